@@ -8,6 +8,17 @@
 #include <petscdmda.h>
 #include <petsc/private/dmimpl.h>
 
+/* DMGlobalToLocal() exchanging whole faces, edges and corners described by MPI datatypes, see DMDASetGhostExchangeDatatypes() */
+typedef struct {
+  PetscInt          n;               /* number of neighbors exchanged with, each gets one send and one receive */
+  PetscMPIInt       *ranks,*stags,*rtags;
+  MPI_Datatype      *stypes,*rtypes; /* subarrays of the owned box sent and of the ghosted box received */
+  MPI_Request       *reqs;
+  Vec               g,l;             /* the vectors whose arrays are held between the begin and end of an exchange */
+  const PetscScalar *garray;
+  PetscScalar       *larray;
+} DMDAGhostExchange;
+
 typedef struct {
   PetscInt              M,N,P;                 /* array dimensions */
   PetscInt              m,n,p;                 /* processor layout */
@@ -19,6 +30,8 @@ typedef struct {
   PetscInt              base;                  /* global number of 1st local node, includes the * w term */
   DMBoundaryType        bx,by,bz;              /* indicates type of ghost nodes at boundary */
   VecScatter            gtol,ltol;        /* scatters, see below for details */
+  PetscBool             gtol_datatypes;   /* use gexch instead of gtol for DMGlobalToLocal() with INSERT_VALUES */
+  DMDAGhostExchange     *gexch;
   DMDAStencilType       stencil_type;          /* stencil, either box or star */
   DMDAInterpolationType interptype;
 
@@ -88,6 +101,8 @@ typedef struct {
             nearest neighbor timestepping.
 */
 
+PETSC_INTERN PetscErrorCode DMDACreateGlobalToLocal_Private(DM);
+PETSC_INTERN PetscErrorCode DMDAGhostExchangeDestroy_Private(DM);
 PETSC_INTERN PetscErrorCode VecView_MPI_DA(Vec,PetscViewer);
 PETSC_INTERN PetscErrorCode VecLoad_Default_DA(Vec, PetscViewer);
 PETSC_INTERN PetscErrorCode DMView_DA_Matlab(DM,PetscViewer);
@@ -79,6 +79,20 @@ struct _PetscGridHash {
   DMLabel      cellsSparse; /* Sparse storage for cell map */
 };
 
+/* Bounding volume hierarchy over axis-aligned boxes, used for point location */
+typedef struct _PetscBVH *PetscBVH;
+struct _PetscBVH {
+  PetscInt          dim;
+  PetscInt          numItems;   /* The number of boxes in the tree */
+  PetscInt          numNodes;   /* The number of tree nodes */
+  PetscReal        *nodeBox;    /* The lower and upper corner of each node */
+  PetscInt         *nodeStart;  /* The first child of an interior node, or the offset into items of a leaf */
+  PetscInt         *nodeSize;   /* The number of items in a leaf, or zero for an interior node */
+  PetscInt         *items;      /* The boxes ordered by leaf */
+  PetscObjectId     coordId;    /* The coordinates used to build the tree */
+  PetscObjectState  coordState;
+};
+
 /* Point Numbering in Plex:
 
    Points are numbered contiguously by stratum. Strate are organized as follows:
@@ -101,6 +115,7 @@ typedef struct {
   PetscSection         supportSection;    /* Layout of cones (inedges for DAG) */
   PetscInt             maxSupportSize;    /* Cached for fast lookup */
   PetscInt            *supports;          /* Cone for each point */
+  PetscBool            supportsLazy;      /* Support sizes are set, but supports are only built from the cones on first use */
   PetscBool            refinementUniform; /* Flag for uniform cell refinement */
   char                *transformType;     /* Type of transform for uniform cell refinement */
   PetscReal            refinementLimit;   /* Maximum volume for refined cell */
@@ -119,6 +134,7 @@ typedef struct {
   char                *triangleOpts;
   PetscPartitioner     partitioner;
   PetscBool            partitionBalance;  /* Evenly divide partition overlap when distributing */
+  PetscBool            overlapLocalCopy; /* Only communicate the incoming points when adding overlap */
   PetscBool            remeshBd;
 
   /* Submesh */
@@ -168,6 +184,7 @@ typedef struct {
   PetscReal            minradius;         /* Minimum distance from cell centroid to face */
   PetscBool            useHashLocation;   /* Use grid hashing for point location */
   PetscGridHash        lbox;              /* Local box for searching */
+  PetscBVH             bvh;               /* Hierarchy of cell bounding boxes for searching */
   void               (*coordFunc)(PetscInt, PetscInt, PetscInt, /* Function used to remap newly introduced vertices */
                                   const PetscInt[], const PetscInt[], const PetscScalar[], const PetscScalar[], const PetscScalar[],
                                   const PetscInt[], const PetscInt[], const PetscScalar[], const PetscScalar[], const PetscScalar[],
@@ -224,6 +241,7 @@ PETSC_INTERN PetscErrorCode VecLoad_Plex_HDF5_Native_Internal(Vec, PetscViewer);
 
 PETSC_INTERN PetscErrorCode DMPlexVecGetClosureAtDepth_Internal(DM, PetscSection, Vec, PetscInt, PetscInt, PetscInt *, PetscScalar *[]);
 PETSC_INTERN PetscErrorCode DMPlexClosurePoints_Private(DM,PetscInt,const PetscInt[],IS*);
+PETSC_INTERN PetscErrorCode DMPlexComputeCellCentroids_Internal(DM,PetscInt,PetscInt,IS,PetscInt*,PetscInt*,PetscReal*[]);
 PETSC_INTERN PetscErrorCode DMSetFromOptions_NonRefinement_Plex(PetscOptionItems *, DM);
 PETSC_INTERN PetscErrorCode DMCoarsen_Plex(DM, MPI_Comm, DM *);
 PETSC_INTERN PetscErrorCode DMCoarsenHierarchy_Plex(DM, PetscInt, DM []);
@@ -360,7 +378,11 @@ PETSC_EXTERN PetscErrorCode DMPlexComputeResidual_Hybrid_Internal(DM, PetscFormK
 PETSC_EXTERN PetscErrorCode DMPlexComputeJacobian_Internal(DM, PetscFormKey, IS, PetscReal, PetscReal, Vec, Vec, Mat, Mat, void *);
 PETSC_EXTERN PetscErrorCode DMPlexComputeJacobian_Hybrid_Internal(DM, PetscFormKey[], IS, PetscReal, PetscReal, Vec, Vec, Mat, Mat, void *);
 PETSC_EXTERN PetscErrorCode DMPlexComputeJacobian_Action_Internal(DM, PetscFormKey, IS, PetscReal, PetscReal, Vec, Vec, Vec, Vec, void *);
+PETSC_INTERN PetscErrorCode PetscBVHCreate_Internal(PetscInt, PetscInt, const PetscReal[], PetscBVH *);
+PETSC_INTERN PetscErrorCode PetscBVHGetCandidates_Internal(PetscBVH, const PetscReal[], PetscInt *, PetscInt *, PetscInt **);
+PETSC_INTERN PetscErrorCode PetscBVHDestroy_Internal(PetscBVH *);
 PETSC_EXTERN PetscErrorCode DMPlexReconstructGradients_Internal(DM, PetscFV, PetscInt, PetscInt, Vec, Vec, Vec, Vec);
+PETSC_INTERN PetscErrorCode DMPlexComputeFluxFVM_Internal(DM, PetscDS, PetscBool, PetscInt, PetscInt, Vec, Vec, Vec, Vec, Vec, PetscBool *);
 
 /* Matvec with A in row-major storage, x and y can be aliased */
 PETSC_STATIC_INLINE void DMPlex_Mult2D_Internal(const PetscScalar A[], PetscInt ldx, const PetscScalar x[], PetscScalar y[])
@@ -698,6 +720,7 @@ PETSC_INTERN PetscErrorCode DMCreateCoordinateDM_Plex(DM dm, DM *cdm);
 PETSC_INTERN PetscErrorCode DMCreateCoordinateField_Plex(DM dm, DMField *field);
 PETSC_INTERN PetscErrorCode DMClone_Plex(DM dm, DM *newdm);
 PETSC_INTERN PetscErrorCode DMSetUp_Plex(DM dm);
+PETSC_INTERN PetscErrorCode DMPlexSetUpSupports_Internal(DM);
 PETSC_INTERN PetscErrorCode DMDestroy_Plex(DM dm);
 PETSC_INTERN PetscErrorCode DMView_Plex(DM dm, PetscViewer viewer);
 PETSC_INTERN PetscErrorCode DMLoad_Plex(DM dm, PetscViewer viewer);
@@ -46,6 +46,7 @@ typedef struct {
 
 } DM_Stag;
 
+PETSC_INTERN PetscErrorCode DMCreateInterpolation_Stag(DM,DM,Mat*,Vec*);
 PETSC_INTERN PetscErrorCode DMStagDuplicateWithoutSetup(DM,MPI_Comm,DM*);
 PETSC_INTERN PetscErrorCode DMStagInitialize(DMBoundaryType,DMBoundaryType,DMBoundaryType,PetscInt,PetscInt,PetscInt,PetscInt,PetscInt,PetscInt,PetscInt,PetscInt,PetscInt,PetscInt,DMStagStencilType,PetscInt,const PetscInt[],const PetscInt[],const PetscInt[],DM);
 PETSC_INTERN PetscErrorCode DMSetUp_Stag_1d(DM);
@@ -12,6 +12,8 @@ PETSC_EXTERN PetscLogEvent DMSWARM_SetSizes;
 PETSC_EXTERN PetscLogEvent DMSWARM_AddPoints;
 PETSC_EXTERN PetscLogEvent DMSWARM_RemovePoints;
 PETSC_EXTERN PetscLogEvent DMSWARM_Sort;
+PETSC_EXTERN PetscLogEvent DMSWARM_Deposit;
+PETSC_EXTERN PetscLogEvent DMSWARM_Interpolate;
 PETSC_EXTERN PetscLogEvent DMSWARM_DataExchangerTopologySetup;
 PETSC_EXTERN PetscLogEvent DMSWARM_DataExchangerBegin;
 PETSC_EXTERN PetscLogEvent DMSWARM_DataExchangerEnd;
@@ -48,6 +50,7 @@ typedef struct {
   PetscBool collect_view_active;
   PetscInt  collect_view_reset_nlocal;
   DMSwarmSort sort_context;
+  PetscInt    sort_reorder_freq,sort_reorder_count; /* reorder the points by cell after every sort_reorder_freq migrations */
 } DM_Swarm;
 
 typedef struct {
@@ -60,10 +63,15 @@ struct _p_DMSwarmSort {
   PetscInt ncells,npoints;
   PetscInt *pcell_offsets;
   SwarmPoint *list;
+  PetscBool haslist;      /* list describes the points at the previous setup and may be updated incrementally */
+  PetscInt *pcellid;      /* cell index of each point at the previous setup */
+  SwarmPoint *list_work;  /* target of the incremental update, swapped with list */
+  PetscInt *work;
 };
 
 PETSC_INTERN PetscErrorCode DMSwarmMigrate_Push_Basic(DM, PetscBool);
 PETSC_INTERN PetscErrorCode DMSwarmMigrate_CellDMScatter(DM,PetscBool);
 PETSC_INTERN PetscErrorCode DMSwarmMigrate_CellDMExact(DM,PetscBool);
+PETSC_INTERN PetscErrorCode DMSwarmSortReorderAfterMigrate_Internal(DM);
 
 #endif /* _SWARMIMPL_H */
@@ -8,6 +8,10 @@
 PETSC_EXTERN PetscBool      PetscPartitionerRegisterAllCalled;
 PETSC_EXTERN PetscErrorCode PetscPartitionerRegisterAll(void);
 
+PETSC_INTERN PetscErrorCode PetscPartitionerSFCGetNumBits_Internal(PetscInt, PetscInt *);
+PETSC_INTERN PetscErrorCode PetscPartitionerSFCComputeKeys_Internal(PetscPartitionerSFCCurveType, PetscInt, const PetscReal[], const PetscReal[], PetscInt, const PetscReal[], PetscInt64[]);
+PETSC_INTERN PetscErrorCode PetscPartitionerSFCSortKeys_Internal(PetscPartitionerSFCCurveType, PetscInt, const PetscReal[], const PetscReal[], PetscInt, const PetscReal[], PetscInt64[], PetscInt[]);
+
 typedef struct _PetscPartitionerOps *PetscPartitionerOps;
 struct _PetscPartitionerOps {
   PetscErrorCode (*setfromoptions)(PetscOptionItems*, PetscPartitioner);
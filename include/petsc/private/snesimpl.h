@@ -9,6 +9,27 @@ PETSC_EXTERN PetscErrorCode SNESRegisterAll(void);
 
 typedef struct _SNESOps *SNESOps;
 
+/* state of the adaptive Jacobian and preconditioner lagging, see SNESSetLagAdaptive() */
+typedef struct {
+  PetscLogDouble tstamp;          /* time at the end of the last lagging decision */
+  PetscLogDouble tjac;            /* duration of the last Jacobian evaluation */
+  PetscLogDouble tfresh;          /* duration of the last step with a new Jacobian, including its evaluation */
+  PetscLogDouble tpc;             /* duration of the first step after the last preconditioner setup, including the setup */
+  PetscLogDouble titer;           /* duration of one linear iteration with a reused preconditioner */
+  PetscReal      ffresh;          /* residual norm at which the last new Jacobian was computed */
+  PetscReal      rfresh;          /* log of the residual reduction of the last step with a new Jacobian */
+  PetscReal      degrade;         /* reduction of the first step with a reused Jacobian relative to the step before it */
+  PetscReal      fnorm;           /* residual norm at the last lagging decision */
+  PetscInt       its;             /* total linear iterations at the last lagging decision */
+  PetscInt       pcits;           /* linear iterations of the first step after the last preconditioner setup */
+  PetscInt       extra;           /* linear iterations beyond pcits per step since the last preconditioner setup */
+  PetscBool      fresh;           /* the last step used a new Jacobian */
+  PetscBool      measure;         /* the last step is the first one with a reused Jacobian */
+  PetscBool      newpc;           /* the last step used a new preconditioner */
+  PetscReal      costs[4];        /* -snes_lag_adaptive_costs: Jacobian, preconditioner setup, step and linear iteration */
+  PetscInt       ncosts;          /* nonzero when costs[] replace the measured times */
+} SNESLagAdaptive;
+
 struct _SNESOps {
   PetscErrorCode (*computeinitialguess)(SNES,Vec,void*);
   PetscErrorCode (*computescaling)(Vec,Vec,void*);
@@ -110,6 +131,8 @@ struct _p_SNES {
   PetscBool   lagjac_persist;     /* The jac_iter persists until reset */
   PetscInt    pre_iter;           /* The present iteration of the Preconditioner lagging */
   PetscBool   lagpre_persist;     /* The pre_iter persists until reset */
+  PetscBool   lagadaptive;        /* SNESSetLagAdaptive() */
+  SNESLagAdaptive lagadapt;       /* measurements of the adaptive lagging */
   PetscInt    gridsequence;       /* number of grid sequence steps to take; defaults to zero */
 
   PetscBool   tolerancesset;      /* SNESSetTolerances() called and tolerances should persist through SNESCreate_XXX()*/
@@ -367,6 +367,9 @@ struct _DMTSOps {
   TSSolutionFunction solution;
   TSForcingFunction  forcing;
 
+  /* advance one explicit RK step X <- X + h b^T Ydot locally, reusing deep ghost regions for up to the given number of steps */
+  PetscErrorCode (*rkstep)(TS,PetscInt,PetscReal,PetscReal,PetscInt,const PetscReal[],const PetscReal[],const PetscReal[],Vec,Vec[],PetscBool*,void*);
+
   PetscErrorCode (*destroy)(DMTS);
   PetscErrorCode (*duplicate)(DMTS,DMTS);
 };
@@ -387,6 +390,8 @@ struct _p_DMTS {
   void *solutionctx;
   void *forcingctx;
 
+  void *rkstepctx;
+
   void *data;
 
   /* This is NOT reference counted. The DM on which this context was first created is cached here to implement one-way
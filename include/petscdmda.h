@@ -190,6 +190,10 @@ PETSC_EXTERN PetscErrorCode MatCreateDAAD(DM,Mat*);
 PETSC_EXTERN PetscErrorCode MatCreateSeqUSFFT(Vec,DM,Mat*);
 
 PETSC_EXTERN PetscErrorCode DMDASetGetMatrix(DM,PetscErrorCode (*)(DM, Mat *));
+PETSC_EXTERN PetscErrorCode DMDAGetStencilOffsets(DM,PetscInt*,PetscInt*[]);
+PETSC_EXTERN PetscErrorCode DMDASetGhostExchangeDatatypes(DM,PetscBool);
+PETSC_EXTERN PetscErrorCode DMDAGetGhostExchangeDatatypes(DM,PetscBool*);
+PETSC_EXTERN PetscErrorCode DMDACreateStencilOperator(DM,const PetscScalar[],Vec,Mat*);
 PETSC_EXTERN PetscErrorCode DMDASetBlockFills(DM,const PetscInt*,const PetscInt*);
 PETSC_EXTERN PetscErrorCode DMDASetBlockFillsSparse(DM,const PetscInt*,const PetscInt*);
 PETSC_EXTERN PetscErrorCode DMDASetRefinementFactor(DM,PetscInt,PetscInt,PetscInt);
@@ -55,6 +55,30 @@ typedef enum {
   DMSWARMPIC_LAYOUT_SUBDIVISION
 } DMSwarmPICLayoutType;
 
+/*E
+   DMSwarmDepositType - Defines the shape function used to deposit swarm fields onto, and interpolate them from, the nodes of the cell DM
+
+   DMSWARM_DEPOSIT_NGP assigns each point to the nearest grid node (DMDA only).
+
+   DMSWARM_DEPOSIT_CIC uses the cloud-in-cell (multi-linear) weights of the nodes of the cell containing the point (DMDA only).
+
+   DMSWARM_DEPOSIT_TSC uses the triangular-shaped-cloud (quadratic B-spline) weights of the three nodes nearest to the point in each direction (DMDA only).
+   The DMDA requires a stencil width of at least 2 when it is decomposed over more than one rank.
+
+   DMSWARM_DEPOSIT_P1 uses the piecewise linear basis functions of the simplex containing the point (DMPLEX only).
+
+   Level: beginner
+
+.seealso: DMSwarmDepositField(), DMSwarmInterpolateField()
+E*/
+typedef enum {
+  DMSWARM_DEPOSIT_NGP=0,
+  DMSWARM_DEPOSIT_CIC,
+  DMSWARM_DEPOSIT_TSC,
+  DMSWARM_DEPOSIT_P1
+} DMSwarmDepositType;
+PETSC_EXTERN const char *const DMSwarmDepositTypes[];
+
 PETSC_EXTERN const char* DMSwarmTypeNames[];
 PETSC_EXTERN const char* DMSwarmMigrateTypeNames[];
 PETSC_EXTERN const char* DMSwarmCollectTypeNames[];
@@ -111,9 +135,13 @@ PETSC_EXTERN PetscErrorCode DMSwarmSortGetPointsPerCell(DM,PetscInt,PetscInt*,Pe
 PETSC_EXTERN PetscErrorCode DMSwarmSortGetNumberOfPointsPerCell(DM,PetscInt,PetscInt*);
 PETSC_EXTERN PetscErrorCode DMSwarmSortGetIsValid(DM,PetscBool*);
 PETSC_EXTERN PetscErrorCode DMSwarmSortGetSizes(DM,PetscInt*,PetscInt*);
+PETSC_EXTERN PetscErrorCode DMSwarmSortReorder(DM);
+PETSC_EXTERN PetscErrorCode DMSwarmSortSetReorderFrequency(DM,PetscInt);
 
 PETSC_EXTERN PetscErrorCode DMSwarmProjectFields(DM,PetscInt,const char**,Vec**,PetscBool);
 PETSC_EXTERN PetscErrorCode DMSwarmCreateMassMatrixSquare(DM,DM,Mat*);
+PETSC_EXTERN PetscErrorCode DMSwarmDepositField(DM,const char[],DMSwarmDepositType,Vec);
+PETSC_EXTERN PetscErrorCode DMSwarmInterpolateField(DM,Vec,DMSwarmDepositType,const char[]);
 
 PETSC_EXTERN PetscErrorCode DMSwarmGetCellSwarm(DM sw, PetscInt cellID, DM cellswarm);
 PETSC_EXTERN PetscErrorCode DMSwarmRestoreCellSwarm(DM sw, PetscInt cellID, DM cellswarm);
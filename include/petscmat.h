@@ -98,6 +98,9 @@ typedef const char* MatType;
 #define MATSELL            "sell"
 #define MATSEQSELL         "seqsell"
 #define MATMPISELL         "mpisell"
+#define MATVBAIJ           "vbaij"
+#define MATSEQVBAIJ        "seqvbaij"
+#define MATKRONECKER       "kronecker"
 #define MATDUMMY           "dummy"
 #define MATLMVM            "lmvm"
 #define MATLMVMDFP         "lmvmdfp"
@@ -350,6 +353,11 @@ PETSC_EXTERN PetscErrorCode MatCompositeGetNumberMat(Mat,PetscInt*);
 PETSC_EXTERN PetscErrorCode MatCompositeGetMat(Mat,PetscInt,Mat*);
 PETSC_EXTERN PetscErrorCode MatCompositeSetScalings(Mat,const PetscScalar*);
 
+PETSC_EXTERN PetscErrorCode MatCreateKronecker(Mat,Mat,Mat*);
+PETSC_EXTERN PetscErrorCode MatKroneckerAddTerm(Mat,Mat,Mat);
+PETSC_EXTERN PetscErrorCode MatKroneckerGetNumberTerms(Mat,PetscInt*);
+PETSC_EXTERN PetscErrorCode MatKroneckerGetTerm(Mat,PetscInt,Mat*,Mat*);
+
 PETSC_EXTERN PetscErrorCode MatCreateFFT(MPI_Comm,PetscInt,const PetscInt[],MatType,Mat*);
 PETSC_EXTERN PetscErrorCode MatCreateSeqCUFFT(MPI_Comm,PetscInt,const PetscInt[],Mat*);
 
@@ -1781,6 +1789,7 @@ PETSC_EXTERN PetscErrorCode MatDiagonalScaleLocal(Mat,Vec);
 PETSC_EXTERN PetscErrorCode MatCreateMFFD(MPI_Comm,PetscInt,PetscInt,PetscInt,PetscInt,Mat*);
 PETSC_EXTERN PetscErrorCode MatMFFDSetBase(Mat,Vec,Vec);
 PETSC_EXTERN PetscErrorCode MatMFFDSetFunction(Mat,PetscErrorCode(*)(void*,Vec,Vec),void*);
+PETSC_EXTERN PetscErrorCode MatMFFDSetFunctionBatch(Mat,PetscErrorCode(*)(void*,PetscInt,const Vec[],Vec[]),void*);
 PETSC_EXTERN PetscErrorCode MatMFFDSetFunctioni(Mat,PetscErrorCode (*)(void*,PetscInt,Vec,PetscScalar*));
 PETSC_EXTERN PetscErrorCode MatMFFDSetFunctioniBase(Mat,PetscErrorCode (*)(void*,Vec));
 PETSC_EXTERN PetscErrorCode MatMFFDSetHHistory(Mat,PetscScalar[],PetscInt);
@@ -30,6 +30,7 @@ typedef const char *PetscPartitionerType;
 #define PETSCPARTITIONERSIMPLE   "simple"
 #define PETSCPARTITIONERSHELL    "shell"
 #define PETSCPARTITIONERGATHER   "gather"
+#define PETSCPARTITIONERSFC      "sfc"
 
 PETSC_EXTERN PetscFunctionList PetscPartitionerList;
 PETSC_EXTERN PetscErrorCode PetscPartitionerRegister(const char[], PetscErrorCode (*)(PetscPartitioner));
@@ -49,6 +50,20 @@ PETSC_EXTERN PetscErrorCode PetscPartitionerShellSetPartition(PetscPartitioner,
 PETSC_EXTERN PetscErrorCode PetscPartitionerShellSetRandom(PetscPartitioner, PetscBool);
 PETSC_EXTERN PetscErrorCode PetscPartitionerShellGetRandom(PetscPartitioner, PetscBool*);
 
+/*E
+  PetscPartitionerSFCCurveType - The space-filling curve used by PETSCPARTITIONERSFC to order points
+
+  Level: intermediate
+
+.seealso: PetscPartitionerSFCSetCurveType(), PETSCPARTITIONERSFC
+E*/
+typedef enum {PETSCPARTITIONER_SFC_HILBERT, PETSCPARTITIONER_SFC_MORTON} PetscPartitionerSFCCurveType;
+PETSC_EXTERN const char *const PetscPartitionerSFCCurveTypes[];
+
+PETSC_EXTERN PetscErrorCode PetscPartitionerSFCSetCoordinates(PetscPartitioner, PetscInt, PetscInt, const PetscReal[]);
+PETSC_EXTERN PetscErrorCode PetscPartitionerSFCSetCurveType(PetscPartitioner, PetscPartitionerSFCCurveType);
+PETSC_EXTERN PetscErrorCode PetscPartitionerSFCGetCurveType(PetscPartitioner, PetscPartitionerSFCCurveType*);
+
 /* We should implement MatPartitioning with PetscPartitioner */
 #include <petscmat.h>
 #define PETSCPARTITIONERMATPARTITIONING "matpartitioning"
@@ -73,6 +73,7 @@ typedef const char* PCType;
 #define PCDEFLATION       "deflation"
 #define PCHPDDM           "hpddm"
 #define PCHARA            "hara"
+#define PCKRONECKER       "kronecker"
 
 /*E
     PCSide - If the preconditioner is to be applied to the left, right
@@ -154,6 +154,8 @@ PETSC_EXTERN PetscErrorCode SNESSetLagJacobian(SNES,PetscInt);
 PETSC_EXTERN PetscErrorCode SNESGetLagJacobian(SNES,PetscInt*);
 PETSC_EXTERN PetscErrorCode SNESSetLagPreconditionerPersists(SNES,PetscBool);
 PETSC_EXTERN PetscErrorCode SNESSetLagJacobianPersists(SNES,PetscBool);
+PETSC_EXTERN PetscErrorCode SNESSetLagAdaptive(SNES,PetscBool);
+PETSC_EXTERN PetscErrorCode SNESGetLagAdaptive(SNES,PetscBool*);
 PETSC_EXTERN PetscErrorCode SNESSetGridSequence(SNES,PetscInt);
 PETSC_EXTERN PetscErrorCode SNESGetGridSequence(SNES,PetscInt*);
 
@@ -705,6 +707,7 @@ PETSC_EXTERN_TYPEDEF typedef PetscErrorCode (*DMDASNESObjective)(DMDALocalInfo*,
 
 PETSC_EXTERN PetscErrorCode DMDASNESSetFunctionLocal(DM,InsertMode,DMDASNESFunction,void*);
 PETSC_EXTERN PetscErrorCode DMDASNESSetJacobianLocal(DM,DMDASNESJacobian,void*);
+PETSC_EXTERN PetscErrorCode DMDASNESSetFDColoringLocal(DM,PetscBool);
 PETSC_EXTERN PetscErrorCode DMDASNESSetObjectiveLocal(DM,DMDASNESObjective,void*);
 PETSC_EXTERN PetscErrorCode DMDASNESSetPicardLocal(DM,InsertMode,PetscErrorCode (*)(DMDALocalInfo*,void*,void*,void*),PetscErrorCode (*)(DMDALocalInfo*,void*,Mat,Mat,void*),void*);
 
@@ -808,6 +811,8 @@ PETSC_EXTERN PetscErrorCode SNESNASMSetDamping(SNES,PetscReal);
 PETSC_EXTERN PetscErrorCode SNESNASMGetDamping(SNES,PetscReal*);
 PETSC_EXTERN PetscErrorCode SNESNASMGetSubdomainVecs(SNES,PetscInt*,Vec**,Vec**,Vec**,Vec**);
 PETSC_EXTERN PetscErrorCode SNESNASMSetComputeFinalJacobian(SNES,PetscBool);
+PETSC_EXTERN PetscErrorCode SNESNASMSetAsynchronous(SNES,PetscBool);
+PETSC_EXTERN PetscErrorCode SNESNASMGetAsynchronous(SNES,PetscBool*);
 PETSC_EXTERN PetscErrorCode SNESNASMGetSNES(SNES,PetscInt,SNES *);
 PETSC_EXTERN PetscErrorCode SNESNASMGetNumber(SNES,PetscInt*);
 PETSC_EXTERN PetscErrorCode SNESNASMSetWeight(SNES,Vec);
@@ -46,6 +46,7 @@ typedef const char* TSType;
 #define TSRADAU5          "radau5"
 #define TSMPRK            "mprk"
 #define TSDISCGRAD        "discgrad"
+#define TSPARAREAL        "parareal"
 
 /*E
     TSProblemType - Determines the type of problem this TS object is to be used to solve
@@ -339,6 +340,25 @@ PETSC_EXTERN PetscErrorCode TSTrajectorySetDirname(TSTrajectory,const char[]);
 PETSC_EXTERN PetscErrorCode TSTrajectorySetFiletemplate(TSTrajectory,const char[]);
 PETSC_EXTERN PetscErrorCode TSGetTrajectory(TS,TSTrajectory*);
 
+/*E
+   TSTrajectoryCompressionType - How TSTRAJECTORYMEMORY encodes the checkpoints it stores on disk
+
+$  TS_TRAJECTORY_COMPRESSION_NONE     - store the values as they are
+$  TS_TRAJECTORY_COMPRESSION_LOSSLESS - store only the bits in which each value differs from the previous one
+$  TS_TRAJECTORY_COMPRESSION_LOSSY    - round the values to a given absolute accuracy and store the differences of the rounded values
+
+   Level: intermediate
+
+.seealso: TSTrajectoryMemorySetCompression()
+E*/
+typedef enum {TS_TRAJECTORY_COMPRESSION_NONE,TS_TRAJECTORY_COMPRESSION_LOSSLESS,TS_TRAJECTORY_COMPRESSION_LOSSY} TSTrajectoryCompressionType;
+PETSC_EXTERN const char *const TSTrajectoryCompressionTypes[];
+
+PETSC_EXTERN PetscErrorCode TSTrajectoryMemorySetAsyncIO(TSTrajectory,PetscBool);
+PETSC_EXTERN PetscErrorCode TSTrajectoryMemorySetCompression(TSTrajectory,TSTrajectoryCompressionType,PetscReal);
+PETSC_EXTERN PetscErrorCode TSTrajectoryMemorySetStorageLevel(TSTrajectory,PetscInt,const char[],PetscInt,PetscReal,PetscReal);
+PETSC_EXTERN PetscErrorCode TSTrajectoryMemorySetStepTime(TSTrajectory,PetscReal);
+
 PETSC_EXTERN PetscErrorCode TSSetCostGradients(TS,PetscInt,Vec*,Vec*);
 PETSC_EXTERN PetscErrorCode TSGetCostGradients(TS,PetscInt*,Vec**,Vec**);
 PETSC_EXTERN PETSC_DEPRECATED_FUNCTION("Use TSCreateQuadratureTS() then set up the sub-TS (since version 3.12)") PetscErrorCode TSSetCostIntegrand(TS,PetscInt,Vec,PetscErrorCode (*)(TS,PetscReal,Vec,Vec,void*),PetscErrorCode (*)(TS,PetscReal,Vec,Vec*,void*),PetscErrorCode (*)(TS,PetscReal,Vec,Vec*,void*),PetscBool,void*);
@@ -570,6 +590,7 @@ PETSC_EXTERN_TYPEDEF typedef PetscErrorCode (*DMDATSIFunctionLocal)(DMDALocalInf
 PETSC_EXTERN_TYPEDEF typedef PetscErrorCode (*DMDATSIJacobianLocal)(DMDALocalInfo*,PetscReal,void*,void*,PetscReal,Mat,Mat,void*);
 
 PETSC_EXTERN PetscErrorCode DMDATSSetRHSFunctionLocal(DM,InsertMode,PetscErrorCode (*)(DMDALocalInfo*,PetscReal,void*,void*,void*),void *);
+PETSC_EXTERN PetscErrorCode DMDATSSetRHSStencilLocal(DM,PetscInt,PetscErrorCode (*)(DMDALocalInfo*,PetscReal,void*,void*,void*),void *);
 PETSC_EXTERN PetscErrorCode DMDATSSetRHSJacobianLocal(DM,PetscErrorCode (*)(DMDALocalInfo*,PetscReal,void*,Mat,Mat,void*),void *);
 PETSC_EXTERN PetscErrorCode DMDATSSetIFunctionLocal(DM,InsertMode,PetscErrorCode (*)(DMDALocalInfo*,PetscReal,void*,void*,void*,void*),void *);
 PETSC_EXTERN PetscErrorCode DMDATSSetIJacobianLocal(DM,PetscErrorCode (*)(DMDALocalInfo*,PetscReal,void*,void*,PetscReal,Mat,Mat,void*),void *);
@@ -842,6 +863,8 @@ PETSC_EXTERN PetscErrorCode TSRKSetType(TS,TSRKType);
 PETSC_EXTERN PetscErrorCode TSRKGetTableau(TS,PetscInt*,const PetscReal**,const PetscReal**,const PetscReal**,const PetscReal**,PetscInt*,const PetscReal**,PetscBool*);
 PETSC_EXTERN PetscErrorCode TSRKSetMultirate(TS,PetscBool);
 PETSC_EXTERN PetscErrorCode TSRKGetMultirate(TS,PetscBool*);
+PETSC_EXTERN PetscErrorCode TSRKSetTemporalBlocking(TS,PetscInt);
+PETSC_EXTERN PetscErrorCode TSRKGetTemporalBlocking(TS,PetscInt*);
 PETSC_EXTERN PetscErrorCode TSRKRegister(TSRKType,PetscInt,PetscInt,const PetscReal[],const PetscReal[],const PetscReal[],const PetscReal[],PetscInt,const PetscReal[]);
 PETSC_EXTERN PetscErrorCode TSRKInitializePackage(void);
 PETSC_EXTERN PetscErrorCode TSRKFinalizePackage(void);
@@ -987,6 +1010,26 @@ PETSC_EXTERN PetscErrorCode TSBasicSymplecticRegisterDestroy(void);
 
 PETSC_EXTERN PetscErrorCode TSDiscGradSetFormulation(TS, PetscErrorCode(*)(TS, PetscReal, Vec, Mat, void *), PetscErrorCode(*)(TS, PetscReal, Vec, PetscScalar *, void *), PetscErrorCode(*)(TS, PetscReal, Vec, Vec, void *), void *);
 
+/*E
+   TSParaRealRelaxationType - The relaxation of TSPARAREAL before each coarse sweep
+
+$  TS_PARAREAL_RELAXATION_F - fine propagation of all time slices, which is Parareal
+$  TS_PARAREAL_RELAXATION_FCF - two fine propagations of all time slices, which is two-level MGRIT with FCF-relaxation
+
+   Level: intermediate
+
+.seealso: TSParaRealSetRelaxationType(), TSPARAREAL
+E*/
+typedef enum {TS_PARAREAL_RELAXATION_F,TS_PARAREAL_RELAXATION_FCF} TSParaRealRelaxationType;
+PETSC_EXTERN const char *const TSParaRealRelaxationTypes[];
+PETSC_EXTERN PetscErrorCode TSParaRealSetSubcomm(TS,PetscSubcomm);
+PETSC_EXTERN PetscErrorCode TSParaRealSetNumSlices(TS,PetscInt);
+PETSC_EXTERN PetscErrorCode TSParaRealSetRelaxationType(TS,TSParaRealRelaxationType);
+PETSC_EXTERN PetscErrorCode TSParaRealSetTolerances(TS,PetscReal,PetscReal,PetscInt);
+PETSC_EXTERN PetscErrorCode TSParaRealGetIterationNumber(TS,PetscInt*);
+PETSC_EXTERN PetscErrorCode TSParaRealGetFineTS(TS,TS*);
+PETSC_EXTERN PetscErrorCode TSParaRealGetCoarseTS(TS,TS*);
+
 /*
        PETSc interface to Sundials
 */
@@ -133,12 +133,9 @@ PetscErrorCode  DMSetUp_DA_1D(DM da)
   const PetscInt   *lx   = dd->lx;
   DMBoundaryType   bx    = dd->bx;
   MPI_Comm         comm;
-  Vec              local, global;
-  VecScatter       gtol;
-  IS               to, from;
   PetscBool        flg1 = PETSC_FALSE, flg2 = PETSC_FALSE;
   PetscMPIInt      rank, size;
-  PetscInt         i,*idx,nn,left,xs,xe,x,Xs,Xe,start,m,IXs,IXe;
+  PetscInt         i,*idx,nn,left,xs,xe,x,Xs,Xe,m,IXs,IXe;
   PetscErrorCode   ierr;
 
   PetscFunctionBegin;
@@ -224,18 +221,11 @@ PetscErrorCode  DMSetUp_DA_1D(DM da)
     IXe = xe + sDist;
   }
 
-  /* allocate the base parallel and sequential vectors */
+  /* the sizes of the base parallel and sequential vectors */
   dd->Nlocal = dof*x;
-  ierr       = VecCreateMPIWithArray(comm,dof,dd->Nlocal,PETSC_DECIDE,NULL,&global);CHKERRQ(ierr);
   dd->nlocal = dof*(Xe-Xs);
-  ierr       = VecCreateSeqWithArray(PETSC_COMM_SELF,dof,dd->nlocal,NULL,&local);CHKERRQ(ierr);
-
-  ierr = VecGetOwnershipRange(global,&start,NULL);CHKERRQ(ierr);
-
-  /* Create Global to Local Vector Scatter Context */
-  /* global to local must retrieve ghost points */
-  ierr = ISCreateStride(comm,dof*(IXe-IXs),dof*(IXs-Xs),1,&to);CHKERRQ(ierr);
 
+  /* the global to local scatter is built from the local to global mapping only when it is first needed */
   ierr = PetscMalloc1(x+2*sDist,&idx);CHKERRQ(ierr);
   ierr = PetscLogObjectMemory((PetscObject)da,(x+2*(sDist))*sizeof(PetscInt));CHKERRQ(ierr);
 
@@ -282,18 +272,9 @@ PetscErrorCode  DMSetUp_DA_1D(DM da)
     }
   }
 
-  ierr = ISCreateBlock(comm,dof,nn-IXs+Xs,&idx[IXs-Xs],PETSC_USE_POINTER,&from);CHKERRQ(ierr);
-  ierr = VecScatterCreate(global,from,local,to,&gtol);CHKERRQ(ierr);
-  ierr = PetscLogObjectParent((PetscObject)da,(PetscObject)gtol);CHKERRQ(ierr);
-  ierr = ISDestroy(&to);CHKERRQ(ierr);
-  ierr = ISDestroy(&from);CHKERRQ(ierr);
-  ierr = VecDestroy(&local);CHKERRQ(ierr);
-  ierr = VecDestroy(&global);CHKERRQ(ierr);
-
   dd->xs = dof*xs; dd->xe = dof*xe; dd->ys = 0; dd->ye = 1; dd->zs = 0; dd->ze = 1;
   dd->Xs = dof*Xs; dd->Xe = dof*Xe; dd->Ys = 0; dd->Ye = 1; dd->Zs = 0; dd->Ze = 1;
 
-  dd->gtol      = gtol;
   dd->base      = dof*xs;
   da->ops->view = DMView_DA_1d;
 
@@ -202,14 +202,11 @@ PetscErrorCode  DMSetUp_DA_2D(DM da)
   PetscInt         *ly          = dd->ly;
   MPI_Comm         comm;
   PetscMPIInt      rank,size;
-  PetscInt         xs,xe,ys,ye,x,y,Xs,Xe,Ys,Ye,IXs,IXe,IYs,IYe;
-  PetscInt         up,down,left,right,i,n0,n1,n2,n3,n5,n6,n7,n8,*idx,nn;
-  PetscInt         xbase,*bases,*ldims,j,x_t,y_t,s_t,base,count;
+  PetscInt         xs,xe,ys,ye,x,y,Xs,Xe,Ys,Ye;
+  PetscInt         left,i,n0,n1,n2,n3,n5,n6,n7,n8,*idx,nn;
+  PetscInt         xbase,*bases,*ldims,j,x_t,y_t,s_t,base;
   PetscInt         s_x,s_y; /* s proportionalized to w */
   PetscInt         sn0 = 0,sn2 = 0,sn6 = 0,sn8 = 0;
-  Vec              local,global;
-  VecScatter       gtol;
-  IS               to,from;
   PetscErrorCode   ierr;
 
   PetscFunctionBegin;
@@ -311,59 +308,51 @@ PetscErrorCode  DMSetUp_DA_2D(DM da)
   xe = xs + x;
   ye = ys + y;
 
-  /* determine ghost region (Xs) and region scattered into (IXs)  */
+  /* determine ghost region (Xs) */
   if (xs-s > 0) {
-    Xs = xs - s; IXs = xs - s;
+    Xs = xs - s;
   } else {
     if (bx) {
       Xs = xs - s;
     } else {
       Xs = 0;
     }
-    IXs = 0;
   }
   if (xe+s <= M) {
-    Xe = xe + s; IXe = xe + s;
+    Xe = xe + s;
   } else {
     if (bx) {
       Xs = xs - s; Xe = xe + s;
     } else {
       Xe = M;
     }
-    IXe = M;
   }
 
   if (bx == DM_BOUNDARY_PERIODIC || bx == DM_BOUNDARY_MIRROR) {
-    IXs = xs - s;
-    IXe = xe + s;
     Xs  = xs - s;
     Xe  = xe + s;
   }
 
   if (ys-s > 0) {
-    Ys = ys - s; IYs = ys - s;
+    Ys = ys - s;
   } else {
     if (by) {
       Ys = ys - s;
     } else {
       Ys = 0;
     }
-    IYs = 0;
   }
   if (ye+s <= N) {
-    Ye = ye + s; IYe = ye + s;
+    Ye = ye + s;
   } else {
     if (by) {
       Ye = ye + s;
     } else {
       Ye = N;
     }
-    IYe = N;
   }
 
   if (by == DM_BOUNDARY_PERIODIC || by == DM_BOUNDARY_MIRROR) {
-    IYs = ys - s;
-    IYe = ye + s;
     Ys  = ys - s;
     Ye  = ye + s;
   }
@@ -385,62 +374,11 @@ PetscErrorCode  DMSetUp_DA_2D(DM da)
   }
   base = bases[rank]*dof;
 
-  /* allocate the base parallel and sequential vectors */
+  /* the sizes of the base parallel and sequential vectors */
   dd->Nlocal = x*y*dof;
-  ierr       = VecCreateMPIWithArray(comm,dof,dd->Nlocal,PETSC_DECIDE,NULL,&global);CHKERRQ(ierr);
   dd->nlocal = (Xe-Xs)*(Ye-Ys)*dof;
-  ierr       = VecCreateSeqWithArray(PETSC_COMM_SELF,dof,dd->nlocal,NULL,&local);CHKERRQ(ierr);
-
-  /* generate global to local vector scatter and local to global mapping*/
-
-  /* global to local must include ghost points within the domain,
-     but not ghost points outside the domain that aren't periodic */
-  ierr  = PetscMalloc1((IXe-IXs)*(IYe-IYs),&idx);CHKERRQ(ierr);
-  if (stencil_type == DMDA_STENCIL_BOX) {
-    left  = IXs - Xs; right = left + (IXe-IXs);
-    down  = IYs - Ys; up = down + (IYe-IYs);
-    count = 0;
-    for (i=down; i<up; i++) {
-      for (j=left; j<right; j++) {
-        idx[count++] = j + i*(Xe-Xs);
-      }
-    }
-    ierr = ISCreateBlock(comm,dof,count,idx,PETSC_OWN_POINTER,&to);CHKERRQ(ierr);
 
-  } else {
-    /* must drop into cross shape region */
-    /*       ---------|
-            |  top    |
-         |---         ---| up
-         |   middle      |
-         |               |
-         ----         ---- down
-            | bottom  |
-            -----------
-         Xs xs        xe Xe */
-    left  = xs - Xs; right = left + x;
-    down  = ys - Ys; up = down + y;
-    count = 0;
-    /* bottom */
-    for (i=(IYs-Ys); i<down; i++) {
-      for (j=left; j<right; j++) {
-        idx[count++] = j + i*(Xe-Xs);
-      }
-    }
-    /* middle */
-    for (i=down; i<up; i++) {
-      for (j=(IXs-Xs); j<(IXe-Xs); j++) {
-        idx[count++] = j + i*(Xe-Xs);
-      }
-    }
-    /* top */
-    for (i=up; i<up+IYe-ye; i++) {
-      for (j=left; j<right; j++) {
-        idx[count++] = j + i*(Xe-Xs);
-      }
-    }
-    ierr = ISCreateBlock(comm,dof,count,idx,PETSC_OWN_POINTER,&to);CHKERRQ(ierr);
-  }
+  /* the global to local scatter is built from the local to global mapping only when it is first needed */
 
   /* determine who lies on each side of us stored in    n6 n7 n8
                                                         n3    n5
@@ -602,12 +540,6 @@ PetscErrorCode  DMSetUp_DA_2D(DM da)
     }
   }
 
-  ierr = ISCreateBlock(comm,dof,nn,idx,PETSC_USE_POINTER,&from);CHKERRQ(ierr);
-  ierr = VecScatterCreate(global,from,local,to,&gtol);CHKERRQ(ierr);
-  ierr = PetscLogObjectParent((PetscObject)da,(PetscObject)gtol);CHKERRQ(ierr);
-  ierr = ISDestroy(&to);CHKERRQ(ierr);
-  ierr = ISDestroy(&from);CHKERRQ(ierr);
-
   if (stencil_type == DMDA_STENCIL_STAR) {
     n0 = sn0; n2 = sn2; n6 = sn6; n8 = sn8;
   }
@@ -725,10 +657,6 @@ PetscErrorCode  DMSetUp_DA_2D(DM da)
   dd->xs = xs*dof; dd->xe = xe*dof; dd->ys = ys; dd->ye = ye; dd->zs = 0; dd->ze = 1;
   dd->Xs = Xs*dof; dd->Xe = Xe*dof; dd->Ys = Ys; dd->Ye = Ye; dd->Zs = 0; dd->Ze = 1;
 
-  ierr = VecDestroy(&local);CHKERRQ(ierr);
-  ierr = VecDestroy(&global);CHKERRQ(ierr);
-
-  dd->gtol      = gtol;
   dd->base      = base;
   da->ops->view = DMView_DA_2d;
   dd->ltol      = NULL;
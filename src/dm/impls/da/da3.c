@@ -214,17 +214,14 @@ PetscErrorCode  DMSetUp_DA_3D(DM da)
   MPI_Comm         comm;
   PetscMPIInt      rank,size;
   PetscInt         xs = 0,xe,ys = 0,ye,zs = 0,ze,x = 0,y = 0,z = 0;
-  PetscInt         Xs,Xe,Ys,Ye,Zs,Ze,IXs,IXe,IYs,IYe,IZs,IZe,pm;
-  PetscInt         left,right,up,down,bottom,top,i,j,k,*idx,nn;
+  PetscInt         Xs,Xe,Ys,Ye,Zs,Ze,pm;
+  PetscInt         i,j,k,*idx,nn;
   PetscInt         n0,n1,n2,n3,n4,n5,n6,n7,n8,n9,n10,n11,n12,n14;
   PetscInt         n15,n16,n17,n18,n19,n20,n21,n22,n23,n24,n25,n26;
-  PetscInt         *bases,*ldims,base,x_t,y_t,z_t,s_t,count,s_x,s_y,s_z;
+  PetscInt         *bases,*ldims,base,x_t,y_t,z_t,s_t,s_x,s_y,s_z;
   PetscInt         sn0  = 0,sn1 = 0,sn2 = 0,sn3 = 0,sn5 = 0,sn6 = 0,sn7 = 0;
   PetscInt         sn8  = 0,sn9 = 0,sn11 = 0,sn15 = 0,sn24 = 0,sn25 = 0,sn26 = 0;
   PetscInt         sn17 = 0,sn18 = 0,sn19 = 0,sn20 = 0,sn21 = 0,sn23 = 0;
-  Vec              local,global;
-  VecScatter       gtol;
-  IS               to,from;
   PetscBool        twod;
   PetscErrorCode   ierr;
 
@@ -362,70 +359,58 @@ PetscErrorCode  DMSetUp_DA_3D(DM da)
   xe = xs + x;
   ze = zs + z;
 
-  /* determine ghost region (Xs) and region scattered into (IXs)  */
+  /* determine ghost region (Xs) */
   if (xs-s > 0) {
-    Xs = xs - s; IXs = xs - s;
+    Xs = xs - s;
   } else {
     if (bx) Xs = xs - s;
     else Xs = 0;
-    IXs = 0;
   }
   if (xe+s <= M) {
-    Xe = xe + s; IXe = xe + s;
+    Xe = xe + s;
   } else {
     if (bx) {
       Xs = xs - s; Xe = xe + s;
     } else Xe = M;
-    IXe = M;
   }
 
   if (bx == DM_BOUNDARY_PERIODIC || bx == DM_BOUNDARY_MIRROR) {
-    IXs = xs - s;
-    IXe = xe + s;
     Xs  = xs - s;
     Xe  = xe + s;
   }
 
   if (ys-s > 0) {
-    Ys = ys - s; IYs = ys - s;
+    Ys = ys - s;
   } else {
     if (by) Ys = ys - s;
     else Ys = 0;
-    IYs = 0;
   }
   if (ye+s <= N) {
-    Ye = ye + s; IYe = ye + s;
+    Ye = ye + s;
   } else {
     if (by) Ye = ye + s;
     else Ye = N;
-    IYe = N;
   }
 
   if (by == DM_BOUNDARY_PERIODIC || by == DM_BOUNDARY_MIRROR) {
-    IYs = ys - s;
-    IYe = ye + s;
     Ys  = ys - s;
     Ye  = ye + s;
   }
 
   if (zs-s > 0) {
-    Zs = zs - s; IZs = zs - s;
+    Zs = zs - s;
   } else {
     if (bz) Zs = zs - s;
     else Zs = 0;
-    IZs = 0;
   }
   if (ze+s <= P) {
-    Ze = ze + s; IZe = ze + s;
+    Ze = ze + s;
   } else {
     if (bz) Ze = ze + s;
     else Ze = P;
-    IZe = P;
   }
 
   if (bz == DM_BOUNDARY_PERIODIC || bz == DM_BOUNDARY_MIRROR) {
-    IZs = zs - s;
-    IZe = ze + s;
     Zs  = zs - s;
     Ze  = ze + s;
   }
@@ -444,65 +429,11 @@ PetscErrorCode  DMSetUp_DA_3D(DM da)
   for (i=1; i<=size; i++) bases[i] += bases[i-1];
   base = bases[rank]*dof;
 
-  /* allocate the base parallel and sequential vectors */
+  /* the sizes of the base parallel and sequential vectors */
   dd->Nlocal = x*y*z*dof;
-  ierr       = VecCreateMPIWithArray(comm,dof,dd->Nlocal,PETSC_DECIDE,NULL,&global);CHKERRQ(ierr);
   dd->nlocal = (Xe-Xs)*(Ye-Ys)*(Ze-Zs)*dof;
-  ierr       = VecCreateSeqWithArray(PETSC_COMM_SELF,dof,dd->nlocal,NULL,&local);CHKERRQ(ierr);
-
-  /* generate global to local vector scatter and local to global mapping*/
-
-  /* global to local must include ghost points within the domain,
-     but not ghost points outside the domain that aren't periodic */
-  ierr   = PetscMalloc1((IXe-IXs)*(IYe-IYs)*(IZe-IZs),&idx);CHKERRQ(ierr);
-  if (stencil_type == DMDA_STENCIL_BOX) {
-    left   = IXs - Xs; right = left + (IXe-IXs);
-    bottom = IYs - Ys; top = bottom + (IYe-IYs);
-    down   = IZs - Zs; up  = down + (IZe-IZs);
-    count  = 0;
-    for (i=down; i<up; i++) {
-      for (j=bottom; j<top; j++) {
-        for (k=left; k<right; k++) {
-          idx[count++] = (i*(Ye-Ys) + j)*(Xe-Xs) + k;
-        }
-      }
-    }
-    ierr = ISCreateBlock(comm,dof,count,idx,PETSC_OWN_POINTER,&to);CHKERRQ(ierr);
-  } else {
-    /* This is way ugly! We need to list the funny cross type region */
-    left   = xs - Xs; right = left + x;
-    bottom = ys - Ys; top = bottom + y;
-    down   = zs - Zs;   up  = down + z;
-    count  = 0;
-    /* the bottom chunk */
-    for (i=(IZs-Zs); i<down; i++) {
-      for (j=bottom; j<top; j++) {
-        for (k=left; k<right; k++) idx[count++] = (i*(Ye-Ys) + j)*(Xe-Xs) + k;
-      }
-    }
-    /* the middle piece */
-    for (i=down; i<up; i++) {
-      /* front */
-      for (j=(IYs-Ys); j<bottom; j++) {
-        for (k=left; k<right; k++) idx[count++] = (i*(Ye-Ys) + j)*(Xe-Xs) + k;
-      }
-      /* middle */
-      for (j=bottom; j<top; j++) {
-        for (k=IXs-Xs; k<IXe-Xs; k++) idx[count++] = (i*(Ye-Ys) + j)*(Xe-Xs) + k;
-      }
-      /* back */
-      for (j=top; j<top+IYe-ye; j++) {
-        for (k=left; k<right; k++) idx[count++] = (i*(Ye-Ys) + j)*(Xe-Xs) + k;
-      }
-    }
-    /* the top piece */
-    for (i=up; i<up+IZe-ze; i++) {
-      for (j=bottom; j<top; j++) {
-        for (k=left; k<right; k++) idx[count++] = (i*(Ye-Ys) + j)*(Xe-Xs) + k;
-      }
-    }
-    ierr = ISCreateBlock(comm,dof,count,idx,PETSC_OWN_POINTER,&to);CHKERRQ(ierr);
-  }
+
+  /* the global to local scatter is built from the local to global mapping only when it is first needed */
 
   /* determine who lies on each side of use stored in    n24 n25 n26
                                                          n21 n22 n23
@@ -1024,12 +955,6 @@ PetscErrorCode  DMSetUp_DA_3D(DM da)
     }
   }
 
-  ierr = ISCreateBlock(comm,dof,nn,idx,PETSC_USE_POINTER,&from);CHKERRQ(ierr);
-  ierr = VecScatterCreate(global,from,local,to,&gtol);CHKERRQ(ierr);
-  ierr = PetscLogObjectParent((PetscObject)da,(PetscObject)gtol);CHKERRQ(ierr);
-  ierr = ISDestroy(&to);CHKERRQ(ierr);
-  ierr = ISDestroy(&from);CHKERRQ(ierr);
-
   if (stencil_type == DMDA_STENCIL_STAR) {
     n0  = sn0;  n1  = sn1;  n2  = sn2;  n3  = sn3;  n5  = sn5;  n6  = sn6; n7 = sn7;
     n8  = sn8;  n9  = sn9;  n11 = sn11; n15 = sn15; n17 = sn17; n18 = sn18;
@@ -1359,10 +1284,7 @@ PetscErrorCode  DMSetUp_DA_3D(DM da)
   dd->xs = xs*dof; dd->xe = xe*dof; dd->ys = ys; dd->ye = ye; dd->zs = zs; dd->ze = ze;
   dd->Xs = Xs*dof; dd->Xe = Xe*dof; dd->Ys = Ys; dd->Ye = Ye; dd->Zs = Zs; dd->Ze = Ze;
 
-  ierr = VecDestroy(&local);CHKERRQ(ierr);
-  ierr = VecDestroy(&global);CHKERRQ(ierr);
 
-  dd->gtol      = gtol;
   dd->base      = base;
   da->ops->view = DMView_DA_3d;
   dd->ltol      = NULL;
@@ -76,6 +76,7 @@ PetscErrorCode  DMSetFromOptions_DA(PetscOptionItems *PetscOptionsObject,DM da)
   }
 
   ierr = PetscOptionsBoundedInt("-da_refine","Uniformly refine DA one or more times","None",refine,&refine,NULL,0);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-da_ghost_exchange_datatypes","Exchange ghost values in DMGlobalToLocal() with MPI datatypes instead of a VecScatter","DMDASetGhostExchangeDatatypes",dd->gtol_datatypes,&dd->gtol_datatypes,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsTail();CHKERRQ(ierr);
 
   while (refine--) {
@@ -4,6 +4,271 @@
 
 #include <petsc/private/dmdaimpl.h>    /*I   "petscdmda.h"   I*/
 
+/*
+  Describe the exchange with each neighbor: the ghost region in direction d is received from the neighbor in that
+  direction, which sends the strip of width s of its owned box adjacent to this process.
+*/
+static PetscErrorCode DMDAGhostExchangeSetUp_Private(DM da)
+{
+  DM_DA             *dd = (DM_DA*)da->data;
+  DMDAGhostExchange *gx;
+  DMBoundaryType    bnd[3];
+  MPI_Datatype      unit;
+  PetscMPIInt       rank,pc[3],np[3],nc[3],nrank,owned[3],ghosted[3],ssub[3],sstart[3],rsub[3],rstart[3],tags[27];
+  PetscInt          xs[3],xm[3],gxs[3],gxm[3],dim = da->dim,s = dd->s,d[3],nd,n = 0,i;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscNew(&gx);CHKERRQ(ierr);
+  ierr = PetscMalloc6(26,&gx->ranks,26,&gx->stags,26,&gx->rtags,26,&gx->stypes,26,&gx->rtypes,52,&gx->reqs);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)da),&rank);CHKERRMPI(ierr);
+  ierr = DMDAGetCorners(da,&xs[0],&xs[1],&xs[2],&xm[0],&xm[1],&xm[2]);CHKERRQ(ierr);
+  ierr = DMDAGetGhostCorners(da,&gxs[0],&gxs[1],&gxs[2],&gxm[0],&gxm[1],&gxm[2]);CHKERRQ(ierr);
+  np[0]  = (PetscMPIInt)dd->m; np[1] = (PetscMPIInt)dd->n; np[2] = (PetscMPIInt)dd->p;
+  pc[0]  = rank % np[0]; pc[1] = (rank/np[0]) % np[1]; pc[2] = rank/(np[0]*np[1]);
+  bnd[0] = dd->bx; bnd[1] = dd->by; bnd[2] = dd->bz;
+  /* one tag per direction, from the communicator of the DM so that they do not collide with other messages */
+  for (i = 0; i < 27; ++i) {ierr = PetscObjectGetNewTag((PetscObject)da,&tags[i]);CHKERRQ(ierr);}
+  ierr = MPI_Type_contiguous((PetscMPIInt)dd->w,MPIU_SCALAR,&unit);CHKERRMPI(ierr);
+  /* MPI_ORDER_C lists the dimensions slowest first */
+  for (i = 0; i < 3; ++i) {owned[2-i] = (PetscMPIInt)xm[i]; ghosted[2-i] = (PetscMPIInt)gxm[i];}
+  for (d[2] = (dim > 2 ? -1 : 0); d[2] <= (dim > 2 ? 1 : 0); ++d[2]) {
+    for (d[1] = (dim > 1 ? -1 : 0); d[1] <= (dim > 1 ? 1 : 0); ++d[1]) {
+      for (d[0] = -1; d[0] <= 1; ++d[0]) {
+        nd = (d[0] != 0) + (d[1] != 0) + (d[2] != 0);
+        if (!nd || (dd->stencil_type == DMDA_STENCIL_STAR && nd > 1)) continue;
+        for (i = 0; i < 3; ++i) {
+          nc[i] = pc[i] + (PetscMPIInt)d[i];
+          if (nc[i] < 0 || nc[i] >= np[i]) {
+            if (bnd[i] != DM_BOUNDARY_PERIODIC) break;
+            nc[i] = (nc[i] + np[i]) % np[i];
+          }
+          if (!d[i]) {
+            ssub[2-i] = rsub[2-i] = (PetscMPIInt)xm[i];
+            sstart[2-i] = 0;
+            rstart[2-i] = (PetscMPIInt)(xs[i]-gxs[i]);
+          } else {
+            ssub[2-i]   = rsub[2-i] = (PetscMPIInt)s;
+            sstart[2-i] = d[i] < 0 ? 0 : (PetscMPIInt)(xm[i]-s);
+            rstart[2-i] = d[i] < 0 ? 0 : (PetscMPIInt)(xs[i]-gxs[i]+xm[i]);
+          }
+        }
+        if (i < 3 || !s) continue;
+        nrank = nc[0] + np[0]*(nc[1] + np[1]*nc[2]);
+        gx->ranks[n] = nrank;
+        /* messages are tagged with the direction of the sender as seen from the receiver */
+        gx->rtags[n] = tags[(d[0]+1) + 3*(d[1]+1) + 9*(d[2]+1)];
+        gx->stags[n] = tags[(1-d[0]) + 3*(1-d[1]) + 9*(1-d[2])];
+        ierr = MPI_Type_create_subarray(3,owned,ssub,sstart,MPI_ORDER_C,unit,&gx->stypes[n]);CHKERRMPI(ierr);
+        ierr = MPI_Type_commit(&gx->stypes[n]);CHKERRMPI(ierr);
+        ierr = MPI_Type_create_subarray(3,ghosted,rsub,rstart,MPI_ORDER_C,unit,&gx->rtypes[n]);CHKERRMPI(ierr);
+        ierr = MPI_Type_commit(&gx->rtypes[n]);CHKERRMPI(ierr);
+        ++n;
+      }
+    }
+  }
+  ierr = MPI_Type_free(&unit);CHKERRMPI(ierr);
+  gx->n     = n;
+  dd->gexch = gx;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode DMDAGhostExchangeDestroy_Private(DM da)
+{
+  DM_DA             *dd = (DM_DA*)da->data;
+  DMDAGhostExchange *gx = dd->gexch;
+  PetscInt          i;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (!gx) PetscFunctionReturn(0);
+  for (i = 0; i < gx->n; ++i) {
+    ierr = MPI_Type_free(&gx->stypes[i]);CHKERRMPI(ierr);
+    ierr = MPI_Type_free(&gx->rtypes[i]);CHKERRMPI(ierr);
+  }
+  ierr = PetscFree6(gx->ranks,gx->stags,gx->rtags,gx->stypes,gx->rtypes,gx->reqs);CHKERRQ(ierr);
+  ierr = PetscFree(dd->gexch);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+  Creates the global to local scatter from the local to global mapping on first use, so that its index arrays are
+  only allocated when something needs it: DMGlobalToLocal() without the MPI datatypes, DMLocalToGlobal(),
+  DMLocalToLocal() or DMDAGetScatter(). It fills the local points with a global index, except the corners of the
+  ghost region of a star stencil.
+*/
+PetscErrorCode DMDACreateGlobalToLocal_Private(DM da)
+{
+  DM_DA                  *dd = (DM_DA*)da->data;
+  const PetscInt         dof = dd->w,xs = dd->xs/dof,xe = dd->xe/dof,Xs = dd->Xs/dof,Xe = dd->Xe/dof;
+  const PetscInt         *ltog;
+  PetscInt               *fromidx,*toidx,i,j,k,l,n = 0,nout;
+  MPI_Comm               comm;
+  Vec                    global,local;
+  IS                     from,to;
+  PetscErrorCode         ierr;
+
+  PetscFunctionBegin;
+  if (dd->gtol) PetscFunctionReturn(0);
+  if (!da->ltogmap) SETERRQ(PetscObjectComm((PetscObject)da),PETSC_ERR_ARG_WRONGSTATE,"DMSetUp() has not been called");
+  ierr = PetscObjectGetComm((PetscObject)da,&comm);CHKERRQ(ierr);
+  ierr = ISLocalToGlobalMappingGetBlockIndices(da->ltogmap,&ltog);CHKERRQ(ierr);
+  ierr = PetscMalloc2(dd->nlocal/dof,&fromidx,dd->nlocal/dof,&toidx);CHKERRQ(ierr);
+  for (k = dd->Zs, l = 0; k < dd->Ze; ++k) {
+    for (j = dd->Ys; j < dd->Ye; ++j) {
+      for (i = Xs; i < Xe; ++i, ++l) {
+        if (ltog[l] < 0) continue;
+        nout = (i < xs || i >= xe) + (j < dd->ys || j >= dd->ye) + (k < dd->zs || k >= dd->ze);
+        if (dd->stencil_type == DMDA_STENCIL_STAR && nout > 1) continue;
+        fromidx[n] = ltog[l];
+        toidx[n++] = l;
+      }
+    }
+  }
+  ierr = ISLocalToGlobalMappingRestoreBlockIndices(da->ltogmap,&ltog);CHKERRQ(ierr);
+  ierr = ISCreateBlock(comm,dof,n,fromidx,PETSC_USE_POINTER,&from);CHKERRQ(ierr);
+  ierr = ISCreateBlock(comm,dof,n,toidx,PETSC_USE_POINTER,&to);CHKERRQ(ierr);
+  ierr = VecCreateMPIWithArray(comm,dof,dd->Nlocal,PETSC_DECIDE,NULL,&global);CHKERRQ(ierr);
+  ierr = VecCreateSeqWithArray(PETSC_COMM_SELF,dof,dd->nlocal,NULL,&local);CHKERRQ(ierr);
+  ierr = VecScatterCreate(global,from,local,to,&dd->gtol);CHKERRQ(ierr);
+  ierr = PetscLogObjectParent((PetscObject)da,(PetscObject)dd->gtol);CHKERRQ(ierr);
+  ierr = VecDestroy(&local);CHKERRQ(ierr);
+  ierr = VecDestroy(&global);CHKERRQ(ierr);
+  ierr = ISDestroy(&to);CHKERRQ(ierr);
+  ierr = ISDestroy(&from);CHKERRQ(ierr);
+  ierr = PetscFree2(fromidx,toidx);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* the ghost exchange with datatypes is used for the common case of a plain DMDA */
+static PetscBool DMDAUseGhostExchange_Private(DM da,InsertMode mode)
+{
+  DM_DA *dd = (DM_DA*)da->data;
+
+  if (!dd->gtol_datatypes || mode != INSERT_VALUES) return PETSC_FALSE;
+  if (dd->bx == DM_BOUNDARY_MIRROR || dd->by == DM_BOUNDARY_MIRROR || dd->bz == DM_BOUNDARY_MIRROR) return PETSC_FALSE;
+  if (dd->xol || dd->yol || dd->zol) return PETSC_FALSE;
+  return PETSC_TRUE;
+}
+
+static PetscErrorCode DMDAGhostExchangeBegin_Private(DM da,Vec g,Vec l)
+{
+  DM_DA             *dd = (DM_DA*)da->data;
+  DMDAGhostExchange *gx;
+  MPI_Comm          comm;
+  PetscInt          xs,ys,zs,xm,ym,zm,gxs,gys,gzs,gxm,gym,gzm,j,k,i;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (!dd->gexch) {ierr = DMDAGhostExchangeSetUp_Private(da);CHKERRQ(ierr);}
+  gx = dd->gexch;
+  if (gx->g) SETERRQ(PetscObjectComm((PetscObject)da),PETSC_ERR_ORDER,"DMGlobalToLocalEnd() must be called before starting another exchange");
+  ierr = PetscObjectGetComm((PetscObject)da,&comm);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(g,&gx->garray);CHKERRQ(ierr);
+  ierr = VecGetArray(l,&gx->larray);CHKERRQ(ierr);
+  gx->g = g;
+  gx->l = l;
+  for (i = 0; i < gx->n; ++i) {
+    ierr = MPI_Irecv(gx->larray,1,gx->rtypes[i],gx->ranks[i],gx->rtags[i],comm,&gx->reqs[i]);CHKERRMPI(ierr);
+  }
+  for (i = 0; i < gx->n; ++i) {
+    ierr = MPI_Isend((void*)gx->garray,1,gx->stypes[i],gx->ranks[i],gx->stags[i],comm,&gx->reqs[gx->n+i]);CHKERRMPI(ierr);
+  }
+  /* copy the owned values row by row while the messages are in flight */
+  ierr = DMDAGetCorners(da,&xs,&ys,&zs,&xm,&ym,&zm);CHKERRQ(ierr);
+  ierr = DMDAGetGhostCorners(da,&gxs,&gys,&gzs,&gxm,&gym,&gzm);CHKERRQ(ierr);
+  for (k = 0; k < zm; ++k) {
+    for (j = 0; j < ym; ++j) {
+      ierr = PetscArraycpy(gx->larray + dd->w*((xs-gxs) + gxm*((j+ys-gys) + gym*(k+zs-gzs))),gx->garray + dd->w*xm*(j + ym*k),dd->w*xm);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode DMDAGhostExchangeEnd_Private(DM da,Vec g,Vec l)
+{
+  DM_DA             *dd = (DM_DA*)da->data;
+  DMDAGhostExchange *gx = dd->gexch;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (!gx || gx->g != g || gx->l != l) SETERRQ(PetscObjectComm((PetscObject)da),PETSC_ERR_ARG_WRONG,"DMGlobalToLocalEnd() must be called with the vectors given to DMGlobalToLocalBegin()");
+  ierr = MPI_Waitall((PetscMPIInt)(2*gx->n),gx->reqs,MPI_STATUSES_IGNORE);CHKERRMPI(ierr);
+  ierr = VecRestoreArray(l,&gx->larray);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(g,&gx->garray);CHKERRQ(ierr);
+  gx->g = NULL;
+  gx->l = NULL;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   DMDASetGhostExchangeDatatypes - Sets whether DMGlobalToLocalBegin() and DMGlobalToLocalEnd() exchange the ghost
+   values with MPI derived datatypes instead of the VecScatter built from index lists
+
+   Logically Collective on da
+
+   Input Parameters:
++  da - the distributed array
+-  flg - PETSC_TRUE to use MPI datatypes
+
+   Options Database:
+.  -da_ghost_exchange_datatypes - use MPI datatypes for the ghost exchange
+
+   Level: advanced
+
+   Notes:
+   Each face, and for a box stencil each edge and corner, of the ghost region is described by an MPI subarray
+   datatype of the owned box of the neighbor and of the ghosted box of the receiver, so the values are sent straight
+   from the global vector into the local vector with no index arrays and no packing by PETSc. The owned values are
+   copied into the local vector while the messages are in flight.
+
+   This is only used for INSERT_VALUES, and not with DM_BOUNDARY_MIRROR or overlapping subdomains, where the
+   VecScatter is used as before. The vectors given to DMGlobalToLocalBegin() must be passed to DMGlobalToLocalEnd(),
+   and their arrays must not be accessed in between.
+
+   The VecScatter is built from the local to global mapping the first time it is needed, so a DMDA that only
+   exchanges ghost values with the datatypes never allocates its index arrays.
+
+.seealso: DMGlobalToLocalBegin(), DMGlobalToLocalEnd(), DMDAGetGhostExchangeDatatypes()
+@*/
+PetscErrorCode DMDASetGhostExchangeDatatypes(DM da,PetscBool flg)
+{
+  DM_DA *dd = (DM_DA*)da->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecificType(da,DM_CLASSID,1,DMDA);
+  PetscValidLogicalCollectiveBool(da,flg,2);
+  dd->gtol_datatypes = flg;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   DMDAGetGhostExchangeDatatypes - Gets whether DMGlobalToLocalBegin() and DMGlobalToLocalEnd() exchange the ghost
+   values with MPI derived datatypes
+
+   Not Collective
+
+   Input Parameter:
+.  da - the distributed array
+
+   Output Parameter:
+.  flg - PETSC_TRUE if MPI datatypes are used
+
+   Level: advanced
+
+.seealso: DMDASetGhostExchangeDatatypes()
+@*/
+PetscErrorCode DMDAGetGhostExchangeDatatypes(DM da,PetscBool *flg)
+{
+  DM_DA *dd = (DM_DA*)da->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecificType(da,DM_CLASSID,1,DMDA);
+  PetscValidBoolPointer(flg,2);
+  *flg = dd->gtol_datatypes;
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode  DMGlobalToLocalBegin_DA(DM da,Vec g,InsertMode mode,Vec l)
 {
   PetscErrorCode ierr;
@@ -13,7 +278,12 @@ PetscErrorCode  DMGlobalToLocalBegin_DA(DM da,Vec g,InsertMode mode,Vec l)
   PetscValidHeaderSpecific(da,DM_CLASSID,1);
   PetscValidHeaderSpecific(g,VEC_CLASSID,2);
   PetscValidHeaderSpecific(l,VEC_CLASSID,4);
-  ierr = VecScatterBegin(dd->gtol,g,l,mode,SCATTER_FORWARD);CHKERRQ(ierr);
+  if (DMDAUseGhostExchange_Private(da,mode)) {
+    ierr = DMDAGhostExchangeBegin_Private(da,g,l);CHKERRQ(ierr);
+  } else {
+    ierr = DMDACreateGlobalToLocal_Private(da);CHKERRQ(ierr);
+    ierr = VecScatterBegin(dd->gtol,g,l,mode,SCATTER_FORWARD);CHKERRQ(ierr);
+  }
   PetscFunctionReturn(0);
 }
 
@@ -26,7 +296,11 @@ PetscErrorCode  DMGlobalToLocalEnd_DA(DM da,Vec g,InsertMode mode,Vec l)
   PetscValidHeaderSpecific(da,DM_CLASSID,1);
   PetscValidHeaderSpecific(g,VEC_CLASSID,2);
   PetscValidHeaderSpecific(l,VEC_CLASSID,4);
-  ierr = VecScatterEnd(dd->gtol,g,l,mode,SCATTER_FORWARD);CHKERRQ(ierr);
+  if (DMDAUseGhostExchange_Private(da,mode)) {
+    ierr = DMDAGhostExchangeEnd_Private(da,g,l);CHKERRQ(ierr);
+  } else {
+    ierr = VecScatterEnd(dd->gtol,g,l,mode,SCATTER_FORWARD);CHKERRQ(ierr);
+  }
   PetscFunctionReturn(0);
 }
 
@@ -39,6 +313,7 @@ PetscErrorCode  DMLocalToGlobalBegin_DA(DM da,Vec l,InsertMode mode,Vec g)
   PetscValidHeaderSpecific(da,DM_CLASSID,1);
   PetscValidHeaderSpecific(l,VEC_CLASSID,2);
   PetscValidHeaderSpecific(g,VEC_CLASSID,4);
+  ierr = DMDACreateGlobalToLocal_Private(da);CHKERRQ(ierr);
   if (mode == ADD_VALUES) {
     ierr = VecScatterBegin(dd->gtol,l,g,ADD_VALUES,SCATTER_REVERSE);CHKERRQ(ierr);
   } else if (mode == INSERT_VALUES) {
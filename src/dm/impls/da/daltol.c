@@ -29,6 +29,7 @@ PetscErrorCode  DMLocalToLocalCreate_DA(DM da)
      global to local to read from an array with the ghost values
      rather then from the plain array.
   */
+  ierr = DMDACreateGlobalToLocal_Private(da);CHKERRQ(ierr);
   ierr = VecScatterCopy(dd->gtol,&dd->ltol);CHKERRQ(ierr);
   ierr = PetscLogObjectParent((PetscObject)da,(PetscObject)dd->ltol);CHKERRQ(ierr);
   if (dim == 1) {
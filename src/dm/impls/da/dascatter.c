@@ -34,7 +34,10 @@ PetscErrorCode  DMDAGetScatter(DM da,VecScatter *gtol,VecScatter *ltol)
 
   PetscFunctionBegin;
   PetscValidHeaderSpecificType(da,DM_CLASSID,1,DMDA);
-  if (gtol) *gtol = dd->gtol;
+  if (gtol) {
+    ierr  = DMDACreateGlobalToLocal_Private(da);CHKERRQ(ierr);
+    *gtol = dd->gtol;
+  }
   if (ltol) {
     if (!dd->ltol) {
       ierr = DMLocalToLocalCreate_DA(da);CHKERRQ(ierr);
@@ -0,0 +1,392 @@
+/*
+  Matrix-free application of a stencil operator on a DMDA
+*/
+
+#include <petsc/private/dmdaimpl.h>    /*I   "petscdmda.h"   I*/
+
+typedef struct {
+  DM          da;
+  PetscInt    xs,ys,zs,xm,ym,zm;         /* owned box */
+  PetscInt    gxs,gys,gzs,gxm,gym,gzm;   /* ghosted box */
+  PetscInt    sx,sy,sz;                  /* stencil width in each direction, 0 beyond the dimension */
+  PetscInt    nq;                        /* number of stencil points */
+  PetscInt    *off;                      /* (i,j,k) offset of each stencil point */
+  PetscInt    *offo;                     /* linear offset of each stencil point in the owned array */
+  PetscInt    qcenter;                   /* the stencil point with zero offset */
+  PetscScalar *coeff;                    /* nq constant coefficients, or NULL */
+  PetscScalar *vcoeff;                   /* variable coefficients, stored coefficient by coefficient over the owned points */
+  PetscInt    tx,ty;                     /* tile sizes for the interior sweep */
+  Vec         xl;                        /* ghosted work vector; only its ghost entries are ever written */
+  VecScatter  ghosts;                    /* fills the ghost entries of xl from a global vector */
+} DMDAStencilOp;
+
+/*
+  Enumerate the stencil of the DMDA, with the x offset varying fastest. A star stencil keeps only the points
+  with at most one nonzero offset.
+*/
+static PetscErrorCode DMDAGetStencilOffsets_Private(DM da,PetscInt *npoints,PetscInt **offsets)
+{
+  DM_DA          *dd = (DM_DA*)da->data;
+  PetscInt       sx,sy,sz,di,dj,dk,n = 0;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  sx = dd->s;
+  sy = da->dim > 1 ? dd->s : 0;
+  sz = da->dim > 2 ? dd->s : 0;
+  ierr = PetscMalloc1(3*(2*sx+1)*(2*sy+1)*(2*sz+1),offsets);CHKERRQ(ierr);
+  for (dk = -sz; dk <= sz; ++dk) {
+    for (dj = -sy; dj <= sy; ++dj) {
+      for (di = -sx; di <= sx; ++di) {
+        if (dd->stencil_type == DMDA_STENCIL_STAR && ((di != 0) + (dj != 0) + (dk != 0)) > 1) continue;
+        (*offsets)[3*n+0] = di;
+        (*offsets)[3*n+1] = dj;
+        (*offsets)[3*n+2] = dk;
+        ++n;
+      }
+    }
+  }
+  *npoints = n;
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   DMDAGetStencilOffsets - Gets the offsets of the points of the stencil of a DMDA, in the order expected by
+   DMDACreateStencilOperator()
+
+   Not Collective
+
+   Input Parameter:
+.  da - the distributed array, with one degree of freedom per node
+
+   Output Parameters:
++  npoints - the number of stencil points
+-  offsets - the offsets (i, j, k) of the stencil points relative to the center, dim entries per point, free with PetscFree()
+
+   Level: intermediate
+
+   Notes:
+   The points are ordered with the x offset varying fastest, so for a box stencil of width s in 2d point
+   (s+di) + (2s+1)(s+dj) has offset (di, dj). A star stencil keeps the points of the box with at most one nonzero offset,
+   in the same order.
+
+.seealso: DMDACreateStencilOperator(), DMDAGetStencilWidth(), DMDAGetStencilType()
+@*/
+PetscErrorCode DMDAGetStencilOffsets(DM da,PetscInt *npoints,PetscInt *offsets[])
+{
+  PetscInt       *off,n,q,d,dim;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecificType(da,DM_CLASSID,1,DMDA);
+  PetscValidIntPointer(npoints,2);
+  ierr = DMGetDimension(da,&dim);CHKERRQ(ierr);
+  ierr = DMDAGetStencilOffsets_Private(da,&n,&off);CHKERRQ(ierr);
+  *npoints = n;
+  if (offsets) {
+    ierr = PetscMalloc1(dim*n,offsets);CHKERRQ(ierr);
+    for (q = 0; q < n; ++q) for (d = 0; d < dim; ++d) (*offsets)[q*dim+d] = off[3*q+d];
+  }
+  ierr = PetscFree(off);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* y[0:n) = sum_q c_q x[off[q] + 0:n), with constant or variable (stride cstride) coefficients */
+static void DMDAStencilOpRow_Private(PetscInt n,PetscInt nq,const PetscInt off[],const PetscScalar *coeff,const PetscScalar *vcoeff,PetscInt cstride,const PetscScalar *x,PetscScalar *y)
+{
+  PetscInt i,q;
+
+  for (i = 0; i < n; ++i) y[i] = 0.0;
+  if (coeff) {
+    for (q = 0; q < nq; ++q) {
+      const PetscScalar c = coeff[q],*xq = x + off[q];
+
+      PetscPragmaSIMD
+      for (i = 0; i < n; ++i) y[i] += c*xq[i];
+    }
+  } else {
+    for (q = 0; q < nq; ++q) {
+      const PetscScalar *c = vcoeff + q*cstride,*xq = x + off[q];
+
+      PetscPragmaSIMD
+      for (i = 0; i < n; ++i) y[i] += c[i]*xq[i];
+    }
+  }
+}
+
+/* the points whose whole stencil lies in the owned box, traversed in tiles of tx by ty points in the x-y plane */
+static PetscErrorCode DMDAStencilOpInterior_Private(DMDAStencilOp *op,const PetscScalar *x,PetscScalar *y)
+{
+  const PetscInt xm = op->xm,ym = op->ym,zm = op->zm,nowned = xm*ym*zm;
+  const PetscInt i0 = op->sx,i1 = xm-op->sx,j0 = op->sy,j1 = ym-op->sy,k0 = op->sz,k1 = zm-op->sz;
+  PetscInt       it,jt,j,k;
+
+  PetscFunctionBegin;
+  if (i1 <= i0 || j1 <= j0 || k1 <= k0) PetscFunctionReturn(0);
+  for (jt = j0; jt < j1; jt += op->ty) {
+    const PetscInt je = PetscMin(jt+op->ty,j1);
+
+    for (it = i0; it < i1; it += op->tx) {
+      const PetscInt ie = PetscMin(it+op->tx,i1);
+
+      for (k = k0; k < k1; ++k) {
+        for (j = jt; j < je; ++j) {
+          const PetscInt p = it + xm*(j + ym*k);
+
+          DMDAStencilOpRow_Private(ie-it,op->nq,op->offo,op->coeff,op->vcoeff ? op->vcoeff + p : NULL,nowned,x + p,y + p);
+        }
+      }
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/* y at one owned point near the edge of the owned box, reading owned values from x and ghost values from xl */
+PETSC_STATIC_INLINE PetscScalar DMDAStencilOpPoint_Private(DMDAStencilOp *op,PetscInt i,PetscInt j,PetscInt k,const PetscScalar *x,const PetscScalar *xl)
+{
+  const PetscInt p = i + op->xm*(j + op->ym*k),nowned = op->xm*op->ym*op->zm;
+  PetscScalar    sum = 0.0,v;
+  PetscInt       q,ii,jj,kk,gi,gj,gk;
+
+  for (q = 0; q < op->nq; ++q) {
+    ii = i + op->off[3*q]; jj = j + op->off[3*q+1]; kk = k + op->off[3*q+2];
+    if (ii >= 0 && ii < op->xm && jj >= 0 && jj < op->ym && kk >= 0 && kk < op->zm) v = x[p + op->offo[q]];
+    else {
+      gi = ii + op->xs - op->gxs; gj = jj + op->ys - op->gys; gk = kk + op->zs - op->gzs;
+      /* neighbours beyond a non-periodic boundary are zero */
+      if (gi < 0 || gi >= op->gxm || gj < 0 || gj >= op->gym || gk < 0 || gk >= op->gzm) continue;
+      v = xl[gi + op->gxm*(gj + op->gym*gk)];
+    }
+    sum += (op->coeff ? op->coeff[q] : op->vcoeff[q*nowned + p])*v;
+  }
+  return sum;
+}
+
+/* the owned points within the stencil width of the edge of the owned box */
+static PetscErrorCode DMDAStencilOpBoundary_Private(DMDAStencilOp *op,const PetscScalar *x,const PetscScalar *xl,PetscScalar *y)
+{
+  const PetscInt xm = op->xm,ym = op->ym,zm = op->zm;
+  const PetscInt i0 = PetscMin(op->sx,xm),i1 = PetscMax(xm-op->sx,i0);
+  PetscInt       i,j,k;
+
+  PetscFunctionBegin;
+  for (k = 0; k < zm; ++k) {
+    for (j = 0; j < ym; ++j) {
+      const PetscBool inner = (PetscBool)(j >= op->sy && j < ym-op->sy && k >= op->sz && k < zm-op->sz);
+
+      if (inner) {
+        for (i = 0; i < i0; ++i) y[i + xm*(j + ym*k)] = DMDAStencilOpPoint_Private(op,i,j,k,x,xl);
+        for (i = i1; i < xm; ++i) y[i + xm*(j + ym*k)] = DMDAStencilOpPoint_Private(op,i,j,k,x,xl);
+      } else {
+        for (i = 0; i < xm; ++i) y[i + xm*(j + ym*k)] = DMDAStencilOpPoint_Private(op,i,j,k,x,xl);
+      }
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatMult_DMDAStencil(Mat A,Vec x,Vec y)
+{
+  DMDAStencilOp     *op;
+  const PetscScalar *xa,*xla;
+  PetscScalar       *ya;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(A,&op);CHKERRQ(ierr);
+  /* the owned values are read in place, only the ghosts are communicated, and the interior is computed meanwhile */
+  ierr = VecScatterBegin(op->ghosts,x,op->xl,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(x,&xa);CHKERRQ(ierr);
+  ierr = VecGetArray(y,&ya);CHKERRQ(ierr);
+  ierr = DMDAStencilOpInterior_Private(op,xa,ya);CHKERRQ(ierr);
+  ierr = VecScatterEnd(op->ghosts,x,op->xl,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(op->xl,&xla);CHKERRQ(ierr);
+  ierr = DMDAStencilOpBoundary_Private(op,xa,xla,ya);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(op->xl,&xla);CHKERRQ(ierr);
+  ierr = VecRestoreArray(y,&ya);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(x,&xa);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*op->nq*op->xm*op->ym*op->zm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatGetDiagonal_DMDAStencil(Mat A,Vec d)
+{
+  DMDAStencilOp  *op;
+  PetscScalar    *da;
+  PetscInt       nowned;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(A,&op);CHKERRQ(ierr);
+  if (op->coeff) {
+    ierr = VecSet(d,op->coeff[op->qcenter]);CHKERRQ(ierr);
+  } else {
+    nowned = op->xm*op->ym*op->zm;
+    ierr = VecGetArray(d,&da);CHKERRQ(ierr);
+    ierr = PetscArraycpy(da,op->vcoeff + op->qcenter*nowned,nowned);CHKERRQ(ierr);
+    ierr = VecRestoreArray(d,&da);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatDestroy_DMDAStencil(Mat A)
+{
+  DMDAStencilOp  *op;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(A,&op);CHKERRQ(ierr);
+  ierr = VecScatterDestroy(&op->ghosts);CHKERRQ(ierr);
+  ierr = VecDestroy(&op->xl);CHKERRQ(ierr);
+  ierr = PetscFree2(op->off,op->offo);CHKERRQ(ierr);
+  ierr = PetscFree(op->coeff);CHKERRQ(ierr);
+  ierr = PetscFree(op->vcoeff);CHKERRQ(ierr);
+  ierr = DMDestroy(&op->da);CHKERRQ(ierr);
+  ierr = PetscFree(op);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* scatter from a global vector to the ghost entries of the ghosted work vector, leaving its owned entries alone */
+static PetscErrorCode DMDAStencilOpCreateGhostScatter_Private(DM da,DMDAStencilOp *op)
+{
+  ISLocalToGlobalMapping ltog;
+  const PetscInt         *gidx;
+  PetscInt               *from,*to,n = 0,i,j,k,l;
+  IS                     isfrom,isto;
+  Vec                    g;
+  PetscErrorCode         ierr;
+
+  PetscFunctionBegin;
+  ierr = DMGetLocalToGlobalMapping(da,&ltog);CHKERRQ(ierr);
+  ierr = ISLocalToGlobalMappingGetIndices(ltog,&gidx);CHKERRQ(ierr);
+  ierr = PetscMalloc2(op->gxm*op->gym*op->gzm,&from,op->gxm*op->gym*op->gzm,&to);CHKERRQ(ierr);
+  for (k = op->gzs; k < op->gzs+op->gzm; ++k) {
+    for (j = op->gys; j < op->gys+op->gym; ++j) {
+      for (i = op->gxs; i < op->gxs+op->gxm; ++i) {
+        if (i >= op->xs && i < op->xs+op->xm && j >= op->ys && j < op->ys+op->ym && k >= op->zs && k < op->zs+op->zm) continue;
+        l = (i-op->gxs) + op->gxm*((j-op->gys) + op->gym*(k-op->gzs));
+        if (gidx[l] < 0) continue;
+        from[n] = gidx[l];
+        to[n]   = l;
+        ++n;
+      }
+    }
+  }
+  ierr = ISLocalToGlobalMappingRestoreIndices(ltog,&gidx);CHKERRQ(ierr);
+  ierr = ISCreateGeneral(PETSC_COMM_SELF,n,from,PETSC_COPY_VALUES,&isfrom);CHKERRQ(ierr);
+  ierr = ISCreateGeneral(PETSC_COMM_SELF,n,to,PETSC_COPY_VALUES,&isto);CHKERRQ(ierr);
+  ierr = PetscFree2(from,to);CHKERRQ(ierr);
+  ierr = DMGetGlobalVector(da,&g);CHKERRQ(ierr);
+  ierr = VecScatterCreate(g,isfrom,op->xl,isto,&op->ghosts);CHKERRQ(ierr);
+  ierr = DMRestoreGlobalVector(da,&g);CHKERRQ(ierr);
+  ierr = ISDestroy(&isfrom);CHKERRQ(ierr);
+  ierr = ISDestroy(&isto);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   DMDACreateStencilOperator - Creates a matrix-free operator that applies a constant or variable coefficient
+   stencil on a DMDA
+
+   Collective on da
+
+   Input Parameters:
++  da - the distributed array, with one degree of freedom per node
+.  coeff - the constant coefficients, one per stencil point, or NULL
+-  vcoeff - the variable coefficients, or NULL; a global vector of a DMDA with the same layout as da and one degree
+            of freedom per stencil point, see DMDACreateCompatibleDMDA()
+
+   Output Parameter:
+.  A - the MATSHELL applying the stencil
+
+   Options Database:
+.  -da_stencil_operator_tile <tx,ty> - the size of the tiles of the x-y plane traversed by the sweep over the interior
+
+   Level: intermediate
+
+   Notes:
+   Exactly one of coeff and vcoeff must be given. The stencil is the one of the DMDA, see DMDASetStencilType() and
+   DMDASetStencilWidth(), with its points in the order given by DMDAGetStencilOffsets(). The coefficients are copied,
+   so later changes to coeff or vcoeff are not seen by the operator.
+
+   Neighbours beyond a boundary that is not periodic are taken to be zero, so the operator equals the matrix obtained
+   by MatSetValuesStencil() on the matrix from DMCreateMatrix() when the entries coupling to points outside the
+   domain are dropped.
+
+   MatMult() starts the ghost exchange, applies the stencil to the points whose whole stencil is owned while the
+   messages are in flight, reading the input vector in place, and then finishes the points near the edge of the owned
+   box. Only the ghost values are communicated: the owned values are never copied into a local vector.
+   MatGetDiagonal() is also supported, so the operator can be used with Jacobi smoothing.
+
+.seealso: DMDAGetStencilOffsets(), DMCreateMatrix(), MatCreateShell(), DMDACreateCompatibleDMDA()
+@*/
+PetscErrorCode DMDACreateStencilOperator(DM da,const PetscScalar coeff[],Vec vcoeff,Mat *A)
+{
+  DM_DA             *dd = (DM_DA*)da->data;
+  DMDAStencilOp     *op;
+  const PetscScalar *va;
+  PetscInt          dim,dof,q,p,nowned,nloc,tile[2],ntile = 2;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecificType(da,DM_CLASSID,1,DMDA);
+  if (vcoeff) PetscValidHeaderSpecific(vcoeff,VEC_CLASSID,3);
+  PetscValidPointer(A,4);
+  if (!coeff == !vcoeff) SETERRQ(PetscObjectComm((PetscObject)da),PETSC_ERR_ARG_WRONG,"Exactly one of constant or variable coefficients must be given");
+  ierr = DMGetDimension(da,&dim);CHKERRQ(ierr);
+  ierr = DMDAGetInfo(da,NULL,NULL,NULL,NULL,NULL,NULL,NULL,&dof,NULL,NULL,NULL,NULL,NULL);CHKERRQ(ierr);
+  if (dof != 1) SETERRQ1(PetscObjectComm((PetscObject)da),PETSC_ERR_SUP,"Stencil operators require one degree of freedom per node, not %D",dof);
+
+  ierr = PetscNew(&op);CHKERRQ(ierr);
+  ierr = PetscObjectReference((PetscObject)da);CHKERRQ(ierr);
+  op->da = da;
+  ierr = DMDAGetCorners(da,&op->xs,&op->ys,&op->zs,&op->xm,&op->ym,&op->zm);CHKERRQ(ierr);
+  ierr = DMDAGetGhostCorners(da,&op->gxs,&op->gys,&op->gzs,&op->gxm,&op->gym,&op->gzm);CHKERRQ(ierr);
+  op->sx = dd->s;
+  op->sy = dim > 1 ? dd->s : 0;
+  op->sz = dim > 2 ? dd->s : 0;
+  nowned = op->xm*op->ym*op->zm;
+
+  {
+    PetscInt *off;
+
+    ierr = DMDAGetStencilOffsets_Private(da,&op->nq,&off);CHKERRQ(ierr);
+    ierr = PetscMalloc2(3*op->nq,&op->off,op->nq,&op->offo);CHKERRQ(ierr);
+    ierr = PetscArraycpy(op->off,off,3*op->nq);CHKERRQ(ierr);
+    ierr = PetscFree(off);CHKERRQ(ierr);
+  }
+  for (q = 0; q < op->nq; ++q) {
+    op->offo[q] = op->off[3*q] + op->xm*(op->off[3*q+1] + op->ym*op->off[3*q+2]);
+    if (!op->off[3*q] && !op->off[3*q+1] && !op->off[3*q+2]) op->qcenter = q;
+  }
+  if (coeff) {
+    ierr = PetscMalloc1(op->nq,&op->coeff);CHKERRQ(ierr);
+    ierr = PetscArraycpy(op->coeff,coeff,op->nq);CHKERRQ(ierr);
+  } else {
+    /* store each coefficient contiguously over the owned points, so that the sweep along x reads them with unit stride */
+    ierr = VecGetLocalSize(vcoeff,&nloc);CHKERRQ(ierr);
+    if (nloc != op->nq*nowned) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_ARG_SIZ,"Variable coefficient vector has local size %D, expected %D stencil points times %D nodes",nloc,op->nq,nowned);
+    ierr = PetscMalloc1(op->nq*nowned,&op->vcoeff);CHKERRQ(ierr);
+    ierr = VecGetArrayRead(vcoeff,&va);CHKERRQ(ierr);
+    for (p = 0; p < nowned; ++p) for (q = 0; q < op->nq; ++q) op->vcoeff[q*nowned + p] = va[p*op->nq + q];
+    ierr = VecRestoreArrayRead(vcoeff,&va);CHKERRQ(ierr);
+  }
+
+  tile[0] = 256;
+  tile[1] = 16;
+  ierr = PetscOptionsGetIntArray(((PetscObject)da)->options,((PetscObject)da)->prefix,"-da_stencil_operator_tile",tile,&ntile,NULL);CHKERRQ(ierr);
+  if (ntile == 1) tile[1] = tile[0];
+  op->tx = PetscMax(tile[0],1);
+  op->ty = PetscMax(tile[1],1);
+
+  ierr = DMCreateLocalVector(da,&op->xl);CHKERRQ(ierr);
+  ierr = VecZeroEntries(op->xl);CHKERRQ(ierr);
+  ierr = DMDAStencilOpCreateGhostScatter_Private(da,op);CHKERRQ(ierr);
+
+  ierr = MatCreateShell(PetscObjectComm((PetscObject)da),nowned,nowned,PETSC_DETERMINE,PETSC_DETERMINE,op,A);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(*A,MATOP_MULT,(void (*)(void))MatMult_DMDAStencil);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(*A,MATOP_GET_DIAGONAL,(void (*)(void))MatGetDiagonal_DMDAStencil);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(*A,MATOP_DESTROY,(void (*)(void))MatDestroy_DMDAStencil);CHKERRQ(ierr);
+  ierr = MatSetDM(*A,da);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
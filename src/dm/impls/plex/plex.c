@@ -676,6 +676,7 @@ static PetscErrorCode DMPlexView_Ascii(DM dm, PetscViewer viewer)
     if (name) {ierr = PetscViewerASCIIPrintf(viewer, "%s in %D dimension%s:\n", name, dim, dim == 1 ? "" : "s");CHKERRQ(ierr);}
     else      {ierr = PetscViewerASCIIPrintf(viewer, "Mesh in %D dimension%s:\n", dim, dim == 1 ? "" : "s");CHKERRQ(ierr);}
     if (cellHeight) {ierr = PetscViewerASCIIPrintf(viewer, "  Cells are at height %D\n", cellHeight);CHKERRQ(ierr);}
+    ierr = DMPlexSetUpSupports_Internal(dm);CHKERRQ(ierr);
     ierr = PetscViewerASCIIPrintf(viewer, "Supports:\n", name);CHKERRQ(ierr);
     ierr = PetscViewerASCIIPushSynchronized(viewer);CHKERRQ(ierr);
     ierr = PetscViewerASCIISynchronizedPrintf(viewer, "[%d] Max support size: %D\n", rank, maxSupportSize);CHKERRQ(ierr);
@@ -2244,6 +2245,7 @@ PetscErrorCode DMDestroy_Plex(DM dm)
   ierr = PetscFree(mesh->children);CHKERRQ(ierr);
   ierr = DMDestroy(&mesh->referenceTree);CHKERRQ(ierr);
   ierr = PetscGridHashDestroy(&mesh->lbox);CHKERRQ(ierr);
+  ierr = PetscBVHDestroy_Internal(&mesh->bvh);CHKERRQ(ierr);
   ierr = PetscFree(mesh->neighbors);CHKERRQ(ierr);
   /* This was originally freed in DMDestroy(), but that prevents reference counting of backend objects */
   ierr = PetscFree(mesh);CHKERRQ(ierr);
@@ -2803,6 +2805,18 @@ PetscErrorCode DMPlexSetCone(DM dm, PetscInt p, const PetscInt cone[])
   if (dof) PetscValidPointer(cone, 3);
   ierr = PetscSectionGetOffset(mesh->coneSection, p, &off);CHKERRQ(ierr);
   if ((p < pStart) || (p >= pEnd)) SETERRQ3(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "Mesh point %D is not in the valid range [%D, %D)", p, pStart, pEnd);
+  if (mesh->supportsLazy) {
+    PetscInt d;
+
+    /* the support sizes of DMPlexSymmetrize() only hold for the cones it saw, so build the supports unless this just reorders the cone */
+    for (c = 0; c < 2*dof; ++c) {
+      const PetscInt q = c < dof ? cone[c] : mesh->cones[off+c-dof];
+
+      for (d = 0; d < dof; ++d) if ((c < dof ? mesh->cones[off+d] : cone[d]) == q) break;
+      if (d == dof) break;
+    }
+    if (c < 2*dof) {ierr = DMPlexSetUpSupports_Internal(dm);CHKERRQ(ierr);}
+  }
   for (c = 0; c < dof; ++c) {
     if ((cone[c] < pStart) || (cone[c] >= pEnd)) SETERRQ3(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "Cone point %D is not in the valid range [%D, %D)", cone[c], pStart, pEnd);
     mesh->cones[off+c] = cone[c];
@@ -2932,6 +2946,7 @@ PetscErrorCode DMPlexInsertCone(DM dm, PetscInt p, PetscInt conePos, PetscInt co
   ierr = PetscSectionGetDof(mesh->coneSection, p, &dof);CHKERRQ(ierr);
   ierr = PetscSectionGetOffset(mesh->coneSection, p, &off);CHKERRQ(ierr);
   if ((conePos < 0) || (conePos >= dof)) SETERRQ3(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "Cone position %D of point %D is not in the valid range [0, %D)", conePos, p, dof);
+  if (mesh->supportsLazy && mesh->cones[off+conePos] != conePoint) {ierr = DMPlexSetUpSupports_Internal(dm);CHKERRQ(ierr);}
   mesh->cones[off+conePos] = conePoint;
   PetscFunctionReturn(0);
 }
@@ -3026,6 +3041,7 @@ PetscErrorCode DMPlexSetSupportSize(DM dm, PetscInt p, PetscInt size)
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  ierr = DMPlexSetUpSupports_Internal(dm);CHKERRQ(ierr);
   ierr = PetscSectionSetDof(mesh->supportSection, p, size);CHKERRQ(ierr);
 
   mesh->maxSupportSize = PetscMax(mesh->maxSupportSize, size);
@@ -3063,6 +3079,7 @@ PetscErrorCode DMPlexGetSupport(DM dm, PetscInt p, const PetscInt *support[])
   PetscFunctionBegin;
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
   PetscValidPointer(support, 3);
+  ierr     = DMPlexSetUpSupports_Internal(dm);CHKERRQ(ierr);
   ierr     = PetscSectionGetOffset(mesh->supportSection, p, &off);CHKERRQ(ierr);
   *support = &mesh->supports[off];
   PetscFunctionReturn(0);
@@ -3096,6 +3113,7 @@ PetscErrorCode DMPlexSetSupport(DM dm, PetscInt p, const PetscInt support[])
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  ierr = DMPlexSetUpSupports_Internal(dm);CHKERRQ(ierr);
   ierr = PetscSectionGetChart(mesh->supportSection, &pStart, &pEnd);CHKERRQ(ierr);
   ierr = PetscSectionGetDof(mesh->supportSection, p, &dof);CHKERRQ(ierr);
   if (dof) PetscValidPointer(support, 3);
@@ -3132,6 +3150,7 @@ PetscErrorCode DMPlexInsertSupport(DM dm, PetscInt p, PetscInt supportPos, Petsc
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  ierr = DMPlexSetUpSupports_Internal(dm);CHKERRQ(ierr);
   ierr = PetscSectionGetChart(mesh->supportSection, &pStart, &pEnd);CHKERRQ(ierr);
   ierr = PetscSectionGetDof(mesh->supportSection, p, &dof);CHKERRQ(ierr);
   ierr = PetscSectionGetOffset(mesh->supportSection, p, &off);CHKERRQ(ierr);
@@ -3627,9 +3646,14 @@ PetscErrorCode DMCreateSuperDM_Plex(DM dms[], PetscInt len, IS **is, DM *superdm
 
   Output Parameter:
 
-  Note:
+  Notes:
   This should be called after all calls to DMPlexSetCone()
 
+  Only the support sizes are computed here. The supports themselves are built from the cones the first time they are
+  needed, for example by DMPlexGetSupport() or DMPlexGetSupportSection(), so that meshes which are only traversed
+  through cones and closures never store them. As before, the supports reflect the cones at the time of this call:
+  DMPlexSetCone() and DMPlexInsertCone() build them first when they change the points of a cone.
+
   Level: beginner
 
 .seealso: DMPlexCreate(), DMPlexSetChart(), DMPlexSetConeSize(), DMPlexSetCone()
@@ -3637,14 +3661,12 @@ PetscErrorCode DMCreateSuperDM_Plex(DM dms[], PetscInt len, IS **is, DM *superdm
 PetscErrorCode DMPlexSymmetrize(DM dm)
 {
   DM_Plex       *mesh = (DM_Plex*) dm->data;
-  PetscInt      *offsets;
-  PetscInt       supportSize;
   PetscInt       pStart, pEnd, p;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
-  if (mesh->supports) SETERRQ(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_WRONGSTATE, "Supports were already setup in this DMPlex");
+  if (mesh->supports || mesh->supportsLazy) SETERRQ(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_WRONGSTATE, "Supports were already setup in this DMPlex");
   ierr = PetscLogEventBegin(DMPLEX_Symmetrize,dm,0,0,0);CHKERRQ(ierr);
   /* Calculate support sizes */
   ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
@@ -3665,7 +3687,36 @@ PetscErrorCode DMPlexSymmetrize(DM dm)
     mesh->maxSupportSize = PetscMax(mesh->maxSupportSize, dof);
   }
   ierr = PetscSectionSetUp(mesh->supportSection);CHKERRQ(ierr);
-  /* Calculate supports */
+  mesh->supportsLazy = PETSC_TRUE;
+  ierr = PetscLogEventEnd(DMPLEX_Symmetrize,dm,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+  DMPlexSetUpSupports_Internal - Build the supports deferred by DMPlexSymmetrize(), if they are not built yet
+
+  Not collective
+
+  Input Parameter:
+. dm - The DMPlex
+
+  Level: developer
+
+.seealso: DMPlexSymmetrize()
+*/
+PetscErrorCode DMPlexSetUpSupports_Internal(DM dm)
+{
+  DM_Plex       *mesh = (DM_Plex*) dm->data;
+  PetscInt      *offsets;
+  PetscInt       supportSize;
+  PetscInt       pStart, pEnd, p;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!mesh->supportsLazy) PetscFunctionReturn(0);
+  mesh->supportsLazy = PETSC_FALSE;
+  ierr = PetscLogEventBegin(DMPLEX_Symmetrize,dm,0,0,0);CHKERRQ(ierr);
+  ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
   ierr = PetscSectionGetStorageSize(mesh->supportSection, &supportSize);CHKERRQ(ierr);
   ierr = PetscMalloc1(supportSize, &mesh->supports);CHKERRQ(ierr);
   ierr = PetscCalloc1(pEnd - pStart, &offsets);CHKERRQ(ierr);
@@ -3676,12 +3727,13 @@ PetscErrorCode DMPlexSymmetrize(DM dm)
     ierr = PetscSectionGetOffset(mesh->coneSection, p, &off);CHKERRQ(ierr);
     for (c = off; c < off+dof; ++c) {
       const PetscInt q = mesh->cones[c];
-      PetscInt       offS;
+      PetscInt       dofS, offS;
 
+      ierr = PetscSectionGetDof(mesh->supportSection, q, &dofS);CHKERRQ(ierr);
       ierr = PetscSectionGetOffset(mesh->supportSection, q, &offS);CHKERRQ(ierr);
-
-      mesh->supports[offS+offsets[q]] = p;
-      ++offsets[q];
+      if (offsets[q-pStart] >= dofS) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Point %D has more supports than the %D counted by DMPlexSymmetrize(), its cones were changed without DMPlexSetCone()", q, dofS);
+      mesh->supports[offS+offsets[q-pStart]] = p;
+      ++offsets[q-pStart];
     }
   }
   ierr = PetscFree(offsets);CHKERRQ(ierr);
@@ -3806,22 +3858,26 @@ PetscErrorCode DMPlexStratify(DM dm)
     ierr = DMPlexCreateDepthStratum(dm, label, 1, sMin, sMax+1);CHKERRQ(ierr);
   } else {
     PetscInt level = 0;
-    PetscInt qStart, qEnd, q;
+    PetscInt qStart, qEnd;
 
     ierr = DMLabelGetStratumBounds(label, level, &qStart, &qEnd);CHKERRQ(ierr);
+    /* The next stratum covers the points with a cone point in the current one, which avoids building the supports */
     while (qEnd > qStart) {
       PetscInt sMin = PETSC_MAX_INT;
       PetscInt sMax = PETSC_MIN_INT;
 
-      for (q = qStart; q < qEnd; ++q) {
-        const PetscInt *support;
-        PetscInt        supportSize, s;
+      for (p = pStart; p < pEnd; ++p) {
+        const PetscInt *cone;
+        PetscInt        coneSize, c;
 
-        ierr = DMPlexGetSupportSize(dm, q, &supportSize);CHKERRQ(ierr);
-        ierr = DMPlexGetSupport(dm, q, &support);CHKERRQ(ierr);
-        for (s = 0; s < supportSize; ++s) {
-          sMin = PetscMin(support[s], sMin);
-          sMax = PetscMax(support[s], sMax);
+        ierr = DMPlexGetConeSize(dm, p, &coneSize);CHKERRQ(ierr);
+        ierr = DMPlexGetCone(dm, p, &cone);CHKERRQ(ierr);
+        for (c = 0; c < coneSize; ++c) {
+          if (cone[c] >= qStart && cone[c] < qEnd) {
+            sMin = PetscMin(p, sMin);
+            sMax = PetscMax(p, sMax);
+            break;
+          }
         }
       }
       ierr = DMLabelGetNumValues(label, &level);CHKERRQ(ierr);
@@ -4011,6 +4067,7 @@ PetscErrorCode DMPlexGetJoin(DM dm, PetscInt numPoints, const PetscInt points[],
   PetscValidIntPointer(points, 3);
   PetscValidIntPointer(numCoveredPoints, 4);
   PetscValidPointer(coveredPoints, 5);
+  ierr = DMPlexSetUpSupports_Internal(dm);CHKERRQ(ierr);
   ierr = DMGetWorkArray(dm, mesh->maxSupportSize, MPIU_INT, &join[0]);CHKERRQ(ierr);
   ierr = DMGetWorkArray(dm, mesh->maxSupportSize, MPIU_INT, &join[1]);CHKERRQ(ierr);
   /* Copy in support of first point */
@@ -4940,10 +4997,12 @@ PetscErrorCode DMPlexGetConeSection(DM dm, PetscSection *section)
 @*/
 PetscErrorCode DMPlexGetSupportSection(DM dm, PetscSection *section)
 {
-  DM_Plex *mesh = (DM_Plex*) dm->data;
+  DM_Plex       *mesh = (DM_Plex*) dm->data;
+  PetscErrorCode ierr;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  ierr = DMPlexSetUpSupports_Internal(dm);CHKERRQ(ierr);
   if (section) *section = mesh->supportSection;
   PetscFunctionReturn(0);
 }
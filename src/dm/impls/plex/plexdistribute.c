@@ -1,5 +1,6 @@
 #include <petsc/private/dmpleximpl.h>    /*I      "petscdmplex.h"   I*/
 #include <petsc/private/dmlabelimpl.h>   /*I      "petscdmlabel.h"  I*/
+#include <petsc/private/hashmapij.h>
 
 /*@C
   DMPlexSetAdjacencyUser - Define adjacency in the mesh using a user-provided callback
@@ -1340,6 +1341,61 @@ PetscErrorCode DMPlexGetPartitionBalance(DM dm, PetscBool *flg)
   PetscFunctionReturn(0);
 }
 
+/*@
+  DMPlexSetOverlapLocalCopy - Should DMPlexDistributeOverlap() copy the local points instead of migrating them, and only communicate the incoming overlap points?
+
+  Input Parameters:
++ dm  - The DMPlex object
+- flg - Copy the local points and only communicate the incoming overlap points?
+
+  Options Database Key:
+. -dm_plex_overlap_local_copy - Copy the local points and only communicate the incoming overlap points
+
+  Notes:
+  This is a communication optimization only. The overlapping mesh is still built as a new DM next to the input one, so the peak memory is
+  that of both meshes, as with the full migration, and the input DM is not extended.
+
+  The local copy needs the points of the mesh to be stratified by cell type, as produced by DMPlexDistribute(), and no reference tree.
+  Otherwise the whole mesh is migrated as usual.
+
+  Level: intermediate
+
+.seealso: DMPlexDistributeOverlap(), DMPlexGetOverlapLocalCopy()
+@*/
+PetscErrorCode DMPlexSetOverlapLocalCopy(DM dm, PetscBool flg)
+{
+  DM_Plex *mesh = (DM_Plex *)dm->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  mesh->overlapLocalCopy = flg;
+  PetscFunctionReturn(0);
+}
+
+/*@
+  DMPlexGetOverlapLocalCopy - Does DMPlexDistributeOverlap() copy the local points instead of migrating them, and only communicate the incoming overlap points?
+
+  Input Parameter:
+. dm - The DMPlex object
+
+  Output Parameter:
+. flg - Copy the local points and only communicate the incoming overlap points?
+
+  Level: intermediate
+
+.seealso: DMPlexDistributeOverlap(), DMPlexSetOverlapLocalCopy()
+@*/
+PetscErrorCode DMPlexGetOverlapLocalCopy(DM dm, PetscBool *flg)
+{
+  DM_Plex *mesh = (DM_Plex *)dm->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscValidBoolPointer(flg, 2);
+  *flg = mesh->overlapLocalCopy;
+  PetscFunctionReturn(0);
+}
+
 typedef struct {
   PetscInt vote, rank, index;
 } Petsc3Int;
@@ -1605,7 +1661,7 @@ PetscErrorCode DMPlexDistribute(DM dm, PetscInt overlap, PetscSF *sf, DM *dmPara
   DM                     dmCoord;
   DMLabel                lblPartition, lblMigration;
   PetscSF                sfMigration, sfStratified, sfPoint;
-  PetscBool              flg, balance;
+  PetscBool              flg, balance, localCopy;
   PetscMPIInt            rank, size;
   PetscErrorCode         ierr;
 
@@ -1688,6 +1744,8 @@ PetscErrorCode DMPlexDistribute(DM dm, PetscInt overlap, PetscSF *sf, DM *dmPara
   /* Build the point SF without overlap */
   ierr = DMPlexGetPartitionBalance(dm, &balance);CHKERRQ(ierr);
   ierr = DMPlexSetPartitionBalance(*dmParallel, balance);CHKERRQ(ierr);
+  ierr = DMPlexGetOverlapLocalCopy(dm, &localCopy);CHKERRQ(ierr);
+  ierr = DMPlexSetOverlapLocalCopy(*dmParallel, localCopy);CHKERRQ(ierr);
   ierr = DMPlexCreatePointSF(*dmParallel, sfMigration, PETSC_TRUE, &sfPoint);CHKERRQ(ierr);
   ierr = DMSetPointSF(*dmParallel, sfPoint);CHKERRQ(ierr);
   ierr = DMGetCoordinateDM(*dmParallel, &dmCoord);CHKERRQ(ierr);
@@ -1755,6 +1813,608 @@ PetscErrorCode DMPlexDistribute(DM dm, PetscInt overlap, PetscSF *sf, DM *dmPara
   PetscFunctionReturn(0);
 }
 
+/* Sort key for each cell type, matching the stratified point order produced by DMPlexStratifyMigrationSF() */
+static PetscErrorCode DMPlexGetCellTypeOrder_Static(PetscInt depth, PetscInt dim, PetscInt ctOrder[])
+{
+  PetscInt dims[4], order = 0, i, c;
+
+  PetscFunctionBegin;
+  for (c = 0; c < DM_NUM_POLYTOPES; ++c) ctOrder[c] = -1;
+  /* Cells (depth), Vertices (0), Faces (depth-1), Edges (1) */
+  dims[0] = dim; dims[1] = 0; dims[2] = dim-1; dims[3] = 1;
+  for (i = 0; i <= depth; ++i) {
+    for (c = 0; c < DM_NUM_POLYTOPES; ++c) {
+      if (DMPolytopeTypeGetDim((DMPolytopeType) c) != dims[i] && !(i == 0 && (c == DM_POLYTOPE_FV_GHOST || c == DM_POLYTOPE_INTERIOR_GHOST))) continue;
+      ctOrder[c] = order++;
+    }
+  }
+  for (c = 0; c < DM_NUM_POLYTOPES; ++c) {
+    const PetscInt ctDim = DMPolytopeTypeGetDim((DMPolytopeType) c);
+
+    if ((ctDim < 0 || ctDim > dim) && (c != DM_POLYTOPE_FV_GHOST && c != DM_POLYTOPE_INTERIOR_GHOST)) ctOrder[c] = order++;
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+  DMPlexOverlapSectionCreate_Static - Lay out the data received for the incoming overlap points
+
+  Input Parameters:
++ sfIn        - The SF from the existing points to the incoming points, with contiguous leaves
+. oldToNew    - The new number of each existing point, or NULL
+. newPoint    - The new number of each incoming point, or NULL
+. rootSection - The layout of the data sent for each existing point
+. oldSection  - The layout of the data kept for each existing point, or NULL
+- newSection  - The layout over the extended mesh to be filled in, or NULL
+
+  Output Parameters:
++ recvSection - The layout of the received data, over the incoming points
+- recvSF      - The SF sending the rootSection data into the recvSection layout
+
+  Note: If the chart of newSection has not been set, it is taken as the range of extended mesh points carrying data.
+*/
+static PetscErrorCode DMPlexOverlapSectionCreate_Static(PetscSF sfIn, const PetscInt oldToNew[], const PetscInt newPoint[], PetscSection rootSection, PetscSection oldSection, PetscSection newSection, PetscSection *recvSection, PetscSF *recvSF)
+{
+  PetscInt      *rootBuf, *leafDof, *leafOff;
+  PetscInt       nroots, nleaves, rpStart, rpEnd, numFields, f, p, k;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscSFGetGraph(sfIn, &nroots, &nleaves, NULL, NULL);CHKERRQ(ierr);
+  ierr = PetscSectionGetChart(rootSection, &rpStart, &rpEnd);CHKERRQ(ierr);
+  ierr = PetscSectionGetNumFields(rootSection, &numFields);CHKERRQ(ierr);
+  ierr = PetscSectionCreate(PETSC_COMM_SELF, recvSection);CHKERRQ(ierr);
+  if (numFields) {ierr = PetscSectionSetNumFields(*recvSection, numFields);CHKERRQ(ierr);}
+  ierr = PetscSectionSetChart(*recvSection, 0, nleaves);CHKERRQ(ierr);
+  ierr = PetscMalloc3(nroots, &rootBuf, nleaves, &leafDof, nleaves, &leafOff);CHKERRQ(ierr);
+  /* Point and field dofs of the incoming points */
+  for (f = -1; f < numFields; ++f) {
+    for (p = 0; p < nroots; ++p) {
+      rootBuf[p] = 0;
+      if (p < rpStart || p >= rpEnd) continue;
+      if (f < 0) {ierr = PetscSectionGetDof(rootSection, p, &rootBuf[p]);CHKERRQ(ierr);}
+      else       {ierr = PetscSectionGetFieldDof(rootSection, p, f, &rootBuf[p]);CHKERRQ(ierr);}
+    }
+    ierr = PetscSFBcastBegin(sfIn, MPIU_INT, rootBuf, leafDof, MPI_REPLACE);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sfIn, MPIU_INT, rootBuf, leafDof, MPI_REPLACE);CHKERRQ(ierr);
+    for (k = 0; k < nleaves; ++k) {
+      if (f < 0) {ierr = PetscSectionSetDof(*recvSection, k, leafDof[k]);CHKERRQ(ierr);}
+      else       {ierr = PetscSectionSetFieldDof(*recvSection, k, f, leafDof[k]);CHKERRQ(ierr);}
+    }
+  }
+  /* Remote offsets of the incoming points */
+  for (p = 0; p < nroots; ++p) {
+    rootBuf[p] = 0;
+    if (p >= rpStart && p < rpEnd) {ierr = PetscSectionGetOffset(rootSection, p, &rootBuf[p]);CHKERRQ(ierr);}
+  }
+  ierr = PetscSFBcastBegin(sfIn, MPIU_INT, rootBuf, leafOff, MPI_REPLACE);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(sfIn, MPIU_INT, rootBuf, leafOff, MPI_REPLACE);CHKERRQ(ierr);
+  ierr = PetscSectionSetUp(*recvSection);CHKERRQ(ierr);
+  ierr = PetscSFCreateSectionSF(sfIn, rootSection, leafOff, *recvSection, recvSF);CHKERRQ(ierr);
+  if (newSection) {
+    PetscInt opStart, opEnd, qStart, qEnd, dof, fdof;
+
+    ierr = PetscSectionGetChart(oldSection, &opStart, &opEnd);CHKERRQ(ierr);
+    if (numFields) {
+      ierr = PetscSectionSetNumFields(newSection, numFields);CHKERRQ(ierr);
+      for (f = 0; f < numFields; ++f) {
+        PetscInt nc;
+
+        ierr = PetscSectionGetFieldComponents(oldSection, f, &nc);CHKERRQ(ierr);
+        ierr = PetscSectionSetFieldComponents(newSection, f, nc);CHKERRQ(ierr);
+      }
+    }
+    ierr = PetscSectionGetChart(newSection, &qStart, &qEnd);CHKERRQ(ierr);
+    if (qStart < 0) {
+      qStart = PETSC_MAX_INT; qEnd = -1;
+      if (opEnd > opStart) {qStart = oldToNew[opStart]; qEnd = oldToNew[opEnd-1]+1;}
+      for (k = 0; k < nleaves; ++k) {
+        if (!leafDof[k]) continue;
+        qStart = PetscMin(qStart, newPoint[k]);
+        qEnd   = PetscMax(qEnd, newPoint[k]+1);
+      }
+      if (qEnd < 0) qStart = qEnd = 0;
+      ierr = PetscSectionSetChart(newSection, qStart, qEnd);CHKERRQ(ierr);
+    }
+    for (p = opStart; p < opEnd; ++p) {
+      ierr = PetscSectionGetDof(oldSection, p, &dof);CHKERRQ(ierr);
+      ierr = PetscSectionSetDof(newSection, oldToNew[p], dof);CHKERRQ(ierr);
+      for (f = 0; f < numFields; ++f) {
+        ierr = PetscSectionGetFieldDof(oldSection, p, f, &fdof);CHKERRQ(ierr);
+        ierr = PetscSectionSetFieldDof(newSection, oldToNew[p], f, fdof);CHKERRQ(ierr);
+      }
+    }
+    for (k = 0; k < nleaves; ++k) {
+      if (!leafDof[k]) continue;
+      ierr = PetscSectionSetDof(newSection, newPoint[k], leafDof[k]);CHKERRQ(ierr);
+      for (f = 0; f < numFields; ++f) {
+        ierr = PetscSectionGetFieldDof(*recvSection, k, f, &fdof);CHKERRQ(ierr);
+        ierr = PetscSectionSetFieldDof(newSection, newPoint[k], f, fdof);CHKERRQ(ierr);
+      }
+    }
+    ierr = PetscSectionSetUp(newSection);CHKERRQ(ierr);
+  }
+  ierr = PetscFree3(rootBuf, leafDof, leafOff);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+  DMPlexDistributeOverlapLocalCopy_Static - Build the overlapping mesh, copying the local points and communicating only the incoming points
+
+  The existing points keep their relative order and are only shifted inside their (depth, cell type) stratum, so that their
+  cones, labels and coordinates are copied locally into the new DM (the input DM is not modified, so the peak memory is that of
+  both meshes). The incoming points are appended at the end of their stratum, which gives
+  the same stratification as DMPlexStratifyMigrationSF(). If the mesh cannot be extended this way on some process, for example
+  because it has a reference tree or its points are not stratified by cell type, dmOverlap is returned as NULL on all processes.
+*/
+static PetscErrorCode DMPlexDistributeOverlapLocalCopy_Static(DM dm, DMLabel lblOverlap, PetscSF *sf, DM *dmOverlap)
+{
+  DM_Plex           *mesh = (DM_Plex*) dm->data;
+  MPI_Comm           comm;
+  PetscMPIInt        rank;
+  DM                 dmNew, cdm, cdmNew, refTree;
+  DMLabel            depthLabel;
+  PetscObjectState   depthState = -1;
+  PetscSection       parentSection, coneSection, coneSectionNew, sendSection, recvSection;
+  PetscSF            sfPoint, sfIn, recvSF;
+  PetscHMapIJ        remoteHash;
+  PetscHashIJKey     key;
+  IS                 valueIS;
+  const PetscInt    *leaves, *values, *rootDegree;
+  const PetscSFNode *remotes;
+  PetscSFNode       *owners, *newRemote;
+  PetscInt          *oldToNew, *newPoint, *work;
+  PetscInt           ctOrder[DM_NUM_POLYTOPES], ctSort[DM_NUM_POLYTOPES], ctKey[DM_NUM_POLYTOPES];
+  PetscInt           oldCount[DM_NUM_POLYTOPES], newCount[DM_NUM_POLYTOPES], ctShift[DM_NUM_POLYTOPES], ctIdx[DM_NUM_POLYTOPES];
+  PetscInt           check[3], depth, dim, cdim, pStart, pEnd, pEndNew, nroots, nleaves, numValues, numLabels, nNew = 0, nct = 0, p, k, l, v, c;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  *dmOverlap = NULL;
+  ierr = PetscObjectGetComm((PetscObject) dm, &comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm, &rank);CHKERRMPI(ierr);
+  ierr = DMPlexGetDepth(dm, &depth);CHKERRQ(ierr);
+  ierr = DMGetDimension(dm, &dim);CHKERRQ(ierr);
+  ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
+  ierr = DMGetPointSF(dm, &sfPoint);CHKERRQ(ierr);
+  ierr = PetscSFGetGraph(sfPoint, &nroots, &nleaves, &leaves, &remotes);CHKERRQ(ierr);
+  ierr = DMPlexGetTree(dm, &parentSection, NULL, NULL, NULL, NULL);CHKERRQ(ierr);
+  ierr = DMPlexGetDepthLabel(dm, &depthLabel);CHKERRQ(ierr);
+  if (depthLabel) {ierr = PetscObjectStateGet((PetscObject) depthLabel, &depthState);CHKERRQ(ierr);}
+  ierr = DMGetNumLabels(dm, &numLabels);CHKERRQ(ierr);
+  /* Check that the existing points can be kept in place, storing their cell type in oldToNew */
+  ierr = PetscMalloc1(pEnd, &oldToNew);CHKERRQ(ierr);
+  ierr = PetscArrayzero(oldCount, DM_NUM_POLYTOPES);CHKERRQ(ierr);
+  check[0] = (pStart || nroots < 0 || parentSection || mesh->depthState != depthState) ? 1 : 0;
+  ierr = DMPlexGetCellTypeOrder_Static(depth, dim, ctOrder);CHKERRQ(ierr);
+  for (p = pStart, k = 0; !check[0] && p < pEnd; ++p) {
+    DMPolytopeType ct;
+
+    ierr = DMPlexGetCellType(dm, p, &ct);CHKERRQ(ierr);
+    if (ctOrder[ct] < k) {check[0] = 1; break;}
+    k = ctOrder[ct];
+    oldToNew[p] = ct;
+    ++oldCount[ct];
+  }
+  check[1] = numLabels; check[2] = -numLabels;
+  ierr = MPIU_Allreduce(MPI_IN_PLACE, check, 3, MPIU_INT, MPI_MAX, comm);CHKERRMPI(ierr);
+  if (check[0] || check[1] != -check[2]) {
+    ierr = PetscInfo(dm, "Mesh cannot be extended in place, using full migration for the overlap\n");CHKERRQ(ierr);
+    ierr = PetscFree(oldToNew);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  /* Identify the incoming points by their owner, since the overlap label is given in terms of owners */
+  ierr = PetscMalloc1(pEnd, &owners);CHKERRQ(ierr);
+  for (p = 0; p < pEnd; ++p) {owners[p].rank = rank; owners[p].index = p;}
+  ierr = PetscHMapIJCreate(&remoteHash);CHKERRQ(ierr);
+  for (l = 0; l < nleaves; ++l) {
+    const PetscInt leaf = leaves ? leaves[l] : l;
+
+    owners[leaf] = remotes[l];
+    key.i = remotes[l].index;
+    key.j = remotes[l].rank;
+    ierr = PetscHMapIJSet(remoteHash, key, leaf);CHKERRQ(ierr);
+  }
+  ierr = DMLabelGetValueIS(lblOverlap, &valueIS);CHKERRQ(ierr);
+  ierr = ISGetLocalSize(valueIS, &numValues);CHKERRQ(ierr);
+  ierr = ISGetIndices(valueIS, &values);CHKERRQ(ierr);
+  for (v = 0, k = 0; v < numValues; ++v) {
+    PetscInt n;
+
+    if (values[v] == rank) continue;
+    ierr = DMLabelGetStratumSize(lblOverlap, values[v], &n);CHKERRQ(ierr);
+    k += n;
+  }
+  ierr = PetscMalloc1(k, &newRemote);CHKERRQ(ierr);
+  for (v = 0; v < numValues; ++v) {
+    IS              pointIS;
+    const PetscInt *points;
+    PetscInt        n, i, leaf;
+
+    if (values[v] == rank) continue;
+    ierr = DMLabelGetStratumIS(lblOverlap, values[v], &pointIS);CHKERRQ(ierr);
+    ierr = ISGetLocalSize(pointIS, &n);CHKERRQ(ierr);
+    ierr = ISGetIndices(pointIS, &points);CHKERRQ(ierr);
+    for (i = 0; i < n; ++i) {
+      key.i = points[i];
+      key.j = values[v];
+      ierr = PetscHMapIJGet(remoteHash, key, &leaf);CHKERRQ(ierr);
+      if (leaf >= 0) continue;
+      newRemote[nNew].rank  = values[v];
+      newRemote[nNew].index = points[i];
+      ++nNew;
+    }
+    ierr = ISRestoreIndices(pointIS, &points);CHKERRQ(ierr);
+    ierr = ISDestroy(&pointIS);CHKERRQ(ierr);
+  }
+  ierr = ISRestoreIndices(valueIS, &values);CHKERRQ(ierr);
+  ierr = ISDestroy(&valueIS);CHKERRQ(ierr);
+  ierr = PetscSFCreate(comm, &sfIn);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(sfIn, pEnd, nNew, NULL, PETSC_OWN_POINTER, newRemote, PETSC_OWN_POINTER);CHKERRQ(ierr);
+  ierr = PetscSFSetUp(sfIn);CHKERRQ(ierr);
+  /* Number the incoming points at the end of their stratum and shift the existing points */
+  ierr = PetscMalloc1(nNew, &newPoint);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(sfIn, MPIU_INT, oldToNew, newPoint, MPI_REPLACE);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(sfIn, MPIU_INT, oldToNew, newPoint, MPI_REPLACE);CHKERRQ(ierr);
+  ierr = PetscArrayzero(newCount, DM_NUM_POLYTOPES);CHKERRQ(ierr);
+  for (k = 0; k < nNew; ++k) ++newCount[newPoint[k]];
+  for (c = 0; c < DM_NUM_POLYTOPES; ++c) {
+    if (ctOrder[c] < 0) continue;
+    ctKey[nct]    = ctOrder[c];
+    ctSort[nct++] = c;
+  }
+  ierr = PetscSortIntWithArray(nct, ctKey, ctSort);CHKERRQ(ierr);
+  for (c = 0, k = 0, l = 0; c < nct; ++c) {
+    const PetscInt ct = ctSort[c];
+
+    ctShift[ct] = k;
+    ctIdx[ct]   = l + k + oldCount[ct];
+    k          += newCount[ct];
+    l          += oldCount[ct];
+  }
+  for (p = 0; p < pEnd; ++p) oldToNew[p] = p + ctShift[oldToNew[p]];
+  for (k = 0; k < nNew; ++k) newPoint[k] = ctIdx[newPoint[k]]++;
+  pEndNew = pEnd + nNew;
+  /* Key every remote point by its owner, now in the new numbering */
+  for (l = 0; l < nleaves; ++l) {
+    key.i = remotes[l].index;
+    key.j = remotes[l].rank;
+    ierr = PetscHMapIJSet(remoteHash, key, oldToNew[leaves ? leaves[l] : l]);CHKERRQ(ierr);
+  }
+  for (k = 0; k < nNew; ++k) {
+    key.i = newRemote[k].index;
+    key.j = newRemote[k].rank;
+    ierr = PetscHMapIJSet(remoteHash, key, newPoint[k]);CHKERRQ(ierr);
+  }
+  ierr = PetscSFComputeDegreeBegin(sfIn, &rootDegree);CHKERRQ(ierr);
+  ierr = PetscSFComputeDegreeEnd(sfIn, &rootDegree);CHKERRQ(ierr);
+
+  ierr = DMPlexCreate(comm, &dmNew);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) dmNew, "Parallel Mesh");CHKERRQ(ierr);
+  ierr = DMSetDimension(dmNew, dim);CHKERRQ(ierr);
+  ierr = DMGetCoordinateDim(dm, &cdim);CHKERRQ(ierr);
+  ierr = DMSetCoordinateDim(dmNew, cdim);CHKERRQ(ierr);
+  ierr = DMPlexSetChart(dmNew, 0, pEndNew);CHKERRQ(ierr);
+  /* Cones: existing cones are renumbered locally, incoming cones are sent as owner pairs */
+  {
+    DM_Plex           *meshNew = (DM_Plex*) dmNew->data;
+    PetscSFNode       *sendCones, *recvCones;
+    PetscInt          *sendOrnt, *recvOrnt, *cones, *ornts, *oldCones, *oldOrnts;
+    PetscInt           size, dof, off, noff, i;
+
+    ierr = PetscLogEventBegin(DMPLEX_DistributeCones, dm, 0, 0, 0);CHKERRQ(ierr);
+    ierr = DMPlexGetConeSection(dm, &coneSection);CHKERRQ(ierr);
+    ierr = DMPlexGetConeSection(dmNew, &coneSectionNew);CHKERRQ(ierr);
+    ierr = PetscSectionCreate(PETSC_COMM_SELF, &sendSection);CHKERRQ(ierr);
+    ierr = PetscSectionSetChart(sendSection, 0, pEnd);CHKERRQ(ierr);
+    for (p = 0; p < pEnd; ++p) {
+      if (!rootDegree[p]) continue;
+      ierr = PetscSectionGetDof(coneSection, p, &dof);CHKERRQ(ierr);
+      ierr = PetscSectionSetDof(sendSection, p, dof);CHKERRQ(ierr);
+    }
+    ierr = PetscSectionSetUp(sendSection);CHKERRQ(ierr);
+    ierr = PetscSectionGetStorageSize(sendSection, &size);CHKERRQ(ierr);
+    ierr = PetscMalloc2(size, &sendCones, size, &sendOrnt);CHKERRQ(ierr);
+    ierr = DMPlexGetCones(dm, &oldCones);CHKERRQ(ierr);
+    ierr = DMPlexGetConeOrientations(dm, &oldOrnts);CHKERRQ(ierr);
+    for (p = 0; p < pEnd; ++p) {
+      if (!rootDegree[p]) continue;
+      ierr = PetscSectionGetDof(sendSection, p, &dof);CHKERRQ(ierr);
+      ierr = PetscSectionGetOffset(sendSection, p, &noff);CHKERRQ(ierr);
+      ierr = PetscSectionGetOffset(coneSection, p, &off);CHKERRQ(ierr);
+      for (i = 0; i < dof; ++i) {
+        sendCones[noff+i] = owners[oldCones[off+i]];
+        sendOrnt[noff+i]  = oldOrnts[off+i];
+      }
+    }
+    ierr = DMPlexOverlapSectionCreate_Static(sfIn, oldToNew, newPoint, sendSection, coneSection, coneSectionNew, &recvSection, &recvSF);CHKERRQ(ierr);
+    for (p = 0; p < pEndNew; ++p) {
+      ierr = PetscSectionGetDof(coneSectionNew, p, &dof);CHKERRQ(ierr);
+      meshNew->maxConeSize = PetscMax(meshNew->maxConeSize, dof);
+    }
+    ierr = DMSetUp(dmNew);CHKERRQ(ierr);
+    ierr = PetscSectionGetStorageSize(recvSection, &size);CHKERRQ(ierr);
+    ierr = PetscMalloc2(size, &recvCones, size, &recvOrnt);CHKERRQ(ierr);
+    ierr = PetscSFBcastBegin(recvSF, MPIU_2INT, sendCones, recvCones, MPI_REPLACE);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(recvSF, MPIU_2INT, sendCones, recvCones, MPI_REPLACE);CHKERRQ(ierr);
+    ierr = PetscSFBcastBegin(recvSF, MPIU_INT, sendOrnt, recvOrnt, MPI_REPLACE);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(recvSF, MPIU_INT, sendOrnt, recvOrnt, MPI_REPLACE);CHKERRQ(ierr);
+    ierr = PetscFree2(sendCones, sendOrnt);CHKERRQ(ierr);
+    ierr = DMPlexGetCones(dmNew, &cones);CHKERRQ(ierr);
+    ierr = DMPlexGetConeOrientations(dmNew, &ornts);CHKERRQ(ierr);
+    for (p = 0; p < pEnd; ++p) {
+      ierr = PetscSectionGetDof(coneSection, p, &dof);CHKERRQ(ierr);
+      ierr = PetscSectionGetOffset(coneSection, p, &off);CHKERRQ(ierr);
+      ierr = PetscSectionGetOffset(coneSectionNew, oldToNew[p], &noff);CHKERRQ(ierr);
+      for (i = 0; i < dof; ++i) {
+        cones[noff+i] = oldToNew[oldCones[off+i]];
+        ornts[noff+i] = oldOrnts[off+i];
+      }
+    }
+    for (k = 0; k < nNew; ++k) {
+      ierr = PetscSectionGetDof(recvSection, k, &dof);CHKERRQ(ierr);
+      ierr = PetscSectionGetOffset(recvSection, k, &off);CHKERRQ(ierr);
+      ierr = PetscSectionGetOffset(coneSectionNew, newPoint[k], &noff);CHKERRQ(ierr);
+      for (i = 0; i < dof; ++i) {
+        const PetscSFNode q = recvCones[off+i];
+
+        if (q.rank == rank) {
+          cones[noff+i] = oldToNew[q.index];
+        } else {
+          key.i = q.index;
+          key.j = q.rank;
+          ierr = PetscHMapIJGet(remoteHash, key, &cones[noff+i]);CHKERRQ(ierr);
+          if (cones[noff+i] < 0) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Cone point (%D, %D) of overlap point %D is not in the overlap", q.rank, q.index, newPoint[k]);
+        }
+        ornts[noff+i] = recvOrnt[off+i];
+      }
+    }
+    ierr = PetscFree2(recvCones, recvOrnt);CHKERRQ(ierr);
+    ierr = PetscSectionDestroy(&sendSection);CHKERRQ(ierr);
+    ierr = PetscSectionDestroy(&recvSection);CHKERRQ(ierr);
+    ierr = PetscSFDestroy(&recvSF);CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(DMPLEX_DistributeCones, dm, 0, 0, 0);CHKERRQ(ierr);
+  }
+  ierr = DMPlexSymmetrize(dmNew);CHKERRQ(ierr);
+  ierr = DMPlexStratify(dmNew);CHKERRQ(ierr);
+  {
+    PetscBool useCone, useClosure, useAnchors;
+
+    ierr = DMGetBasicAdjacency(dm, &useCone, &useClosure);CHKERRQ(ierr);
+    ierr = DMSetBasicAdjacency(dmNew, useCone, useClosure);CHKERRQ(ierr);
+    ierr = DMPlexGetAdjacencyUseAnchors(dm, &useAnchors);CHKERRQ(ierr);
+    ierr = DMPlexSetAdjacencyUseAnchors(dmNew, useAnchors);CHKERRQ(ierr);
+  }
+  /* Labels: existing strata are shifted, incoming points receive the values of their owner */
+  ierr = PetscLogEventBegin(DMPLEX_DistributeLabels, dm, 0, 0, 0);CHKERRQ(ierr);
+  ierr = PetscCalloc1(pEnd, &work);CHKERRQ(ierr);
+  for (l = 0; l < numLabels; ++l) {
+    DMLabel         label, labelNew;
+    const char     *name;
+    PetscInt       *sendValues, *recvValues, *strata, defaultValue, size, numStrata, dof, off, i, n;
+    PetscBool       isDepth, isOutput;
+
+    ierr = DMGetLabelByNum(dm, l, &label);CHKERRQ(ierr);
+    ierr = PetscObjectGetName((PetscObject) label, &name);CHKERRQ(ierr);
+    ierr = PetscStrcmp(name, "depth", &isDepth);CHKERRQ(ierr);
+    if (isDepth) continue;
+    ierr = DMLabelGetValueIS(label, &valueIS);CHKERRQ(ierr);
+    ierr = ISGetLocalSize(valueIS, &numValues);CHKERRQ(ierr);
+    ierr = ISGetIndices(valueIS, &values);CHKERRQ(ierr);
+    /* Send the values of the points requested by other processes */
+    ierr = PetscSectionCreate(PETSC_COMM_SELF, &sendSection);CHKERRQ(ierr);
+    ierr = PetscSectionSetChart(sendSection, 0, pEnd);CHKERRQ(ierr);
+    for (v = 0; v < numValues; ++v) {
+      IS              pointIS;
+      const PetscInt *points;
+
+      ierr = DMLabelGetStratumIS(label, values[v], &pointIS);CHKERRQ(ierr);
+      if (!pointIS) continue;
+      ierr = ISGetLocalSize(pointIS, &n);CHKERRQ(ierr);
+      ierr = ISGetIndices(pointIS, &points);CHKERRQ(ierr);
+      for (i = 0; i < n; ++i) {
+        if (points[i] < pStart || points[i] >= pEnd || !rootDegree[points[i]]) continue;
+        ierr = PetscSectionAddDof(sendSection, points[i], 1);CHKERRQ(ierr);
+      }
+      ierr = ISRestoreIndices(pointIS, &points);CHKERRQ(ierr);
+      ierr = ISDestroy(&pointIS);CHKERRQ(ierr);
+    }
+    ierr = PetscSectionSetUp(sendSection);CHKERRQ(ierr);
+    ierr = PetscSectionGetStorageSize(sendSection, &size);CHKERRQ(ierr);
+    ierr = PetscMalloc1(size, &sendValues);CHKERRQ(ierr);
+    ierr = PetscArrayzero(work, pEnd);CHKERRQ(ierr);
+    for (v = 0; v < numValues; ++v) {
+      IS              pointIS;
+      const PetscInt *points;
+
+      ierr = DMLabelGetStratumIS(label, values[v], &pointIS);CHKERRQ(ierr);
+      if (!pointIS) continue;
+      ierr = ISGetLocalSize(pointIS, &n);CHKERRQ(ierr);
+      ierr = ISGetIndices(pointIS, &points);CHKERRQ(ierr);
+      for (i = 0; i < n; ++i) {
+        if (points[i] < pStart || points[i] >= pEnd || !rootDegree[points[i]]) continue;
+        ierr = PetscSectionGetOffset(sendSection, points[i], &off);CHKERRQ(ierr);
+        sendValues[off + work[points[i]]++] = values[v];
+      }
+      ierr = ISRestoreIndices(pointIS, &points);CHKERRQ(ierr);
+      ierr = ISDestroy(&pointIS);CHKERRQ(ierr);
+    }
+    ierr = DMPlexOverlapSectionCreate_Static(sfIn, NULL, NULL, sendSection, NULL, NULL, &recvSection, &recvSF);CHKERRQ(ierr);
+    ierr = PetscSectionGetStorageSize(recvSection, &size);CHKERRQ(ierr);
+    ierr = PetscMalloc1(size, &recvValues);CHKERRQ(ierr);
+    ierr = PetscSFBcastBegin(recvSF, MPIU_INT, sendValues, recvValues, MPI_REPLACE);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(recvSF, MPIU_INT, sendValues, recvValues, MPI_REPLACE);CHKERRQ(ierr);
+    ierr = PetscFree(sendValues);CHKERRQ(ierr);
+    ierr = PetscSectionDestroy(&sendSection);CHKERRQ(ierr);
+    ierr = PetscSFDestroy(&recvSF);CHKERRQ(ierr);
+    /* Create the strata in sorted order, as DMLabelDistribute() does */
+    ierr = DMLabelCreate(PETSC_COMM_SELF, name, &labelNew);CHKERRQ(ierr);
+    ierr = DMLabelGetDefaultValue(label, &defaultValue);CHKERRQ(ierr);
+    ierr = DMLabelSetDefaultValue(labelNew, defaultValue);CHKERRQ(ierr);
+    numStrata = numValues + size;
+    ierr = PetscMalloc1(numStrata, &strata);CHKERRQ(ierr);
+    ierr = PetscArraycpy(strata, values, numValues);CHKERRQ(ierr);
+    ierr = PetscArraycpy(&strata[numValues], recvValues, size);CHKERRQ(ierr);
+    ierr = DMLabelAddStrata(labelNew, numStrata, strata);CHKERRQ(ierr);
+    ierr = PetscFree(strata);CHKERRQ(ierr);
+    for (v = 0; v < numValues; ++v) {
+      IS              pointIS, newIS;
+      const PetscInt *points;
+      PetscInt       *newPoints;
+
+      ierr = DMLabelGetStratumIS(label, values[v], &pointIS);CHKERRQ(ierr);
+      if (!pointIS) continue;
+      ierr = ISGetLocalSize(pointIS, &n);CHKERRQ(ierr);
+      ierr = ISGetIndices(pointIS, &points);CHKERRQ(ierr);
+      ierr = PetscMalloc1(n, &newPoints);CHKERRQ(ierr);
+      for (i = 0, k = 0; i < n; ++i) {
+        if (points[i] < pStart || points[i] >= pEnd) continue;
+        newPoints[k++] = oldToNew[points[i]];
+      }
+      ierr = ISRestoreIndices(pointIS, &points);CHKERRQ(ierr);
+      ierr = ISDestroy(&pointIS);CHKERRQ(ierr);
+      ierr = ISCreateGeneral(PETSC_COMM_SELF, k, newPoints, PETSC_OWN_POINTER, &newIS);CHKERRQ(ierr);
+      ierr = DMLabelSetStratumIS(labelNew, values[v], newIS);CHKERRQ(ierr);
+      ierr = ISDestroy(&newIS);CHKERRQ(ierr);
+    }
+    ierr = ISRestoreIndices(valueIS, &values);CHKERRQ(ierr);
+    ierr = ISDestroy(&valueIS);CHKERRQ(ierr);
+    for (k = 0; k < nNew; ++k) {
+      ierr = PetscSectionGetDof(recvSection, k, &dof);CHKERRQ(ierr);
+      ierr = PetscSectionGetOffset(recvSection, k, &off);CHKERRQ(ierr);
+      for (i = 0; i < dof; ++i) {ierr = DMLabelSetValue(labelNew, newPoint[k], recvValues[off+i]);CHKERRQ(ierr);}
+    }
+    ierr = PetscFree(recvValues);CHKERRQ(ierr);
+    ierr = PetscSectionDestroy(&recvSection);CHKERRQ(ierr);
+    ierr = DMAddLabel(dmNew, labelNew);CHKERRQ(ierr);
+    ierr = DMGetLabelOutput(dm, name, &isOutput);CHKERRQ(ierr);
+    ierr = DMSetLabelOutput(dmNew, name, isOutput);CHKERRQ(ierr);
+    ierr = DMLabelDestroy(&labelNew);CHKERRQ(ierr);
+  }
+  ierr = PetscLogEventEnd(DMPLEX_DistributeLabels, dm, 0, 0, 0);CHKERRQ(ierr);
+  /* Coordinates */
+  {
+    PetscSection       coordSection, coordSectionNew;
+    Vec                coordinates, coordinatesNew;
+    const PetscScalar *coords;
+    PetscScalar       *coordsNew, *recvCoords;
+    const PetscReal   *maxCell, *L;
+    const DMBoundaryType *bd;
+    const char        *name;
+    PetscInt           bs, size, cpStart, cpEnd, dof, off, noff, i;
+    PetscBool          isper;
+
+    ierr = DMGetCoordinatesLocal(dm, &coordinates);CHKERRQ(ierr);
+    if (coordinates) {
+      ierr = DMGetCoordinateSection(dm, &coordSection);CHKERRQ(ierr);
+      ierr = PetscSectionCreate(comm, &coordSectionNew);CHKERRQ(ierr);
+      ierr = DMPlexOverlapSectionCreate_Static(sfIn, oldToNew, newPoint, coordSection, coordSection, coordSectionNew, &recvSection, &recvSF);CHKERRQ(ierr);
+      ierr = DMSetCoordinateSection(dmNew, cdim, coordSectionNew);CHKERRQ(ierr);
+      ierr = VecCreate(PETSC_COMM_SELF, &coordinatesNew);CHKERRQ(ierr);
+      ierr = PetscObjectGetName((PetscObject) coordinates, &name);CHKERRQ(ierr);
+      ierr = PetscObjectSetName((PetscObject) coordinatesNew, name);CHKERRQ(ierr);
+      ierr = PetscSectionGetStorageSize(coordSectionNew, &size);CHKERRQ(ierr);
+      ierr = VecSetSizes(coordinatesNew, size, PETSC_DETERMINE);CHKERRQ(ierr);
+      ierr = VecGetBlockSize(coordinates, &bs);CHKERRQ(ierr);
+      ierr = VecSetBlockSize(coordinatesNew, bs);CHKERRQ(ierr);
+      ierr = VecSetType(coordinatesNew, dm->vectype);CHKERRQ(ierr);
+      ierr = PetscSectionGetStorageSize(recvSection, &size);CHKERRQ(ierr);
+      ierr = PetscMalloc1(size, &recvCoords);CHKERRQ(ierr);
+      ierr = VecGetArrayRead(coordinates, &coords);CHKERRQ(ierr);
+      ierr = VecGetArray(coordinatesNew, &coordsNew);CHKERRQ(ierr);
+      ierr = PetscSFBcastBegin(recvSF, MPIU_SCALAR, coords, recvCoords, MPI_REPLACE);CHKERRQ(ierr);
+      ierr = PetscSectionGetChart(coordSection, &cpStart, &cpEnd);CHKERRQ(ierr);
+      for (p = cpStart; p < cpEnd; ++p) {
+        ierr = PetscSectionGetDof(coordSection, p, &dof);CHKERRQ(ierr);
+        ierr = PetscSectionGetOffset(coordSection, p, &off);CHKERRQ(ierr);
+        ierr = PetscSectionGetOffset(coordSectionNew, oldToNew[p], &noff);CHKERRQ(ierr);
+        for (i = 0; i < dof; ++i) coordsNew[noff+i] = coords[off+i];
+      }
+      ierr = PetscSFBcastEnd(recvSF, MPIU_SCALAR, coords, recvCoords, MPI_REPLACE);CHKERRQ(ierr);
+      for (k = 0; k < nNew; ++k) {
+        ierr = PetscSectionGetDof(recvSection, k, &dof);CHKERRQ(ierr);
+        if (!dof) continue;
+        ierr = PetscSectionGetOffset(recvSection, k, &off);CHKERRQ(ierr);
+        ierr = PetscSectionGetOffset(coordSectionNew, newPoint[k], &noff);CHKERRQ(ierr);
+        for (i = 0; i < dof; ++i) coordsNew[noff+i] = recvCoords[off+i];
+      }
+      ierr = VecRestoreArrayRead(coordinates, &coords);CHKERRQ(ierr);
+      ierr = VecRestoreArray(coordinatesNew, &coordsNew);CHKERRQ(ierr);
+      ierr = DMSetCoordinatesLocal(dmNew, coordinatesNew);CHKERRQ(ierr);
+      ierr = VecDestroy(&coordinatesNew);CHKERRQ(ierr);
+      ierr = PetscFree(recvCoords);CHKERRQ(ierr);
+      ierr = PetscSectionDestroy(&coordSectionNew);CHKERRQ(ierr);
+      ierr = PetscSectionDestroy(&recvSection);CHKERRQ(ierr);
+      ierr = PetscSFDestroy(&recvSF);CHKERRQ(ierr);
+    }
+    ierr = DMGetPeriodicity(dm, &isper, &maxCell, &L, &bd);CHKERRQ(ierr);
+    ierr = DMSetPeriodicity(dmNew, isper, maxCell, L, bd);CHKERRQ(ierr);
+    ierr = DMGetCoordinateDM(dm, &cdm);CHKERRQ(ierr);
+    ierr = DMGetCoordinateDM(dmNew, &cdmNew);CHKERRQ(ierr);
+    ierr = DMCopyDisc(cdm, cdmNew);CHKERRQ(ierr);
+  }
+  ierr = DMPlexGetReferenceTree(dm, &refTree);CHKERRQ(ierr);
+  ierr = DMPlexSetReferenceTree(dmNew, refTree);CHKERRQ(ierr);
+  ((DM_Plex*) dmNew->data)->useAnchors = mesh->useAnchors;
+  /* Point SF: every shared and incoming point keeps its owner, whose new number is sent over the old point SF and sfIn */
+  {
+    PetscSF      sfPointNew;
+    PetscSFNode *remotesNew, tmp;
+    PetscInt    *leavesNew, *remoteNew;
+
+    ierr = PetscMalloc1(nleaves+nNew, &leavesNew);CHKERRQ(ierr);
+    ierr = PetscMalloc1(nleaves+nNew, &remotesNew);CHKERRQ(ierr);
+    ierr = PetscMalloc1(nNew, &remoteNew);CHKERRQ(ierr);
+    ierr = PetscSFBcastBegin(sfPoint, MPIU_INT, oldToNew, work, MPI_REPLACE);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sfPoint, MPIU_INT, oldToNew, work, MPI_REPLACE);CHKERRQ(ierr);
+    ierr = PetscSFBcastBegin(sfIn, MPIU_INT, oldToNew, remoteNew, MPI_REPLACE);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sfIn, MPIU_INT, oldToNew, remoteNew, MPI_REPLACE);CHKERRQ(ierr);
+    for (l = 0; l < nleaves; ++l) {
+      const PetscInt leaf = leaves ? leaves[l] : l;
+
+      leavesNew[l]        = oldToNew[leaf];
+      remotesNew[l].rank  = remotes[l].rank;
+      remotesNew[l].index = work[leaf];
+    }
+    for (k = 0; k < nNew; ++k) {
+      leavesNew[nleaves+k]        = newPoint[k];
+      remotesNew[nleaves+k].rank  = newRemote[k].rank;
+      remotesNew[nleaves+k].index = remoteNew[k];
+    }
+    ierr = PetscFree(remoteNew);CHKERRQ(ierr);
+    ierr = PetscSortIntWithDataArray(nleaves+nNew, leavesNew, remotesNew, sizeof(PetscSFNode), &tmp);CHKERRQ(ierr);
+    ierr = PetscSFCreate(comm, &sfPointNew);CHKERRQ(ierr);
+    ierr = PetscSFSetGraph(sfPointNew, pEndNew, nleaves+nNew, leavesNew, PETSC_OWN_POINTER, remotesNew, PETSC_OWN_POINTER);CHKERRQ(ierr);
+    ierr = PetscSFSetFromOptions(sfPointNew);CHKERRQ(ierr);
+    ierr = DMSetPointSF(dmNew, sfPointNew);CHKERRQ(ierr);
+    ierr = DMGetCoordinateDM(dmNew, &cdmNew);CHKERRQ(ierr);
+    if (cdmNew) {ierr = DMSetPointSF(cdmNew, sfPointNew);CHKERRQ(ierr);}
+    ierr = PetscSFDestroy(&sfPointNew);CHKERRQ(ierr);
+  }
+  /* Migration SF from the original points to the extended mesh */
+  {
+    PetscSFNode *iremote;
+    PetscInt    *ilocal;
+
+    ierr = PetscMalloc1(pEndNew, &ilocal);CHKERRQ(ierr);
+    ierr = PetscMalloc1(pEndNew, &iremote);CHKERRQ(ierr);
+    for (p = 0; p < pEnd; ++p) {ilocal[p] = oldToNew[p]; iremote[p] = owners[p];}
+    for (k = 0; k < nNew; ++k) {ilocal[pEnd+k] = newPoint[k]; iremote[pEnd+k] = newRemote[k];}
+    ierr = PetscSFCreate(comm, sf);CHKERRQ(ierr);
+    ierr = PetscSFSetGraph(*sf, pEnd, pEndNew, ilocal, PETSC_OWN_POINTER, iremote, PETSC_OWN_POINTER);CHKERRQ(ierr);
+    ierr = PetscObjectSetName((PetscObject) *sf, "Overlap SF");CHKERRQ(ierr);
+    ierr = PetscSFSetFromOptions(*sf);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(work);CHKERRQ(ierr);
+  ierr = PetscFree(owners);CHKERRQ(ierr);
+  ierr = PetscFree(oldToNew);CHKERRQ(ierr);
+  ierr = PetscFree(newPoint);CHKERRQ(ierr);
+  ierr = PetscHMapIJDestroy(&remoteHash);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sfIn);CHKERRQ(ierr);
+  *dmOverlap = dmNew;
+  PetscFunctionReturn(0);
+}
+
 /*@C
   DMPlexDistributeOverlap - Add partition overlap to a distributed non-overlapping DM.
 
@@ -1774,19 +2434,24 @@ PetscErrorCode DMPlexDistribute(DM dm, PetscInt overlap, PetscSF *sf, DM *dmPara
   The user can control the definition of adjacency for the mesh using DMSetAdjacency(). They should choose the combination appropriate for the function
   representation on the mesh.
 
+  If DMPlexSetOverlapLocalCopy() has been called, the existing points are copied locally and only the incoming overlap points are communicated,
+  which avoids migrating the whole mesh. The existing points then keep their relative order inside each stratum. This only reduces the
+  communication: dmOverlap is still a complete new mesh, so the input mesh and dmOverlap are in memory at the same time.
+
   Level: advanced
 
-.seealso: DMPlexCreate(), DMSetAdjacency(), DMPlexDistribute(), DMPlexCreateOverlapLabel(), DMPlexGetOverlap()
+.seealso: DMPlexCreate(), DMSetAdjacency(), DMPlexDistribute(), DMPlexCreateOverlapLabel(), DMPlexGetOverlap(), DMPlexSetOverlapLocalCopy()
 @*/
 PetscErrorCode DMPlexDistributeOverlap(DM dm, PetscInt overlap, PetscSF *sf, DM *dmOverlap)
 {
+  DM_Plex               *mesh = (DM_Plex*) dm->data;
   MPI_Comm               comm;
   PetscMPIInt            size, rank;
   PetscSection           rootSection, leafSection;
   IS                     rootrank, leafrank;
   DM                     dmCoord;
   DMLabel                lblOverlap;
-  PetscSF                sfOverlap, sfStratified, sfPoint;
+  PetscSF                sfOverlap = NULL, sfStratified, sfPoint;
   PetscErrorCode         ierr;
 
   PetscFunctionBegin;
@@ -1809,32 +2474,37 @@ PetscErrorCode DMPlexDistributeOverlap(DM dm, PetscInt overlap, PetscSF *sf, DM
   ierr = PetscSectionCreate(comm, &leafSection);CHKERRQ(ierr);
   ierr = DMPlexDistributeOwnership(dm, rootSection, &rootrank, leafSection, &leafrank);CHKERRQ(ierr);
   ierr = DMPlexCreateOverlapLabel(dm, overlap, rootSection, rootrank, leafSection, leafrank, &lblOverlap);CHKERRQ(ierr);
-  /* Convert overlap label to stratified migration SF */
-  ierr = DMPlexPartitionLabelCreateSF(dm, lblOverlap, &sfOverlap);CHKERRQ(ierr);
-  ierr = DMPlexStratifyMigrationSF(dm, sfOverlap, &sfStratified);CHKERRQ(ierr);
-  ierr = PetscSFDestroy(&sfOverlap);CHKERRQ(ierr);
-  sfOverlap = sfStratified;
-  ierr = PetscObjectSetName((PetscObject) sfOverlap, "Overlap SF");CHKERRQ(ierr);
-  ierr = PetscSFSetFromOptions(sfOverlap);CHKERRQ(ierr);
-
   ierr = PetscSectionDestroy(&rootSection);CHKERRQ(ierr);
   ierr = PetscSectionDestroy(&leafSection);CHKERRQ(ierr);
   ierr = ISDestroy(&rootrank);CHKERRQ(ierr);
   ierr = ISDestroy(&leafrank);CHKERRQ(ierr);
   ierr = PetscLogEventEnd(DMPLEX_Partition,dm,0,0,0);CHKERRQ(ierr);
 
-  /* Build the overlapping DM */
-  ierr = DMPlexCreate(comm, dmOverlap);CHKERRQ(ierr);
-  ierr = PetscObjectSetName((PetscObject) *dmOverlap, "Parallel Mesh");CHKERRQ(ierr);
-  ierr = DMPlexMigrate(dm, sfOverlap, *dmOverlap);CHKERRQ(ierr);
+  /* Append the incoming overlap points to the local mesh if its point layout allows it */
+  if (mesh->overlapLocalCopy) {ierr = DMPlexDistributeOverlapLocalCopy_Static(dm, lblOverlap, &sfOverlap, dmOverlap);CHKERRQ(ierr);}
+  if (!*dmOverlap) {
+    /* Convert overlap label to stratified migration SF */
+    ierr = DMPlexPartitionLabelCreateSF(dm, lblOverlap, &sfOverlap);CHKERRQ(ierr);
+    ierr = DMPlexStratifyMigrationSF(dm, sfOverlap, &sfStratified);CHKERRQ(ierr);
+    ierr = PetscSFDestroy(&sfOverlap);CHKERRQ(ierr);
+    sfOverlap = sfStratified;
+    ierr = PetscObjectSetName((PetscObject) sfOverlap, "Overlap SF");CHKERRQ(ierr);
+    ierr = PetscSFSetFromOptions(sfOverlap);CHKERRQ(ierr);
+
+    /* Build the overlapping DM */
+    ierr = DMPlexCreate(comm, dmOverlap);CHKERRQ(ierr);
+    ierr = PetscObjectSetName((PetscObject) *dmOverlap, "Parallel Mesh");CHKERRQ(ierr);
+    ierr = DMPlexMigrate(dm, sfOverlap, *dmOverlap);CHKERRQ(ierr);
+    /* Build the new point SF */
+    ierr = DMPlexCreatePointSF(*dmOverlap, sfOverlap, PETSC_FALSE, &sfPoint);CHKERRQ(ierr);
+    ierr = DMSetPointSF(*dmOverlap, sfPoint);CHKERRQ(ierr);
+    ierr = DMGetCoordinateDM(*dmOverlap, &dmCoord);CHKERRQ(ierr);
+    if (dmCoord) {ierr = DMSetPointSF(dmCoord, sfPoint);CHKERRQ(ierr);}
+    ierr = PetscSFDestroy(&sfPoint);CHKERRQ(ierr);
+  }
   /* Store the overlap in the new DM */
-  ((DM_Plex*)(*dmOverlap)->data)->overlap = overlap + ((DM_Plex*)dm->data)->overlap;
-  /* Build the new point SF */
-  ierr = DMPlexCreatePointSF(*dmOverlap, sfOverlap, PETSC_FALSE, &sfPoint);CHKERRQ(ierr);
-  ierr = DMSetPointSF(*dmOverlap, sfPoint);CHKERRQ(ierr);
-  ierr = DMGetCoordinateDM(*dmOverlap, &dmCoord);CHKERRQ(ierr);
-  if (dmCoord) {ierr = DMSetPointSF(dmCoord, sfPoint);CHKERRQ(ierr);}
-  ierr = PetscSFDestroy(&sfPoint);CHKERRQ(ierr);
+  ((DM_Plex*)(*dmOverlap)->data)->overlap = overlap + mesh->overlap;
+  ((DM_Plex*)(*dmOverlap)->data)->overlapLocalCopy = mesh->overlapLocalCopy;
   /* Cleanup overlap partition */
   ierr = DMLabelDestroy(&lblOverlap);CHKERRQ(ierr);
   if (sf) *sf = sfOverlap;
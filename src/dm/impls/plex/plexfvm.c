@@ -198,3 +198,352 @@ PetscErrorCode DMPlexReconstructGradientsFVM(DM dm, Vec locX, Vec grad)
   ierr = DMPlexReconstructGradients_Internal(dm, fvm, fStart, fEnd, faceGeometryFVM, cellGeometryFVM, locX, grad);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
+
+/* Face connectivity and compacted geometry for the faces carrying a finite volume flux, stored as separate arrays so that the flux loop
+   does not query the ghost label, the support, or the face and cell geometry vectors */
+typedef struct {
+  DMLabel          ghostLabel;     /* The label used to select the flux faces */
+  PetscObjectState ghostState;
+  PetscObjectId    faceGeomId, cellGeomId;
+  PetscObjectState faceGeomState, cellGeomState;
+  PetscInt         fStart, fEnd;   /* The face range used to build the data */
+  PetscBool        usable;         /* False if some flux face does not have two supporting cells */
+  PetscInt         chunkSize;      /* Number of faces processed at once, or PETSC_DETERMINE */
+  PetscInt         Nface;          /* Number of flux faces */
+  PetscInt        *cellL, *cellR;  /* Supporting cells of each flux face */
+  PetscBool       *updL, *updR;    /* Whether the flux is accumulated into the supporting cells */
+  PetscFVFaceGeom *fgeom;          /* Face geometry */
+  PetscReal       *vol;            /* Volumes of the supporting cells, interlaced */
+  PetscReal       *dx;             /* Offsets from the supporting cell centroids to the face centroid, interlaced */
+} DMPlexFaceData_FVM;
+
+static PetscErrorCode DMPlexFaceDataReset_FVM(DMPlexFaceData_FVM *fd)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree7(fd->cellL, fd->cellR, fd->updL, fd->updR, fd->fgeom, fd->vol, fd->dx);CHKERRQ(ierr);
+  fd->Nface = 0;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode DMPlexFaceDataDestroy_FVM(void *ctx)
+{
+  DMPlexFaceData_FVM *fd = (DMPlexFaceData_FVM *) ctx;
+  PetscErrorCode      ierr;
+
+  PetscFunctionBegin;
+  ierr = DMPlexFaceDataReset_FVM(fd);CHKERRQ(ierr);
+  ierr = PetscFree(fd);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Sort the flux faces by their left, then right, cell so that the gather and scatter sweep the cells in order */
+static PetscErrorCode DMPlexFaceDataSort_FVM(PetscInt dim, DMPlexFaceData_FVM *fd)
+{
+  const PetscInt   Nface = fd->Nface;
+  PetscInt        *perm, *key, *cellL, *cellR;
+  PetscBool       *updL, *updR;
+  PetscFVFaceGeom *fgeom;
+  PetscReal       *vol, *dx;
+  PetscInt         i, j, d;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc2(Nface, &perm, Nface, &key);CHKERRQ(ierr);
+  for (i = 0; i < Nface; ++i) {perm[i] = i; key[i] = fd->cellL[i];}
+  ierr = PetscSortIntWithArray(Nface, key, perm);CHKERRQ(ierr);
+  for (i = 0; i < Nface; i = j) {
+    for (j = i+1; j < Nface && key[j] == key[i]; ++j);
+    ierr = PetscSortInt(j-i, &perm[i]);CHKERRQ(ierr);
+    for (d = i; d < j; ++d) key[d] = fd->cellR[perm[d]];
+    ierr = PetscSortIntWithArray(j-i, &key[i], &perm[i]);CHKERRQ(ierr);
+  }
+  ierr = PetscMalloc7(Nface, &cellL, Nface, &cellR, Nface, &updL, Nface, &updR, Nface, &fgeom, Nface*2, &vol, Nface*2*dim, &dx);CHKERRQ(ierr);
+  for (i = 0; i < Nface; ++i) {
+    const PetscInt p = perm[i];
+
+    cellL[i] = fd->cellL[p]; cellR[i] = fd->cellR[p];
+    updL[i]  = fd->updL[p];  updR[i]  = fd->updR[p];
+    fgeom[i] = fd->fgeom[p];
+    vol[i*2+0] = fd->vol[p*2+0]; vol[i*2+1] = fd->vol[p*2+1];
+    for (d = 0; d < 2*dim; ++d) dx[i*2*dim+d] = fd->dx[p*2*dim+d];
+  }
+  ierr = DMPlexFaceDataReset_FVM(fd);CHKERRQ(ierr);
+  fd->Nface = Nface;
+  fd->cellL = cellL; fd->cellR = cellR; fd->updL = updL; fd->updR = updR;
+  fd->fgeom = fgeom; fd->vol = vol; fd->dx = dx;
+  ierr = PetscFree2(perm, key);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode DMPlexFaceDataSetUp_FVM(DM dm, PetscInt fStart, PetscInt fEnd, Vec faceGeometry, Vec cellGeometry, DMPlexFaceData_FVM *fd)
+{
+  DM                 dmFace, dmCell;
+  DMLabel            ghostLabel;
+  const PetscScalar *facegeom, *cellgeom;
+  PetscBool          sortFaces = PETSC_FALSE;
+  PetscInt           dim, face, iface, d;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = DMPlexFaceDataReset_FVM(fd);CHKERRQ(ierr);
+  ierr = DMGetDimension(dm, &dim);CHKERRQ(ierr);
+  ierr = DMGetLabel(dm, "ghost", &ghostLabel);CHKERRQ(ierr);
+  fd->ghostLabel = ghostLabel;
+  fd->ghostState = 0;
+  if (ghostLabel) {ierr = PetscObjectStateGet((PetscObject) ghostLabel, &fd->ghostState);CHKERRQ(ierr);}
+  ierr = PetscObjectGetId((PetscObject) faceGeometry, &fd->faceGeomId);CHKERRQ(ierr);
+  ierr = PetscObjectStateGet((PetscObject) faceGeometry, &fd->faceGeomState);CHKERRQ(ierr);
+  ierr = PetscObjectGetId((PetscObject) cellGeometry, &fd->cellGeomId);CHKERRQ(ierr);
+  ierr = PetscObjectStateGet((PetscObject) cellGeometry, &fd->cellGeomState);CHKERRQ(ierr);
+  fd->fStart    = fStart;
+  fd->fEnd      = fEnd;
+  fd->usable    = PETSC_TRUE;
+  fd->chunkSize = PETSC_DETERMINE;
+  ierr = PetscOptionsGetInt(((PetscObject) dm)->options, ((PetscObject) dm)->prefix, "-dm_plex_fvm_chunk_size", &fd->chunkSize, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(((PetscObject) dm)->options, ((PetscObject) dm)->prefix, "-dm_plex_fvm_sort_faces", &sortFaces, NULL);CHKERRQ(ierr);
+  /* Select the same faces as DMPlexGetFaceFields() */
+  for (face = fStart; face < fEnd; ++face) {
+    PetscInt ghost = -1, nsupp, nchild;
+
+    if (ghostLabel) {ierr = DMLabelGetValue(ghostLabel, face, &ghost);CHKERRQ(ierr);}
+    ierr = DMPlexGetSupportSize(dm, face, &nsupp);CHKERRQ(ierr);
+    ierr = DMPlexGetTreeChildren(dm, face, &nchild, NULL);CHKERRQ(ierr);
+    if (ghost >= 0 || nsupp > 2 || nchild > 0) continue;
+    if (nsupp < 2) fd->usable = PETSC_FALSE;
+    ++fd->Nface;
+  }
+  if (!fd->usable) {fd->Nface = 0; PetscFunctionReturn(0);}
+  ierr = PetscMalloc7(fd->Nface, &fd->cellL, fd->Nface, &fd->cellR, fd->Nface, &fd->updL, fd->Nface, &fd->updR, fd->Nface, &fd->fgeom, fd->Nface*2, &fd->vol, fd->Nface*2*dim, &fd->dx);CHKERRQ(ierr);
+  ierr = VecGetDM(faceGeometry, &dmFace);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(faceGeometry, &facegeom);CHKERRQ(ierr);
+  ierr = VecGetDM(cellGeometry, &dmCell);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(cellGeometry, &cellgeom);CHKERRQ(ierr);
+  for (face = fStart, iface = 0; face < fEnd; ++face) {
+    const PetscInt  *cells;
+    PetscFVFaceGeom *fg;
+    PetscFVCellGeom *cgL, *cgR;
+    PetscInt         ghost = -1, nsupp, nchild;
+
+    if (ghostLabel) {ierr = DMLabelGetValue(ghostLabel, face, &ghost);CHKERRQ(ierr);}
+    ierr = DMPlexGetSupportSize(dm, face, &nsupp);CHKERRQ(ierr);
+    ierr = DMPlexGetTreeChildren(dm, face, &nchild, NULL);CHKERRQ(ierr);
+    if (ghost >= 0 || nsupp > 2 || nchild > 0) continue;
+    ierr = DMPlexGetSupport(dm, face, &cells);CHKERRQ(ierr);
+    ierr = DMPlexPointLocalRead(dmFace, face, facegeom, &fg);CHKERRQ(ierr);
+    ierr = DMPlexPointLocalRead(dmCell, cells[0], cellgeom, &cgL);CHKERRQ(ierr);
+    ierr = DMPlexPointLocalRead(dmCell, cells[1], cellgeom, &cgR);CHKERRQ(ierr);
+    fd->cellL[iface] = cells[0];
+    fd->cellR[iface] = cells[1];
+    fd->updL[iface]  = PETSC_TRUE;
+    fd->updR[iface]  = PETSC_TRUE;
+    if (ghostLabel) {
+      ierr = DMLabelGetValue(ghostLabel, cells[0], &ghost);CHKERRQ(ierr);
+      fd->updL[iface] = ghost <= 0 ? PETSC_TRUE : PETSC_FALSE;
+      ierr = DMLabelGetValue(ghostLabel, cells[1], &ghost);CHKERRQ(ierr);
+      fd->updR[iface] = ghost <= 0 ? PETSC_TRUE : PETSC_FALSE;
+    }
+    ierr = PetscArrayzero(&fd->fgeom[iface], 1);CHKERRQ(ierr);
+    for (d = 0; d < dim; ++d) {
+      fd->fgeom[iface].centroid[d] = fg->centroid[d];
+      fd->fgeom[iface].normal[d]   = fg->normal[d];
+    }
+    fd->vol[iface*2+0] = cgL->volume;
+    fd->vol[iface*2+1] = cgR->volume;
+    DMPlex_WaxpyD_Internal(dim, -1, cgL->centroid, fg->centroid, &fd->dx[(iface*2+0)*dim]);
+    DMPlex_WaxpyD_Internal(dim, -1, cgR->centroid, fg->centroid, &fd->dx[(iface*2+1)*dim]);
+    ++iface;
+  }
+  ierr = VecRestoreArrayRead(faceGeometry, &facegeom);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(cellGeometry, &cellgeom);CHKERRQ(ierr);
+  if (sortFaces && fd->Nface > 1) {ierr = DMPlexFaceDataSort_FVM(dim, fd);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+/* Return the cached flux face data, rebuilding it if the ghost label or geometry changed */
+static PetscErrorCode DMPlexGetFaceData_FVM(DM dm, PetscInt fStart, PetscInt fEnd, Vec faceGeometry, Vec cellGeometry, DMPlexFaceData_FVM **faceData)
+{
+  PetscContainer      container;
+  DMPlexFaceData_FVM *fd;
+  DMLabel             ghostLabel;
+  PetscObjectId       fId, cId;
+  PetscObjectState    gState = 0, fState, cState;
+  PetscErrorCode      ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectQuery((PetscObject) dm, "DMPlex_facedata_fvm", (PetscObject *) &container);CHKERRQ(ierr);
+  if (!container) {
+    ierr = PetscNew(&fd);CHKERRQ(ierr);
+    ierr = DMPlexFaceDataSetUp_FVM(dm, fStart, fEnd, faceGeometry, cellGeometry, fd);CHKERRQ(ierr);
+    ierr = PetscContainerCreate(PETSC_COMM_SELF, &container);CHKERRQ(ierr);
+    ierr = PetscContainerSetPointer(container, (void *) fd);CHKERRQ(ierr);
+    ierr = PetscContainerSetUserDestroy(container, DMPlexFaceDataDestroy_FVM);CHKERRQ(ierr);
+    ierr = PetscObjectCompose((PetscObject) dm, "DMPlex_facedata_fvm", (PetscObject) container);CHKERRQ(ierr);
+    ierr = PetscContainerDestroy(&container);CHKERRQ(ierr);
+    *faceData = fd;
+    PetscFunctionReturn(0);
+  }
+  ierr = PetscContainerGetPointer(container, (void **) &fd);CHKERRQ(ierr);
+  ierr = DMGetLabel(dm, "ghost", &ghostLabel);CHKERRQ(ierr);
+  if (ghostLabel) {ierr = PetscObjectStateGet((PetscObject) ghostLabel, &gState);CHKERRQ(ierr);}
+  ierr = PetscObjectGetId((PetscObject) faceGeometry, &fId);CHKERRQ(ierr);
+  ierr = PetscObjectStateGet((PetscObject) faceGeometry, &fState);CHKERRQ(ierr);
+  ierr = PetscObjectGetId((PetscObject) cellGeometry, &cId);CHKERRQ(ierr);
+  ierr = PetscObjectStateGet((PetscObject) cellGeometry, &cState);CHKERRQ(ierr);
+  if (fd->ghostLabel != ghostLabel || fd->ghostState != gState || fd->faceGeomId != fId || fd->faceGeomState != fState ||
+      fd->cellGeomId != cId || fd->cellGeomState != cState || fd->fStart != fStart || fd->fEnd != fEnd) {
+    ierr = DMPlexFaceDataSetUp_FVM(dm, fStart, fEnd, faceGeometry, cellGeometry, fd);CHKERRQ(ierr);
+  }
+  *faceData = fd;
+  PetscFunctionReturn(0);
+}
+
+/*
+  DMPlexComputeFluxFVM_Internal - Compute the finite volume fluxes over faces [fStart, fEnd) and accumulate them into locF
+
+  Input Parameters:
++ dm           - The DM
+. ds           - The PetscDS
+. isImplicit   - Only integrate the fields with this implicit flag
+. fStart       - The first face
+. fEnd         - The first face to exclude
+. locX         - The local solution
+. faceGeometry - The face geometry from DMPlexGetGeometryFVM()
+. cellGeometry - The cell geometry from DMPlexGetGeometryFVM()
+. locGrad      - The local reconstructed gradients, or NULL
+- locF         - The local residual
+
+  Output Parameter:
+. computed - PETSC_FALSE if the fluxes must be computed with DMPlexGetFaceFields() instead
+
+  Notes:
+  The face to cell connectivity and the face geometry are precomputed and cached on the DM, and the faces are processed in chunks
+  sized to fit in cache, which can be set with -dm_plex_fvm_chunk_size. The option -dm_plex_fvm_sort_faces orders the faces by
+  their supporting cells, which is most effective after the cells have been renumbered with DMPlexGetOrdering() and DMPlexPermute().
+  This is only used when all fields are finite volume fields.
+*/
+PetscErrorCode DMPlexComputeFluxFVM_Internal(DM dm, PetscDS ds, PetscBool isImplicit, PetscInt fStart, PetscInt fEnd, Vec locX, Vec faceGeometry, Vec cellGeometry, Vec locGrad, Vec locF, PetscBool *computed)
+{
+  DM                  dmGrad = NULL;
+  DMPlexFaceData_FVM *fd = NULL;
+  const PetscScalar  *x, *lgrad = NULL;
+  PetscScalar        *fa, *uL, *uR, *fluxL, *fluxR;
+  PetscInt            dim, Nf, f, Nc, totDim, chunkSize, fS;
+  PetscErrorCode      ierr;
+
+  PetscFunctionBegin;
+  *computed = PETSC_FALSE;
+  ierr = PetscDSGetNumFields(ds, &Nf);CHKERRQ(ierr);
+  for (f = 0; f < Nf; ++f) {
+    PetscObject  obj;
+    PetscClassId id;
+
+    ierr = PetscDSGetDiscretization(ds, f, &obj);CHKERRQ(ierr);
+    ierr = PetscObjectGetClassId(obj, &id);CHKERRQ(ierr);
+    if (id != PETSCFV_CLASSID) PetscFunctionReturn(0);
+  }
+  ierr = DMPlexGetFaceData_FVM(dm, fStart, fEnd, faceGeometry, cellGeometry, &fd);CHKERRQ(ierr);
+  if (!fd->usable) PetscFunctionReturn(0);
+  ierr = DMGetDimension(dm, &dim);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalComponents(ds, &Nc);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalDimension(ds, &totDim);CHKERRQ(ierr);
+  chunkSize = fd->chunkSize;
+  if (chunkSize <= 0) {
+    /* Keep the states, fluxes, and geometry of a chunk within 256KB */
+    const size_t faceBytes = (2*Nc + 2*totDim)*sizeof(PetscScalar) + sizeof(PetscFVFaceGeom) + 2*(dim+1)*sizeof(PetscReal);
+
+    chunkSize = PetscMax(64, (PetscInt) (262144/faceBytes));
+  }
+  chunkSize = PetscMax(PetscMin(chunkSize, fd->Nface), 1);
+  ierr = DMGetWorkArray(dm, chunkSize*Nc, MPIU_SCALAR, &uL);CHKERRQ(ierr);
+  ierr = DMGetWorkArray(dm, chunkSize*Nc, MPIU_SCALAR, &uR);CHKERRQ(ierr);
+  ierr = DMGetWorkArray(dm, chunkSize*totDim, MPIU_SCALAR, &fluxL);CHKERRQ(ierr);
+  ierr = DMGetWorkArray(dm, chunkSize*totDim, MPIU_SCALAR, &fluxR);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(locX, &x);CHKERRQ(ierr);
+  ierr = VecGetArray(locF, &fa);CHKERRQ(ierr);
+  if (locGrad) {
+    ierr = VecGetDM(locGrad, &dmGrad);CHKERRQ(ierr);
+    ierr = VecGetArrayRead(locGrad, &lgrad);CHKERRQ(ierr);
+  }
+  for (fS = 0; fS < fd->Nface; fS += chunkSize) {
+    const PetscInt Ne = PetscMin(chunkSize, fd->Nface - fS);
+    PetscInt       i;
+
+    /* Gather the left and right states, reconstructed at the face centroid */
+    for (f = 0; f < Nf; ++f) {
+      PetscFV  fv;
+      PetscInt off, numComp, c;
+
+      ierr = PetscDSGetDiscretization(ds, f, (PetscObject *) &fv);CHKERRQ(ierr);
+      ierr = PetscDSGetComponentOffset(ds, f, &off);CHKERRQ(ierr);
+      ierr = PetscFVGetNumComponents(fv, &numComp);CHKERRQ(ierr);
+      for (i = 0; i < Ne; ++i) {
+        const PetscInt face = fS+i;
+        PetscInt       xoL, xoR, end;
+
+        ierr = DMGetLocalFieldOffset_Private(dm, fd->cellL[face], f, &xoL, &end);CHKERRQ(ierr);
+        ierr = DMGetLocalFieldOffset_Private(dm, fd->cellR[face], f, &xoR, &end);CHKERRQ(ierr);
+        if (dmGrad) {
+          PetscInt goL, goR;
+
+          ierr = DMGetLocalOffset_Private(dmGrad, fd->cellL[face], &goL, &end);CHKERRQ(ierr);
+          ierr = DMGetLocalOffset_Private(dmGrad, fd->cellR[face], &goR, &end);CHKERRQ(ierr);
+          for (c = 0; c < numComp; ++c) {
+            uL[i*Nc+off+c] = x[xoL+c] + DMPlex_DotD_Internal(dim, &lgrad[goL+c*dim], &fd->dx[(face*2+0)*dim]);
+            uR[i*Nc+off+c] = x[xoR+c] + DMPlex_DotD_Internal(dim, &lgrad[goR+c*dim], &fd->dx[(face*2+1)*dim]);
+          }
+        } else {
+          for (c = 0; c < numComp; ++c) {
+            uL[i*Nc+off+c] = x[xoL+c];
+            uR[i*Nc+off+c] = x[xoR+c];
+          }
+        }
+      }
+    }
+    /* Riemann solve over the chunk */
+    for (f = 0; f < Nf; ++f) {
+      PetscFV   fv;
+      PetscBool fimp;
+
+      ierr = PetscDSGetImplicit(ds, f, &fimp);CHKERRQ(ierr);
+      if (isImplicit != fimp) continue;
+      ierr = PetscDSGetDiscretization(ds, f, (PetscObject *) &fv);CHKERRQ(ierr);
+      ierr = PetscFVIntegrateRHSFunction(fv, ds, f, Ne, &fd->fgeom[fS], &fd->vol[fS*2], uL, uR, fluxL, fluxR);CHKERRQ(ierr);
+    }
+    /* Accumulate fluxes to cells */
+    for (f = 0; f < Nf; ++f) {
+      PetscFV   fv;
+      PetscBool fimp;
+      PetscInt  foff, pdim, d;
+
+      ierr = PetscDSGetImplicit(ds, f, &fimp);CHKERRQ(ierr);
+      if (isImplicit != fimp) continue;
+      ierr = PetscDSGetDiscretization(ds, f, (PetscObject *) &fv);CHKERRQ(ierr);
+      ierr = PetscDSGetFieldOffset(ds, f, &foff);CHKERRQ(ierr);
+      ierr = PetscFVGetNumComponents(fv, &pdim);CHKERRQ(ierr);
+      for (i = 0; i < Ne; ++i) {
+        const PetscInt face = fS+i;
+        PetscInt       o, end;
+
+        if (fd->updL[face]) {
+          ierr = DMGetLocalFieldOffset_Private(dm, fd->cellL[face], f, &o, &end);CHKERRQ(ierr);
+          for (d = 0; d < pdim; ++d) fa[o+d] -= fluxL[i*totDim+foff+d];
+        }
+        if (fd->updR[face]) {
+          ierr = DMGetLocalFieldOffset_Private(dm, fd->cellR[face], f, &o, &end);CHKERRQ(ierr);
+          for (d = 0; d < pdim; ++d) fa[o+d] += fluxR[i*totDim+foff+d];
+        }
+      }
+    }
+  }
+  if (locGrad) {ierr = VecRestoreArrayRead(locGrad, &lgrad);CHKERRQ(ierr);}
+  ierr = VecRestoreArray(locF, &fa);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(locX, &x);CHKERRQ(ierr);
+  ierr = DMRestoreWorkArray(dm, chunkSize*totDim, MPIU_SCALAR, &fluxR);CHKERRQ(ierr);
+  ierr = DMRestoreWorkArray(dm, chunkSize*totDim, MPIU_SCALAR, &fluxL);CHKERRQ(ierr);
+  ierr = DMRestoreWorkArray(dm, chunkSize*Nc, MPIU_SCALAR, &uR);CHKERRQ(ierr);
+  ierr = DMRestoreWorkArray(dm, chunkSize*Nc, MPIU_SCALAR, &uL);CHKERRQ(ierr);
+  *computed = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
@@ -459,6 +459,159 @@ PetscErrorCode PetscGridHashDestroy(PetscGridHash *box)
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode PetscBVHBuild_Private(PetscBVH bvh, const PetscReal boxes[], PetscReal key[], PetscInt start, PetscInt end, PetscInt node)
+{
+  const PetscInt dim = bvh->dim;
+  PetscReal     *nbox = &bvh->nodeBox[node*2*dim];
+  PetscReal      cmin[3], cmax[3];
+  PetscInt       i, d, axis = 0, mid, child;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (d = 0; d < dim; ++d) {nbox[d] = cmin[d] = PETSC_MAX_REAL; nbox[dim+d] = cmax[d] = PETSC_MIN_REAL;}
+  for (i = start; i < end; ++i) {
+    const PetscReal *b = &boxes[bvh->items[i]*2*dim];
+
+    for (d = 0; d < dim; ++d) {
+      const PetscReal c = 0.5*(b[d] + b[dim+d]);
+
+      nbox[d]     = PetscMin(nbox[d], b[d]);
+      nbox[dim+d] = PetscMax(nbox[dim+d], b[dim+d]);
+      cmin[d]     = PetscMin(cmin[d], c);
+      cmax[d]     = PetscMax(cmax[d], c);
+    }
+  }
+  /* Small sets of boxes, or boxes with coincident centers, become leaves */
+  for (d = 1; d < dim; ++d) if (cmax[d] - cmin[d] > cmax[axis] - cmin[axis]) axis = d;
+  if (end - start <= 8 || cmax[axis] <= cmin[axis]) {
+    bvh->nodeStart[node] = start;
+    bvh->nodeSize[node]  = end - start;
+    PetscFunctionReturn(0);
+  }
+  /* Split at the median center along the longest axis */
+  for (i = start; i < end; ++i) {
+    const PetscReal *b = &boxes[bvh->items[i]*2*dim];
+
+    key[i] = 0.5*(b[axis] + b[dim+axis]);
+  }
+  ierr = PetscSortRealWithArrayInt(end - start, &key[start], &bvh->items[start]);CHKERRQ(ierr);
+  mid   = start + (end - start)/2;
+  child = bvh->numNodes;
+  bvh->numNodes += 2;
+  bvh->nodeStart[node] = child;
+  bvh->nodeSize[node]  = 0;
+  ierr = PetscBVHBuild_Private(bvh, boxes, key, start, mid, child);CHKERRQ(ierr);
+  ierr = PetscBVHBuild_Private(bvh, boxes, key, mid, end, child+1);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+  PetscBVHCreate_Internal - Create a bounding volume hierarchy over a set of axis-aligned boxes
+
+  Not collective
+
+  Input Parameters:
++ dim   - The spatial dimension
+. n     - The number of boxes
+- boxes - The lower corner followed by the upper corner of each box
+
+  Output Parameter:
+. bvh - The hierarchy
+
+  Level: developer
+
+.seealso: PetscBVHGetCandidates_Internal(), PetscBVHDestroy_Internal()
+*/
+PetscErrorCode PetscBVHCreate_Internal(PetscInt dim, PetscInt n, const PetscReal boxes[], PetscBVH *bvh)
+{
+  PetscBVH       b;
+  PetscReal     *key;
+  PetscInt       i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (dim < 1 || dim > 3) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Invalid dimension %D for bounding volume hierarchy", dim);
+  ierr = PetscNew(&b);CHKERRQ(ierr);
+  b->dim      = dim;
+  b->numItems = n;
+  ierr = PetscMalloc4(PetscMax(2*n-1, 1)*2*dim, &b->nodeBox, PetscMax(2*n-1, 1), &b->nodeStart, PetscMax(2*n-1, 1), &b->nodeSize, n, &b->items);CHKERRQ(ierr);
+  for (i = 0; i < n; ++i) b->items[i] = i;
+  if (n) {
+    ierr = PetscMalloc1(n, &key);CHKERRQ(ierr);
+    b->numNodes = 1;
+    ierr = PetscBVHBuild_Private(b, boxes, key, 0, n, 0);CHKERRQ(ierr);
+    ierr = PetscFree(key);CHKERRQ(ierr);
+  }
+  *bvh = b;
+  PetscFunctionReturn(0);
+}
+
+/*
+  PetscBVHGetCandidates_Internal - Find the boxes which contain a given point
+
+  Not collective
+
+  Input Parameters:
++ bvh   - The hierarchy
+. point - The point
+. maxn  - The allocated size of items
+- items - A work array, which may be NULL, reallocated as needed
+
+  Output Parameters:
++ n     - The number of boxes containing the point
+. maxn  - The new allocated size of items
+- items - The boxes containing the point
+
+  Level: developer
+
+.seealso: PetscBVHCreate_Internal()
+*/
+PetscErrorCode PetscBVHGetCandidates_Internal(PetscBVH bvh, const PetscReal point[], PetscInt *n, PetscInt *maxn, PetscInt **items)
+{
+  const PetscInt dim = bvh->dim;
+  PetscInt       stack[128];
+  PetscInt       top = 0, d;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  *n = 0;
+  if (!bvh->numNodes) PetscFunctionReturn(0);
+  stack[top++] = 0;
+  while (top) {
+    const PetscInt   node = stack[--top];
+    const PetscReal *nbox = &bvh->nodeBox[node*2*dim];
+
+    for (d = 0; d < dim; ++d) if (point[d] < nbox[d] || point[d] > nbox[dim+d]) break;
+    if (d < dim) continue;
+    if (bvh->nodeSize[node]) {
+      const PetscInt start = bvh->nodeStart[node], size = bvh->nodeSize[node];
+
+      if (*n + size > *maxn) {
+        *maxn = PetscMax(2*(*maxn), *n + size);
+        ierr  = PetscRealloc(*maxn*sizeof(PetscInt), items);CHKERRQ(ierr);
+      }
+      ierr = PetscArraycpy(&(*items)[*n], &bvh->items[start], size);CHKERRQ(ierr);
+      *n  += size;
+    } else {
+      if (top+2 > 128) SETERRQ(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Bounding volume hierarchy is too deep");
+      stack[top++] = bvh->nodeStart[node];
+      stack[top++] = bvh->nodeStart[node]+1;
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PetscBVHDestroy_Internal(PetscBVH *bvh)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!*bvh) PetscFunctionReturn(0);
+  ierr = PetscFree4((*bvh)->nodeBox, (*bvh)->nodeStart, (*bvh)->nodeSize, (*bvh)->items);CHKERRQ(ierr);
+  ierr = PetscFree(*bvh);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode DMPlexLocatePoint_Internal(DM dm, PetscInt dim, const PetscScalar point[], PetscInt cellStart, PetscInt *cell)
 {
   DMPolytopeType ct;
@@ -643,16 +796,208 @@ PetscErrorCode DMPlexComputeGridHash_Internal(DM dm, PetscGridHash *localBox)
   PetscFunctionReturn(0);
 }
 
+/* Return the hierarchy of cell bounding boxes, rebuilding it when the coordinates change */
+static PetscErrorCode DMPlexGetCellBVH_Private(DM dm, PetscBVH *bvh)
+{
+  DM_Plex          *mesh = (DM_Plex *) dm->data;
+  PetscSection      coordSection;
+  Vec               coordsLocal;
+  PetscObjectId     id;
+  PetscObjectState  state;
+  PetscReal        *boxes;
+  PetscInt          dim, cStart, cEnd, c, d, i;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = DMGetCoordinatesLocal(dm, &coordsLocal);CHKERRQ(ierr);
+  ierr = PetscObjectGetId((PetscObject) coordsLocal, &id);CHKERRQ(ierr);
+  ierr = PetscObjectStateGet((PetscObject) coordsLocal, &state);CHKERRQ(ierr);
+  if (mesh->bvh && mesh->bvh->coordId == id && mesh->bvh->coordState == state) {*bvh = mesh->bvh; PetscFunctionReturn(0);}
+  ierr = PetscBVHDestroy_Internal(&mesh->bvh);CHKERRQ(ierr);
+  ierr = PetscInfo(dm, "Building bounding volume hierarchy of cells\n");CHKERRQ(ierr);
+  ierr = DMGetCoordinateDim(dm, &dim);CHKERRQ(ierr);
+  ierr = DMGetCoordinateSection(dm, &coordSection);CHKERRQ(ierr);
+  ierr = DMPlexGetSimplexOrBoxCells(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  ierr = PetscMalloc1((cEnd - cStart)*2*dim, &boxes);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {
+    PetscReal   *box     = &boxes[(c - cStart)*2*dim];
+    PetscScalar *ccoords = NULL;
+    PetscReal    tol     = 0.0;
+    PetscInt     csize   = 0;
+
+    for (d = 0; d < dim; ++d) {box[d] = PETSC_MAX_REAL; box[dim+d] = PETSC_MIN_REAL;}
+    ierr = DMPlexVecGetClosure(dm, coordSection, coordsLocal, c, &csize, &ccoords);CHKERRQ(ierr);
+    for (i = 0; i < csize; i += dim) {
+      for (d = 0; d < dim; ++d) {
+        box[d]     = PetscMin(box[d],     PetscRealPart(ccoords[i+d]));
+        box[dim+d] = PetscMax(box[dim+d], PetscRealPart(ccoords[i+d]));
+      }
+    }
+    ierr = DMPlexVecRestoreClosure(dm, coordSection, coordsLocal, c, &csize, &ccoords);CHKERRQ(ierr);
+    /* Enlarge the box to cover the tolerance used by DMPlexLocatePoint_Internal() */
+    for (d = 0; d < dim; ++d) tol = PetscMax(tol, box[dim+d] - box[d]);
+    tol *= 2.0*PETSC_SQRT_MACHINE_EPSILON;
+    for (d = 0; d < dim; ++d) {box[d] -= tol; box[dim+d] += tol;}
+  }
+  ierr = PetscBVHCreate_Internal(dim, cEnd - cStart, boxes, &mesh->bvh);CHKERRQ(ierr);
+  ierr = PetscFree(boxes);CHKERRQ(ierr);
+  mesh->bvh->coordId    = id;
+  mesh->bvh->coordState = state;
+  *bvh = mesh->bvh;
+  PetscFunctionReturn(0);
+}
+
+/* Locate a point in the lowest numbered cell containing it, which matches a search over all cells */
+static PetscErrorCode DMPlexLocatePointBVH_Private(DM dm, PetscBVH bvh, PetscInt cStart, const PetscScalar point[], PetscInt *maxn, PetscInt **cand, PetscInt *cell)
+{
+  PetscReal      pt[3];
+  PetscInt       dim = bvh->dim, n, c, d;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  *cell = DMLOCATEPOINT_POINT_NOT_FOUND;
+  for (d = 0; d < dim; ++d) pt[d] = PetscRealPart(point[d]);
+  ierr = PetscBVHGetCandidates_Internal(bvh, pt, &n, maxn, cand);CHKERRQ(ierr);
+  ierr = PetscSortInt(n, *cand);CHKERRQ(ierr);
+  for (c = 0; c < n; ++c) {
+    ierr = DMPlexLocatePoint_Internal(dm, dim, point, (*cand)[c] + cStart, cell);CHKERRQ(ierr);
+    if (*cell >= 0) break;
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Map located cells to their owners */
+static PetscErrorCode DMPlexLocatePointsSetOwners_Private(DM dm, PetscInt cStart, PetscInt cEnd, PetscInt n, PetscSFNode cells[])
+{
+  PetscSF            sf;
+  const PetscInt    *leaves;
+  const PetscSFNode *remotes;
+  PetscSFNode       *owners;
+  PetscMPIInt        rank;
+  PetscInt           nleaves, l, c, p;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_rank(PetscObjectComm((PetscObject) dm), &rank);CHKERRMPI(ierr);
+  ierr = DMGetPointSF(dm, &sf);CHKERRQ(ierr);
+  ierr = PetscSFGetGraph(sf, NULL, &nleaves, &leaves, &remotes);CHKERRQ(ierr);
+  ierr = PetscMalloc1(cEnd - cStart, &owners);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {owners[c-cStart].rank = rank; owners[c-cStart].index = c;}
+  for (l = 0; l < (nleaves < 0 ? 0 : nleaves); ++l) {
+    const PetscInt leaf = leaves ? leaves[l] : l;
+
+    if (leaf >= cStart && leaf < cEnd) owners[leaf-cStart] = remotes[l];
+  }
+  for (p = 0; p < n; ++p) if (cells[p].index >= 0) cells[p] = owners[cells[p].index - cStart];
+  ierr = PetscFree(owners);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+  Route points that were not found locally to the processes whose bounding box contains them. The bounding boxes of all processes
+  form a coarse global index. When several of these processes contain a point, the cell of the lowest rank is kept.
+*/
+static PetscErrorCode DMPlexLocatePointsRemote_Private(DM dm, PetscBVH bvh, PetscInt cStart, PetscInt cEnd, PetscInt numPoints, const PetscScalar a[], PetscSFNode cells[])
+{
+  MPI_Comm          comm;
+  PetscBVH          rankBVH;
+  PetscSF           sfCount, sfReq;
+  MPI_Datatype      pointType;
+  PetscSFNode      *remote = NULL, *reqCells, *rootCells;
+  PetscScalar      *reqCoords, *rootCoords;
+  PetscReal         lbox[6], *gboxes;
+  PetscInt         *reqPoint = NULL, *one, *slot, *cand = NULL, *rcand = NULL;
+  PetscInt          dim = bvh->dim, maxc = 0, maxr = 0, nreq = 0, nroot = 0, p, r, i, d;
+  PetscMPIInt       size, rank;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject) dm, &comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm, &size);CHKERRMPI(ierr);
+  ierr = MPI_Comm_rank(comm, &rank);CHKERRMPI(ierr);
+  /* Gather the local bounding boxes */
+  for (d = 0; d < dim; ++d) {lbox[d] = PETSC_MAX_REAL; lbox[dim+d] = PETSC_MIN_REAL;}
+  if (bvh->numNodes) {for (d = 0; d < 2*dim; ++d) lbox[d] = bvh->nodeBox[d];}
+  ierr = PetscMalloc1(size*2*dim, &gboxes);CHKERRQ(ierr);
+  ierr = MPI_Allgather(lbox, 2*dim, MPIU_REAL, gboxes, 2*dim, MPIU_REAL, comm);CHKERRMPI(ierr);
+  ierr = PetscBVHCreate_Internal(dim, size, gboxes, &rankBVH);CHKERRQ(ierr);
+  ierr = PetscFree(gboxes);CHKERRQ(ierr);
+  /* Send each unfound point to all other processes which might contain it */
+  for (i = 0; i < 2; ++i) {
+    for (p = 0, nreq = 0; p < numPoints; ++p) {
+      PetscReal pt[3];
+      PetscInt  n;
+
+      if (cells[p].index >= 0) continue;
+      for (d = 0; d < dim; ++d) pt[d] = PetscRealPart(a[p*dim+d]);
+      ierr = PetscBVHGetCandidates_Internal(rankBVH, pt, &n, &maxr, &rcand);CHKERRQ(ierr);
+      for (r = 0; r < n; ++r) {
+        if (rcand[r] == rank) continue;
+        if (i) {
+          reqPoint[nreq]     = p;
+          remote[nreq].rank  = rcand[r];
+          remote[nreq].index = 0;
+        }
+        ++nreq;
+      }
+    }
+    if (!i) {ierr = PetscMalloc2(nreq, &reqPoint, nreq, &remote);CHKERRQ(ierr);}
+  }
+  ierr = PetscBVHDestroy_Internal(&rankBVH);CHKERRQ(ierr);
+  ierr = PetscFree(rcand);CHKERRQ(ierr);
+  /* Reserve a slot for each request on the receiving process */
+  ierr = PetscMalloc2(nreq, &one, nreq, &slot);CHKERRQ(ierr);
+  for (i = 0; i < nreq; ++i) one[i] = 1;
+  ierr = PetscSFCreate(comm, &sfCount);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(sfCount, 1, nreq, NULL, PETSC_USE_POINTER, remote, PETSC_USE_POINTER);CHKERRQ(ierr);
+  ierr = PetscSFFetchAndOpBegin(sfCount, MPIU_INT, &nroot, one, slot, MPI_SUM);CHKERRQ(ierr);
+  ierr = PetscSFFetchAndOpEnd(sfCount, MPIU_INT, &nroot, one, slot, MPI_SUM);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sfCount);CHKERRQ(ierr);
+  for (i = 0; i < nreq; ++i) remote[i].index = slot[i];
+  ierr = PetscFree2(one, slot);CHKERRQ(ierr);
+  ierr = PetscSFCreate(comm, &sfReq);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(sfReq, nroot, nreq, NULL, PETSC_USE_POINTER, remote, PETSC_USE_POINTER);CHKERRQ(ierr);
+  /* Send the coordinates and locate the incoming points */
+  ierr = PetscMalloc4(nreq*dim, &reqCoords, nreq, &reqCells, nroot*dim, &rootCoords, nroot, &rootCells);CHKERRQ(ierr);
+  for (i = 0; i < nreq; ++i) for (d = 0; d < dim; ++d) reqCoords[i*dim+d] = a[reqPoint[i]*dim+d];
+  ierr = MPI_Type_contiguous(dim, MPIU_SCALAR, &pointType);CHKERRMPI(ierr);
+  ierr = MPI_Type_commit(&pointType);CHKERRMPI(ierr);
+  ierr = PetscSFReduceBegin(sfReq, pointType, reqCoords, rootCoords, MPI_REPLACE);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(sfReq, pointType, reqCoords, rootCoords, MPI_REPLACE);CHKERRQ(ierr);
+  ierr = MPI_Type_free(&pointType);CHKERRMPI(ierr);
+  for (i = 0; i < nroot; ++i) {
+    ierr = DMPlexLocatePointBVH_Private(dm, bvh, cStart, &rootCoords[i*dim], &maxc, &cand, &rootCells[i].index);CHKERRQ(ierr);
+    rootCells[i].rank = rank;
+  }
+  ierr = PetscFree(cand);CHKERRQ(ierr);
+  ierr = DMPlexLocatePointsSetOwners_Private(dm, cStart, cEnd, nroot, rootCells);CHKERRQ(ierr);
+  for (i = 0; i < nroot; ++i) if (rootCells[i].index < 0) rootCells[i].rank = -1;
+  /* Return the cells, keeping the lowest rank when several remote processes found a point */
+  ierr = PetscSFBcastBegin(sfReq, MPIU_2INT, rootCells, reqCells, MPI_REPLACE);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(sfReq, MPIU_2INT, rootCells, reqCells, MPI_REPLACE);CHKERRQ(ierr);
+  for (i = 0; i < nreq; ++i) {
+    const PetscInt q = reqPoint[i];
+
+    if (reqCells[i].index < 0) continue;
+    if (cells[q].index < 0 || reqCells[i].rank < cells[q].rank) cells[q] = reqCells[i];
+  }
+  ierr = PetscSFDestroy(&sfReq);CHKERRQ(ierr);
+  ierr = PetscFree4(reqCoords, reqCells, rootCoords, rootCells);CHKERRQ(ierr);
+  ierr = PetscFree2(reqPoint, remote);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode DMLocatePoints_Plex(DM dm, Vec v, DMPointLocationType ltype, PetscSF cellSF)
 {
   DM_Plex        *mesh = (DM_Plex *) dm->data;
-  PetscBool       hash = mesh->useHashLocation, reuse = PETSC_FALSE;
-  PetscInt        bs, numPoints, p, numFound, *found = NULL;
+  PetscBool       hash = mesh->useHashLocation, reuse = PETSC_FALSE, parallel = PETSC_FALSE;
+  PetscBVH        bvh = NULL;
+  PetscInt        bs, numPoints, p, numFound, *found = NULL, *cand = NULL, maxCand = 0;
   PetscInt        dim, cStart, cEnd, numCells, c, d;
   const PetscInt *boxCells;
   PetscSFNode    *cells;
   PetscScalar    *a;
-  PetscMPIInt     result;
+  PetscMPIInt     result, size, rank = 0;
   PetscLogDouble  t0,t1;
   PetscReal       gmin[3],gmax[3];
   PetscInt        terminating_query_type[] = { 0, 0, 0 };
@@ -665,7 +1010,14 @@ PetscErrorCode DMLocatePoints_Plex(DM dm, Vec v, DMPointLocationType ltype, Pets
   ierr = DMGetCoordinateDim(dm, &dim);CHKERRQ(ierr);
   ierr = VecGetBlockSize(v, &bs);CHKERRQ(ierr);
   ierr = MPI_Comm_compare(PetscObjectComm((PetscObject)cellSF),PETSC_COMM_SELF,&result);CHKERRMPI(ierr);
-  if (result != MPI_IDENT && result != MPI_CONGRUENT) SETERRQ(PetscObjectComm((PetscObject)cellSF),PETSC_ERR_SUP, "Trying parallel point location: only local point location supported");
+  if (result != MPI_IDENT && result != MPI_CONGRUENT) {
+    ierr = MPI_Comm_compare(PetscObjectComm((PetscObject)cellSF),PetscObjectComm((PetscObject)dm),&result);CHKERRMPI(ierr);
+    if (result != MPI_IDENT && result != MPI_CONGRUENT) SETERRQ(PetscObjectComm((PetscObject)cellSF),PETSC_ERR_SUP, "Parallel point location requires the point vector to be on the communicator of the mesh");
+    ierr = MPI_Comm_size(PetscObjectComm((PetscObject)dm),&size);CHKERRMPI(ierr);
+    parallel = size > 1 ? PETSC_TRUE : PETSC_FALSE;
+    ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)dm),&rank);CHKERRMPI(ierr);
+  }
+  if (parallel && (hash || ltype == DM_POINTLOCATION_NEAREST)) SETERRQ(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "Parallel point location does not support grid hashing or nearest point location");
   if (bs != dim) SETERRQ2(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_WRONG, "Block size for point vector %D must be the mesh coordinate dimension %D", bs, dim);
   ierr = DMPlexGetSimplexOrBoxCells(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
   ierr = VecGetLocalSize(v, &numPoints);CHKERRQ(ierr);
@@ -689,13 +1041,13 @@ PetscErrorCode DMLocatePoints_Plex(DM dm, Vec v, DMPointLocationType ltype, Pets
       }
     }
   }
-  /* define domain bounding box */
+  /* define local domain bounding box, points outside it may still be found on other processes */
   {
-    Vec coorglobal;
+    Vec coorlocal;
 
-    ierr = DMGetCoordinates(dm,&coorglobal);CHKERRQ(ierr);
-    ierr = VecStrideMaxAll(coorglobal,NULL,gmax);CHKERRQ(ierr);
-    ierr = VecStrideMinAll(coorglobal,NULL,gmin);CHKERRQ(ierr);
+    ierr = DMGetCoordinatesLocal(dm,&coorlocal);CHKERRQ(ierr);
+    ierr = VecStrideMaxAll(coorlocal,NULL,gmax);CHKERRQ(ierr);
+    ierr = VecStrideMinAll(coorlocal,NULL,gmin);CHKERRQ(ierr);
   }
   if (hash) {
     if (!mesh->lbox) {ierr = PetscInfo(dm, "Initializing grid hashing");CHKERRQ(ierr);ierr = DMPlexComputeGridHash_Internal(dm, &mesh->lbox);CHKERRQ(ierr);}
@@ -704,6 +1056,8 @@ PetscErrorCode DMLocatePoints_Plex(DM dm, Vec v, DMPointLocationType ltype, Pets
     /* Search cells that lie in each subbox */
     /*   Should we bin points before doing search? */
     ierr = ISGetIndices(mesh->lbox->cells, &boxCells);CHKERRQ(ierr);
+  } else {
+    ierr = DMPlexGetCellBVH_Private(dm, &bvh);CHKERRQ(ierr);
   }
   for (p = 0, numFound = 0; p < numPoints; ++p) {
     const PetscScalar *point = &a[p*bs];
@@ -723,6 +1077,7 @@ PetscErrorCode DMLocatePoints_Plex(DM dm, Vec v, DMPointLocationType ltype, Pets
     }
 
     /* check initial values in cells[].index - abort early if found */
+    if (parallel && cells[p].rank != rank) cells[p].index = DMLOCATEPOINT_POINT_NOT_FOUND;
     if (cells[p].index != DMLOCATEPOINT_POINT_NOT_FOUND) {
       c = cells[p].index;
       cells[p].index = DMLOCATEPOINT_POINT_NOT_FOUND;
@@ -759,19 +1114,25 @@ PetscErrorCode DMLocatePoints_Plex(DM dm, Vec v, DMPointLocationType ltype, Pets
         }
       }
     } else {
-      for (c = cStart; c < cEnd; ++c) {
-        ierr = DMPlexLocatePoint_Internal(dm, dim, point, c, &cell);CHKERRQ(ierr);
-        if (cell >= 0) {
-          cells[p].rank = 0;
-          cells[p].index = cell;
-          numFound++;
-          terminating_query_type[2]++;
-          break;
-        }
+      ierr = DMPlexLocatePointBVH_Private(dm, bvh, cStart, point, &maxCand, &cand, &cell);CHKERRQ(ierr);
+      if (cell >= 0) {
+        cells[p].rank = 0;
+        cells[p].index = cell;
+        numFound++;
+        terminating_query_type[2]++;
       }
     }
   }
   if (hash) {ierr = ISRestoreIndices(mesh->lbox->cells, &boxCells);CHKERRQ(ierr);}
+  ierr = PetscFree(cand);CHKERRQ(ierr);
+  if (parallel) {
+    ierr = DMPlexLocatePointsSetOwners_Private(dm, cStart, cEnd, numPoints, cells);CHKERRQ(ierr);
+    ierr = DMPlexLocatePointsRemote_Private(dm, bvh, cStart, cEnd, numPoints, a, cells);CHKERRQ(ierr);
+    for (p = 0, numFound = 0; p < numPoints; ++p) {
+      if (cells[p].index >= 0) ++numFound;
+      else cells[p].rank = 0;
+    }
+  }
   if (ltype == DM_POINTLOCATION_NEAREST && hash && numFound < numPoints) {
     for (p = 0; p < numPoints; p++) {
       const PetscScalar *point = &a[p*bs];
@@ -819,7 +1180,7 @@ PetscErrorCode DMLocatePoints_Plex(DM dm, Vec v, DMPointLocationType ltype, Pets
   if (hash) {
     ierr = PetscInfo3(dm,"[DMLocatePoints_Plex] terminating_query_type : %D [outside domain] : %D [inside initial cell] : %D [hash]\n",terminating_query_type[0],terminating_query_type[1],terminating_query_type[2]);CHKERRQ(ierr);
   } else {
-    ierr = PetscInfo3(dm,"[DMLocatePoints_Plex] terminating_query_type : %D [outside domain] : %D [inside initial cell] : %D [brute-force]\n",terminating_query_type[0],terminating_query_type[1],terminating_query_type[2]);CHKERRQ(ierr);
+    ierr = PetscInfo3(dm,"[DMLocatePoints_Plex] terminating_query_type : %D [outside domain] : %D [inside initial cell] : %D [bvh]\n",terminating_query_type[0],terminating_query_type[1],terminating_query_type[2]);CHKERRQ(ierr);
   }
   ierr = PetscInfo3(dm,"[DMLocatePoints_Plex] npoints %D : time(rank0) %1.2e (sec): points/sec %1.4e\n",numPoints,t1-t0,(double)((double)numPoints/(t1-t0)));CHKERRQ(ierr);
   ierr = PetscLogEventEnd(DMPLEX_LocatePoints,0,0,0,0);CHKERRQ(ierr);
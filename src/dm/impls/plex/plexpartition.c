@@ -606,6 +606,59 @@ PetscErrorCode DMPlexCreateNeighborCSR(DM dm, PetscInt cellHeight, PetscInt *num
   PetscFunctionReturn(0);
 }
 
+/*
+  DMPlexComputeCellCentroids_Internal - Average the closure coordinates of each cell in [cStart, cEnd)
+
+  Input Parameters:
++ dm              - The DMPlex
+. cStart, cEnd    - The range of cells
+- globalNumbering - [Optional] If given, cells with negative numbers (not owned) are skipped
+
+  Output Parameters:
++ cdim      - The coordinate dimension
+. n         - The number of centroids computed
+- centroids - The centroid coordinates, n*cdim, which the caller must free
+*/
+PetscErrorCode DMPlexComputeCellCentroids_Internal(DM dm, PetscInt cStart, PetscInt cEnd, IS globalNumbering, PetscInt *cdim, PetscInt *n, PetscReal *centroids[])
+{
+  DM              cdm;
+  PetscSection    csection;
+  Vec             coordinates;
+  const PetscInt *gid = NULL;
+  PetscReal      *centroid;
+  PetscInt        dim, c, v = 0;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = DMGetCoordinateDim(dm, &dim);CHKERRQ(ierr);
+  ierr = DMGetCoordinateDM(dm, &cdm);CHKERRQ(ierr);
+  ierr = DMGetLocalSection(cdm, &csection);CHKERRQ(ierr);
+  ierr = DMGetCoordinatesLocal(dm, &coordinates);CHKERRQ(ierr);
+  if (globalNumbering) {ierr = ISGetIndices(globalNumbering, &gid);CHKERRQ(ierr);}
+  ierr = PetscMalloc1((cEnd-cStart)*dim, &centroid);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {
+    PetscScalar *coords = NULL;
+    PetscInt     csize, nv, i, d;
+
+    if (gid && gid[c-cStart] < 0) continue;
+    ierr = DMPlexVecGetClosure(cdm, csection, coordinates, c, &csize, &coords);CHKERRQ(ierr);
+    nv   = csize/dim;
+    for (d = 0; d < dim; ++d) {
+      PetscReal x = 0.0;
+
+      for (i = 0; i < nv; ++i) x += PetscRealPart(coords[i*dim+d]);
+      centroid[v*dim+d] = nv ? x/nv : 0.0;
+    }
+    ierr = DMPlexVecRestoreClosure(cdm, csection, coordinates, c, &csize, &coords);CHKERRQ(ierr);
+    ++v;
+  }
+  if (globalNumbering) {ierr = ISRestoreIndices(globalNumbering, &gid);CHKERRQ(ierr);}
+  *cdim      = dim;
+  *n         = v;
+  *centroids = centroid;
+  PetscFunctionReturn(0);
+}
+
 /*@
   PetscPartitionerDMPlexPartition - Create a non-overlapping partition of the cells in the mesh
 
@@ -623,6 +676,7 @@ PetscErrorCode DMPlexCreateNeighborCSR(DM dm, PetscInt cellHeight, PetscInt *num
   Notes:
     If the DM has a local section associated, each point to be partitioned will be weighted by the total number of dofs identified
     by the section in the transitive closure of the point.
+    If the partitioner is PETSCPARTITIONERSFC, the cell centroids are used as the coordinates of the points to be partitioned.
 
   Level: developer
 
@@ -631,7 +685,7 @@ PetscErrorCode DMPlexCreateNeighborCSR(DM dm, PetscInt cellHeight, PetscInt *num
 PetscErrorCode PetscPartitionerDMPlexPartition(PetscPartitioner part, DM dm, PetscSection targetSection, PetscSection partSection, IS *partition)
 {
   PetscMPIInt    size;
-  PetscBool      isplex;
+  PetscBool      isplex, issfc;
   PetscErrorCode ierr;
   PetscSection   vertSection = NULL;
 
@@ -658,6 +712,7 @@ PetscErrorCode PetscPartitionerDMPlexPartition(PetscPartitioner part, DM dm, Pet
     ierr = ISCreateGeneral(PetscObjectComm((PetscObject) part), cEnd-cStart, points, PETSC_OWN_POINTER, partition);CHKERRQ(ierr);
     PetscFunctionReturn(0);
   }
+  ierr = PetscObjectTypeCompare((PetscObject) part, PETSCPARTITIONERSFC, &issfc);CHKERRQ(ierr);
   if (part->height == 0) {
     PetscInt numVertices = 0;
     PetscInt *start     = NULL;
@@ -729,6 +784,16 @@ PetscErrorCode PetscPartitionerDMPlexPartition(PetscPartitioner part, DM dm, Pet
       }
       ierr = PetscSectionSetUp(vertSection);CHKERRQ(ierr);
     }
+    if (issfc) { /* the space-filling curve partitioner orders the cell centroids */
+      PetscReal *centroids;
+      PetscInt   cdim, n, cStart, cEnd;
+
+      ierr = DMPlexGetHeightStratum(dm, part->height, &cStart, &cEnd);CHKERRQ(ierr);
+      ierr = DMPlexComputeCellCentroids_Internal(dm, cStart, cEnd, globalNumbering, &cdim, &n, &centroids);CHKERRQ(ierr);
+      if (n != numVertices) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Number of centroids %D != %D number of graph vertices", n, numVertices);
+      ierr = PetscPartitionerSFCSetCoordinates(part, cdim, n, centroids);CHKERRQ(ierr);
+      ierr = PetscFree(centroids);CHKERRQ(ierr);
+    }
     ierr = PetscPartitionerPartition(part, size, numVertices, start, adjacency, vertSection, targetSection, partSection, partition);CHKERRQ(ierr);
     ierr = PetscFree(start);CHKERRQ(ierr);
     ierr = PetscFree(adjacency);CHKERRQ(ierr);
@@ -846,6 +846,7 @@ static PetscErrorCode DMPlexTreeExchangeSupports(DM dm)
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  ierr = DMPlexSetUpSupports_Internal(dm);CHKERRQ(ierr);
   /* symmetrize the hierarchy */
   ierr = DMPlexGetDepth(dm,&depth);CHKERRQ(ierr);
   ierr = PetscSectionCreate(PetscObjectComm((PetscObject)(mesh->supportSection)),&newSupportSection);CHKERRQ(ierr);
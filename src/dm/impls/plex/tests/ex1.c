@@ -340,6 +340,14 @@ int main(int argc, char **argv)
     requires: triangle
     nsize: {{2 8}separate output}
     args: -dm_coord_space 0 -ref_dm_refine 1 -dist_dm_distribute -petscpartitioner_type simple -overlap {{0 1 2}separate output} -dm_view ascii::ascii_info
+  test:
+    suffix: overlap_local_copy_2d
+    nsize: {{2 4}separate output}
+    args: -dm_plex_simplex 0 -dm_plex_box_faces 4,4 -dist_dm_distribute -petscpartitioner_type simple -overlap {{1 2}separate output} -dm_plex_overlap_local_copy {{0 1}} -final_diagnostics -dm_view ascii::ascii_info
+  test:
+    suffix: overlap_local_copy_3d
+    nsize: 3
+    args: -dm_plex_dim 3 -dm_plex_simplex 0 -dm_plex_box_faces 3,3,3 -dm_plex_box_bd periodic,none,none -dist_dm_distribute -petscpartitioner_type simple -overlap 1 -dm_plex_overlap_local_copy {{0 1}} -final_diagnostics -dm_view ascii::ascii_info
 
   # Parallel simple partitioner tests
   test:
@@ -353,6 +361,12 @@ int main(int argc, char **argv)
     nsize: 8
     args: -dm_coord_space 0 -ref_dm_refine 1 -dist_dm_distribute -petscpartitioner_type simple -dist_partition_view -dm_view ascii::ascii_info_detail
 
+  # Parallel space-filling curve partitioner tests
+  test:
+    suffix: part_sfc_0
+    nsize: 3
+    args: -dm_plex_simplex 0 -dm_plex_box_faces 5,5 -dist_dm_distribute -petscpartitioner_type sfc -petscpartitioner_sfc_curve {{hilbert morton}separate output} -dm_view ascii::ascii_info
+
   # Parallel partitioner tests
   test:
     suffix: part_parmetis_0
@@ -9,6 +9,7 @@ typedef struct {
   PetscInt *numComponents;     /* The number of field components */
   PetscInt *numDof;            /* The dof signature for the section */
   PetscInt  numGroups;         /* If greater than 1, use grouping in test */
+  PetscBool useSFC;            /* Use a space-filling curve ordering instead of RCM */
 } AppCtx;
 
 PetscErrorCode ProcessOptions(AppCtx *options)
@@ -22,6 +23,7 @@ PetscErrorCode ProcessOptions(AppCtx *options)
   options->numComponents = NULL;
   options->numDof        = NULL;
   options->numGroups     = 0;
+  options->useSFC        = PETSC_FALSE;
 
   ierr = PetscOptionsBegin(PETSC_COMM_SELF, "", "Meshing Problem Options", "DMPLEX");CHKERRQ(ierr);
   ierr = PetscOptionsBoundedInt("-num_fields", "The number of section fields", "ex10.c", options->numFields, &options->numFields, NULL,1);CHKERRQ(ierr);
@@ -32,6 +34,7 @@ PetscErrorCode ProcessOptions(AppCtx *options)
     if (flg && (len != options->numFields)) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Length of components array is %D should be %D", len, options->numFields);
   }
   ierr = PetscOptionsBoundedInt("-num_groups", "Group permutation by this many label values", "ex10.c", options->numGroups, &options->numGroups, NULL,0);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-sfc", "Order cells along a Hilbert curve", "ex10.c", options->useSFC, &options->useSFC, NULL);CHKERRQ(ierr);
   ierr = PetscOptionsEnd();CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -71,7 +74,12 @@ PetscErrorCode TestReordering(DM dm, AppCtx *user)
   PetscErrorCode  ierr;
 
   PetscFunctionBegin;
-  ierr = DMPlexGetOrdering(dm, order, NULL, &perm);CHKERRQ(ierr);
+  if (user->useSFC) {
+    order = "sfc";
+    ierr  = DMPlexGetOrderingSFC(dm, PETSCPARTITIONER_SFC_HILBERT, NULL, &perm);CHKERRQ(ierr);
+  } else {
+    ierr = DMPlexGetOrdering(dm, order, NULL, &perm);CHKERRQ(ierr);
+  }
   ierr = DMPlexPermute(dm, perm, &pdm);CHKERRQ(ierr);
   ierr = PetscObjectSetOptionsPrefix((PetscObject) pdm, "perm_");CHKERRQ(ierr);
   ierr = DMSetFromOptions(pdm);CHKERRQ(ierr);
@@ -222,6 +230,13 @@ int main(int argc, char **argv)
   test:
     suffix: 7
     args: -dm_plex_dim 3 -dm_plex_simplex 0 -dm_refine 1 -num_dof 1,0,0,0
+  # Space-filling curve tests
+  test:
+    suffix: sfc_0
+    args: -dm_plex_simplex 0 -dm_refine 2 -num_dof 1,0,0 -sfc
+  test:
+    suffix: sfc_1
+    args: -dm_plex_dim 3 -dm_plex_simplex 0 -dm_refine 1 -num_dof 1,0,0,0 -sfc
   # Parallel tests
   # Grouping tests
   test:
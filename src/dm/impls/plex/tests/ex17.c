@@ -49,14 +49,88 @@ static PetscErrorCode TestLocation(DM dm)
   PetscFunctionReturn(0);
 }
 
+/* Locate a lattice of points spread over all ranks, and check each point lies in the cell it was routed to */
+static PetscErrorCode TestParallelLocation(DM dm)
+{
+  MPI_Comm           comm;
+  MPI_Datatype       unit;
+  Vec                v, lv;
+  PetscSF            cellSF = NULL, lcellSF = NULL;
+  const PetscSFNode *cells, *lcells;
+  const PetscInt    *leaves, *degree;
+  PetscScalar       *a;
+  PetscReal         *coords, *rootCoords;
+  PetscInt           dim, cStart, cEnd, c, N = 7, Np, n = 0, nleaves, nroots = 0, numFound, i, j, d;
+  PetscMPIInt        rank, size;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBeginUser;
+  ierr = PetscObjectGetComm((PetscObject) dm, &comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm, &rank);CHKERRMPI(ierr);
+  ierr = MPI_Comm_size(comm, &size);CHKERRMPI(ierr);
+  ierr = DMGetDimension(dm, &dim);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  /* Deal the lattice points round-robin, so most points are not in the local partition */
+  for (Np = 1, d = 0; d < dim; ++d) Np *= N;
+  for (i = rank; i < Np; i += size) ++n;
+  ierr = VecCreateMPI(comm, n*dim, PETSC_DETERMINE, &v);CHKERRQ(ierr);
+  ierr = VecSetBlockSize(v, dim);CHKERRQ(ierr);
+  ierr = PetscMalloc1(n*dim, &coords);CHKERRQ(ierr);
+  ierr = VecGetArray(v, &a);CHKERRQ(ierr);
+  for (i = rank, j = 0; i < Np; i += size, ++j) {
+    PetscInt idx = i;
+
+    for (d = 0; d < dim; ++d, idx /= N) coords[j*dim+d] = a[j*dim+d] = (idx % N + 0.5)/N;
+  }
+  ierr = VecRestoreArray(v, &a);CHKERRQ(ierr);
+  ierr = DMLocatePoints(dm, v, DM_POINTLOCATION_NONE, &cellSF);CHKERRQ(ierr);
+  ierr = PetscSFGetGraph(cellSF, NULL, &nleaves, &leaves, &cells);CHKERRQ(ierr);
+  if (leaves) SETERRQ(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Expected contiguous leaves");
+  for (i = 0, numFound = 0; i < nleaves; ++i) if (cells[i].index >= 0) ++numFound;
+  ierr = MPI_Allreduce(MPI_IN_PLACE, &numFound, 1, MPIU_INT, MPI_SUM, comm);CHKERRMPI(ierr);
+  ierr = PetscPrintf(comm, "Located %D/%D points\n", numFound, Np);CHKERRQ(ierr);
+  /* Send each point to the cell owning it, and locate it again locally */
+  ierr = PetscSFComputeDegreeBegin(cellSF, &degree);CHKERRQ(ierr);
+  ierr = PetscSFComputeDegreeEnd(cellSF, &degree);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) nroots += degree[c-cStart];
+  ierr = PetscMalloc1(nroots*dim, &rootCoords);CHKERRQ(ierr);
+  ierr = MPI_Type_contiguous(dim, MPIU_REAL, &unit);CHKERRMPI(ierr);
+  ierr = MPI_Type_commit(&unit);CHKERRMPI(ierr);
+  ierr = PetscSFGatherBegin(cellSF, unit, coords, rootCoords);CHKERRQ(ierr);
+  ierr = PetscSFGatherEnd(cellSF, unit, coords, rootCoords);CHKERRQ(ierr);
+  ierr = MPI_Type_free(&unit);CHKERRMPI(ierr);
+  ierr = VecCreateSeq(PETSC_COMM_SELF, nroots*dim, &lv);CHKERRQ(ierr);
+  ierr = VecSetBlockSize(lv, dim);CHKERRQ(ierr);
+  ierr = VecGetArray(lv, &a);CHKERRQ(ierr);
+  for (i = 0; i < nroots*dim; ++i) a[i] = rootCoords[i];
+  ierr = VecRestoreArray(lv, &a);CHKERRQ(ierr);
+  ierr = DMLocatePoints(dm, lv, DM_POINTLOCATION_NONE, &lcellSF);CHKERRQ(ierr);
+  ierr = PetscSFGetGraph(lcellSF, NULL, NULL, NULL, &lcells);CHKERRQ(ierr);
+  for (c = cStart, j = 0; c < cEnd; ++c) {
+    for (i = 0; i < degree[c-cStart]; ++i, ++j) {
+      if (lcells[j].index != c) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Point %D routed to cell %D lies in cell %D", j, c, lcells[j].index);
+    }
+  }
+  ierr = PetscSFDestroy(&lcellSF);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&cellSF);CHKERRQ(ierr);
+  ierr = VecDestroy(&lv);CHKERRQ(ierr);
+  ierr = VecDestroy(&v);CHKERRQ(ierr);
+  ierr = PetscFree(rootCoords);CHKERRQ(ierr);
+  ierr = PetscFree(coords);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 int main(int argc, char **argv)
 {
   DM             dm;
+  PetscBool      parallel = PETSC_FALSE;
   PetscErrorCode ierr;
 
   ierr = PetscInitialize(&argc, &argv, NULL, help);if (ierr) return ierr;
+  ierr = PetscOptionsGetBool(NULL, NULL, "-parallel", &parallel, NULL);CHKERRQ(ierr);
   ierr = CreateMesh(PETSC_COMM_WORLD, &dm);CHKERRQ(ierr);
   ierr = TestLocation(dm);CHKERRQ(ierr);
+  if (parallel) {ierr = TestParallelLocation(dm);CHKERRQ(ierr);}
   ierr = DMDestroy(&dm);CHKERRQ(ierr);
   ierr = PetscFinalize();
   return ierr;
@@ -86,4 +160,14 @@ int main(int argc, char **argv)
     suffix: hex
     args: -dm_plex_dim 3 -dm_plex_simplex 0 -dm_plex_box_faces 3,3,3
 
+  test:
+    suffix: quad_parallel
+    nsize: 3
+    args: -dm_plex_simplex 0 -dm_plex_box_faces 5,5 -dm_distribute -petscpartitioner_type simple -parallel
+
+  test:
+    suffix: hex_parallel
+    nsize: 3
+    args: -dm_plex_dim 3 -dm_plex_simplex 0 -dm_plex_box_faces 3,3,3 -dm_distribute -petscpartitioner_type simple -parallel
+
 TEST*/
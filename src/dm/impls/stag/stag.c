@@ -21,6 +21,50 @@ static PetscErrorCode DMClone_Stag(DM dm,DM *newdm)
   PetscFunctionReturn(0);
 }
 
+/* Refinement and coarsening are by a factor of 2 in each direction, keeping the
+   rank grid, so that each rank's coarse elements are the parents of its fine ones */
+static PetscErrorCode DMRefine_Stag(DM dm,MPI_Comm comm,DM *dmf)
+{
+  PetscErrorCode  ierr;
+  DM_Stag         *stagf;
+  PetscInt        d,r,dim;
+
+  PetscFunctionBegin;
+  ierr = DMGetDimension(dm,&dim);CHKERRQ(ierr);
+  ierr = DMStagDuplicateWithoutSetup(dm,comm,dmf);CHKERRQ(ierr);
+  stagf = (DM_Stag*)(*dmf)->data;
+  for (d=0; d<dim; ++d) {
+    stagf->N[d] *= 2;
+    for (r=0; r<stagf->nRanks[d]; ++r) stagf->l[d][r] *= 2;
+  }
+  ierr = DMSetUp(*dmf);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode DMCoarsen_Stag(DM dm,MPI_Comm comm,DM *dmc)
+{
+  PetscErrorCode  ierr;
+  DM_Stag * const stag = (DM_Stag*)dm->data;
+  DM_Stag         *stagc;
+  PetscInt        d,r,dim;
+
+  PetscFunctionBegin;
+  ierr = DMGetDimension(dm,&dim);CHKERRQ(ierr);
+  for (d=0; d<dim; ++d) {
+    for (r=0; r<stag->nRanks[d]; ++r) {
+      if (stag->l[d][r] % 2) SETERRQ3(PetscObjectComm((PetscObject)dm),PETSC_ERR_ARG_SIZ,"Cannot coarsen a DMStag with an odd number of elements (%D) on rank %D in direction %D",stag->l[d][r],r,d);
+    }
+  }
+  ierr = DMStagDuplicateWithoutSetup(dm,comm,dmc);CHKERRQ(ierr);
+  stagc = (DM_Stag*)(*dmc)->data;
+  for (d=0; d<dim; ++d) {
+    stagc->N[d] /= 2;
+    for (r=0; r<stagc->nRanks[d]; ++r) stagc->l[d][r] /= 2;
+  }
+  ierr = DMSetUp(*dmc);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode DMDestroy_Stag(DM dm)
 {
   PetscErrorCode ierr;
@@ -466,7 +510,8 @@ PETSC_EXTERN PetscErrorCode DMCreate_Stag(DM dm)
   ierr = PetscMemzero(dm->ops,sizeof(*(dm->ops)));CHKERRQ(ierr);
   dm->ops->createcoordinatedm  = DMCreateCoordinateDM_Stag;
   dm->ops->createglobalvector  = DMCreateGlobalVector_Stag;
-  dm->ops->createinterpolation = NULL;
+  dm->ops->coarsen             = DMCoarsen_Stag;
+  dm->ops->createinterpolation = DMCreateInterpolation_Stag;
   dm->ops->createlocalvector   = DMCreateLocalVector_Stag;
   dm->ops->creatematrix        = DMCreateMatrix_Stag;
   dm->ops->destroy             = DMDestroy_Stag;
@@ -475,6 +520,7 @@ PETSC_EXTERN PetscErrorCode DMCreate_Stag(DM dm)
   dm->ops->globaltolocalend    = DMGlobalToLocalEnd_Stag;
   dm->ops->localtoglobalbegin  = DMLocalToGlobalBegin_Stag;
   dm->ops->localtoglobalend    = DMLocalToGlobalEnd_Stag;
+  dm->ops->refine              = DMRefine_Stag;
   dm->ops->setfromoptions      = DMSetFromOptions_Stag;
   switch (dim) {
     case 1: dm->ops->setup     = DMSetUp_Stag_1d; break;
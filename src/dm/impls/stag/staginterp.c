@@ -0,0 +1,136 @@
+/*
+   Grid transfer operators between DMStag objects related by DMRefine() or DMCoarsen()
+*/
+#include <petsc/private/dmstagimpl.h>
+
+/* Each location is described by the directions in which it sits on a vertex
+   plane (bit d set) rather than halfway between two of them */
+typedef struct {
+  DMStagStencilLocation loc;
+  PetscInt              nodes;
+} DMStagInterpLocation;
+
+static const DMStagInterpLocation locations1d[] = {{DMSTAG_LEFT,1},{DMSTAG_ELEMENT,0}};
+static const DMStagInterpLocation locations2d[] = {{DMSTAG_DOWN_LEFT,3},{DMSTAG_LEFT,1},{DMSTAG_DOWN,2},{DMSTAG_ELEMENT,0}};
+static const DMStagInterpLocation locations3d[] = {{DMSTAG_BACK_DOWN_LEFT,7},{DMSTAG_DOWN_LEFT,3},{DMSTAG_BACK_LEFT,5},{DMSTAG_BACK_DOWN,6},{DMSTAG_LEFT,1},{DMSTAG_DOWN,2},{DMSTAG_BACK,4},{DMSTAG_ELEMENT,0}};
+
+/*
+  The interpolation is a tensor product of one-dimensional operators. In a direction
+  where a location lies on vertex planes, a fine point on a coarse plane takes the coarse
+  value and one halfway between two coarse planes the average of the two; in a direction
+  where it lies between vertex planes, the fine points take the value of their parent.
+  Thus element dof are injected as constants, face dof are interpolated linearly in the
+  normal direction only, and vertex dof are interpolated (bi/tri)linearly. Restriction
+  is the transpose, as used by PCMG by default.
+*/
+PETSC_INTERN PetscErrorCode DMCreateInterpolation_Stag(DM dmc,DM dmf,Mat *A,Vec *vec)
+{
+  PetscErrorCode              ierr;
+  DM_Stag * const             stagc = (DM_Stag*)dmc->data;
+  DM_Stag                     *stagf;
+  const DMStagInterpLocation  *locations;
+  ISLocalToGlobalMapping      ltogc,ltogf;
+  PetscBool                   isstag;
+  PetscInt                    dim,dimf,d,l,nLocations,c,ind[3],lo[3],hi[3],sgf[3],ngf[3],sgc[3],ngc[3];
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)dmf,DMSTAG,&isstag);CHKERRQ(ierr);
+  if (!isstag) SETERRQ(PetscObjectComm((PetscObject)dmc),PETSC_ERR_ARG_WRONG,"Fine DM must also be a DMStag");
+  stagf = (DM_Stag*)dmf->data;
+  ierr = DMGetDimension(dmc,&dim);CHKERRQ(ierr);
+  ierr = DMGetDimension(dmf,&dimf);CHKERRQ(ierr);
+  if (dim != dimf) SETERRQ2(PetscObjectComm((PetscObject)dmc),PETSC_ERR_ARG_INCOMP,"Coarse and fine DMStag have different dimensions %D != %D",dim,dimf);
+  for (d=0; d<=dim; ++d) {
+    if (stagc->dof[d] != stagf->dof[d]) SETERRQ3(PetscObjectComm((PetscObject)dmc),PETSC_ERR_ARG_INCOMP,"Coarse and fine DMStag have different dof on stratum %D: %D != %D",d,stagc->dof[d],stagf->dof[d]);
+  }
+  for (d=0; d<dim; ++d) {
+    if (stagc->boundaryType[d] != stagf->boundaryType[d]) SETERRQ1(PetscObjectComm((PetscObject)dmc),PETSC_ERR_ARG_INCOMP,"Coarse and fine DMStag have different boundary types in direction %D",d);
+    if (stagf->N[d] != 2*stagc->N[d] || stagf->start[d] != 2*stagc->start[d] || stagf->n[d] != 2*stagc->n[d]) SETERRQ1(PetscObjectComm((PetscObject)dmc),PETSC_ERR_ARG_INCOMP,"Fine DMStag elements are not the children of the local coarse DMStag elements in direction %D; create the DMs with DMRefine() or DMCoarsen()",d);
+  }
+  switch (dim) {
+    case 1: locations = locations1d; nLocations = 2; break;
+    case 2: locations = locations2d; nLocations = 4; break;
+    case 3: locations = locations3d; nLocations = 8; break;
+    default : SETERRQ1(PetscObjectComm((PetscObject)dmc),PETSC_ERR_ARG_OUTOFRANGE,"Unsupported dimension %D",dim);
+  }
+
+  ierr = MatCreate(PetscObjectComm((PetscObject)dmc),A);CHKERRQ(ierr);
+  ierr = MatSetSizes(*A,stagf->entries,stagc->entries,PETSC_DETERMINE,PETSC_DETERMINE);CHKERRQ(ierr);
+  ierr = MatSetType(*A,MATAIJ);CHKERRQ(ierr);
+  ierr = MatSeqAIJSetPreallocation(*A,1<<dim,NULL);CHKERRQ(ierr);
+  ierr = MatMPIAIJSetPreallocation(*A,1<<dim,NULL,1<<dim,NULL);CHKERRQ(ierr);
+  ierr = DMGetLocalToGlobalMapping(dmc,&ltogc);CHKERRQ(ierr);
+  ierr = DMGetLocalToGlobalMapping(dmf,&ltogf);CHKERRQ(ierr);
+
+  for (d=0; d<3; ++d) {
+    sgf[d] = d < dim ? stagf->startGhost[d] : 0;
+    ngf[d] = d < dim ? stagf->nGhost[d]     : 1;
+    sgc[d] = d < dim ? stagc->startGhost[d] : 0;
+    ngc[d] = d < dim ? stagc->nGhost[d]     : 1;
+  }
+  for (l=0; l<nLocations; ++l) {
+    const PetscInt nodes = locations[l].nodes;
+    PetscInt       stratum = dim;
+
+    for (d=0; d<dim; ++d) if (nodes & (1<<d)) --stratum;
+    /* Vertex planes include the one on the far boundary of a non-periodic domain */
+    for (d=0; d<3; ++d) {
+      lo[d] = d < dim ? stagf->start[d] : 0;
+      hi[d] = d < dim ? stagf->start[d] + stagf->n[d] : 1;
+      if (d < dim && (nodes & (1<<d)) && stagf->lastRank[d] && stagf->boundaryType[d] != DM_BOUNDARY_PERIODIC) ++hi[d];
+    }
+    for (c=0; c<stagf->dof[stratum]; ++c) {
+      PetscInt slotf,slotc;
+
+      ierr = DMStagGetLocationSlot(dmf,locations[l].loc,c,&slotf);CHKERRQ(ierr);
+      ierr = DMStagGetLocationSlot(dmc,locations[l].loc,c,&slotc);CHKERRQ(ierr);
+      for (ind[2]=lo[2]; ind[2]<hi[2]; ++ind[2]) {
+        for (ind[1]=lo[1]; ind[1]<hi[1]; ++ind[1]) {
+          for (ind[0]=lo[0]; ind[0]<hi[0]; ++ind[0]) {
+            PetscInt    cnt[3],parent[3][2],row,cols[8],n,q[3];
+            PetscScalar w[3][2],vals[8];
+
+            for (d=0; d<3; ++d) {
+              parent[d][0] = ind[d] / 2;
+              w[d][0]      = 1.0;
+              cnt[d]       = 1;
+              if (d < dim && (nodes & (1<<d)) && ind[d] % 2) {
+                parent[d][1] = parent[d][0] + 1;
+                w[d][0]      = w[d][1] = 0.5;
+                cnt[d]       = 2;
+              }
+            }
+            row = (((ind[2]-sgf[2])*ngf[1] + ind[1]-sgf[1])*ngf[0] + ind[0]-sgf[0])*stagf->entriesPerElement + slotf;
+            n   = 0;
+            for (q[2]=0; q[2]<cnt[2]; ++q[2]) {
+              for (q[1]=0; q[1]<cnt[1]; ++q[1]) {
+                for (q[0]=0; q[0]<cnt[0]; ++q[0]) {
+                  for (d=0; d<3; ++d) {
+                    const PetscInt i = parent[d][q[d]] - sgc[d];
+
+                    if (i < 0 || i >= ngc[d]) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Interpolation needs a coarse DMStag stencil width of at least 1");
+                  }
+                  cols[n] = (((parent[2][q[2]]-sgc[2])*ngc[1] + parent[1][q[1]]-sgc[1])*ngc[0] + parent[0][q[0]]-sgc[0])*stagc->entriesPerElement + slotc;
+                  vals[n] = w[0][q[0]]*w[1][q[1]]*w[2][q[2]];
+                  ++n;
+                }
+              }
+            }
+            ierr = ISLocalToGlobalMappingApply(ltogf,1,&row,&row);CHKERRQ(ierr);
+            ierr = ISLocalToGlobalMappingApply(ltogc,n,cols,cols);CHKERRQ(ierr);
+            for (d=0; d<n; ++d) {
+              if (cols[d] < 0) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Interpolation needs the diagonal ghost points of a coarse DMStag with DMSTAG_STENCIL_BOX");
+            }
+            ierr = MatSetValues(*A,1,&row,n,cols,vals,INSERT_VALUES);CHKERRQ(ierr);
+          }
+        }
+      }
+    }
+  }
+  ierr = MatAssemblyBegin(*A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(*A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  if (vec) {
+    ierr = DMCreateInterpolationScale(dmc,dmf,*A,vec);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
@@ -0,0 +1,141 @@
+static char help[] = "Test DMRefine(), DMCoarsen() and DMCreateInterpolation() with DMStag\n\n";
+
+#include <petscdm.h>
+#include <petscdmstag.h>
+
+/* Locations on each stratum, with a bit set for each direction in which the location lies on a vertex plane */
+static const DMStagStencilLocation locs1d[] = {DMSTAG_LEFT,DMSTAG_ELEMENT};
+static const PetscInt              nodes1d[] = {1,0};
+static const DMStagStencilLocation locs2d[] = {DMSTAG_DOWN_LEFT,DMSTAG_LEFT,DMSTAG_DOWN,DMSTAG_ELEMENT};
+static const PetscInt              nodes2d[] = {3,1,2,0};
+static const DMStagStencilLocation locs3d[] = {DMSTAG_BACK_DOWN_LEFT,DMSTAG_DOWN_LEFT,DMSTAG_BACK_LEFT,DMSTAG_BACK_DOWN,DMSTAG_LEFT,DMSTAG_DOWN,DMSTAG_BACK,DMSTAG_ELEMENT};
+static const PetscInt              nodes3d[] = {7,3,5,6,1,2,4,0};
+
+/* A field which is constant on each component, plus linear along the directions in which a
+   location lies on vertex planes if the domain is not periodic. Interpolation reproduces it exactly. */
+static PetscErrorCode FillField(DM dm,Vec vec)
+{
+  PetscErrorCode              ierr;
+  DMBoundaryType              bt[3];
+  const DMStagStencilLocation *locs;
+  const PetscInt              *nodes;
+  PetscInt                    dim,dof[4],N[3],start[3],n[3],extra[3],l,nl,c,d,ind[3],slot;
+  Vec                         local;
+  PetscScalar                 *arr;
+
+  PetscFunctionBeginUser;
+  ierr = DMGetDimension(dm,&dim);CHKERRQ(ierr);
+  ierr = DMStagGetDOF(dm,&dof[0],&dof[1],&dof[2],&dof[3]);CHKERRQ(ierr);
+  ierr = DMStagGetGlobalSizes(dm,&N[0],&N[1],&N[2]);CHKERRQ(ierr);
+  ierr = DMStagGetBoundaryTypes(dm,&bt[0],&bt[1],&bt[2]);CHKERRQ(ierr);
+  ierr = DMStagGetCorners(dm,&start[0],&start[1],&start[2],&n[0],&n[1],&n[2],&extra[0],&extra[1],&extra[2]);CHKERRQ(ierr);
+  for (d=dim; d<3; ++d) {start[d] = 0; n[d] = 1; extra[d] = 0;}
+  switch (dim) {
+    case 1: locs = locs1d; nodes = nodes1d; nl = 2; break;
+    case 2: locs = locs2d; nodes = nodes2d; nl = 4; break;
+    default: locs = locs3d; nodes = nodes3d; nl = 8; break;
+  }
+  ierr = DMGetLocalVector(dm,&local);CHKERRQ(ierr);
+  ierr = VecZeroEntries(local);CHKERRQ(ierr);
+  ierr = VecGetArray(local,&arr);CHKERRQ(ierr);
+  for (l=0; l<nl; ++l) {
+    PetscInt stratum = dim,hi[3];
+
+    for (d=0; d<dim; ++d) if (nodes[l] & (1<<d)) --stratum;
+    for (d=0; d<3; ++d) hi[d] = start[d] + n[d] + ((nodes[l] & (1<<d)) ? extra[d] : 0);
+    for (c=0; c<dof[stratum]; ++c) {
+      ierr = DMStagGetLocationSlot(dm,locs[l],c,&slot);CHKERRQ(ierr);
+      for (ind[2]=start[2]; ind[2]<hi[2]; ++ind[2]) {
+        for (ind[1]=start[1]; ind[1]<hi[1]; ++ind[1]) {
+          for (ind[0]=start[0]; ind[0]<hi[0]; ++ind[0]) {
+            DMStagStencil pt;
+            PetscInt      idx;
+            PetscScalar   v = 1.0 + c + 10.0*stratum;
+
+            for (d=0; d<dim; ++d) {
+              if ((nodes[l] & (1<<d)) && bt[d] != DM_BOUNDARY_PERIODIC) v += (d+1.0)*ind[d]/N[d];
+            }
+            pt.loc = locs[l]; pt.i = ind[0]; pt.j = ind[1]; pt.k = ind[2]; pt.c = c;
+            ierr = DMStagStencilToIndexLocal(dm,dim,1,&pt,&idx);CHKERRQ(ierr);
+            arr[idx] = v;
+          }
+        }
+      }
+    }
+  }
+  ierr = VecRestoreArray(local,&arr);CHKERRQ(ierr);
+  ierr = DMLocalToGlobal(dm,local,INSERT_VALUES,vec);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(dm,&local);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  PetscErrorCode  ierr;
+  DM              dm,dmc,dmf;
+  DMBoundaryType  bt = DM_BOUNDARY_NONE;
+  Mat             P;
+  Vec             xc,xf,yf;
+  PetscInt        dim = 2,Nf,Nr;
+  PetscReal       err;
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-dim",&dim,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetEnum(NULL,NULL,"-boundary",DMBoundaryTypes,(PetscEnum*)&bt,NULL);CHKERRQ(ierr);
+  if (dim == 1) {
+    ierr = DMStagCreate1d(PETSC_COMM_WORLD,bt,16,2,1,DMSTAG_STENCIL_BOX,1,NULL,&dm);CHKERRQ(ierr);
+  } else if (dim == 2) {
+    ierr = DMStagCreate2d(PETSC_COMM_WORLD,bt,bt,8,12,PETSC_DECIDE,PETSC_DECIDE,1,2,1,DMSTAG_STENCIL_BOX,1,NULL,NULL,&dm);CHKERRQ(ierr);
+  } else if (dim == 3) {
+    ierr = DMStagCreate3d(PETSC_COMM_WORLD,bt,bt,bt,4,8,4,PETSC_DECIDE,PETSC_DECIDE,PETSC_DECIDE,1,1,1,2,DMSTAG_STENCIL_BOX,1,NULL,NULL,NULL,&dm);CHKERRQ(ierr);
+  } else SETERRQ1(PETSC_COMM_WORLD,PETSC_ERR_SUP,"No support for dimension %D",dim);
+  ierr = DMSetFromOptions(dm);CHKERRQ(ierr);
+  ierr = DMSetUp(dm);CHKERRQ(ierr);
+
+  /* Coarsening and refining again gives back the same layout */
+  ierr = DMCoarsen(dm,MPI_COMM_NULL,&dmc);CHKERRQ(ierr);
+  ierr = DMRefine(dmc,MPI_COMM_NULL,&dmf);CHKERRQ(ierr);
+  ierr = DMCreateGlobalVector(dm,&xf);CHKERRQ(ierr);
+  ierr = DMCreateGlobalVector(dmf,&yf);CHKERRQ(ierr);
+  ierr = VecGetSize(xf,&Nf);CHKERRQ(ierr);
+  ierr = VecGetSize(yf,&Nr);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Coarsened and refined DM %s the original one\n",Nf == Nr ? "matches" : "DIFFERS from");CHKERRQ(ierr);
+
+  ierr = DMCreateInterpolation(dmc,dm,&P,NULL);CHKERRQ(ierr);
+  ierr = DMCreateGlobalVector(dmc,&xc);CHKERRQ(ierr);
+  ierr = FillField(dmc,xc);CHKERRQ(ierr);
+  ierr = FillField(dm,xf);CHKERRQ(ierr);
+  ierr = MatInterpolate(P,xc,yf);CHKERRQ(ierr);
+  ierr = VecAXPY(yf,-1.0,xf);CHKERRQ(ierr);
+  ierr = VecNorm(yf,NORM_INFINITY,&err);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Interpolated field %s\n",err < 100*PETSC_MACHINE_EPSILON ? "is exact" : "is NOT exact");CHKERRQ(ierr);
+
+  ierr = MatDestroy(&P);CHKERRQ(ierr);
+  ierr = VecDestroy(&xc);CHKERRQ(ierr);
+  ierr = VecDestroy(&xf);CHKERRQ(ierr);
+  ierr = VecDestroy(&yf);CHKERRQ(ierr);
+  ierr = DMDestroy(&dmc);CHKERRQ(ierr);
+  ierr = DMDestroy(&dmf);CHKERRQ(ierr);
+  ierr = DMDestroy(&dm);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: 1d
+      nsize: {{1 2}}
+      args: -dim 1 -boundary {{none periodic}}
+
+   test:
+      suffix: 2d
+      nsize: {{1 4}}
+      args: -dim 2 -boundary {{none ghosted periodic}}
+
+   test:
+      suffix: 3d
+      nsize: {{1 8}}
+      args: -dim 3 -boundary {{none periodic}}
+
+TEST*/
@@ -0,0 +1,334 @@
+static char help[] = "Matrix-free geometric multigrid for variable-viscosity Stokes flow on a staggered grid\n\n";
+/*
+
+  Solves the 2D incompressible Stokes equations with a variable viscosity
+
+    -div(2 eta D(u)) + grad p = f
+                      -div u  = 0
+
+  on the unit square, with no flow through the walls and free slip along them,
+  discretized with the marker-and-cell scheme on a DMStag.
+
+  No matrix is assembled on any level. Each level applies the operator matrix-free,
+  rediscretized on the DMStag obtained with DMCoarsen(), and the levels are connected
+  by DMCreateInterpolation() and its transpose. The smoother is an additive "diagonal
+  Vanka" iteration: each element solves the system coupling its pressure to the
+  velocities on its faces, with the viscous block replaced by its diagonal, and the
+  face corrections are averaged. The coarse problem is solved matrix-free with GMRES.
+
+  All equations are scaled by the element area, so that the rediscretized coarse
+  operators approximate the Galerkin ones.
+
+  For example, for a viscosity contrast of 10^4 on a 128x128 grid,
+
+     ./ex7 -stag_grid_x 128 -stag_grid_y 128 -pc_mg_levels 6 -contrast 1e4 -ksp_monitor
+
+*/
+#include <petscdm.h>
+#include <petscksp.h>
+#include <petscdmstag.h>
+
+typedef struct {
+  PetscReal logcontrast; /* log of the viscosity contrast */
+  PetscReal omega;       /* Vanka damping */
+} AppCtx;
+
+/* A viscosity varying smoothly but quickly across x = 0.5 */
+static PetscReal Eta(AppCtx *user,PetscReal x,PetscReal y)
+{
+  return PetscExpReal(user->logcontrast*(0.5 + 0.5*PetscTanhReal((x - 0.5 + 0.1*y)/0.05)));
+}
+
+/* Local grid information and accessors for the ghosted arrays */
+typedef struct {
+  PetscInt  N[2],iu,iv,ip;
+  PetscReal h[2];
+} Grid;
+
+static PetscErrorCode GetGrid(DM dm,Grid *g)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = DMStagGetGlobalSizes(dm,&g->N[0],&g->N[1],NULL);CHKERRQ(ierr);
+  g->h[0] = 1.0/g->N[0];
+  g->h[1] = 1.0/g->N[1];
+  ierr = DMStagGetLocationSlot(dm,DMSTAG_LEFT,0,&g->iu);CHKERRQ(ierr);
+  ierr = DMStagGetLocationSlot(dm,DMSTAG_DOWN,0,&g->iv);CHKERRQ(ierr);
+  ierr = DMStagGetLocationSlot(dm,DMSTAG_ELEMENT,0,&g->ip);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Velocities normal to the walls are zero */
+static PetscScalar U(const Grid *g,PetscScalar ***a,PetscInt i,PetscInt j) {return (i == 0 || i == g->N[0]) ? 0.0 : a[j][i][g->iu];}
+static PetscScalar V(const Grid *g,PetscScalar ***a,PetscInt i,PetscInt j) {return (j == 0 || j == g->N[1]) ? 0.0 : a[j][i][g->iv];}
+
+/* Viscosity in element (i,j) and on vertex (i,j) */
+static PetscReal EtaC(AppCtx *user,const Grid *g,PetscInt i,PetscInt j) {return Eta(user,(i+0.5)*g->h[0],(j+0.5)*g->h[1]);}
+static PetscReal EtaV(AppCtx *user,const Grid *g,PetscInt i,PetscInt j) {return Eta(user,i*g->h[0],j*g->h[1]);}
+
+/* Deviatoric stresses in element (i,j) and, vanishing on the walls for free slip, on vertex (i,j) */
+static PetscScalar TauXX(AppCtx *user,const Grid *g,PetscScalar ***a,PetscInt i,PetscInt j) {return 2.0*EtaC(user,g,i,j)*(U(g,a,i+1,j) - U(g,a,i,j))/g->h[0];}
+static PetscScalar TauYY(AppCtx *user,const Grid *g,PetscScalar ***a,PetscInt i,PetscInt j) {return 2.0*EtaC(user,g,i,j)*(V(g,a,i,j+1) - V(g,a,i,j))/g->h[1];}
+static PetscScalar TauXY(AppCtx *user,const Grid *g,PetscScalar ***a,PetscInt i,PetscInt j)
+{
+  if (i == 0 || i == g->N[0] || j == 0 || j == g->N[1]) return 0.0;
+  return EtaV(user,g,i,j)*((U(g,a,i,j) - U(g,a,i,j-1))/g->h[1] + (V(g,a,i,j) - V(g,a,i-1,j))/g->h[0]);
+}
+
+/* Diagonal entries of the viscous block for the velocities on the left face (dir 0) or the
+   bottom face (dir 1) of element (i,j), and the scaling of the rows of the wall velocities */
+static PetscReal Diag(AppCtx *user,const Grid *g,PetscInt dir,PetscInt i,PetscInt j)
+{
+  const PetscReal r = g->h[1]/g->h[0];
+
+  if (dir == 0) {
+    if (i == 0 || i == g->N[0]) return 2.0*Eta(user,i*g->h[0],(j+0.5)*g->h[1])*(r + 1.0/r);
+    return 2.0*(EtaC(user,g,i,j) + EtaC(user,g,i-1,j))*r + ((j > 0 ? EtaV(user,g,i,j) : 0.0) + (j+1 < g->N[1] ? EtaV(user,g,i,j+1) : 0.0))/r;
+  } else {
+    if (j == 0 || j == g->N[1]) return 2.0*Eta(user,(i+0.5)*g->h[0],j*g->h[1])*(r + 1.0/r);
+    return 2.0*(EtaC(user,g,i,j) + EtaC(user,g,i,j-1))/r + ((i > 0 ? EtaV(user,g,i,j) : 0.0) + (i+1 < g->N[0] ? EtaV(user,g,i+1,j) : 0.0))*r;
+  }
+}
+
+static PetscErrorCode MatMult_Stokes(Mat A,Vec x,Vec y)
+{
+  PetscErrorCode ierr;
+  AppCtx         *user;
+  DM             dm;
+  Grid           g;
+  Vec            xLocal,yLocal;
+  PetscScalar    ***a,***b;
+  PetscInt       xs,ys,nx,ny,ex,ey,i,j;
+
+  PetscFunctionBeginUser;
+  ierr = MatShellGetContext(A,&user);CHKERRQ(ierr);
+  ierr = MatGetDM(A,&dm);CHKERRQ(ierr);
+  ierr = GetGrid(dm,&g);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(dm,&xLocal);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(dm,&yLocal);CHKERRQ(ierr);
+  ierr = DMGlobalToLocal(dm,x,INSERT_VALUES,xLocal);CHKERRQ(ierr);
+  ierr = DMStagVecGetArrayRead(dm,xLocal,&a);CHKERRQ(ierr);
+  ierr = DMStagVecGetArray(dm,yLocal,&b);CHKERRQ(ierr);
+  ierr = DMStagGetCorners(dm,&xs,&ys,NULL,&nx,&ny,NULL,&ex,&ey,NULL);CHKERRQ(ierr);
+  for (j=ys; j<ys+ny+ey; ++j) {
+    for (i=xs; i<xs+nx+ex; ++i) {
+      if (j < g.N[1]) {
+        if (i == 0 || i == g.N[0]) b[j][i][g.iu] = Diag(user,&g,0,i,j)*a[j][i][g.iu];
+        else b[j][i][g.iu] = -(TauXX(user,&g,a,i,j) - TauXX(user,&g,a,i-1,j))*g.h[1] - (TauXY(user,&g,a,i,j+1) - TauXY(user,&g,a,i,j))*g.h[0] + (a[j][i][g.ip] - a[j][i-1][g.ip])*g.h[1];
+      }
+      if (i < g.N[0]) {
+        if (j == 0 || j == g.N[1]) b[j][i][g.iv] = Diag(user,&g,1,i,j)*a[j][i][g.iv];
+        else b[j][i][g.iv] = -(TauYY(user,&g,a,i,j) - TauYY(user,&g,a,i,j-1))*g.h[0] - (TauXY(user,&g,a,i+1,j) - TauXY(user,&g,a,i,j))*g.h[1] + (a[j][i][g.ip] - a[j-1][i][g.ip])*g.h[0];
+      }
+      if (i < g.N[0] && j < g.N[1]) {
+        b[j][i][g.ip] = -(U(&g,a,i+1,j) - U(&g,a,i,j))*g.h[1] - (V(&g,a,i,j+1) - V(&g,a,i,j))*g.h[0];
+      }
+    }
+  }
+  ierr = DMStagVecRestoreArrayRead(dm,xLocal,&a);CHKERRQ(ierr);
+  ierr = DMStagVecRestoreArray(dm,yLocal,&b);CHKERRQ(ierr);
+  ierr = DMLocalToGlobal(dm,yLocal,INSERT_VALUES,y);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(dm,&xLocal);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(dm,&yLocal);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Pressure correction of the element (i,j) system, with the viscous block replaced by its diagonal */
+static PetscScalar VankaPressure(AppCtx *user,const Grid *g,PetscScalar ***r,PetscInt i,PetscInt j)
+{
+  PetscScalar rhs = -r[j][i][g->ip];
+  PetscReal   s = 0.0,d;
+
+  if (i > 0)          {d = Diag(user,g,0,i,j);   rhs += g->h[1]*r[j][i][g->iu]/d;   s += g->h[1]*g->h[1]/d;}
+  if (i+1 < g->N[0])  {d = Diag(user,g,0,i+1,j); rhs -= g->h[1]*r[j][i+1][g->iu]/d; s += g->h[1]*g->h[1]/d;}
+  if (j > 0)          {d = Diag(user,g,1,i,j);   rhs += g->h[0]*r[j][i][g->iv]/d;   s += g->h[0]*g->h[0]/d;}
+  if (j+1 < g->N[1])  {d = Diag(user,g,1,i,j+1); rhs -= g->h[0]*r[j+1][i][g->iv]/d; s += g->h[0]*g->h[0]/d;}
+  return rhs/s;
+}
+
+static PetscErrorCode PCApply_Vanka(PC pc,Vec r,Vec z)
+{
+  PetscErrorCode ierr;
+  AppCtx         *user;
+  Mat            A;
+  DM             dm;
+  Grid           g;
+  Vec            rLocal,zLocal;
+  PetscScalar    ***a,***b;
+  PetscInt       xs,ys,nx,ny,ex,ey,i,j;
+
+  PetscFunctionBeginUser;
+  ierr = PCShellGetContext(pc,(void**)&user);CHKERRQ(ierr);
+  ierr = PCGetOperators(pc,&A,NULL);CHKERRQ(ierr);
+  ierr = MatGetDM(A,&dm);CHKERRQ(ierr);
+  ierr = GetGrid(dm,&g);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(dm,&rLocal);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(dm,&zLocal);CHKERRQ(ierr);
+  ierr = DMGlobalToLocal(dm,r,INSERT_VALUES,rLocal);CHKERRQ(ierr);
+  ierr = DMStagVecGetArrayRead(dm,rLocal,&a);CHKERRQ(ierr);
+  ierr = DMStagVecGetArray(dm,zLocal,&b);CHKERRQ(ierr);
+  ierr = DMStagGetCorners(dm,&xs,&ys,NULL,&nx,&ny,NULL,&ex,&ey,NULL);CHKERRQ(ierr);
+  for (j=ys; j<ys+ny+ey; ++j) {
+    for (i=xs; i<xs+nx+ex; ++i) {
+      /* A face velocity receives the average of the corrections from its two elements */
+      if (j < g.N[1]) {
+        if (i == 0 || i == g.N[0]) b[j][i][g.iu] = a[j][i][g.iu]/Diag(user,&g,0,i,j);
+        else b[j][i][g.iu] = user->omega*(a[j][i][g.iu] - 0.5*g.h[1]*(VankaPressure(user,&g,a,i,j) - VankaPressure(user,&g,a,i-1,j)))/Diag(user,&g,0,i,j);
+      }
+      if (i < g.N[0]) {
+        if (j == 0 || j == g.N[1]) b[j][i][g.iv] = a[j][i][g.iv]/Diag(user,&g,1,i,j);
+        else b[j][i][g.iv] = user->omega*(a[j][i][g.iv] - 0.5*g.h[0]*(VankaPressure(user,&g,a,i,j) - VankaPressure(user,&g,a,i,j-1)))/Diag(user,&g,1,i,j);
+      }
+      if (i < g.N[0] && j < g.N[1]) b[j][i][g.ip] = user->omega*VankaPressure(user,&g,a,i,j);
+    }
+  }
+  ierr = DMStagVecRestoreArrayRead(dm,rLocal,&a);CHKERRQ(ierr);
+  ierr = DMStagVecRestoreArray(dm,zLocal,&b);CHKERRQ(ierr);
+  ierr = DMLocalToGlobal(dm,zLocal,INSERT_VALUES,z);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(dm,&rLocal);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(dm,&zLocal);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode AttachNullspace(DM dm,Mat A)
+{
+  PetscErrorCode ierr;
+  DM             dmPressure;
+  Vec            constantPressure,basis;
+  PetscReal      nrm;
+  MatNullSpace   matNullSpace;
+
+  PetscFunctionBeginUser;
+  ierr = DMStagCreateCompatibleDMStag(dm,0,0,1,0,&dmPressure);CHKERRQ(ierr);
+  ierr = DMGetGlobalVector(dmPressure,&constantPressure);CHKERRQ(ierr);
+  ierr = VecSet(constantPressure,1.0);CHKERRQ(ierr);
+  ierr = VecNorm(constantPressure,NORM_2,&nrm);CHKERRQ(ierr);
+  ierr = VecScale(constantPressure,1.0/nrm);CHKERRQ(ierr);
+  ierr = DMCreateGlobalVector(dm,&basis);CHKERRQ(ierr);
+  ierr = DMStagMigrateVec(dmPressure,constantPressure,dm,basis);CHKERRQ(ierr);
+  ierr = MatNullSpaceCreate(PetscObjectComm((PetscObject)dm),PETSC_FALSE,1,&basis,&matNullSpace);CHKERRQ(ierr);
+  ierr = VecDestroy(&basis);CHKERRQ(ierr);
+  ierr = DMRestoreGlobalVector(dmPressure,&constantPressure);CHKERRQ(ierr);
+  ierr = DMDestroy(&dmPressure);CHKERRQ(ierr);
+  ierr = MatSetNullSpace(A,matNullSpace);CHKERRQ(ierr);
+  ierr = MatNullSpaceDestroy(&matNullSpace);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Called on every level, with the MATSHELL created by DMCreateMatrix() */
+static PetscErrorCode ComputeOperators(KSP ksp,Mat J,Mat Jpre,void *ctx)
+{
+  PetscErrorCode ierr;
+  DM             dm;
+
+  PetscFunctionBeginUser;
+  ierr = KSPGetDM(ksp,&dm);CHKERRQ(ierr);
+  ierr = MatShellSetContext(J,ctx);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(J,MATOP_MULT,(void(*)(void))MatMult_Stokes);CHKERRQ(ierr);
+  ierr = AttachNullspace(dm,J);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* A buoyancy force, scaled by the element area like the equations */
+static PetscErrorCode ComputeRHS(KSP ksp,Vec b,void *ctx)
+{
+  PetscErrorCode ierr;
+  DM             dm;
+  Grid           g;
+  Vec            bLocal;
+  PetscScalar    ***arr;
+  PetscInt       xs,ys,nx,ny,ex,ey,i,j;
+
+  PetscFunctionBeginUser;
+  ierr = KSPGetDM(ksp,&dm);CHKERRQ(ierr);
+  ierr = GetGrid(dm,&g);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(dm,&bLocal);CHKERRQ(ierr);
+  ierr = VecZeroEntries(bLocal);CHKERRQ(ierr);
+  ierr = DMStagVecGetArray(dm,bLocal,&arr);CHKERRQ(ierr);
+  ierr = DMStagGetCorners(dm,&xs,&ys,NULL,&nx,&ny,NULL,&ex,&ey,NULL);CHKERRQ(ierr);
+  for (j=ys; j<ys+ny+ey; ++j) {
+    for (i=xs; i<xs+nx; ++i) {
+      const PetscReal x = (i+0.5)*g.h[0],y = j*g.h[1];
+
+      if (j > 0 && j < g.N[1]) arr[j][i][g.iv] = -PetscExpReal(-((x-0.3)*(x-0.3) + (y-0.6)*(y-0.6))/0.01)*g.h[0]*g.h[1];
+    }
+  }
+  ierr = DMStagVecRestoreArray(dm,bLocal,&arr);CHKERRQ(ierr);
+  ierr = DMLocalToGlobal(dm,bLocal,INSERT_VALUES,b);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(dm,&bLocal);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  PetscErrorCode ierr;
+  DM             dm;
+  KSP            ksp,kspLevel;
+  PC             pc,pcLevel;
+  AppCtx         user;
+  PetscReal      contrast = 1e2;
+  PetscInt       nlevels,l;
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  user.omega = 0.8;
+  ierr = PetscOptionsGetReal(NULL,NULL,"-contrast",&contrast,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetReal(NULL,NULL,"-omega",&user.omega,NULL);CHKERRQ(ierr);
+  user.logcontrast = PetscLogReal(contrast);
+
+  /* Velocities on the faces and pressure in the elements. The box stencil provides the
+     diagonal ghost points used by the shear stresses and by the interpolation. */
+  ierr = DMStagCreate2d(PETSC_COMM_WORLD,DM_BOUNDARY_NONE,DM_BOUNDARY_NONE,32,32,PETSC_DECIDE,PETSC_DECIDE,0,1,1,DMSTAG_STENCIL_BOX,1,NULL,NULL,&dm);CHKERRQ(ierr);
+  ierr = DMSetFromOptions(dm);CHKERRQ(ierr);
+  ierr = DMSetUp(dm);CHKERRQ(ierr);
+  ierr = DMSetMatType(dm,MATSHELL);CHKERRQ(ierr);
+
+  ierr = KSPCreate(PETSC_COMM_WORLD,&ksp);CHKERRQ(ierr);
+  ierr = KSPSetDM(ksp,dm);CHKERRQ(ierr);
+  ierr = KSPSetComputeOperators(ksp,ComputeOperators,&user);CHKERRQ(ierr);
+  ierr = KSPSetComputeRHS(ksp,ComputeRHS,&user);CHKERRQ(ierr);
+  ierr = KSPSetType(ksp,KSPFGMRES);CHKERRQ(ierr);
+  ierr = KSPGetPC(ksp,&pc);CHKERRQ(ierr);
+  ierr = PCSetType(pc,PCMG);CHKERRQ(ierr);
+  ierr = PCMGSetLevels(pc,4,NULL);CHKERRQ(ierr);
+  ierr = KSPSetFromOptions(ksp);CHKERRQ(ierr);
+
+  /* Defaults for the smoothers and the coarse solver, which the options database can still override */
+  ierr = PCMGGetLevels(pc,&nlevels);CHKERRQ(ierr);
+  for (l=1; l<nlevels; ++l) {
+    ierr = PCMGGetSmoother(pc,l,&kspLevel);CHKERRQ(ierr);
+    ierr = KSPSetType(kspLevel,KSPRICHARDSON);CHKERRQ(ierr);
+    ierr = KSPGetPC(kspLevel,&pcLevel);CHKERRQ(ierr);
+    ierr = PCSetType(pcLevel,PCSHELL);CHKERRQ(ierr);
+    ierr = PCShellSetContext(pcLevel,&user);CHKERRQ(ierr);
+    ierr = PCShellSetApply(pcLevel,PCApply_Vanka);CHKERRQ(ierr);
+    ierr = PCShellSetName(pcLevel,"diagonal Vanka");CHKERRQ(ierr);
+  }
+  ierr = PCMGGetCoarseSolve(pc,&kspLevel);CHKERRQ(ierr);
+  ierr = KSPSetType(kspLevel,KSPGMRES);CHKERRQ(ierr);
+  ierr = KSPGMRESSetRestart(kspLevel,100);CHKERRQ(ierr);
+  ierr = KSPSetTolerances(kspLevel,1e-8,PETSC_DEFAULT,PETSC_DEFAULT,100);CHKERRQ(ierr);
+  ierr = KSPGetPC(kspLevel,&pcLevel);CHKERRQ(ierr);
+  ierr = PCSetType(pcLevel,PCNONE);CHKERRQ(ierr);
+
+  ierr = KSPSolve(ksp,NULL,NULL);CHKERRQ(ierr);
+
+  ierr = KSPDestroy(&ksp);CHKERRQ(ierr);
+  ierr = DMDestroy(&dm);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      nsize: {{1 4}}
+      args: -ksp_converged_reason -ksp_rtol 1e-8
+
+   test:
+      suffix: contrast
+      nsize: 4
+      args: -stag_grid_x 64 -stag_grid_y 64 -pc_mg_levels 5 -contrast 1e4 -ksp_monitor_short -ksp_converged_reason
+
+TEST*/
@@ -48,11 +48,10 @@ PetscErrorCode DMSwarmDataFieldCreate(const char registration_function[],const c
   ierr = PetscStrallocpy(registration_function, &df->registration_function);CHKERRQ(ierr);
   ierr = PetscStrallocpy(name, &df->name);CHKERRQ(ierr);
   df->atomic_size = size;
-  df->L  = L;
+  df->L  = 0;
   df->bs = 1;
   /* allocate something so we don't have to reallocate */
-  ierr = PetscMalloc(size * L, &df->data);CHKERRQ(ierr);
-  ierr = PetscMemzero(df->data, size * L);CHKERRQ(ierr);
+  ierr = DMSwarmDataFieldSetSize(df, L);CHKERRQ(ierr);
   *DF = df;
   PetscFunctionReturn(0);
 }
@@ -65,7 +64,7 @@ PetscErrorCode DMSwarmDataFieldDestroy(DMSwarmDataField *DF)
   PetscFunctionBegin;
   ierr = PetscFree(df->registration_function);CHKERRQ(ierr);
   ierr = PetscFree(df->name);CHKERRQ(ierr);
-  ierr = PetscFree(df->data);CHKERRQ(ierr);
+  ierr = PetscFree(df->data_raw);CHKERRQ(ierr);
   ierr = PetscFree(df);CHKERRQ(ierr);
   *DF  = NULL;
   PetscFunctionReturn(0);
@@ -214,22 +213,33 @@ PetscErrorCode DMSwarmDataFieldSetBlockSize(DMSwarmDataField df,PetscInt blocksi
   PetscFunctionReturn(0);
 }
 
+/*
+ The storage is moved to a new allocation, aligned to DMSWARM_DATAFIELD_ALIGNMENT and padded to a multiple of it,
+ so that vector loads of whole registers never run past the end of the field. New entries and the padding are zeroed.
+*/
 PetscErrorCode DMSwarmDataFieldSetSize(DMSwarmDataField df,const PetscInt new_L)
 {
+  const size_t   align = DMSWARM_DATAFIELD_ALIGNMENT;
+  size_t         bytes,keep;
+  void           *raw;
+  char           *data;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
   if (new_L < 0) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_USER,"Cannot set size of DMSwarmDataField to be < 0");
-  if (new_L == df->L) PetscFunctionReturn(0);
-  if (new_L > df->L) {
-    ierr = PetscRealloc(df->atomic_size * (new_L), &df->data);CHKERRQ(ierr);
-    /* init new contents */
-    ierr = PetscMemzero(( ((char*)df->data)+df->L*df->atomic_size), (new_L-df->L)*df->atomic_size);CHKERRQ(ierr);
-  } else {
-    /* reallocate pointer list, add +1 in case new_L = 0 */
-    ierr = PetscRealloc(df->atomic_size * (new_L+1), &df->data);CHKERRQ(ierr);
-  }
-  df->L = new_L;
+  if (new_L == df->L && df->data_raw) PetscFunctionReturn(0);
+  /* add +1 in case new_L = 0 */
+  bytes = ((df->atomic_size * (new_L+1) + align-1)/align)*align;
+  ierr = PetscMalloc(bytes + align-1, &raw);CHKERRQ(ierr);
+  data = (char*)raw + (align - ((PETSC_UINTPTR_T)raw) % align) % align;
+  keep = df->atomic_size * PetscMin(df->L,new_L);
+  if (keep) {ierr = PetscMemcpy(data, df->data, keep);CHKERRQ(ierr);}
+  /* init new contents */
+  ierr = PetscMemzero(data + keep, bytes - keep);CHKERRQ(ierr);
+  ierr = PetscFree(df->data_raw);CHKERRQ(ierr);
+  df->data_raw = raw;
+  df->data     = (void*)data;
+  df->L        = new_L;
   PetscFunctionReturn(0);
 }
 
@@ -247,10 +257,15 @@ PetscErrorCode DMSwarmDataFieldZeroBlock(DMSwarmDataField df,const PetscInt star
 
 /*
  A negative buffer value will simply be ignored and the old buffer value will be used.
+
+ The fields are only reallocated when the capacity is exceeded, in which case it grows by at least half so that
+ adding points in many small batches costs an amortized constant number of copies per point. Removed points leave
+ their slots zeroed within the allocation, where they are reused by later additions; the fields are only shrunk once
+ fewer than a quarter of the slots are needed.
  */
 PetscErrorCode DMSwarmDataBucketSetSizes(DMSwarmDataBucket db,const PetscInt L,const PetscInt buffer)
 {
-  PetscInt       current_allocated,new_used,new_unused,new_buffer,new_allocated,f;
+  PetscInt       current_allocated,current_used,new_used,new_unused,new_buffer,new_allocated,f;
   PetscBool      any_active_fields;
   PetscErrorCode ierr;
 
@@ -260,6 +275,7 @@ PetscErrorCode DMSwarmDataBucketSetSizes(DMSwarmDataBucket db,const PetscInt L,c
   if (any_active_fields) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_USER,"Cannot safely re-size as at least one DMSwarmDataField is currently being accessed");
 
   current_allocated = db->allocated;
+  current_used = PetscMax(db->L,0);
   new_used   = L;
   new_unused = current_allocated - new_used;
   new_buffer = db->buffer;
@@ -269,15 +285,16 @@ PetscErrorCode DMSwarmDataBucketSetSizes(DMSwarmDataBucket db,const PetscInt L,c
   new_allocated = new_used + new_buffer;
   /* action */
   if (new_allocated > current_allocated) {
-    /* increase size to new_used + new_buffer */
+    /* increase size to at least new_used + new_buffer */
+    new_allocated = PetscMax(new_allocated, current_allocated + current_allocated/2);
     for (f=0; f<db->nfields; f++) {
       ierr = DMSwarmDataFieldSetSize(db->field[f], new_allocated);CHKERRQ(ierr);
     }
     db->L         = new_used;
     db->buffer    = new_buffer;
-    db->allocated = new_used + new_buffer;
+    db->allocated = new_allocated;
   } else {
-    if (new_unused > 2 * new_buffer) {
+    if (new_unused > 2 * new_buffer && 4 * new_allocated <= current_allocated) {
       /* shrink array to new_used + new_buffer */
       for (f = 0; f < db->nfields; ++f) {
         ierr = DMSwarmDataFieldSetSize(db->field[f], new_allocated);CHKERRQ(ierr);
@@ -290,10 +307,12 @@ PetscErrorCode DMSwarmDataBucketSetSizes(DMSwarmDataBucket db,const PetscInt L,c
       db->buffer = new_buffer;
     }
   }
-  /* zero all entries from db->L to db->allocated */
-  for (f = 0; f < db->nfields; ++f) {
-    DMSwarmDataField field = db->field[f];
-    ierr = DMSwarmDataFieldZeroBlock(field, db->L,db->allocated);CHKERRQ(ierr);
+  /* entries from db->L to db->allocated are kept zero, so only the slots just released need zeroing */
+  if (db->L < current_used) {
+    for (f = 0; f < db->nfields; ++f) {
+      DMSwarmDataField field = db->field[f];
+      ierr = DMSwarmDataFieldZeroBlock(field, db->L, PetscMin(current_used,db->allocated));CHKERRQ(ierr);
+    }
   }
   PetscFunctionReturn(0);
 }
@@ -735,10 +754,12 @@ PetscErrorCode DMSwarmDataBucketCreatePackedArray(DMSwarmDataBucket db,size_t *b
     DMSwarmDataField df = db->field[f];
     sizeof_marker_contents += df->atomic_size;
   }
-  ierr = PetscMalloc(sizeof_marker_contents, &buffer);CHKERRQ(ierr);
-  ierr = PetscMemzero(buffer, sizeof_marker_contents);CHKERRQ(ierr);
   if (bytes) {*bytes = sizeof_marker_contents;}
-  if (buf)   {*buf   = buffer;}
+  if (buf) {
+    ierr = PetscMalloc(sizeof_marker_contents, &buffer);CHKERRQ(ierr);
+    ierr = PetscMemzero(buffer, sizeof_marker_contents);CHKERRQ(ierr);
+    *buf = buffer;
+  }
   PetscFunctionReturn(0);
 }
 
@@ -793,3 +814,119 @@ PetscErrorCode DMSwarmDataBucketInsertPackedArray(DMSwarmDataBucket db,const Pet
   }
   PetscFunctionReturn(0);
 }
+
+/* pack the points list[0], ..., list[n-1] into consecutive entries of buf, copying one field at a time */
+PetscErrorCode DMSwarmDataBucketFillPackedArrays(DMSwarmDataBucket db,const PetscInt n,const PetscInt list[],void *buf)
+{
+  PetscInt       f,p;
+  size_t         psize = 0,offset = 0;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (f = 0; f < db->nfields; ++f) psize += db->field[f]->atomic_size;
+  for (f = 0; f < db->nfields; ++f) {
+    DMSwarmDataField df    = db->field[f];
+    const size_t     asize = df->atomic_size;
+    const char       *data = (const char*)df->data;
+
+    for (p = 0; p < n; ++p) {
+#if defined(DMSWARM_DATAFIELD_POINT_ACCESS_GUARD)
+      if (list[p] < 0 || list[p] >= db->L) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_USER,"index %D must be in [0, %D)",list[p],db->L);
+#endif
+      ierr = PetscMemcpy((char*)buf + p*psize + offset, data + list[p]*asize, asize);CHKERRQ(ierr);
+    }
+    offset += asize;
+  }
+  PetscFunctionReturn(0);
+}
+
+/* insert n packed points into the existing locations start, ..., start+n-1, copying one field at a time */
+PetscErrorCode DMSwarmDataBucketInsertPackedArrays(DMSwarmDataBucket db,const PetscInt start,const PetscInt n,const void *data)
+{
+  PetscInt       f,p;
+  size_t         psize = 0,offset = 0;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+#if defined(DMSWARM_DATAFIELD_POINT_ACCESS_GUARD)
+  if (start < 0 || start+n > db->L) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_USER,"range [%D, %D) must lie in [0, %D)",start,start+n,db->L);
+#endif
+  for (f = 0; f < db->nfields; ++f) psize += db->field[f]->atomic_size;
+  for (f = 0; f < db->nfields; ++f) {
+    DMSwarmDataField df    = db->field[f];
+    const size_t     asize = df->atomic_size;
+    char             *dest = (char*)df->data + start*asize;
+
+    for (p = 0; p < n; ++p) {
+      ierr = PetscMemcpy(dest + p*asize, (const char*)data + p*psize + offset, asize);CHKERRQ(ierr);
+    }
+    offset += asize;
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+  remove every point p >= start with remove[p] set, in a single pass over each field.
+  The final ordering is the one given by calling DMSwarmDataBucketRemovePointAtIndex() on each point in turn,
+  that is each hole is filled with the current last point.
+*/
+PetscErrorCode DMSwarmDataBucketRemovePoints(DMSwarmDataBucket db,const PetscInt start,const PetscBool remove[])
+{
+  PetscInt       *perm,L,f,p;
+  PetscBool      any_active_fields;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMSwarmDataBucketQueryForActiveFields(db,&any_active_fields);CHKERRQ(ierr);
+  if (any_active_fields) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_USER,"Cannot safely remove points as at least one DMSwarmDataField is currently being accessed");
+  L = db->L;
+  ierr = PetscMalloc1(L,&perm);CHKERRQ(ierr);
+  for (p = 0; p < L; ++p) perm[p] = p;
+  for (p = start; p < L; ++p) {
+    while (p < L && remove[perm[p]]) {perm[p] = perm[L-1]; --L;}
+  }
+  /* moved points all come from beyond the new size, so the copies never overlap */
+  for (f = 0; f < db->nfields; ++f) {
+    DMSwarmDataField df    = db->field[f];
+    const size_t     asize = df->atomic_size;
+    char             *data = (char*)df->data;
+
+    for (p = start; p < L; ++p) {
+      if (perm[p] != p) {ierr = PetscMemcpy(data + p*asize, data + perm[p]*asize, asize);CHKERRQ(ierr);}
+    }
+  }
+  ierr = PetscFree(perm);CHKERRQ(ierr);
+  if (L != db->L) {ierr = DMSwarmDataBucketSetSizes(db,L,DMSWARM_DATA_BUCKET_BUFFER_DEFAULT);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+/* reorder the points in use so that point p receives the contents of point perm[p], one field at a time */
+PetscErrorCode DMSwarmDataBucketPermutePoints(DMSwarmDataBucket db,const PetscInt perm[])
+{
+  PetscInt       f,p;
+  size_t         asize_max = 0;
+  char           *buf;
+  PetscBool      any_active_fields;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMSwarmDataBucketQueryForActiveFields(db,&any_active_fields);CHKERRQ(ierr);
+  if (any_active_fields) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_USER,"Cannot safely permute points as at least one DMSwarmDataField is currently being accessed");
+  for (f = 0; f < db->nfields; ++f) asize_max = PetscMax(asize_max,db->field[f]->atomic_size);
+  ierr = PetscMalloc(asize_max*db->L+1,&buf);CHKERRQ(ierr);
+  for (f = 0; f < db->nfields; ++f) {
+    DMSwarmDataField df    = db->field[f];
+    const size_t     asize = df->atomic_size;
+    char             *data = (char*)df->data;
+
+    for (p = 0; p < db->L; ++p) {
+#if defined(DMSWARM_DATAFIELD_POINT_ACCESS_GUARD)
+      if (perm[p] < 0 || perm[p] >= db->L) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_USER,"index %D must be in [0, %D)",perm[p],db->L);
+#endif
+      ierr = PetscMemcpy(buf + p*asize, data + perm[p]*asize, asize);CHKERRQ(ierr);
+    }
+    ierr = PetscMemcpy(data, buf, db->L*asize);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(buf);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -6,6 +6,9 @@
 #define DMSWARM_DATA_BUCKET_BUFFER_DEFAULT -1
 #define DMSWARM_DATAFIELD_POINT_ACCESS_GUARD
 
+/* field storage is aligned to, and padded to a multiple of, this many bytes */
+#define DMSWARM_DATAFIELD_ALIGNMENT 64
+
 /* Logging flag */
 #define DMSWARM_DATA_BUCKET_LOG
 
@@ -17,14 +20,15 @@ struct _p_DMSwarmDataField {
         PetscBool     active;
         size_t        atomic_size;
         char          *name; /* what are they called */
-        void          *data; /* the data - an array of structs */
+        void          *data; /* the data - an array of structs, aligned to DMSWARM_DATAFIELD_ALIGNMENT */
+        void          *data_raw; /* the allocation data lives in */
   PetscDataType petsc_type;
 };
 
 struct _p_DMSwarmDataBucket {
         PetscInt  L;             /* number in use */
         PetscInt  buffer;        /* memory buffer used for re-allocation */
-        PetscInt  allocated;     /* number allocated, this will equal datafield->L */
+        PetscInt  allocated;     /* number allocated, this will equal datafield->L; slots in [L, allocated) are zero and are reused before the fields are reallocated */
         PetscBool finalised;     /* DEPRECATED */
         PetscInt  nfields;       /* how many fields of this type */
         DMSwarmDataField *field; /* the data */
@@ -88,5 +92,9 @@ PETSC_INTERN PetscErrorCode DMSwarmDataBucketCreatePackedArray(DMSwarmDataBucket
 PETSC_INTERN PetscErrorCode DMSwarmDataBucketDestroyPackedArray(DMSwarmDataBucket db,void **buf);
 PETSC_INTERN PetscErrorCode DMSwarmDataBucketFillPackedArray(DMSwarmDataBucket db,const PetscInt index,void *buf);
 PETSC_INTERN PetscErrorCode DMSwarmDataBucketInsertPackedArray(DMSwarmDataBucket db,const PetscInt idx,void *data);
+PETSC_INTERN PetscErrorCode DMSwarmDataBucketFillPackedArrays(DMSwarmDataBucket db,const PetscInt n,const PetscInt list[],void *buf);
+PETSC_INTERN PetscErrorCode DMSwarmDataBucketInsertPackedArrays(DMSwarmDataBucket db,const PetscInt start,const PetscInt n,const void *data);
+PETSC_INTERN PetscErrorCode DMSwarmDataBucketRemovePoints(DMSwarmDataBucket db,const PetscInt start,const PetscBool remove[]);
+PETSC_INTERN PetscErrorCode DMSwarmDataBucketPermutePoints(DMSwarmDataBucket db,const PetscInt perm[]);
 
 #endif
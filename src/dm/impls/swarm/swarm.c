@@ -11,6 +11,7 @@
 #include <petscsection.h>
 
 PetscLogEvent DMSWARM_Migrate, DMSWARM_SetSizes, DMSWARM_AddPoints, DMSWARM_RemovePoints, DMSWARM_Sort;
+PetscLogEvent DMSWARM_Deposit, DMSWARM_Interpolate;
 PetscLogEvent DMSWARM_DataExchangerTopologySetup, DMSWARM_DataExchangerBegin, DMSWARM_DataExchangerEnd;
 PetscLogEvent DMSWARM_DataExchangerSendCount, DMSWARM_DataExchangerPack;
 
@@ -18,6 +19,7 @@ const char* DMSwarmTypeNames[] = { "basic", "pic", NULL };
 const char* DMSwarmMigrateTypeNames[] = { "basic", "dmcellnscatter", "dmcellexact", "user", NULL };
 const char* DMSwarmCollectTypeNames[] = { "basic", "boundingbox", "general", "user", NULL  };
 const char* DMSwarmPICLayoutTypeNames[] = { "regular", "gauss", "subdivision", NULL  };
+const char *const DMSwarmDepositTypes[] = { "ngp", "cic", "tsc", "p1", "DMSwarmDepositType", "DMSWARM_DEPOSIT_", NULL };
 
 const char DMSwarmField_pid[] = "DMSwarm_pid";
 const char DMSwarmField_rank[] = "DMSwarm_rank";
@@ -1336,6 +1338,7 @@ PetscErrorCode DMSwarmMigrate(DM dm,PetscBool remove_sent_points)
   }
   ierr = PetscLogEventEnd(DMSWARM_Migrate,0,0,0,0);CHKERRQ(ierr);
   ierr = DMClearGlobalVectors(dm);CHKERRQ(ierr);
+  ierr = DMSwarmSortReorderAfterMigrate_Internal(dm);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1630,6 +1633,21 @@ PetscErrorCode DMSwarmView_Draw(DM dm, PetscViewer viewer)
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode DMSetFromOptions_Swarm(PetscOptionItems *PetscOptionsObject,DM dm)
+{
+  DM_Swarm       *swarm = (DM_Swarm*)dm->data;
+  PetscInt       freq = swarm->sort_reorder_freq;
+  PetscBool      flg;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"DMSwarm Options");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-dm_swarm_sort_reorder_frequency","Reorder the points by cell after every k-th migration","DMSwarmSortSetReorderFrequency",freq,&freq,&flg);CHKERRQ(ierr);
+  if (flg) {ierr = DMSwarmSortSetReorderFrequency(dm,freq);CHKERRQ(ierr);}
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode DMView_Swarm(DM dm, PetscViewer viewer)
 {
   DM_Swarm       *swarm = (DM_Swarm*)dm->data;
@@ -1759,7 +1777,7 @@ static PetscErrorCode DMInitialize_Swarm(DM sw)
   sw->dim  = 0;
   sw->ops->view                            = DMView_Swarm;
   sw->ops->load                            = NULL;
-  sw->ops->setfromoptions                  = NULL;
+  sw->ops->setfromoptions                  = DMSetFromOptions_Swarm;
   sw->ops->clone                           = DMClone_Swarm;
   sw->ops->setup                           = DMSetup_Swarm;
   sw->ops->createlocalsection              = NULL;
@@ -1874,6 +1892,8 @@ PETSC_EXTERN PetscErrorCode DMCreate_Swarm(DM dm)
   swarm->dmcell = NULL;
   swarm->collect_view_active = PETSC_FALSE;
   swarm->collect_view_reset_nlocal = -1;
+  swarm->sort_reorder_freq = 0;
+  swarm->sort_reorder_count = 0;
   ierr = DMInitialize_Swarm(dm);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -4,94 +4,134 @@
 #include <petsc/private/dmswarmimpl.h>    /*I   "petscdmswarm.h"   I*/
 #include "../src/dm/impls/swarm/data_bucket.h"
 #include "../src/dm/impls/swarm/data_ex.h"
+#include <petsc/private/hashseti.h>
+#include <petsc/private/hashmapi.h>
 
 /*
- User loads desired location (MPI rank) into field DMSwarm_rank
+ Pack the points list[0], ..., list[n-1] into the exchanger, where point list[i] goes to rank dest[i].
+ The points are grouped by destination with a counting sort, so each neighbour receives them in list order,
+ and all fields are copied into a single packed buffer one field at a time.
 */
-PetscErrorCode DMSwarmMigrate_Push_Basic(DM dm,PetscBool remove_sent_points)
+static PetscErrorCode DMSwarmMigrate_PackPoints_Private(DMSwarmDataBucket db,DMSwarmDataEx de,PetscInt n,const PetscInt list[],const PetscMPIInt dest[])
 {
-  DM_Swarm       *swarm = (DM_Swarm*)dm->data;
-  PetscErrorCode ierr;
-  DMSwarmDataEx  de;
-  PetscInt       p,npoints,*rankval,n_points_recv;
-  PetscMPIInt    rank,nrank;
-  void           *point_buffer,*recv_points;
+  PetscHSetI     ranks;
+  PetscHMapI     rankToLocal;
+  PetscInt       *elems,*cnt,*off,*order,nranks,i,l;
+  PetscMPIInt    nneigh,*neigh;
+  void           *buffer;
   size_t         sizeof_dmswarm_point;
+  PetscErrorCode ierr;
 
   PetscFunctionBegin;
-  ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)dm),&rank);CHKERRMPI(ierr);
-
-  ierr = DMSwarmDataBucketGetSizes(swarm->db,&npoints,NULL,NULL);CHKERRQ(ierr);
-  ierr = DMSwarmGetField(dm,DMSwarmField_rank,NULL,NULL,(void**)&rankval);CHKERRQ(ierr);
-  ierr = DMSwarmDataExCreate(PetscObjectComm((PetscObject)dm),0, &de);CHKERRQ(ierr);
+  ierr = PetscHSetICreate(&ranks);CHKERRQ(ierr);
+  for (i = 0; i < n; ++i) {ierr = PetscHSetIAdd(ranks,dest[i]);CHKERRQ(ierr);}
+  ierr = PetscHSetIGetSize(ranks,&nranks);CHKERRQ(ierr);
+  ierr = PetscMalloc1(nranks,&elems);CHKERRQ(ierr);
+  l = 0;
+  ierr = PetscHSetIGetElems(ranks,&l,elems);CHKERRQ(ierr);
+  ierr = PetscHSetIDestroy(&ranks);CHKERRQ(ierr);
   ierr = DMSwarmDataExTopologyInitialize(de);CHKERRQ(ierr);
-  for (p = 0; p < npoints; ++p) {
-    nrank = rankval[p];
-    if (nrank != rank) {
-      ierr = DMSwarmDataExTopologyAddNeighbour(de,nrank);CHKERRQ(ierr);
-    }
-  }
+  for (i = 0; i < nranks; ++i) {ierr = DMSwarmDataExTopologyAddNeighbour(de,(PetscMPIInt)elems[i]);CHKERRQ(ierr);}
   ierr = DMSwarmDataExTopologyFinalize(de);CHKERRQ(ierr);
+  ierr = PetscFree(elems);CHKERRQ(ierr);
+  /* count and order the points by destination */
+  ierr = DMSwarmDataExTopologyGetNeighbours(de,&nneigh,&neigh);CHKERRQ(ierr);
+  ierr = PetscHMapICreate(&rankToLocal);CHKERRQ(ierr);
+  for (i = 0; i < nneigh; ++i) {ierr = PetscHMapISet(rankToLocal,neigh[i],i);CHKERRQ(ierr);}
+  ierr = PetscCalloc3(nneigh+1,&cnt,nneigh+1,&off,n,&order);CHKERRQ(ierr);
+  for (i = 0; i < n; ++i) {
+    ierr = PetscHMapIGet(rankToLocal,dest[i],&l);CHKERRQ(ierr);
+    ++cnt[l];
+  }
+  for (i = 0; i < nneigh; ++i) off[i+1] = off[i] + cnt[i];
+  for (i = 0; i < n; ++i) {
+    ierr = PetscHMapIGet(rankToLocal,dest[i],&l);CHKERRQ(ierr);
+    order[off[l]++] = list[i];
+  }
+  ierr = PetscHMapIDestroy(&rankToLocal);CHKERRQ(ierr);
   ierr = DMSwarmDataExInitializeSendCount(de);CHKERRQ(ierr);
-  for (p=0; p<npoints; p++) {
-    nrank = rankval[p];
-    if (nrank != rank) {
-      ierr = DMSwarmDataExAddToSendCount(de,nrank,1);CHKERRQ(ierr);
-    }
-  }
+  for (i = 0; i < nneigh; ++i) {ierr = DMSwarmDataExAddToSendCount(de,neigh[i],cnt[i]);CHKERRQ(ierr);}
   ierr = DMSwarmDataExFinalizeSendCount(de);CHKERRQ(ierr);
-  ierr = DMSwarmDataBucketCreatePackedArray(swarm->db,&sizeof_dmswarm_point,&point_buffer);CHKERRQ(ierr);
+  /* pack everything at once, then hand each neighbour its contiguous piece */
+  ierr = DMSwarmDataBucketCreatePackedArray(db,&sizeof_dmswarm_point,NULL);CHKERRQ(ierr);
+  ierr = PetscMalloc(sizeof_dmswarm_point*(n+1),&buffer);CHKERRQ(ierr);
+  ierr = DMSwarmDataBucketFillPackedArrays(db,n,order,buffer);CHKERRQ(ierr);
   ierr = DMSwarmDataExPackInitialize(de,sizeof_dmswarm_point);CHKERRQ(ierr);
-  for (p=0; p<npoints; p++) {
-    nrank = rankval[p];
-    if (nrank != rank) {
-      /* copy point into buffer */
-      ierr = DMSwarmDataBucketFillPackedArray(swarm->db,p,point_buffer);CHKERRQ(ierr);
-      /* insert point buffer into DMSwarmDataExchanger */
-      ierr = DMSwarmDataExPackData(de,nrank,1,point_buffer);CHKERRQ(ierr);
-    }
+  for (i = 0; i < nneigh; ++i) {
+    if (cnt[i]) {ierr = DMSwarmDataExPackData(de,neigh[i],cnt[i],(char*)buffer + (off[i]-cnt[i])*sizeof_dmswarm_point);CHKERRQ(ierr);}
   }
   ierr = DMSwarmDataExPackFinalize(de);CHKERRQ(ierr);
-  ierr = DMSwarmRestoreField(dm,DMSwarmField_rank,NULL,NULL,(void**)&rankval);CHKERRQ(ierr);
+  ierr = PetscFree(buffer);CHKERRQ(ierr);
+  ierr = PetscFree3(cnt,off,order);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
 
-  if (remove_sent_points) {
-    DMSwarmDataField gfield;
+/* Append the points received by the exchanger to the end of the bucket */
+static PetscErrorCode DMSwarmMigrate_UnpackPoints_Private(DMSwarmDataBucket db,DMSwarmDataEx de)
+{
+  PetscInt       npoints,n_points_recv;
+  void           *recv_points;
+  PetscErrorCode ierr;
 
-    ierr = DMSwarmDataBucketGetDMSwarmDataFieldByName(swarm->db,DMSwarmField_rank,&gfield);CHKERRQ(ierr);
-    ierr = DMSwarmDataFieldGetAccess(gfield);CHKERRQ(ierr);
-    ierr = DMSwarmDataFieldGetEntries(gfield,(void**)&rankval);CHKERRQ(ierr);
+  PetscFunctionBegin;
+  ierr = DMSwarmDataExGetRecvData(de,&n_points_recv,&recv_points);CHKERRQ(ierr);
+  ierr = DMSwarmDataBucketGetSizes(db,&npoints,NULL,NULL);CHKERRQ(ierr);
+  ierr = DMSwarmDataBucketSetSizes(db,npoints + n_points_recv,DMSWARM_DATA_BUCKET_BUFFER_DEFAULT);CHKERRQ(ierr);
+  ierr = DMSwarmDataBucketInsertPackedArrays(db,npoints,n_points_recv,recv_points);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
 
-    /* remove points which left processor */
-    ierr = DMSwarmDataBucketGetSizes(swarm->db,&npoints,NULL,NULL);CHKERRQ(ierr);
-    for (p=0; p<npoints; p++) {
-      nrank = rankval[p];
-      if (nrank != rank) {
-        /* kill point */
-        ierr = DMSwarmDataFieldRestoreAccess(gfield);CHKERRQ(ierr);
+/* Remove the points p >= start whose DMSwarm_rank entry satisfies rankval[p] == value (or != value if differ is set) */
+static PetscErrorCode DMSwarmMigrate_RemovePoints_Private(DM dm,PetscInt start,PetscInt value,PetscBool differ)
+{
+  DM_Swarm       *swarm = (DM_Swarm*)dm->data;
+  PetscInt       p,npoints,*rankval;
+  PetscBool      *remove;
+  PetscErrorCode ierr;
 
-        ierr = DMSwarmDataBucketRemovePointAtIndex(swarm->db,p);CHKERRQ(ierr);
+  PetscFunctionBegin;
+  ierr = DMSwarmDataBucketGetSizes(swarm->db,&npoints,NULL,NULL);CHKERRQ(ierr);
+  ierr = PetscMalloc1(npoints,&remove);CHKERRQ(ierr);
+  ierr = DMSwarmGetField(dm,DMSwarmField_rank,NULL,NULL,(void**)&rankval);CHKERRQ(ierr);
+  for (p = 0; p < npoints; ++p) remove[p] = (PetscBool) (differ ? rankval[p] != value : rankval[p] == value);
+  ierr = DMSwarmRestoreField(dm,DMSwarmField_rank,NULL,NULL,(void**)&rankval);CHKERRQ(ierr);
+  ierr = DMSwarmDataBucketRemovePoints(swarm->db,start,remove);CHKERRQ(ierr);
+  ierr = PetscFree(remove);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
 
-        ierr = DMSwarmDataBucketGetSizes(swarm->db,&npoints,NULL,NULL);CHKERRQ(ierr); /* you need to update npoints as the list size decreases! */
-        ierr = DMSwarmDataFieldGetAccess(gfield);CHKERRQ(ierr);
-        ierr = DMSwarmDataFieldGetEntries(gfield,(void**)&rankval);CHKERRQ(ierr);
-        p--; /* check replacement point */
-      }
-    }
-    ierr = DMSwarmDataFieldRestoreEntries(gfield,(void**)&rankval);CHKERRQ(ierr);
-    ierr = DMSwarmDataFieldRestoreAccess(gfield);CHKERRQ(ierr);
+/*
+ User loads desired location (MPI rank) into field DMSwarm_rank
+*/
+PetscErrorCode DMSwarmMigrate_Push_Basic(DM dm,PetscBool remove_sent_points)
+{
+  DM_Swarm       *swarm = (DM_Swarm*)dm->data;
+  PetscErrorCode ierr;
+  DMSwarmDataEx  de;
+  PetscInt       p,npoints,nsend = 0,*rankval,*list;
+  PetscMPIInt    rank,*dest;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)dm),&rank);CHKERRMPI(ierr);
+
+  ierr = DMSwarmDataBucketGetSizes(swarm->db,&npoints,NULL,NULL);CHKERRQ(ierr);
+  ierr = DMSwarmGetField(dm,DMSwarmField_rank,NULL,NULL,(void**)&rankval);CHKERRQ(ierr);
+  for (p = 0; p < npoints; ++p) if (rankval[p] != rank) ++nsend;
+  ierr = PetscMalloc2(nsend,&list,nsend,&dest);CHKERRQ(ierr);
+  for (p = 0, nsend = 0; p < npoints; ++p) {
+    if (rankval[p] != rank) {list[nsend] = p; dest[nsend++] = (PetscMPIInt)rankval[p];}
   }
+  ierr = DMSwarmRestoreField(dm,DMSwarmField_rank,NULL,NULL,(void**)&rankval);CHKERRQ(ierr);
+  ierr = DMSwarmDataExCreate(PetscObjectComm((PetscObject)dm),0, &de);CHKERRQ(ierr);
+  ierr = DMSwarmMigrate_PackPoints_Private(swarm->db,de,nsend,list,dest);CHKERRQ(ierr);
+  ierr = PetscFree2(list,dest);CHKERRQ(ierr);
+
+  /* remove points which left processor */
+  if (remove_sent_points) {ierr = DMSwarmMigrate_RemovePoints_Private(dm,0,rank,PETSC_TRUE);CHKERRQ(ierr);}
   ierr = DMSwarmDataExBegin(de);CHKERRQ(ierr);
   ierr = DMSwarmDataExEnd(de);CHKERRQ(ierr);
-  ierr = DMSwarmDataExGetRecvData(de,&n_points_recv,(void**)&recv_points);CHKERRQ(ierr);
-  ierr = DMSwarmDataBucketGetSizes(swarm->db,&npoints,NULL,NULL);CHKERRQ(ierr);
-  ierr = DMSwarmDataBucketSetSizes(swarm->db,npoints + n_points_recv,DMSWARM_DATA_BUCKET_BUFFER_DEFAULT);CHKERRQ(ierr);
-  for (p=0; p<n_points_recv; p++) {
-    void *data_p = (void*)( (char*)recv_points + p*sizeof_dmswarm_point);
-
-    ierr = DMSwarmDataBucketInsertPackedArray(swarm->db,npoints+p,data_p);CHKERRQ(ierr);
-  }
+  ierr = DMSwarmMigrate_UnpackPoints_Private(swarm->db,de);CHKERRQ(ierr);
   ierr = DMSwarmDataExView(de);CHKERRQ(ierr);
-  ierr = DMSwarmDataBucketDestroyPackedArray(swarm->db,&point_buffer);CHKERRQ(ierr);
   ierr = DMSwarmDataExDestroy(de);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -101,10 +141,10 @@ PetscErrorCode DMSwarmMigrate_DMNeighborScatter(DM dm,DM dmcell,PetscBool remove
   DM_Swarm          *swarm = (DM_Swarm*)dm->data;
   PetscErrorCode    ierr;
   DMSwarmDataEx     de;
-  PetscInt          r,p,npoints,*rankval,n_points_recv;
+  PetscInt          r,p,npoints,nsend = 0,*rankval,*list;
   PetscMPIInt       rank,_rank;
   const PetscMPIInt *neighbourranks;
-  void              *point_buffer,*recv_points;
+  void              *point_buffer;
   size_t            sizeof_dmswarm_point;
   PetscInt          nneighbors;
   PetscMPIInt       mynneigh,*myneigh;
@@ -113,6 +153,10 @@ PetscErrorCode DMSwarmMigrate_DMNeighborScatter(DM dm,DM dmcell,PetscBool remove
   ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)dm),&rank);CHKERRMPI(ierr);
   ierr = DMSwarmDataBucketGetSizes(swarm->db,&npoints,NULL,NULL);CHKERRQ(ierr);
   ierr = DMSwarmGetField(dm,DMSwarmField_rank,NULL,NULL,(void**)&rankval);CHKERRQ(ierr);
+  for (p=0; p<npoints; p++) if (rankval[p] == DMLOCATEPOINT_POINT_NOT_FOUND) nsend++;
+  ierr = PetscMalloc1(nsend,&list);CHKERRQ(ierr);
+  for (p=0, nsend=0; p<npoints; p++) if (rankval[p] == DMLOCATEPOINT_POINT_NOT_FOUND) list[nsend++] = p;
+  ierr = DMSwarmRestoreField(dm,DMSwarmField_rank,NULL,NULL,(void**)&rankval);CHKERRQ(ierr);
   ierr = DMSwarmDataExCreate(PetscObjectComm((PetscObject)dm),0,&de);CHKERRQ(ierr);
   ierr = DMGetNeighbors(dmcell,&nneighbors,&neighbourranks);CHKERRQ(ierr);
   ierr = DMSwarmDataExTopologyInitialize(de);CHKERRQ(ierr);
@@ -124,60 +168,28 @@ PetscErrorCode DMSwarmMigrate_DMNeighborScatter(DM dm,DM dmcell,PetscBool remove
   }
   ierr = DMSwarmDataExTopologyFinalize(de);CHKERRQ(ierr);
   ierr = DMSwarmDataExTopologyGetNeighbours(de,&mynneigh,&myneigh);CHKERRQ(ierr);
+  /* every unlocated point is sent to all neighbours, so it is packed once and the same buffer is sent to each */
   ierr = DMSwarmDataExInitializeSendCount(de);CHKERRQ(ierr);
-  for (p=0; p<npoints; p++) {
-    if (rankval[p] == DMLOCATEPOINT_POINT_NOT_FOUND) {
-      for (r=0; r<mynneigh; r++) {
-        _rank = myneigh[r];
-        ierr = DMSwarmDataExAddToSendCount(de,_rank,1);CHKERRQ(ierr);
-      }
-    }
+  for (r=0; r<mynneigh; r++) {
+    ierr = DMSwarmDataExAddToSendCount(de,myneigh[r],nsend);CHKERRQ(ierr);
   }
   ierr = DMSwarmDataExFinalizeSendCount(de);CHKERRQ(ierr);
-  ierr = DMSwarmDataBucketCreatePackedArray(swarm->db,&sizeof_dmswarm_point,&point_buffer);CHKERRQ(ierr);
+  ierr = DMSwarmDataBucketCreatePackedArray(swarm->db,&sizeof_dmswarm_point,NULL);CHKERRQ(ierr);
+  ierr = PetscMalloc(sizeof_dmswarm_point*(nsend+1),&point_buffer);CHKERRQ(ierr);
+  ierr = DMSwarmDataBucketFillPackedArrays(swarm->db,nsend,list,point_buffer);CHKERRQ(ierr);
+  ierr = PetscFree(list);CHKERRQ(ierr);
   ierr = DMSwarmDataExPackInitialize(de,sizeof_dmswarm_point);CHKERRQ(ierr);
-  for (p=0; p<npoints; p++) {
-    if (rankval[p] == DMLOCATEPOINT_POINT_NOT_FOUND) {
-      for (r=0; r<mynneigh; r++) {
-        _rank = myneigh[r];
-        /* copy point into buffer */
-        ierr = DMSwarmDataBucketFillPackedArray(swarm->db,p,point_buffer);CHKERRQ(ierr);
-        /* insert point buffer into DMSwarmDataExchanger */
-        ierr = DMSwarmDataExPackData(de,_rank,1,point_buffer);CHKERRQ(ierr);
-      }
-    }
+  for (r=0; r<mynneigh; r++) {
+    if (nsend) {ierr = DMSwarmDataExPackData(de,myneigh[r],nsend,point_buffer);CHKERRQ(ierr);}
   }
   ierr = DMSwarmDataExPackFinalize(de);CHKERRQ(ierr);
-  ierr = DMSwarmRestoreField(dm,DMSwarmField_rank,NULL,NULL,(void**)&rankval);CHKERRQ(ierr);
-  if (remove_sent_points) {
-    DMSwarmDataField PField;
-
-    ierr = DMSwarmDataBucketGetDMSwarmDataFieldByName(swarm->db,DMSwarmField_rank,&PField);CHKERRQ(ierr);
-    ierr = DMSwarmDataFieldGetEntries(PField,(void**)&rankval);CHKERRQ(ierr);
-    /* remove points which left processor */
-    ierr = DMSwarmDataBucketGetSizes(swarm->db,&npoints,NULL,NULL);CHKERRQ(ierr);
-    for (p=0; p<npoints; p++) {
-      if (rankval[p] == DMLOCATEPOINT_POINT_NOT_FOUND) {
-        /* kill point */
-        ierr = DMSwarmDataBucketRemovePointAtIndex(swarm->db,p);CHKERRQ(ierr);
-        ierr = DMSwarmDataBucketGetSizes(swarm->db,&npoints,NULL,NULL);CHKERRQ(ierr); /* you need to update npoints as the list size decreases! */
-        ierr = DMSwarmDataFieldGetEntries(PField,(void**)&rankval);CHKERRQ(ierr); /* update date point increase realloc performed */
-        p--; /* check replacement point */
-      }
-    }
-  }
+  ierr = PetscFree(point_buffer);CHKERRQ(ierr);
+  /* remove points which left processor */
+  if (remove_sent_points) {ierr = DMSwarmMigrate_RemovePoints_Private(dm,0,DMLOCATEPOINT_POINT_NOT_FOUND,PETSC_FALSE);CHKERRQ(ierr);}
   ierr = DMSwarmDataBucketGetSizes(swarm->db,npoints_prior_migration,NULL,NULL);CHKERRQ(ierr);
   ierr = DMSwarmDataExBegin(de);CHKERRQ(ierr);
   ierr = DMSwarmDataExEnd(de);CHKERRQ(ierr);
-  ierr = DMSwarmDataExGetRecvData(de,&n_points_recv,(void**)&recv_points);CHKERRQ(ierr);
-  ierr = DMSwarmDataBucketGetSizes(swarm->db,&npoints,NULL,NULL);CHKERRQ(ierr);
-  ierr = DMSwarmDataBucketSetSizes(swarm->db,npoints + n_points_recv,DMSWARM_DATA_BUCKET_BUFFER_DEFAULT);CHKERRQ(ierr);
-  for (p=0; p<n_points_recv; p++) {
-    void *data_p = (void*)( (char*)recv_points + p*sizeof_dmswarm_point);
-
-    ierr = DMSwarmDataBucketInsertPackedArray(swarm->db,npoints+p,data_p);CHKERRQ(ierr);
-  }
-  ierr = DMSwarmDataBucketDestroyPackedArray(swarm->db,&point_buffer);CHKERRQ(ierr);
+  ierr = DMSwarmMigrate_UnpackPoints_Private(swarm->db,de);CHKERRQ(ierr);
   ierr = DMSwarmDataExDestroy(de);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -248,23 +260,8 @@ PetscErrorCode DMSwarmMigrate_CellDMScatter(DM dm,PetscBool remove_sent_points)
   if (size > 1) {
     ierr = DMSwarmMigrate_DMNeighborScatter(dm,dmcell,remove_sent_points,&npoints_prior_migration);CHKERRQ(ierr);
   } else {
-    DMSwarmDataField PField;
-    PetscInt npoints_curr;
-
-    /* remove points which the domain */
-    ierr = DMSwarmDataBucketGetDMSwarmDataFieldByName(swarm->db,DMSwarmField_rank,&PField);CHKERRQ(ierr);
-    ierr = DMSwarmDataFieldGetEntries(PField,(void**)&rankval);CHKERRQ(ierr);
-
-    ierr = DMSwarmDataBucketGetSizes(swarm->db,&npoints_curr,NULL,NULL);CHKERRQ(ierr);
-    for (p=0; p<npoints_curr; p++) {
-      if (rankval[p] == DMLOCATEPOINT_POINT_NOT_FOUND) {
-        /* kill point */
-        ierr = DMSwarmDataBucketRemovePointAtIndex(swarm->db,p);CHKERRQ(ierr);
-        ierr = DMSwarmDataBucketGetSizes(swarm->db,&npoints_curr,NULL,NULL);CHKERRQ(ierr); /* you need to update npoints as the list size decreases! */
-        ierr = DMSwarmDataFieldGetEntries(PField,(void**)&rankval);CHKERRQ(ierr); /* update date point increase realloc performed */
-        p--; /* check replacement point */
-      }
-    }
+    /* remove points which left the domain */
+    ierr = DMSwarmMigrate_RemovePoints_Private(dm,0,DMLOCATEPOINT_POINT_NOT_FOUND,PETSC_FALSE);CHKERRQ(ierr);
     ierr = DMSwarmGetSize(dm,&npoints_prior_migration);CHKERRQ(ierr);
 
   }
@@ -313,7 +310,6 @@ PetscErrorCode DMSwarmMigrate_CellDMScatter(DM dm,PetscBool remove_sent_points)
   { /* this performs two point locations: (i) on the initial points set prior to communication; and (ii) on the new (received) points */
     PetscScalar      *LA_coor;
     PetscInt         npoints_from_neighbours,bs;
-    DMSwarmDataField PField;
 
     npoints_from_neighbours = npoints2 - npoints_prior_migration;
 
@@ -334,19 +330,7 @@ PetscErrorCode DMSwarmMigrate_CellDMScatter(DM dm,PetscBool remove_sent_points)
     ierr = PetscSFDestroy(&sfcell);CHKERRQ(ierr);
 
     /* remove points which left processor */
-    ierr = DMSwarmDataBucketGetDMSwarmDataFieldByName(swarm->db,DMSwarmField_rank,&PField);CHKERRQ(ierr);
-    ierr = DMSwarmDataFieldGetEntries(PField,(void**)&rankval);CHKERRQ(ierr);
-
-    ierr = DMSwarmDataBucketGetSizes(swarm->db,&npoints2,NULL,NULL);CHKERRQ(ierr);
-    for (p=npoints_prior_migration; p<npoints2; p++) {
-      if (rankval[p] == DMLOCATEPOINT_POINT_NOT_FOUND) {
-        /* kill point */
-        ierr = DMSwarmDataBucketRemovePointAtIndex(swarm->db,p);CHKERRQ(ierr);
-        ierr = DMSwarmDataBucketGetSizes(swarm->db,&npoints2,NULL,NULL);CHKERRQ(ierr); /* you need to update npoints as the list size decreases! */
-        ierr = DMSwarmDataFieldGetEntries(PField,(void**)&rankval);CHKERRQ(ierr); /* update date point increase realloc performed */
-        p--; /* check replacement point */
-      }
-    }
+    ierr = DMSwarmMigrate_RemovePoints_Private(dm,npoints_prior_migration,DMLOCATEPOINT_POINT_NOT_FOUND,PETSC_FALSE);CHKERRQ(ierr);
   }
 
   {
@@ -384,9 +368,9 @@ PetscErrorCode DMSwarmMigrate_GlobalToLocal_Basic(DM dm,PetscInt *globalsize)
   DM_Swarm       *swarm = (DM_Swarm*)dm->data;
   PetscErrorCode ierr;
   DMSwarmDataEx  de;
-  PetscInt       p,npoints,*rankval,n_points_recv;
+  PetscInt       p,npoints,*rankval;
   PetscMPIInt    rank,nrank,negrank;
-  void           *point_buffer,*recv_points;
+  void           *point_buffer;
   size_t         sizeof_dmswarm_point;
 
   PetscFunctionBegin;
@@ -431,14 +415,7 @@ PetscErrorCode DMSwarmMigrate_GlobalToLocal_Basic(DM dm,PetscInt *globalsize)
   ierr = DMSwarmRestoreField(dm,DMSwarmField_rank,NULL,NULL,(void**)&rankval);CHKERRQ(ierr);
   ierr = DMSwarmDataExBegin(de);CHKERRQ(ierr);
   ierr = DMSwarmDataExEnd(de);CHKERRQ(ierr);
-  ierr = DMSwarmDataExGetRecvData(de,&n_points_recv,(void**)&recv_points);CHKERRQ(ierr);
-  ierr = DMSwarmDataBucketGetSizes(swarm->db,&npoints,NULL,NULL);CHKERRQ(ierr);
-  ierr = DMSwarmDataBucketSetSizes(swarm->db,npoints + n_points_recv,DMSWARM_DATA_BUCKET_BUFFER_DEFAULT);CHKERRQ(ierr);
-  for (p=0; p<n_points_recv; p++) {
-    void *data_p = (void*)( (char*)recv_points + p*sizeof_dmswarm_point);
-
-    ierr = DMSwarmDataBucketInsertPackedArray(swarm->db,npoints+p,data_p);CHKERRQ(ierr);
-  }
+  ierr = DMSwarmMigrate_UnpackPoints_Private(swarm->db,de);CHKERRQ(ierr);
   ierr = DMSwarmDataExView(de);CHKERRQ(ierr);
   ierr = DMSwarmDataBucketDestroyPackedArray(swarm->db,&point_buffer);CHKERRQ(ierr);
   ierr = DMSwarmDataExDestroy(de);CHKERRQ(ierr);
@@ -455,9 +432,9 @@ PETSC_EXTERN PetscErrorCode DMSwarmCollect_DMDABoundingBox(DM dm,PetscInt *globa
   DM_Swarm *        swarm = (DM_Swarm*)dm->data;
   PetscErrorCode    ierr;
   DMSwarmDataEx     de;
-  PetscInt          p,pk,npoints,*rankval,n_points_recv,n_bbox_recv,dim,neighbour_cells;
+  PetscInt          p,pk,npoints,*rankval,n_bbox_recv,dim,neighbour_cells;
   PetscMPIInt       rank,nrank;
-  void              *point_buffer,*recv_points;
+  void              *point_buffer;
   size_t            sizeof_dmswarm_point,sizeof_bbox_ctx;
   PetscBool         isdmda;
   CollectBBox       *bbox,*recv_bbox;
@@ -585,14 +562,7 @@ PETSC_EXTERN PetscErrorCode DMSwarmCollect_DMDABoundingBox(DM dm,PetscInt *globa
   ierr = DMSwarmRestoreField(dm,DMSwarmField_rank,NULL,NULL,(void**)&rankval);CHKERRQ(ierr);
   ierr = DMSwarmDataExBegin(de);CHKERRQ(ierr);
   ierr = DMSwarmDataExEnd(de);CHKERRQ(ierr);
-  ierr = DMSwarmDataExGetRecvData(de,&n_points_recv,(void**)&recv_points);CHKERRQ(ierr);
-  ierr = DMSwarmDataBucketGetSizes(swarm->db,&npoints,NULL,NULL);CHKERRQ(ierr);
-  ierr = DMSwarmDataBucketSetSizes(swarm->db,npoints + n_points_recv,DMSWARM_DATA_BUCKET_BUFFER_DEFAULT);CHKERRQ(ierr);
-  for (p=0; p<n_points_recv; p++) {
-    void *data_p = (void*)( (char*)recv_points + p*sizeof_dmswarm_point);
-
-    ierr = DMSwarmDataBucketInsertPackedArray(swarm->db,npoints+p,data_p);CHKERRQ(ierr);
-  }
+  ierr = DMSwarmMigrate_UnpackPoints_Private(swarm->db,de);CHKERRQ(ierr);
   ierr = DMSwarmDataBucketDestroyPackedArray(swarm->db,&point_buffer);CHKERRQ(ierr);
   PetscFree(bbox);
   ierr = DMSwarmDataExView(de);CHKERRQ(ierr);
@@ -614,9 +584,9 @@ PETSC_EXTERN PetscErrorCode DMSwarmCollect_General(DM dm,PetscErrorCode (*collec
   DM_Swarm       *swarm = (DM_Swarm*)dm->data;
   PetscErrorCode ierr;
   DMSwarmDataEx         de;
-  PetscInt       p,r,npoints,n_points_recv;
+  PetscInt       p,r,npoints;
   PetscMPIInt    size,rank;
-  void           *point_buffer,*recv_points;
+  void           *point_buffer;
   void           *ctxlist;
   PetscInt       *n2collect,**collectlist;
   size_t         sizeof_dmswarm_point;
@@ -677,14 +647,7 @@ PETSC_EXTERN PetscErrorCode DMSwarmCollect_General(DM dm,PetscErrorCode (*collec
   ierr = DMSwarmDataExBegin(de);CHKERRQ(ierr);
   ierr = DMSwarmDataExEnd(de);CHKERRQ(ierr);
   /* Collect data in DMSwarm container */
-  ierr = DMSwarmDataExGetRecvData(de,&n_points_recv,(void**)&recv_points);CHKERRQ(ierr);
-  ierr = DMSwarmDataBucketGetSizes(swarm->db,&npoints,NULL,NULL);CHKERRQ(ierr);
-  ierr = DMSwarmDataBucketSetSizes(swarm->db,npoints + n_points_recv,DMSWARM_DATA_BUCKET_BUFFER_DEFAULT);CHKERRQ(ierr);
-  for (p=0; p<n_points_recv; p++) {
-    void *data_p = (void*)( (char*)recv_points + p*sizeof_dmswarm_point);
-
-    ierr = DMSwarmDataBucketInsertPackedArray(swarm->db,npoints+p,data_p);CHKERRQ(ierr);
-  }
+  ierr = DMSwarmMigrate_UnpackPoints_Private(swarm->db,de);CHKERRQ(ierr);
   /* Release memory */
   for (r=0; r<size; r++) {
     if (collectlist[r]) PetscFree(collectlist[r]);
@@ -533,6 +533,153 @@ PETSC_EXTERN PetscErrorCode DMSwarmProjectFields(DM dm,PetscInt nfields,const ch
   PetscFunctionReturn(0);
 }
 
+/* Deposition and interpolation API */
+extern PetscErrorCode private_DMSwarmDepositInterpolate_DA(DM swarm,DM celldm,DMSwarmDepositType type,PetscBool deposit,PetscInt bs,PetscReal field[],PetscScalar xl[]);
+extern PetscErrorCode private_DMSwarmDepositInterpolate_PLEX(DM swarm,DM celldm,DMSwarmDepositType type,PetscBool deposit,PetscInt bs,PetscReal field[],PetscScalar xl[]);
+
+static PetscErrorCode private_DMSwarmDepositInterpolate(DM dm,DMSwarmDepositType type,PetscBool deposit,PetscInt bs,PetscReal field[],PetscScalar xl[])
+{
+  DM             celldm;
+  PetscBool      isDA,isPLEX,isvalid;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMSwarmGetCellDM(dm,&celldm);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)celldm,DMDA,&isDA);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)celldm,DMPLEX,&isPLEX);CHKERRQ(ierr);
+  /* the kernels traverse the points cell by cell; keep any sort access held by the caller */
+  ierr = DMSwarmSortGetIsValid(dm,&isvalid);CHKERRQ(ierr);
+  if (!isvalid) {ierr = DMSwarmSortGetAccess(dm);CHKERRQ(ierr);}
+  if (isDA) {
+    ierr = private_DMSwarmDepositInterpolate_DA(dm,celldm,type,deposit,bs,field,xl);CHKERRQ(ierr);
+  } else if (isPLEX) {
+    ierr = private_DMSwarmDepositInterpolate_PLEX(dm,celldm,type,deposit,bs,field,xl);CHKERRQ(ierr);
+  } else SETERRQ(PetscObjectComm((PetscObject)dm),PETSC_ERR_SUP,"Only supported for cell DMs of type DMDA and DMPLEX");
+  if (!isvalid) {ierr = DMSwarmSortRestoreAccess(dm);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   DMSwarmDepositField - Deposits a swarm field onto the nodes of the cell DM
+
+   Collective on dm
+
+   Input parameters:
++  dm - the DMSwarm
+.  fieldname - the textual name of the swarm field to deposit
+-  type - the shape function used for the deposition, see DMSwarmDepositType
+
+   Output parameter:
+.  x - a global vector of the cell DM, with block size equal to the block size of the field
+
+   Notes:
+   The deposition computes
+     x_i = \sum_{p} W_i(x_p) phi_p
+   where W_i is the shape function of node i and phi_p is the swarm field at point p. Since the shape functions form a
+   partition of unity, the sum of x equals the sum of the field over all points. Contrary to DMSwarmProjectFields(),
+   no mass matrix is assembled and the result is not normalized.
+
+   The points are processed cell by cell using the DMSwarm sort context. When PETSc is configured with OpenMP,
+   cells are processed concurrently: on a DMDA the cells are colored so that cells of the same color never update the
+   same node, on a DMPLEX each thread accumulates into a private copy of the local vector. Reordering the points with
+   DMSwarmSortReorder() makes the traversal sequential in memory.
+
+   Only swarm fields registered with data type = PETSC_REAL can be deposited. The cell DM must have one node per vertex:
+   a DMDA with dof equal to the block size of the field, or a DMPLEX with a local section which places bs dofs on each vertex.
+
+   Level: intermediate
+
+.seealso: DMSwarmInterpolateField(), DMSwarmDepositType, DMSwarmProjectFields(), DMSwarmSortReorder()
+@*/
+PetscErrorCode DMSwarmDepositField(DM dm,const char fieldname[],DMSwarmDepositType type,Vec x)
+{
+  DM             celldm;
+  Vec            xl;
+  PetscScalar    *_xl;
+  PetscReal      *field;
+  PetscInt       bs;
+  PetscDataType  ftype;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm,DM_CLASSID,1);
+  PetscValidCharPointer(fieldname,2);
+  PetscValidHeaderSpecific(x,VEC_CLASSID,4);
+  DMSWARMPICVALID(dm);
+  ierr = DMSwarmGetCellDM(dm,&celldm);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(celldm,&xl);CHKERRQ(ierr);
+  ierr = VecZeroEntries(xl);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(DMSWARM_Deposit,0,0,0,0);CHKERRQ(ierr);
+  ierr = DMSwarmGetField(dm,fieldname,&bs,&ftype,(void**)&field);CHKERRQ(ierr);
+  if (ftype != PETSC_REAL) SETERRQ(PetscObjectComm((PetscObject)dm),PETSC_ERR_SUP,"Deposition only valid for fields using a data type = PETSC_REAL");
+  ierr = VecGetArray(xl,&_xl);CHKERRQ(ierr);
+  ierr = private_DMSwarmDepositInterpolate(dm,type,PETSC_TRUE,bs,field,_xl);CHKERRQ(ierr);
+  ierr = VecRestoreArray(xl,&_xl);CHKERRQ(ierr);
+  ierr = DMSwarmRestoreField(dm,fieldname,&bs,&ftype,(void**)&field);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(DMSWARM_Deposit,0,0,0,0);CHKERRQ(ierr);
+  ierr = VecZeroEntries(x);CHKERRQ(ierr);
+  ierr = DMLocalToGlobalBegin(celldm,xl,ADD_VALUES,x);CHKERRQ(ierr);
+  ierr = DMLocalToGlobalEnd(celldm,xl,ADD_VALUES,x);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(celldm,&xl);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   DMSwarmInterpolateField - Interpolates a field defined on the nodes of the cell DM to the points of a DMSwarm
+
+   Collective on dm
+
+   Input parameters:
++  dm - the DMSwarm
+.  x - a global vector of the cell DM, with block size equal to the block size of the field
+-  type - the shape function used for the interpolation, see DMSwarmDepositType
+
+   Output parameter:
+.  fieldname - the textual name of the swarm field receiving the interpolated values
+
+   Notes:
+   The interpolation computes
+     phi_p = \sum_{i} W_i(x_p) x_i
+   which is the transpose of the operation performed by DMSwarmDepositField() with the same type. Using the same
+   shape function for both operations avoids self-forces in particle-in-cell methods.
+
+   The same restrictions as for DMSwarmDepositField() apply.
+
+   Level: intermediate
+
+.seealso: DMSwarmDepositField(), DMSwarmDepositType
+@*/
+PetscErrorCode DMSwarmInterpolateField(DM dm,Vec x,DMSwarmDepositType type,const char fieldname[])
+{
+  DM             celldm;
+  Vec            xl;
+  PetscScalar    *_xl;
+  PetscReal      *field;
+  PetscInt       bs;
+  PetscDataType  ftype;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm,DM_CLASSID,1);
+  PetscValidHeaderSpecific(x,VEC_CLASSID,2);
+  PetscValidCharPointer(fieldname,4);
+  DMSWARMPICVALID(dm);
+  ierr = DMSwarmGetCellDM(dm,&celldm);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(celldm,&xl);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalBegin(celldm,x,INSERT_VALUES,xl);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalEnd(celldm,x,INSERT_VALUES,xl);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(DMSWARM_Interpolate,0,0,0,0);CHKERRQ(ierr);
+  ierr = DMSwarmGetField(dm,fieldname,&bs,&ftype,(void**)&field);CHKERRQ(ierr);
+  if (ftype != PETSC_REAL) SETERRQ(PetscObjectComm((PetscObject)dm),PETSC_ERR_SUP,"Interpolation only valid for fields using a data type = PETSC_REAL");
+  ierr = VecGetArray(xl,&_xl);CHKERRQ(ierr);
+  ierr = private_DMSwarmDepositInterpolate(dm,type,PETSC_FALSE,bs,field,_xl);CHKERRQ(ierr);
+  ierr = VecRestoreArray(xl,&_xl);CHKERRQ(ierr);
+  ierr = DMSwarmRestoreField(dm,fieldname,&bs,&ftype,(void**)&field);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(DMSWARM_Interpolate,0,0,0,0);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(celldm,&xl);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@C
    DMSwarmCreatePointPerCellCount - Count the number of points within all cells in the cell DM
 
@@ -353,3 +353,166 @@ PetscErrorCode private_DMSwarmProjectFields_DA(DM swarm,DM celldm,PetscInt proje
   }
   PetscFunctionReturn(0);
 }
+
+/* Geometry of the local elements of a DMDA, in the ghosted local numbering of the nodes */
+typedef struct {
+  PetscInt          dim,bs,np;    /* np: number of nodes per direction in the footprint of a point */
+  PetscInt          ne[3];        /* number of local elements in each direction */
+  PetscInt          e0[3];        /* ghosted local index of the first node of element 0 */
+  PetscInt          gn[3];        /* number of ghosted local nodes in each direction */
+  PetscInt          stride[3];
+  DMSwarmDepositType type;
+  const PetscScalar *coor;        /* ghosted local node coordinates */
+  const PetscReal   *pcoor;       /* point coordinates */
+} DMSwarmDeposit_DA;
+
+/* Computes the ghosted local node indices and weights, in each direction, of the nodes receiving contributions from point p in element e */
+PETSC_STATIC_INLINE void DMSwarmDepositWeights_DA(const DMSwarmDeposit_DA *ctx,PetscInt e,PetscInt p,PetscInt idx[][3],PetscReal w[][3])
+{
+  PetscInt d,g[3],ie[3],n0 = 0;
+
+  ie[0] = e % ctx->ne[0];
+  ie[1] = ctx->dim > 1 ? (e / ctx->ne[0]) % ctx->ne[1] : 0;
+  ie[2] = ctx->dim > 2 ? e / (ctx->ne[0]*ctx->ne[1]) : 0;
+  for (d = 0; d < ctx->dim; ++d) {
+    g[d] = ctx->e0[d] + ie[d];
+    n0  += g[d]*ctx->stride[d];
+  }
+  for (d = 0; d < ctx->dim; ++d) {
+    const PetscReal x0 = PetscRealPart(ctx->coor[ctx->dim*n0 + d]);
+    const PetscReal h  = PetscRealPart(ctx->coor[ctx->dim*(n0 + ctx->stride[d]) + d]) - x0;
+    const PetscReal t  = (ctx->pcoor[ctx->dim*p + d] - x0)/h;
+    PetscInt        n,k;
+    PetscReal       s;
+
+    switch (ctx->type) {
+    case DMSWARM_DEPOSIT_NGP:
+      idx[d][0] = g[d] + (t >= 0.5 ? 1 : 0);
+      w[d][0]   = 1.0;
+      break;
+    case DMSWARM_DEPOSIT_CIC:
+      idx[d][0] = g[d];     w[d][0] = 1.0 - t;
+      idx[d][1] = g[d] + 1; w[d][1] = t;
+      break;
+    default:
+      n = g[d] + (t >= 0.5 ? 1 : 0);
+      s = t - (t >= 0.5 ? 1.0 : 0.0);
+      w[d][0] = 0.5*(0.5 - s)*(0.5 - s);
+      w[d][1] = 0.75 - s*s;
+      w[d][2] = 0.5*(0.5 + s)*(0.5 + s);
+      /* nodes beyond a physical boundary are folded onto the boundary node */
+      for (k = 0; k < 3; ++k) idx[d][k] = PetscMin(PetscMax(n - 1 + k,0),ctx->gn[d]-1);
+      break;
+    }
+  }
+  for (d = ctx->dim; d < 3; ++d) {idx[d][0] = 0; w[d][0] = 1.0;}
+}
+
+/* Deposits the points of element e, or interpolates to them */
+PETSC_STATIC_INLINE void DMSwarmDepositCell_DA(const DMSwarmDeposit_DA *ctx,const DMSwarmSort sort,PetscInt e,PetscBool deposit,PetscReal field[],PetscScalar xl[])
+{
+  const PetscInt bs = ctx->bs,npk = ctx->dim > 2 ? ctx->np : 1,npj = ctx->dim > 1 ? ctx->np : 1;
+  PetscInt       idx[3][3],q,i,j,k,c;
+  PetscReal      w[3][3];
+
+  for (q = sort->pcell_offsets[e]; q < sort->pcell_offsets[e+1]; ++q) {
+    const PetscInt p = sort->list[q].point_index;
+    PetscReal      *fp = &field[bs*p];
+
+    DMSwarmDepositWeights_DA(ctx,e,p,idx,w);
+    if (!deposit) for (c = 0; c < bs; ++c) fp[c] = 0.0;
+    for (k = 0; k < npk; ++k) {
+      for (j = 0; j < npj; ++j) {
+        const PetscReal wjk = w[1][j]*w[2][k];
+        const PetscInt  njk = idx[1][j]*ctx->stride[1] + idx[2][k]*ctx->stride[2];
+
+        for (i = 0; i < ctx->np; ++i) {
+          const PetscReal wijk = w[0][i]*wjk;
+          PetscScalar     *xn  = &xl[bs*(idx[0][i] + njk)];
+
+          if (deposit) for (c = 0; c < bs; ++c) xn[c] += wijk*fp[c];
+          else         for (c = 0; c < bs; ++c) fp[c] += wijk*PetscRealPart(xn[c]);
+        }
+      }
+    }
+  }
+}
+
+PetscErrorCode private_DMSwarmDepositInterpolate_DA(DM swarm,DM celldm,DMSwarmDepositType type,PetscBool deposit,PetscInt bs,PetscReal field[],PetscScalar xl[])
+{
+  DMSwarmDeposit_DA ctx;
+  DMSwarmSort       sort = ((DM_Swarm*)swarm->data)->sort_context;
+  DMDAElementType   etype;
+  Vec               coor;
+  PetscInt          xs[3],xe[3],Xs[3],Xe[3],M[3],m[3],dof,sw,d,ncells,npoints;
+  PetscReal         *pcoor;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = DMDAGetElementType(celldm,&etype);CHKERRQ(ierr);
+  if (etype == DMDA_ELEMENT_P1) SETERRQ(PetscObjectComm((PetscObject)swarm),PETSC_ERR_SUP,"Only Q1 DMDA supported");
+  if (type != DMSWARM_DEPOSIT_NGP && type != DMSWARM_DEPOSIT_CIC && type != DMSWARM_DEPOSIT_TSC) SETERRQ1(PetscObjectComm((PetscObject)swarm),PETSC_ERR_SUP,"Deposition type %s not supported on a DMDA, use ngp, cic or tsc",DMSwarmDepositTypes[type]);
+  ierr = DMDAGetInfo(celldm,&ctx.dim,&M[0],&M[1],&M[2],&m[0],&m[1],&m[2],&dof,&sw,NULL,NULL,NULL,NULL);CHKERRQ(ierr);
+  if (ctx.dim < 2) SETERRQ(PetscObjectComm((PetscObject)swarm),PETSC_ERR_SUP,"Only 2D and 3D DMDA supported");
+  if (dof != bs) SETERRQ2(PetscObjectComm((PetscObject)swarm),PETSC_ERR_ARG_INCOMP,"The DMDA has %D dofs per node but the swarm field has block size %D",dof,bs);
+  ierr = DMDAGetCorners(celldm,&xs[0],&xs[1],&xs[2],&xe[0],&xe[1],&xe[2]);CHKERRQ(ierr);
+  ierr = DMDAGetGhostCorners(celldm,&Xs[0],&Xs[1],&Xs[2],&Xe[0],&Xe[1],&Xe[2]);CHKERRQ(ierr);
+  for (d = 0; d < 3; ++d) {
+    /* same local element range as DMDAGetElements() and DMLocatePoints() */
+    xe[d] += xs[d]; Xe[d] += Xs[d]; if (xs[d] != Xs[d]) xs[d] -= 1;
+    ctx.ne[d] = d < ctx.dim ? xe[d] - xs[d] - 1 : 1;
+    ctx.e0[d] = d < ctx.dim ? xs[d] - Xs[d] : 0;
+    ctx.gn[d] = d < ctx.dim ? Xe[d] - Xs[d] : 1;
+    if (type == DMSWARM_DEPOSIT_TSC && d < ctx.dim && m[d] > 1 && sw < 2) SETERRQ(PetscObjectComm((PetscObject)swarm),PETSC_ERR_SUP,"TSC deposition requires a DMDA stencil width of at least 2");
+  }
+  ctx.stride[0] = 1;
+  ctx.stride[1] = ctx.gn[0];
+  ctx.stride[2] = ctx.gn[0]*ctx.gn[1];
+  ctx.bs   = bs;
+  ctx.type = type;
+  ctx.np   = type == DMSWARM_DEPOSIT_NGP ? 1 : (type == DMSWARM_DEPOSIT_CIC ? 2 : 3);
+  ncells   = ctx.ne[0]*ctx.ne[1]*ctx.ne[2];
+  if (sort->ncells != ncells) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Sort context has %D cells, the DMDA has %D local elements",sort->ncells,ncells);
+  npoints = sort->npoints;
+
+  ierr = DMGetCoordinatesLocal(celldm,&coor);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(coor,&ctx.coor);CHKERRQ(ierr);
+  ierr = DMSwarmGetField(swarm,DMSwarmPICField_coor,NULL,NULL,(void**)&pcoor);CHKERRQ(ierr);
+  ctx.pcoor = pcoor;
+  if (deposit) {
+#if defined(PETSC_HAVE_OPENMP)
+    /* elements whose indices differ by the footprint width in some direction never update the same node */
+    const PetscInt s = type == DMSWARM_DEPOSIT_TSC ? 4 : 2;
+    PetscInt       color,ncolors = 1;
+
+    for (d = 0; d < ctx.dim; ++d) ncolors *= s;
+    for (color = 0; color < ncolors; ++color) {
+      const PetscInt c[3] = {color % s,(color/s) % s,color/(s*s)};
+      PetscInt       nc[3],n;
+
+      for (d = 0; d < 3; ++d) nc[d] = d < ctx.dim ? (ctx.ne[d] - c[d] + s - 1)/s : 1;
+#pragma omp parallel for schedule(static)
+      for (n = 0; n < nc[0]*nc[1]*nc[2]; ++n) {
+        const PetscInt i = c[0] + s*(n % nc[0]),j = c[1] + s*((n/nc[0]) % nc[1]),k = c[2] + s*(n/(nc[0]*nc[1]));
+
+        DMSwarmDepositCell_DA(&ctx,sort,i + ctx.ne[0]*(j + ctx.ne[1]*k),PETSC_TRUE,field,xl);
+      }
+    }
+#else
+    PetscInt e;
+
+    for (e = 0; e < ncells; ++e) DMSwarmDepositCell_DA(&ctx,sort,e,PETSC_TRUE,field,xl);
+#endif
+  } else {
+    PetscInt e;
+
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for schedule(static)
+#endif
+    for (e = 0; e < ncells; ++e) DMSwarmDepositCell_DA(&ctx,sort,e,PETSC_FALSE,field,xl);
+  }
+  ierr = DMSwarmRestoreField(swarm,DMSwarmPICField_coor,NULL,NULL,(void**)&pcoor);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(coor,&ctx.coor);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*npoints*bs*PetscPowInt(ctx.np,ctx.dim));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
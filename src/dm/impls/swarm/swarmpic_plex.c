@@ -1,7 +1,11 @@
 #include <petscdm.h>
 #include <petscdmplex.h>
 #include <petscdmswarm.h>
+#include <petsc/private/dmpleximpl.h>
 #include "../src/dm/impls/swarm/data_bucket.h"
+#if defined(PETSC_HAVE_OPENMP)
+#include <omp.h>
+#endif
 
 PetscErrorCode private_DMSwarmSetPointCoordinatesCellwise_PLEX(DM,DM,PetscInt,PetscReal*xi);
 
@@ -755,3 +759,121 @@ PetscErrorCode private_DMSwarmSetPointCoordinatesCellwise_PLEX(DM dm,DM dmc,Pets
 
   PetscFunctionReturn(0);
 }
+
+/* Deposits the points of cell c, or interpolates to them, using the barycentric coordinates of the simplex */
+PETSC_STATIC_INLINE void DMSwarmDepositCell_PLEX(PetscInt dim,PetscInt bs,const DMSwarmSort sort,PetscInt c,const PetscInt voff[],const PetscReal geom[],const PetscReal pcoor[],PetscBool deposit,PetscReal field[],PetscScalar xl[])
+{
+  const PetscReal *v0 = geom,*invJ = geom + dim;
+  PetscInt        q,i,j,k;
+
+  for (q = sort->pcell_offsets[c]; q < sort->pcell_offsets[c+1]; ++q) {
+    const PetscInt p = sort->list[q].point_index;
+    PetscReal      *fp = &field[bs*p],lambda[4];
+
+    lambda[0] = 1.0;
+    for (i = 0; i < dim; ++i) {
+      lambda[i+1] = 0.0;
+      for (j = 0; j < dim; ++j) lambda[i+1] += invJ[i*dim+j]*(pcoor[dim*p+j] - v0[j]);
+      lambda[0] -= lambda[i+1];
+    }
+    if (!deposit) for (k = 0; k < bs; ++k) fp[k] = 0.0;
+    for (i = 0; i <= dim; ++i) {
+      PetscScalar *xn = &xl[voff[i]];
+
+      if (deposit) for (k = 0; k < bs; ++k) xn[k] += lambda[i]*fp[k];
+      else         for (k = 0; k < bs; ++k) fp[k] += lambda[i]*PetscRealPart(xn[k]);
+    }
+  }
+}
+
+PetscErrorCode private_DMSwarmDepositInterpolate_PLEX(DM swarm,DM celldm,DMSwarmDepositType type,PetscBool deposit,PetscInt bs,PetscReal field[],PetscScalar xl[])
+{
+  DMSwarmSort     sort = ((DM_Swarm*)swarm->data)->sort_context;
+  PetscSection    section,csection;
+  Vec             coordinates;
+  DMPolytopeType  ct;
+  PetscInt        dim,cStart,cEnd,vStart,vEnd,ncells,nv,ng,c,*voff;
+  PetscReal       *geom,*pcoor;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  if (type != DMSWARM_DEPOSIT_P1) SETERRQ1(PetscObjectComm((PetscObject)swarm),PETSC_ERR_SUP,"Deposition type %s not supported on a DMPLEX, use p1",DMSwarmDepositTypes[type]);
+  ierr = DMGetDimension(celldm,&dim);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(celldm,0,&cStart,&cEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetDepthStratum(celldm,0,&vStart,&vEnd);CHKERRQ(ierr);
+  ncells = cEnd - cStart;
+  if (sort->ncells != ncells) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Sort context has %D cells, the DMPLEX has %D cells",sort->ncells,ncells);
+  if (ncells) {
+    ierr = DMPlexGetCellType(celldm,cStart,&ct);CHKERRQ(ierr);
+    if (DMPolytopeTypeGetNumVertices(ct) != dim+1 || (dim != 2 && dim != 3)) SETERRQ(PetscObjectComm((PetscObject)swarm),PETSC_ERR_SUP,"P1 deposition requires a DMPLEX of triangles or tetrahedra");
+  }
+  ierr = DMGetLocalSection(celldm,&section);CHKERRQ(ierr);
+  if (!section) SETERRQ(PetscObjectComm((PetscObject)swarm),PETSC_ERR_ARG_WRONGSTATE,"P1 deposition requires a local section on the DMPLEX");
+  ierr = DMGetCoordinateSection(celldm,&csection);CHKERRQ(ierr);
+  ierr = DMGetCoordinatesLocal(celldm,&coordinates);CHKERRQ(ierr);
+
+  /* node offsets and affine map of every cell */
+  nv   = dim+1;
+  ng   = dim + dim*dim;
+  ierr = PetscMalloc2(ncells*nv,&voff,ncells*ng,&geom);CHKERRQ(ierr);
+  for (c = 0; c < ncells; ++c) {
+    PetscInt    *closure = NULL,clSize,cl,n = 0,cdSize,i,j;
+    PetscScalar *ccoords = NULL;
+    PetscReal   J[9],detJ,*v0 = &geom[c*ng];
+
+    ierr = DMPlexGetTransitiveClosure(celldm,cStart+c,PETSC_TRUE,&clSize,&closure);CHKERRQ(ierr);
+    for (cl = 0; cl < 2*clSize; cl += 2) {
+      const PetscInt v = closure[cl];
+      PetscInt       dof;
+
+      if (v < vStart || v >= vEnd) continue;
+      ierr = PetscSectionGetDof(section,v,&dof);CHKERRQ(ierr);
+      if (dof != bs) SETERRQ3(PetscObjectComm((PetscObject)swarm),PETSC_ERR_ARG_INCOMP,"Vertex %D has %D dofs but the swarm field has block size %D",v,dof,bs);
+      ierr = PetscSectionGetOffset(section,v,&voff[c*nv+n]);CHKERRQ(ierr);
+      n++;
+    }
+    ierr = DMPlexRestoreTransitiveClosure(celldm,cStart+c,PETSC_TRUE,&clSize,&closure);CHKERRQ(ierr);
+    ierr = DMPlexVecGetClosure(celldm,csection,coordinates,cStart+c,&cdSize,&ccoords);CHKERRQ(ierr);
+    for (i = 0; i < dim; ++i) {
+      v0[i] = PetscRealPart(ccoords[i]);
+      for (j = 0; j < dim; ++j) J[i*dim+j] = PetscRealPart(ccoords[(j+1)*dim+i]) - v0[i];
+    }
+    ierr = DMPlexVecRestoreClosure(celldm,csection,coordinates,cStart+c,&cdSize,&ccoords);CHKERRQ(ierr);
+    if (dim == 2) {DMPlex_Det2D_Internal(&detJ,J); DMPlex_Invert2D_Internal(&v0[dim],J,detJ);}
+    else          {DMPlex_Det3D_Internal(&detJ,J); DMPlex_Invert3D_Internal(&v0[dim],J,detJ);}
+  }
+
+  ierr = DMSwarmGetField(swarm,DMSwarmPICField_coor,NULL,NULL,(void**)&pcoor);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+  if (deposit && omp_get_max_threads() > 1) {
+    /* every thread but the first accumulates into a private copy of the local vector, which are summed afterwards */
+    const PetscInt nthreads = omp_get_max_threads();
+    PetscInt       nl;
+    PetscScalar    *priv;
+
+    ierr = PetscSectionGetStorageSize(section,&nl);CHKERRQ(ierr);
+    ierr = PetscCalloc1((nthreads-1)*nl,&priv);CHKERRQ(ierr);
+#pragma omp parallel num_threads(nthreads)
+    {
+      const PetscInt tid = omp_get_thread_num();
+      PetscScalar    *xt = tid ? &priv[(tid-1)*nl] : xl;
+      PetscInt       cc,i,t;
+
+#pragma omp for schedule(static)
+      for (cc = 0; cc < ncells; ++cc) DMSwarmDepositCell_PLEX(dim,bs,sort,cc,&voff[cc*nv],&geom[cc*ng],pcoor,PETSC_TRUE,field,xt);
+#pragma omp for schedule(static)
+      for (i = 0; i < nl; ++i) for (t = 1; t < nthreads; ++t) xl[i] += priv[(t-1)*nl+i];
+    }
+    ierr = PetscFree(priv);CHKERRQ(ierr);
+  } else {
+#pragma omp parallel for schedule(static) if (!deposit)
+    for (c = 0; c < ncells; ++c) DMSwarmDepositCell_PLEX(dim,bs,sort,c,&voff[c*nv],&geom[c*ng],pcoor,deposit,field,xl);
+  }
+#else
+  for (c = 0; c < ncells; ++c) DMSwarmDepositCell_PLEX(dim,bs,sort,c,&voff[c*nv],&geom[c*ng],pcoor,deposit,field,xl);
+#endif
+  ierr = DMSwarmRestoreField(swarm,DMSwarmPICField_coor,NULL,NULL,(void**)&pcoor);CHKERRQ(ierr);
+  ierr = PetscFree2(voff,geom);CHKERRQ(ierr);
+  ierr = PetscLogFlops((2.0*dim*dim + 2.0*nv*bs)*sort->npoints);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
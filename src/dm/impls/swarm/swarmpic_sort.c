@@ -3,28 +3,82 @@
 #include <petscdmplex.h>
 #include <petscdmswarm.h>
 #include <petsc/private/dmswarmimpl.h>
+#include "../src/dm/impls/swarm/data_bucket.h"
 
-int sort_CompareSwarmPoint(const void *dataA,const void *dataB)
+/*
+  Counting sort of all points by cell index. Points within a cell are listed in increasing point index.
+  On output ctx->list and ctx->pcell_offsets are complete.
+*/
+static PetscErrorCode DMSwarmSortApplyCellIndexSort(DMSwarmSort ctx,const PetscInt swarm_cellid[])
 {
-  SwarmPoint *pointA;
-  SwarmPoint *pointB;
+  PetscInt       *offsets = ctx->pcell_offsets;
+  PetscInt       p,c;
+  PetscErrorCode ierr;
 
-  pointA = (SwarmPoint*)dataA;
-  pointB = (SwarmPoint*)dataB;
+  PetscFunctionBegin;
+  ierr = PetscArrayzero(offsets,ctx->ncells + 1);CHKERRQ(ierr);
+  for (p=0; p<ctx->npoints; p++) offsets[swarm_cellid[p] + 1]++;
+  for (c=0; c<ctx->ncells; c++) offsets[c+1] += offsets[c];
+  /* offsets[c] is used as the insertion cursor of cell c, leaving it holding the start of cell c+1 */
+  for (p=0; p<ctx->npoints; p++) {
+    const PetscInt k = offsets[swarm_cellid[p]]++;
 
-  if (pointA->cell_index < pointB->cell_index) {
-    return -1;
-  } else if (pointA->cell_index > pointB->cell_index) {
-    return 1;
-  } else {
-    return 0;
+    ctx->list[k].point_index = p;
+    ctx->list[k].cell_index  = swarm_cellid[p];
   }
+  for (c=ctx->ncells; c>0; c--) offsets[c] = offsets[c-1];
+  offsets[0] = 0;
+  PetscFunctionReturn(0);
 }
 
-PetscErrorCode DMSwarmSortApplyCellIndexSort(DMSwarmSort ctx)
+/*
+  Update the list built at the previous setup, which described nold points, by re-bucketing only
+  the nmoved points listed in moved[] (in increasing order). These are the points whose cell index changed
+  and the points appended since the previous setup; points beyond the current size are dropped.
+  The result is identical to DMSwarmSortApplyCellIndexSort().
+*/
+static PetscErrorCode DMSwarmSortApplyCellIndexUpdate(DMSwarmSort ctx,PetscInt npoints,const PetscInt swarm_cellid[],PetscInt nmoved,const PetscInt moved[])
 {
+  PetscInt       *offsets = ctx->pcell_offsets,*moffsets = ctx->work,*msorted = ctx->work + ctx->ncells + 1;
+  SwarmPoint     *list = ctx->list,*nlist = ctx->list_work;
+  PetscInt       c,k,i,j,w = 0;
+  PetscErrorCode ierr;
+
   PetscFunctionBegin;
-  qsort(ctx->list,ctx->npoints,sizeof(SwarmPoint),sort_CompareSwarmPoint);
+  /* bucket the moved points by their new cell */
+  ierr = PetscArrayzero(moffsets,ctx->ncells + 1);CHKERRQ(ierr);
+  for (k=0; k<nmoved; k++) moffsets[swarm_cellid[moved[k]] + 1]++;
+  for (c=0; c<ctx->ncells; c++) moffsets[c+1] += moffsets[c];
+  for (k=0; k<nmoved; k++) msorted[moffsets[swarm_cellid[moved[k]]]++] = moved[k];
+  for (c=ctx->ncells; c>0; c--) moffsets[c] = moffsets[c-1];
+  moffsets[0] = 0;
+
+  /* merge the points which stayed in each cell with the points which moved into it */
+  for (c=0; c<ctx->ncells; c++) {
+    const PetscInt start = offsets[c],end = offsets[c+1];
+
+    offsets[c] = w;
+    for (i=start,j=moffsets[c]; i<end || j<moffsets[c+1];) {
+      if (i < end) {
+        const PetscInt pi = list[i].point_index;
+
+        if (pi >= npoints || swarm_cellid[pi] != c) {i++; continue;}
+        if (j == moffsets[c+1] || pi < msorted[j]) {
+          nlist[w].point_index = pi;
+          nlist[w].cell_index  = c;
+          w++; i++;
+          continue;
+        }
+      }
+      nlist[w].point_index = msorted[j];
+      nlist[w].cell_index  = c;
+      w++; j++;
+    }
+  }
+  offsets[ctx->ncells] = w;
+  if (w != npoints) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Incremental sort produced %D points, expected %D",w,npoints);
+  ctx->list      = nlist;
+  ctx->list_work = list;
   PetscFunctionReturn(0);
 }
 
@@ -37,6 +91,7 @@ PetscErrorCode DMSwarmSortCreate(DMSwarmSort *_ctx)
   ierr = PetscMalloc1(1,&ctx);CHKERRQ(ierr);
   ierr = PetscMemzero(ctx,sizeof(struct _p_DMSwarmSort));CHKERRQ(ierr);
   ctx->isvalid = PETSC_FALSE;
+  ctx->haslist = PETSC_FALSE;
   ctx->ncells = 0;
   ctx->npoints = 0;
   ierr = PetscMalloc1(1,&ctx->pcell_offsets);CHKERRQ(ierr);
@@ -48,8 +103,8 @@ PetscErrorCode DMSwarmSortCreate(DMSwarmSort *_ctx)
 PetscErrorCode DMSwarmSortSetup(DMSwarmSort ctx,DM dm,PetscInt ncells)
 {
   PetscInt        *swarm_cellid;
-  PetscInt        p,npoints;
-  PetscInt        tmp,c,count;
+  PetscInt        p,npoints,nold,nmoved = 0;
+  PetscBool       incremental;
   PetscErrorCode  ierr;
 
   PetscFunctionBegin;
@@ -57,44 +112,55 @@ PetscErrorCode DMSwarmSortSetup(DMSwarmSort ctx,DM dm,PetscInt ncells)
   if (ctx->isvalid) PetscFunctionReturn(0);
 
   ierr = PetscLogEventBegin(DMSWARM_Sort,0,0,0,0);CHKERRQ(ierr);
+  ierr = DMSwarmGetLocalSize(dm,&npoints);CHKERRQ(ierr);
+  ierr = DMSwarmGetField(dm,DMSwarmPICField_cellid,NULL,NULL,(void**)&swarm_cellid);CHKERRQ(ierr);
+  for (p=0; p<npoints; p++) {
+    if (swarm_cellid[p] < 0 || swarm_cellid[p] >= ncells) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_USER,"Point %D has cell index %D outside of [0, %D)",p,swarm_cellid[p],ncells);
+  }
+
+  /* the previous list can be updated if the cells are unchanged; count the points which must be re-bucketed */
+  nold        = ctx->npoints;
+  incremental = (ctx->haslist && ncells == ctx->ncells) ? PETSC_TRUE : PETSC_FALSE;
+  if (incremental) {
+    for (p=0; p<PetscMin(npoints,nold); p++) if (swarm_cellid[p] != ctx->pcellid[p]) nmoved++;
+    if (npoints > nold) nmoved += npoints - nold;
+    /* beyond this fraction a full sort touches less memory than the merge */
+    if (nmoved > npoints/4) incremental = PETSC_FALSE;
+  }
+
   /* check the number of cells */
   if (ncells != ctx->ncells) {
     ierr = PetscRealloc(sizeof(PetscInt)*(ncells + 1),&ctx->pcell_offsets);CHKERRQ(ierr);
     ctx->ncells = ncells;
   }
-  ierr = PetscArrayzero(ctx->pcell_offsets,ctx->ncells + 1);CHKERRQ(ierr);
 
-  /* get the number of points */
-  ierr = DMSwarmGetLocalSize(dm,&npoints);CHKERRQ(ierr);
-  if (npoints != ctx->npoints) {
-    ierr = PetscRealloc(sizeof(SwarmPoint)*npoints,&ctx->list);CHKERRQ(ierr);
+  if (incremental && !nmoved && npoints == nold) {
+    /* no point changed cell since the previous setup */
+  } else if (incremental) {
+    PetscInt *moved;
+
+    ierr = PetscRealloc(sizeof(SwarmPoint)*(npoints+1),&ctx->list_work);CHKERRQ(ierr);
+    ierr = PetscRealloc(sizeof(PetscInt)*(ncells + 1 + nmoved + 1),&ctx->work);CHKERRQ(ierr);
+    ierr = PetscMalloc1(nmoved,&moved);CHKERRQ(ierr);
+    nmoved = 0;
+    for (p=0; p<npoints; p++) if (p >= nold || swarm_cellid[p] != ctx->pcellid[p]) moved[nmoved++] = p;
+    ierr = DMSwarmSortApplyCellIndexUpdate(ctx,npoints,swarm_cellid,nmoved,moved);CHKERRQ(ierr);
+    ierr = PetscFree(moved);CHKERRQ(ierr);
+    ierr = PetscRealloc(sizeof(SwarmPoint)*(npoints+1),&ctx->list);CHKERRQ(ierr);
+    ctx->npoints = npoints;
+  } else {
+    ierr = PetscRealloc(sizeof(SwarmPoint)*(npoints+1),&ctx->list);CHKERRQ(ierr);
     ctx->npoints = npoints;
+    ierr = DMSwarmSortApplyCellIndexSort(ctx,swarm_cellid);CHKERRQ(ierr);
   }
-  ierr = PetscArrayzero(ctx->list,npoints);CHKERRQ(ierr);
 
-  ierr = DMSwarmGetField(dm,DMSwarmPICField_cellid,NULL,NULL,(void**)&swarm_cellid);CHKERRQ(ierr);
-  for (p=0; p<ctx->npoints; p++) {
-    ctx->list[p].point_index = p;
-    ctx->list[p].cell_index  = swarm_cellid[p];
-  }
+  /* record the cell index of each point for the next setup */
+  ierr = PetscRealloc(sizeof(PetscInt)*(npoints+1),&ctx->pcellid);CHKERRQ(ierr);
+  ierr = PetscArraycpy(ctx->pcellid,swarm_cellid,npoints);CHKERRQ(ierr);
   ierr = DMSwarmRestoreField(dm,DMSwarmPICField_cellid,NULL,NULL,(void**)&swarm_cellid);CHKERRQ(ierr);
+  ierr = PetscInfo3(dm,"Sorted %D points into %D cells, re-bucketed %D points\n",npoints,ncells,incremental ? nmoved : npoints);CHKERRQ(ierr);
 
-  ierr = DMSwarmSortApplyCellIndexSort(ctx);CHKERRQ(ierr);
-
-  /* sum points per cell */
-  for (p=0; p<ctx->npoints; p++) {
-    ctx->pcell_offsets[ ctx->list[p].cell_index ]++;
-  }
-
-  /* create offset list */
-  count = 0;
-  for (c=0; c<ctx->ncells; c++) {
-    tmp = ctx->pcell_offsets[c];
-    ctx->pcell_offsets[c] = count;
-    count = count + tmp;
-  }
-  ctx->pcell_offsets[c] = count;
-
+  ctx->haslist = PETSC_TRUE;
   ctx->isvalid = PETSC_TRUE;
   ierr = PetscLogEventEnd(DMSWARM_Sort,0,0,0,0);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -115,6 +181,9 @@ PetscErrorCode DMSwarmSortDestroy(DMSwarmSort *_ctx)
   if (ctx->pcell_offsets) {
     ierr = PetscFree(ctx->pcell_offsets);CHKERRQ(ierr);
   }
+  ierr = PetscFree(ctx->list_work);CHKERRQ(ierr);
+  ierr = PetscFree(ctx->pcellid);CHKERRQ(ierr);
+  ierr = PetscFree(ctx->work);CHKERRQ(ierr);
   ierr = PetscFree(ctx);CHKERRQ(ierr);
   *_ctx = NULL;
   PetscFunctionReturn(0);
@@ -198,6 +267,43 @@ PETSC_EXTERN PetscErrorCode DMSwarmSortGetPointsPerCell(DM dm,PetscInt e,PetscIn
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode DMSwarmSortGetNumberOfCells_Private(DM dm,PetscInt *nc)
+{
+  PetscErrorCode  ierr;
+  PetscInt        ncells;
+  DM              celldm;
+  PetscBool       isda,isplex,isshell;
+
+  PetscFunctionBegin;
+  ierr = DMSwarmGetCellDM(dm,&celldm);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)celldm,DMDA,&isda);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)celldm,DMPLEX,&isplex);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)celldm,DMSHELL,&isshell);CHKERRQ(ierr);
+  ncells = 0;
+  if (isda) {
+    PetscInt nel,npe;
+    const PetscInt *element;
+
+    ierr = DMDAGetElements(celldm,&nel,&npe,&element);CHKERRQ(ierr);
+    ncells = nel;
+    ierr = DMDARestoreElements(celldm,&nel,&npe,&element);CHKERRQ(ierr);
+  } else if (isplex) {
+    PetscInt ps,pe;
+
+    ierr = DMPlexGetHeightStratum(celldm,0,&ps,&pe);CHKERRQ(ierr);
+    ncells = pe - ps;
+  } else if (isshell) {
+    PetscErrorCode (*method_DMShellGetNumberOfCells)(DM,PetscInt*);
+
+    ierr = PetscObjectQueryFunction((PetscObject)celldm,"DMGetNumberOfCells_C",&method_DMShellGetNumberOfCells);CHKERRQ(ierr);
+    if (method_DMShellGetNumberOfCells) {
+      ierr = method_DMShellGetNumberOfCells(celldm,&ncells);CHKERRQ(ierr);
+    } else SETERRQ(PetscObjectComm((PetscObject)dm),PETSC_ERR_SUP,"Cannot determine the number of cells for the DMSHELL object. User must provide a method via PetscObjectComposeFunction( (PetscObject)shelldm, \"DMGetNumberOfCells_C\", your_function_to_compute_number_of_cells);");
+  } else SETERRQ(PetscObjectComm((PetscObject)dm),PETSC_ERR_SUP,"Cannot determine the number of cells for a DM not of type DA, PLEX or SHELL");
+  *nc = ncells;
+  PetscFunctionReturn(0);
+}
+
 /*@C
    DMSwarmSortGetAccess - Setups up a DMSwarm point sort context for efficient traversal of points within a cell
 
@@ -225,6 +331,11 @@ PETSC_EXTERN PetscErrorCode DMSwarmSortGetPointsPerCell(DM dm,PetscInt e,PetscIn
    To facilitate safe removal of points using the sort context, we suggest a "two pass" strategy in which the
    first pass "marks" points for removal, and the second pass actually removes the points from the DMSwarm.
 
+   The sort context remembers the cell index of every point. When the number of cells is unchanged, a subsequent call
+   only re-buckets the points whose cell index changed (or which were added) since the previous call, so calling
+   DMSwarmSortGetAccess() after each DMSwarmMigrate() costs little when most points stay in their cell. Within a cell,
+   points are listed in increasing index. Use DMSwarmSortReorder() to store the points of each cell contiguously.
+
    Notes:
    - You must call DMSwarmSortGetAccess() before you can call DMSwarmSortGetPointsPerCell() or DMSwarmSortGetNumberOfPointsPerCell()
    - The sort context may become invalid if any re-sizing methods are applied which alter the first NP points
@@ -233,51 +344,115 @@ PETSC_EXTERN PetscErrorCode DMSwarmSortGetPointsPerCell(DM dm,PetscInt e,PetscIn
 
    Level: advanced
 
-.seealso: DMSwarmSetType(), DMSwarmSortRestoreAccess()
+.seealso: DMSwarmSetType(), DMSwarmSortRestoreAccess(), DMSwarmSortReorder()
 @*/
 PETSC_EXTERN PetscErrorCode DMSwarmSortGetAccess(DM dm)
 {
   DM_Swarm        *swarm = (DM_Swarm*)dm->data;
   PetscErrorCode  ierr;
-  PetscInt        ncells;
-  DM              celldm;
-  PetscBool       isda,isplex,isshell;
+  PetscInt        ncells = 0;
 
   PetscFunctionBegin;
   if (!swarm->sort_context) {
     ierr = DMSwarmSortCreate(&swarm->sort_context);CHKERRQ(ierr);
   }
+  ierr = DMSwarmSortGetNumberOfCells_Private(dm,&ncells);CHKERRQ(ierr);
+  ierr = DMSwarmSortSetup(swarm->sort_context,dm,ncells);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   DMSwarmSortReorder - Reorders the points of a DMSwarm so that the points contained in each cell are stored contiguously
+
+   Not collective
+
+   Input parameter:
+.  dm - a DMSwarm object
+
+   Notes:
+   Unlike DMSwarmSortGetAccess(), this method physically permutes the entries of every registered field. Points are
+   ordered by increasing cell index, and points within a cell keep their relative order. Traversing the points cell
+   by cell, as done when depositing to or interpolating from the cell DM, then accesses the field arrays sequentially.
+
+   Any point index obtained before calling DMSwarmSortReorder() is invalidated. The method must not be called while
+   the sort context is accessed, that is between DMSwarmSortGetAccess() and DMSwarmSortRestoreAccess().
+
+   The sort context is updated at no cost, so a subsequent DMSwarmSortGetAccess() only re-buckets the points which
+   changed cell in the meantime. Reordering can be applied automatically after every k-th DMSwarmMigrate() using
+   DMSwarmSortSetReorderFrequency().
+
+   Level: advanced
+
+.seealso: DMSwarmSortGetAccess(), DMSwarmSortSetReorderFrequency(), DMSwarmMigrate()
+@*/
+PetscErrorCode DMSwarmSortReorder(DM dm)
+{
+  DM_Swarm        *swarm = (DM_Swarm*)dm->data;
+  DMSwarmSort     ctx;
+  PetscInt        *perm,p;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm,DM_CLASSID,1);
+  if (swarm->sort_context && swarm->sort_context->isvalid) SETERRQ(PetscObjectComm((PetscObject)dm),PETSC_ERR_ARG_WRONGSTATE,"Cannot reorder the points while the sort context is accessed. Call DMSwarmSortRestoreAccess() first");
+  ierr = DMSwarmSortGetAccess(dm);CHKERRQ(ierr);
+  ctx  = swarm->sort_context;
+  ierr = PetscMalloc1(ctx->npoints,&perm);CHKERRQ(ierr);
+  for (p=0; p<ctx->npoints; p++) perm[p] = ctx->list[p].point_index;
+  ierr = DMSwarmDataBucketPermutePoints(swarm->db,perm);CHKERRQ(ierr);
+  ierr = PetscFree(perm);CHKERRQ(ierr);
+  /* point p now holds the p-th entry of the list */
+  for (p=0; p<ctx->npoints; p++) {
+    ctx->list[p].point_index = p;
+    ctx->pcellid[p]          = ctx->list[p].cell_index;
+  }
+  ierr = DMSwarmSortRestoreAccess(dm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
 
-  /* get the number of cells */
-  ierr = DMSwarmGetCellDM(dm,&celldm);CHKERRQ(ierr);
-  ierr = PetscObjectTypeCompare((PetscObject)celldm,DMDA,&isda);CHKERRQ(ierr);
-  ierr = PetscObjectTypeCompare((PetscObject)celldm,DMPLEX,&isplex);CHKERRQ(ierr);
-  ierr = PetscObjectTypeCompare((PetscObject)celldm,DMSHELL,&isshell);CHKERRQ(ierr);
-  ncells = 0;
-  if (isda) {
-    PetscInt nel,npe;
-    const PetscInt *element;
+/*@
+   DMSwarmSortSetReorderFrequency - Sets how often DMSwarmMigrate() reorders the points of a DMSwarm by cell
 
-    ierr = DMDAGetElements(celldm,&nel,&npe,&element);CHKERRQ(ierr);
-    ncells = nel;
-    ierr = DMDARestoreElements(celldm,&nel,&npe,&element);CHKERRQ(ierr);
-  } else if (isplex) {
-    PetscInt ps,pe;
+   Logically collective on dm
 
-    ierr = DMPlexGetHeightStratum(celldm,0,&ps,&pe);CHKERRQ(ierr);
-    ncells = pe - ps;
-  } else if (isshell) {
-    PetscErrorCode (*method_DMShellGetNumberOfCells)(DM,PetscInt*);
+   Input parameters:
++  dm - a DMSwarm object
+-  freq - the points are reordered after every freq-th migration, 0 disables reordering
 
-    ierr = PetscObjectQueryFunction((PetscObject)celldm,"DMGetNumberOfCells_C",&method_DMShellGetNumberOfCells);CHKERRQ(ierr);
-    if (method_DMShellGetNumberOfCells) {
-      ierr = method_DMShellGetNumberOfCells(celldm,&ncells);CHKERRQ(ierr);
-    } else SETERRQ(PetscObjectComm((PetscObject)dm),PETSC_ERR_SUP,"Cannot determine the number of cells for the DMSHELL object. User must provide a method via PetscObjectComposeFunction( (PetscObject)shelldm, \"DMGetNumberOfCells_C\", your_function_to_compute_number_of_cells);");
-  } else SETERRQ(PetscObjectComm((PetscObject)dm),PETSC_ERR_SUP,"Cannot determine the number of cells for a DM not of type DA, PLEX or SHELL");
+   Options Database Key:
+.  -dm_swarm_sort_reorder_frequency <freq> - the reordering frequency
 
-  /* setup */
-  ierr = DMSwarmSortSetup(swarm->sort_context,dm,ncells);CHKERRQ(ierr);
+   Notes:
+   Reordering is only applied with the migration type DMSWARM_MIGRATE_DMCELLNSCATTER, for which the cell index of
+   every point is up to date after the migration. The default is 0.
 
+   Level: advanced
+
+.seealso: DMSwarmSortReorder(), DMSwarmMigrate(), DMSwarmSetMigrateType()
+@*/
+PetscErrorCode DMSwarmSortSetReorderFrequency(DM dm,PetscInt freq)
+{
+  DM_Swarm *swarm = (DM_Swarm*)dm->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm,DM_CLASSID,1);
+  PetscValidLogicalCollectiveInt(dm,freq,2);
+  if (freq < 0) SETERRQ1(PetscObjectComm((PetscObject)dm),PETSC_ERR_ARG_OUTOFRANGE,"Reorder frequency %D must be non-negative",freq);
+  swarm->sort_reorder_freq = freq;
+  PetscFunctionReturn(0);
+}
+
+/* called at the end of DMSwarmMigrate() */
+PetscErrorCode DMSwarmSortReorderAfterMigrate_Internal(DM dm)
+{
+  DM_Swarm       *swarm = (DM_Swarm*)dm->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!swarm->sort_reorder_freq || swarm->migrate_type != DMSWARM_MIGRATE_DMCELLNSCATTER) PetscFunctionReturn(0);
+  if (++swarm->sort_reorder_count < swarm->sort_reorder_freq) PetscFunctionReturn(0);
+  swarm->sort_reorder_count = 0;
+  ierr = DMSwarmSortReorder(dm);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -0,0 +1,152 @@
+static char help[] = "Tests the incremental update of the DMSwarm cell sort and the reordering of the points by cell\n";
+
+#include <petscdmda.h>
+#include <petscdmswarm.h>
+
+/* Check that every local point is listed exactly once, in the cell given by its cell index, in increasing order */
+static PetscErrorCode CheckSort(DM sw,PetscBool *valid)
+{
+  PetscInt       *cellid,*count,*list,nlocal,ncells,npoints,nlisted = 0,c,p;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  *valid = PETSC_TRUE;
+  ierr = DMSwarmGetLocalSize(sw,&nlocal);CHKERRQ(ierr);
+  ierr = DMSwarmSortGetAccess(sw);CHKERRQ(ierr);
+  ierr = DMSwarmSortGetSizes(sw,&ncells,NULL);CHKERRQ(ierr);
+  ierr = DMSwarmGetField(sw,DMSwarmPICField_cellid,NULL,NULL,(void**)&cellid);CHKERRQ(ierr);
+  ierr = PetscCalloc1(nlocal,&count);CHKERRQ(ierr);
+  for (c = 0; c < ncells; ++c) {
+    ierr = DMSwarmSortGetPointsPerCell(sw,c,&npoints,&list);CHKERRQ(ierr);
+    for (p = 0; p < npoints; ++p) {
+      if (cellid[list[p]] != c) *valid = PETSC_FALSE;
+      if (p && list[p] <= list[p-1]) *valid = PETSC_FALSE;
+      count[list[p]]++;
+    }
+    nlisted += npoints;
+    ierr = PetscFree(list);CHKERRQ(ierr);
+  }
+  for (p = 0; p < nlocal; ++p) if (count[p] != 1) *valid = PETSC_FALSE;
+  if (nlisted != nlocal) *valid = PETSC_FALSE;
+  ierr = PetscFree(count);CHKERRQ(ierr);
+  ierr = DMSwarmRestoreField(sw,DMSwarmPICField_cellid,NULL,NULL,(void**)&cellid);CHKERRQ(ierr);
+  ierr = DMSwarmSortRestoreAccess(sw);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Check that the points are stored cell by cell and that the fields were permuted together */
+static PetscErrorCode CheckOrder(DM sw,PetscBool *ordered,PetscBool *consistent)
+{
+  PetscInt       *cellid,nlocal,p;
+  PetscReal      *coor,*sum;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  *ordered = *consistent = PETSC_TRUE;
+  ierr = DMSwarmGetLocalSize(sw,&nlocal);CHKERRQ(ierr);
+  ierr = DMSwarmGetField(sw,DMSwarmPICField_cellid,NULL,NULL,(void**)&cellid);CHKERRQ(ierr);
+  ierr = DMSwarmGetField(sw,DMSwarmPICField_coor,NULL,NULL,(void**)&coor);CHKERRQ(ierr);
+  ierr = DMSwarmGetField(sw,"sum",NULL,NULL,(void**)&sum);CHKERRQ(ierr);
+  for (p = 0; p < nlocal; ++p) {
+    if (p && cellid[p] < cellid[p-1]) *ordered = PETSC_FALSE;
+    if (PetscAbsReal(sum[p] - (coor[2*p] + coor[2*p+1])) > 1.0e-12) *consistent = PETSC_FALSE;
+  }
+  ierr = DMSwarmRestoreField(sw,"sum",NULL,NULL,(void**)&sum);CHKERRQ(ierr);
+  ierr = DMSwarmRestoreField(sw,DMSwarmPICField_coor,NULL,NULL,(void**)&coor);CHKERRQ(ierr);
+  ierr = DMSwarmRestoreField(sw,DMSwarmPICField_cellid,NULL,NULL,(void**)&cellid);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Shift the points in x, wrapping them around the unit square; only points with x < 0.5 move */
+static PetscErrorCode MovePoints(DM sw,PetscReal dx)
+{
+  PetscInt       nlocal,p;
+  PetscReal      *coor,*sum;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = DMSwarmGetLocalSize(sw,&nlocal);CHKERRQ(ierr);
+  ierr = DMSwarmGetField(sw,DMSwarmPICField_coor,NULL,NULL,(void**)&coor);CHKERRQ(ierr);
+  ierr = DMSwarmGetField(sw,"sum",NULL,NULL,(void**)&sum);CHKERRQ(ierr);
+  for (p = 0; p < nlocal; ++p) {
+    if (coor[2*p] >= 0.5) continue;
+    coor[2*p] += dx;
+    if (coor[2*p] >= 1.0) coor[2*p] -= 1.0;
+    sum[p] = coor[2*p] + coor[2*p+1];
+  }
+  ierr = DMSwarmRestoreField(sw,"sum",NULL,NULL,(void**)&sum);CHKERRQ(ierr);
+  ierr = DMSwarmRestoreField(sw,DMSwarmPICField_coor,NULL,NULL,(void**)&coor);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  DM             da,sw;
+  PetscInt       nsteps = 4,step,nlocal,p;
+  PetscReal      *coor,*sum;
+  PetscBool      valid,ordered,consistent;
+  PetscMPIInt    rank;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRMPI(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-nsteps",&nsteps,NULL);CHKERRQ(ierr);
+  ierr = DMDACreate2d(PETSC_COMM_WORLD,DM_BOUNDARY_NONE,DM_BOUNDARY_NONE,DMDA_STENCIL_BOX,17,17,PETSC_DECIDE,PETSC_DECIDE,1,1,NULL,NULL,&da);CHKERRQ(ierr);
+  ierr = DMDASetElementType(da,DMDA_ELEMENT_Q1);CHKERRQ(ierr);
+  ierr = DMSetFromOptions(da);CHKERRQ(ierr);
+  ierr = DMSetUp(da);CHKERRQ(ierr);
+  ierr = DMDASetUniformCoordinates(da,0.0,1.0,0.0,1.0,0.0,0.0);CHKERRQ(ierr);
+
+  ierr = DMCreate(PETSC_COMM_WORLD,&sw);CHKERRQ(ierr);
+  ierr = DMSetType(sw,DMSWARM);CHKERRQ(ierr);
+  ierr = DMSetDimension(sw,2);CHKERRQ(ierr);
+  ierr = DMSwarmSetType(sw,DMSWARM_PIC);CHKERRQ(ierr);
+  ierr = DMSwarmSetCellDM(sw,da);CHKERRQ(ierr);
+  ierr = DMSwarmRegisterPetscDatatypeField(sw,"sum",1,PETSC_REAL);CHKERRQ(ierr);
+  ierr = DMSwarmFinalizeFieldRegister(sw);CHKERRQ(ierr);
+  ierr = DMSetFromOptions(sw);CHKERRQ(ierr);
+  ierr = DMSwarmSetLocalSizes(sw,4,0);CHKERRQ(ierr);
+  ierr = DMSwarmInsertPointsUsingCellDM(sw,DMSWARMPIC_LAYOUT_REGULAR,2);CHKERRQ(ierr);
+
+  /* store x + y with each point to check that reordering permutes all fields together */
+  ierr = DMSwarmGetLocalSize(sw,&nlocal);CHKERRQ(ierr);
+  ierr = DMSwarmGetField(sw,DMSwarmPICField_coor,NULL,NULL,(void**)&coor);CHKERRQ(ierr);
+  ierr = DMSwarmGetField(sw,"sum",NULL,NULL,(void**)&sum);CHKERRQ(ierr);
+  for (p = 0; p < nlocal; ++p) sum[p] = coor[2*p] + coor[2*p+1];
+  ierr = DMSwarmRestoreField(sw,"sum",NULL,NULL,(void**)&sum);CHKERRQ(ierr);
+  ierr = DMSwarmRestoreField(sw,DMSwarmPICField_coor,NULL,NULL,(void**)&coor);CHKERRQ(ierr);
+
+  ierr = CheckSort(sw,&valid);CHKERRQ(ierr);
+  ierr = PetscSynchronizedPrintf(PETSC_COMM_WORLD,"[%d] initial sort %s\n",rank,valid ? "valid" : "INVALID");CHKERRQ(ierr);
+  ierr = DMSwarmSortReorder(sw);CHKERRQ(ierr);
+  ierr = CheckOrder(sw,&ordered,&consistent);CHKERRQ(ierr);
+  ierr = CheckSort(sw,&valid);CHKERRQ(ierr);
+  ierr = PetscSynchronizedPrintf(PETSC_COMM_WORLD,"[%d] reordered: sort %s, points %s, fields %s\n",rank,valid ? "valid" : "INVALID",ordered ? "ordered" : "NOT ordered",consistent ? "consistent" : "INCONSISTENT");CHKERRQ(ierr);
+  for (step = 0; step < nsteps; ++step) {
+    PetscInt nglobal;
+
+    ierr = MovePoints(sw,0.03);CHKERRQ(ierr);
+    ierr = DMSwarmMigrate(sw,PETSC_TRUE);CHKERRQ(ierr);
+    ierr = DMSwarmGetSize(sw,&nglobal);CHKERRQ(ierr);
+    ierr = CheckSort(sw,&valid);CHKERRQ(ierr);
+    ierr = CheckOrder(sw,&ordered,&consistent);CHKERRQ(ierr);
+    ierr = PetscSynchronizedPrintf(PETSC_COMM_WORLD,"[%d] step %D: %D points, sort %s, fields %s%s\n",rank,step,nglobal,valid ? "valid" : "INVALID",consistent ? "consistent" : "INCONSISTENT",ordered ? ", points ordered" : "");CHKERRQ(ierr);
+  }
+  ierr = PetscSynchronizedFlush(PETSC_COMM_WORLD,PETSC_STDOUT);CHKERRQ(ierr);
+  ierr = DMDestroy(&sw);CHKERRQ(ierr);
+  ierr = DMDestroy(&da);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+  test:
+    suffix: 0
+
+  test:
+    suffix: reorder
+    nsize: 2
+    args: -dm_swarm_sort_reorder_frequency 2
+
+TEST*/
@@ -0,0 +1,278 @@
+static char help[] = "Tests the deposition of DMSwarm fields onto a cell DM and their interpolation back to the points\n";
+
+#include <petscdmda.h>
+#include <petscdmplex.h>
+#include <petscdmswarm.h>
+
+typedef struct {
+  PetscInt           dim;
+  PetscBool          simplex;   /* Use a DMPLEX of simplices instead of a DMDA */
+  DMSwarmDepositType type;
+  PetscInt           faces;     /* Number of faces per direction of the DMPLEX box */
+  PetscInt           nbench;    /* Number of repetitions used to measure the throughput */
+} AppCtx;
+
+static PetscErrorCode ProcessOptions(MPI_Comm comm,AppCtx *options)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  options->dim     = 2;
+  options->simplex = PETSC_FALSE;
+  options->type    = DMSWARM_DEPOSIT_CIC;
+  options->faces   = 2;
+  options->nbench  = 0;
+  ierr = PetscOptionsBegin(comm,"","Swarm deposition test options","DMSWARM");CHKERRQ(ierr);
+  ierr = PetscOptionsRangeInt("-dim","The spatial dimension","ex8.c",options->dim,&options->dim,NULL,2,3);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-simplex","Use a DMPLEX of simplices as the cell DM","ex8.c",options->simplex,&options->simplex,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-faces","Number of faces per direction of the DMPLEX box","ex8.c",options->faces,&options->faces,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnum("-deposit_type","The deposition shape function","DMSwarmDepositField",DMSwarmDepositTypes,(PetscEnum)options->type,(PetscEnum*)&options->type,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-benchmark","Number of depositions and interpolations used to measure the throughput","ex8.c",options->nbench,&options->nbench,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Creates the unit square split into triangles, or the unit cube split into tetrahedra, on rank 0 */
+static PetscErrorCode CreateSimplexBox(MPI_Comm comm,PetscInt dim,PetscInt n,DM *dm)
+{
+  PetscInt       nv = 0,nc = 0,nvc = dim+1,*cells = NULL,i,j,k,c,d,m,t;
+  PetscReal      *coords = NULL;
+  PetscMPIInt    rank;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRMPI(ierr);
+  if (!rank) {
+    const PetscInt nk = dim > 2 ? n : 1,nvk = dim > 2 ? n+1 : 1;
+
+    nv   = (n+1)*(n+1)*nvk;
+    nc   = (dim > 2 ? 6 : 2)*n*n*nk;
+    ierr = PetscMalloc2(nv*dim,&coords,nc*nvc,&cells);CHKERRQ(ierr);
+    for (k = 0; k < nvk; ++k) for (j = 0; j <= n; ++j) for (i = 0; i <= n; ++i) {
+      const PetscInt v = i + (n+1)*(j + (n+1)*k);
+
+      coords[v*dim+0] = (PetscReal)i/n;
+      coords[v*dim+1] = (PetscReal)j/n;
+      if (dim > 2) coords[v*dim+2] = (PetscReal)k/n;
+    }
+    c = 0;
+    for (k = 0; k < nk; ++k) for (j = 0; j < n; ++j) for (i = 0; i < n; ++i) {
+      const PetscInt stride[3] = {1,n+1,(n+1)*(n+1)},v0 = i + (n+1)*(j + (n+1)*k);
+
+      if (dim == 2) {
+        cells[nvc*c+0] = v0; cells[nvc*c+1] = v0+1; cells[nvc*c+2] = v0+n+2; ++c;
+        cells[nvc*c+0] = v0; cells[nvc*c+1] = v0+n+2; cells[nvc*c+2] = v0+n+1; ++c;
+      } else {
+        /* Kuhn subdivision: each tetrahedron follows a monotone path from the lowest to the highest corner */
+        const PetscInt perm[6][3] = {{0,1,2},{0,2,1},{1,0,2},{1,2,0},{2,0,1},{2,1,0}};
+
+        for (t = 0; t < 6; ++t) {
+          PetscReal e[3][3],vol;
+
+          cells[nvc*c+0] = v0;
+          for (d = 0; d < 3; ++d) cells[nvc*c+d+1] = cells[nvc*c+d] + stride[perm[t][d]];
+          for (d = 0; d < 3; ++d) for (m = 0; m < 3; ++m) e[d][m] = coords[cells[nvc*c+d+1]*dim+m] - coords[v0*dim+m];
+          vol = e[0][0]*(e[1][1]*e[2][2] - e[1][2]*e[2][1]) - e[0][1]*(e[1][0]*e[2][2] - e[1][2]*e[2][0]) + e[0][2]*(e[1][0]*e[2][1] - e[1][1]*e[2][0]);
+          if (vol < 0.0) {const PetscInt tmp = cells[nvc*c+1]; cells[nvc*c+1] = cells[nvc*c+2]; cells[nvc*c+2] = tmp;}
+          ++c;
+        }
+      }
+    }
+  }
+  ierr = DMPlexCreateFromCellListPetsc(comm,dim,nc,nv,nvc,PETSC_TRUE,cells,dim,coords,dm);CHKERRQ(ierr);
+  ierr = PetscFree2(coords,cells);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode CreateCellDM(MPI_Comm comm,AppCtx *user,DM *dm)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  if (user->simplex) {
+    PetscSection s;
+    DM           dmDist;
+    PetscInt     pStart,pEnd,vStart,vEnd,v;
+
+    ierr = CreateSimplexBox(comm,user->dim,user->faces,dm);CHKERRQ(ierr);
+    ierr = DMPlexDistribute(*dm,0,NULL,&dmDist);CHKERRQ(ierr);
+    if (dmDist) {ierr = DMDestroy(dm);CHKERRQ(ierr); *dm = dmDist;}
+    ierr = DMSetFromOptions(*dm);CHKERRQ(ierr);
+    /* one value per vertex */
+    ierr = PetscSectionCreate(comm,&s);CHKERRQ(ierr);
+    ierr = DMPlexGetChart(*dm,&pStart,&pEnd);CHKERRQ(ierr);
+    ierr = DMPlexGetDepthStratum(*dm,0,&vStart,&vEnd);CHKERRQ(ierr);
+    ierr = PetscSectionSetChart(s,pStart,pEnd);CHKERRQ(ierr);
+    for (v = vStart; v < vEnd; ++v) {ierr = PetscSectionSetDof(s,v,1);CHKERRQ(ierr);}
+    ierr = PetscSectionSetUp(s);CHKERRQ(ierr);
+    ierr = DMSetLocalSection(*dm,s);CHKERRQ(ierr);
+    ierr = PetscSectionDestroy(&s);CHKERRQ(ierr);
+  } else {
+    if (user->dim == 2) {
+      ierr = DMDACreate2d(comm,DM_BOUNDARY_NONE,DM_BOUNDARY_NONE,DMDA_STENCIL_BOX,9,9,PETSC_DECIDE,PETSC_DECIDE,1,2,NULL,NULL,dm);CHKERRQ(ierr);
+    } else {
+      ierr = DMDACreate3d(comm,DM_BOUNDARY_NONE,DM_BOUNDARY_NONE,DM_BOUNDARY_NONE,DMDA_STENCIL_BOX,5,5,5,PETSC_DECIDE,PETSC_DECIDE,PETSC_DECIDE,1,2,NULL,NULL,NULL,dm);CHKERRQ(ierr);
+    }
+    ierr = DMDASetElementType(*dm,DMDA_ELEMENT_Q1);CHKERRQ(ierr);
+    ierr = DMSetFromOptions(*dm);CHKERRQ(ierr);
+    ierr = DMSetUp(*dm);CHKERRQ(ierr);
+    ierr = DMDASetUniformCoordinates(*dm,0.0,1.0,0.0,1.0,0.0,1.0);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Sets the nodal values of the linear function 1 + 2x + 3y + 4z */
+static PetscErrorCode SetLinearField(DM dm,AppCtx *user,Vec x)
+{
+  Vec               xl,coordinates;
+  PetscSection      s = NULL,cs = NULL;
+  PetscScalar       *a;
+  const PetscScalar *coords;
+  PetscInt          vStart = 0,vEnd,v,d;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBeginUser;
+  ierr = DMGetLocalVector(dm,&xl);CHKERRQ(ierr);
+  ierr = DMGetCoordinatesLocal(dm,&coordinates);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(coordinates,&coords);CHKERRQ(ierr);
+  ierr = VecGetArray(xl,&a);CHKERRQ(ierr);
+  if (user->simplex) {
+    ierr = DMGetLocalSection(dm,&s);CHKERRQ(ierr);
+    ierr = DMGetCoordinateSection(dm,&cs);CHKERRQ(ierr);
+    ierr = DMPlexGetDepthStratum(dm,0,&vStart,&vEnd);CHKERRQ(ierr);
+  } else {
+    ierr = VecGetLocalSize(xl,&vEnd);CHKERRQ(ierr);
+  }
+  for (v = vStart; v < vEnd; ++v) {
+    PetscInt off = v,coff = user->dim*v;
+
+    if (user->simplex) {
+      ierr = PetscSectionGetOffset(s,v,&off);CHKERRQ(ierr);
+      ierr = PetscSectionGetOffset(cs,v,&coff);CHKERRQ(ierr);
+    }
+    a[off] = 1.0;
+    for (d = 0; d < user->dim; ++d) a[off] += (d+2)*coords[coff+d];
+  }
+  ierr = VecRestoreArray(xl,&a);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(coordinates,&coords);CHKERRQ(ierr);
+  ierr = DMLocalToGlobalBegin(dm,xl,INSERT_VALUES,x);CHKERRQ(ierr);
+  ierr = DMLocalToGlobalEnd(dm,xl,INSERT_VALUES,x);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(dm,&xl);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  DM             dm,sw;
+  Vec            rho,phi;
+  AppCtx         user;
+  PetscReal      *q,*f,*coor,qsum = 0.0,fqsum = 0.0,err = 0.0,gsum[2],lsum[2],gerr;
+  PetscScalar    rhosum,rhophi;
+  PetscInt       nlocal,nglobal,p,d;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = ProcessOptions(PETSC_COMM_WORLD,&user);CHKERRQ(ierr);
+  ierr = CreateCellDM(PETSC_COMM_WORLD,&user,&dm);CHKERRQ(ierr);
+
+  ierr = DMCreate(PETSC_COMM_WORLD,&sw);CHKERRQ(ierr);
+  ierr = DMSetType(sw,DMSWARM);CHKERRQ(ierr);
+  ierr = DMSetDimension(sw,user.dim);CHKERRQ(ierr);
+  ierr = DMSwarmSetType(sw,DMSWARM_PIC);CHKERRQ(ierr);
+  ierr = DMSwarmSetCellDM(sw,dm);CHKERRQ(ierr);
+  ierr = DMSwarmRegisterPetscDatatypeField(sw,"q",1,PETSC_REAL);CHKERRQ(ierr);
+  ierr = DMSwarmRegisterPetscDatatypeField(sw,"f",1,PETSC_REAL);CHKERRQ(ierr);
+  ierr = DMSwarmFinalizeFieldRegister(sw);CHKERRQ(ierr);
+  ierr = DMSwarmSetLocalSizes(sw,4,0);CHKERRQ(ierr);
+  if (user.simplex) {ierr = DMSwarmInsertPointsUsingCellDM(sw,DMSWARMPIC_LAYOUT_GAUSS,3);CHKERRQ(ierr);}
+  else              {ierr = DMSwarmInsertPointsUsingCellDM(sw,DMSWARMPIC_LAYOUT_REGULAR,3);CHKERRQ(ierr);}
+  ierr = DMSwarmGetLocalSize(sw,&nlocal);CHKERRQ(ierr);
+  ierr = DMSwarmGetSize(sw,&nglobal);CHKERRQ(ierr);
+
+  /* a charge which varies with the point, to make the adjointness test meaningful */
+  ierr = DMSwarmGetField(sw,"q",NULL,NULL,(void**)&q);CHKERRQ(ierr);
+  ierr = DMSwarmGetField(sw,DMSwarmPICField_coor,NULL,NULL,(void**)&coor);CHKERRQ(ierr);
+  for (p = 0; p < nlocal; ++p) {
+    q[p] = 1.0 + coor[user.dim*p]*coor[user.dim*p];
+    qsum += q[p];
+  }
+  ierr = DMSwarmRestoreField(sw,DMSwarmPICField_coor,NULL,NULL,(void**)&coor);CHKERRQ(ierr);
+  ierr = DMSwarmRestoreField(sw,"q",NULL,NULL,(void**)&q);CHKERRQ(ierr);
+
+  /* deposition conserves the total charge */
+  ierr = DMCreateGlobalVector(dm,&rho);CHKERRQ(ierr);
+  ierr = DMCreateGlobalVector(dm,&phi);CHKERRQ(ierr);
+  ierr = DMSwarmDepositField(sw,"q",user.type,rho);CHKERRQ(ierr);
+  ierr = VecSum(rho,&rhosum);CHKERRQ(ierr);
+
+  /* interpolation is the transpose of deposition, and is exact for linear fields with CIC and P1 */
+  ierr = SetLinearField(dm,&user,phi);CHKERRQ(ierr);
+  ierr = DMSwarmInterpolateField(sw,phi,user.type,"f");CHKERRQ(ierr);
+  ierr = VecDot(rho,phi,&rhophi);CHKERRQ(ierr);
+  ierr = DMSwarmGetField(sw,"q",NULL,NULL,(void**)&q);CHKERRQ(ierr);
+  ierr = DMSwarmGetField(sw,"f",NULL,NULL,(void**)&f);CHKERRQ(ierr);
+  ierr = DMSwarmGetField(sw,DMSwarmPICField_coor,NULL,NULL,(void**)&coor);CHKERRQ(ierr);
+  for (p = 0; p < nlocal; ++p) {
+    PetscReal exact = 1.0;
+
+    for (d = 0; d < user.dim; ++d) exact += (d+2)*coor[user.dim*p+d];
+    err    = PetscMax(err,PetscAbsReal(f[p] - exact));
+    fqsum += f[p]*q[p];
+  }
+  ierr = DMSwarmRestoreField(sw,DMSwarmPICField_coor,NULL,NULL,(void**)&coor);CHKERRQ(ierr);
+  ierr = DMSwarmRestoreField(sw,"f",NULL,NULL,(void**)&f);CHKERRQ(ierr);
+  ierr = DMSwarmRestoreField(sw,"q",NULL,NULL,(void**)&q);CHKERRQ(ierr);
+  lsum[0] = qsum; lsum[1] = fqsum;
+  ierr = MPIU_Allreduce(lsum,gsum,2,MPIU_REAL,MPIU_SUM,PETSC_COMM_WORLD);CHKERRMPI(ierr);
+  ierr = MPIU_Allreduce(&err,&gerr,1,MPIU_REAL,MPIU_MAX,PETSC_COMM_WORLD);CHKERRMPI(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"%s deposition of %D points\n",DMSwarmDepositTypes[user.type],nglobal);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"  charge conserved: %s\n",PetscAbsReal(PetscRealPart(rhosum) - gsum[0]) < 1.0e-10*gsum[0] ? "yes" : "no");CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"  interpolation is the transpose of deposition: %s\n",PetscAbsReal(PetscRealPart(rhophi) - gsum[1]) < 1.0e-10*PetscAbsReal(gsum[1]) ? "yes" : "no");CHKERRQ(ierr);
+  if (user.type == DMSWARM_DEPOSIT_CIC || user.type == DMSWARM_DEPOSIT_P1) {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"  linear field interpolated exactly: %s\n",gerr < 1.0e-10 ? "yes" : "no");CHKERRQ(ierr);
+  }
+
+  if (user.nbench > 0) {
+    PetscLogDouble t0,t1,t2;
+    PetscInt       i;
+
+    ierr = DMSwarmSortReorder(sw);CHKERRQ(ierr);
+    ierr = MPI_Barrier(PETSC_COMM_WORLD);CHKERRMPI(ierr);
+    ierr = PetscTime(&t0);CHKERRQ(ierr);
+    for (i = 0; i < user.nbench; ++i) {ierr = DMSwarmDepositField(sw,"q",user.type,rho);CHKERRQ(ierr);}
+    ierr = PetscTime(&t1);CHKERRQ(ierr);
+    for (i = 0; i < user.nbench; ++i) {ierr = DMSwarmInterpolateField(sw,phi,user.type,"f");CHKERRQ(ierr);}
+    ierr = PetscTime(&t2);CHKERRQ(ierr);
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"  deposition %g particles/s, interpolation %g particles/s\n",(double)(user.nbench*nglobal/(t1-t0)),(double)(user.nbench*nglobal/(t2-t1)));CHKERRQ(ierr);
+  }
+
+  ierr = VecDestroy(&rho);CHKERRQ(ierr);
+  ierr = VecDestroy(&phi);CHKERRQ(ierr);
+  ierr = DMDestroy(&sw);CHKERRQ(ierr);
+  ierr = DMDestroy(&dm);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+  test:
+    suffix: da_2d
+    nsize: {{1 2}}
+    args: -deposit_type {{ngp cic tsc}separate output}
+
+  test:
+    suffix: da_3d
+    nsize: 2
+    args: -dim 3 -deposit_type {{cic tsc}separate output}
+
+  test:
+    suffix: plex_2d
+    nsize: {{1 2}}
+    args: -simplex -faces 4 -deposit_type p1
+
+  test:
+    suffix: plex_3d
+    args: -simplex -dim 3 -faces 2 -deposit_type p1
+
+TEST*/
@@ -125,6 +125,8 @@ PetscErrorCode  DMInitializePackage(void)
   ierr = PetscLogEventRegister("DMSwarmRmvPnts",         DM_CLASSID,&DMSWARM_RemovePoints);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("DMSwarmSort",            DM_CLASSID,&DMSWARM_Sort);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("DMSwarmSetSizes",        DM_CLASSID,&DMSWARM_SetSizes);CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("DMSwarmDeposit",         DM_CLASSID,&DMSWARM_Deposit);CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("DMSwarmInterp",          DM_CLASSID,&DMSWARM_Interpolate);CHKERRQ(ierr);
   /* Process Info */
   {
     PetscClassId  classids[1];
@@ -7104,6 +7104,8 @@ PetscErrorCode DMLocalizeCoordinates(DM dm)
   Notes:
   To do a search of the local cells of the mesh, v should have PETSC_COMM_SELF as its communicator.
   To do a search of all the cells in the distributed mesh, v should have the same communicator as dm.
+  In the parallel case, each point is first searched among the local cells, and points which are not found are sent to the
+  processes whose local bounding box contains them.
 
   If *cellSF is NULL on input, a PetscSF will be created.
   If *cellSF is not NULL on input, it should point to an existing PetscSF, whose graph will be used as initial guesses.
@@ -0,0 +1,430 @@
+#include <petsc/private/partitionerimpl.h>        /*I "petscpartitioner.h" I*/
+
+const char *const PetscPartitionerSFCCurveTypes[] = {"hilbert", "morton", "PetscPartitionerSFCCurveType", "PETSCPARTITIONER_SFC_", NULL};
+
+typedef struct {
+  PetscPartitionerSFCCurveType curve;  /* The space-filling curve used to order the vertices */
+  PetscInt                     dim;    /* The dimension of the vertex coordinates */
+  PetscInt                     n;      /* The number of local vertices with coordinates */
+  PetscReal                   *coords; /* The coordinates of the local vertices, n*dim */
+} PetscPartitioner_SFC;
+
+/* Skilling's transform of the axis coordinates into the transposed Hilbert index, J. Skilling, "Programming the Hilbert curve", AIP Conf. Proc. 707, 2004 */
+static void PetscSFCAxesToTranspose_Private(PetscInt64 X[], PetscInt b, PetscInt n)
+{
+  const PetscInt64 M = ((PetscInt64) 1) << (b-1);
+  PetscInt64       P, Q, t;
+  PetscInt         i;
+
+  /* Inverse undo */
+  for (Q = M; Q > 1; Q >>= 1) {
+    P = Q - 1;
+    for (i = 0; i < n; ++i) {
+      if (X[i] & Q) X[0] ^= P;
+      else {t = (X[0] ^ X[i]) & P; X[0] ^= t; X[i] ^= t;}
+    }
+  }
+  /* Gray encode */
+  for (i = 1; i < n; ++i) X[i] ^= X[i-1];
+  t = 0;
+  for (Q = M; Q > 1; Q >>= 1) if (X[n-1] & Q) t ^= Q - 1;
+  for (i = 0; i < n; ++i) X[i] ^= t;
+}
+
+/*
+  PetscPartitionerSFCGetNumBits_Internal - The number of bits per coordinate direction used to quantize points, so that keys fit in 62 bits
+*/
+PetscErrorCode PetscPartitionerSFCGetNumBits_Internal(PetscInt dim, PetscInt *bits)
+{
+  PetscFunctionBegin;
+  if (dim < 1 || dim > 3) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Space-filling curves are only supported for dimension 1, 2, or 3, not %D", dim);
+  *bits = PetscMin(62/dim, 31);
+  PetscFunctionReturn(0);
+}
+
+/*
+  PetscPartitionerSFCComputeKeys_Internal - Compute the position of each point along the space-filling curve through the box [lower, upper]
+
+  Input Parameters:
++ curve  - The type of space-filling curve
+. dim    - The coordinate dimension
+. lower  - The lower corner of the bounding box
+. upper  - The upper corner of the bounding box
+. n      - The number of points
+- coords - The point coordinates, n*dim
+
+  Output Parameter:
+. keys   - The curve index of each point, in [0, 2^(bits*dim))
+*/
+PetscErrorCode PetscPartitionerSFCComputeKeys_Internal(PetscPartitionerSFCCurveType curve, PetscInt dim, const PetscReal lower[], const PetscReal upper[], PetscInt n, const PetscReal coords[], PetscInt64 keys[])
+{
+  PetscReal      scale[3];
+  PetscInt64     X[3], maxc;
+  PetscInt       b, v, d, j;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscPartitionerSFCGetNumBits_Internal(dim, &b);CHKERRQ(ierr);
+  maxc = (((PetscInt64) 1) << b) - 1;
+  for (d = 0; d < dim; ++d) scale[d] = upper[d] > lower[d] ? ((PetscReal) maxc)/(upper[d] - lower[d]) : 0.0;
+  for (v = 0; v < n; ++v) {
+    PetscInt64 key = 0;
+
+    for (d = 0; d < dim; ++d) {
+      const PetscReal x = (coords[v*dim+d] - lower[d])*scale[d];
+
+      X[d] = x <= 0.0 ? 0 : (x >= (PetscReal) maxc ? maxc : (PetscInt64) x);
+    }
+    if (curve == PETSCPARTITIONER_SFC_HILBERT && dim > 1) PetscSFCAxesToTranspose_Private(X, b, dim);
+    /* Interleave the bits, most significant first */
+    for (j = b-1; j >= 0; --j) for (d = 0; d < dim; ++d) key = (key << 1) | ((X[d] >> j) & 1);
+    keys[v] = key;
+  }
+  PetscFunctionReturn(0);
+}
+
+static int PetscSFCCompareKeys_Private(const void *a, const void *b, void *ctx)
+{
+  const PetscInt64 ka = *(const PetscInt64 *) a;
+  const PetscInt64 kb = *(const PetscInt64 *) b;
+
+  return ka < kb ? -1 : (ka > kb ? 1 : 0);
+}
+
+/*
+  PetscPartitionerSFCSortKeys_Internal - Compute curve keys for the points and sort them, returning the sorted keys and the permutation taking sorted position to input point
+*/
+PetscErrorCode PetscPartitionerSFCSortKeys_Internal(PetscPartitionerSFCCurveType curve, PetscInt dim, const PetscReal lower[], const PetscReal upper[], PetscInt n, const PetscReal coords[], PetscInt64 keys[], PetscInt perm[])
+{
+  PetscInt       v;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscPartitionerSFCComputeKeys_Internal(curve, dim, lower, upper, n, coords, keys);CHKERRQ(ierr);
+  for (v = 0; v < n; ++v) perm[v] = v;
+  if (n > 1) {ierr = PetscTimSortWithArray(n, keys, sizeof(PetscInt64), perm, sizeof(PetscInt), PetscSFCCompareKeys_Private, NULL);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscPartitionerReset_SFC(PetscPartitioner part)
+{
+  PetscPartitioner_SFC *p = (PetscPartitioner_SFC *) part->data;
+  PetscErrorCode        ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree(p->coords);CHKERRQ(ierr);
+  p->dim = 0;
+  p->n   = 0;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscPartitionerDestroy_SFC(PetscPartitioner part)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscPartitionerReset_SFC(part);CHKERRQ(ierr);
+  ierr = PetscFree(part->data);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscPartitionerView_SFC_ASCII(PetscPartitioner part, PetscViewer viewer)
+{
+  PetscPartitioner_SFC *p = (PetscPartitioner_SFC *) part->data;
+  PetscErrorCode        ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscViewerASCIIPushTab(viewer);CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer, "Space-filling curve: %s\n", PetscPartitionerSFCCurveTypes[p->curve]);CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPopTab(viewer);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscPartitionerView_SFC(PetscPartitioner part, PetscViewer viewer)
+{
+  PetscBool      iascii;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(part, PETSCPARTITIONER_CLASSID, 1);
+  PetscValidHeaderSpecific(viewer, PETSC_VIEWER_CLASSID, 2);
+  ierr = PetscObjectTypeCompare((PetscObject) viewer, PETSCVIEWERASCII, &iascii);CHKERRQ(ierr);
+  if (iascii) {ierr = PetscPartitionerView_SFC_ASCII(part, viewer);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscPartitionerSetFromOptions_SFC(PetscOptionItems *PetscOptionsObject, PetscPartitioner part)
+{
+  PetscPartitioner_SFC *p = (PetscPartitioner_SFC *) part->data;
+  PetscErrorCode        ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject, "PetscPartitioner SFC Options");CHKERRQ(ierr);
+  ierr = PetscOptionsEnum("-petscpartitioner_sfc_curve", "The space-filling curve used to order vertices", "PetscPartitionerSFCSetCurveType", PetscPartitionerSFCCurveTypes, (PetscEnum) p->curve, (PetscEnum *) &p->curve, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+  The vertices are sorted locally along the curve, and the global curve is cut into nparts pieces of the target weight. The cut
+  points are found by simultaneous bisection on the key space, one reduction per bit, so that no global sort is necessary. Vertices
+  sharing the key at a cut are split in rank order, so the partition is exactly balanced up to the weight of a single vertex.
+*/
+static PetscErrorCode PetscPartitionerPartition_SFC(PetscPartitioner part, PetscInt nparts, PetscInt numVertices, PetscInt start[], PetscInt adjacency[], PetscSection vertSection, PetscSection targetSection, PetscSection partSection, IS *partition)
+{
+  PetscPartitioner_SFC *p = (PetscPartitioner_SFC *) part->data;
+  MPI_Comm              comm;
+  PetscReal             lower[3], upper[3], glower[3], gupper[3];
+  PetscInt64           *keys, *wsum, *target, *lo, *hi, *lcnt, *gcnt, *tieOff, *tieW, W = 0, maxKey;
+  PetscInt             *perm, bits, dim = p->dim, np, v, d, it;
+  PetscErrorCode        ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject) part, &comm);CHKERRQ(ierr);
+  if (numVertices && !p->coords) SETERRQ(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "SFC partitioner needs vertex coordinates. Please call PetscPartitionerSFCSetCoordinates()");
+  if (p->coords && p->n != numVertices) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ, "Number of input vertices %D != %D vertices with coordinates", numVertices, p->n);
+  ierr = MPIU_Allreduce(&p->dim, &dim, 1, MPIU_INT, MPI_MAX, comm);CHKERRMPI(ierr);
+  if (!dim) dim = 1;
+  ierr = PetscPartitionerSFCGetNumBits_Internal(dim, &bits);CHKERRQ(ierr);
+  maxKey = ((PetscInt64) 1) << (bits*dim);
+  /* Global bounding box */
+  for (d = 0; d < dim; ++d) {lower[d] = PETSC_MAX_REAL; upper[d] = PETSC_MIN_REAL;}
+  for (v = 0; v < numVertices; ++v) {
+    for (d = 0; d < dim; ++d) {
+      lower[d] = PetscMin(lower[d], p->coords[v*dim+d]);
+      upper[d] = PetscMax(upper[d], p->coords[v*dim+d]);
+    }
+  }
+  ierr = MPIU_Allreduce(lower, glower, dim, MPIU_REAL, MPI_MIN, comm);CHKERRMPI(ierr);
+  ierr = MPIU_Allreduce(upper, gupper, dim, MPIU_REAL, MPI_MAX, comm);CHKERRMPI(ierr);
+  /* Local sort along the curve, with prefix sums of vertex weights */
+  ierr = PetscMalloc2(numVertices, &keys, numVertices+1, &wsum);CHKERRQ(ierr);
+  ierr = PetscMalloc1(numVertices, &perm);CHKERRQ(ierr);
+  ierr = PetscPartitionerSFCSortKeys_Internal(p->curve, dim, glower, gupper, numVertices, p->coords, keys, perm);CHKERRQ(ierr);
+  wsum[0] = 0;
+  for (v = 0; v < numVertices; ++v) {
+    PetscInt w = 1;
+
+    if (vertSection) {ierr = PetscSectionGetDof(vertSection, perm[v], &w);CHKERRQ(ierr);}
+    wsum[v+1] = wsum[v] + w;
+  }
+  ierr = MPIU_Allreduce(&wsum[numVertices], &W, 1, MPIU_INT64, MPI_SUM, comm);CHKERRMPI(ierr);
+  /* Weight before each cut: target[np] for np = 1..nparts-1 */
+  ierr = PetscMalloc7(nparts, &target, nparts, &lo, nparts, &hi, nparts, &lcnt, nparts, &gcnt, nparts, &tieOff, nparts, &tieW);CHKERRQ(ierr);
+  target[0] = 0;
+  {
+    PetscInt64 sumw = 0;
+
+    if (targetSection) {
+      for (np = 0; np < nparts; ++np) {
+        PetscInt tw;
+
+        ierr = PetscSectionGetDof(targetSection, np, &tw);CHKERRQ(ierr);
+        sumw += tw;
+      }
+    }
+    if (sumw) {
+      PetscInt64 cumw = 0;
+
+      for (np = 1; np < nparts; ++np) {
+        PetscInt tw;
+
+        ierr = PetscSectionGetDof(targetSection, np-1, &tw);CHKERRQ(ierr);
+        cumw      += tw;
+        target[np] = (PetscInt64) ((((PetscReal) cumw)/((PetscReal) sumw))*((PetscReal) W) + 0.5);
+      }
+    } else {
+      for (np = 1; np < nparts; ++np) target[np] = np*(W/nparts) + PetscMin(W % nparts, np);
+    }
+  }
+  /* Bisection for the smallest key such that the weight of vertices with keys <= it exceeds the target */
+  for (np = 0; np < nparts; ++np) {lo[np] = 0; hi[np] = maxKey;}
+  for (it = 0; it <= bits*dim; ++it) {
+    for (np = 1; np < nparts; ++np) {
+      const PetscInt64 mid = lo[np] + (hi[np] - lo[np])/2;
+      PetscInt         l = 0, h = numVertices;
+
+      while (l < h) {const PetscInt m = l + (h - l)/2; if (keys[m] <= mid) l = m+1; else h = m;}
+      lcnt[np] = wsum[l];
+    }
+    ierr = MPIU_Allreduce(&lcnt[1], &gcnt[1], nparts-1, MPIU_INT64, MPI_SUM, comm);CHKERRMPI(ierr);
+    for (np = 1; np < nparts; ++np) {
+      const PetscInt64 mid = lo[np] + (hi[np] - lo[np])/2;
+
+      if (lo[np] >= hi[np]) continue;
+      if (gcnt[np] > target[np]) hi[np] = mid;
+      else                       lo[np] = mid+1;
+    }
+  }
+  /* Global weight strictly before each cut key, and the rank offset among the vertices sharing that key */
+  for (np = 1; np < nparts; ++np) {
+    PetscInt l = 0, h = numVertices, e;
+
+    while (l < h) {const PetscInt m = l + (h - l)/2; if (keys[m] < lo[np]) l = m+1; else h = m;}
+    for (e = l; e < numVertices && keys[e] == lo[np]; ++e);
+    lcnt[np]   = wsum[l];
+    tieW[np]   = wsum[e] - wsum[l];
+    tieOff[np] = 0;
+  }
+  ierr = MPIU_Allreduce(&lcnt[1], &gcnt[1], nparts-1, MPIU_INT64, MPI_SUM, comm);CHKERRMPI(ierr);
+  ierr = MPI_Exscan(&tieW[1], &tieOff[1], nparts-1, MPIU_INT64, MPI_SUM, comm);CHKERRMPI(ierr);
+  {
+    PetscMPIInt rank;
+
+    ierr = MPI_Comm_rank(comm, &rank);CHKERRMPI(ierr);
+    if (!rank) for (np = 1; np < nparts; ++np) tieOff[np] = 0;
+  }
+  /* Vertices are in curve order, so the part number is nondecreasing */
+  for (v = 0, np = 0; v < numVertices; ++v) {
+    while (np+1 < nparts) {
+      const PetscInt64 cut = lo[np+1];
+
+      if (keys[v] > cut) ++np;
+      else if (keys[v] == cut) {
+        PetscInt l = 0, h = v;
+
+        while (l < h) {const PetscInt m = l + (h - l)/2; if (keys[m] < cut) l = m+1; else h = m;}
+        if (gcnt[np+1] + tieOff[np+1] + wsum[v] - wsum[l] >= target[np+1]) ++np;
+        else break;
+      } else break;
+    }
+    ierr = PetscSectionAddDof(partSection, np, 1);CHKERRQ(ierr);
+  }
+  ierr = PetscFree7(target, lo, hi, lcnt, gcnt, tieOff, tieW);CHKERRQ(ierr);
+  ierr = PetscFree2(keys, wsum);CHKERRQ(ierr);
+  ierr = ISCreateGeneral(PETSC_COMM_SELF, numVertices, perm, PETSC_OWN_POINTER, partition);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscPartitionerInitialize_SFC(PetscPartitioner part)
+{
+  PetscFunctionBegin;
+  part->noGraph             = PETSC_TRUE;
+  part->ops->view           = PetscPartitionerView_SFC;
+  part->ops->setfromoptions = PetscPartitionerSetFromOptions_SFC;
+  part->ops->reset          = PetscPartitionerReset_SFC;
+  part->ops->destroy        = PetscPartitionerDestroy_SFC;
+  part->ops->partition      = PetscPartitionerPartition_SFC;
+  PetscFunctionReturn(0);
+}
+
+/*MC
+  PETSCPARTITIONERSFC = "sfc" - A PetscPartitioner object which cuts a space-filling curve through the vertex coordinates
+
+  Level: intermediate
+
+  Options Database Keys:
+.  -petscpartitioner_sfc_curve <hilbert,morton> - The space-filling curve
+
+  Notes:
+  The partitioner does not use the connectivity graph, only the coordinates given by PetscPartitionerSFCSetCoordinates(),
+  which PetscPartitionerDMPlexPartition() sets to the cell centroids. Vertex weights are respected. The cost is a local sort
+  and a fixed number of small reductions, so it is suitable for the initial distribution of very large meshes. Each part is
+  a contiguous piece of the curve, and the points in each part are listed in curve order.
+
+.seealso: PetscPartitionerType, PetscPartitionerCreate(), PetscPartitionerSetType(), PetscPartitionerSFCSetCoordinates(), DMPlexGetOrderingSFC()
+M*/
+
+PETSC_EXTERN PetscErrorCode PetscPartitionerCreate_SFC(PetscPartitioner part)
+{
+  PetscPartitioner_SFC *p;
+  PetscErrorCode        ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(part, PETSCPARTITIONER_CLASSID, 1);
+  ierr       = PetscNewLog(part, &p);CHKERRQ(ierr);
+  part->data = p;
+
+  ierr = PetscPartitionerInitialize_SFC(part);CHKERRQ(ierr);
+  p->curve = PETSCPARTITIONER_SFC_HILBERT;
+  PetscFunctionReturn(0);
+}
+
+/*@C
+  PetscPartitionerSFCSetCoordinates - Set the coordinates of the local vertices to be partitioned
+
+  Not Collective
+
+  Input Parameters:
++ part   - The PetscPartitioner
+. dim    - The coordinate dimension, at most 3
+. n      - The number of local vertices
+- coords - array of length n*dim with the coordinates of each vertex
+
+  Level: developer
+
+  Notes:
+    It is safe to free the coords array after use in this routine. PetscPartitionerDMPlexPartition() calls this with the cell centroids.
+
+.seealso PetscPartitionerSFCSetCurveType(), PetscPartitionerDMPlexPartition(), PETSCPARTITIONERSFC
+@*/
+PetscErrorCode PetscPartitionerSFCSetCoordinates(PetscPartitioner part, PetscInt dim, PetscInt n, const PetscReal coords[])
+{
+  PetscPartitioner_SFC *p = (PetscPartitioner_SFC *) part->data;
+  PetscInt              bits;
+  PetscErrorCode        ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecificType(part, PETSCPARTITIONER_CLASSID, 1, PETSCPARTITIONERSFC);
+  if (n) PetscValidRealPointer(coords, 4);
+  ierr = PetscPartitionerSFCGetNumBits_Internal(dim, &bits);CHKERRQ(ierr);
+  ierr = PetscFree(p->coords);CHKERRQ(ierr);
+  ierr = PetscMalloc1(n*dim, &p->coords);CHKERRQ(ierr);
+  ierr = PetscArraycpy(p->coords, coords, n*dim);CHKERRQ(ierr);
+  p->dim = dim;
+  p->n   = n;
+  PetscFunctionReturn(0);
+}
+
+/*@
+  PetscPartitionerSFCSetCurveType - Set the space-filling curve used to order the vertices
+
+  Logically Collective on PetscPartitioner
+
+  Input Parameters:
++ part  - The PetscPartitioner
+- curve - The curve type, PETSCPARTITIONER_SFC_HILBERT or PETSCPARTITIONER_SFC_MORTON
+
+  Options Database:
+. -petscpartitioner_sfc_curve <hilbert,morton> - The space-filling curve
+
+  Level: intermediate
+
+.seealso PetscPartitionerSFCGetCurveType(), PetscPartitionerCreate()
+@*/
+PetscErrorCode PetscPartitionerSFCSetCurveType(PetscPartitioner part, PetscPartitionerSFCCurveType curve)
+{
+  PetscPartitioner_SFC *p = (PetscPartitioner_SFC *) part->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecificType(part, PETSCPARTITIONER_CLASSID, 1, PETSCPARTITIONERSFC);
+  PetscValidLogicalCollectiveEnum(part, curve, 2);
+  p->curve = curve;
+  PetscFunctionReturn(0);
+}
+
+/*@
+  PetscPartitionerSFCGetCurveType - Get the space-filling curve used to order the vertices
+
+  Not Collective
+
+  Input Parameter:
+. part  - The PetscPartitioner
+
+  Output Parameter:
+. curve - The curve type
+
+  Level: intermediate
+
+.seealso PetscPartitionerSFCSetCurveType(), PetscPartitionerCreate()
+@*/
+PetscErrorCode PetscPartitionerSFCGetCurveType(PetscPartitioner part, PetscPartitionerSFCCurveType *curve)
+{
+  PetscPartitioner_SFC *p = (PetscPartitioner_SFC *) part->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecificType(part, PETSCPARTITIONER_CLASSID, 1, PETSCPARTITIONERSFC);
+  PetscValidPointer(curve, 2);
+  *curve = p->curve;
+  PetscFunctionReturn(0);
+}
@@ -2,6 +2,27 @@ static char help[] = "Tests PetscPartitioner.\n\n";
 
 #include <petscpartitioner.h>
 
+/* The SFC partitioner needs coordinates: place the graph vertices, numbered offset to offset+n-1, on a circle */
+static PetscErrorCode SetSFCCoordinates(PetscPartitioner p, PetscInt n, PetscInt offset, PetscInt total)
+{
+  PetscReal      *coords;
+  PetscInt        i;
+  PetscBool       issfc;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)p,PETSCPARTITIONERSFC,&issfc);CHKERRQ(ierr);
+  if (!issfc) PetscFunctionReturn(0);
+  ierr = PetscMalloc1(2*n,&coords);CHKERRQ(ierr);
+  for (i = 0; i < n; i++) {
+    coords[2*i]   = PetscCosReal(2.0*PETSC_PI*(offset+i)/total);
+    coords[2*i+1] = PetscSinReal(2.0*PETSC_PI*(offset+i)/total);
+  }
+  ierr = PetscPartitionerSFCSetCoordinates(p,2,n,coords);CHKERRQ(ierr);
+  ierr = PetscFree(coords);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 int main(int argc, char **argv)
 {
   PetscErrorCode   ierr;
@@ -86,8 +107,10 @@ int main(int argc, char **argv)
 
   /* test partitioning a graph on one process only (not main) */
   if (rank == size - 1) {
+    ierr = SetSFCCoordinates(p,nv,0,nv);CHKERRQ(ierr);
     ierr = PetscPartitionerPartition(p,nparts,nv,vv,vadj,vertexSection,targetSection,partSection,&partition);CHKERRQ(ierr);
   } else {
+    ierr = SetSFCCoordinates(p,0,0,nv);CHKERRQ(ierr);
     ierr = PetscPartitionerPartition(p,nparts,0,NULL,NULL,vertexSection,targetSection,partSection,&partition);CHKERRQ(ierr);
   }
   ierr = PetscObjectSetName((PetscObject)partSection,"SEQ SECTION");CHKERRQ(ierr);
@@ -103,10 +126,13 @@ int main(int argc, char **argv)
 
   /* test partitioning a graph on a subset of the processess only */
   if (rank%2) {
+    ierr = SetSFCCoordinates(p,0,0,1);CHKERRQ(ierr);
     ierr = PetscPartitionerPartition(p,nparts,0,NULL,NULL,NULL,targetSection,partSection,&partition);CHKERRQ(ierr);
   } else {
     PetscInt i,totv = nv*((size+1)/2),*pvadj;
 
+    ierr = SetSFCCoordinates(p,nv,nv*(rank/2),totv);CHKERRQ(ierr);
+
     ierr = PetscMalloc1(2*nv,&pvadj);CHKERRQ(ierr);
     for (i = 0; i < nv; i++) {
       pvadj[2*i]   = (nv*(rank/2) + totv + i - 1)%totv;
@@ -162,6 +188,11 @@ finally:
     nsize: {{1 2 3}separate output}
     args: -nparts {{1 2 3}separate output} -petscpartitioner_type gather -petscpartitioner_view -petscpartitioner_view_graph
 
+  test:
+    suffix: sfc
+    nsize: {{1 2 3}separate output}
+    args: -nparts {{2 3}separate output} -vwgts -petscpartitioner_type sfc -petscpartitioner_sfc_curve {{hilbert morton}separate output} -petscpartitioner_view
+
   test:
     requires: parmetis
     suffix: parmetis
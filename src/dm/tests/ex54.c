@@ -0,0 +1,164 @@
+static char help[] = "Tests the matrix-free DMDA stencil operator against the assembled matrix.\n\n";
+
+#include <petscdmda.h>
+
+/* assemble the same operator with MatSetValuesStencil(), dropping the couplings to points outside a non-periodic domain */
+static PetscErrorCode AssembleStencil(DM da,const PetscScalar coeff[],Vec vcoeff,Mat *A)
+{
+  DM             cda;
+  DMBoundaryType bx,by,bz;
+  PetscInt       dim,M,N,P,nq,*off,xs,ys,zs,xm,ym,zm,i,j,k,q,n;
+  PetscScalar    ****vc = NULL,*vals;
+  MatStencil     row,*cols;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = DMDAGetInfo(da,&dim,&M,&N,&P,NULL,NULL,NULL,NULL,NULL,&bx,&by,&bz,NULL);CHKERRQ(ierr);
+  ierr = DMDAGetStencilOffsets(da,&nq,&off);CHKERRQ(ierr);
+  ierr = DMCreateMatrix(da,A);CHKERRQ(ierr);
+  ierr = DMDAGetCorners(da,&xs,&ys,&zs,&xm,&ym,&zm);CHKERRQ(ierr);
+  ierr = PetscMalloc2(nq,&cols,nq,&vals);CHKERRQ(ierr);
+  if (vcoeff) {
+    ierr = VecGetDM(vcoeff,&cda);CHKERRQ(ierr);
+    ierr = DMDAVecGetArrayDOFRead(cda,vcoeff,&vc);CHKERRQ(ierr);
+  }
+  for (k = zs; k < zs+zm; ++k) {
+    for (j = ys; j < ys+ym; ++j) {
+      for (i = xs; i < xs+xm; ++i) {
+        row.i = i; row.j = j; row.k = k; row.c = 0;
+        for (q = 0, n = 0; q < nq; ++q) {
+          PetscInt ci = i + off[q*dim],cj = dim > 1 ? j + off[q*dim+1] : 0,ck = dim > 2 ? k + off[q*dim+2] : 0;
+
+          if (bx != DM_BOUNDARY_PERIODIC && (ci < 0 || ci >= M)) continue;
+          if (by != DM_BOUNDARY_PERIODIC && (cj < 0 || cj >= N)) continue;
+          if (bz != DM_BOUNDARY_PERIODIC && (ck < 0 || ck >= P)) continue;
+          cols[n].i = ci; cols[n].j = cj; cols[n].k = ck; cols[n].c = 0;
+          if (!vc)           vals[n] = coeff[q];
+          else if (dim == 1) vals[n] = ((PetscScalar**)vc)[i][q];
+          else if (dim == 2) vals[n] = ((PetscScalar***)vc)[j][i][q];
+          else               vals[n] = vc[k][j][i][q];
+          ++n;
+        }
+        ierr = MatSetValuesStencil(*A,1,&row,n,cols,vals,ADD_VALUES);CHKERRQ(ierr);
+      }
+    }
+  }
+  if (vcoeff) {ierr = DMDAVecRestoreArrayDOFRead(cda,vcoeff,&vc);CHKERRQ(ierr);}
+  ierr = MatAssemblyBegin(*A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(*A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = PetscFree2(cols,vals);CHKERRQ(ierr);
+  ierr = PetscFree(off);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  DM              da,cda = NULL;
+  DMBoundaryType  bt = DM_BOUNDARY_NONE;
+  DMDAStencilType st;
+  Mat             A,B;
+  Vec             x,y,z,vcoeff = NULL;
+  PetscRandom     rnd;
+  PetscScalar     *coeff = NULL;
+  PetscReal       nrm,err;
+  PetscInt        dim = 2,s = 1,n = 9,nq,q,its = 0,it;
+  PetscBool       box = PETSC_FALSE,variable = PETSC_FALSE;
+  PetscLogDouble  t0,t1;
+  PetscErrorCode  ierr;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = PetscOptionsBegin(PETSC_COMM_WORLD,NULL,"DMDA stencil operator test","DM");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-dim","The dimension","ex54.c",dim,&dim,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-n","The number of nodes in each direction","ex54.c",n,&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-s","The stencil width","ex54.c",s,&s,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-box","Use a box stencil instead of a star stencil","ex54.c",box,&box,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnum("-boundary","The boundary type","ex54.c",DMBoundaryTypes,(PetscEnum)bt,(PetscEnum*)&bt,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-variable","Use variable coefficients","ex54.c",variable,&variable,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-benchmark","Time this many products with each operator","ex54.c",its,&its,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();CHKERRQ(ierr);
+  st   = box ? DMDA_STENCIL_BOX : DMDA_STENCIL_STAR;
+
+  if (dim == 1)      {ierr = DMDACreate1d(PETSC_COMM_WORLD,bt,n,1,s,NULL,&da);CHKERRQ(ierr);}
+  else if (dim == 2) {ierr = DMDACreate2d(PETSC_COMM_WORLD,bt,bt,st,n,n,PETSC_DECIDE,PETSC_DECIDE,1,s,NULL,NULL,&da);CHKERRQ(ierr);}
+  else               {ierr = DMDACreate3d(PETSC_COMM_WORLD,bt,bt,bt,st,n,n,n,PETSC_DECIDE,PETSC_DECIDE,PETSC_DECIDE,1,s,NULL,NULL,NULL,&da);CHKERRQ(ierr);}
+  ierr = DMSetFromOptions(da);CHKERRQ(ierr);
+  ierr = DMSetUp(da);CHKERRQ(ierr);
+
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rnd);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rnd);CHKERRQ(ierr);
+  ierr = DMDAGetStencilOffsets(da,&nq,NULL);CHKERRQ(ierr);
+  if (variable) {
+    ierr = DMDACreateCompatibleDMDA(da,nq,&cda);CHKERRQ(ierr);
+    ierr = DMCreateGlobalVector(cda,&vcoeff);CHKERRQ(ierr);
+    ierr = VecSetRandom(vcoeff,rnd);CHKERRQ(ierr);
+  } else {
+    ierr = PetscMalloc1(nq,&coeff);CHKERRQ(ierr);
+    for (q = 0; q < nq; ++q) coeff[q] = 1.0 + q;
+  }
+  ierr = DMDACreateStencilOperator(da,coeff,vcoeff,&A);CHKERRQ(ierr);
+  ierr = AssembleStencil(da,coeff,vcoeff,&B);CHKERRQ(ierr);
+
+  ierr = DMCreateGlobalVector(da,&x);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&y);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&z);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,rnd);CHKERRQ(ierr);
+  ierr = MatMult(A,x,y);CHKERRQ(ierr);
+  ierr = MatMult(B,x,z);CHKERRQ(ierr);
+  ierr = VecNorm(z,NORM_2,&nrm);CHKERRQ(ierr);
+  ierr = VecAXPY(y,-1.0,z);CHKERRQ(ierr);
+  ierr = VecNorm(y,NORM_2,&err);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"%D-point stencil, product %s\n",nq,err <= 100*PETSC_MACHINE_EPSILON*nrm ? "matches the assembled matrix" : "DIFFERS from the assembled matrix");CHKERRQ(ierr);
+  ierr = MatGetDiagonal(A,y);CHKERRQ(ierr);
+  ierr = MatGetDiagonal(B,z);CHKERRQ(ierr);
+  ierr = VecAXPY(y,-1.0,z);CHKERRQ(ierr);
+  ierr = VecNorm(y,NORM_2,&err);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"diagonal %s\n",err == 0.0 ? "matches the assembled matrix" : "DIFFERS from the assembled matrix");CHKERRQ(ierr);
+
+  if (its) {
+    ierr = PetscTime(&t0);CHKERRQ(ierr);
+    for (it = 0; it < its; ++it) {ierr = MatMult(A,x,y);CHKERRQ(ierr);}
+    ierr = PetscTime(&t1);CHKERRQ(ierr);
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"stencil operator:  %g s per product\n",(double)((t1-t0)/its));CHKERRQ(ierr);
+    ierr = PetscTime(&t0);CHKERRQ(ierr);
+    for (it = 0; it < its; ++it) {ierr = MatMult(B,x,y);CHKERRQ(ierr);}
+    ierr = PetscTime(&t1);CHKERRQ(ierr);
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"assembled matrix:  %g s per product\n",(double)((t1-t0)/its));CHKERRQ(ierr);
+  }
+
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&z);CHKERRQ(ierr);
+  ierr = VecDestroy(&vcoeff);CHKERRQ(ierr);
+  ierr = PetscFree(coeff);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rnd);CHKERRQ(ierr);
+  ierr = DMDestroy(&cda);CHKERRQ(ierr);
+  ierr = DMDestroy(&da);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+  test:
+    suffix: 1d
+    nsize: {{1 3}}
+    args: -dim 1 -n 20 -s 2 -boundary {{none periodic}}
+
+  test:
+    suffix: 2d
+    nsize: {{1 4}}
+    args: -box {{0 1}separate output} -boundary {{none periodic ghosted}} -variable {{0 1}}
+
+  test:
+    suffix: 2d_tiled
+    nsize: 2
+    args: -n 23 -s 2 -box -da_stencil_operator_tile 4,3
+
+  test:
+    suffix: 3d
+    nsize: {{1 4}}
+    args: -dim 3 -n 7 -box {{0 1}separate output} -boundary {{none periodic}} -variable {{0 1}} -da_stencil_operator_tile 3,2
+
+TEST*/
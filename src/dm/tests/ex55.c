@@ -0,0 +1,107 @@
+static char help[] = "Tests the DMDA ghost exchange with MPI datatypes against the VecScatter.\n\n";
+
+#include <petscdmda.h>
+
+int main(int argc,char **argv)
+{
+  DM              da;
+  DMBoundaryType  bt = DM_BOUNDARY_NONE;
+  Vec             g,l1,l2;
+  PetscInt        dim = 2,dof = 1,s = 1,n = 8,i,its = 0,it;
+  PetscBool       box = PETSC_FALSE,flg;
+  PetscReal       err;
+  PetscLogDouble  t0,t1;
+  PetscErrorCode  ierr;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = PetscOptionsBegin(PETSC_COMM_WORLD,NULL,"DMDA ghost exchange test","DM");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-dim","The dimension","ex55.c",dim,&dim,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-n","The number of nodes in each direction","ex55.c",n,&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-dof","The number of degrees of freedom per node","ex55.c",dof,&dof,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-s","The stencil width","ex55.c",s,&s,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-box","Use a box stencil instead of a star stencil","ex55.c",box,&box,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnum("-boundary","The boundary type","ex55.c",DMBoundaryTypes,(PetscEnum)bt,(PetscEnum*)&bt,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-benchmark","Time this many exchanges with each method","ex55.c",its,&its,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();CHKERRQ(ierr);
+
+  if (dim == 1)      {ierr = DMDACreate1d(PETSC_COMM_WORLD,bt,n,dof,s,NULL,&da);CHKERRQ(ierr);}
+  else if (dim == 2) {ierr = DMDACreate2d(PETSC_COMM_WORLD,bt,bt,box ? DMDA_STENCIL_BOX : DMDA_STENCIL_STAR,n,n,PETSC_DECIDE,PETSC_DECIDE,dof,s,NULL,NULL,&da);CHKERRQ(ierr);}
+  else               {ierr = DMDACreate3d(PETSC_COMM_WORLD,bt,bt,bt,box ? DMDA_STENCIL_BOX : DMDA_STENCIL_STAR,n,n,n,PETSC_DECIDE,PETSC_DECIDE,PETSC_DECIDE,dof,s,NULL,NULL,NULL,&da);CHKERRQ(ierr);}
+  ierr = DMSetFromOptions(da);CHKERRQ(ierr);
+  ierr = DMSetUp(da);CHKERRQ(ierr);
+
+  /* the global index of each value, so that any misplaced value shows up */
+  ierr = DMCreateGlobalVector(da,&g);CHKERRQ(ierr);
+  {
+    PetscScalar *a;
+    PetscInt    rstart,nlocal;
+
+    ierr = VecGetOwnershipRange(g,&rstart,NULL);CHKERRQ(ierr);
+    ierr = VecGetLocalSize(g,&nlocal);CHKERRQ(ierr);
+    ierr = VecGetArray(g,&a);CHKERRQ(ierr);
+    for (i = 0; i < nlocal; ++i) a[i] = 1.0 + rstart + i;
+    ierr = VecRestoreArray(g,&a);CHKERRQ(ierr);
+  }
+  ierr = DMCreateLocalVector(da,&l1);CHKERRQ(ierr);
+  ierr = VecDuplicate(l1,&l2);CHKERRQ(ierr);
+  ierr = VecZeroEntries(l1);CHKERRQ(ierr);
+  ierr = VecZeroEntries(l2);CHKERRQ(ierr);
+
+  ierr = DMDASetGhostExchangeDatatypes(da,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalBegin(da,g,INSERT_VALUES,l1);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalEnd(da,g,INSERT_VALUES,l1);CHKERRQ(ierr);
+  ierr = DMDASetGhostExchangeDatatypes(da,PETSC_TRUE);CHKERRQ(ierr);
+  ierr = DMDAGetGhostExchangeDatatypes(da,&flg);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalBegin(da,g,INSERT_VALUES,l2);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalEnd(da,g,INSERT_VALUES,l2);CHKERRQ(ierr);
+  ierr = VecAXPY(l2,-1.0,l1);CHKERRQ(ierr);
+  ierr = VecNorm(l2,NORM_INFINITY,&err);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(MPI_IN_PLACE,&err,1,MPIU_REAL,MPIU_MAX,PETSC_COMM_WORLD);CHKERRMPI(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"ghost exchange with datatypes %s: local vector %s the scatter\n",flg ? "on" : "off",err == 0.0 ? "matches" : "DIFFERS from");CHKERRQ(ierr);
+
+  if (its) {
+    for (i = 0; i < 2; ++i) {
+      flg  = (PetscBool)i;
+      ierr = DMDASetGhostExchangeDatatypes(da,flg);CHKERRQ(ierr);
+      ierr = MPI_Barrier(PETSC_COMM_WORLD);CHKERRMPI(ierr);
+      ierr = PetscTime(&t0);CHKERRQ(ierr);
+      for (it = 0; it < its; ++it) {
+        ierr = DMGlobalToLocalBegin(da,g,INSERT_VALUES,l1);CHKERRQ(ierr);
+        ierr = DMGlobalToLocalEnd(da,g,INSERT_VALUES,l1);CHKERRQ(ierr);
+      }
+      ierr = PetscTime(&t1);CHKERRQ(ierr);
+      ierr = PetscPrintf(PETSC_COMM_WORLD,"%s: %g s per exchange\n",flg ? "datatypes" : "scatter  ",(double)((t1-t0)/its));CHKERRQ(ierr);
+    }
+  }
+
+  ierr = VecDestroy(&g);CHKERRQ(ierr);
+  ierr = VecDestroy(&l1);CHKERRQ(ierr);
+  ierr = VecDestroy(&l2);CHKERRQ(ierr);
+  ierr = DMDestroy(&da);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+  test:
+    suffix: 1d
+    nsize: {{1 3}}
+    args: -dim 1 -n 12 -s 2 -dof 2 -boundary {{none periodic ghosted}}
+
+  test:
+    suffix: 2d
+    nsize: {{1 2 4}}
+    args: -box {{0 1}} -boundary {{none periodic ghosted}} -dof {{1 3}}
+
+  test:
+    suffix: 3d
+    nsize: {{1 4 8}}
+    args: -dim 3 -n 6 -box {{0 1}} -boundary {{none periodic}} -s {{1 2}}
+
+  test:
+    suffix: options
+    nsize: 2
+    args: -da_ghost_exchange_datatypes -dim 3 -n 6 -box
+
+TEST*/
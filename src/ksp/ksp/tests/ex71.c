@@ -0,0 +1,105 @@
+
+static char help[] = "Solves the Laplacian on a tensor product grid, K x M + M x K, stored as a MATKRONECKER matrix with PCKRONECKER.\n\
+  -na <n>, -nb <n> : number of interior nodes in each direction\n\
+  -nterms <1,2>    : solve with K x K instead\n\n";
+
+#include <petscksp.h>
+
+/* the 1d finite element stiffness (mass = PETSC_FALSE) or mass matrix with Dirichlet conditions */
+static PetscErrorCode Create1d(MPI_Comm comm,PetscInt n,PetscBool mass,Mat *A)
+{
+  PetscInt       i,rstart,rend,col[3];
+  PetscScalar    v[3],h = 1.0/(n+1);
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = MatCreateAIJ(comm,PETSC_DECIDE,PETSC_DECIDE,n,n,3,NULL,1,NULL,A);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(*A,&rstart,&rend);CHKERRQ(ierr);
+  if (mass) {v[0] = h/6.0; v[1] = 4.0*h/6.0; v[2] = h/6.0;}
+  else {v[0] = -1.0/h; v[1] = 2.0/h; v[2] = -1.0/h;}
+  for (i=rstart; i<rend; i++) {
+    col[0] = i-1; col[1] = i; col[2] = i+1;
+    if (i == 0) {
+      ierr = MatSetValues(*A,1,&i,2,col+1,v+1,INSERT_VALUES);CHKERRQ(ierr);
+    } else if (i == n-1) {
+      ierr = MatSetValues(*A,1,&i,2,col,v,INSERT_VALUES);CHKERRQ(ierr);
+    } else {
+      ierr = MatSetValues(*A,1,&i,3,col,v,INSERT_VALUES);CHKERRQ(ierr);
+    }
+  }
+  ierr = MatAssemblyBegin(*A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(*A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **args)
+{
+  Mat            Ka,Ma,Kb,Mb,C;
+  Vec            x,b,u;
+  KSP            ksp;
+  PC             pc;
+  PetscReal      norm,unorm;
+  PetscInt       na = 12,nb = 9,nterms = 2;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,NULL,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-na",&na,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-nb",&nb,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-nterms",&nterms,NULL);CHKERRQ(ierr);
+
+  /* the first factors are distributed, the second ones are on each process */
+  ierr = Create1d(PETSC_COMM_WORLD,na,PETSC_FALSE,&Ka);CHKERRQ(ierr);
+  ierr = Create1d(PETSC_COMM_WORLD,na,PETSC_TRUE,&Ma);CHKERRQ(ierr);
+  ierr = Create1d(PETSC_COMM_SELF,nb,PETSC_FALSE,&Kb);CHKERRQ(ierr);
+  ierr = Create1d(PETSC_COMM_SELF,nb,PETSC_TRUE,&Mb);CHKERRQ(ierr);
+  if (nterms == 1) {
+    ierr = MatCreateKronecker(Ka,Kb,&C);CHKERRQ(ierr);
+  } else {
+    ierr = MatCreateKronecker(Ka,Mb,&C);CHKERRQ(ierr);
+    ierr = MatKroneckerAddTerm(C,Ma,Kb);CHKERRQ(ierr);
+  }
+
+  ierr = MatCreateVecs(C,&x,&b);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&u);CHKERRQ(ierr);
+  ierr = VecSet(u,1.0);CHKERRQ(ierr);
+  ierr = MatMult(C,u,b);CHKERRQ(ierr);
+
+  ierr = KSPCreate(PETSC_COMM_WORLD,&ksp);CHKERRQ(ierr);
+  ierr = KSPSetOperators(ksp,C,C);CHKERRQ(ierr);
+  ierr = KSPSetType(ksp,KSPCG);CHKERRQ(ierr);
+  ierr = KSPGetPC(ksp,&pc);CHKERRQ(ierr);
+  ierr = PCSetType(pc,PCKRONECKER);CHKERRQ(ierr);
+  ierr = KSPSetFromOptions(ksp);CHKERRQ(ierr);
+  ierr = KSPSolve(ksp,b,x);CHKERRQ(ierr);
+
+  ierr = VecAXPY(x,-1.0,u);CHKERRQ(ierr);
+  ierr = VecNorm(x,NORM_2,&norm);CHKERRQ(ierr);
+  ierr = VecNorm(u,NORM_2,&unorm);CHKERRQ(ierr);
+  if (norm > 1.e-8*unorm) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Relative error of the solution %g\n",(double)(norm/unorm));CHKERRQ(ierr);}
+
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&u);CHKERRQ(ierr);
+  ierr = VecDestroy(&b);CHKERRQ(ierr);
+  ierr = MatDestroy(&Ka);CHKERRQ(ierr);
+  ierr = MatDestroy(&Ma);CHKERRQ(ierr);
+  ierr = MatDestroy(&Kb);CHKERRQ(ierr);
+  ierr = MatDestroy(&Mb);CHKERRQ(ierr);
+  ierr = MatDestroy(&C);CHKERRQ(ierr);
+  ierr = KSPDestroy(&ksp);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      nsize: {{1 2}}
+      args: -nterms {{1 2}} -ksp_converged_reason
+      output_file: output/ex71_1.out
+
+   test:
+      suffix: 2
+      args: -ksp_view
+      filter: grep -A2 "PC Object"
+
+TEST*/
@@ -1,5 +1,6 @@
 #include <../src/ksp/ksp/utils/lmvm/symbrdn/symbrdn.h> /*I "petscksp.h" I*/
 #include <../src/ksp/ksp/utils/lmvm/diagbrdn/diagbrdn.h>
+#include <petscblaslapack.h>
 
 /*
   Limited-memory Broyden-Fletcher-Goldfarb-Shano method for approximating both
@@ -8,6 +9,193 @@
 
 /*------------------------------------------------------------*/
 
+/*
+  The compact representation of L-BFGS follows Theorem 2.2 and Equation (3.5)
+  of Byrd, Nocedal and Schnabel "Representations of quasi-Newton matrices and
+  their use in limited memory methods" (https://doi.org/10.1007/BF01582063).
+  With S = [S[0],...,S[k]], Y = [Y[0],...,Y[k]], the splitting S^T Y = L + R
+  into its strictly lower triangular part L and upper triangular part R, and
+  D the diagonal of S^T Y,
+
+    H = H0 + [S, H0*Y] [ R^{-T} (D + Y^T H0 Y) R^{-1}   -R^{-T} ] [ S^T    ]
+                       [ -R^{-1}                          0     ] [ Y^T H0 ]
+
+    B = B0 - [B0*S, Y] [ S^T B0 S   L  ]^{-1} [ S^T B0 ]
+                       [ L^T        -D ]      [ Y^T    ]
+
+  with H0 = J0^{-1} and B0 = J0. S^T Y, Y^T Y and S^T S are updated with one
+  reduction per accepted update, and Y^T H0 Y and S^T B0 S follow from them for
+  a scalar J0 or are recomputed with one reduction when a diagonal J0 changes.
+  Each application then needs a single reduction for the projections onto S
+  and Y, against 2(k+1) for the recursive formulas. A J0 provided by the user
+  falls back onto the recursive formulas.
+*/
+PETSC_STATIC_INLINE PetscBool MatLMVMBFGSUseCompact(Mat B)
+{
+  Mat_LMVM          *lmvm = (Mat_LMVM*)B->data;
+  Mat_SymBrdn       *lbfgs = (Mat_SymBrdn*)lmvm->ctx;
+
+  if (!lbfgs->compact || lmvm->k < 0) return PETSC_FALSE;
+  if (lmvm->J0 || lmvm->user_pc || lmvm->user_ksp || lmvm->user_scale) return PETSC_FALSE;
+  return (PetscBool)(lbfgs->scale_type != MAT_LMVM_SYMBROYDEN_SCALE_USER);
+}
+
+/* Recompute the rows and columns start,...,k of the cached S^T Y, Y^T Y and S^T S */
+static PetscErrorCode MatLMVMBFGSUpdateCompact(Mat B, PetscInt start)
+{
+  Mat_LMVM          *lmvm = (Mat_LMVM*)B->data;
+  Mat_SymBrdn       *lbfgs = (Mat_SymBrdn*)lmvm->ctx;
+  PetscErrorCode    ierr;
+  PetscInt          i, j, m = lmvm->m, n = lmvm->k+1;
+  PetscScalar       *dots;
+
+  PetscFunctionBegin;
+  for (i = start; i < n; ++i) {
+    dots = lbfgs->cwork + 4*(i-start)*n;
+    ierr = VecMDotBegin(lmvm->S[i], n, lmvm->Y, dots);CHKERRQ(ierr);
+    ierr = VecMDotBegin(lmvm->Y[i], n, lmvm->S, dots+n);CHKERRQ(ierr);
+    ierr = VecMDotBegin(lmvm->Y[i], n, lmvm->Y, dots+2*n);CHKERRQ(ierr);
+    ierr = VecMDotBegin(lmvm->S[i], n, lmvm->S, dots+3*n);CHKERRQ(ierr);
+  }
+  for (i = start; i < n; ++i) {
+    dots = lbfgs->cwork + 4*(i-start)*n;
+    ierr = VecMDotEnd(lmvm->S[i], n, lmvm->Y, dots);CHKERRQ(ierr);
+    ierr = VecMDotEnd(lmvm->Y[i], n, lmvm->S, dots+n);CHKERRQ(ierr);
+    ierr = VecMDotEnd(lmvm->Y[i], n, lmvm->Y, dots+2*n);CHKERRQ(ierr);
+    ierr = VecMDotEnd(lmvm->S[i], n, lmvm->S, dots+3*n);CHKERRQ(ierr);
+    for (j = 0; j < n; ++j) {
+      lbfgs->StY[i*m+j] = PetscRealPart(dots[j]);
+      lbfgs->StY[j*m+i] = PetscRealPart(dots[n+j]);
+      lbfgs->YtY[i*m+j] = lbfgs->YtY[j*m+i] = PetscRealPart(dots[2*n+j]);
+      lbfgs->StS[i*m+j] = lbfgs->StS[j*m+i] = PetscRealPart(dots[3*n+j]);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Form Y^T H0 Y and S^T B0 S for the current J0, using the P vectors as work space for a diagonal J0 */
+static PetscErrorCode MatLMVMBFGSComputeJ0Compact(Mat B)
+{
+  Mat_LMVM          *lmvm = (Mat_LMVM*)B->data;
+  Mat_SymBrdn       *lbfgs = (Mat_SymBrdn*)lmvm->ctx;
+  PetscErrorCode    ierr;
+  PetscInt          i, j, m = lmvm->m, n = lmvm->k+1;
+  PetscScalar       *dots = lbfgs->cwork;
+
+  PetscFunctionBegin;
+  if (!lbfgs->needK) PetscFunctionReturn(0);
+  if (lbfgs->scale_type == MAT_LMVM_SYMBROYDEN_SCALE_DIAGONAL) {
+    /* the local parts of the products are computed in VecMDotBegin(), so P[i] can be reused right away */
+    for (i = 0; i < n; ++i) {
+      ierr = MatSymBrdnApplyJ0Inv(B, lmvm->Y[i], lbfgs->P[i]);CHKERRQ(ierr);
+      ierr = VecMDotBegin(lbfgs->P[i], i+1, lmvm->Y, dots+i*m);CHKERRQ(ierr);
+    }
+    for (i = 0; i < n; ++i) {
+      ierr = MatSymBrdnApplyJ0Fwd(B, lmvm->S[i], lbfgs->P[i]);CHKERRQ(ierr);
+      ierr = VecMDotBegin(lbfgs->P[i], i+1, lmvm->S, dots+(m+i)*m);CHKERRQ(ierr);
+    }
+    for (i = 0; i < 2*n; ++i) {
+      ierr = VecMDotEnd(lbfgs->P[i%n], (i%n)+1, NULL, dots+(i < n ? i : m+i-n)*m);CHKERRQ(ierr);
+    }
+    for (i = 0; i < n; ++i) {
+      for (j = 0; j <= i; ++j) {
+        lbfgs->YHY[i*m+j] = lbfgs->YHY[j*m+i] = PetscRealPart(dots[i*m+j]);
+        lbfgs->SBS[i*m+j] = lbfgs->SBS[j*m+i] = PetscRealPart(dots[(m+i)*m+j]);
+      }
+    }
+    lbfgs->needP = PETSC_TRUE;
+  } else {
+    for (i = 0; i < n; ++i) {
+      for (j = 0; j < n; ++j) {
+        lbfgs->YHY[i*m+j] = lbfgs->sigma*lbfgs->YtY[i*m+j];
+        lbfgs->SBS[i*m+j] = lbfgs->StS[i*m+j]/lbfgs->sigma;
+      }
+    }
+  }
+  lbfgs->needK = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSolve_LMVMBFGS_Compact(Mat B, Vec F, Vec dX)
+{
+  Mat_LMVM          *lmvm = (Mat_LMVM*)B->data;
+  Mat_SymBrdn       *lbfgs = (Mat_SymBrdn*)lmvm->ctx;
+  PetscErrorCode    ierr;
+  PetscInt          i, j, m = lmvm->m, n = lmvm->k+1;
+  PetscScalar       *stf = lbfgs->cwork, *ythf = stf+m, *u = stf+2*m, *t = stf+3*m;
+  PetscReal         *R = lbfgs->StY;
+
+  PetscFunctionBegin;
+  ierr = MatLMVMBFGSComputeJ0Compact(B);CHKERRQ(ierr);
+  ierr = MatSymBrdnApplyJ0Inv(B, F, dX);CHKERRQ(ierr);
+  ierr = VecMDotBegin(F, n, lmvm->S, stf);CHKERRQ(ierr);
+  ierr = VecMDotBegin(dX, n, lmvm->Y, ythf);CHKERRQ(ierr);
+  ierr = VecMDotEnd(F, n, lmvm->S, stf);CHKERRQ(ierr);
+  ierr = VecMDotEnd(dX, n, lmvm->Y, ythf);CHKERRQ(ierr);
+  /* u = R^{-1} S^T F */
+  for (i = n-1; i >= 0; --i) {
+    u[i] = stf[i];
+    for (j = i+1; j < n; ++j) u[i] -= R[i*m+j]*u[j];
+    u[i] /= R[i*m+i];
+  }
+  /* t = R^{-T} ((D + Y^T H0 Y) u - Y^T H0 F) */
+  for (i = 0; i < n; ++i) {
+    t[i] = R[i*m+i]*u[i] - ythf[i];
+    for (j = 0; j < n; ++j) t[i] += lbfgs->YHY[i*m+j]*u[j];
+    for (j = 0; j < i; ++j) t[i] -= R[j*m+i]*t[j];
+    t[i] /= R[i*m+i];
+  }
+  /* dX = H0 (F - Y u) + S t */
+  for (i = 0; i < n; ++i) u[i] = -u[i];
+  ierr = VecCopy(F, lbfgs->work);CHKERRQ(ierr);
+  ierr = VecMAXPY(lbfgs->work, n, u, lmvm->Y);CHKERRQ(ierr);
+  ierr = MatSymBrdnApplyJ0Inv(B, lbfgs->work, dX);CHKERRQ(ierr);
+  ierr = VecMAXPY(dX, n, t, lmvm->S);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatMult_LMVMBFGS_Compact(Mat B, Vec X, Vec Z)
+{
+  Mat_LMVM          *lmvm = (Mat_LMVM*)B->data;
+  Mat_SymBrdn       *lbfgs = (Mat_SymBrdn*)lmvm->ctx;
+  PetscErrorCode    ierr;
+  PetscInt          i, j, m = lmvm->m, n = lmvm->k+1;
+  PetscScalar       *c = lbfgs->cwork, *K = c+2*m;
+  PetscReal         *StY = lbfgs->StY;
+  PetscBLASInt      nn, one = 1, info;
+
+  PetscFunctionBegin;
+  ierr = MatLMVMBFGSComputeJ0Compact(B);CHKERRQ(ierr);
+  ierr = MatSymBrdnApplyJ0Fwd(B, X, Z);CHKERRQ(ierr);
+  ierr = VecMDotBegin(Z, n, lmvm->S, c);CHKERRQ(ierr);
+  ierr = VecMDotBegin(X, n, lmvm->Y, c+n);CHKERRQ(ierr);
+  ierr = VecMDotEnd(Z, n, lmvm->S, c);CHKERRQ(ierr);
+  ierr = VecMDotEnd(X, n, lmvm->Y, c+n);CHKERRQ(ierr);
+  /* Solve [S^T B0 S, L; L^T, -D] c = [S^T B0 X; Y^T X] */
+  for (j = 0; j < n; ++j) {
+    for (i = 0; i < n; ++i) {
+      K[i+j*2*n]         = lbfgs->SBS[i*m+j];
+      K[i+(n+j)*2*n]     = i > j ? StY[i*m+j] : 0.0;
+      K[n+i+j*2*n]       = i < j ? StY[j*m+i] : 0.0;
+      K[n+i+(n+j)*2*n]   = i == j ? -StY[i*m+i] : 0.0;
+    }
+  }
+  ierr = PetscBLASIntCast(2*n, &nn);CHKERRQ(ierr);
+  ierr = PetscFPTrapPush(PETSC_FP_TRAP_OFF);CHKERRQ(ierr);
+  PetscStackCallBLAS("LAPACKgesv",LAPACKgesv_(&nn, &one, K, &nn, lbfgs->pivots, c, &nn, &info));
+  ierr = PetscFPTrapPop();CHKERRQ(ierr);
+  if (info) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_LIB, "Error in LAPACK routine %d", (int)info);
+  /* Z = B0 (X - S c[0:n]) - Y c[n:2n] */
+  for (i = 0; i < 2*n; ++i) c[i] = -c[i];
+  ierr = VecCopy(X, lbfgs->work);CHKERRQ(ierr);
+  ierr = VecMAXPY(lbfgs->work, n, c, lmvm->S);CHKERRQ(ierr);
+  ierr = MatSymBrdnApplyJ0Fwd(B, lbfgs->work, Z);CHKERRQ(ierr);
+  ierr = VecMAXPY(Z, n, c+n, lmvm->Y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*------------------------------------------------------------*/
+
 /*
   The solution method (approximate inverse Jacobian application) is adapted
    from Algorithm 7.4 on page 178 of Nocedal and Wright "Numerical Optimization"
@@ -43,6 +231,10 @@ PetscErrorCode MatSolve_LMVMBFGS(Mat B, Vec F, Vec dX)
   PetscFunctionBegin;
   VecCheckSameSize(F, 2, dX, 3);
   VecCheckMatCompatible(B, dX, 3, F, 2);
+  if (MatLMVMBFGSUseCompact(B)) {
+    ierr = MatSolve_LMVMBFGS_Compact(B, F, dX);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
 
   /* Copy the function into the work vector for the first loop */
   ierr = VecCopy(F, lbfgs->work);CHKERRQ(ierr);
@@ -109,6 +301,10 @@ PetscErrorCode MatMult_LMVMBFGS(Mat B, Vec X, Vec Z)
   PetscFunctionBegin;
   VecCheckSameSize(X, 2, Z, 3);
   VecCheckMatCompatible(B, X, 2, Z, 3);
+  if (MatLMVMBFGSUseCompact(B)) {
+    ierr = MatMult_LMVMBFGS_Compact(B, X, Z);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
 
   if (lbfgs->needP) {
     /* Pre-compute (P[i] = B_i * S[i]) */
@@ -152,7 +348,7 @@ static PetscErrorCode MatUpdate_LMVMBFGS(Mat B, Vec X, Vec F)
   Mat_LMVM          *dbase;
   Mat_DiagBrdn      *dctx;
   PetscErrorCode    ierr;
-  PetscInt          old_k, i;
+  PetscInt          old_k, i, j, m = lmvm->m;
   PetscReal         curvtol;
   PetscScalar       curvature, ytytmp, ststmp;
 
@@ -191,6 +387,19 @@ static PetscErrorCode MatUpdate_LMVMBFGS(Mat B, Vec X, Vec F)
       lbfgs->yts[lmvm->k] = PetscRealPart(curvature);
       lbfgs->yty[lmvm->k] = PetscRealPart(ytytmp);
       lbfgs->sts[lmvm->k] = PetscRealPart(ststmp);
+      /* Shift and extend the inner products of the compact representation */
+      if (lbfgs->compact) {
+        if (old_k == lmvm->k) {
+          for (i = 0; i <= lmvm->k-1; ++i) {
+            for (j = 0; j <= lmvm->k-1; ++j) {
+              lbfgs->StY[i*m+j] = lbfgs->StY[(i+1)*m+j+1];
+              lbfgs->YtY[i*m+j] = lbfgs->YtY[(i+1)*m+j+1];
+              lbfgs->StS[i*m+j] = lbfgs->StS[(i+1)*m+j+1];
+            }
+          }
+        }
+        ierr = MatLMVMBFGSUpdateCompact(B, lmvm->k);CHKERRQ(ierr);
+      }
       /* Compute the scalar scale if necessary */
       if (lbfgs->scale_type == MAT_LMVM_SYMBROYDEN_SCALE_SCALAR) {
         ierr = MatSymBrdnComputeJ0Scalar(B);CHKERRQ(ierr);
@@ -234,6 +443,7 @@ static PetscErrorCode MatUpdate_LMVMBFGS(Mat B, Vec X, Vec F)
   ierr = VecCopy(X, lmvm->Xprev);CHKERRQ(ierr);
   ierr = VecCopy(F, lmvm->Fprev);CHKERRQ(ierr);
   lmvm->prev_set = PETSC_TRUE;
+  lbfgs->needK = PETSC_TRUE;
   PetscFunctionReturn(0);
 }
 
@@ -246,7 +456,7 @@ static PetscErrorCode MatCopy_LMVMBFGS(Mat B, Mat M, MatStructure str)
   Mat_LMVM          *mdata = (Mat_LMVM*)M->data;
   Mat_SymBrdn       *mctx = (Mat_SymBrdn*)mdata->ctx;
   PetscErrorCode    ierr;
-  PetscInt          i;
+  PetscInt          i, j;
 
   PetscFunctionBegin;
   mctx->needP = bctx->needP;
@@ -255,6 +465,17 @@ static PetscErrorCode MatCopy_LMVMBFGS(Mat B, Mat M, MatStructure str)
     mctx->yts[i] = bctx->yts[i];
     ierr = VecCopy(bctx->P[i], mctx->P[i]);CHKERRQ(ierr);
   }
+  mctx->compact = bctx->compact;
+  mctx->needK   = PETSC_TRUE;
+  if (bctx->compact) {
+    for (i=0; i<=bdata->k; ++i) {
+      for (j=0; j<=bdata->k; ++j) {
+        mctx->StY[i*mdata->m+j] = bctx->StY[i*bdata->m+j];
+        mctx->YtY[i*mdata->m+j] = bctx->YtY[i*bdata->m+j];
+        mctx->StS[i*mdata->m+j] = bctx->StS[i*bdata->m+j];
+      }
+    }
+  }
   mctx->scale_type      = bctx->scale_type;
   mctx->alpha           = bctx->alpha;
   mctx->beta            = bctx->beta;
@@ -292,10 +513,13 @@ static PetscErrorCode MatReset_LMVMBFGS(Mat B, PetscBool destructive)
   PetscFunctionBegin;
   lbfgs->watchdog = 0;
   lbfgs->needP = PETSC_TRUE;
+  lbfgs->needK = PETSC_TRUE;
   if (lbfgs->allocated) {
     if (destructive) {
       ierr = VecDestroy(&lbfgs->work);CHKERRQ(ierr);
       ierr = PetscFree4(lbfgs->stp, lbfgs->yts, lbfgs->yty, lbfgs->sts);CHKERRQ(ierr);
+      ierr = PetscFree5(lbfgs->StY, lbfgs->YtY, lbfgs->StS, lbfgs->YHY, lbfgs->SBS);CHKERRQ(ierr);
+      ierr = PetscFree2(lbfgs->cwork, lbfgs->pivots);CHKERRQ(ierr);
       ierr = VecDestroyVecs(lmvm->m, &lbfgs->P);CHKERRQ(ierr);
       switch (lbfgs->scale_type) {
       case MAT_LMVM_SYMBROYDEN_SCALE_DIAGONAL:
@@ -341,6 +565,8 @@ static PetscErrorCode MatAllocate_LMVMBFGS(Mat B, Vec X, Vec F)
   if (!lbfgs->allocated) {
     ierr = VecDuplicate(X, &lbfgs->work);CHKERRQ(ierr);
     ierr = PetscMalloc4(lmvm->m, &lbfgs->stp, lmvm->m, &lbfgs->yts, lmvm->m, &lbfgs->yty, lmvm->m, &lbfgs->sts);CHKERRQ(ierr);
+    ierr = PetscMalloc5(lmvm->m*lmvm->m, &lbfgs->StY, lmvm->m*lmvm->m, &lbfgs->YtY, lmvm->m*lmvm->m, &lbfgs->StS, lmvm->m*lmvm->m, &lbfgs->YHY, lmvm->m*lmvm->m, &lbfgs->SBS);CHKERRQ(ierr);
+    ierr = PetscMalloc2(4*lmvm->m*(lmvm->m+1), &lbfgs->cwork, 2*lmvm->m, &lbfgs->pivots);CHKERRQ(ierr);
     if (lmvm->m > 0) {
       ierr = VecDuplicateVecs(X, lmvm->m, &lbfgs->P);CHKERRQ(ierr);
     }
@@ -368,6 +594,8 @@ static PetscErrorCode MatDestroy_LMVMBFGS(Mat B)
   if (lbfgs->allocated) {
     ierr = VecDestroy(&lbfgs->work);CHKERRQ(ierr);
     ierr = PetscFree4(lbfgs->stp, lbfgs->yts, lbfgs->yty, lbfgs->sts);CHKERRQ(ierr);
+    ierr = PetscFree5(lbfgs->StY, lbfgs->YtY, lbfgs->StS, lbfgs->YHY, lbfgs->SBS);CHKERRQ(ierr);
+    ierr = PetscFree2(lbfgs->cwork, lbfgs->pivots);CHKERRQ(ierr);
     ierr = VecDestroyVecs(lmvm->m, &lbfgs->P);CHKERRQ(ierr);
     lbfgs->allocated = PETSC_FALSE;
   }
@@ -392,6 +620,8 @@ static PetscErrorCode MatSetUp_LMVMBFGS(Mat B)
   if (!lbfgs->allocated) {
     ierr = VecDuplicate(lmvm->Xprev, &lbfgs->work);CHKERRQ(ierr);
     ierr = PetscMalloc4(lmvm->m, &lbfgs->stp, lmvm->m, &lbfgs->yts, lmvm->m, &lbfgs->yty, lmvm->m, &lbfgs->sts);CHKERRQ(ierr);
+    ierr = PetscMalloc5(lmvm->m*lmvm->m, &lbfgs->StY, lmvm->m*lmvm->m, &lbfgs->YtY, lmvm->m*lmvm->m, &lbfgs->StS, lmvm->m*lmvm->m, &lbfgs->YHY, lmvm->m*lmvm->m, &lbfgs->SBS);CHKERRQ(ierr);
+    ierr = PetscMalloc2(4*lmvm->m*(lmvm->m+1), &lbfgs->cwork, 2*lmvm->m, &lbfgs->pivots);CHKERRQ(ierr);
     if (lmvm->m > 0) {
       ierr = VecDuplicateVecs(lmvm->Xprev, lmvm->m, &lbfgs->P);CHKERRQ(ierr);
     }
@@ -414,13 +644,22 @@ static PetscErrorCode MatSetUp_LMVMBFGS(Mat B)
 
 static PetscErrorCode MatSetFromOptions_LMVMBFGS(PetscOptionItems *PetscOptionsObject, Mat B)
 {
+  Mat_LMVM                     *lmvm = (Mat_LMVM*)B->data;
+  Mat_SymBrdn                  *lbfgs = (Mat_SymBrdn*)lmvm->ctx;
+  PetscBool                    compact = lbfgs->compact;
   PetscErrorCode               ierr;
 
   PetscFunctionBegin;
   ierr = MatSetFromOptions_LMVM(PetscOptionsObject, B);CHKERRQ(ierr);
   ierr = PetscOptionsHead(PetscOptionsObject,"L-BFGS method for approximating SPD Jacobian actions (MATLMVMBFGS)");CHKERRQ(ierr);
   ierr = MatSetFromOptions_LMVMSymBrdn_Private(PetscOptionsObject, B);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-mat_lmvm_compact","Apply the matrix and its inverse through the compact representation, with one reduction per application","",lbfgs->compact,&lbfgs->compact,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsTail();CHKERRQ(ierr);
+  /* Build the inner products of the updates stored so far */
+  if (lbfgs->compact && !compact && lbfgs->allocated && lmvm->k >= 0) {
+    ierr = MatLMVMBFGSUpdateCompact(B, 0);CHKERRQ(ierr);
+  }
+  lbfgs->needK = PETSC_TRUE;
   PetscFunctionReturn(0);
 }
 
@@ -489,7 +728,13 @@ PetscErrorCode MatCreate_LMVMBFGS(Mat B)
 .   -mat_lmvm_rho - (developer) update limiter for the J0 scaling
 .   -mat_lmvm_alpha - (developer) coefficient factor for the quadratic subproblem in J0 scaling
 .   -mat_lmvm_beta - (developer) exponential factor for the diagonal J0 scaling
--   -mat_lmvm_sigma_hist - (developer) number of past updates to use in J0 scaling
+.   -mat_lmvm_sigma_hist - (developer) number of past updates to use in J0 scaling
+-   -mat_lmvm_compact - apply the matrix through its compact representation, with a single reduction per MatMult() or MatSolve()
+
+   Notes:
+   The compact representation caches the inner products between the stored updates and replaces the
+   recursive formulas with one VecMDot() and two VecMAXPY() per application. It applies with no, scalar or
+   diagonal J0 scaling; a J0 provided with MatLMVMSetJ0() and related functions uses the recursive formulas.
 
    Level: intermediate
 
@@ -18,6 +18,10 @@ typedef struct {
   PetscInt  sigma_hist;                      /* length of update history to be used for scaling */
   MatLMVMSymBroydenScaleType  scale_type;
   PetscInt  watchdog, max_seq_rejects;        /* tracker to reset after a certain # of consecutive rejects */
+  PetscBool compact, needK;                   /* compact representation of L-BFGS and whether its J0 blocks are stale */
+  PetscReal *StY, *YtY, *StS, *YHY, *SBS;     /* cached S^T Y, Y^T Y, S^T S, Y^T J0^{-1} Y and S^T J0 S for the compact representation */
+  PetscScalar  *cwork;                        /* dense work space for the compact representation */
+  PetscBLASInt *pivots;
 } Mat_SymBrdn;
 
 PETSC_INTERN PetscErrorCode MatSymBrdnApplyJ0Fwd(Mat, Vec, Vec);
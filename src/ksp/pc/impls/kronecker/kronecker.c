@@ -0,0 +1,312 @@
+
+/*
+   Fast diagonalization preconditioner for MATKRONECKER matrices
+*/
+#include <petsc/private/pcimpl.h>   /*I "petscpc.h" I*/
+#include <petscblaslapack.h>
+
+typedef struct {
+  PetscInt    na,nb;            /* sizes of the A and B factors */
+  PetscScalar *V,*W;            /* eigenvector bases of the A and B factors, column major */
+  PetscScalar *Vc;              /* the complex conjugate of V */
+  PetscReal   *dinv;            /* inverses of the eigenvalues of the matrix, (j,l) at j*nb+l */
+  PetscScalar *work;            /* two work arrays of length na*nb */
+  PetscReal   emin,emax;        /* extreme eigenvalues of the matrix, for PCView() */
+  VecScatter  scatter;          /* gathers the whole vector on each process in parallel */
+  Vec         xred,yred;
+} PC_Kronecker;
+
+/* returns a dense copy of the n x n matrix A on each process */
+static PetscErrorCode PCKroneckerGetDense_Private(Mat A,PetscInt *n,PetscScalar **a)
+{
+  Mat               Ad,red;
+  const PetscScalar *v;
+  PetscInt          j,lda,N;
+  PetscMPIInt       size;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = MatGetSize(A,n,&N);CHKERRQ(ierr);
+  if (*n != N) SETERRQ2(PetscObjectComm((PetscObject)A),PETSC_ERR_SUP,"The factors must be square, not %D x %D",*n,N);
+  ierr = MPI_Comm_size(PetscObjectComm((PetscObject)A),&size);CHKERRMPI(ierr);
+  if (size > 1) {
+    ierr = MatCreateRedundantMatrix(A,size,PETSC_COMM_SELF,MAT_INITIAL_MATRIX,&red);CHKERRQ(ierr);
+    ierr = MatConvert(red,MATSEQDENSE,MAT_INITIAL_MATRIX,&Ad);CHKERRQ(ierr);
+    ierr = MatDestroy(&red);CHKERRQ(ierr);
+  } else {
+    ierr = MatConvert(A,MATSEQDENSE,MAT_INITIAL_MATRIX,&Ad);CHKERRQ(ierr);
+  }
+  ierr = PetscMalloc1((*n)*(*n),a);CHKERRQ(ierr);
+  ierr = MatDenseGetLDA(Ad,&lda);CHKERRQ(ierr);
+  ierr = MatDenseGetArrayRead(Ad,&v);CHKERRQ(ierr);
+  for (j=0; j<*n; j++) {
+    ierr = PetscArraycpy(*a+j*(*n),v+j*lda,*n);CHKERRQ(ierr);
+  }
+  ierr = MatDenseRestoreArrayRead(Ad,&v);CHKERRQ(ierr);
+  ierr = MatDestroy(&Ad);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Overwrites the Hermitian matrix S with the eigenvectors V of S v = lambda M v, normalized with V^H M V = I,
+   M must be Hermitian positive definite. Without M the eigenvectors are orthonormal.
+*/
+static PetscErrorCode PCKroneckerDiagonalize_Private(PetscInt n,PetscScalar *S,PetscScalar *M,PetscReal *lambda)
+{
+  PetscBLASInt   bn,lwork,lierr,one = 1;
+  PetscScalar    *work;
+#if defined(PETSC_USE_COMPLEX)
+  PetscReal      *rwork;
+#endif
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!n) PetscFunctionReturn(0);
+  ierr  = PetscBLASIntCast(n,&bn);CHKERRQ(ierr);
+  lwork = 3*bn;
+  ierr  = PetscMalloc1(lwork,&work);CHKERRQ(ierr);
+#if defined(PETSC_USE_COMPLEX)
+  ierr  = PetscMalloc1(3*bn,&rwork);CHKERRQ(ierr);
+#endif
+  ierr = PetscFPTrapPush(PETSC_FP_TRAP_OFF);CHKERRQ(ierr);
+  if (M) {
+#if !defined(PETSC_USE_COMPLEX)
+    PetscStackCallBLAS("LAPACKsygv",LAPACKsygv_(&one,"V","U",&bn,S,&bn,M,&bn,lambda,work,&lwork,&lierr));
+#else
+    PetscStackCallBLAS("LAPACKsygv",LAPACKsygv_(&one,"V","U",&bn,S,&bn,M,&bn,lambda,work,&lwork,rwork,&lierr));
+#endif
+  } else {
+#if !defined(PETSC_USE_COMPLEX)
+    PetscStackCallBLAS("LAPACKsyev",LAPACKsyev_("V","U",&bn,S,&bn,lambda,work,&lwork,&lierr));
+#else
+    PetscStackCallBLAS("LAPACKsyev",LAPACKsyev_("V","U",&bn,S,&bn,lambda,work,&lwork,rwork,&lierr));
+#endif
+  }
+  ierr = PetscFPTrapPop();CHKERRQ(ierr);
+  if (lierr > bn) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_MAT_CH_ZRPVT,"The mass factor is not positive definite");
+  if (lierr) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in LAPACK eigensolver %d",(int)lierr);
+  ierr = PetscFree(work);CHKERRQ(ierr);
+#if defined(PETSC_USE_COMPLEX)
+  ierr = PetscFree(rwork);CHKERRQ(ierr);
+#endif
+  ierr = PetscLogFlops(10.0*n*n*n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCReset_Kronecker(PC pc)
+{
+  PC_Kronecker   *kr = (PC_Kronecker*)pc->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree(kr->V);CHKERRQ(ierr);
+  ierr = PetscFree(kr->W);CHKERRQ(ierr);
+#if defined(PETSC_USE_COMPLEX)
+  ierr = PetscFree(kr->Vc);CHKERRQ(ierr);
+#endif
+  kr->Vc = NULL;
+  ierr = PetscFree(kr->dinv);CHKERRQ(ierr);
+  ierr = PetscFree(kr->work);CHKERRQ(ierr);
+  ierr = VecScatterDestroy(&kr->scatter);CHKERRQ(ierr);
+  ierr = VecDestroy(&kr->xred);CHKERRQ(ierr);
+  ierr = VecDestroy(&kr->yred);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   With V^H A_0 V = diag(lambda) and W^H B_0 W = diag(mu) the matrix A_0 x B_0 is (V x W)^{-H} diag(lambda_j mu_l) (V x W)^{-1},
+   with V^H A_0 V = diag(lambda), V^H A_1 V = I, W^H B_0 W = I and W^H B_1 W = diag(mu) the matrix A_0 x B_0 + A_1 x B_1 is
+   (V x W)^{-H} diag(lambda_j + mu_l) (V x W)^{-1}.
+*/
+static PetscErrorCode PCSetUp_Kronecker(PC pc)
+{
+  PC_Kronecker   *kr = (PC_Kronecker*)pc->data;
+  Mat            A0,B0,A1,B1;
+  PetscScalar    *M = NULL;
+  PetscReal      *lambda,*mu,e;
+  PetscInt       nterms,na,nb,j,l;
+  PetscBool      iskron;
+  PetscMPIInt    size;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)pc->pmat,MATKRONECKER,&iskron);CHKERRQ(ierr);
+  if (!iskron) SETERRQ1(PetscObjectComm((PetscObject)pc),PETSC_ERR_SUP,"PCKRONECKER requires a MATKRONECKER matrix, not %s",((PetscObject)pc->pmat)->type_name);
+  ierr = MatKroneckerGetNumberTerms(pc->pmat,&nterms);CHKERRQ(ierr);
+  if (nterms < 1 || nterms > 2) SETERRQ1(PetscObjectComm((PetscObject)pc),PETSC_ERR_SUP,"PCKRONECKER supports one or two Kronecker product terms, not %D",nterms);
+  ierr = PCReset_Kronecker(pc);CHKERRQ(ierr);
+
+  ierr = MatKroneckerGetTerm(pc->pmat,0,&A0,&B0);CHKERRQ(ierr);
+  ierr = PCKroneckerGetDense_Private(A0,&na,&kr->V);CHKERRQ(ierr);
+  ierr = PCKroneckerGetDense_Private(B0,&nb,&kr->W);CHKERRQ(ierr);
+  ierr = PetscMalloc2(na,&lambda,nb,&mu);CHKERRQ(ierr);
+  if (nterms == 1) {
+    ierr = PCKroneckerDiagonalize_Private(na,kr->V,NULL,lambda);CHKERRQ(ierr);
+    ierr = PCKroneckerDiagonalize_Private(nb,kr->W,NULL,mu);CHKERRQ(ierr);
+  } else {
+    ierr = MatKroneckerGetTerm(pc->pmat,1,&A1,&B1);CHKERRQ(ierr);
+    ierr = PCKroneckerGetDense_Private(A1,&j,&M);CHKERRQ(ierr);
+    ierr = PCKroneckerDiagonalize_Private(na,kr->V,M,lambda);CHKERRQ(ierr);
+    ierr = PetscFree(M);CHKERRQ(ierr);
+    /* W diagonalizes B_1 with respect to the positive definite B_0 */
+    ierr = PCKroneckerGetDense_Private(B1,&j,&M);CHKERRQ(ierr);
+    ierr = PCKroneckerDiagonalize_Private(nb,M,kr->W,mu);CHKERRQ(ierr);
+    ierr = PetscFree(kr->W);CHKERRQ(ierr);
+    kr->W = M;
+  }
+  kr->na = na;
+  kr->nb = nb;
+#if defined(PETSC_USE_COMPLEX)
+  ierr = PetscMalloc1(na*na,&kr->Vc);CHKERRQ(ierr);
+  for (j=0; j<na*na; j++) kr->Vc[j] = PetscConj(kr->V[j]);
+#else
+  kr->Vc = kr->V;
+#endif
+
+  ierr = PetscMalloc1(na*nb,&kr->dinv);CHKERRQ(ierr);
+  ierr = PetscMalloc1(2*na*nb,&kr->work);CHKERRQ(ierr);
+  kr->emin = PETSC_MAX_REAL;
+  kr->emax = 0.0;
+  for (j=0; j<na; j++) {
+    for (l=0; l<nb; l++) {
+      e = nterms == 1 ? lambda[j]*mu[l] : lambda[j]+mu[l];
+      if (e == 0.0) SETERRQ(PetscObjectComm((PetscObject)pc),PETSC_ERR_MAT_LU_ZRPVT,"The matrix is singular");
+      kr->emin = PetscMin(kr->emin,PetscAbsReal(e));
+      kr->emax = PetscMax(kr->emax,PetscAbsReal(e));
+      kr->dinv[j*nb+l] = 1.0/e;
+    }
+  }
+  ierr = PetscFree2(lambda,mu);CHKERRQ(ierr);
+  ierr = PetscInfo2(pc,"Smallest and largest eigenvalues in absolute value %g %g\n",(double)kr->emin,(double)kr->emax);CHKERRQ(ierr);
+
+  ierr = MPI_Comm_size(PetscObjectComm((PetscObject)pc),&size);CHKERRMPI(ierr);
+  if (size > 1) {
+    ierr = MatCreateVecs(pc->pmat,&kr->yred,NULL);CHKERRQ(ierr);
+    ierr = VecScatterCreateToAll(kr->yred,&kr->scatter,&kr->xred);CHKERRQ(ierr);
+    ierr = VecDestroy(&kr->yred);CHKERRQ(ierr);
+    ierr = VecDuplicate(kr->xred,&kr->yred);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   y = (V x W) D^{-1} (V x W)^H x, a vector is the nb x na column major matrix X with (V x W) vec(X) = vec(W X V^T)
+*/
+static PetscErrorCode PCKroneckerApply_Private(PC_Kronecker *kr,const PetscScalar *x,PetscScalar *y)
+{
+  PetscScalar    *t1 = kr->work,*t2 = kr->work+kr->na*kr->nb,one = 1.0,zero = 0.0;
+  PetscBLASInt   na,nb;
+  PetscInt       i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!kr->na || !kr->nb) PetscFunctionReturn(0);
+  ierr = PetscBLASIntCast(kr->na,&na);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(kr->nb,&nb);CHKERRQ(ierr);
+  PetscStackCallBLAS("BLASgemm",BLASgemm_("C","N",&nb,&na,&nb,&one,kr->W,&nb,x,&nb,&zero,t1,&nb));
+  PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&nb,&na,&na,&one,t1,&nb,kr->Vc,&na,&zero,t2,&nb));
+  for (i=0; i<kr->na*kr->nb; i++) t2[i] *= kr->dinv[i];
+  PetscStackCallBLAS("BLASgemm",BLASgemm_("N","N",&nb,&na,&nb,&one,kr->W,&nb,t2,&nb,&zero,t1,&nb));
+  PetscStackCallBLAS("BLASgemm",BLASgemm_("N","T",&nb,&na,&na,&one,t1,&nb,kr->V,&na,&zero,y,&nb));
+  ierr = PetscLogFlops(4.0*kr->na*kr->nb*(kr->na+kr->nb)+kr->na*kr->nb);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCApply_Kronecker(PC pc,Vec x,Vec y)
+{
+  PC_Kronecker      *kr = (PC_Kronecker*)pc->data;
+  const PetscScalar *xa,*ya;
+  PetscScalar       *y2;
+  PetscInt          rstart,rend;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (!kr->scatter) {
+    ierr = VecGetArrayRead(x,&xa);CHKERRQ(ierr);
+    ierr = VecGetArrayWrite(y,&y2);CHKERRQ(ierr);
+    ierr = PCKroneckerApply_Private(kr,xa,y2);CHKERRQ(ierr);
+    ierr = VecRestoreArrayWrite(y,&y2);CHKERRQ(ierr);
+    ierr = VecRestoreArrayRead(x,&xa);CHKERRQ(ierr);
+  } else {
+    /* every process applies the whole preconditioner and keeps its part of the result */
+    ierr = VecScatterBegin(kr->scatter,x,kr->xred,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+    ierr = VecScatterEnd(kr->scatter,x,kr->xred,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+    ierr = VecGetArrayRead(kr->xred,&xa);CHKERRQ(ierr);
+    ierr = VecGetArrayWrite(kr->yred,&y2);CHKERRQ(ierr);
+    ierr = PCKroneckerApply_Private(kr,xa,y2);CHKERRQ(ierr);
+    ierr = VecRestoreArrayWrite(kr->yred,&y2);CHKERRQ(ierr);
+    ierr = VecRestoreArrayRead(kr->xred,&xa);CHKERRQ(ierr);
+    ierr = VecGetOwnershipRange(y,&rstart,&rend);CHKERRQ(ierr);
+    ierr = VecGetArrayRead(kr->yred,&ya);CHKERRQ(ierr);
+    ierr = VecGetArrayWrite(y,&y2);CHKERRQ(ierr);
+    ierr = PetscArraycpy(y2,ya+rstart,rend-rstart);CHKERRQ(ierr);
+    ierr = VecRestoreArrayWrite(y,&y2);CHKERRQ(ierr);
+    ierr = VecRestoreArrayRead(kr->yred,&ya);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCDestroy_Kronecker(PC pc)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PCReset_Kronecker(pc);CHKERRQ(ierr);
+  ierr = PetscFree(pc->data);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCView_Kronecker(PC pc,PetscViewer viewer)
+{
+  PC_Kronecker   *kr = (PC_Kronecker*)pc->data;
+  PetscBool      iascii;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (iascii && pc->setupcalled) {
+    ierr = PetscViewerASCIIPrintf(viewer,"  fast diagonalization with factors of sizes %D and %D\n",kr->na,kr->nb);CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPrintf(viewer,"  condition number of the matrix %g\n",(double)(kr->emax/kr->emin));CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*MC
+     PCKRONECKER - Exact inverse of a MATKRONECKER matrix with one or two terms by fast diagonalization
+
+   Notes:
+   For A_0 x B_0 the factors must be symmetric (Hermitian) and nonsingular. For A_0 x B_0 + A_1 x B_1, for example
+   K x M + M x K for a stiffness matrix K and a mass matrix M, the factors must be symmetric (Hermitian) and B_0 and
+   A_1 positive definite.
+
+   The setup computes the dense eigenvector bases V and W of the A and B factors, which diagonalize the matrix as
+   (V x W)^H C (V x W) = D, and each application computes (V x W) D^{-1} (V x W)^H x with four dense matrix products
+   on the na x nb array of the vector. This needs na^2 + nb^2 + na nb storage and O(na nb (na + nb)) operations.
+
+   In parallel the factors and the vector are gathered on each process, which applies the whole preconditioner.
+
+   Level: intermediate
+
+.seealso:  PCCreate(), PCSetType(), PCType (for list of available types), PC, MATKRONECKER, MatCreateKronecker()
+M*/
+
+PETSC_EXTERN PetscErrorCode PCCreate_Kronecker(PC pc)
+{
+  PC_Kronecker   *kr;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr     = PetscNewLog(pc,&kr);CHKERRQ(ierr);
+  pc->data = (void*)kr;
+
+  pc->ops->apply           = PCApply_Kronecker;
+#if !defined(PETSC_USE_COMPLEX)
+  pc->ops->applytranspose  = PCApply_Kronecker;
+#endif
+  pc->ops->setup           = PCSetUp_Kronecker;
+  pc->ops->reset           = PCReset_Kronecker;
+  pc->ops->destroy         = PCDestroy_Kronecker;
+  pc->ops->view            = PCView_Kronecker;
+  pc->ops->applyrichardson = NULL;
+  PetscFunctionReturn(0);
+}
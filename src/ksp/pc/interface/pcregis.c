@@ -59,6 +59,7 @@ PETSC_EXTERN PetscErrorCode PCCreate_PARMS(PC);
 #endif
 PETSC_EXTERN PetscErrorCode PCCreate_BDDC(PC);
 PETSC_EXTERN PetscErrorCode PCCreate_Deflation(PC);
+PETSC_EXTERN PetscErrorCode PCCreate_Kronecker(PC);
 #if defined(PETSC_HAVE_HPDDM) && defined(PETSC_HAVE_DYNAMIC_LIBRARIES) && defined(PETSC_USE_SHARED_LIBRARIES)
 PETSC_EXTERN PetscErrorCode PCCreate_HPDDM(PC);
 #endif
@@ -119,6 +120,7 @@ PetscErrorCode  PCRegisterAll(void)
   ierr = PCRegister(PCTELESCOPE    ,PCCreate_Telescope);CHKERRQ(ierr);
   ierr = PCRegister(PCPATCH        ,PCCreate_Patch);CHKERRQ(ierr);
   ierr = PCRegister(PCHMG          ,PCCreate_HMG);CHKERRQ(ierr);
+  ierr = PCRegister(PCKRONECKER    ,PCCreate_Kronecker);CHKERRQ(ierr);
 #if defined(PETSC_HAVE_ML)
   ierr = PCRegister(PCML           ,PCCreate_ML);CHKERRQ(ierr);
 #endif
@@ -2853,7 +2853,7 @@ PetscErrorCode  MatSeqBAIJSetPreallocation_SeqBAIJ(Mat B,PetscInt bs,PetscInt nz
   Mat_SeqBAIJ    *b;
   PetscErrorCode ierr;
   PetscInt       i,mbs,nbs,bs2;
-  PetscBool      flg = PETSC_FALSE,skipallocation = PETSC_FALSE,realalloc = PETSC_FALSE;
+  PetscBool      flg = PETSC_FALSE,skipallocation = PETSC_FALSE,realalloc = PETSC_FALSE,bsops;
 
   PetscFunctionBegin;
   if (nz >= 0 || nnz) realalloc = PETSC_TRUE;
@@ -2889,6 +2889,9 @@ PetscErrorCode  MatSeqBAIJSetPreallocation_SeqBAIJ(Mat B,PetscInt bs,PetscInt nz
   ierr = PetscOptionsBool("-mat_no_unroll","Do not optimize for block size (slow)",NULL,flg,&flg,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsEnd();CHKERRQ(ierr);
 
+  B->ops->multtranspose    = MatMultTranspose_SeqBAIJ;
+  B->ops->multtransposeadd = MatMultTransposeAdd_SeqBAIJ;
+  B->ops->sor              = MatSOR_SeqBAIJ;
   if (!flg) {
     switch (bs) {
     case 1:
@@ -2932,9 +2935,7 @@ PetscErrorCode  MatSeqBAIJSetPreallocation_SeqBAIJ(Mat B,PetscInt bs,PetscInt nz
         break;
 #endif
       default:
-        B->ops->mult    = MatMult_SeqBAIJ_N;
-        B->ops->multadd = MatMultAdd_SeqBAIJ_N;
-        ierr = PetscInfo1((PetscObject)B,"Using BLAS for MatMult for BAIJ for blocksize %D\n",bs);CHKERRQ(ierr);
+        ierr = MatSeqBAIJSetOps_BS(B,PETSC_TRUE,&bsops);CHKERRQ(ierr);
         break;
       }
       break;
@@ -3003,13 +3004,17 @@ PetscErrorCode  MatSeqBAIJSetPreallocation_SeqBAIJ(Mat B,PetscInt bs,PetscInt nz
       break;
     }
     default:
-      B->ops->mult    = MatMult_SeqBAIJ_N;
-      B->ops->multadd = MatMultAdd_SeqBAIJ_N;
-      ierr = PetscInfo1((PetscObject)B,"Using BLAS for MatMult for BAIJ for blocksize %D\n",bs);CHKERRQ(ierr);
+      ierr = MatSeqBAIJSetOps_BS(B,PETSC_TRUE,&bsops);CHKERRQ(ierr);
+      if (!bsops) {
+        B->ops->mult    = MatMult_SeqBAIJ_N;
+        B->ops->multadd = MatMultAdd_SeqBAIJ_N;
+        ierr = PetscInfo1((PetscObject)B,"Using BLAS for MatMult for BAIJ for blocksize %D\n",bs);CHKERRQ(ierr);
+      }
       break;
     }
+    /* the transpose products and SOR of the block sizes with a hand-unrolled MatMult() */
+    ierr = MatSeqBAIJSetOps_BS(B,PETSC_FALSE,&bsops);CHKERRQ(ierr);
   }
-  B->ops->sor = MatSOR_SeqBAIJ;
   b->mbs = mbs;
   b->nbs = nbs;
   if (!skipallocation) {
@@ -69,6 +69,7 @@ PETSC_INTERN PetscErrorCode MatGetInfo_SeqBAIJ(Mat,MatInfoType,MatInfo*);
 PETSC_INTERN PetscErrorCode MatZeroEntries_SeqBAIJ(Mat);
 PETSC_INTERN PetscErrorCode MatDestroy_SeqBAIJ(Mat);
 PETSC_INTERN PetscErrorCode MatAssemblyEnd_SeqBAIJ(Mat,MatAssemblyType);
+PETSC_INTERN PetscErrorCode MatSeqBAIJSetOps_BS(Mat,PetscBool,PetscBool*);
 
 PETSC_INTERN PetscErrorCode MatSeqBAIJ_UpdateFactorNumeric_NaturalOrdering(Mat);
 
@@ -0,0 +1,297 @@
+/*
+    Matrix-vector product, transpose product and SOR kernels for MATSEQBAIJ for the block sizes 6 to 32 that do not
+    have a hand-unrolled version.
+
+    Each kernel is written once for a block size bs and instantiated for every block size with bs a compile time
+    constant, so the loops over a block are unrolled and vectorized by the compiler. The bs sums of a block row are
+    kept in a local array (registers for the smaller block sizes) while all the blocks of the row stream through, and
+    since the blocks are stored by columns the inner loop runs down a contiguous column of the block.
+*/
+#include <../src/mat/impls/baij/seq/baij.h>
+
+#define MATSEQBAIJ_BS_MAX 32
+
+/* s = s + sign*A_i x over the nz blocks v of a block row with block column indices vi */
+PETSC_STATIC_INLINE void MatSeqBAIJRowAXPY_Private(const PetscInt bs,PetscScalar sign,PetscInt nz,const MatScalar *v,const PetscInt *vi,const PetscScalar *x,PetscScalar *s)
+{
+  const PetscScalar *xb;
+  PetscScalar       xc;
+  PetscInt          j,c,r;
+
+  for (j=0; j<nz; j++) {
+    xb = x + bs*vi[j];
+    for (c=0; c<bs; c++) {
+      xc = sign*xb[c];
+      PetscPragmaSIMD
+      for (r=0; r<bs; r++) s[r] += v[r]*xc;
+      v += bs;
+    }
+  }
+}
+
+/* y = D s or y = y + D s for the bs by bs block D */
+PETSC_STATIC_INLINE void MatSeqBAIJBlockMult_Private(const PetscInt bs,PetscBool add,const MatScalar *d,const PetscScalar *s,PetscScalar *y)
+{
+  PetscScalar sum[MATSEQBAIJ_BS_MAX];
+  PetscInt    c,r;
+
+  for (r=0; r<bs; r++) sum[r] = add ? y[r] : 0.0;
+  for (c=0; c<bs; c++) {
+    PetscPragmaSIMD
+    for (r=0; r<bs; r++) sum[r] += d[r]*s[c];
+    d += bs;
+  }
+  for (r=0; r<bs; r++) y[r] = sum[r];
+}
+
+PETSC_STATIC_INLINE PetscErrorCode MatMultAdd_SeqBAIJ_BS_Private(Mat A,Vec xx,Vec yy,Vec zz,const PetscInt bs)
+{
+  Mat_SeqBAIJ       *a = (Mat_SeqBAIJ*)A->data;
+  PetscScalar       *z,sum[MATSEQBAIJ_BS_MAX];
+  const PetscScalar *x;
+  const MatScalar   *v = a->a;
+  const PetscInt    *idx = a->j,*ii,*ridx = NULL;
+  PetscInt          mbs,i,r,n,bs2 = bs*bs;
+  PetscBool         usecprow = a->compressedrow.use;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (yy) {ierr = VecCopy(yy,zz);CHKERRQ(ierr);}
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  if (yy) {ierr = VecGetArray(zz,&z);CHKERRQ(ierr);}
+  else {ierr = VecGetArrayWrite(zz,&z);CHKERRQ(ierr);}
+  if (usecprow) {
+    mbs  = a->compressedrow.nrows;
+    ii   = a->compressedrow.i;
+    ridx = a->compressedrow.rindex;
+    if (!yy) {ierr = PetscArrayzero(z,bs*a->mbs);CHKERRQ(ierr);}
+  } else {
+    mbs = a->mbs;
+    ii  = a->i;
+  }
+  for (i=0; i<mbs; i++) {
+    PetscScalar *zb = z + bs*(usecprow ? ridx[i] : i);
+
+    n = ii[i+1] - ii[i];
+    for (r=0; r<bs; r++) sum[r] = yy ? zb[r] : 0.0;
+    MatSeqBAIJRowAXPY_Private(bs,1.0,n,v,idx,x,sum);
+    for (r=0; r<bs; r++) zb[r] = sum[r];
+    v   += n*bs2;
+    idx += n;
+  }
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  if (yy) {
+    ierr = VecRestoreArray(zz,&z);CHKERRQ(ierr);
+    ierr = PetscLogFlops(2.0*a->nz*bs2);CHKERRQ(ierr);
+  } else {
+    ierr = VecRestoreArrayWrite(zz,&z);CHKERRQ(ierr);
+    ierr = PetscLogFlops(2.0*a->nz*bs2 - bs*a->nonzerorowcnt);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+PETSC_STATIC_INLINE PetscErrorCode MatMultTransposeAdd_SeqBAIJ_BS_Private(Mat A,Vec xx,Vec yy,Vec zz,const PetscInt bs)
+{
+  Mat_SeqBAIJ       *a = (Mat_SeqBAIJ*)A->data;
+  PetscScalar       *z,*zb,xr[MATSEQBAIJ_BS_MAX],sum;
+  const PetscScalar *x,*xb;
+  const MatScalar   *v = a->a;
+  const PetscInt    *idx = a->j,*ii,*ridx = NULL;
+  PetscInt          mbs,i,j,c,r,n;
+  PetscBool         usecprow = a->compressedrow.use;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (!yy) {ierr = VecSet(zz,0.0);CHKERRQ(ierr);}
+  else if (yy != zz) {ierr = VecCopy(yy,zz);CHKERRQ(ierr);}
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(zz,&z);CHKERRQ(ierr);
+  if (usecprow) {
+    mbs  = a->compressedrow.nrows;
+    ii   = a->compressedrow.i;
+    ridx = a->compressedrow.rindex;
+  } else {
+    mbs = a->mbs;
+    ii  = a->i;
+  }
+  for (i=0; i<mbs; i++) {
+    xb = x + bs*(usecprow ? ridx[i] : i);
+    for (r=0; r<bs; r++) xr[r] = xb[r];
+    n = ii[i+1] - ii[i];
+    for (j=0; j<n; j++) {
+      zb = z + bs*idx[j];
+      for (c=0; c<bs; c++) {
+        sum = 0.0;
+        for (r=0; r<bs; r++) sum += v[r]*xr[r];
+        zb[c] += sum;
+        v     += bs;
+      }
+    }
+    idx += n;
+  }
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(zz,&z);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*a->nz*a->bs2);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PETSC_STATIC_INLINE PetscErrorCode MatSOR_SeqBAIJ_BS_Private(Mat A,Vec bb,PetscReal omega,MatSORType flag,PetscReal fshift,PetscInt its,PetscInt lits,Vec xx,const PetscInt bs)
+{
+  Mat_SeqBAIJ       *a = (Mat_SeqBAIJ*)A->data;
+  PetscScalar       *x,*t,s[MATSEQBAIJ_BS_MAX];
+  const PetscScalar *b,*xb;
+  const MatScalar   *aa = a->a,*idiag;
+  const PetscInt    *diag,*ai = a->i,*aj = a->j;
+  PetscInt          m = a->mbs,i,r,nz,bs2 = bs*bs;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  its = its*lits;
+  if (flag & SOR_EISENSTAT) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"No support yet for Eisenstat");
+  if (its <= 0) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONG,"Relaxation requires global its %D and local its %D both positive",its,lits);
+  if (fshift) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"No support for diagonal shift");
+  if (omega != 1.0) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"No support for non-trivial relaxation factor");
+  if ((flag & SOR_APPLY_UPPER) || (flag & SOR_APPLY_LOWER)) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"No support for applying upper or lower triangular parts");
+
+  if (!a->idiagvalid) {ierr = MatInvertBlockDiagonal(A,NULL);CHKERRQ(ierr);}
+  if (!m) PetscFunctionReturn(0);
+  diag = a->diag;
+  if (!a->sor_workt) {ierr = PetscMalloc1(PetscMax(A->rmap->n,A->cmap->n),&a->sor_workt);CHKERRQ(ierr);}
+  t = a->sor_workt;
+
+  ierr = VecGetArray(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+
+  if (flag & SOR_ZERO_INITIAL_GUESS) {
+    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
+      idiag = a->idiag;
+      for (i=0; i<m; i++) {
+        for (r=0; r<bs; r++) s[r] = b[bs*i+r];
+        MatSeqBAIJRowAXPY_Private(bs,-1.0,diag[i]-ai[i],aa+bs2*ai[i],aj+ai[i],x,s);
+        for (r=0; r<bs; r++) t[bs*i+r] = s[r];
+        MatSeqBAIJBlockMult_Private(bs,PETSC_FALSE,idiag,s,x+bs*i);
+        idiag += bs2;
+      }
+      /* for logging purposes assume number of nonzero in lower half is 1/2 of total */
+      ierr = PetscLogFlops(1.0*bs2*a->nz);CHKERRQ(ierr);
+      xb = t;
+    } else xb = b;
+    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
+      idiag = a->idiag+bs2*(m-1);
+      for (i=m-1; i>=0; i--) {
+        nz = ai[i+1] - diag[i] - 1;
+        for (r=0; r<bs; r++) s[r] = xb[bs*i+r];
+        MatSeqBAIJRowAXPY_Private(bs,-1.0,nz,aa+bs2*(diag[i]+1),aj+diag[i]+1,x,s);
+        MatSeqBAIJBlockMult_Private(bs,PETSC_FALSE,idiag,s,x+bs*i);
+        idiag -= bs2;
+      }
+      ierr = PetscLogFlops(1.0*bs2*a->nz);CHKERRQ(ierr);
+    }
+    its--;
+  }
+  while (its--) {
+    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
+      idiag = a->idiag;
+      for (i=0; i<m; i++) {
+        for (r=0; r<bs; r++) s[r] = b[bs*i+r];
+        MatSeqBAIJRowAXPY_Private(bs,-1.0,ai[i+1]-ai[i],aa+bs2*ai[i],aj+ai[i],x,s);
+        MatSeqBAIJBlockMult_Private(bs,PETSC_TRUE,idiag,s,x+bs*i);
+        idiag += bs2;
+      }
+      ierr = PetscLogFlops(2.0*bs2*a->nz);CHKERRQ(ierr);
+    }
+    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
+      idiag = a->idiag+bs2*(m-1);
+      for (i=m-1; i>=0; i--) {
+        for (r=0; r<bs; r++) s[r] = b[bs*i+r];
+        MatSeqBAIJRowAXPY_Private(bs,-1.0,ai[i+1]-ai[i],aa+bs2*ai[i],aj+ai[i],x,s);
+        MatSeqBAIJBlockMult_Private(bs,PETSC_TRUE,idiag,s,x+bs*i);
+        idiag -= bs2;
+      }
+      ierr = PetscLogFlops(2.0*bs2*a->nz);CHKERRQ(ierr);
+    }
+  }
+  ierr = VecRestoreArray(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#define MATSEQBAIJ_BS_KERNELS(bs) \
+  static PetscErrorCode MatMult_SeqBAIJ_##bs##_BS(Mat A,Vec xx,Vec zz) {return MatMultAdd_SeqBAIJ_BS_Private(A,xx,NULL,zz,bs);} \
+  static PetscErrorCode MatMultAdd_SeqBAIJ_##bs##_BS(Mat A,Vec xx,Vec yy,Vec zz) {return MatMultAdd_SeqBAIJ_BS_Private(A,xx,yy,zz,bs);} \
+  static PetscErrorCode MatMultTranspose_SeqBAIJ_##bs##_BS(Mat A,Vec xx,Vec zz) {return MatMultTransposeAdd_SeqBAIJ_BS_Private(A,xx,NULL,zz,bs);} \
+  static PetscErrorCode MatMultTransposeAdd_SeqBAIJ_##bs##_BS(Mat A,Vec xx,Vec yy,Vec zz) {return MatMultTransposeAdd_SeqBAIJ_BS_Private(A,xx,yy,zz,bs);} \
+  static PetscErrorCode MatSOR_SeqBAIJ_##bs##_BS(Mat A,Vec bb,PetscReal omega,MatSORType flag,PetscReal fshift,PetscInt its,PetscInt lits,Vec xx) {return MatSOR_SeqBAIJ_BS_Private(A,bb,omega,flag,fshift,its,lits,xx,bs);}
+
+MATSEQBAIJ_BS_KERNELS(6)
+MATSEQBAIJ_BS_KERNELS(7)
+MATSEQBAIJ_BS_KERNELS(8)
+MATSEQBAIJ_BS_KERNELS(9)
+MATSEQBAIJ_BS_KERNELS(10)
+MATSEQBAIJ_BS_KERNELS(11)
+MATSEQBAIJ_BS_KERNELS(12)
+MATSEQBAIJ_BS_KERNELS(13)
+MATSEQBAIJ_BS_KERNELS(14)
+MATSEQBAIJ_BS_KERNELS(15)
+MATSEQBAIJ_BS_KERNELS(16)
+MATSEQBAIJ_BS_KERNELS(17)
+MATSEQBAIJ_BS_KERNELS(18)
+MATSEQBAIJ_BS_KERNELS(19)
+MATSEQBAIJ_BS_KERNELS(20)
+MATSEQBAIJ_BS_KERNELS(21)
+MATSEQBAIJ_BS_KERNELS(22)
+MATSEQBAIJ_BS_KERNELS(23)
+MATSEQBAIJ_BS_KERNELS(24)
+MATSEQBAIJ_BS_KERNELS(25)
+MATSEQBAIJ_BS_KERNELS(26)
+MATSEQBAIJ_BS_KERNELS(27)
+MATSEQBAIJ_BS_KERNELS(28)
+MATSEQBAIJ_BS_KERNELS(29)
+MATSEQBAIJ_BS_KERNELS(30)
+MATSEQBAIJ_BS_KERNELS(31)
+MATSEQBAIJ_BS_KERNELS(32)
+
+#define MATSEQBAIJ_BS_OPS(bs) {MatMult_SeqBAIJ_##bs##_BS,MatMultAdd_SeqBAIJ_##bs##_BS,MatMultTranspose_SeqBAIJ_##bs##_BS,MatMultTransposeAdd_SeqBAIJ_##bs##_BS,MatSOR_SeqBAIJ_##bs##_BS}
+
+static const struct {
+  PetscErrorCode (*mult)(Mat,Vec,Vec);
+  PetscErrorCode (*multadd)(Mat,Vec,Vec,Vec);
+  PetscErrorCode (*multtranspose)(Mat,Vec,Vec);
+  PetscErrorCode (*multtransposeadd)(Mat,Vec,Vec,Vec);
+  PetscErrorCode (*sor)(Mat,Vec,PetscReal,MatSORType,PetscReal,PetscInt,PetscInt,Vec);
+} MatSeqBAIJBSOps[] = {MATSEQBAIJ_BS_OPS(6), MATSEQBAIJ_BS_OPS(7), MATSEQBAIJ_BS_OPS(8), MATSEQBAIJ_BS_OPS(9), MATSEQBAIJ_BS_OPS(10),
+                       MATSEQBAIJ_BS_OPS(11),MATSEQBAIJ_BS_OPS(12),MATSEQBAIJ_BS_OPS(13),MATSEQBAIJ_BS_OPS(14),MATSEQBAIJ_BS_OPS(15),
+                       MATSEQBAIJ_BS_OPS(16),MATSEQBAIJ_BS_OPS(17),MATSEQBAIJ_BS_OPS(18),MATSEQBAIJ_BS_OPS(19),MATSEQBAIJ_BS_OPS(20),
+                       MATSEQBAIJ_BS_OPS(21),MATSEQBAIJ_BS_OPS(22),MATSEQBAIJ_BS_OPS(23),MATSEQBAIJ_BS_OPS(24),MATSEQBAIJ_BS_OPS(25),
+                       MATSEQBAIJ_BS_OPS(26),MATSEQBAIJ_BS_OPS(27),MATSEQBAIJ_BS_OPS(28),MATSEQBAIJ_BS_OPS(29),MATSEQBAIJ_BS_OPS(30),
+                       MATSEQBAIJ_BS_OPS(31),MATSEQBAIJ_BS_OPS(32)};
+
+/*
+   MatSeqBAIJSetOps_BS - uses the fixed block size kernels for the products and SOR of a MATSEQBAIJ matrix
+
+   Input Parameters:
++  B    - the matrix, with its block size set
+-  mult - also use them for MatMult() and MatMultAdd(); otherwise only the transpose products and SOR are set
+
+   Output Parameter:
+.  flg - PETSC_TRUE if the block size is covered by the kernels
+*/
+PetscErrorCode MatSeqBAIJSetOps_BS(Mat B,PetscBool mult,PetscBool *flg)
+{
+  const PetscInt bs = B->rmap->bs;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  *flg = (bs >= 6 && bs <= MATSEQBAIJ_BS_MAX) ? PETSC_TRUE : PETSC_FALSE;
+  if (!*flg) PetscFunctionReturn(0);
+  if (mult) {
+    B->ops->mult    = MatSeqBAIJBSOps[bs-6].mult;
+    B->ops->multadd = MatSeqBAIJBSOps[bs-6].multadd;
+    ierr = PetscInfo1((PetscObject)B,"Using fixed block size kernels for MatMult for BAIJ for blocksize %D\n",bs);CHKERRQ(ierr);
+  }
+  B->ops->multtranspose    = MatSeqBAIJBSOps[bs-6].multtranspose;
+  B->ops->multtransposeadd = MatSeqBAIJBSOps[bs-6].multtransposeadd;
+  /* SOR for the block sizes up to 7 is already unrolled */
+  if (bs > 7) B->ops->sor = MatSeqBAIJBSOps[bs-6].sor;
+  PetscFunctionReturn(0);
+}
@@ -0,0 +1,488 @@
+
+/*
+    Matrix-free sums of Kronecker products  A_0 x B_0 + A_1 x B_1 + ...
+*/
+#include <petsc/private/matimpl.h>        /*I "petscmat.h" I*/
+
+/*
+   Row i*mb+k of A x B is row i of A times row k of B, so on each process the vector x splits into the nb
+   (or mb) long pieces x_j that belong to the locally owned columns j of A. Each term is applied as
+
+     (A x B) x = (A x I_mb) (I x B) x         with  (I x B) x = B [x_0 x_1 ...]  a local product with a dense matrix
+                                                    (A x I_mb)   the MAIJ matrix of A with mb components
+
+   and its transpose as (I x B^T) (A^T x I_mb).
+*/
+typedef struct {
+  PetscInt  nterms;
+  Mat       *A,*B;            /* the factors of each term */
+  PetscInt  mb,nb;            /* size of the B factors */
+  PetscBool setup;            /* the work data below has been created */
+  Mat       *mA;              /* MAIJ matrices of the A factors with mb components */
+  Mat       X,Z;              /* dense nb x n and mb x n placeholders for the local pieces of the input */
+  Mat       *BX,*BtZ;         /* the products B X and B^T Z of each term */
+  Vec       z,w;              /* work vectors with the layouts of the columns of mA and of the matrix */
+} Mat_Kronecker;
+
+static PetscErrorCode MatKroneckerReset_Private(Mat C)
+{
+  Mat_Kronecker  *k = (Mat_Kronecker*)C->data;
+  PetscInt       t;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!k->setup) PetscFunctionReturn(0);
+  for (t=0; t<k->nterms; t++) {
+    ierr = MatDestroy(&k->mA[t]);CHKERRQ(ierr);
+    ierr = MatDestroy(&k->BX[t]);CHKERRQ(ierr);
+    ierr = MatDestroy(&k->BtZ[t]);CHKERRQ(ierr);
+  }
+  ierr = PetscFree3(k->mA,k->BX,k->BtZ);CHKERRQ(ierr);
+  ierr = MatDestroy(&k->X);CHKERRQ(ierr);
+  ierr = MatDestroy(&k->Z);CHKERRQ(ierr);
+  ierr = VecDestroy(&k->z);CHKERRQ(ierr);
+  ierr = VecDestroy(&k->w);CHKERRQ(ierr);
+  k->setup = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatKroneckerSetUp_Private(Mat C)
+{
+  Mat_Kronecker  *k = (Mat_Kronecker*)C->data;
+  PetscInt       t,n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (k->setup) PetscFunctionReturn(0);
+  if (!k->nterms) SETERRQ(PetscObjectComm((PetscObject)C),PETSC_ERR_ARG_WRONGSTATE,"Must provide at least one term with MatKroneckerAddTerm()");
+  n    = k->A[0]->cmap->n;
+  ierr = PetscCalloc3(k->nterms,&k->mA,k->nterms,&k->BX,k->nterms,&k->BtZ);CHKERRQ(ierr);
+  for (t=0; t<k->nterms; t++) {
+    ierr = MatCreateMAIJ(k->A[t],k->mb,&k->mA[t]);CHKERRQ(ierr);
+  }
+  ierr = MatCreateVecs(k->mA[0],&k->z,NULL);CHKERRQ(ierr);
+  ierr = MatCreateVecs(C,&k->w,NULL);CHKERRQ(ierr);
+  /* the B products are local, a process without columns of A has nothing to compute */
+  if (n) {
+    ierr = MatCreateSeqDense(PETSC_COMM_SELF,k->nb,n,NULL,&k->X);CHKERRQ(ierr);
+    ierr = MatCreateSeqDense(PETSC_COMM_SELF,k->mb,n,NULL,&k->Z);CHKERRQ(ierr);
+    ierr = MatAssemblyBegin(k->X,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(k->X,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyBegin(k->Z,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(k->Z,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    for (t=0; t<k->nterms; t++) {
+      ierr = MatProductCreate(k->B[t],k->X,NULL,&k->BX[t]);CHKERRQ(ierr);
+      ierr = MatProductSetType(k->BX[t],MATPRODUCT_AB);CHKERRQ(ierr);
+      ierr = MatProductSetFromOptions(k->BX[t]);CHKERRQ(ierr);
+      ierr = MatProductSymbolic(k->BX[t]);CHKERRQ(ierr);
+      ierr = MatProductCreate(k->B[t],k->Z,NULL,&k->BtZ[t]);CHKERRQ(ierr);
+      ierr = MatProductSetType(k->BtZ[t],MATPRODUCT_AtB);CHKERRQ(ierr);
+      ierr = MatProductSetFromOptions(k->BtZ[t]);CHKERRQ(ierr);
+      ierr = MatProductSymbolic(k->BtZ[t]);CHKERRQ(ierr);
+    }
+  }
+  k->setup = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+/* computes the product P of the local dense matrix with the entries of x, storing it in y */
+static PetscErrorCode MatKroneckerLocalProduct_Private(Mat P,Mat X,Vec x,Vec y)
+{
+  const PetscScalar *xa;
+  PetscScalar       *ya;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (!P) PetscFunctionReturn(0);
+  ierr = VecGetArrayRead(x,&xa);CHKERRQ(ierr);
+  ierr = VecGetArrayWrite(y,&ya);CHKERRQ(ierr);
+  ierr = MatDensePlaceArray(X,xa);CHKERRQ(ierr);
+  ierr = MatDensePlaceArray(P,ya);CHKERRQ(ierr);
+  ierr = MatProductNumeric(P);CHKERRQ(ierr);
+  ierr = MatDenseResetArray(P);CHKERRQ(ierr);
+  ierr = MatDenseResetArray(X);CHKERRQ(ierr);
+  ierr = VecRestoreArrayWrite(y,&ya);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(x,&xa);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* y = y0 + C x, y0 may be NULL */
+static PetscErrorCode MatMultKernel_Kronecker(Mat C,Vec x,Vec y0,Vec y)
+{
+  Mat_Kronecker  *k = (Mat_Kronecker*)C->data;
+  PetscInt       t;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatKroneckerSetUp_Private(C);CHKERRQ(ierr);
+  for (t=0; t<k->nterms; t++) {
+    ierr = MatKroneckerLocalProduct_Private(k->BX[t],k->X,x,k->z);CHKERRQ(ierr);
+    if (t) {
+      ierr = MatMultAdd(k->mA[t],k->z,y,y);CHKERRQ(ierr);
+    } else if (y0) {
+      ierr = MatMultAdd(k->mA[t],k->z,y0,y);CHKERRQ(ierr);
+    } else {
+      ierr = MatMult(k->mA[t],k->z,y);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/* y = y0 + C^T x, y0 may be NULL */
+static PetscErrorCode MatMultTransposeKernel_Kronecker(Mat C,Vec x,Vec y0,Vec y)
+{
+  Mat_Kronecker  *k = (Mat_Kronecker*)C->data;
+  PetscInt       t;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatKroneckerSetUp_Private(C);CHKERRQ(ierr);
+  for (t=0; t<k->nterms; t++) {
+    ierr = MatMultTranspose(k->mA[t],x,k->z);CHKERRQ(ierr);
+    if (!t && !y0) {
+      ierr = MatKroneckerLocalProduct_Private(k->BtZ[t],k->Z,k->z,y);CHKERRQ(ierr);
+    } else {
+      ierr = MatKroneckerLocalProduct_Private(k->BtZ[t],k->Z,k->z,k->w);CHKERRQ(ierr);
+      if (!t && y0 != y) {
+        ierr = VecWAXPY(y,1.0,k->w,y0);CHKERRQ(ierr);
+      } else {
+        ierr = VecAXPY(y,1.0,k->w);CHKERRQ(ierr);
+      }
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatMult_Kronecker(Mat C,Vec x,Vec y)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatMultKernel_Kronecker(C,x,NULL,y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatMultAdd_Kronecker(Mat C,Vec x,Vec y,Vec z)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatMultKernel_Kronecker(C,x,y,z);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatMultTranspose_Kronecker(Mat C,Vec x,Vec y)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatMultTransposeKernel_Kronecker(C,x,NULL,y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatMultTransposeAdd_Kronecker(Mat C,Vec x,Vec y,Vec z)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatMultTransposeKernel_Kronecker(C,x,y,z);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatGetDiagonal_Kronecker(Mat C,Vec v)
+{
+  Mat_Kronecker     *k = (Mat_Kronecker*)C->data;
+  Vec               dA,dB;
+  const PetscScalar *a,*b;
+  PetscScalar       *d;
+  PetscInt          t,i,j,m = C->rmap->n/PetscMax(k->mb,1);
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (!k->nterms) SETERRQ(PetscObjectComm((PetscObject)C),PETSC_ERR_ARG_WRONGSTATE,"Must provide at least one term with MatKroneckerAddTerm()");
+  if (k->mb != k->nb) SETERRQ2(PetscObjectComm((PetscObject)C),PETSC_ERR_SUP,"Only for square B factors, not %D x %D",k->mb,k->nb);
+  ierr = MatCreateVecs(k->A[0],NULL,&dA);CHKERRQ(ierr);
+  ierr = MatCreateVecs(k->B[0],NULL,&dB);CHKERRQ(ierr);
+  ierr = VecSet(v,0.0);CHKERRQ(ierr);
+  ierr = VecGetArray(v,&d);CHKERRQ(ierr);
+  for (t=0; t<k->nterms; t++) {
+    ierr = MatGetDiagonal(k->A[t],dA);CHKERRQ(ierr);
+    ierr = MatGetDiagonal(k->B[t],dB);CHKERRQ(ierr);
+    ierr = VecGetArrayRead(dA,&a);CHKERRQ(ierr);
+    ierr = VecGetArrayRead(dB,&b);CHKERRQ(ierr);
+    for (i=0; i<m; i++) {
+      for (j=0; j<k->mb; j++) d[i*k->mb+j] += a[i]*b[j];
+    }
+    ierr = VecRestoreArrayRead(dA,&a);CHKERRQ(ierr);
+    ierr = VecRestoreArrayRead(dB,&b);CHKERRQ(ierr);
+  }
+  ierr = VecRestoreArray(v,&d);CHKERRQ(ierr);
+  ierr = VecDestroy(&dA);CHKERRQ(ierr);
+  ierr = VecDestroy(&dB);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*k->nterms*C->rmap->n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatView_Kronecker(Mat C,PetscViewer viewer)
+{
+  Mat_Kronecker  *k = (Mat_Kronecker*)C->data;
+  PetscInt       t;
+  PetscBool      iascii;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (iascii) {
+    ierr = PetscViewerASCIIPrintf(viewer,"Kronecker product sum of %D term(s)\n",k->nterms);CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPushTab(viewer);CHKERRQ(ierr);
+    for (t=0; t<k->nterms; t++) {
+      ierr = PetscViewerASCIIPrintf(viewer,"term %D: %s %D x %D times %s %D x %D\n",t,((PetscObject)k->A[t])->type_name,k->A[t]->rmap->N,k->A[t]->cmap->N,((PetscObject)k->B[t])->type_name,k->mb,k->nb);CHKERRQ(ierr);
+    }
+    ierr = PetscViewerASCIIPopTab(viewer);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatDestroy_Kronecker(Mat C)
+{
+  Mat_Kronecker  *k = (Mat_Kronecker*)C->data;
+  PetscInt       t;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatKroneckerReset_Private(C);CHKERRQ(ierr);
+  for (t=0; t<k->nterms; t++) {
+    ierr = MatDestroy(&k->A[t]);CHKERRQ(ierr);
+    ierr = MatDestroy(&k->B[t]);CHKERRQ(ierr);
+  }
+  ierr = PetscFree2(k->A,k->B);CHKERRQ(ierr);
+  ierr = PetscFree(C->data);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)C,"MatKroneckerAddTerm_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)C,"MatKroneckerGetNumberTerms_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)C,"MatKroneckerGetTerm_C",NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatKroneckerAddTerm_Kronecker(Mat C,Mat A,Mat B)
+{
+  Mat_Kronecker  *k = (Mat_Kronecker*)C->data;
+  Mat            *As,*Bs;
+  PetscBool      isaij;
+  PetscMPIInt    size;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectBaseTypeCompareAny((PetscObject)A,&isaij,MATSEQAIJ,MATMPIAIJ,"");CHKERRQ(ierr);
+  if (!isaij) SETERRQ1(PetscObjectComm((PetscObject)C),PETSC_ERR_SUP,"The A factor must be an AIJ matrix, not %s",((PetscObject)A)->type_name);
+  ierr = MPI_Comm_size(PetscObjectComm((PetscObject)B),&size);CHKERRMPI(ierr);
+  if (size > 1) SETERRQ(PetscObjectComm((PetscObject)C),PETSC_ERR_ARG_WRONG,"The B factor must be a sequential matrix");
+  if (k->nterms && (B->rmap->N != k->mb || B->cmap->N != k->nb)) SETERRQ4(PetscObjectComm((PetscObject)C),PETSC_ERR_ARG_SIZ,"The B factor is %D x %D, the previous ones are %D x %D",B->rmap->N,B->cmap->N,k->mb,k->nb);
+  if (A->rmap->n*B->rmap->N != C->rmap->n || A->cmap->n*B->cmap->N != C->cmap->n) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_SIZ,"The local sizes of the factors do not match those of the matrix %D x %D",C->rmap->n,C->cmap->n);
+  if (A->rmap->N*B->rmap->N != C->rmap->N || A->cmap->N*B->cmap->N != C->cmap->N) SETERRQ2(PetscObjectComm((PetscObject)C),PETSC_ERR_ARG_SIZ,"The sizes of the factors do not match those of the matrix %D x %D",C->rmap->N,C->cmap->N);
+
+  ierr = MatKroneckerReset_Private(C);CHKERRQ(ierr);
+  ierr = PetscMalloc2(k->nterms+1,&As,k->nterms+1,&Bs);CHKERRQ(ierr);
+  ierr = PetscArraycpy(As,k->A,k->nterms);CHKERRQ(ierr);
+  ierr = PetscArraycpy(Bs,k->B,k->nterms);CHKERRQ(ierr);
+  ierr = PetscFree2(k->A,k->B);CHKERRQ(ierr);
+  ierr = PetscObjectReference((PetscObject)A);CHKERRQ(ierr);
+  ierr = PetscObjectReference((PetscObject)B);CHKERRQ(ierr);
+  As[k->nterms]   = A;
+  Bs[k->nterms]   = B;
+  k->A            = As;
+  k->B            = Bs;
+  k->mb           = B->rmap->N;
+  k->nb           = B->cmap->N;
+  k->nterms++;
+  ierr = PetscObjectStateIncrease((PetscObject)C);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatKroneckerGetNumberTerms_Kronecker(Mat C,PetscInt *nterms)
+{
+  Mat_Kronecker *k = (Mat_Kronecker*)C->data;
+
+  PetscFunctionBegin;
+  *nterms = k->nterms;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatKroneckerGetTerm_Kronecker(Mat C,PetscInt t,Mat *A,Mat *B)
+{
+  Mat_Kronecker *k = (Mat_Kronecker*)C->data;
+
+  PetscFunctionBegin;
+  if (t < 0 || t >= k->nterms) SETERRQ2(PetscObjectComm((PetscObject)C),PETSC_ERR_ARG_OUTOFRANGE,"Term %D out of range, the matrix has %D terms",t,k->nterms);
+  if (A) *A = k->A[t];
+  if (B) *B = k->B[t];
+  PetscFunctionReturn(0);
+}
+
+/*@
+   MatKroneckerAddTerm - Adds the term A x B to a MATKRONECKER matrix
+
+   Collective on Mat
+
+   Input Parameters:
++  C - the MATKRONECKER matrix
+.  A - the first factor, an AIJ matrix with the parallel layout of the matrix
+-  B - the second factor, a sequential matrix with the same entries on each process
+
+   Notes:
+   The local sizes of C must be those of A times the global sizes of B, all terms must have B factors of the same size.
+
+   Level: advanced
+
+.seealso: MatCreateKronecker(), MatKroneckerGetNumberTerms(), MatKroneckerGetTerm(), MATKRONECKER
+@*/
+PetscErrorCode MatKroneckerAddTerm(Mat C,Mat A,Mat B)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(C,MAT_CLASSID,1);
+  PetscValidHeaderSpecific(A,MAT_CLASSID,2);
+  PetscValidHeaderSpecific(B,MAT_CLASSID,3);
+  PetscCheckSameComm(C,1,A,2);
+  ierr = PetscUseMethod(C,"MatKroneckerAddTerm_C",(Mat,Mat,Mat),(C,A,B));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   MatKroneckerGetNumberTerms - Returns the number of Kronecker product terms of a MATKRONECKER matrix
+
+   Not Collective
+
+   Input Parameter:
+.  C - the MATKRONECKER matrix
+
+   Output Parameter:
+.  nterms - the number of terms
+
+   Level: advanced
+
+.seealso: MatCreateKronecker(), MatKroneckerAddTerm(), MatKroneckerGetTerm(), MATKRONECKER
+@*/
+PetscErrorCode MatKroneckerGetNumberTerms(Mat C,PetscInt *nterms)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(C,MAT_CLASSID,1);
+  PetscValidIntPointer(nterms,2);
+  ierr = PetscUseMethod(C,"MatKroneckerGetNumberTerms_C",(Mat,PetscInt*),(C,nterms));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   MatKroneckerGetTerm - Returns the factors of a term of a MATKRONECKER matrix
+
+   Not Collective
+
+   Input Parameters:
++  C - the MATKRONECKER matrix
+-  t - the number of the term
+
+   Output Parameters:
++  A - the first factor (or NULL)
+-  B - the second factor (or NULL)
+
+   Notes:
+   The factors are shared with the matrix, changing their values changes the matrix.
+
+   Level: advanced
+
+.seealso: MatCreateKronecker(), MatKroneckerAddTerm(), MatKroneckerGetNumberTerms(), MATKRONECKER
+@*/
+PetscErrorCode MatKroneckerGetTerm(Mat C,PetscInt t,Mat *A,Mat *B)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(C,MAT_CLASSID,1);
+  ierr = PetscUseMethod(C,"MatKroneckerGetTerm_C",(Mat,PetscInt,Mat*,Mat*),(C,t,A,B));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   MatCreateKronecker - Creates a matrix that applies the Kronecker product A x B without forming it
+
+   Collective on Mat
+
+   Input Parameters:
++  A - the first factor, an AIJ matrix
+-  B - the second factor, a sequential matrix with the same entries on each process
+
+   Output Parameter:
+.  C - the matrix
+
+   Notes:
+   Row i*mb+k of C, where B is mb x nb, is the row i of A times the row k of B. C has the parallel layout of A
+   with each row replaced by mb rows, and the block sizes mb and nb.
+
+   More terms A_1 x B_1 + ... can be added with MatKroneckerAddTerm(). The products are applied as one
+   product of B with a dense matrix holding the local pieces of the vector followed by a product with the
+   MAIJ matrix of A, the memory use is that of the factors instead of that of their Kronecker product.
+
+   MatSeqAIJKron() computes the Kronecker product of two sequential AIJ matrices explicitly.
+
+   Level: advanced
+
+.seealso: MATKRONECKER, MatKroneckerAddTerm(), MatKroneckerGetTerm(), MatSeqAIJKron(), MatCreateMAIJ(), PCKRONECKER
+@*/
+PetscErrorCode MatCreateKronecker(Mat A,Mat B,Mat *C)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A,MAT_CLASSID,1);
+  PetscValidHeaderSpecific(B,MAT_CLASSID,2);
+  PetscValidPointer(C,3);
+  ierr = MatCreate(PetscObjectComm((PetscObject)A),C);CHKERRQ(ierr);
+  ierr = MatSetSizes(*C,A->rmap->n*B->rmap->N,A->cmap->n*B->cmap->N,A->rmap->N*B->rmap->N,A->cmap->N*B->cmap->N);CHKERRQ(ierr);
+  ierr = MatSetBlockSizes(*C,PetscMax(B->rmap->N,1),PetscMax(B->cmap->N,1));CHKERRQ(ierr);
+  ierr = MatSetType(*C,MATKRONECKER);CHKERRQ(ierr);
+  ierr = MatKroneckerAddTerm(*C,A,B);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*MC
+   MATKRONECKER - "kronecker" - A matrix-free sum of Kronecker products A_0 x B_0 + A_1 x B_1 + ... of sparse
+   factors. The A factors are AIJ matrices that may be parallel, the B factors are sequential.
+
+   Operations provided: MatMult(), MatMultAdd(), MatMultTranspose(), MatMultTransposeAdd() and MatGetDiagonal()
+
+   Level: advanced
+
+.seealso: MatCreateKronecker(), MatKroneckerAddTerm(), MatKroneckerGetNumberTerms(), MatKroneckerGetTerm(), MATKAIJ, MATMAIJ, PCKRONECKER
+M*/
+
+PETSC_EXTERN PetscErrorCode MatCreate_Kronecker(Mat C)
+{
+  Mat_Kronecker  *k;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr    = PetscNewLog(C,&k);CHKERRQ(ierr);
+  C->data = (void*)k;
+
+  ierr = PetscLayoutSetUp(C->rmap);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(C->cmap);CHKERRQ(ierr);
+
+  C->assembled    = PETSC_TRUE;
+  C->preallocated = PETSC_TRUE;
+
+  C->ops->mult             = MatMult_Kronecker;
+  C->ops->multadd          = MatMultAdd_Kronecker;
+  C->ops->multtranspose    = MatMultTranspose_Kronecker;
+  C->ops->multtransposeadd = MatMultTransposeAdd_Kronecker;
+  C->ops->getdiagonal      = MatGetDiagonal_Kronecker;
+  C->ops->view             = MatView_Kronecker;
+  C->ops->destroy          = MatDestroy_Kronecker;
+
+  ierr = PetscObjectComposeFunction((PetscObject)C,"MatKroneckerAddTerm_C",MatKroneckerAddTerm_Kronecker);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)C,"MatKroneckerGetNumberTerms_C",MatKroneckerGetNumberTerms_Kronecker);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)C,"MatKroneckerGetTerm_C",MatKroneckerGetTerm_Kronecker);CHKERRQ(ierr);
+  ierr = PetscObjectChangeTypeName((PetscObject)C,MATKRONECKER);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
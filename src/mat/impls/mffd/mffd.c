@@ -91,6 +91,8 @@ static PetscErrorCode  MatMFFDSetType_MFFD(Mat mat,MatMFFDType ftype)
 
   ierr =  PetscFunctionListFind(MatMFFDList,ftype,&r);CHKERRQ(ierr);
   if (!r) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_UNKNOWN_TYPE,"Unknown MatMFFD type %s given",ftype);
+  /* the batched computation of h is optional, so do not inherit the one of the previous type */
+  ctx->ops->computes = NULL;
   ierr = (*r)(ctx);CHKERRQ(ierr);
   ierr = PetscObjectChangeTypeName((PetscObject)ctx,ftype);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -222,6 +224,8 @@ static PetscErrorCode MatDestroy_MFFD(Mat mat)
   PetscFunctionBegin;
   ierr = MatShellGetContext(mat,&ctx);CHKERRQ(ierr);
   ierr = VecDestroy(&ctx->w);CHKERRQ(ierr);
+  ierr = VecDestroyVecs(ctx->nws,&ctx->ws);CHKERRQ(ierr);
+  ierr = VecDestroyVecs(ctx->nws,&ctx->ys);CHKERRQ(ierr);
   ierr = VecDestroy(&ctx->current_u);CHKERRQ(ierr);
   if (ctx->current_f_allocated) {
     ierr = VecDestroy(&ctx->current_f);CHKERRQ(ierr);
@@ -233,6 +237,7 @@ static PetscErrorCode MatDestroy_MFFD(Mat mat)
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMFFDSetFunctioniBase_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMFFDSetFunctioni_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMFFDSetFunction_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMFFDSetFunctionBatch_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMFFDSetFunctionError_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMFFDSetCheckh_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMFFDSetPeriod_C",NULL);CHKERRQ(ierr);
@@ -313,90 +318,180 @@ PETSC_EXTERN PetscErrorCode MatAssemblyEnd_MFFD(Mat J,MatAssemblyType mt)
 }
 
 /*
-  MatMult_MFFD - Default matrix-free form for Jacobian-vector product, y = F'(u)*a:
+  MatMFFDMult_Private - Default matrix-free form for Jacobian-vector products, y[i] = F'(u)*a[i]:
 
-        y ~= (F(u + ha) - F(u))/h,
+        y[i] ~= (F(u + h[i]a[i]) - F(u))/h[i],
   where F = nonlinear function, as set by SNESSetFunction()
         u = current iterate
-        h = difference interval
+        h[i] = difference interval
+
+  The n differencing parameters are computed together when the h routine provides
+  ops->computes(), and the perturbed states w[i] (which may share the storage of a[i])
+  are evaluated in one call of the function set with MatMFFDSetFunctionBatch().
 */
-static PetscErrorCode MatMult_MFFD(Mat mat,Vec a,Vec y)
+static PetscErrorCode MatMFFDMult_Private(Mat mat,PetscInt n,Vec a[],Vec w[],Vec y[])
 {
   MatMFFD        ctx;
-  PetscScalar    h;
-  Vec            w,U,F;
+  PetscScalar    *h;
+  PetscBool      *zeroa,base = PETSC_FALSE;
+  Vec            U,F,*x,*f;
+  PetscInt       i,nx = 0;
   PetscErrorCode ierr;
-  PetscBool      zeroa;
 
   PetscFunctionBegin;
   ierr = MatShellGetContext(mat,&ctx);CHKERRQ(ierr);
   if (!ctx->current_u) SETERRQ(PetscObjectComm((PetscObject)mat),PETSC_ERR_ARG_WRONGSTATE,"MatMFFDSetBase() has not been called, this is often caused by forgetting to call \n\t\tMatAssemblyBegin/End on the first Mat in the SNES compute function");
+  if (!ctx->func && !ctx->funcs) SETERRQ(PetscObjectComm((PetscObject)mat),PETSC_ERR_ARG_WRONGSTATE,"Requires calling MatMFFDSetFunction() or MatMFFDSetFunctionBatch() first");
   /* We log matrix-free matrix-vector products separately, so that we can
      separate the performance monitoring from the cases that use conventional
      storage.  We may eventually modify event logging to associate events
      with particular objects, hence alleviating the more general problem. */
-  ierr = PetscLogEventBegin(MATMFFD_Mult,a,y,0,0);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(MATMFFD_Mult,a[0],y[0],0,0);CHKERRQ(ierr);
 
-  w = ctx->w;
   U = ctx->current_u;
   F = ctx->current_f;
   /*
-      Compute differencing parameter
+      Compute differencing parameters
   */
   if (!((PetscObject)ctx)->type_name) {
     ierr = MatMFFDSetType(mat,MATMFFD_WP);CHKERRQ(ierr);
     ierr = MatSetFromOptions(mat);CHKERRQ(ierr);
   }
-  ierr = (*ctx->ops->compute)(ctx,U,a,&h,&zeroa);CHKERRQ(ierr);
-  if (zeroa) {
-    ierr = VecSet(y,0.0);CHKERRQ(ierr);
-    PetscFunctionReturn(0);
+  ierr = PetscMalloc4(n,&h,n,&zeroa,n+1,&x,n+1,&f);CHKERRQ(ierr);
+  if (n > 1 && ctx->ops->computes) {
+    ierr = (*ctx->ops->computes)(ctx,U,n,a,h,zeroa);CHKERRQ(ierr);
+  } else {
+    for (i=0; i<n; i++) {
+      ierr = (*ctx->ops->compute)(ctx,U,a[i],&h[i],&zeroa[i]);CHKERRQ(ierr);
+      if (!zeroa[i]) ctx->currenth = h[i];
+    }
   }
 
-  if (mat->erroriffailure && PetscIsInfOrNanScalar(h)) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Computed Nan differencing parameter h");
-  if (ctx->checkh) {
-    ierr = (*ctx->checkh)(ctx->checkhctx,U,a,&h);CHKERRQ(ierr);
+  /* compute func(U) as base for differencing; only needed first time in and not when provided by user */
+  if (!ctx->ncurrenth && ctx->current_f_allocated) {
+    for (i=0; i<n; i++) base = (PetscBool)(base || !zeroa[i]);
+    if (base) {x[nx] = U; f[nx++] = F;}
   }
+  for (i=0; i<n; i++) {
+    if (zeroa[i]) {
+      ierr = VecSet(y[i],0.0);CHKERRQ(ierr);
+      continue;
+    }
+    if (mat->erroriffailure && PetscIsInfOrNanScalar(h[i])) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Computed Nan differencing parameter h");
+    if (ctx->checkh) {
+      ierr = (*ctx->checkh)(ctx->checkhctx,U,a[i],&h[i]);CHKERRQ(ierr);
+    }
 
-  /* keep a record of the current differencing parameter h */
-  ctx->currenth = h;
+    /* keep a record of the current differencing parameter h */
+    ctx->currenth = h[i];
 #if defined(PETSC_USE_COMPLEX)
-  ierr = PetscInfo2(mat,"Current differencing parameter: %g + %g i\n",(double)PetscRealPart(h),(double)PetscImaginaryPart(h));CHKERRQ(ierr);
+    ierr = PetscInfo2(mat,"Current differencing parameter: %g + %g i\n",(double)PetscRealPart(h[i]),(double)PetscImaginaryPart(h[i]));CHKERRQ(ierr);
 #else
-  ierr = PetscInfo1(mat,"Current differencing parameter: %15.12e\n",h);CHKERRQ(ierr);
+    ierr = PetscInfo1(mat,"Current differencing parameter: %15.12e\n",h[i]);CHKERRQ(ierr);
 #endif
-  if (ctx->historyh && ctx->ncurrenth < ctx->maxcurrenth) {
-    ctx->historyh[ctx->ncurrenth] = h;
-  }
-  ctx->ncurrenth++;
+    if (ctx->historyh && ctx->ncurrenth < ctx->maxcurrenth) {
+      ctx->historyh[ctx->ncurrenth] = h[i];
+    }
+    ctx->ncurrenth++;
 
 #if defined(PETSC_USE_COMPLEX)
-  if (ctx->usecomplex) h = PETSC_i*h;
+    if (ctx->usecomplex) h[i] = PETSC_i*h[i];
 #endif
 
-  /* w = u + ha */
-  ierr = VecWAXPY(w,h,a,U);CHKERRQ(ierr);
-
-  /* compute func(U) as base for differencing; only needed first time in and not when provided by user */
-  if (ctx->ncurrenth == 1 && ctx->current_f_allocated) {
-    ierr = (*ctx->func)(ctx->funcctx,U,F);CHKERRQ(ierr);
+    /* w = u + ha */
+    if (w[i] == a[i]) {
+      ierr = VecAYPX(w[i],h[i],U);CHKERRQ(ierr);
+    } else {
+      ierr = VecWAXPY(w[i],h[i],a[i],U);CHKERRQ(ierr);
+    }
+    x[nx] = w[i]; f[nx++] = y[i];
   }
-  ierr = (*ctx->func)(ctx->funcctx,w,y);CHKERRQ(ierr);
 
-#if defined(PETSC_USE_COMPLEX)
-  if (ctx->usecomplex) {
-    ierr = VecImaginaryPart(y);CHKERRQ(ierr);
-    h    = PetscImaginaryPart(h);
+  if (ctx->funcs) {
+    if (nx) {ierr = (*ctx->funcs)(ctx->funcsctx,nx,(const Vec*)x,f);CHKERRQ(ierr);}
   } else {
-    ierr = VecAXPY(y,-1.0,F);CHKERRQ(ierr);
+    for (i=0; i<nx; i++) {ierr = (*ctx->func)(ctx->funcctx,x[i],f[i]);CHKERRQ(ierr);}
   }
+
+  for (i=0; i<n; i++) {
+    if (zeroa[i]) continue;
+#if defined(PETSC_USE_COMPLEX)
+    if (ctx->usecomplex) {
+      ierr = VecImaginaryPart(y[i]);CHKERRQ(ierr);
+      h[i] = PetscImaginaryPart(h[i]);
+    } else {
+      ierr = VecAXPY(y[i],-1.0,F);CHKERRQ(ierr);
+    }
 #else
-  ierr = VecAXPY(y,-1.0,F);CHKERRQ(ierr);
+    ierr = VecAXPY(y[i],-1.0,F);CHKERRQ(ierr);
 #endif
-  ierr = VecScale(y,1.0/h);CHKERRQ(ierr);
-  if (mat->nullsp) {ierr = MatNullSpaceRemove(mat->nullsp,y);CHKERRQ(ierr);}
+    ierr = VecScale(y[i],1.0/h[i]);CHKERRQ(ierr);
+    if (mat->nullsp) {ierr = MatNullSpaceRemove(mat->nullsp,y[i]);CHKERRQ(ierr);}
+  }
+  ierr = PetscFree4(h,zeroa,x,f);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(MATMFFD_Mult,a[0],y[0],0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatMult_MFFD(Mat mat,Vec a,Vec y)
+{
+  MatMFFD        ctx;
+  PetscErrorCode ierr;
 
-  ierr = PetscLogEventEnd(MATMFFD_Mult,a,y,0,0);CHKERRQ(ierr);
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(mat,&ctx);CHKERRQ(ierr);
+  ierr = MatMFFDMult_Private(mat,1,&a,&ctx->w,&y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+  MatProductNumeric_MFFD_Dense - C = F'(u)*B for a dense B, with all the columns of B
+  differenced together
+*/
+static PetscErrorCode MatProductNumeric_MFFD_Dense(Mat A,Mat B,Mat C,void *data)
+{
+  MatMFFD        ctx;
+  Vec            v;
+  PetscScalar    *c;
+  PetscInt       i,n,lda;
+  PetscMPIInt    size;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(A,&ctx);CHKERRQ(ierr);
+  if (!ctx->current_u) SETERRQ(PetscObjectComm((PetscObject)A),PETSC_ERR_ARG_WRONGSTATE,"MatMFFDSetBase() has not been called");
+  ierr = MatGetSize(B,NULL,&n);CHKERRQ(ierr);
+  if (!n) PetscFunctionReturn(0);
+  if (n > ctx->nws) {
+    ierr = VecDestroyVecs(ctx->nws,&ctx->ws);CHKERRQ(ierr);
+    ierr = VecDestroyVecs(ctx->nws,&ctx->ys);CHKERRQ(ierr);
+    ierr = VecDuplicateVecs(ctx->current_u,n,&ctx->ws);CHKERRQ(ierr);
+    /* the results have no storage of their own, their arrays are placed on the columns of C */
+    ierr = MPI_Comm_size(PetscObjectComm((PetscObject)A),&size);CHKERRMPI(ierr);
+    ierr = PetscMalloc1(n,&ctx->ys);CHKERRQ(ierr);
+    for (i=0; i<n; i++) {
+      if (size == 1) {
+        ierr = VecCreateSeqWithArray(PetscObjectComm((PetscObject)A),A->rmap->bs,A->rmap->n,NULL,&ctx->ys[i]);CHKERRQ(ierr);
+      } else {
+        ierr = VecCreateMPIWithArray(PetscObjectComm((PetscObject)A),A->rmap->bs,A->rmap->n,A->rmap->N,NULL,&ctx->ys[i]);CHKERRQ(ierr);
+      }
+    }
+    ctx->nws = n;
+  }
+  /* the columns of B are copied into the perturbed states, which are then overwritten in place by u + h*B(:,i) */
+  for (i=0; i<n; i++) {
+    ierr = MatDenseGetColumnVecRead(B,i,&v);CHKERRQ(ierr);
+    ierr = VecCopy(v,ctx->ws[i]);CHKERRQ(ierr);
+    ierr = MatDenseRestoreColumnVecRead(B,i,&v);CHKERRQ(ierr);
+  }
+  ierr = MatDenseGetLDA(C,&lda);CHKERRQ(ierr);
+  ierr = MatDenseGetArrayWrite(C,&c);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {ierr = VecPlaceArray(ctx->ys[i],c+i*lda);CHKERRQ(ierr);}
+  ierr = MatMFFDMult_Private(A,n,ctx->ws,ctx->ws,ctx->ys);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {ierr = VecResetArray(ctx->ys[i]);CHKERRQ(ierr);}
+  ierr = MatDenseRestoreArrayWrite(C,&c);CHKERRQ(ierr);
+  ierr = MatAssemblyBegin(C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -586,6 +681,18 @@ static PetscErrorCode  MatMFFDSetFunction_MFFD(Mat mat,PetscErrorCode (*func)(vo
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode  MatMFFDSetFunctionBatch_MFFD(Mat mat,PetscErrorCode (*funcs)(void*,PetscInt,const Vec[],Vec[]),void *funcsctx)
+{
+  MatMFFD        ctx;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(mat,&ctx);CHKERRQ(ierr);
+  ctx->funcs    = funcs;
+  ctx->funcsctx = funcsctx;
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode  MatMFFDSetFunctionError_MFFD(Mat mat,PetscReal error)
 {
   MatMFFD        ctx;
@@ -615,12 +722,17 @@ PetscErrorCode  MatMFFDSetHHistory_MFFD(Mat J,PetscScalar history[],PetscInt nhi
 
   Level: advanced
 
+  Notes:
+  MatMatMult() with a dense matrix differences all its columns together: the differencing parameters
+  are computed with one collective operation and the perturbed states can be evaluated at once with
+  MatMFFDSetFunctionBatch().
+
   Developers Note: This is implemented on top of MATSHELL to get support for scaling and shifting without requiring duplicate code
 
 .seealso: MatCreateMFFD(), MatCreateSNESMF(), MatMFFDSetFunction(), MatMFFDSetType(),
           MatMFFDSetFunctionError(), MatMFFDDSSetUmin(), MatMFFDSetFunction()
           MatMFFDSetHHistory(), MatMFFDResetHHistory(), MatCreateSNESMF(),
-          MatMFFDGetH(),
+          MatMFFDGetH(), MatMFFDSetFunctionBatch()
 M*/
 PETSC_EXTERN PetscErrorCode MatCreate_MFFD(Mat A)
 {
@@ -670,6 +782,7 @@ PETSC_EXTERN PetscErrorCode MatCreate_MFFD(Mat A)
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatMFFDSetFunctioniBase_C",MatMFFDSetFunctioniBase_MFFD);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatMFFDSetFunctioni_C",MatMFFDSetFunctioni_MFFD);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatMFFDSetFunction_C",MatMFFDSetFunction_MFFD);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatMFFDSetFunctionBatch_C",MatMFFDSetFunctionBatch_MFFD);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatMFFDSetCheckh_C",MatMFFDSetCheckh_MFFD);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatMFFDSetPeriod_C",MatMFFDSetPeriod_MFFD);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatMFFDSetFunctionError_C",MatMFFDSetFunctionError_MFFD);CHKERRQ(ierr);
@@ -678,6 +791,7 @@ PETSC_EXTERN PetscErrorCode MatCreate_MFFD(Mat A)
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatMFFDSetType_C",MatMFFDSetType_MFFD);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatMFFDGetH_C",MatMFFDGetH_MFFD);CHKERRQ(ierr);
   ierr = PetscObjectChangeTypeName((PetscObject)A,MATMFFD);CHKERRQ(ierr);
+  ierr = MatShellSetMatProductOperation(A,MATPRODUCT_AB,NULL,MatProductNumeric_MFFD_Dense,NULL,MATDENSE,MATDENSE);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -810,7 +924,7 @@ $     func (void *funcctx, Vec x, Vec f)
     If this is not set then it will use the function set with SNESSetFunction() if MatCreateSNESMF() was used.
 
 .seealso: MatCreateSNESMF(),MatMFFDGetH(), MatCreateMFFD(), MATMFFD,
-          MatMFFDSetHHistory(), MatMFFDResetHHistory(), SNESetFunction()
+          MatMFFDSetHHistory(), MatMFFDResetHHistory(), SNESetFunction(), MatMFFDSetFunctionBatch()
 @*/
 PetscErrorCode  MatMFFDSetFunction(Mat mat,PetscErrorCode (*func)(void*,Vec,Vec),void *funcctx)
 {
@@ -822,6 +936,46 @@ PetscErrorCode  MatMFFDSetFunction(Mat mat,PetscErrorCode (*func)(void*,Vec,Vec)
   PetscFunctionReturn(0);
 }
 
+/*@C
+   MatMFFDSetFunctionBatch - Sets the function used to evaluate several perturbed states at once
+   in matrix-free matrix products with several vectors
+
+   Logically Collective on Mat
+
+   Input Parameters:
++  mat - the matrix free matrix created via MatCreateSNESMF() or MatCreateMFFD()
+.  funcs - the function to use
+-  funcsctx - optional function context passed to function
+
+   Calling Sequence of funcs:
+$     funcs (void *funcsctx, PetscInt n, const Vec x[], Vec f[])
+
++  funcsctx - user provided context
+.  n - the number of states
+.  x - the input vectors
+-  f - the computed output functions, f[i] = F(x[i])
+
+   Level: advanced
+
+   Notes:
+    MatMatMult() with a dense matrix computes the differencing parameters of all its columns
+    with one collective operation, and then calls funcs once with all the perturbed states, so that
+    an implementation can evaluate them in one sweep over the mesh with one ghost exchange.
+    If funcs is set it is also used by MatMult(), with n = 1 or 2 (the base state), and the function
+    set with MatMFFDSetFunction() is not needed.
+
+.seealso: MatMFFDSetFunction(), MatCreateMFFD(), MATMFFD, MatMatMult()
+@*/
+PetscErrorCode  MatMFFDSetFunctionBatch(Mat mat,PetscErrorCode (*funcs)(void*,PetscInt,const Vec[],Vec[]),void *funcsctx)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(mat,MAT_CLASSID,1);
+  ierr = PetscTryMethod(mat,"MatMFFDSetFunctionBatch_C",(Mat,PetscErrorCode (*)(void*,PetscInt,const Vec[],Vec[]),void*),(mat,funcs,funcsctx));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@C
    MatMFFDSetFunctioni - Sets the function for a single component
 
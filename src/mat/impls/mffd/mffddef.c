@@ -23,6 +23,9 @@
 
       MatMFFDDestroy_ - frees any space allocated by the routines above
 
+      MatMFFDComputes_ - computes h for several directions with a single
+                         collective operation, used by MatMatMult()
+
 */
 
 /*
@@ -99,6 +102,53 @@ static PetscErrorCode MatMFFDCompute_DS(MatMFFD ctx,Vec U,Vec a,PetscScalar *h,P
   PetscFunctionReturn(0);
 }
 
+/*
+   MatMFFDComputes_DS - Computes the differencing parameters for several directions with
+   all the norms and inner products gathered in one collective operation
+*/
+static PetscErrorCode MatMFFDComputes_DS(MatMFFD ctx,Vec U,PetscInt n,Vec a[],PetscScalar h[],PetscBool zeroa[])
+{
+  MatMFFD_DS     *hctx = (MatMFFD_DS*)ctx->hctx;
+  PetscReal      *nrm,*sum,umin = hctx->umin;
+  PetscScalar    *dot,hprev = ctx->currenth;
+  PetscInt       i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc3(n,&dot,n,&sum,n,&nrm);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    if ((ctx->count+i) % ctx->recomputeperiod) continue;
+    ierr = VecDotBegin(U,a[i],&dot[i]);CHKERRQ(ierr);
+    ierr = VecNormBegin(a[i],NORM_1,&sum[i]);CHKERRQ(ierr);
+    ierr = VecNormBegin(a[i],NORM_2,&nrm[i]);CHKERRQ(ierr);
+  }
+  for (i=0; i<n; i++) {
+    if ((ctx->count+i) % ctx->recomputeperiod) continue;
+    ierr = VecDotEnd(U,a[i],&dot[i]);CHKERRQ(ierr);
+    ierr = VecNormEnd(a[i],NORM_1,&sum[i]);CHKERRQ(ierr);
+    ierr = VecNormEnd(a[i],NORM_2,&nrm[i]);CHKERRQ(ierr);
+  }
+  for (i=0; i<n; i++) {
+    zeroa[i] = PETSC_FALSE;
+    if ((ctx->count+i) % ctx->recomputeperiod) {
+      h[i] = hprev;
+      continue;
+    }
+    if (nrm[i] == 0.0) {
+      zeroa[i] = PETSC_TRUE;
+      continue;
+    }
+    if (PetscAbsScalar(dot[i]) < umin*sum[i] && PetscRealPart(dot[i]) >= 0.0) dot[i] = umin*sum[i];
+    else if (PetscAbsScalar(dot[i]) < 0.0 && PetscRealPart(dot[i]) > -umin*sum[i]) dot[i] = -umin*sum[i];
+    h[i] = ctx->error_rel*dot[i]/(nrm[i]*nrm[i]);
+    if (PetscIsInfOrNanScalar(h[i])) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Differencing parameter is not a number sum = %g dot = %g norm = %g",(double)sum[i],(double)PetscRealPart(dot[i]),(double)nrm[i]);
+    hprev = h[i];
+  }
+  ctx->count += n;
+  ierr = PetscFree3(dot,sum,nrm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*
    MatMFFDView_DS - Prints information about this particular
    method for computing h. Note that this does not print the general
@@ -254,6 +304,7 @@ PETSC_EXTERN PetscErrorCode MatCreateMFFD_DS(MatMFFD ctx)
 
   /* set the functions I am providing */
   ctx->ops->compute        = MatMFFDCompute_DS;
+  ctx->ops->computes       = MatMFFDComputes_DS;
   ctx->ops->destroy        = MatMFFDDestroy_DS;
   ctx->ops->view           = MatMFFDView_DS;
   ctx->ops->setfromoptions = MatMFFDSetFromOptions_DS;
@@ -24,6 +24,7 @@ struct _MFOps {
   PetscErrorCode (*view)(MatMFFD,PetscViewer);
   PetscErrorCode (*destroy)(MatMFFD);
   PetscErrorCode (*setfromoptions)(PetscOptionItems*,MatMFFD);
+  PetscErrorCode (*computes)(MatMFFD,Vec,PetscInt,Vec[],PetscScalar[],PetscBool[]); /* h for several directions with one reduction */
 };
 
 /* context for default matrix-free SNES */
@@ -47,6 +48,11 @@ struct _p_MatMFFD {
   PetscBool      current_f_allocated;
   Vec            current_u;              /* location of u; used with F(u+h) */
 
+  PetscErrorCode (*funcs)(void*,PetscInt,const Vec[],Vec[]); /* evaluates the function at several states at once */
+  void           *funcsctx;
+  Vec            *ws,*ys;                /* perturbed states and results for products with several vectors */
+  PetscInt       nws;
+
   PetscErrorCode (*funci)(void*,PetscInt,Vec,PetscScalar*); /* Evaluates func_[i]() */
   PetscErrorCode (*funcisetbase)(void*,Vec);                /* Sets base for future evaluations of func_[i]() */
 
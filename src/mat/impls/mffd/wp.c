@@ -83,6 +83,43 @@ static PetscErrorCode MatMFFDCompute_WP(MatMFFD ctx,Vec U,Vec a,PetscScalar *h,P
   PetscFunctionReturn(0);
 }
 
+/*
+   MatMFFDComputes_WP - Computes the differencing parameters for several directions with
+   the norms gathered in one collective operation
+*/
+static PetscErrorCode MatMFFDComputes_WP(MatMFFD ctx,Vec U,PetscInt n,Vec a[],PetscScalar h[],PetscBool zeroa[])
+{
+  MatMFFD_WP     *hctx = (MatMFFD_WP*)ctx->hctx;
+  PetscReal      normU,*norma;
+  PetscBool      normu;
+  PetscInt       i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (ctx->count % ctx->recomputeperiod) {
+    for (i=0; i<n; i++) {
+      h[i]     = ctx->currenth;
+      zeroa[i] = PETSC_FALSE;
+    }
+    PetscFunctionReturn(0);
+  }
+  ierr  = PetscMalloc1(n,&norma);CHKERRQ(ierr);
+  normu = (PetscBool)(hctx->computenormU || !ctx->ncurrenth);
+  if (normu) {ierr = VecNormBegin(U,NORM_2,&normU);CHKERRQ(ierr);}
+  for (i=0; i<n; i++) {ierr = VecNormBegin(a[i],NORM_2,&norma[i]);CHKERRQ(ierr);}
+  if (normu) {
+    ierr            = VecNormEnd(U,NORM_2,&normU);CHKERRQ(ierr);
+    hctx->normUfact = PetscSqrtReal(1.0+normU);
+  }
+  for (i=0; i<n; i++) {
+    ierr     = VecNormEnd(a[i],NORM_2,&norma[i]);CHKERRQ(ierr);
+    zeroa[i] = (PetscBool)(norma[i] == 0.0);
+    if (!zeroa[i]) h[i] = ctx->error_rel*hctx->normUfact/norma[i];
+  }
+  ierr = PetscFree(norma);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*
    MatMFFDView_WP - Prints information about this particular
      method for computing h. Note that this does not print the general
@@ -215,6 +252,7 @@ PETSC_EXTERN PetscErrorCode MatCreateMFFD_WP(MatMFFD ctx)
 
   /* set the functions I am providing */
   ctx->ops->compute        = MatMFFDCompute_WP;
+  ctx->ops->computes       = MatMFFDComputes_WP;
   ctx->ops->destroy        = MatMFFDDestroy_WP;
   ctx->ops->view           = MatMFFDView_WP;
   ctx->ops->setfromoptions = MatMFFDSetFromOptions_WP;
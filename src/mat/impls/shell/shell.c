@@ -645,28 +645,39 @@ static PetscErrorCode MatProductNumeric_Shell_X(Mat D)
       case MATPRODUCT_ABt: /* s L A R B^t + v L R B^t + L D R B^t */
         if (shell->left) {
           ierr = MatDiagonalScale(D,shell->left,NULL);CHKERRQ(ierr);
-          if (shell->dshift || shell->vshift != zero) {
-            if (!shell->left_work) {ierr = MatCreateVecs(A,NULL,&shell->left_work);CHKERRQ(ierr);}
-            if (shell->dshift) {
-              ierr = VecCopy(shell->dshift,shell->left_work);CHKERRQ(ierr);
-              ierr = VecShift(shell->left_work,shell->vshift);CHKERRQ(ierr);
-              ierr = VecPointwiseMult(shell->left_work,shell->left_work,shell->left);CHKERRQ(ierr);
+        }
+        if (shell->dshift || shell->vshift != zero) {
+          if (!useBmdata) { /* the shift needs a scaled copy of B also without left or right scaling */
+            if (!mdata->B) {
+              ierr = MatDuplicate(B,MAT_SHARE_NONZERO_PATTERN,&mdata->B);CHKERRQ(ierr);
             } else {
-              ierr = VecSet(shell->left_work,shell->vshift);CHKERRQ(ierr);
+              newB = PETSC_FALSE;
             }
-            if (product->type == MATPRODUCT_ABt) {
-              MatReuse     reuse = mdata->Bt ? MAT_REUSE_MATRIX : MAT_INITIAL_MATRIX;
-              MatStructure str = mdata->Bt ? SUBSET_NONZERO_PATTERN : DIFFERENT_NONZERO_PATTERN;
-
-              ierr = MatTranspose(mdata->B,reuse,&mdata->Bt);CHKERRQ(ierr);
-              ierr = MatDiagonalScale(mdata->Bt,shell->left_work,NULL);CHKERRQ(ierr);
-              ierr = MatAXPY(D,1.0,mdata->Bt,str);CHKERRQ(ierr);
-            } else {
-              MatStructure str = newB ? DIFFERENT_NONZERO_PATTERN : SUBSET_NONZERO_PATTERN;
+            ierr = MatCopy(B,mdata->B,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+          }
+          if (!shell->left_work) {ierr = MatCreateVecs(A,NULL,&shell->left_work);CHKERRQ(ierr);}
+          if (shell->dshift) {
+            ierr = VecCopy(shell->dshift,shell->left_work);CHKERRQ(ierr);
+            ierr = VecShift(shell->left_work,shell->vshift);CHKERRQ(ierr);
+            if (shell->left) {ierr = VecPointwiseMult(shell->left_work,shell->left_work,shell->left);CHKERRQ(ierr);}
+          } else if (shell->left) {
+            ierr = VecCopy(shell->left,shell->left_work);CHKERRQ(ierr);
+            ierr = VecScale(shell->left_work,shell->vshift);CHKERRQ(ierr);
+          } else {
+            ierr = VecSet(shell->left_work,shell->vshift);CHKERRQ(ierr);
+          }
+          if (product->type == MATPRODUCT_ABt) {
+            MatReuse     reuse = mdata->Bt ? MAT_REUSE_MATRIX : MAT_INITIAL_MATRIX;
+            MatStructure str = mdata->Bt ? SUBSET_NONZERO_PATTERN : DIFFERENT_NONZERO_PATTERN;
+
+            ierr = MatTranspose(mdata->B,reuse,&mdata->Bt);CHKERRQ(ierr);
+            ierr = MatDiagonalScale(mdata->Bt,shell->left_work,NULL);CHKERRQ(ierr);
+            ierr = MatAXPY(D,1.0,mdata->Bt,str);CHKERRQ(ierr);
+          } else {
+            MatStructure str = newB ? DIFFERENT_NONZERO_PATTERN : SUBSET_NONZERO_PATTERN;
 
-              ierr = MatDiagonalScale(mdata->B,shell->left_work,NULL);CHKERRQ(ierr);
-              ierr = MatAXPY(D,1.0,mdata->B,str);CHKERRQ(ierr);
-            }
+            ierr = MatDiagonalScale(mdata->B,shell->left_work,NULL);CHKERRQ(ierr);
+            ierr = MatAXPY(D,1.0,mdata->B,str);CHKERRQ(ierr);
           }
         }
         break;
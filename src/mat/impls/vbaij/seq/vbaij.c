@@ -0,0 +1,691 @@
+
+/*
+    Defines the basic matrix operations for the VBAIJ (variable block compressed row) matrix storage format.
+*/
+#include <../src/mat/impls/vbaij/seq/vbaij.h>  /*I   "petscmat.h"  I*/
+#include <petsc/private/kernels/blockinvert.h>
+
+static PetscErrorCode MatMultAdd_SeqVBAIJ_Private(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  Mat_SeqVBAIJ      *a = (Mat_SeqVBAIJ*)A->data;
+  const PetscScalar *x;
+  PetscScalar       *z;
+  const PetscInt    *bsizes = a->bsizes,*rstart = a->rstart,*ai = a->i,*aj = a->j,*boff = a->boff;
+  PetscInt          ib,k,m;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (yy && yy != zz) {ierr = VecCopy(yy,zz);CHKERRQ(ierr);}
+  else if (!yy) {ierr = VecSet(zz,0.0);CHKERRQ(ierr);}
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(zz,&z);CHKERRQ(ierr);
+  for (ib=0; ib<a->mbs; ib++) {
+    m = bsizes[ib];
+    for (k=ai[ib]; k<ai[ib+1]; k++) MatVBAIJBlockMultAdd_Private(m,bsizes[aj[k]],a->a+boff[k],x+rstart[aj[k]],z+rstart[ib]);
+  }
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(zz,&z);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*boff[a->nz]);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatMult_SeqVBAIJ(Mat A,Vec xx,Vec yy)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatMultAdd_SeqVBAIJ_Private(A,xx,NULL,yy);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatMultAdd_SeqVBAIJ(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatMultAdd_SeqVBAIJ_Private(A,xx,yy,zz);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatMultTransposeAdd_SeqVBAIJ_Private(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  Mat_SeqVBAIJ      *a = (Mat_SeqVBAIJ*)A->data;
+  const PetscScalar *x;
+  PetscScalar       *z;
+  const PetscInt    *bsizes = a->bsizes,*rstart = a->rstart,*ai = a->i,*aj = a->j,*boff = a->boff;
+  PetscInt          ib,k,m;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (yy && yy != zz) {ierr = VecCopy(yy,zz);CHKERRQ(ierr);}
+  else if (!yy) {ierr = VecSet(zz,0.0);CHKERRQ(ierr);}
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(zz,&z);CHKERRQ(ierr);
+  for (ib=0; ib<a->mbs; ib++) {
+    m = bsizes[ib];
+    for (k=ai[ib]; k<ai[ib+1]; k++) MatVBAIJBlockMultTransposeAdd_Private(m,bsizes[aj[k]],a->a+boff[k],x+rstart[ib],z+rstart[aj[k]]);
+  }
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(zz,&z);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*boff[a->nz]);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatMultTranspose_SeqVBAIJ(Mat A,Vec xx,Vec yy)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatMultTransposeAdd_SeqVBAIJ_Private(A,xx,NULL,yy);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatMultTransposeAdd_SeqVBAIJ(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatMultTransposeAdd_SeqVBAIJ_Private(A,xx,yy,zz);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* inverts the diagonal blocks into a->idiag */
+static PetscErrorCode MatInvertBlockDiagonal_SeqVBAIJ(Mat A)
+{
+  Mat_SeqVBAIJ   *a = (Mat_SeqVBAIJ*)A->data;
+  PetscInt       ib,m,*pivots;
+  MatScalar      *work,*v;
+  PetscBool      allowzeropivot,zeropivotdetected = PETSC_FALSE;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (a->idiagvalid) PetscFunctionReturn(0);
+  allowzeropivot = PetscNot(A->erroriffailure);
+  if (!a->idiag) {ierr = PetscMalloc1(a->idoff[a->mbs],&a->idiag);CHKERRQ(ierr);}
+  ierr = PetscMalloc2(a->bsmax,&pivots,a->bsmax,&work);CHKERRQ(ierr);
+  A->factorerrortype = MAT_FACTOR_NOERROR;
+  for (ib=0; ib<a->mbs; ib++) {
+    if (a->diag[ib] < 0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Matrix is missing diagonal block %D",ib);
+    m = a->bsizes[ib];
+    v = a->idiag + a->idoff[ib];
+    ierr = PetscArraycpy(v,a->a+a->boff[a->diag[ib]],m*m);CHKERRQ(ierr);
+    if (m == 1) {
+      if (v[0] == (MatScalar)0.0) {
+        if (!allowzeropivot) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_MAT_LU_ZRPVT,"Zero pivot in block %D",ib);
+        zeropivotdetected = PETSC_TRUE;
+      } else v[0] = 1.0/v[0];
+    } else {
+      ierr = PetscKernel_A_gets_inverse_A(m,v,pivots,work,allowzeropivot,&zeropivotdetected);CHKERRQ(ierr);
+    }
+    if (zeropivotdetected) A->factorerrortype = MAT_FACTOR_NUMERIC_ZEROPIVOT;
+  }
+  ierr = PetscFree2(pivots,work);CHKERRQ(ierr);
+  a->idiagvalid = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatInvertVariableBlockDiagonal_SeqVBAIJ(Mat A,PetscInt nblocks,const PetscInt *bsizes,PetscScalar *diag)
+{
+  Mat_SeqVBAIJ   *a = (Mat_SeqVBAIJ*)A->data;
+  PetscInt       ib;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (nblocks != a->mbs) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_SIZ,"Number of blocks %D does not match the %D blocks of the VBAIJ matrix",nblocks,a->mbs);
+  for (ib=0; ib<nblocks; ib++) {
+    if (bsizes[ib] != a->bsizes[ib]) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_ARG_SIZ,"Size %D of block %D does not match the VBAIJ block size %D",bsizes[ib],ib,a->bsizes[ib]);
+  }
+  ierr = MatInvertBlockDiagonal_SeqVBAIJ(A);CHKERRQ(ierr);
+  ierr = PetscArraycpy(diag,a->idiag,a->idoff[a->mbs]);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Block Gauss-Seidel: each sweep solves with the diagonal blocks exactly, so like MATSEQBAIJ only omega = 1 is supported
+*/
+static PetscErrorCode MatSOR_SeqVBAIJ(Mat A,Vec bb,PetscReal omega,MatSORType flag,PetscReal fshift,PetscInt its,PetscInt lits,Vec xx)
+{
+  Mat_SeqVBAIJ      *a = (Mat_SeqVBAIJ*)A->data;
+  const PetscInt    *bsizes = a->bsizes,*rstart = a->rstart,*ai = a->i,*aj = a->j,*boff = a->boff;
+  const MatScalar   *aa = a->a;
+  PetscScalar       *x,*t = a->work;
+  const PetscScalar *b;
+  PetscInt          ib,jb,k,m;
+  PetscBool         zero;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  its = its*lits;
+  if (its <= 0) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONG,"Relaxation requires global its %D and local its %D both positive",its,lits);
+  if (flag & SOR_EISENSTAT) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"No support yet for Eisenstat");
+  if (omega != 1.0) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"No support for omega not equal to 1.0");
+  if (fshift == -1.0) fshift = 0.0; /* negative fshift indicates do not error on zero diagonal; this code never errors on zero diagonal */
+  if (fshift) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"No support for diagonal shift");
+  if ((flag & SOR_APPLY_UPPER) || (flag & SOR_APPLY_LOWER)) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"No support for applying upper or lower triangular parts");
+
+  ierr = MatInvertBlockDiagonal_SeqVBAIJ(A);CHKERRQ(ierr);
+  zero = (flag & SOR_ZERO_INITIAL_GUESS) ? PETSC_TRUE : PETSC_FALSE;
+  if (zero) {ierr = VecSet(xx,0.0);CHKERRQ(ierr);}
+  ierr = VecGetArray(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  while (its--) {
+    if ((flag & SOR_FORWARD_SWEEP) || (flag & SOR_LOCAL_FORWARD_SWEEP)) {
+      for (ib=0; ib<a->mbs; ib++) {
+        m    = bsizes[ib];
+        ierr = PetscArraycpy(t,b+rstart[ib],m);CHKERRQ(ierr);
+        for (k=ai[ib]; k<ai[ib+1]; k++) {
+          jb = aj[k];
+          if (jb == ib) continue;
+          if (zero && jb > ib) break;
+          MatVBAIJBlockMultSub_Private(m,bsizes[jb],aa+boff[k],x+rstart[jb],t);
+        }
+        ierr = PetscArrayzero(x+rstart[ib],m);CHKERRQ(ierr);
+        MatVBAIJBlockMultAdd_Private(m,m,a->idiag+a->idoff[ib],t,x+rstart[ib]);
+      }
+      zero = PETSC_FALSE;
+      ierr = PetscLogFlops(2.0*(boff[a->nz]+a->idoff[a->mbs]));CHKERRQ(ierr);
+    }
+    if ((flag & SOR_BACKWARD_SWEEP) || (flag & SOR_LOCAL_BACKWARD_SWEEP)) {
+      for (ib=a->mbs-1; ib>=0; ib--) {
+        m    = bsizes[ib];
+        ierr = PetscArraycpy(t,b+rstart[ib],m);CHKERRQ(ierr);
+        for (k=ai[ib+1]-1; k>=ai[ib]; k--) {
+          jb = aj[k];
+          if (jb == ib) continue;
+          if (zero && jb < ib) break;
+          MatVBAIJBlockMultSub_Private(m,bsizes[jb],aa+boff[k],x+rstart[jb],t);
+        }
+        ierr = PetscArrayzero(x+rstart[ib],m);CHKERRQ(ierr);
+        MatVBAIJBlockMultAdd_Private(m,m,a->idiag+a->idoff[ib],t,x+rstart[ib]);
+      }
+      zero = PETSC_FALSE;
+      ierr = PetscLogFlops(2.0*(boff[a->nz]+a->idoff[a->mbs]));CHKERRQ(ierr);
+    }
+  }
+  ierr = VecRestoreArray(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatGetDiagonal_SeqVBAIJ(Mat A,Vec v)
+{
+  Mat_SeqVBAIJ   *a = (Mat_SeqVBAIJ*)A->data;
+  PetscScalar    *x;
+  const MatScalar *d;
+  PetscInt       ib,r,m;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (A->factortype) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Not for factored matrix");
+  ierr = VecGetArray(v,&x);CHKERRQ(ierr);
+  for (ib=0; ib<a->mbs; ib++) {
+    m = a->bsizes[ib];
+    if (a->diag[ib] < 0) {
+      for (r=0; r<m; r++) x[a->rstart[ib]+r] = 0.0;
+    } else {
+      d = a->a + a->boff[a->diag[ib]];
+      for (r=0; r<m; r++) x[a->rstart[ib]+r] = d[r*m+r];
+    }
+  }
+  ierr = VecRestoreArray(v,&x);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* only locations inside the stored blocks can be set, the block structure is fixed when the matrix is created */
+static PetscErrorCode MatSetValues_SeqVBAIJ(Mat A,PetscInt m,const PetscInt im[],PetscInt n,const PetscInt in[],const PetscScalar v[],InsertMode is)
+{
+  Mat_SeqVBAIJ   *a = (Mat_SeqVBAIJ*)A->data;
+  PetscInt       i,j,row,col,ib,jb,loc;
+  MatScalar      *ap;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (i=0; i<m; i++) {
+    row = im[i];
+    if (row < 0) continue;
+    if (PetscUnlikelyDebug(row >= A->rmap->n)) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Row too large: row %D max %D",row,A->rmap->n-1);
+    ib = a->rowblock[row];
+    for (j=0; j<n; j++) {
+      col = in[j];
+      if (col < 0) continue;
+      if (PetscUnlikelyDebug(col >= A->cmap->n)) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Column too large: col %D max %D",col,A->cmap->n-1);
+      jb    = a->rowblock[col];
+      ierr = PetscFindInt(jb,a->i[ib+1]-a->i[ib],a->j+a->i[ib],&loc);CHKERRQ(ierr);
+      if (loc < 0) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Inserting a new nonzero at (%D,%D) outside of the blocks of the VBAIJ matrix",row,col);
+      ap = a->a + a->boff[a->i[ib]+loc] + (col-a->rstart[jb])*a->bsizes[ib] + row-a->rstart[ib];
+      if (is == ADD_VALUES) *ap += v ? v[i*n+j] : 0.0;
+      else *ap = v ? v[i*n+j] : 0.0;
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatZeroEntries_SeqVBAIJ(Mat A)
+{
+  Mat_SeqVBAIJ   *a = (Mat_SeqVBAIJ*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscArrayzero(a->a,a->boff[a->nz]);CHKERRQ(ierr);
+  a->idiagvalid = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatAssemblyEnd_SeqVBAIJ(Mat A,MatAssemblyType mode)
+{
+  Mat_SeqVBAIJ *a = (Mat_SeqVBAIJ*)A->data;
+
+  PetscFunctionBegin;
+  a->idiagvalid = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+/* the point row including the explicit zeros of its blocks */
+static PetscErrorCode MatGetRow_SeqVBAIJ(Mat A,PetscInt row,PetscInt *nz,PetscInt **idx,PetscScalar **v)
+{
+  Mat_SeqVBAIJ   *a = (Mat_SeqVBAIJ*)A->data;
+  PetscInt       ib,jb,k,c,cnt = 0,m,lr;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (row < 0 || row >= A->rmap->n) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Row %D out of range",row);
+  ib  = a->rowblock[row];
+  m  = a->bsizes[ib];
+  lr = row - a->rstart[ib];
+  for (k=a->i[ib]; k<a->i[ib+1]; k++) cnt += a->bsizes[a->j[k]];
+  if (nz) *nz = cnt;
+  if (idx) {ierr = PetscMalloc1(cnt,idx);CHKERRQ(ierr);}
+  if (v) {ierr = PetscMalloc1(cnt,v);CHKERRQ(ierr);}
+  cnt = 0;
+  for (k=a->i[ib]; k<a->i[ib+1]; k++) {
+    jb = a->j[k];
+    for (c=0; c<a->bsizes[jb]; c++,cnt++) {
+      if (idx) (*idx)[cnt] = a->rstart[jb] + c;
+      if (v) (*v)[cnt] = a->a[a->boff[k]+c*m+lr];
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatRestoreRow_SeqVBAIJ(Mat A,PetscInt row,PetscInt *nz,PetscInt **idx,PetscScalar **v)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (idx) {ierr = PetscFree(*idx);CHKERRQ(ierr);}
+  if (v) {ierr = PetscFree(*v);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatGetInfo_SeqVBAIJ(Mat A,MatInfoType flag,MatInfo *info)
+{
+  Mat_SeqVBAIJ *a = (Mat_SeqVBAIJ*)A->data;
+
+  PetscFunctionBegin;
+  info->block_size   = 1.0;
+  info->nz_allocated = a->boff ? a->boff[a->nz] : 0;
+  info->nz_used      = info->nz_allocated; /* includes the explicit zeros of the blocks */
+  info->nz_unneeded  = 0;
+  info->assemblies   = A->num_ass;
+  info->mallocs      = 0;
+  info->memory       = ((PetscObject)A)->mem;
+  if (A->factortype) {
+    info->fill_ratio_given  = A->info.fill_ratio_given;
+    info->fill_ratio_needed = A->info.fill_ratio_needed;
+    info->factor_mallocs    = A->info.factor_mallocs;
+  } else {
+    info->fill_ratio_given  = 0;
+    info->fill_ratio_needed = 0;
+    info->factor_mallocs    = 0;
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   Allocates the structure of B (block sizes bsizes[] and block compressed rows ai[], aj[] with sorted aj[])
+   and takes ownership of bsizes, ai and aj
+*/
+static PetscErrorCode MatSeqVBAIJSetStructure_Private(Mat B,PetscInt mbs,PetscInt *bsizes,PetscInt *ai,PetscInt *aj)
+{
+  Mat_SeqVBAIJ   *b = (Mat_SeqVBAIJ*)B->data;
+  PetscInt       ib,k,r;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  b->mbs    = mbs;
+  b->nz     = ai[mbs];
+  b->bsizes = bsizes;
+  b->i      = ai;
+  b->j      = aj;
+  b->bsmax  = 0;
+  ierr = PetscMalloc4(mbs+1,&b->rstart,B->rmap->n,&b->rowblock,mbs,&b->diag,mbs+1,&b->idoff);CHKERRQ(ierr);
+  ierr = PetscMalloc1(b->nz+1,&b->boff);CHKERRQ(ierr);
+  b->rstart[0] = 0;
+  b->idoff[0]  = 0;
+  for (ib=0; ib<mbs; ib++) {
+    b->bsmax       = PetscMax(b->bsmax,bsizes[ib]);
+    b->rstart[ib+1] = b->rstart[ib] + bsizes[ib];
+    b->idoff[ib+1]  = b->idoff[ib] + bsizes[ib]*bsizes[ib];
+    for (r=b->rstart[ib]; r<b->rstart[ib+1]; r++) b->rowblock[r] = ib;
+  }
+  if (b->rstart[mbs] != B->rmap->n) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_SIZ,"Sum of block sizes %D does not equal the number of rows %D",b->rstart[mbs],B->rmap->n);
+  b->boff[0] = 0;
+  for (ib=0; ib<mbs; ib++) {
+    b->diag[ib] = -1;
+    for (k=ai[ib]; k<ai[ib+1]; k++) {
+      if (aj[k] == ib) b->diag[ib] = k;
+      b->boff[k+1] = b->boff[k] + bsizes[ib]*bsizes[aj[k]];
+    }
+  }
+  ierr = PetscCalloc1(b->boff[b->nz],&b->a);CHKERRQ(ierr);
+  ierr = PetscMalloc1(2*b->bsmax,&b->work);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject)B,b->boff[b->nz]*sizeof(MatScalar)+(2*b->nz+7*mbs+B->rmap->n)*sizeof(PetscInt));CHKERRQ(ierr);
+  b->idiagvalid = PETSC_FALSE;
+  ierr = MatSetVariableBlockSizes(B,mbs,bsizes);CHKERRQ(ierr);
+  B->preallocated = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatDuplicateNoCreate_SeqVBAIJ(Mat C,Mat A,MatDuplicateOption cpvalues)
+{
+  Mat_SeqVBAIJ   *a = (Mat_SeqVBAIJ*)A->data;
+  PetscInt       *bsizes,*ci,*cj;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc1(a->mbs,&bsizes);CHKERRQ(ierr);
+  ierr = PetscMalloc1(a->mbs+1,&ci);CHKERRQ(ierr);
+  ierr = PetscMalloc1(a->nz,&cj);CHKERRQ(ierr);
+  ierr = PetscArraycpy(bsizes,a->bsizes,a->mbs);CHKERRQ(ierr);
+  ierr = PetscArraycpy(ci,a->i,a->mbs+1);CHKERRQ(ierr);
+  ierr = PetscArraycpy(cj,a->j,a->nz);CHKERRQ(ierr);
+  ierr = MatSeqVBAIJSetStructure_Private(C,a->mbs,bsizes,ci,cj);CHKERRQ(ierr);
+  if (cpvalues == MAT_COPY_VALUES) {ierr = PetscArraycpy(((Mat_SeqVBAIJ*)C->data)->a,a->a,a->boff[a->nz]);CHKERRQ(ierr);}
+  C->assembled = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatDuplicate_SeqVBAIJ(Mat A,MatDuplicateOption cpvalues,Mat *B)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatCreate(PetscObjectComm((PetscObject)A),B);CHKERRQ(ierr);
+  ierr = MatSetSizes(*B,A->rmap->n,A->cmap->n,A->rmap->n,A->cmap->n);CHKERRQ(ierr);
+  ierr = MatSetType(*B,((PetscObject)A)->type_name);CHKERRQ(ierr);
+  ierr = MatDuplicateNoCreate_SeqVBAIJ(*B,A,cpvalues);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Block detection: consecutive rows with identical nonzero patterns form a block, unless the block sizes
+   were given with MatSetVariableBlockSizes(). The blocks of the columns are the blocks of the rows.
+*/
+static PetscErrorCode MatConvertFrom_SeqVBAIJ(Mat A,MatType newtype,MatReuse reuse,Mat *newmat)
+{
+  Mat               B;
+  Mat_SeqVBAIJ      *b;
+  PetscInt          m = A->rmap->n,row,ib,jb,k,c,ncols,mbs = 0,pass,*bsizes,*bi,*bj = NULL,*mark,*rowblock,*pcols = NULL,npcols = 0,maxbs = 32,maxcols = 0,loc;
+  const PetscInt    *cols;
+  const PetscScalar *vals;
+  PetscBool         same;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (A->rmap->n != A->cmap->n) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_SUP,"Only square matrices can be converted to VBAIJ, rows %D columns %D",A->rmap->n,A->cmap->n);
+  if (reuse == MAT_REUSE_MATRIX) {
+    B    = *newmat;
+    ierr = MatZeroEntries(B);CHKERRQ(ierr);
+  } else {
+    ierr = PetscOptionsGetInt(((PetscObject)A)->options,((PetscObject)A)->prefix,"-mat_vbaij_max_block_size",&maxbs,NULL);CHKERRQ(ierr);
+    if (maxbs < 1) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Maximum block size %D must be positive",maxbs);
+    ierr = PetscMalloc1(m,&bsizes);CHKERRQ(ierr);
+    if (A->nblocks) {
+      mbs  = A->nblocks;
+      ierr = PetscArraycpy(bsizes,A->bsizes,mbs);CHKERRQ(ierr);
+    } else {
+      for (row=0; row<m; row++) {
+        ierr = MatGetRow(A,row,&ncols,&cols,NULL);CHKERRQ(ierr);
+        same = PETSC_FALSE;
+        if (mbs && bsizes[mbs-1] < maxbs && ncols == npcols) {ierr = PetscArraycmp(cols,pcols,ncols,&same);CHKERRQ(ierr);}
+        if (same) bsizes[mbs-1]++;
+        else {
+          bsizes[mbs++] = 1;
+          if (ncols > maxcols) {
+            ierr    = PetscFree(pcols);CHKERRQ(ierr);
+            maxcols = ncols;
+            ierr    = PetscMalloc1(maxcols,&pcols);CHKERRQ(ierr);
+          }
+          ierr   = PetscArraycpy(pcols,cols,ncols);CHKERRQ(ierr);
+          npcols = ncols;
+        }
+        ierr = MatRestoreRow(A,row,&ncols,&cols,NULL);CHKERRQ(ierr);
+      }
+      ierr = PetscFree(pcols);CHKERRQ(ierr);
+    }
+
+    ierr = MatCreate(PetscObjectComm((PetscObject)A),&B);CHKERRQ(ierr);
+    ierr = MatSetSizes(B,m,m,m,m);CHKERRQ(ierr);
+    ierr = MatSetType(B,MATSEQVBAIJ);CHKERRQ(ierr);
+    ierr = PetscLayoutSetUp(B->rmap);CHKERRQ(ierr);
+    ierr = PetscLayoutSetUp(B->cmap);CHKERRQ(ierr);
+
+    /* the block nonzero structure: count, then fill and sort each block row */
+    ierr = PetscMalloc1(mbs+1,&bi);CHKERRQ(ierr);
+    ierr = PetscMalloc2(mbs,&mark,m,&rowblock);CHKERRQ(ierr);
+    for (row=0,ib=0; ib<mbs; ib++) {
+      mark[ib] = -1;
+      for (k=0; k<bsizes[ib]; k++) rowblock[row++] = ib;
+    }
+    for (pass=0; pass<2; pass++) {
+      if (pass) {
+        ierr = PetscMalloc1(bi[mbs],&bj);CHKERRQ(ierr);
+        for (ib=0; ib<mbs; ib++) mark[ib] = -1;
+      }
+      bi[0] = 0;
+      for (row=0,ib=0; ib<mbs; ib++) {
+        bi[ib+1] = bi[ib];
+        for (k=0; k<bsizes[ib]; k++,row++) {
+          ierr = MatGetRow(A,row,&ncols,&cols,NULL);CHKERRQ(ierr);
+          for (c=0; c<ncols; c++) {
+            jb = rowblock[cols[c]];
+            if (mark[jb] == ib) continue;
+            mark[jb] = ib;
+            if (pass) bj[bi[ib+1]] = jb;
+            bi[ib+1]++;
+          }
+          ierr = MatRestoreRow(A,row,&ncols,&cols,NULL);CHKERRQ(ierr);
+        }
+        if (pass) {ierr = PetscSortInt(bi[ib+1]-bi[ib],bj+bi[ib]);CHKERRQ(ierr);}
+      }
+    }
+    ierr = PetscFree2(mark,rowblock);CHKERRQ(ierr);
+    ierr = MatSeqVBAIJSetStructure_Private(B,mbs,bsizes,bi,bj);CHKERRQ(ierr);
+  }
+
+  /* copy the values into the blocks */
+  b = (Mat_SeqVBAIJ*)B->data;
+  for (row=0; row<m; row++) {
+    ib    = b->rowblock[row];
+    ierr = MatGetRow(A,row,&ncols,&cols,&vals);CHKERRQ(ierr);
+    for (c=0; c<ncols; c++) {
+      jb    = b->rowblock[cols[c]];
+      ierr = PetscFindInt(jb,b->i[ib+1]-b->i[ib],b->j+b->i[ib],&loc);CHKERRQ(ierr);
+      if (loc < 0) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_INCOMP,"Entry (%D,%D) is outside of the blocks of the VBAIJ matrix being reused",row,cols[c]);
+      b->a[b->boff[b->i[ib]+loc] + (cols[c]-b->rstart[jb])*b->bsizes[ib] + row-b->rstart[ib]] = vals[c];
+    }
+    ierr = MatRestoreRow(A,row,&ncols,&cols,&vals);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = PetscInfo4(B,"%D rows in %D blocks with %D stored blocks, largest block size %D\n",m,b->mbs,b->nz,b->bsmax);CHKERRQ(ierr);
+
+  if (reuse == MAT_INPLACE_MATRIX) {
+    ierr = MatHeaderReplace(A,&B);CHKERRQ(ierr);
+  } else {
+    *newmat = B;
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatConvert_SeqVBAIJ_SeqAIJ(Mat A,MatType newtype,MatReuse reuse,Mat *newmat)
+{
+  Mat_SeqVBAIJ   *a = (Mat_SeqVBAIJ*)A->data;
+  Mat            B;
+  PetscInt       row,ncols,*cols,*nnz,ib,k;
+  PetscScalar    *vals;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_REUSE_MATRIX) {
+    B    = *newmat;
+    ierr = MatZeroEntries(B);CHKERRQ(ierr);
+  } else {
+    ierr = PetscMalloc1(A->rmap->n,&nnz);CHKERRQ(ierr);
+    for (row=0; row<A->rmap->n; row++) {
+      ib = a->rowblock[row];
+      nnz[row] = 0;
+      for (k=a->i[ib]; k<a->i[ib+1]; k++) nnz[row] += a->bsizes[a->j[k]];
+    }
+    ierr = MatCreate(PetscObjectComm((PetscObject)A),&B);CHKERRQ(ierr);
+    ierr = MatSetSizes(B,A->rmap->n,A->cmap->n,A->rmap->N,A->cmap->N);CHKERRQ(ierr);
+    ierr = MatSetType(B,MATSEQAIJ);CHKERRQ(ierr);
+    ierr = MatSeqAIJSetPreallocation(B,0,nnz);CHKERRQ(ierr);
+    ierr = PetscFree(nnz);CHKERRQ(ierr);
+  }
+  for (row=0; row<A->rmap->n; row++) {
+    ierr = MatGetRow_SeqVBAIJ(A,row,&ncols,&cols,&vals);CHKERRQ(ierr);
+    ierr = MatSetValues(B,1,&row,ncols,cols,vals,INSERT_VALUES);CHKERRQ(ierr);
+    ierr = MatRestoreRow_SeqVBAIJ(A,row,&ncols,&cols,&vals);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatSetVariableBlockSizes(B,a->mbs,a->bsizes);CHKERRQ(ierr);
+
+  if (reuse == MAT_INPLACE_MATRIX) {
+    ierr = MatHeaderReplace(A,&B);CHKERRQ(ierr);
+  } else {
+    *newmat = B;
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatView_SeqVBAIJ(Mat A,PetscViewer viewer)
+{
+  Mat_SeqVBAIJ      *a = (Mat_SeqVBAIJ*)A->data;
+  PetscBool         iascii;
+  PetscViewerFormat format;
+  PetscInt          ib,bsmin = a->bsmax;
+  Mat               B;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  ierr = PetscViewerGetFormat(viewer,&format);CHKERRQ(ierr);
+  if (A->factortype || (iascii && (format == PETSC_VIEWER_ASCII_INFO || format == PETSC_VIEWER_ASCII_INFO_DETAIL))) {
+    if (!iascii) PetscFunctionReturn(0);
+    for (ib=0; ib<a->mbs; ib++) bsmin = PetscMin(bsmin,a->bsizes[ib]);
+    ierr = PetscViewerASCIIPrintf(viewer,"%D block rows of sizes %D to %D, %D stored blocks\n",a->mbs,bsmin,a->bsmax,a->nz);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = MatConvert_SeqVBAIJ_SeqAIJ(A,MATSEQAIJ,MAT_INITIAL_MATRIX,&B);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject)B,((PetscObject)A)->name);CHKERRQ(ierr);
+  ierr = MatView(B,viewer);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatDestroy_SeqVBAIJ(Mat A)
+{
+  Mat_SeqVBAIJ   *a = (Mat_SeqVBAIJ*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree(a->bsizes);CHKERRQ(ierr);
+  ierr = PetscFree(a->i);CHKERRQ(ierr);
+  ierr = PetscFree(a->j);CHKERRQ(ierr);
+  ierr = PetscFree4(a->rstart,a->rowblock,a->diag,a->idoff);CHKERRQ(ierr);
+  ierr = PetscFree(a->boff);CHKERRQ(ierr);
+  ierr = PetscFree(a->a);CHKERRQ(ierr);
+  ierr = PetscFree(a->idiag);CHKERRQ(ierr);
+  ierr = PetscFree(a->work);CHKERRQ(ierr);
+  ierr = PetscFree(A->data);CHKERRQ(ierr);
+
+  ierr = PetscObjectChangeTypeName((PetscObject)A,NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatConvert_seqvbaij_seqaij_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatFactorGetSolverType_C",NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*MC
+   MATSEQVBAIJ - MATSEQVBAIJ = "seqvbaij" - A sequential matrix type stored as dense square blocks of varying sizes,
+   in block compressed row format. This suits coupled problems whose unknowns at a mesh point differ from point to
+   point (for example fluid, species and thermal fields present on different parts of the mesh), where MATSEQBAIJ
+   would require a single block size and MATSEQAIJ loses the block structure.
+
+   A MATSEQVBAIJ matrix is obtained with MatConvert() from an assembled sequential matrix. The blocks are given by
+   MatSetVariableBlockSizes() on that matrix or, when none were set, are detected as runs of consecutive rows with
+   the same nonzero columns. The columns are split into blocks in the same way as the rows, and every block containing
+   a nonzero of the original matrix is stored densely.
+
+   Options Database Keys:
+.  -mat_vbaij_max_block_size <32> - largest block formed by the block detection
+
+   Notes:
+   The block sizes are attached to the new matrix with MatSetVariableBlockSizes(), so PCVPBJACOBI can be used directly.
+   MatSOR() applies block Gauss-Seidel with the inverted diagonal blocks (omega = 1 only), and MatGetFactor() with
+   MATSOLVERPETSC provides a block ILU(0) factorization in the natural ordering.
+
+   Values can be changed with MatSetValues() only inside the stored blocks; the block structure is fixed once the
+   matrix is created. MatConvert() with MAT_REUSE_MATRIX copies in new values for the same nonzero structure.
+
+   Level: intermediate
+
+.seealso: MATVBAIJ, MATSEQBAIJ, MatSetVariableBlockSizes(), PCVPBJACOBI, MatConvert()
+M*/
+
+/*MC
+   MATVBAIJ - MATVBAIJ = "vbaij" - A matrix type stored as dense square blocks of varying sizes.
+
+   This matrix type is identical to MATSEQVBAIJ, there is no parallel version.
+
+   Level: intermediate
+
+.seealso: MATSEQVBAIJ
+M*/
+
+PETSC_EXTERN PetscErrorCode MatCreate_SeqVBAIJ(Mat B)
+{
+  Mat_SeqVBAIJ   *b;
+  PetscMPIInt    size;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_size(PetscObjectComm((PetscObject)B),&size);CHKERRMPI(ierr);
+  if (size > 1) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Comm must be of size 1, there is no parallel VBAIJ format");
+
+  ierr    = PetscNewLog(B,&b);CHKERRQ(ierr);
+  B->data = (void*)b;
+
+  B->ops->setvalues                   = MatSetValues_SeqVBAIJ;
+  B->ops->getrow                      = MatGetRow_SeqVBAIJ;
+  B->ops->restorerow                  = MatRestoreRow_SeqVBAIJ;
+  B->ops->mult                        = MatMult_SeqVBAIJ;
+  B->ops->multadd                     = MatMultAdd_SeqVBAIJ;
+  B->ops->multtranspose               = MatMultTranspose_SeqVBAIJ;
+  B->ops->multtransposeadd            = MatMultTransposeAdd_SeqVBAIJ;
+  B->ops->sor                         = MatSOR_SeqVBAIJ;
+  B->ops->getdiagonal                 = MatGetDiagonal_SeqVBAIJ;
+  B->ops->invertvariableblockdiagonal = MatInvertVariableBlockDiagonal_SeqVBAIJ;
+  B->ops->zeroentries                 = MatZeroEntries_SeqVBAIJ;
+  B->ops->assemblyend                 = MatAssemblyEnd_SeqVBAIJ;
+  B->ops->getinfo                     = MatGetInfo_SeqVBAIJ;
+  B->ops->duplicate                   = MatDuplicate_SeqVBAIJ;
+  B->ops->convertfrom                 = MatConvertFrom_SeqVBAIJ;
+  B->ops->view                        = MatView_SeqVBAIJ;
+  B->ops->destroy                     = MatDestroy_SeqVBAIJ;
+
+  ierr = PetscObjectChangeTypeName((PetscObject)B,MATSEQVBAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqvbaij_seqaij_C",MatConvert_SeqVBAIJ_SeqAIJ);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
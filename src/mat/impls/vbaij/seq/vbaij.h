@@ -0,0 +1,77 @@
+
+#if !defined(__VBAIJ_H)
+#define __VBAIJ_H
+
+#include <petsc/private/matimpl.h>
+
+/*
+  MATSEQVBAIJ format - block compressed row storage with variable size square blocks.
+
+  The rows (and the columns) are split into mbs blocks, block I has bsizes[I] rows starting at rstart[I].
+  Block row I stores the blocks j[i[I]] ... j[i[I+1]-1] (in increasing order) as dense
+  bsizes[I] x bsizes[j[k]] arrays in column major order, block k starting at a + boff[k].
+*/
+typedef struct {
+  PetscInt    mbs;         /* number of block rows (and block columns) */
+  PetscInt    nz;          /* number of stored blocks */
+  PetscInt    bsmax;       /* largest block size */
+  PetscInt    *bsizes;     /* size of each block */
+  PetscInt    *rstart;     /* first row of each block, length mbs+1 */
+  PetscInt    *rowblock;   /* block containing each row */
+  PetscInt    *i,*j;       /* block compressed row structure */
+  PetscInt    *diag;       /* location of the diagonal block of each block row, -1 if it is missing */
+  PetscInt    *boff;       /* offset of each block in a, length nz+1 */
+  MatScalar   *a;          /* the dense blocks */
+  MatScalar   *idiag;      /* inverses of the diagonal blocks, used by MatSOR() */
+  PetscInt    *idoff;      /* offset of each inverse in idiag, length mbs+1 */
+  PetscBool   idiagvalid;  /* idiag is up to date with a */
+  PetscScalar *work;       /* work space of length 2*bsmax */
+} Mat_SeqVBAIJ;
+
+PETSC_INTERN PetscErrorCode MatDuplicateNoCreate_SeqVBAIJ(Mat,Mat,MatDuplicateOption);
+PETSC_INTERN PetscErrorCode MatGetFactor_seqvbaij_petsc(Mat,MatFactorType,Mat*);
+PETSC_INTERN PetscErrorCode MatILUFactorSymbolic_SeqVBAIJ(Mat,Mat,IS,IS,const MatFactorInfo*);
+PETSC_INTERN PetscErrorCode MatILUFactorNumeric_SeqVBAIJ(Mat,Mat,const MatFactorInfo*);
+PETSC_INTERN PetscErrorCode MatSolve_SeqVBAIJ(Mat,Vec,Vec);
+
+/*
+   Dense kernels on column major blocks: v is m x n
+
+   y += v x,  y -= v x,  y += v^T x
+*/
+PETSC_STATIC_INLINE void MatVBAIJBlockMultAdd_Private(PetscInt m,PetscInt n,const MatScalar *v,const PetscScalar *x,PetscScalar *y)
+{
+  PetscInt c,r;
+
+  for (c=0; c<n; c++) {
+    const PetscScalar xc = x[c];
+    for (r=0; r<m; r++) y[r] += v[r]*xc;
+    v += m;
+  }
+}
+
+PETSC_STATIC_INLINE void MatVBAIJBlockMultSub_Private(PetscInt m,PetscInt n,const MatScalar *v,const PetscScalar *x,PetscScalar *y)
+{
+  PetscInt c,r;
+
+  for (c=0; c<n; c++) {
+    const PetscScalar xc = x[c];
+    for (r=0; r<m; r++) y[r] -= v[r]*xc;
+    v += m;
+  }
+}
+
+PETSC_STATIC_INLINE void MatVBAIJBlockMultTransposeAdd_Private(PetscInt m,PetscInt n,const MatScalar *v,const PetscScalar *x,PetscScalar *y)
+{
+  PetscInt    c,r;
+  PetscScalar sum;
+
+  for (c=0; c<n; c++) {
+    sum = 0.0;
+    for (r=0; r<m; r++) sum += v[r]*x[r];
+    y[c] += sum;
+    v    += m;
+  }
+}
+
+#endif
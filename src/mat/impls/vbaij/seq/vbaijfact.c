@@ -0,0 +1,154 @@
+
+/*
+    Block ILU(0) factorization of the VBAIJ matrix format
+*/
+#include <../src/mat/impls/vbaij/seq/vbaij.h>
+#include <petsc/private/kernels/blockinvert.h>
+
+/*
+   The factor has the block structure of the matrix: the blocks left of the diagonal hold L (with identity diagonal
+   blocks), the others hold U with the diagonal blocks inverted
+*/
+PetscErrorCode MatILUFactorNumeric_SeqVBAIJ(Mat C,Mat A,const MatFactorInfo *info)
+{
+  Mat_SeqVBAIJ   *a = (Mat_SeqVBAIJ*)A->data,*b = (Mat_SeqVBAIJ*)C->data;
+  const PetscInt *bsizes = b->bsizes,*bi = b->i,*bj = b->j,*bdiag = b->diag,*boff = b->boff;
+  MatScalar      *ba = b->a,*tmp,*work,*L;
+  PetscInt       ib,jb,kb,k,kk,p,c,mI,mK,*pivots;
+  PetscBool      allowzeropivot,zeropivotdetected = PETSC_FALSE;
+  PetscLogDouble flops = 0.0;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  allowzeropivot = PetscNot(A->erroriffailure);
+  ierr = PetscArraycpy(ba,a->a,a->boff[a->nz]);CHKERRQ(ierr);
+  ierr = PetscMalloc3(b->bsmax*b->bsmax,&tmp,b->bsmax,&work,b->bsmax,&pivots);CHKERRQ(ierr);
+  C->factorerrortype = MAT_FACTOR_NOERROR;
+  for (ib=0; ib<b->mbs; ib++) {
+    mI = bsizes[ib];
+    for (k=bi[ib]; k<bdiag[ib]; k++) {
+      kb  = bj[k];
+      mK = bsizes[kb];
+      L  = ba + boff[k];
+      /* L_IK = A_IK inv(U_KK) */
+      ierr = PetscArraycpy(tmp,L,mI*mK);CHKERRQ(ierr);
+      ierr = PetscArrayzero(L,mI*mK);CHKERRQ(ierr);
+      for (c=0; c<mK; c++) MatVBAIJBlockMultAdd_Private(mI,mK,tmp,ba+boff[bdiag[kb]]+c*mK,L+c*mI);
+      flops += 2.0*mI*mK*mK;
+      /* A_IJ -= L_IK U_KJ for the blocks J > K present in both block rows */
+      p = k+1;
+      for (kk=bdiag[kb]+1; kk<bi[kb+1]; kk++) {
+        jb = bj[kk];
+        while (p < bi[ib+1] && bj[p] < jb) p++;
+        if (p == bi[ib+1]) break;
+        if (bj[p] != jb) continue;
+        for (c=0; c<bsizes[jb]; c++) MatVBAIJBlockMultSub_Private(mI,mK,L,ba+boff[kk]+c*mK,ba+boff[p]+c*mI);
+        flops += 2.0*mI*mK*bsizes[jb];
+      }
+    }
+    /* invert the diagonal block of U */
+    L = ba + boff[bdiag[ib]];
+    if (mI == 1) {
+      if (L[0] == (MatScalar)0.0) {
+        if (!allowzeropivot) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_MAT_LU_ZRPVT,"Zero pivot in block row %D",ib);
+        zeropivotdetected = PETSC_TRUE;
+      } else L[0] = 1.0/L[0];
+    } else {
+      ierr = PetscKernel_A_gets_inverse_A(mI,L,pivots,work,allowzeropivot,&zeropivotdetected);CHKERRQ(ierr);
+    }
+    if (zeropivotdetected) C->factorerrortype = MAT_FACTOR_NUMERIC_ZEROPIVOT;
+    flops += 2.0*mI*mI*mI/3.0;
+  }
+  ierr = PetscFree3(tmp,work,pivots);CHKERRQ(ierr);
+
+  C->ops->solve   = MatSolve_SeqVBAIJ;
+  C->assembled    = PETSC_TRUE;
+  C->preallocated = PETSC_TRUE;
+  ierr = PetscLogFlops(flops);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatSolve_SeqVBAIJ(Mat A,Vec bb,Vec xx)
+{
+  Mat_SeqVBAIJ   *a = (Mat_SeqVBAIJ*)A->data;
+  const PetscInt *bsizes = a->bsizes,*rstart = a->rstart,*ai = a->i,*aj = a->j,*adiag = a->diag,*boff = a->boff;
+  const MatScalar *aa = a->a;
+  PetscScalar    *x,*t = a->work;
+  PetscInt       ib,k,m;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecCopy(bb,xx);CHKERRQ(ierr);
+  ierr = VecGetArray(xx,&x);CHKERRQ(ierr);
+  /* forward solve with the unit block lower triangular part */
+  for (ib=0; ib<a->mbs; ib++) {
+    m = bsizes[ib];
+    for (k=ai[ib]; k<adiag[ib]; k++) MatVBAIJBlockMultSub_Private(m,bsizes[aj[k]],aa+boff[k],x+rstart[aj[k]],x+rstart[ib]);
+  }
+  /* backward solve with the upper triangular part, whose diagonal blocks are inverted */
+  for (ib=a->mbs-1; ib>=0; ib--) {
+    m    = bsizes[ib];
+    ierr = PetscArraycpy(t,x+rstart[ib],m);CHKERRQ(ierr);
+    for (k=adiag[ib]+1; k<ai[ib+1]; k++) MatVBAIJBlockMultSub_Private(m,bsizes[aj[k]],aa+boff[k],x+rstart[aj[k]],t);
+    ierr = PetscArrayzero(x+rstart[ib],m);CHKERRQ(ierr);
+    MatVBAIJBlockMultAdd_Private(m,m,aa+boff[adiag[ib]],t,x+rstart[ib]);
+  }
+  ierr = VecRestoreArray(xx,&x);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*boff[a->nz]);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatILUFactorSymbolic_SeqVBAIJ(Mat fact,Mat A,IS isrow,IS iscol,const MatFactorInfo *info)
+{
+  Mat_SeqVBAIJ   *a = (Mat_SeqVBAIJ*)A->data;
+  PetscInt       ib;
+  PetscBool      row_identity = PETSC_TRUE,col_identity = PETSC_TRUE;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (info->levels > 0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_SUP,"Only ILU(0) is supported for VBAIJ, not %D levels",(PetscInt)info->levels);
+  if (info->shifttype == MAT_SHIFT_NONZERO || info->shifttype == MAT_SHIFT_POSITIVE_DEFINITE) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Only MAT_SHIFT_NONE and MAT_SHIFT_INBLOCKS are supported for VBAIJ matrix");
+  if (isrow) {ierr = ISIdentity(isrow,&row_identity);CHKERRQ(ierr);}
+  if (iscol) {ierr = ISIdentity(iscol,&col_identity);CHKERRQ(ierr);}
+  if (!row_identity || !col_identity) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Only the natural ordering is supported for VBAIJ");
+  for (ib=0; ib<a->mbs; ib++) {
+    if (a->diag[ib] < 0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Matrix is missing diagonal block %D",ib);
+  }
+  ierr = MatDuplicateNoCreate_SeqVBAIJ(fact,A,MAT_DO_NOT_COPY_VALUES);CHKERRQ(ierr);
+
+  fact->factortype             = MAT_FACTOR_ILU;
+  fact->info.factor_mallocs    = 0;
+  fact->info.fill_ratio_given  = info->fill;
+  fact->info.fill_ratio_needed = 1.0;
+  fact->ops->lufactornumeric   = MatILUFactorNumeric_SeqVBAIJ;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatFactorGetSolverType_seqvbaij_petsc(Mat A,MatSolverType *type)
+{
+  PetscFunctionBegin;
+  *type = MATSOLVERPETSC;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatGetFactor_seqvbaij_petsc(Mat A,MatFactorType ftype,Mat *B)
+{
+  PetscInt       n = A->rmap->n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (ftype != MAT_FACTOR_ILU) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Factor type not supported");
+  ierr = MatCreate(PetscObjectComm((PetscObject)A),B);CHKERRQ(ierr);
+  ierr = MatSetSizes(*B,n,n,n,n);CHKERRQ(ierr);
+  ierr = MatSetType(*B,MATSEQVBAIJ);CHKERRQ(ierr);
+
+  (*B)->ops->ilufactorsymbolic = MatILUFactorSymbolic_SeqVBAIJ;
+  (*B)->factortype             = ftype;
+  (*B)->canuseordering         = PETSC_FALSE;
+  ierr = PetscStrallocpy(MATORDERINGNATURAL,(char**)&(*B)->preferredordering[MAT_FACTOR_ILU]);CHKERRQ(ierr);
+
+  ierr = PetscFree((*B)->solvertype);CHKERRQ(ierr);
+  ierr = PetscStrallocpy(MATSOLVERPETSC,&(*B)->solvertype);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)*B,"MatFactorGetSolverType_C",MatFactorGetSolverType_seqvbaij_petsc);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
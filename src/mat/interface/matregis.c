@@ -25,6 +25,7 @@ PETSC_EXTERN PetscErrorCode MatCreate_MPIDenseCUDA(Mat);
 PETSC_EXTERN PetscErrorCode MatCreate_MPIAdj(Mat);
 PETSC_EXTERN PetscErrorCode MatCreate_Shell(Mat);
 PETSC_EXTERN PetscErrorCode MatCreate_Composite(Mat);
+PETSC_EXTERN PetscErrorCode MatCreate_Kronecker(Mat);
 
 PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJPERM(Mat);
 PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJPERM(Mat);
@@ -52,6 +53,8 @@ PETSC_EXTERN PetscErrorCode MatCreate_Nest(Mat);
 PETSC_EXTERN PetscErrorCode MatCreate_SeqSELL(Mat);
 PETSC_EXTERN PetscErrorCode MatCreate_MPISELL(Mat);
 
+PETSC_EXTERN PetscErrorCode MatCreate_SeqVBAIJ(Mat);
+
 #if defined(PETSC_HAVE_CUDA)
 PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJCUSPARSE(Mat);
 PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJCUSPARSE(Mat);
@@ -124,6 +127,7 @@ PetscErrorCode  MatRegisterAll(void)
   ierr = MatRegister(MATIS,             MatCreate_IS);CHKERRQ(ierr);
   ierr = MatRegister(MATSHELL,          MatCreate_Shell);CHKERRQ(ierr);
   ierr = MatRegister(MATCOMPOSITE,      MatCreate_Composite);CHKERRQ(ierr);
+  ierr = MatRegister(MATKRONECKER,      MatCreate_Kronecker);CHKERRQ(ierr);
 
   ierr = MatRegisterRootName(MATAIJ,MATSEQAIJ,MATMPIAIJ);CHKERRQ(ierr);
   ierr = MatRegister(MATMPIAIJ,         MatCreate_MPIAIJ);CHKERRQ(ierr);
@@ -179,6 +183,9 @@ PetscErrorCode  MatRegisterAll(void)
   ierr = MatRegister(MATMPISELL,         MatCreate_MPISELL);CHKERRQ(ierr);
   ierr = MatRegister(MATSEQSELL,         MatCreate_SeqSELL);CHKERRQ(ierr);
 
+  ierr = MatRegister(MATVBAIJ,           MatCreate_SeqVBAIJ);CHKERRQ(ierr);
+  ierr = MatRegister(MATSEQVBAIJ,        MatCreate_SeqVBAIJ);CHKERRQ(ierr);
+
 #if defined(PETSC_HAVE_CUDA)
   ierr = MatRegisterRootName(MATAIJCUSPARSE,MATSEQAIJCUSPARSE,MATMPIAIJCUSPARSE);CHKERRQ(ierr);
   ierr = MatRegister(MATSEQAIJCUSPARSE, MatCreate_SeqAIJCUSPARSE);CHKERRQ(ierr);
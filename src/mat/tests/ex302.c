@@ -0,0 +1,128 @@
+static char help[] = "Tests MatMatMult() with MATMFFD against MatMult() on each column, with and without a batched function.\n\n";
+
+#include <petscmat.h>
+
+typedef struct {
+  PetscInt ncalls,nstates;
+} AppCtx;
+
+/* F(x)_i = x_i^3 + exp(x_i) x_i+1, coupling the local entries only */
+static PetscErrorCode FormFunction(void *ctx,Vec x,Vec f)
+{
+  const PetscScalar *ax;
+  PetscScalar       *af;
+  PetscInt          i,n;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBeginUser;
+  ierr = VecGetLocalSize(x,&n);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(x,&ax);CHKERRQ(ierr);
+  ierr = VecGetArray(f,&af);CHKERRQ(ierr);
+  for (i=0; i<n; i++) af[i] = ax[i]*ax[i]*ax[i] + PetscExpScalar(ax[i])*ax[(i+1)%n];
+  ierr = VecRestoreArray(f,&af);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(x,&ax);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode FormFunctionBatch(void *ctx,PetscInt n,const Vec x[],Vec f[])
+{
+  AppCtx         *user = (AppCtx*)ctx;
+  PetscInt       i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  user->ncalls++;
+  user->nstates += n;
+  for (i=0; i<n; i++) {ierr = FormFunction(NULL,x[i],f[i]);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  Mat            A,B,C,D;
+  Vec            U,a,y;
+  PetscRandom    rnd;
+  AppCtx         user = {0,0};
+  PetscInt       i,n = 20,k = 4;
+  PetscReal      shift = 0.0,nrm,err;
+  PetscBool      batch = PETSC_FALSE;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-k",&k,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetReal(NULL,NULL,"-shift",&shift,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-batch",&batch,NULL);CHKERRQ(ierr);
+
+  ierr = MatCreateMFFD(PETSC_COMM_WORLD,PETSC_DECIDE,PETSC_DECIDE,n,n,&A);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(A);CHKERRQ(ierr);
+  if (batch) {
+    ierr = MatMFFDSetFunctionBatch(A,FormFunctionBatch,&user);CHKERRQ(ierr);
+  } else {
+    ierr = MatMFFDSetFunction(A,FormFunction,NULL);CHKERRQ(ierr);
+  }
+  ierr = MatCreateVecs(A,&U,&y);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rnd);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rnd);CHKERRQ(ierr);
+  ierr = VecSetRandom(U,rnd);CHKERRQ(ierr);
+  ierr = MatMFFDSetBase(A,U,NULL);CHKERRQ(ierr);
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  if (shift != 0.0) {ierr = MatShift(A,shift);CHKERRQ(ierr);}
+
+  ierr = MatCreateDense(PETSC_COMM_WORLD,PETSC_DECIDE,PETSC_DECIDE,n,k,NULL,&B);CHKERRQ(ierr);
+  ierr = MatSetRandom(B,rnd);CHKERRQ(ierr);
+  /* a zero column is skipped by the differencing */
+  ierr = MatDenseGetColumnVecWrite(B,k-1,&a);CHKERRQ(ierr);
+  ierr = VecSet(a,0.0);CHKERRQ(ierr);
+  ierr = MatDenseRestoreColumnVecWrite(B,k-1,&a);CHKERRQ(ierr);
+  ierr = MatMatMult(A,B,MAT_INITIAL_MATRIX,PETSC_DEFAULT,&C);CHKERRQ(ierr);
+  if (batch) {ierr = PetscPrintf(PETSC_COMM_WORLD,"MatMatMult: %D call(s) of the batched function with %D states\n",user.ncalls,user.nstates);CHKERRQ(ierr);}
+
+  /* the same product one column at a time */
+  ierr = VecDuplicate(U,&a);CHKERRQ(ierr);
+  ierr = MatDuplicate(C,MAT_DO_NOT_COPY_VALUES,&D);CHKERRQ(ierr);
+  ierr = MatMFFDResetHHistory(A);CHKERRQ(ierr);
+  for (i=0; i<k; i++) {
+    Vec b,d;
+
+    ierr = MatDenseGetColumnVecRead(B,i,&b);CHKERRQ(ierr);
+    ierr = VecCopy(b,a);CHKERRQ(ierr);
+    ierr = MatDenseRestoreColumnVecRead(B,i,&b);CHKERRQ(ierr);
+    ierr = MatMult(A,a,y);CHKERRQ(ierr);
+    ierr = MatDenseGetColumnVecWrite(D,i,&d);CHKERRQ(ierr);
+    ierr = VecCopy(y,d);CHKERRQ(ierr);
+    ierr = MatDenseRestoreColumnVecWrite(D,i,&d);CHKERRQ(ierr);
+  }
+  ierr = MatNorm(D,NORM_FROBENIUS,&nrm);CHKERRQ(ierr);
+  ierr = MatAXPY(D,-1.0,C,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+  ierr = MatNorm(D,NORM_FROBENIUS,&err);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"MatMatMult with MATMFFD %s MatMult\n",err <= 1e-10*nrm ? "matches" : "DIFFERS from");CHKERRQ(ierr);
+
+  ierr = PetscRandomDestroy(&rnd);CHKERRQ(ierr);
+  ierr = VecDestroy(&U);CHKERRQ(ierr);
+  ierr = VecDestroy(&a);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = MatDestroy(&C);CHKERRQ(ierr);
+  ierr = MatDestroy(&D);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+  test:
+    suffix: 1
+    nsize: {{1 2}}
+    args: -mat_mffd_type {{ds wp}} -shift {{0 2}}
+    output_file: output/ex302_1.out
+
+  test:
+    suffix: batch
+    nsize: {{1 2}}
+    args: -batch -mat_mffd_type {{ds wp}}
+    output_file: output/ex302_batch.out
+
+TEST*/
@@ -0,0 +1,134 @@
+static char help[] = "Tests the products and SOR of MATSEQBAIJ with the fixed block size kernels against the generic ones.\n\n";
+
+#include <petscmat.h>
+
+static PetscErrorCode CreateMatrix(PetscInt bs,PetscInt m,PetscBool unroll,PetscBool empty,Mat *A)
+{
+  PetscRandom    rnd;
+  PetscScalar    *v;
+  PetscInt       i,j,k,cols[3];
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  if (!unroll) {ierr = PetscOptionsSetValue(NULL,"-mat_no_unroll",NULL);CHKERRQ(ierr);}
+  ierr = MatCreateSeqBAIJ(PETSC_COMM_SELF,bs,m*bs,m*bs,3,NULL,A);CHKERRQ(ierr);
+  if (!unroll) {ierr = PetscOptionsClearValue(NULL,"-mat_no_unroll");CHKERRQ(ierr);}
+  /* the same values for both matrices */
+  ierr = PetscRandomCreate(PETSC_COMM_SELF,&rnd);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rnd);CHKERRQ(ierr);
+  ierr = PetscMalloc1(3*bs*bs,&v);CHKERRQ(ierr);
+  for (i=0; i<m; i++) {
+    /* a block tridiagonal matrix with an extra coupling, diagonally dominant */
+    cols[0] = i; cols[1] = (i+1)%m; cols[2] = (i+m/2+1)%m;
+    if (cols[2] == cols[0] || cols[2] == cols[1]) cols[2] = (i+m-1)%m;
+    for (k=0; k<3*bs*bs; k++) {ierr = PetscRandomGetValue(rnd,&v[k]);CHKERRQ(ierr);}
+    for (j=0; j<bs; j++) v[j*3*bs+j] += 3.0*bs;
+    /* with most block rows left empty the products use the compressed row kernels */
+    if (empty && i%4) continue;
+    ierr = MatSetValuesBlocked(*A,1,&i,m > 2 ? 3 : 1,cols,v,INSERT_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(*A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(*A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = PetscFree(v);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rnd);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode Compare(const char *op,PetscInt bs,Vec y1,Vec y2)
+{
+  Vec            d;
+  PetscReal      nrm,err;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = VecNorm(y2,NORM_2,&nrm);CHKERRQ(ierr);
+  ierr = VecDuplicate(y2,&d);CHKERRQ(ierr);
+  ierr = VecWAXPY(d,-1.0,y1,y2);CHKERRQ(ierr);
+  ierr = VecNorm(d,NORM_2,&err);CHKERRQ(ierr);
+  ierr = VecDestroy(&d);CHKERRQ(ierr);
+  if (err > 100*PETSC_MACHINE_EPSILON*nrm) {ierr = PetscPrintf(PETSC_COMM_SELF,"bs %D: %s differs, relative error %g\n",bs,op,(double)(err/nrm));CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode CompareProducts(PetscInt bs,Mat A,Mat B,Vec x,Vec y,Vec y1,Vec y2)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = MatMult(A,x,y1);CHKERRQ(ierr);
+  ierr = MatMult(B,x,y2);CHKERRQ(ierr);
+  ierr = Compare("MatMult",bs,y1,y2);CHKERRQ(ierr);
+  ierr = MatMultAdd(A,x,y,y1);CHKERRQ(ierr);
+  ierr = MatMultAdd(B,x,y,y2);CHKERRQ(ierr);
+  ierr = Compare("MatMultAdd",bs,y1,y2);CHKERRQ(ierr);
+  ierr = MatMultTranspose(A,x,y1);CHKERRQ(ierr);
+  ierr = MatMultTranspose(B,x,y2);CHKERRQ(ierr);
+  ierr = Compare("MatMultTranspose",bs,y1,y2);CHKERRQ(ierr);
+  ierr = MatMultTransposeAdd(A,x,y,y1);CHKERRQ(ierr);
+  ierr = MatMultTransposeAdd(B,x,y,y2);CHKERRQ(ierr);
+  ierr = Compare("MatMultTransposeAdd",bs,y1,y2);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  Mat            A,B;
+  Vec            x,y,y1,y2;
+  PetscRandom    rnd;
+  PetscInt       bs = 8,m = 7;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-bs",&bs,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-m",&m,NULL);CHKERRQ(ierr);
+  ierr = CreateMatrix(bs,m,PETSC_TRUE,PETSC_FALSE,&A);CHKERRQ(ierr);
+  ierr = CreateMatrix(bs,m,PETSC_FALSE,PETSC_FALSE,&B);CHKERRQ(ierr);
+  ierr = MatCreateVecs(A,&x,&y);CHKERRQ(ierr);
+  ierr = VecDuplicate(y,&y1);CHKERRQ(ierr);
+  ierr = VecDuplicate(y,&y2);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_SELF,&rnd);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rnd);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,rnd);CHKERRQ(ierr);
+  ierr = VecSetRandom(y,rnd);CHKERRQ(ierr);
+
+  ierr = CompareProducts(bs,A,B,x,y,y1,y2);CHKERRQ(ierr);
+
+  ierr = MatSOR(A,x,1.0,(MatSORType)(SOR_SYMMETRIC_SWEEP|SOR_ZERO_INITIAL_GUESS),0.0,2,1,y1);CHKERRQ(ierr);
+  ierr = MatSOR(B,x,1.0,(MatSORType)(SOR_SYMMETRIC_SWEEP|SOR_ZERO_INITIAL_GUESS),0.0,2,1,y2);CHKERRQ(ierr);
+  ierr = Compare("MatSOR symmetric",bs,y1,y2);CHKERRQ(ierr);
+  ierr = MatSOR(A,x,1.0,SOR_FORWARD_SWEEP,0.0,1,1,y1);CHKERRQ(ierr);
+  ierr = MatSOR(B,x,1.0,SOR_FORWARD_SWEEP,0.0,1,1,y2);CHKERRQ(ierr);
+  ierr = Compare("MatSOR forward",bs,y1,y2);CHKERRQ(ierr);
+  ierr = VecCopy(y,y1);CHKERRQ(ierr);
+  ierr = VecCopy(y,y2);CHKERRQ(ierr);
+  ierr = MatSOR(A,x,1.0,(MatSORType)(SOR_BACKWARD_SWEEP|SOR_ZERO_INITIAL_GUESS),0.0,1,1,y1);CHKERRQ(ierr);
+  ierr = MatSOR(B,x,1.0,(MatSORType)(SOR_BACKWARD_SWEEP|SOR_ZERO_INITIAL_GUESS),0.0,1,1,y2);CHKERRQ(ierr);
+  ierr = Compare("MatSOR backward",bs,y1,y2);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+
+  /* the same products through the compressed row kernels */
+  ierr = CreateMatrix(bs,m,PETSC_TRUE,PETSC_TRUE,&A);CHKERRQ(ierr);
+  ierr = CreateMatrix(bs,m,PETSC_FALSE,PETSC_TRUE,&B);CHKERRQ(ierr);
+  ierr = CompareProducts(bs,A,B,x,y,y1,y2);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_SELF,"Done\n");CHKERRQ(ierr);
+
+  ierr = PetscRandomDestroy(&rnd);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&y1);CHKERRQ(ierr);
+  ierr = VecDestroy(&y2);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+  test:
+    suffix: 1
+    args: -bs {{6 7 8 9 10 13 16 24 32}}
+    output_file: output/ex303_1.out
+
+TEST*/
@@ -0,0 +1,203 @@
+static char help[] = "Tests MATVBAIJ converted from MATAIJ: products against AIJ, SOR and ILU(0) against BAIJ for a uniform block size, and solves.\n\n";
+
+#include <petscksp.h>
+
+/* a matrix coupling the unknowns at each node to those of the nodes i+-1 and i+-3 on a ring, diagonally dominant */
+static PetscErrorCode CreateMatrix(PetscInt nodes,PetscInt bs,Mat *A)
+{
+  PetscRandom    rnd;
+  PetscInt       i,j,k,l,n = 0,dmax = 0,*dof,*start,*nnz,nb,nbrs[5],rows[8],cols[8];
+  PetscScalar    v[64];
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = PetscMalloc2(nodes,&dof,nodes+1,&start);CHKERRQ(ierr);
+  start[0] = 0;
+  for (i=0; i<nodes; i++) {
+    dof[i]     = bs ? bs : 1 + (7*i)%3;
+    start[i+1] = start[i] + dof[i];
+    dmax       = PetscMax(dmax,dof[i]);
+  }
+  n    = start[nodes];
+  ierr = PetscMalloc1(n,&nnz);CHKERRQ(ierr);
+  for (i=0; i<nodes; i++) {
+    for (k=0; k<dof[i]; k++) nnz[start[i]+k] = 5*dmax;
+  }
+  ierr = MatCreate(PETSC_COMM_SELF,A);CHKERRQ(ierr);
+  ierr = MatSetSizes(*A,n,n,n,n);CHKERRQ(ierr);
+  ierr = MatSetType(*A,MATSEQAIJ);CHKERRQ(ierr);
+  if (bs) {ierr = MatSetBlockSize(*A,bs);CHKERRQ(ierr);}
+  ierr = MatSeqAIJSetPreallocation(*A,0,nnz);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_SELF,&rnd);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rnd);CHKERRQ(ierr);
+  for (i=0; i<nodes; i++) {
+    nbrs[0] = (i+nodes-3)%nodes; nbrs[1] = (i+nodes-1)%nodes; nbrs[2] = i; nbrs[3] = (i+1)%nodes; nbrs[4] = (i+3)%nodes;
+    for (k=0; k<dof[i]; k++) rows[k] = start[i]+k;
+    for (j=0; j<5; j++) {
+      nb = nbrs[j];
+      for (l=0; l<dof[nb]; l++) cols[l] = start[nb]+l;
+      for (k=0; k<dof[i]*dof[nb]; k++) {ierr = PetscRandomGetValue(rnd,&v[k]);CHKERRQ(ierr);}
+      if (nb == i) for (k=0; k<dof[i]; k++) v[k*dof[i]+k] += 5.0*dmax;
+      ierr = MatSetValues(*A,dof[i],rows,dof[nb],cols,v,INSERT_VALUES);CHKERRQ(ierr);
+    }
+  }
+  ierr = MatAssemblyBegin(*A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(*A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rnd);CHKERRQ(ierr);
+  ierr = PetscFree2(dof,start);CHKERRQ(ierr);
+  ierr = PetscFree(nnz);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode Compare(const char *op,Vec y1,Vec y2)
+{
+  Vec            d;
+  PetscReal      nrm,err;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = VecNorm(y2,NORM_2,&nrm);CHKERRQ(ierr);
+  ierr = VecDuplicate(y2,&d);CHKERRQ(ierr);
+  ierr = VecWAXPY(d,-1.0,y1,y2);CHKERRQ(ierr);
+  ierr = VecNorm(d,NORM_2,&err);CHKERRQ(ierr);
+  ierr = VecDestroy(&d);CHKERRQ(ierr);
+  if (err > 100*PETSC_MACHINE_EPSILON*nrm) {ierr = PetscPrintf(PETSC_COMM_SELF,"%s differs, relative error %g\n",op,(double)(err/nrm));CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode CompareProducts(Mat A,Mat V,Vec x,Vec y,Vec y1,Vec y2)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = MatMult(A,x,y1);CHKERRQ(ierr);
+  ierr = MatMult(V,x,y2);CHKERRQ(ierr);
+  ierr = Compare("MatMult",y1,y2);CHKERRQ(ierr);
+  ierr = MatMultAdd(A,x,y,y1);CHKERRQ(ierr);
+  ierr = MatMultAdd(V,x,y,y2);CHKERRQ(ierr);
+  ierr = Compare("MatMultAdd",y1,y2);CHKERRQ(ierr);
+  ierr = MatMultTranspose(A,x,y1);CHKERRQ(ierr);
+  ierr = MatMultTranspose(V,x,y2);CHKERRQ(ierr);
+  ierr = Compare("MatMultTranspose",y1,y2);CHKERRQ(ierr);
+  ierr = MatMultTransposeAdd(A,x,y,y1);CHKERRQ(ierr);
+  ierr = MatMultTransposeAdd(V,x,y,y2);CHKERRQ(ierr);
+  ierr = Compare("MatMultTransposeAdd",y1,y2);CHKERRQ(ierr);
+  ierr = MatGetDiagonal(A,y1);CHKERRQ(ierr);
+  ierr = MatGetDiagonal(V,y2);CHKERRQ(ierr);
+  ierr = Compare("MatGetDiagonal",y1,y2);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  Mat            A,V,B,C,F,FB;
+  Vec            x,y,y1,y2;
+  KSP            ksp;
+  IS             row,col;
+  MatFactorInfo  info;
+  PetscRandom    rnd;
+  PetscInt       nodes = 12,bs = 0;
+  PetscReal      nrm,err;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-nodes",&nodes,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-bs",&bs,NULL);CHKERRQ(ierr);
+  if (bs < 0 || bs > 8) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Block size must be between 0 and 8");
+  ierr = CreateMatrix(nodes,bs,&A);CHKERRQ(ierr);
+  ierr = MatConvert(A,MATVBAIJ,MAT_INITIAL_MATRIX,&V);CHKERRQ(ierr);
+  ierr = PetscViewerPushFormat(PETSC_VIEWER_STDOUT_SELF,PETSC_VIEWER_ASCII_INFO);CHKERRQ(ierr);
+  ierr = MatView(V,PETSC_VIEWER_STDOUT_SELF);CHKERRQ(ierr);
+  ierr = PetscViewerPopFormat(PETSC_VIEWER_STDOUT_SELF);CHKERRQ(ierr);
+
+  ierr = MatCreateVecs(A,&x,&y);CHKERRQ(ierr);
+  ierr = VecDuplicate(y,&y1);CHKERRQ(ierr);
+  ierr = VecDuplicate(y,&y2);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_SELF,&rnd);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rnd);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,rnd);CHKERRQ(ierr);
+  ierr = VecSetRandom(y,rnd);CHKERRQ(ierr);
+  ierr = CompareProducts(A,V,x,y,y1,y2);CHKERRQ(ierr);
+
+  /* back to AIJ, and new values with the same nonzero structure */
+  ierr = MatConvert(V,MATAIJ,MAT_INITIAL_MATRIX,&C);CHKERRQ(ierr);
+  ierr = MatNorm(A,NORM_FROBENIUS,&nrm);CHKERRQ(ierr);
+  ierr = MatAXPY(C,-1.0,A,DIFFERENT_NONZERO_PATTERN);CHKERRQ(ierr);
+  ierr = MatNorm(C,NORM_FROBENIUS,&err);CHKERRQ(ierr);
+  if (err > 100*PETSC_MACHINE_EPSILON*nrm) {ierr = PetscPrintf(PETSC_COMM_SELF,"MatConvert to AIJ differs, relative error %g\n",(double)(err/nrm));CHKERRQ(ierr);}
+  ierr = MatDestroy(&C);CHKERRQ(ierr);
+  ierr = MatShift(A,1.0);CHKERRQ(ierr);
+  ierr = MatConvert(A,MATVBAIJ,MAT_REUSE_MATRIX,&V);CHKERRQ(ierr);
+  ierr = CompareProducts(A,V,x,y,y1,y2);CHKERRQ(ierr);
+
+  if (bs) {
+    /* with a uniform block size the block Gauss-Seidel and block ILU(0) of BAIJ are the same algorithms */
+    ierr = MatConvert(A,MATSEQBAIJ,MAT_INITIAL_MATRIX,&B);CHKERRQ(ierr);
+    ierr = MatSOR(B,x,1.0,(MatSORType)(SOR_SYMMETRIC_SWEEP|SOR_ZERO_INITIAL_GUESS),0.0,2,1,y1);CHKERRQ(ierr);
+    ierr = MatSOR(V,x,1.0,(MatSORType)(SOR_SYMMETRIC_SWEEP|SOR_ZERO_INITIAL_GUESS),0.0,2,1,y2);CHKERRQ(ierr);
+    ierr = Compare("MatSOR symmetric",y1,y2);CHKERRQ(ierr);
+    ierr = MatSOR(B,x,1.0,SOR_FORWARD_SWEEP,0.0,1,1,y1);CHKERRQ(ierr);
+    ierr = MatSOR(V,x,1.0,SOR_FORWARD_SWEEP,0.0,1,1,y2);CHKERRQ(ierr);
+    ierr = Compare("MatSOR forward",y1,y2);CHKERRQ(ierr);
+    ierr = MatSOR(B,x,1.0,(MatSORType)(SOR_BACKWARD_SWEEP|SOR_ZERO_INITIAL_GUESS),0.0,1,1,y1);CHKERRQ(ierr);
+    ierr = MatSOR(V,x,1.0,(MatSORType)(SOR_BACKWARD_SWEEP|SOR_ZERO_INITIAL_GUESS),0.0,1,1,y2);CHKERRQ(ierr);
+    ierr = Compare("MatSOR backward",y1,y2);CHKERRQ(ierr);
+
+    ierr = MatFactorInfoInitialize(&info);CHKERRQ(ierr);
+    info.fill = 1.0;
+    ierr = MatGetOrdering(B,MATORDERINGNATURAL,&row,&col);CHKERRQ(ierr);
+    ierr = MatGetFactor(B,MATSOLVERPETSC,MAT_FACTOR_ILU,&FB);CHKERRQ(ierr);
+    ierr = MatILUFactorSymbolic(FB,B,row,col,&info);CHKERRQ(ierr);
+    ierr = MatLUFactorNumeric(FB,B,&info);CHKERRQ(ierr);
+    ierr = MatSolve(FB,x,y1);CHKERRQ(ierr);
+    ierr = MatGetFactor(V,MATSOLVERPETSC,MAT_FACTOR_ILU,&F);CHKERRQ(ierr);
+    ierr = MatILUFactorSymbolic(F,V,NULL,NULL,&info);CHKERRQ(ierr);
+    ierr = MatLUFactorNumeric(F,V,&info);CHKERRQ(ierr);
+    ierr = MatSolve(F,x,y2);CHKERRQ(ierr);
+    ierr = Compare("ILU(0) MatSolve",y1,y2);CHKERRQ(ierr);
+    ierr = ISDestroy(&row);CHKERRQ(ierr);
+    ierr = ISDestroy(&col);CHKERRQ(ierr);
+    ierr = MatDestroy(&F);CHKERRQ(ierr);
+    ierr = MatDestroy(&FB);CHKERRQ(ierr);
+    ierr = MatDestroy(&B);CHKERRQ(ierr);
+  }
+
+  /* solve A x = b with the VBAIJ matrix and the preconditioner from the options */
+  ierr = MatMult(A,x,y);CHKERRQ(ierr);
+  ierr = KSPCreate(PETSC_COMM_SELF,&ksp);CHKERRQ(ierr);
+  ierr = KSPSetOperators(ksp,V,V);CHKERRQ(ierr);
+  ierr = KSPSetTolerances(ksp,1.e-10,PETSC_DEFAULT,PETSC_DEFAULT,PETSC_DEFAULT);CHKERRQ(ierr);
+  ierr = KSPSetFromOptions(ksp);CHKERRQ(ierr);
+  ierr = KSPSolve(ksp,y,y1);CHKERRQ(ierr);
+  ierr = VecNorm(x,NORM_2,&nrm);CHKERRQ(ierr);
+  ierr = VecAXPY(y1,-1.0,x);CHKERRQ(ierr);
+  ierr = VecNorm(y1,NORM_2,&err);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_SELF,"KSPSolve with MATVBAIJ: error %s\n",err < 1.e-8*nrm ? "< 1e-8" : "too large");CHKERRQ(ierr);
+
+  ierr = KSPDestroy(&ksp);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rnd);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&y1);CHKERRQ(ierr);
+  ierr = VecDestroy(&y2);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&V);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+  test:
+    suffix: 1
+    args: -pc_type {{sor ilu vpbjacobi}}
+
+  test:
+    suffix: 2
+    args: -bs {{3 5}separate output} -pc_type {{sor ilu}}
+
+  test:
+    suffix: 3
+    args: -mat_vbaij_max_block_size 2 -pc_type ilu
+
+TEST*/
@@ -0,0 +1,185 @@
+static char help[] = "Tests the products and the diagonal of MATKRONECKER against the assembled Kronecker product.\n\n";
+
+#include <petscmat.h>
+
+/* a nonsymmetric banded m x n matrix, the same values on each process */
+static PetscErrorCode CreateFactor(MPI_Comm comm,PetscInt m,PetscInt n,PetscInt seed,Mat *A)
+{
+  PetscInt       i,j,rstart,rend;
+  PetscScalar    v;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = MatCreateAIJ(comm,PETSC_DECIDE,PETSC_DECIDE,m,n,3,NULL,2,NULL,A);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(*A,&rstart,&rend);CHKERRQ(ierr);
+  for (i=rstart; i<rend; i++) {
+    for (j=PetscMax(i-1,0); j<PetscMin(i+2,n); j++) {
+      v    = (i == j) ? 3.0+seed : -1.0+0.1*((i+2*j+seed)%5);
+      ierr = MatSetValue(*A,i,j,v,INSERT_VALUES);CHKERRQ(ierr);
+    }
+  }
+  ierr = MatAssemblyBegin(*A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(*A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* C += A x B, assembled */
+static PetscErrorCode AddKron(Mat A,Mat B,Mat C)
+{
+  PetscInt          i,k,p,q,ncA,ncB,mb,nb,rstart,rend,row,col;
+  const PetscInt    *cA,*cB;
+  const PetscScalar *vA,*vB;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBeginUser;
+  ierr = MatGetSize(B,&mb,&nb);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(A,&rstart,&rend);CHKERRQ(ierr);
+  for (i=rstart; i<rend; i++) {
+    ierr = MatGetRow(A,i,&ncA,&cA,&vA);CHKERRQ(ierr);
+    for (k=0; k<mb; k++) {
+      ierr = MatGetRow(B,k,&ncB,&cB,&vB);CHKERRQ(ierr);
+      row  = i*mb+k;
+      for (p=0; p<ncA; p++) {
+        for (q=0; q<ncB; q++) {
+          col  = cA[p]*nb+cB[q];
+          ierr = MatSetValue(C,row,col,vA[p]*vB[q],ADD_VALUES);CHKERRQ(ierr);
+        }
+      }
+      ierr = MatRestoreRow(B,k,&ncB,&cB,&vB);CHKERRQ(ierr);
+    }
+    ierr = MatRestoreRow(A,i,&ncA,&cA,&vA);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode Compare(const char *op,Vec y1,Vec y2)
+{
+  Vec            d;
+  PetscReal      nrm,err;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = VecNorm(y2,NORM_2,&nrm);CHKERRQ(ierr);
+  ierr = VecDuplicate(y2,&d);CHKERRQ(ierr);
+  ierr = VecWAXPY(d,-1.0,y1,y2);CHKERRQ(ierr);
+  ierr = VecNorm(d,NORM_2,&err);CHKERRQ(ierr);
+  ierr = VecDestroy(&d);CHKERRQ(ierr);
+  if (err > 100*PETSC_MACHINE_EPSILON*nrm) {ierr = PetscPrintf(PETSC_COMM_WORLD,"%s differs, relative error %g\n",op,(double)(err/nrm));CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  Mat            A[2],B[2],C,E;
+  Vec            x,y,u,v,y1,y2,u1,u2;
+  PetscRandom    rnd;
+  PetscInt       ma = 10,na = 10,mb = 4,nb = 4,nterms = 1,t,nt,m,n;
+  PetscBool      view = PETSC_FALSE;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-ma",&ma,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-na",&na,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-mb",&mb,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-nb",&nb,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-nterms",&nterms,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-view",&view,NULL);CHKERRQ(ierr);
+  if (nterms < 1 || nterms > 2) SETERRQ(PETSC_COMM_WORLD,PETSC_ERR_ARG_OUTOFRANGE,"-nterms must be 1 or 2");
+
+  for (t=0; t<nterms; t++) {
+    ierr = CreateFactor(PETSC_COMM_WORLD,ma,na,t,&A[t]);CHKERRQ(ierr);
+    ierr = CreateFactor(PETSC_COMM_SELF,mb,nb,2*t+1,&B[t]);CHKERRQ(ierr);
+  }
+  ierr = MatCreateKronecker(A[0],B[0],&C);CHKERRQ(ierr);
+  if (nterms > 1) {ierr = MatKroneckerAddTerm(C,A[1],B[1]);CHKERRQ(ierr);}
+  ierr = MatKroneckerGetNumberTerms(C,&nt);CHKERRQ(ierr);
+  if (nt != nterms) SETERRQ2(PETSC_COMM_WORLD,PETSC_ERR_PLIB,"Wrong number of terms %D != %D",nt,nterms);
+  if (view) {ierr = MatView(C,NULL);CHKERRQ(ierr);}
+
+  /* the assembled product has the same parallel layout */
+  ierr = MatGetLocalSize(C,&m,&n);CHKERRQ(ierr);
+  ierr = MatCreateAIJ(PETSC_COMM_WORLD,m,n,PETSC_DETERMINE,PETSC_DETERMINE,9*nterms,NULL,9*nterms,NULL,&E);CHKERRQ(ierr);
+  for (t=0; t<nterms; t++) {ierr = AddKron(A[t],B[t],E);CHKERRQ(ierr);}
+  ierr = MatAssemblyBegin(E,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(E,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+
+  ierr = MatCreateVecs(C,&x,&y);CHKERRQ(ierr);
+  ierr = MatCreateVecs(C,&u,&v);CHKERRQ(ierr);
+  ierr = VecDuplicate(y,&y1);CHKERRQ(ierr);
+  ierr = VecDuplicate(y,&y2);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&u1);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&u2);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rnd);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rnd);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,rnd);CHKERRQ(ierr);
+  ierr = VecSetRandom(y,rnd);CHKERRQ(ierr);
+  ierr = VecSetRandom(u,rnd);CHKERRQ(ierr);
+  ierr = VecSetRandom(v,rnd);CHKERRQ(ierr);
+
+  ierr = MatMult(C,x,y1);CHKERRQ(ierr);
+  ierr = MatMult(E,x,y2);CHKERRQ(ierr);
+  ierr = Compare("MatMult",y1,y2);CHKERRQ(ierr);
+  ierr = MatMultAdd(C,x,y,y1);CHKERRQ(ierr);
+  ierr = MatMultAdd(E,x,y,y2);CHKERRQ(ierr);
+  ierr = Compare("MatMultAdd",y1,y2);CHKERRQ(ierr);
+  ierr = VecCopy(y,y1);CHKERRQ(ierr);
+  ierr = VecCopy(y,y2);CHKERRQ(ierr);
+  ierr = MatMultAdd(C,x,y1,y1);CHKERRQ(ierr);
+  ierr = MatMultAdd(E,x,y2,y2);CHKERRQ(ierr);
+  ierr = Compare("MatMultAdd in place",y1,y2);CHKERRQ(ierr);
+  ierr = MatMultTranspose(C,v,u1);CHKERRQ(ierr);
+  ierr = MatMultTranspose(E,v,u2);CHKERRQ(ierr);
+  ierr = Compare("MatMultTranspose",u1,u2);CHKERRQ(ierr);
+  ierr = MatMultTransposeAdd(C,v,u,u1);CHKERRQ(ierr);
+  ierr = MatMultTransposeAdd(E,v,u,u2);CHKERRQ(ierr);
+  ierr = Compare("MatMultTransposeAdd",u1,u2);CHKERRQ(ierr);
+  ierr = VecCopy(u,u1);CHKERRQ(ierr);
+  ierr = VecCopy(u,u2);CHKERRQ(ierr);
+  ierr = MatMultTransposeAdd(C,v,u1,u1);CHKERRQ(ierr);
+  ierr = MatMultTransposeAdd(E,v,u2,u2);CHKERRQ(ierr);
+  ierr = Compare("MatMultTransposeAdd in place",u1,u2);CHKERRQ(ierr);
+  if (mb == nb) {
+    ierr = MatGetDiagonal(C,y1);CHKERRQ(ierr);
+    ierr = MatGetDiagonal(E,y2);CHKERRQ(ierr);
+    ierr = Compare("MatGetDiagonal",y1,y2);CHKERRQ(ierr);
+  }
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Done\n");CHKERRQ(ierr);
+
+  ierr = PetscRandomDestroy(&rnd);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&u);CHKERRQ(ierr);
+  ierr = VecDestroy(&v);CHKERRQ(ierr);
+  ierr = VecDestroy(&y1);CHKERRQ(ierr);
+  ierr = VecDestroy(&y2);CHKERRQ(ierr);
+  ierr = VecDestroy(&u1);CHKERRQ(ierr);
+  ierr = VecDestroy(&u2);CHKERRQ(ierr);
+  for (t=0; t<nterms; t++) {
+    ierr = MatDestroy(&A[t]);CHKERRQ(ierr);
+    ierr = MatDestroy(&B[t]);CHKERRQ(ierr);
+  }
+  ierr = MatDestroy(&C);CHKERRQ(ierr);
+  ierr = MatDestroy(&E);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+  test:
+    suffix: 1
+    nsize: {{1 3}}
+    args: -nterms {{1 2}}
+    output_file: output/ex305_1.out
+
+  test:
+    suffix: 2
+    nsize: {{1 3}}
+    args: -ma 7 -na 9 -mb 3 -nb 5 -nterms 2
+    output_file: output/ex305_1.out
+
+  test:
+    suffix: 3
+    args: -nterms 2 -view
+
+TEST*/
@@ -1,5 +1,6 @@
 #include <petsc/private/snesimpl.h>             /*I   "petscsnes.h"   I*/
 #include <petscdm.h>
+#include <petscsf.h>
 
 typedef struct {
   PetscInt   n;                   /* local subdomains */
@@ -25,6 +26,21 @@ typedef struct {
 
   PetscInt      fjtype;            /* type of computed jacobian */
   Vec           xinit;             /* initial solution in case the final jacobian type is computed as first */
+
+  /* asynchronous iteration, see SNESNASMSetAsynchronous() */
+  PetscBool     async;             /* sweep over the local subdomains without waiting for the other processes */
+  PetscInt      asyncsweeps;       /* average number of sweeps per process after which an iteration ends */
+  Vec           xg;                /* owned entries of the solution followed by the ghost entries read by the local subdomains */
+  Vec           yg,fg;             /* summed restricted updates and residuals of a sweep, laid out like xg */
+  VecScatter    *oscatterg;        /* scatter from xg to the subdomain global space */
+  VecScatter    *gscatterg;        /* scatter from xg to the subdomain local space */
+  VecScatter    *iscatterg;        /* scatter from the nonoverlapping part of the subdomain global space to xg */
+  PetscSF       ghostsf;           /* owners of the ghost entries of xg */
+  PetscScalar   *sendbuf,*recvbuf; /* buffers of the ghost exchange */
+  MPI_Request   *reqs;             /* requests of the ghost exchange in progress */
+  PetscMPIInt   tag;               /* tag of the ghost exchange */
+  PetscInt      nrounds;           /* number of ghost exchanges posted in the current iteration */
+  PetscBool     exchanging;        /* a ghost exchange is in progress */
 } SNES_NASM;
 
 const char *const SNESNASMTypes[] = {"NONE","RESTRICT","INTERPOLATE","BASIC","PCASMType","PC_ASM_",NULL};
@@ -67,6 +83,20 @@ static PetscErrorCode SNESReset_NASM(SNES snes)
     ierr = VecDestroy(&nasm->weight);CHKERRQ(ierr);
   }
 
+  if (nasm->xg) {
+    for (i=0; i<nasm->n; i++) {
+      ierr = VecScatterDestroy(&nasm->oscatterg[i]);CHKERRQ(ierr);
+      ierr = VecScatterDestroy(&nasm->gscatterg[i]);CHKERRQ(ierr);
+      ierr = VecScatterDestroy(&nasm->iscatterg[i]);CHKERRQ(ierr);
+    }
+    ierr = PetscFree3(nasm->oscatterg,nasm->gscatterg,nasm->iscatterg);CHKERRQ(ierr);
+    ierr = PetscFree3(nasm->sendbuf,nasm->recvbuf,nasm->reqs);CHKERRQ(ierr);
+    ierr = PetscSFDestroy(&nasm->ghostsf);CHKERRQ(ierr);
+    ierr = VecDestroy(&nasm->xg);CHKERRQ(ierr);
+    ierr = VecDestroy(&nasm->yg);CHKERRQ(ierr);
+    ierr = VecDestroy(&nasm->fg);CHKERRQ(ierr);
+  }
+
   nasm->eventrestrictinterp = 0;
   nasm->eventsubsolve = 0;
   PetscFunctionReturn(0);
@@ -137,8 +167,8 @@ static PetscErrorCode SNESSetUp_NASM(SNES snes)
         ierr = DMDestroy(&subdms[i]);CHKERRQ(ierr);
       }
       ierr = PetscFree(subdms);CHKERRQ(ierr);
-    } else SETERRQ(PetscObjectComm((PetscObject)snes),PETSC_ERR_ARG_WRONGSTATE,"Cannot construct local problems automatically without a DM!");
-  } else SETERRQ(PetscObjectComm((PetscObject)snes),PETSC_ERR_ARG_WRONGSTATE,"Must set subproblems manually if there is no DM!");
+    } else SETERRQ(PetscObjectComm((PetscObject)snes),PETSC_ERR_ARG_WRONGSTATE,"Cannot construct local problems automatically without a DM! Set subproblems manually with SNESNASMSetSubdomains().");
+  }
   /* allocate the global vectors */
   if (!nasm->x) {
     ierr = PetscCalloc1(nasm->n,&nasm->x);CHKERRQ(ierr);
@@ -194,6 +224,8 @@ static PetscErrorCode SNESSetFromOptions_NASM(PetscOptionItems *PetscOptionsObje
   ierr   = PetscOptionsDeprecated("-snes_nasm_sub_view",NULL,"3.15","Use -snes_view ::ascii_info_detail");CHKERRQ(ierr);
   ierr   = PetscOptionsBool("-snes_nasm_finaljacobian","Compute the global jacobian of the final iterate (for ASPIN)","",nasm->finaljacobian,&nasm->finaljacobian,NULL);CHKERRQ(ierr);
   ierr   = PetscOptionsEList("-snes_nasm_finaljacobian_type","The type of the final jacobian computed.","",SNESNASMFJTypes,3,SNESNASMFJTypes[0],&nasm->fjtype,NULL);CHKERRQ(ierr);
+  ierr   = PetscOptionsBool("-snes_nasm_async","Sweep over the local subdomains with the most recently received overlap values, without waiting for the other processes","SNESNASMSetAsynchronous",nasm->async,&nasm->async,NULL);CHKERRQ(ierr);
+  ierr   = PetscOptionsInt("-snes_nasm_async_sweeps","Average number of sweeps per process after which an asynchronous iteration ends","SNESNASMSetAsynchronous",nasm->asyncsweeps,&nasm->asyncsweeps,NULL);CHKERRQ(ierr);
   ierr   = PetscOptionsBool("-snes_nasm_log","Log times for subSNES solves and restriction","",monflg,&monflg,&flg);CHKERRQ(ierr);
   if (flg) {
     ierr = PetscLogEventRegister("SNESNASMSubSolve",((PetscObject)snes)->classid,&nasm->eventsubsolve);CHKERRQ(ierr);
@@ -224,6 +256,7 @@ static PetscErrorCode SNESView_NASM(SNES snes, PetscViewer viewer)
   ierr = MPIU_Allreduce(&nasm->n,&N,1,MPIU_INT,MPI_SUM,comm);CHKERRMPI(ierr);
   if (iascii) {
     ierr = PetscViewerASCIIPrintf(viewer, "  total subdomain blocks = %D\n",N);CHKERRQ(ierr);
+    if (nasm->async) {ierr = PetscViewerASCIIPrintf(viewer, "  asynchronous, iterations end after %D sweeps per process on average\n",nasm->asyncsweeps);CHKERRQ(ierr);}
     ierr = PetscViewerGetFormat(viewer,&format);CHKERRQ(ierr);
     if (format != PETSC_VIEWER_ASCII_INFO_DETAIL) {
       if (nasm->subsnes) {
@@ -606,6 +639,86 @@ static PetscErrorCode SNESNASMGetDamping_NASM(SNES snes,PetscReal *dmp)
   PetscFunctionReturn(0);
 }
 
+/*@
+   SNESNASMSetAsynchronous - Sets whether each process sweeps over its subdomains without waiting for the other processes
+
+   Logically collective on SNES
+
+   Input Parameters:
++  SNES - the SNES context
+-  flg - PETSC_TRUE to iterate asynchronously
+
+   Options Database:
++  -snes_nasm_async - iterate asynchronously
+-  -snes_nasm_async_sweeps <n> - average number of sweeps per process after which an iteration ends
+
+   Level: advanced
+
+   Notes:
+   In an asynchronous iteration each process repeatedly solves its subdomain problems using the overlap values most recently
+   received from its neighbors, and applies the restricted updates to its own entries immediately. The overlap values are
+   refreshed with nonblocking messages and the norm of the subdomain residuals with a nonblocking reduction, so that no process
+   waits for the others until the iteration ends. The true residual is then computed and tested as usual.
+
+   Only the restrict type (SNESNASMSetType()) is supported, and MPI must provide MPI_Iallreduce().
+
+.seealso: SNESNASM, SNESNASMGetAsynchronous(), SNESNASMSetType()
+@*/
+PetscErrorCode SNESNASMSetAsynchronous(SNES snes,PetscBool flg)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(snes,SNES_CLASSID,1);
+  PetscValidLogicalCollectiveBool(snes,flg,2);
+  ierr = PetscTryMethod(snes,"SNESNASMSetAsynchronous_C",(SNES,PetscBool),(snes,flg));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode SNESNASMSetAsynchronous_NASM(SNES snes,PetscBool flg)
+{
+  SNES_NASM      *nasm = (SNES_NASM*)snes->data;
+
+  PetscFunctionBegin;
+  nasm->async = flg;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   SNESNASMGetAsynchronous - Gets whether each process sweeps over its subdomains without waiting for the other processes
+
+   Not Collective
+
+   Input Parameter:
+.  SNES - the SNES context
+
+   Output Parameter:
+.  flg - PETSC_TRUE if the iteration is asynchronous
+
+   Level: advanced
+
+.seealso: SNESNASM, SNESNASMSetAsynchronous()
+@*/
+PetscErrorCode SNESNASMGetAsynchronous(SNES snes,PetscBool *flg)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(snes,SNES_CLASSID,1);
+  PetscValidBoolPointer(flg,2);
+  ierr = PetscUseMethod(snes,"SNESNASMGetAsynchronous_C",(SNES,PetscBool*),(snes,flg));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode SNESNASMGetAsynchronous_NASM(SNES snes,PetscBool *flg)
+{
+  SNES_NASM      *nasm = (SNES_NASM*)snes->data;
+
+  PetscFunctionBegin;
+  *flg = nasm->async;
+  PetscFunctionReturn(0);
+}
+
 /*
   Input Parameters:
 + snes - The solver
@@ -693,6 +806,321 @@ PetscErrorCode SNESNASMSolveLocal_Private(SNES snes,Vec B,Vec Y,Vec X)
   PetscFunctionReturn(0);
 }
 
+/*
+   SNESNASMAsyncSetUp_Private - Builds the sequential copy of the solution on which the asynchronous iteration works: the owned
+   entries followed by the entries of the other processes read by the local subdomains, together with the scatters between this
+   copy and the subdomains and the communication pattern that refreshes the ghost entries.
+*/
+static PetscErrorCode SNESNASMAsyncSetUp_Private(SNES snes,Vec X)
+{
+  SNES_NASM         *nasm = (SNES_NASM*)snes->data;
+  PetscInt          i,k,m,n,rstart,rend,nown,nghost = 0,nidx,*ghosts,**oidx,**gidx,**iidx,*from,*to,g,nranks,niranks;
+  const PetscInt    *roffset,*ioffset;
+  const PetscMPIInt *ranks,*iranks;
+  PetscScalar       *a;
+  const PetscScalar *ca;
+  Vec               G,L;
+  IS                isfrom,isto;
+  PetscLayout       map;
+  PCASMType         type;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = SNESNASMGetType(snes,&type);CHKERRQ(ierr);
+  if (type != PC_ASM_RESTRICT) SETERRQ(PetscObjectComm((PetscObject)snes),PETSC_ERR_SUP,"Asynchronous SNESNASM requires the restrict type, use -snes_nasm_type restrict");
+  ierr = VecGetOwnershipRange(X,&rstart,&rend);CHKERRQ(ierr);
+  nown = rend-rstart;
+  /* find the global index of every subdomain entry by scattering the global indices themselves */
+  ierr = VecDuplicate(X,&G);CHKERRQ(ierr);
+  ierr = VecGetArray(G,&a);CHKERRQ(ierr);
+  for (k=0; k<nown; k++) a[k] = rstart+k;
+  ierr = VecRestoreArray(G,&a);CHKERRQ(ierr);
+  ierr = PetscMalloc3(nasm->n,&oidx,nasm->n,&gidx,nasm->n,&iidx);CHKERRQ(ierr);
+  for (i=0; i<nasm->n; i++) {
+    VecScatter scat[3] = {nasm->oscatter[i],nasm->gscatter[i],nasm->iscatter[i]};
+    Vec        sub[3]  = {nasm->x[i],nasm->xl[i],nasm->x[i]};
+    PetscInt   **idx[3] = {oidx,gidx,iidx};
+
+    for (m=0; m<3; m++) {
+      ierr = VecDuplicate(sub[m],&L);CHKERRQ(ierr);
+      ierr = VecSet(L,-1.0);CHKERRQ(ierr);
+      ierr = VecScatterBegin(scat[m],G,L,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+      ierr = VecScatterEnd(scat[m],G,L,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+      ierr = VecGetLocalSize(L,&n);CHKERRQ(ierr);
+      ierr = PetscMalloc1(n,&idx[m][i]);CHKERRQ(ierr);
+      ierr = VecGetArrayRead(L,&ca);CHKERRQ(ierr);
+      for (k=0; k<n; k++) idx[m][i][k] = PetscRealPart(ca[k]) < 0 ? -1 : (PetscInt)(PetscRealPart(ca[k])+0.5);
+      ierr = VecRestoreArrayRead(L,&ca);CHKERRQ(ierr);
+      ierr = VecDestroy(&L);CHKERRQ(ierr);
+      if (m < 2) {
+        for (k=0; k<n; k++) if (idx[m][i][k] >= 0 && (idx[m][i][k] < rstart || idx[m][i][k] >= rend)) nghost++;
+      } else {
+        for (k=0; k<n; k++) if (idx[m][i][k] >= 0 && (idx[m][i][k] < rstart || idx[m][i][k] >= rend)) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_SUP,"Asynchronous SNESNASM requires the nonoverlapping part of subdomain %D to be owned by its process",i);
+      }
+    }
+  }
+  ierr = VecDestroy(&G);CHKERRQ(ierr);
+  /* the ghost entries are the remote entries read by any local subdomain */
+  ierr = PetscMalloc1(nghost,&ghosts);CHKERRQ(ierr);
+  nghost = 0;
+  for (i=0; i<nasm->n; i++) {
+    ierr = VecGetLocalSize(nasm->x[i],&n);CHKERRQ(ierr);
+    for (k=0; k<n; k++) if (oidx[i][k] >= 0 && (oidx[i][k] < rstart || oidx[i][k] >= rend)) ghosts[nghost++] = oidx[i][k];
+    ierr = VecGetLocalSize(nasm->xl[i],&n);CHKERRQ(ierr);
+    for (k=0; k<n; k++) if (gidx[i][k] >= 0 && (gidx[i][k] < rstart || gidx[i][k] >= rend)) ghosts[nghost++] = gidx[i][k];
+  }
+  ierr = PetscSortRemoveDupsInt(&nghost,ghosts);CHKERRQ(ierr);
+  ierr = VecCreateSeq(PETSC_COMM_SELF,nown+nghost,&nasm->xg);CHKERRQ(ierr);
+  ierr = VecDuplicate(nasm->xg,&nasm->yg);CHKERRQ(ierr);
+  ierr = VecDuplicate(nasm->xg,&nasm->fg);CHKERRQ(ierr);
+  ierr = VecSet(nasm->fg,0.0);CHKERRQ(ierr);
+  ierr = PetscMalloc3(nasm->n,&nasm->oscatterg,nasm->n,&nasm->gscatterg,nasm->n,&nasm->iscatterg);CHKERRQ(ierr);
+  for (i=0; i<nasm->n; i++) {
+    VecScatter *scat[3] = {nasm->oscatterg,nasm->gscatterg,nasm->iscatterg};
+    Vec        sub[3]   = {nasm->x[i],nasm->xl[i],nasm->x[i]};
+    PetscInt   **idx[3] = {oidx,gidx,iidx};
+
+    for (m=0; m<3; m++) {
+      ierr = VecGetLocalSize(sub[m],&n);CHKERRQ(ierr);
+      ierr = PetscMalloc2(n,&from,n,&to);CHKERRQ(ierr);
+      for (k=0,nidx=0; k<n; k++) {
+        g = idx[m][i][k];
+        if (g < 0) continue;
+        if (g >= rstart && g < rend) from[nidx] = g-rstart;
+        else {
+          ierr = PetscFindInt(g,nghost,ghosts,&from[nidx]);CHKERRQ(ierr);
+          from[nidx] += nown;
+        }
+        to[nidx++] = k;
+      }
+      ierr = ISCreateGeneral(PETSC_COMM_SELF,nidx,from,PETSC_COPY_VALUES,&isfrom);CHKERRQ(ierr);
+      ierr = ISCreateGeneral(PETSC_COMM_SELF,nidx,to,PETSC_COPY_VALUES,&isto);CHKERRQ(ierr);
+      /* the updates and residuals go from the nonoverlapping part of the subdomain to the owned entries */
+      if (m < 2) {ierr = VecScatterCreate(nasm->xg,isfrom,sub[m],isto,&scat[m][i]);CHKERRQ(ierr);}
+      else       {ierr = VecScatterCreate(sub[m],isto,nasm->xg,isfrom,&scat[m][i]);CHKERRQ(ierr);}
+      ierr = ISDestroy(&isfrom);CHKERRQ(ierr);
+      ierr = ISDestroy(&isto);CHKERRQ(ierr);
+      ierr = PetscFree2(from,to);CHKERRQ(ierr);
+      ierr = PetscFree(idx[m][i]);CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscFree3(oidx,gidx,iidx);CHKERRQ(ierr);
+  /* the ghost entries are leaves of a star forest rooted at their owners */
+  ierr = PetscSFCreate(PetscObjectComm((PetscObject)snes),&nasm->ghostsf);CHKERRQ(ierr);
+  ierr = VecGetLayout(X,&map);CHKERRQ(ierr);
+  ierr = PetscSFSetGraphLayout(nasm->ghostsf,map,nghost,NULL,PETSC_COPY_VALUES,ghosts);CHKERRQ(ierr);
+  ierr = PetscSFSetUp(nasm->ghostsf);CHKERRQ(ierr);
+  ierr = PetscFree(ghosts);CHKERRQ(ierr);
+  ierr = PetscSFGetRootRanks(nasm->ghostsf,&nranks,&ranks,&roffset,NULL,NULL);CHKERRQ(ierr);
+  ierr = PetscSFGetLeafRanks(nasm->ghostsf,&niranks,&iranks,&ioffset,NULL);CHKERRQ(ierr);
+  ierr = PetscMalloc3(ioffset[niranks],&nasm->sendbuf,roffset[nranks],&nasm->recvbuf,nranks+niranks,&nasm->reqs);CHKERRQ(ierr);
+  ierr = PetscObjectGetNewTag((PetscObject)snes,&nasm->tag);CHKERRQ(ierr);
+  ierr = PetscInfo2(snes,"Asynchronous iteration reads %D ghost entries from %D processes\n",nghost,nranks);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   SNESNASMAsyncPost_Private - Starts a ghost exchange: sends the current owned entries of xg read by the other processes and posts
+   the receives of the ghost entries.
+*/
+static PetscErrorCode SNESNASMAsyncPost_Private(SNES snes)
+{
+  SNES_NASM         *nasm = (SNES_NASM*)snes->data;
+  MPI_Comm          comm = PetscObjectComm((PetscObject)snes);
+  PetscInt          j,k,nranks,niranks;
+  const PetscInt    *roffset,*ioffset,*irootloc;
+  const PetscMPIInt *ranks,*iranks;
+  const PetscScalar *x;
+  PetscMPIInt       cnt;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscSFGetRootRanks(nasm->ghostsf,&nranks,&ranks,&roffset,NULL,NULL);CHKERRQ(ierr);
+  ierr = PetscSFGetLeafRanks(nasm->ghostsf,&niranks,&iranks,&ioffset,&irootloc);CHKERRQ(ierr);
+  for (j=0; j<nranks; j++) {
+    ierr = PetscMPIIntCast(roffset[j+1]-roffset[j],&cnt);CHKERRQ(ierr);
+    ierr = MPI_Irecv(nasm->recvbuf+roffset[j],cnt,MPIU_SCALAR,ranks[j],nasm->tag,comm,&nasm->reqs[j]);CHKERRMPI(ierr);
+  }
+  ierr = VecGetArrayRead(nasm->xg,&x);CHKERRQ(ierr);
+  for (k=0; k<ioffset[niranks]; k++) nasm->sendbuf[k] = x[irootloc[k]];
+  ierr = VecRestoreArrayRead(nasm->xg,&x);CHKERRQ(ierr);
+  for (j=0; j<niranks; j++) {
+    ierr = PetscMPIIntCast(ioffset[j+1]-ioffset[j],&cnt);CHKERRQ(ierr);
+    ierr = MPI_Isend(nasm->sendbuf+ioffset[j],cnt,MPIU_SCALAR,iranks[j],nasm->tag,comm,&nasm->reqs[nranks+j]);CHKERRMPI(ierr);
+  }
+  nasm->nrounds++;
+  nasm->exchanging = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+/*
+   SNESNASMAsyncComplete_Private - Tests (or waits for, if wait is set) the completion of the ghost exchange in progress and copies
+   the received ghost entries into xg once it has completed.
+*/
+static PetscErrorCode SNESNASMAsyncComplete_Private(SNES snes,PetscBool wait)
+{
+  SNES_NASM      *nasm = (SNES_NASM*)snes->data;
+  PetscInt       k,nranks,niranks,nown;
+  const PetscInt *roffset,*rmine,*ioffset;
+  PetscScalar    *x;
+  PetscMPIInt    nreqs,flg = 1;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!nasm->exchanging) PetscFunctionReturn(0);
+  ierr = PetscSFGetRootRanks(nasm->ghostsf,&nranks,NULL,&roffset,&rmine,NULL);CHKERRQ(ierr);
+  ierr = PetscSFGetLeafRanks(nasm->ghostsf,&niranks,NULL,&ioffset,NULL);CHKERRQ(ierr);
+  ierr = PetscMPIIntCast(nranks+niranks,&nreqs);CHKERRQ(ierr);
+  if (wait) {ierr = MPI_Waitall(nreqs,nasm->reqs,MPI_STATUSES_IGNORE);CHKERRMPI(ierr);}
+  else      {ierr = MPI_Testall(nreqs,nasm->reqs,&flg,MPI_STATUSES_IGNORE);CHKERRMPI(ierr);}
+  if (!flg) PetscFunctionReturn(0);
+  ierr = VecGetSize(nasm->xg,&nown);CHKERRQ(ierr);
+  nown -= roffset[nranks];
+  ierr = VecGetArray(nasm->xg,&x);CHKERRQ(ierr);
+  for (k=0; k<roffset[nranks]; k++) x[nown+rmine[k]] = nasm->recvbuf[k];
+  ierr = VecRestoreArray(nasm->xg,&x);CHKERRQ(ierr);
+  nasm->exchanging = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+/*
+   SNESNASMSolveAsync_Private - One asynchronous iteration of restricted NASM.
+
+   Each process sweeps repeatedly over its subdomains, reading the overlap from the ghost entries most recently received and
+   applying the restricted updates to its owned entries right away. A new ghost exchange is posted as soon as the previous one
+   has completed, so no process waits for its neighbors during the sweeps. The norm of the owned part of the subdomain residuals is
+   reduced with a nonblocking reduction running alongside the sweeps; the iteration ends once it is below target or the processes
+   have done asyncsweeps sweeps on average.
+*/
+static PetscErrorCode SNESNASMSolveAsync_Private(SNES snes,Vec B,Vec Y,Vec X,PetscReal target)
+{
+#if defined(PETSC_HAVE_MPI_IALLREDUCE)
+  SNES_NASM         *nasm = (SNES_NASM*)snes->data;
+  MPI_Comm          comm = PetscObjectComm((PetscObject)snes);
+  SNES              subsnes;
+  PetscInt          i,k,nown,sweeps = 0,maxrounds;
+  PetscReal         dmp,fnorm,red[2],gred[2];
+  PetscScalar       *x,*y;
+  const PetscScalar *w;
+  Vec               Xl,Bl,Yl,Xlloc,Fl;
+  DM                dm,subdm;
+  MPI_Request       rreq;
+  PetscMPIInt       size,flg;
+  PetscBool         reducing = PETSC_FALSE,stop = PETSC_FALSE;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (!nasm->xg) {ierr = SNESNASMAsyncSetUp_Private(snes,X);CHKERRQ(ierr);}
+  ierr = MPI_Comm_size(comm,&size);CHKERRMPI(ierr);
+  ierr = SNESGetDM(snes,&dm);CHKERRQ(ierr);
+  ierr = SNESNASMGetDamping(snes,&dmp);CHKERRQ(ierr);
+  ierr = VecGetLocalSize(X,&nown);CHKERRQ(ierr);
+  /* the restriction of the auxiliary data and the right hand side are collective and done once per iteration */
+  if (nasm->eventrestrictinterp) {ierr = PetscLogEventBegin(nasm->eventrestrictinterp,snes,0,0,0);CHKERRQ(ierr);}
+  for (i=0; i<nasm->n; i++) {
+    ierr = SNESGetDM(nasm->subsnes[i],&subdm);CHKERRQ(ierr);
+    ierr = DMSubDomainRestrict(dm,nasm->oscatter[i],nasm->gscatter[i],subdm);CHKERRQ(ierr);
+    if (B) {
+      ierr = VecScatterBegin(nasm->oscatter_copy[i],B,nasm->b[i],INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+      ierr = VecScatterEnd(nasm->oscatter_copy[i],B,nasm->b[i],INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+    }
+  }
+  ierr = VecCopy(X,Y);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(X,&w);CHKERRQ(ierr);
+  ierr = VecGetArray(nasm->xg,&x);CHKERRQ(ierr);
+  ierr = PetscArraycpy(x,w,nown);CHKERRQ(ierr);
+  ierr = VecRestoreArray(nasm->xg,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(X,&w);CHKERRQ(ierr);
+  nasm->nrounds = 0;
+  ierr = SNESNASMAsyncPost_Private(snes);CHKERRQ(ierr);
+  ierr = SNESNASMAsyncComplete_Private(snes,PETSC_TRUE);CHKERRQ(ierr);
+  if (nasm->eventrestrictinterp) {ierr = PetscLogEventEnd(nasm->eventrestrictinterp,snes,0,0,0);CHKERRQ(ierr);}
+
+  while (!stop) {
+    if (nasm->eventsubsolve) {ierr = PetscLogEventBegin(nasm->eventsubsolve,snes,0,0,0);CHKERRQ(ierr);}
+    ierr = VecSet(nasm->yg,0.0);CHKERRQ(ierr);
+    for (i=0; i<nasm->n; i++) {
+      Xl      = nasm->x[i];
+      Xlloc   = nasm->xl[i];
+      Yl      = nasm->y[i];
+      Bl      = B ? nasm->b[i] : NULL;
+      subsnes = nasm->subsnes[i];
+      Fl      = subsnes->vec_func;
+      ierr = VecScatterBegin(nasm->oscatterg[i],nasm->xg,Xl,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+      ierr = VecScatterEnd(nasm->oscatterg[i],nasm->xg,Xl,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+      ierr = VecScatterBegin(nasm->gscatterg[i],nasm->xg,Xlloc,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+      ierr = VecScatterEnd(nasm->gscatterg[i],nasm->xg,Xlloc,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+      /* the residual of the owned rows, as seen from the latest ghost values */
+      ierr = SNESComputeFunction(subsnes,Xl,Fl);CHKERRQ(ierr);
+      if (subsnes->vec_rhs) {ierr = VecAXPY(Fl,1.0,subsnes->vec_rhs);CHKERRQ(ierr);}
+      if (Bl) {ierr = VecAXPY(Fl,-1.0,Bl);CHKERRQ(ierr);}
+      ierr = VecScatterBegin(nasm->iscatterg[i],Fl,nasm->fg,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+      ierr = VecScatterEnd(nasm->iscatterg[i],Fl,nasm->fg,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+      ierr = VecCopy(Xl,Yl);CHKERRQ(ierr);
+      ierr = SNESSolve(subsnes,Bl,Xl);CHKERRQ(ierr);
+      ierr = VecAYPX(Yl,-1.0,Xl);CHKERRQ(ierr);
+      ierr = VecScale(Yl,nasm->damping);CHKERRQ(ierr);
+      ierr = VecScatterBegin(nasm->iscatterg[i],Yl,nasm->yg,ADD_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+      ierr = VecScatterEnd(nasm->iscatterg[i],Yl,nasm->yg,ADD_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+    }
+    if (nasm->eventsubsolve) {ierr = PetscLogEventEnd(nasm->eventsubsolve,snes,0,0,0);CHKERRQ(ierr);}
+    ierr = VecGetArray(nasm->xg,&x);CHKERRQ(ierr);
+    ierr = VecGetArray(nasm->yg,&y);CHKERRQ(ierr);
+    if (nasm->weight_set) {
+      ierr = VecGetArrayRead(nasm->weight,&w);CHKERRQ(ierr);
+      for (k=0; k<nown; k++) x[k] += dmp*w[k]*y[k];
+      ierr = VecRestoreArrayRead(nasm->weight,&w);CHKERRQ(ierr);
+    } else {
+      for (k=0; k<nown; k++) x[k] += dmp*y[k];
+    }
+    ierr = VecRestoreArray(nasm->yg,&y);CHKERRQ(ierr);
+    ierr = VecRestoreArray(nasm->xg,&x);CHKERRQ(ierr);
+    ierr = VecNorm(nasm->fg,NORM_2,&fnorm);CHKERRQ(ierr);
+    sweeps++;
+
+    /* refresh the ghost entries whenever the previous exchange has completed */
+    if (nasm->eventrestrictinterp) {ierr = PetscLogEventBegin(nasm->eventrestrictinterp,snes,0,0,0);CHKERRQ(ierr);}
+    ierr = SNESNASMAsyncComplete_Private(snes,PETSC_FALSE);CHKERRQ(ierr);
+    if (!nasm->exchanging) {ierr = SNESNASMAsyncPost_Private(snes);CHKERRQ(ierr);}
+    if (nasm->eventrestrictinterp) {ierr = PetscLogEventEnd(nasm->eventrestrictinterp,snes,0,0,0);CHKERRQ(ierr);}
+
+    /* all processes see the same completed reductions in the same order, hence stop in the same sweep of their own */
+    if (reducing) {
+      ierr = MPI_Test(&rreq,&flg,MPI_STATUS_IGNORE);CHKERRMPI(ierr);
+      if (flg) {
+        reducing = PETSC_FALSE;
+        if (PetscSqrtReal(gred[0]) <= target || gred[1] >= (PetscReal)size*nasm->asyncsweeps) stop = PETSC_TRUE;
+      }
+    }
+    if (!reducing && !stop) {
+      red[0] = fnorm*fnorm;
+      red[1] = (PetscReal)sweeps;
+      ierr = MPI_Iallreduce(red,gred,2,MPIU_REAL,MPIU_SUM,comm,&rreq);CHKERRMPI(ierr);
+      reducing = PETSC_TRUE;
+    }
+  }
+
+  /* every process posts as many exchanges as the busiest one so that all the messages are matched */
+  ierr = MPIU_Allreduce(&nasm->nrounds,&maxrounds,1,MPIU_INT,MPI_MAX,comm);CHKERRQ(ierr);
+  ierr = SNESNASMAsyncComplete_Private(snes,PETSC_TRUE);CHKERRQ(ierr);
+  while (nasm->nrounds < maxrounds) {
+    ierr = SNESNASMAsyncPost_Private(snes);CHKERRQ(ierr);
+    ierr = SNESNASMAsyncComplete_Private(snes,PETSC_TRUE);CHKERRQ(ierr);
+  }
+  ierr = PetscInfo4(snes,"Asynchronous iteration: %D local sweeps, %D ghost exchanges, estimated residual norm %g after %g sweeps per process\n",sweeps,maxrounds,(double)PetscSqrtReal(gred[0]),(double)(gred[1]/size));CHKERRQ(ierr);
+  ierr = VecGetArray(X,&x);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(nasm->xg,&w);CHKERRQ(ierr);
+  ierr = PetscArraycpy(x,w,nown);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(nasm->xg,&w);CHKERRQ(ierr);
+  ierr = VecRestoreArray(X,&x);CHKERRQ(ierr);
+  ierr = VecAYPX(Y,-1.0,X);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+#else
+  PetscFunctionBegin;
+  SETERRQ(PetscObjectComm((PetscObject)snes),PETSC_ERR_SUP,"Asynchronous SNESNASM requires MPI_Iallreduce()");
+#endif
+}
+
 static PetscErrorCode SNESNASMComputeFinalJacobian_Private(SNES snes, Vec Xfinal)
 {
   Vec            X = Xfinal;
@@ -749,7 +1177,7 @@ static PetscErrorCode SNESSolve_NASM(SNES snes)
   Vec              B;
   Vec              Y;
   PetscInt         i;
-  PetscReal        fnorm = 0.0;
+  PetscReal        fnorm = 0.0,fnorm0;
   PetscErrorCode   ierr;
   SNESNormSchedule normschedule;
   SNES_NASM        *nasm = (SNES_NASM*)snes->data;
@@ -800,9 +1228,15 @@ static PetscErrorCode SNESSolve_NASM(SNES snes)
   }
   /* copy the initial solution over for later */
   if (nasm->fjtype == 2) {ierr = VecCopy(X,nasm->xinit);CHKERRQ(ierr);}
+  fnorm0 = fnorm;
 
   for (i=0; i < snes->max_its; i++) {
-    ierr = SNESNASMSolveLocal_Private(snes,B,Y,X);CHKERRQ(ierr);
+    if (nasm->async) {
+      /* without norms the iterations only end after the given number of sweeps */
+      PetscReal target = normschedule == SNES_NORM_ALWAYS ? PetscMax(snes->abstol,snes->rtol*fnorm0) : 0.0;
+
+      ierr = SNESNASMSolveAsync_Private(snes,B,Y,X,target);CHKERRQ(ierr);
+    } else {ierr = SNESNASMSolveLocal_Private(snes,B,Y,X);CHKERRQ(ierr);}
     if (normschedule == SNES_NORM_ALWAYS || ((i == snes->max_its - 1) && (normschedule == SNES_NORM_INITIAL_FINAL_ONLY || normschedule == SNES_NORM_FINAL_ONLY))) {
       ierr = SNESComputeFunction(snes,X,F);CHKERRQ(ierr);
       ierr = VecNorm(F, NORM_2, &fnorm);CHKERRQ(ierr); /* fnorm <- ||F||  */
@@ -843,6 +1277,8 @@ static PetscErrorCode SNESSolve_NASM(SNES snes)
 .  -snes_asm_damping <dmp> - the new solution is obtained as old solution plus dmp times (sum of the solutions on the subdomains)
 .  -snes_nasm_finaljacobian - compute the local and global jacobians of the final iterate
 .  -snes_nasm_finaljacobian_type <finalinner,finalouter,initial> - pick state the jacobian is calculated at
+.  -snes_nasm_async - sweep over the local subdomains without waiting for the other processes, see SNESNASMSetAsynchronous()
+.  -snes_nasm_async_sweeps <n> - average number of sweeps per process after which an asynchronous iteration ends
 .  -sub_snes_ - options prefix of the subdomain nonlinear solves
 .  -sub_ksp_ - options prefix of the subdomain Krylov solver
 -  -sub_pc_ - options prefix of the subdomain preconditioner
@@ -902,6 +1338,8 @@ PETSC_EXTERN PetscErrorCode SNESCreate_NASM(SNES snes)
 
   nasm->fjtype              = 0;
   nasm->xinit               = NULL;
+  nasm->async               = PETSC_FALSE;
+  nasm->asyncsweeps         = 10;
   nasm->eventrestrictinterp = 0;
   nasm->eventsubsolve       = 0;
 
@@ -918,6 +1356,8 @@ PETSC_EXTERN PetscErrorCode SNESCreate_NASM(SNES snes)
   ierr = PetscObjectComposeFunction((PetscObject)snes,"SNESNASMGetDamping_C",SNESNASMGetDamping_NASM);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)snes,"SNESNASMGetSubdomainVecs_C",SNESNASMGetSubdomainVecs_NASM);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)snes,"SNESNASMSetComputeFinalJacobian_C",SNESNASMSetComputeFinalJacobian_NASM);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)snes,"SNESNASMSetAsynchronous_C",SNESNASMSetAsynchronous_NASM);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)snes,"SNESNASMGetAsynchronous_C",SNESNASMGetAsynchronous_NASM);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
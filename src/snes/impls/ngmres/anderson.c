@@ -13,6 +13,7 @@ static PetscErrorCode SNESSetFromOptions_Anderson(PetscOptionItems *PetscOptions
   ierr = PetscOptionsInt("-snes_anderson_restart",      "Iterations before forced restart", "SNES",ngmres->restart_periodic,&ngmres->restart_periodic,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsInt("-snes_anderson_restart_it",   "Tolerance iterations before restart","SNES",ngmres->restart_it,&ngmres->restart_it,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsEnum("-snes_anderson_restart_type","Restart type","SNESNGMRESSetRestartType",SNESNGMRESRestartTypes,(PetscEnum)ngmres->restart_type,(PetscEnum*)&ngmres->restart_type,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-snes_anderson_single_reduction","Aggregate reductions","SNES",ngmres->singlereduction,&ngmres->singlereduction,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-snes_anderson_monitor",     "Monitor steps of Anderson Mixing","SNES",ngmres->monitor ? PETSC_TRUE : PETSC_FALSE,&monitor,NULL);CHKERRQ(ierr);
   if (monitor) {
     ngmres->monitor = PETSC_VIEWER_STDOUT_(PetscObjectComm((PetscObject)snes));CHKERRQ(ierr);
@@ -184,6 +185,7 @@ static PetscErrorCode SNESSolve_Anderson(SNES snes)
 .  -snes_anderson_restart_type     - Type of restart (see SNESNGMRES)
 .  -snes_anderson_restart_it       - Number of iterations of restart conditions before restart
 .  -snes_anderson_restart          - Number of iterations before periodic restart
+.  -snes_anderson_single_reduction - Keep the Gram matrix of the solution history and compute the differences used by the restart in the reduction of the least squares problem
 -  -snes_anderson_monitor          - Prints relevant information about the ngmres iteration
 
    Notes:
@@ -193,6 +195,10 @@ static PetscErrorCode SNESSolve_Anderson(SNES snes)
 
    Very similar to the SNESNGMRES algorithm.
 
+   With -snes_anderson_single_reduction the differences used by the restart are computed from the inner products of the
+   solution history. They are only accurate relative to the size of the solution, so those smaller than about 1e-3 of the
+   norm of the solution are still computed from the vectors.
+
    References:
 +  1. -  D. G. Anderson. Iterative procedures for nonlinear integral equations.
     J. Assoc. Comput. Mach., 12, 1965."
@@ -27,23 +27,57 @@ PetscErrorCode SNESNGMRESFormCombinedSolution_Private(SNES snes,PetscInt ivec,Pe
   PetscScalar    *xi        = ngmres->xi;
   PetscScalar    alph_total = 0.;
   PetscErrorCode ierr;
+  PetscScalar    xmm = 0.,*xx,*xp;
   PetscReal      nu;
   Vec            Y = snes->work[2];
-  PetscBool      changed_y,changed_w;
+  PetscBool      changed_y,changed_w,accurate = PETSC_FALSE;
 
   PetscFunctionBegin;
   nu = fMnorm*fMnorm;
+  ngmres->dcomputed = PETSC_FALSE;
+  /* the single reduction may be requested after SNESSetUp() */
+  if (ngmres->singlereduction && !ngmres->p) {
+    ierr = PetscCalloc3(ngmres->msize*ngmres->msize,&ngmres->p,ngmres->msize,&ngmres->xx,ngmres->msize,&ngmres->xp);CHKERRQ(ierr);
+    ngmres->prefresh = PETSC_TRUE;
+  }
+  xx = ngmres->xx;
+  xp = ngmres->xp;
 
   /* construct the right hand side and xi factors */
   if (l > 0) {
     ierr = VecMDotBegin(FM,l,Fdot,xi);CHKERRQ(ierr);
     ierr = VecMDotBegin(Fdot[ivec],l,Fdot,beta);CHKERRQ(ierr);
+    if (ngmres->singlereduction) {
+      /* the same products for the solution history, so that no reduction is needed for the differences */
+      ierr = VecMDotBegin(XM,l,Xdot,xx);CHKERRQ(ierr);
+      if (ngmres->prefresh) {
+        /* the rows of the older history vectors were not kept, so all of p is formed again */
+        for (i = 0; i < l; i++) {ierr = VecMDotBegin(Xdot[i],l,Xdot,&P(i,0));CHKERRQ(ierr);}
+      } else {
+        ierr = VecMDotBegin(Xdot[ivec],l,Xdot,xp);CHKERRQ(ierr);
+      }
+      ierr = VecDotBegin(XM,XM,&xmm);CHKERRQ(ierr);
+    }
     ierr = VecMDotEnd(FM,l,Fdot,xi);CHKERRQ(ierr);
     ierr = VecMDotEnd(Fdot[ivec],l,Fdot,beta);CHKERRQ(ierr);
     for (i = 0; i < l; i++) {
       Q(i,ivec) = beta[i];
       Q(ivec,i) = beta[i];
     }
+    if (ngmres->singlereduction) {
+      ierr = VecMDotEnd(XM,l,Xdot,xx);CHKERRQ(ierr);
+      if (ngmres->prefresh) {
+        for (i = 0; i < l; i++) {ierr = VecMDotEnd(Xdot[i],l,Xdot,&P(i,0));CHKERRQ(ierr);}
+        ngmres->prefresh = PETSC_FALSE;
+      } else {
+        ierr = VecMDotEnd(Xdot[ivec],l,Xdot,xp);CHKERRQ(ierr);
+        for (i = 0; i < l; i++) {
+          P(ivec,i) = xp[i];
+          P(i,ivec) = PetscConj(xp[i]);
+        }
+      }
+      ierr = VecDotEnd(XM,XM,&xmm);CHKERRQ(ierr);
+    }
   } else {
     Q(0,0) = ngmres->fnorms[ivec]*ngmres->fnorms[ivec];
   }
@@ -81,6 +115,29 @@ PetscErrorCode SNESNGMRESFormCombinedSolution_Private(SNES snes,PetscInt ivec,Pe
   alph_total = 0.;
   for (i = 0; i < l; i++) alph_total += beta[i];
 
+  if (ngmres->singlereduction) {
+    /* x_A - x_M = sum_i beta_i d_i with d_i = xdot_i - x_M, so the differences follow from the Gram matrix of the d_i */
+    PetscReal   dnorm2 = 0.,dcur2,dtol = 1.e-6*PetscRealPart(xmm);
+    PetscScalar gd;
+
+    for (i = 0; i < l; i++) {
+      for (j = 0; j < l; j++) H(i,j) = P(i,j)-PetscConj(xx[i])-xx[j]+xmm;
+    }
+    for (i = 0; i < l; i++) {
+      for (j = 0; j < l; j++) dnorm2 += PetscRealPart(PetscConj(beta[i])*beta[j]*H(j,i));
+    }
+    ngmres->dnorm = PetscSqrtReal(PetscMax(dnorm2,0.));
+    /* the expanded squares lose about ||x_M||^2 times the machine precision, so small differences are taken from the vectors */
+    accurate = (PetscBool)(dnorm2 >= dtol);
+    for (i = 0; i < l; i++) {
+      gd = 0.;
+      for (j = 0; j < l; j++) gd += PetscConj(beta[j])*H(i,j);
+      dcur2 = PetscRealPart(H(i,i)) - 2.*PetscRealPart(gd) + dnorm2;
+      ngmres->xnorms[i] = PetscSqrtReal(PetscMax(dcur2,0.));
+      if (dcur2 < dtol) accurate = PETSC_FALSE;
+    }
+  } else ngmres->prefresh = PETSC_TRUE;
+
   ierr = VecCopy(XM,XA);CHKERRQ(ierr);
   ierr = VecScale(XA,1.-alph_total);CHKERRQ(ierr);
   ierr = VecMAXPY(XA,l,beta,Xdot);CHKERRQ(ierr);
@@ -88,6 +145,8 @@ PetscErrorCode SNESNGMRESFormCombinedSolution_Private(SNES snes,PetscInt ivec,Pe
   ierr = VecCopy(XA,Y);CHKERRQ(ierr);
   ierr = VecAXPY(Y,-1.0,X);CHKERRQ(ierr);
   ierr = SNESLineSearchPostCheck(snes->linesearch,X,Y,XA,&changed_y,&changed_w);CHKERRQ(ierr);
+  /* a modified combination no longer matches the products */
+  if (accurate && !changed_w) ngmres->dcomputed = PETSC_TRUE;
   if (!ngmres->approxfunc) {
     if (snes->npc && snes->npcside== PC_LEFT) {
       ierr = SNESApplyNPC(snes,XA,NULL,FA);CHKERRQ(ierr);
@@ -133,12 +192,12 @@ PetscErrorCode SNESNGMRESNorms_Private(SNES snes,PetscInt l,Vec X,Vec F,Vec XM,V
     ierr = VecAXPY(D,-1.0,XA);CHKERRQ(ierr);
     ierr = VecNormBegin(D,NORM_2,yAnorm);CHKERRQ(ierr);
   }
-  if (dnorm) {
+  if (dnorm && !ngmres->dcomputed) {
     ierr = VecCopy(XA,D);CHKERRQ(ierr);
     ierr = VecAXPY(D,-1.0,XM);CHKERRQ(ierr);
     ierr = VecNormBegin(D,NORM_2,dnorm);CHKERRQ(ierr);
   }
-  if (dminnorm) {
+  if (dminnorm && !ngmres->dcomputed) {
     for (i=0; i<l; i++) {
       ierr = VecCopy(Xdot[i],D);CHKERRQ(ierr);
       ierr = VecAXPY(D,-1.0,XA);CHKERRQ(ierr);
@@ -151,10 +210,13 @@ PetscErrorCode SNESNGMRESNorms_Private(SNES snes,PetscInt l,Vec X,Vec F,Vec XM,V
   if (xAnorm) {ierr = VecNormEnd(XA,NORM_2,xAnorm);CHKERRQ(ierr);}
   if (fAnorm) {ierr = VecNormEnd(FA,NORM_2,fAnorm);CHKERRQ(ierr);}
   if (yAnorm) {ierr = VecNormEnd(D,NORM_2,yAnorm);CHKERRQ(ierr);}
-  if (dnorm) {ierr = VecNormEnd(D,NORM_2,dnorm);CHKERRQ(ierr);}
+  if (dnorm) {
+    if (ngmres->dcomputed) *dnorm = ngmres->dnorm;
+    else {ierr = VecNormEnd(D,NORM_2,dnorm);CHKERRQ(ierr);}
+  }
   if (dminnorm) {
     for (i=0; i<l; i++) {
-      ierr = VecNormEnd(D,NORM_2,&ngmres->xnorms[i]);CHKERRQ(ierr);
+      if (!ngmres->dcomputed) {ierr = VecNormEnd(D,NORM_2,&ngmres->xnorms[i]);CHKERRQ(ierr);}
       dcurnorm = ngmres->xnorms[i];
       if ((dcurnorm < dmin) || (dmin < 0.0)) dmin = dcurnorm;
     }
@@ -26,6 +26,7 @@ PetscErrorCode SNESDestroy_NGMRES(SNES snes)
   ierr = SNESReset_NGMRES(snes);CHKERRQ(ierr);
   ierr = PetscFree4(ngmres->h,ngmres->beta,ngmres->xi,ngmres->q);CHKERRQ(ierr);
   ierr = PetscFree3(ngmres->xnorms,ngmres->fnorms,ngmres->s);CHKERRQ(ierr);
+  ierr = PetscFree3(ngmres->p,ngmres->xx,ngmres->xp);CHKERRQ(ierr);
 #if defined(PETSC_USE_COMPLEX)
   ierr = PetscFree(ngmres->rwork);CHKERRQ(ierr);
 #endif
@@ -136,6 +137,7 @@ PetscErrorCode SNESView_NGMRES(SNES snes,PetscViewer viewer)
     ierr = PetscViewerASCIIPrintf(viewer,"  Residual selection: gammaA=%1.0e, gammaC=%1.0e\n",ngmres->gammaA,ngmres->gammaC);CHKERRQ(ierr);
     ierr = PetscViewerASCIIPrintf(viewer,"  Difference restart: epsilonB=%1.0e, deltaB=%1.0e\n",ngmres->epsilonB,ngmres->deltaB);CHKERRQ(ierr);
     ierr = PetscViewerASCIIPrintf(viewer,"  Restart on F_M residual increase: %s\n",ngmres->restart_fm_rise?"TRUE":"FALSE");CHKERRQ(ierr);
+    if (ngmres->singlereduction) {ierr = PetscViewerASCIIPrintf(viewer,"  Using a single reduction for the residual and solution histories\n");CHKERRQ(ierr);}
   }
   PetscFunctionReturn(0);
 }
@@ -490,6 +492,7 @@ PetscErrorCode SNESNGMRESSetRestartType_NGMRES(SNES snes,SNESNGMRESRestartType r
 .  -snes_ngmres_epsilonB         - Difference tolerance between subsequent solutions triggering restart
 .  -snes_ngmres_deltaB           - Difference tolerance between residuals triggering restart
 .  -snes_ngmres_restart_fm_rise  - Restart on residual rise from x_M step
+.  -snes_ngmres_single_reduction - Keep the Gram matrix of the solution history and compute the differences used by the selection and restart in the reduction of the least squares problem
 .  -snes_ngmres_monitor          - Prints relevant information about the ngmres iteration
 .  -snes_linesearch_type <basic,l2,cp> - Line search type used for the default smoother
 -  -additive_snes_linesearch_type - linesearch type used to select between the candidate and combined solution with additive select type
@@ -501,6 +504,11 @@ PetscErrorCode SNESNGMRESSetRestartType_NGMRES(SNES snes,SNESNGMRESRestartType r
 
    Very similar to the SNESANDERSON algorithm.
 
+   With -snes_ngmres_single_reduction the inner products of the solution history are maintained with those of the residual
+   history, and the differences used by the selection and restart are computed from them rather than from the vectors. This
+   saves a pass over the history and its reductions. Since the differences are then only accurate relative to the size of the
+   solution, those smaller than about 1e-3 of the norm of the solution are still computed from the vectors.
+
    References:
 +  1. - C. W. Oosterlee and T. Washio, "Krylov Subspace Acceleration of Nonlinear Multigrid with Application to Recirculating Flows",
    SIAM Journal on Scientific Computing, 21(5), 2000.
@@ -43,6 +43,12 @@ typedef struct {
 
   /* Least squares minimization solve context */
   PetscScalar  *q;             /* the matrix formed as q_ij = (rdot_i, rdot_j) */
+  PetscScalar  *p;             /* the matrix formed as p_ij = (xdot_i, xdot_j), kept with the single reduction */
+  PetscScalar  *xx;            /* the dot-product of the current and previous solutions */
+  PetscScalar  *xp;            /* the row of p being updated */
+  PetscBool    prefresh;       /* p is out of date and must be formed from the whole history */
+  PetscBool    dcomputed;      /* dnorm and the history distances were obtained from p in the last combination */
+  PetscReal    dnorm;          /* ||x_A - x_M|| from the last combination */
   PetscBLASInt m;              /* matrix dimension */
   PetscBLASInt n;              /* matrix dimension */
   PetscBLASInt nrhs;           /* the number of right hand sides */
@@ -61,6 +67,7 @@ typedef struct {
 
 #define H(i,j)  ngmres->h[i*ngmres->msize + j]
 #define Q(i,j)  ngmres->q[i*ngmres->msize + j]
+#define P(i,j)  ngmres->p[i*ngmres->msize + j]
 
 /* private functions that are shared components of the methods */
 PETSC_INTERN PetscErrorCode SNESNGMRESUpdateSubspace_Private(SNES,PetscInt,PetscInt,Vec,PetscReal,Vec);
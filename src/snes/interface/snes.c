@@ -428,15 +428,19 @@ PetscErrorCode  SNESView(SNES snes,PetscViewer viewer)
         ierr = PetscViewerASCIIPrintf(viewer,"    gamma=%g, alpha=%g, alpha2=%g\n",(double)kctx->gamma,(double)kctx->alpha,(double)kctx->alpha2);CHKERRQ(ierr);
       }
     }
-    if (snes->lagpreconditioner == -1) {
-      ierr = PetscViewerASCIIPrintf(viewer,"  Preconditioned is never rebuilt\n");CHKERRQ(ierr);
-    } else if (snes->lagpreconditioner > 1) {
-      ierr = PetscViewerASCIIPrintf(viewer,"  Preconditioned is rebuilt every %D new Jacobians\n",snes->lagpreconditioner);CHKERRQ(ierr);
-    }
-    if (snes->lagjacobian == -1) {
-      ierr = PetscViewerASCIIPrintf(viewer,"  Jacobian is never rebuilt\n");CHKERRQ(ierr);
-    } else if (snes->lagjacobian > 1) {
-      ierr = PetscViewerASCIIPrintf(viewer,"  Jacobian is rebuilt every %D SNES iterations\n",snes->lagjacobian);CHKERRQ(ierr);
+    if (snes->lagadaptive) {
+      ierr = PetscViewerASCIIPrintf(viewer,"  Jacobian and preconditioner are rebuilt adaptively from the measured costs and residual reductions\n");CHKERRQ(ierr);
+    } else {
+      if (snes->lagpreconditioner == -1) {
+        ierr = PetscViewerASCIIPrintf(viewer,"  Preconditioned is never rebuilt\n");CHKERRQ(ierr);
+      } else if (snes->lagpreconditioner > 1) {
+        ierr = PetscViewerASCIIPrintf(viewer,"  Preconditioned is rebuilt every %D new Jacobians\n",snes->lagpreconditioner);CHKERRQ(ierr);
+      }
+      if (snes->lagjacobian == -1) {
+        ierr = PetscViewerASCIIPrintf(viewer,"  Jacobian is never rebuilt\n");CHKERRQ(ierr);
+      } else if (snes->lagjacobian > 1) {
+        ierr = PetscViewerASCIIPrintf(viewer,"  Jacobian is rebuilt every %D SNES iterations\n",snes->lagjacobian);CHKERRQ(ierr);
+      }
     }
     ierr = SNESGetDM(snes,&dm);CHKERRQ(ierr);
     ierr = DMSNESGetJacobian(dm,&cJ,&ctx);CHKERRQ(ierr);
@@ -954,6 +958,11 @@ PetscErrorCode  SNESSetFromOptions(SNES snes)
   if (flg) {
     ierr = SNESSetLagJacobianPersists(snes,persist);CHKERRQ(ierr);
   }
+  ierr = PetscOptionsBool("-snes_lag_adaptive","Decide from the measured costs and residual reductions when to rebuild the Jacobian and preconditioner","SNESSetLagAdaptive",snes->lagadaptive,&snes->lagadaptive,NULL);CHKERRQ(ierr);
+  snes->lagadapt.ncosts = 4;
+  ierr = PetscOptionsRealArray("-snes_lag_adaptive_costs","Times of a Jacobian evaluation, a preconditioner setup, a step and a linear iteration used instead of the measured ones (for testing)","SNESSetLagAdaptive",snes->lagadapt.costs,&snes->lagadapt.ncosts,&flg);CHKERRQ(ierr);
+  if (flg && snes->lagadapt.ncosts != 4) SETERRQ1(PetscObjectComm((PetscObject)snes),PETSC_ERR_ARG_WRONG,"-snes_lag_adaptive_costs needs 4 values, not %D",snes->lagadapt.ncosts);
+  if (!flg) snes->lagadapt.ncosts = 0;
 
   ierr = PetscOptionsInt("-snes_grid_sequence","Use grid sequencing to generate initial guess","SNESSetGridSequence",snes->gridsequence,&grids,&flg);CHKERRQ(ierr);
   if (flg) {
@@ -1740,6 +1749,7 @@ PetscErrorCode  SNESCreate(MPI_Comm comm,SNES *outsnes)
   snes->lagpreconditioner = 1;
   snes->pre_iter          = 0;
   snes->lagpre_persist    = PETSC_FALSE;
+  snes->lagadaptive       = PETSC_FALSE;
   snes->numbermonitors    = 0;
   snes->numberreasonviews = 0;
   snes->data              = NULL;
@@ -2729,6 +2739,84 @@ PetscErrorCode SNESTestJacobian(SNES snes)
   PetscFunctionReturn(0);
 }
 
+/*
+   Decides whether the Jacobian and the preconditioner are rebuilt at the current iterate.
+
+   The time of each step, from the end of one decision to the next (the preconditioner setup, the linear solve and the
+   function evaluations), and of each Jacobian evaluation is measured with PetscTime() and reduced to its maximum over
+   the processes, so that they all take the same decision. The Jacobian is reused when the
+   predicted reduction of the logarithm of the residual norm per unit of time of a step with the current Jacobian is at
+   least that of a step with a new Jacobian, whose time includes the evaluation of the Jacobian.
+
+   The reduction with a new Jacobian is predicted from the last step with a new Jacobian assuming quadratic convergence,
+   which favors rebuilding in the damped phase of Newton's method. The reduction of the first step with a reused Jacobian
+   is predicted with the degradation observed the last time a Jacobian was reused in this solve (initially none, so it
+   is tried once when the Jacobian is at least as expensive as the step), and that of later steps by the reduction of
+   the previous step. When the Jacobian is rebuilt, the preconditioner is only rebuilt once the linear iterations added by
+   reusing it, at the measured time per iteration, have cost more than its setup.
+*/
+static PetscErrorCode SNESLagAdaptiveDecide_Private(SNES snes,PetscBool *rebuildjac,PetscBool *rebuildpc)
+{
+  SNESLagAdaptive *la = &snes->lagadapt;
+  PetscLogDouble  now,step,setup,t[2],tmax[2];
+  PetscReal       fnorm = snes->norm,r,reuse,fresh;
+  PetscInt        its;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscTime(&now);CHKERRQ(ierr);
+  *rebuildjac = PETSC_TRUE;
+  *rebuildpc  = PETSC_TRUE;
+  /* the first Jacobian of each solve is always computed, and without residual norms there is nothing to measure */
+  if (snes->iter && fnorm > 0.0 && la->fnorm > 0.0) {
+    /* all processes must take the same decision, so they use the times of the slowest process */
+    t[0] = now - la->tstamp;
+    t[1] = la->tjac;
+    ierr = MPIU_Allreduce(t,tmax,2,MPIU_PETSCLOGDOUBLE,MPI_MAX,PetscObjectComm((PetscObject)snes));CHKERRMPI(ierr);
+    step     = tmax[0];
+    la->tjac = tmax[1];
+    its      = snes->linear_its - la->its;
+    if (la->ncosts) { /* reproducible decisions for testing */
+      la->tjac = la->costs[0];
+      step     = (la->newpc ? la->costs[1] : 0.0) + la->costs[2] + its*la->costs[3];
+    }
+    if (la->newpc) {
+      la->tpc   = step;
+      la->pcits = its;
+      la->extra = 0;
+    } else {
+      if (its > 0) la->titer = step/its;
+      la->extra += its - la->pcits;
+    }
+    if (fnorm < la->fnorm && step > 0.0) {
+      r = PetscLogReal(la->fnorm/fnorm);
+      if (la->fresh) {
+        la->ffresh = la->fnorm;
+        la->rfresh = r;
+        la->tfresh = la->tjac + step;
+        reuse      = la->degrade*r/step;
+      } else {
+        if (la->measure) la->degrade = r/la->rfresh;
+        reuse = r/step;
+      }
+      fresh       = (la->rfresh + PetscLogReal(la->ffresh/fnorm))/la->tfresh;
+      *rebuildjac = reuse >= fresh ? PETSC_FALSE : PETSC_TRUE;
+      ierr = PetscInfo2(snes,"Predicted residual reduction rate %g with the current Jacobian, %g with a new one\n",(double)reuse,(double)fresh);CHKERRQ(ierr);
+    } else if (la->measure) la->degrade = 0.0;
+    if (la->titer > 0.0) {
+      setup      = PetscMax(la->tpc - la->pcits*la->titer,0.0);
+      *rebuildpc = la->extra*la->titer >= setup ? PETSC_TRUE : PETSC_FALSE;
+    }
+  } else la->degrade = 1.0; /* try to reuse the Jacobian once in each solve to measure the degradation */
+  la->measure = (!*rebuildjac && la->fresh) ? PETSC_TRUE : PETSC_FALSE;
+  la->fnorm   = fnorm;
+  la->its     = snes->linear_its;
+  la->fresh   = *rebuildjac;
+  la->newpc   = (*rebuildjac && *rebuildpc) ? PETSC_TRUE : PETSC_FALSE;
+  ierr = PetscInfo1(snes,"%s Jacobian from the adaptive lagging\n",*rebuildjac ? "Recomputing" : "Reusing");CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@
    SNESComputeJacobian - Computes the Jacobian matrix that has been set with SNESSetJacobian().
 
@@ -2745,6 +2833,7 @@ PetscErrorCode SNESTestJacobian(SNES snes)
   Options Database Keys:
 +    -snes_lag_preconditioner <lag>
 .    -snes_lag_jacobian <lag>
+.    -snes_lag_adaptive - decide when to rebuild the Jacobian and preconditioner from the measured costs, see SNESSetLagAdaptive()
 .    -snes_test_jacobian <optional threshold> - compare the user provided Jacobian with one compute via finite differences to check for errors.  If a threshold is given, display only those entries whose difference is greater than the threshold.
 .    -snes_test_jacobian_view - display the user provided Jacobian, the finite difference Jacobian and the difference between them to help users detect the location of errors in the user provided Jacobian
 .    -snes_compare_explicit - Compare the computed Jacobian to the finite difference Jacobian and output the differences
@@ -2774,7 +2863,8 @@ PetscErrorCode SNESTestJacobian(SNES snes)
 PetscErrorCode  SNESComputeJacobian(SNES snes,Vec X,Mat A,Mat B)
 {
   PetscErrorCode ierr;
-  PetscBool      flag;
+  PetscBool      flag,rebuildjac = PETSC_TRUE,rebuildpc = PETSC_TRUE;
+  PetscLogDouble tjac = 0.0;
   DM             dm;
   DMSNES         sdm;
   KSP            ksp;
@@ -2791,7 +2881,18 @@ PetscErrorCode  SNESComputeJacobian(SNES snes,Vec X,Mat A,Mat B)
 
   /* make sure that MatAssemblyBegin/End() is called on A matrix if it is matrix free */
 
-  if (snes->lagjacobian == -2) {
+  if (snes->lagadaptive) {
+    ierr = SNESLagAdaptiveDecide_Private(snes,&rebuildjac,&rebuildpc);CHKERRQ(ierr);
+    if (!rebuildjac) {
+      ierr = PetscObjectTypeCompare((PetscObject)A,MATMFFD,&flag);CHKERRQ(ierr);
+      if (flag) {
+        ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+        ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+      }
+      ierr = PetscTime(&snes->lagadapt.tstamp);CHKERRQ(ierr);
+      PetscFunctionReturn(0);
+    }
+  } else if (snes->lagjacobian == -2) {
     snes->lagjacobian = -1;
 
     ierr = PetscInfo(snes,"Recomputing Jacobian/preconditioner because lag is -2 (means compute Jacobian, but then never again) \n");CHKERRQ(ierr);
@@ -2818,6 +2919,7 @@ PetscErrorCode  SNESComputeJacobian(SNES snes,Vec X,Mat A,Mat B)
     PetscFunctionReturn(0);
   }
 
+  if (snes->lagadaptive) {ierr = PetscTime(&tjac);CHKERRQ(ierr);}
   ierr = PetscLogEventBegin(SNES_JacobianEval,snes,X,A,B);CHKERRQ(ierr);
   ierr = VecLockReadPush(X);CHKERRQ(ierr);
   PetscStackPush("SNES user Jacobian function");
@@ -2831,7 +2933,12 @@ PetscErrorCode  SNESComputeJacobian(SNES snes,Vec X,Mat A,Mat B)
 
   /* the next line ensures that snes->ksp exists */
   ierr = SNESGetKSP(snes,&ksp);CHKERRQ(ierr);
-  if (snes->lagpreconditioner == -2) {
+  if (snes->lagadaptive) {
+    ierr = PetscInfo1(snes,"%s preconditioner from the adaptive lagging\n",rebuildpc ? "Rebuilding" : "Reusing");CHKERRQ(ierr);
+    ierr = KSPSetReusePreconditioner(snes->ksp,rebuildpc ? PETSC_FALSE : PETSC_TRUE);CHKERRQ(ierr);
+    ierr = PetscTime(&snes->lagadapt.tstamp);CHKERRQ(ierr);
+    snes->lagadapt.tjac = snes->lagadapt.tstamp - tjac;
+  } else if (snes->lagpreconditioner == -2) {
     ierr = PetscInfo(snes,"Rebuilding preconditioner exactly once since lag is -2\n");CHKERRQ(ierr);
     ierr = KSPSetReusePreconditioner(snes->ksp,PETSC_FALSE);CHKERRQ(ierr);
     snes->lagpreconditioner = -1;
@@ -3663,6 +3770,73 @@ PetscErrorCode  SNESSetLagJacobianPersists(SNES snes,PetscBool flg)
   PetscFunctionReturn(0);
 }
 
+/*@
+   SNESSetLagAdaptive - Lets the nonlinear solver decide at each iteration whether to rebuild the Jacobian, only the preconditioner, or neither
+
+   Logically Collective on SNES
+
+   Input Parameters:
++  snes - the SNES context
+-  flg - PETSC_TRUE to decide adaptively
+
+   Options Database Keys:
++    -snes_lag_adaptive <true,false> - decide adaptively
+-    -snes_lag_adaptive_costs <jac,pc,step,iter> - use these times instead of the measured ones, for testing
+
+   Notes:
+   The time of each nonlinear step and of each Jacobian evaluation is measured with PetscTime(), so this does not
+   require -log_view; the maximum over the processes is used. The Jacobian is reused as long as the predicted reduction
+   of the logarithm of the residual norm per unit of time of a step with the current Jacobian is at least that of a step
+   with a new Jacobian, whose time includes the evaluation of the Jacobian. The reduction with a new Jacobian is
+   predicted from the last step taken with a new Jacobian assuming quadratic convergence, and the reduction with the
+   current Jacobian from the previous step (for the first reuse, from the degradation observed the last time the
+   Jacobian was reused in this solve). When a new Jacobian is computed, the preconditioner is rebuilt only when the extra
+   linear iterations caused by reusing it have cost more than its setup.
+
+   The Jacobian is always computed at the first iteration of each nonlinear solve. The decisions require the residual
+   norms of the iterates, so with SNESSetNormSchedule() other than SNES_NORM_ALWAYS everything is rebuilt at each
+   iteration. This overrides SNESSetLagJacobian() and SNESSetLagPreconditioner(). Since the decisions depend on measured
+   times, the iteration counts may differ between runs; -snes_lag_adaptive_costs <jac,pc,step,iter> replaces the
+   measurements by the given times of a Jacobian evaluation, a preconditioner setup, the rest of a step and a linear
+   iteration, which makes the decisions reproducible.
+
+   Level: intermediate
+
+.seealso: SNESGetLagAdaptive(), SNESSetLagJacobian(), SNESSetLagPreconditioner(), KSPSetReusePreconditioner()
+@*/
+PetscErrorCode  SNESSetLagAdaptive(SNES snes,PetscBool flg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(snes,SNES_CLASSID,1);
+  PetscValidLogicalCollectiveBool(snes,flg,2);
+  snes->lagadaptive = flg;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   SNESGetLagAdaptive - Indicates whether the Jacobian and preconditioner are rebuilt adaptively
+
+   Not Collective
+
+   Input Parameter:
+.  snes - the SNES context
+
+   Output Parameter:
+.  flg - PETSC_TRUE if they are rebuilt adaptively
+
+   Level: intermediate
+
+.seealso: SNESSetLagAdaptive()
+@*/
+PetscErrorCode  SNESGetLagAdaptive(SNES snes,PetscBool *flg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(snes,SNES_CLASSID,1);
+  PetscValidBoolPointer(flg,2);
+  *flg = snes->lagadaptive;
+  PetscFunctionReturn(0);
+}
+
 /*@
    SNESSetLagPreconditionerPersists - Set whether or not the preconditioner lagging persists through multiple nonlinear solves
 
@@ -0,0 +1,192 @@
+static char help[] = "Tests the DMDA-aware finite difference Jacobian of DMDASNESSetFDColoringLocal() against MatFDColoring.\n\n";
+
+/*
+   F(u)_c = kappa (Laplacian u_c + u_c,xy) + u_c^2 u_c+1 + sin(u_c-1)    on [0,1]^dim,
+
+   with second (-s 1) or fourth (-s 2) order differences, the mixed derivative only for box stencils,
+   and zero Dirichlet, ghosted or periodic boundary conditions.
+
+   Run with -bench <n> to time n Jacobian evaluations with either method.
+*/
+
+#include <petscdmda.h>
+#include <petscsnes.h>
+
+typedef struct {
+  PetscReal       kappa;
+  PetscInt        s;
+  DMDAStencilType st;
+} AppCtx;
+
+/* value at a grid point, zero outside a non-periodic domain */
+static PetscScalar Val(DMDALocalInfo *info,void *x,PetscInt i,PetscInt j,PetscInt k,PetscInt c)
+{
+  if (info->bx != DM_BOUNDARY_PERIODIC && (i < 0 || i >= info->mx)) return 0.0;
+  if (info->dim > 1 && info->by != DM_BOUNDARY_PERIODIC && (j < 0 || j >= info->my)) return 0.0;
+  if (info->dim > 2 && info->bz != DM_BOUNDARY_PERIODIC && (k < 0 || k >= info->mz)) return 0.0;
+  if (info->dim == 1) return ((PetscScalar*)x)[i*info->dof+c];
+  if (info->dim == 2) return ((PetscScalar**)x)[j][i*info->dof+c];
+  return ((PetscScalar***)x)[k][j][i*info->dof+c];
+}
+
+static PetscErrorCode FormFunctionLocal(DMDALocalInfo *info,void *x,void *f,void *ctx)
+{
+  AppCtx          *user = (AppCtx*)ctx;
+  const PetscReal w1[] = {1.0,-2.0},w2[] = {-1.0/12,4.0/3,-5.0/2};
+  const PetscReal *wt = user->s == 1 ? w1 : w2;
+  const PetscInt  s = user->s,n[3] = {info->mx,info->my,info->mz},dof = info->dof;
+  PetscInt        i,j,k,c,d,q;
+
+  PetscFunctionBeginUser;
+  for (k = info->zs; k < info->zs+info->zm; ++k) {
+    for (j = info->ys; j < info->ys+info->ym; ++j) {
+      for (i = info->xs; i < info->xs+info->xm; ++i) {
+        for (c = 0; c < dof; ++c) {
+          PetscScalar u = Val(info,x,i,j,k,c),lap = 0.0,r;
+
+          for (d = 0; d < info->dim; ++d) {
+            PetscReal   h2 = 1.0/(PetscReal)(n[d]*n[d]);
+            PetscScalar v  = wt[s]*u;
+
+            for (q = 1; q <= s; ++q) {
+              PetscInt o[3] = {0,0,0};
+
+              o[d] = q;
+              v   += wt[s-q]*(Val(info,x,i+o[0],j+o[1],k+o[2],c) + Val(info,x,i-o[0],j-o[1],k-o[2],c));
+            }
+            lap += v/h2;
+          }
+          if (info->dim > 1 && user->st == DMDA_STENCIL_BOX) lap += 0.25*info->mx*info->my*(Val(info,x,i+1,j+1,k,c) - Val(info,x,i+1,j-1,k,c) - Val(info,x,i-1,j+1,k,c) + Val(info,x,i-1,j-1,k,c));
+          if (info->dim > 2 && user->st == DMDA_STENCIL_BOX) lap += 0.25*info->my*info->mz*(Val(info,x,i,j+1,k+1,c) - Val(info,x,i,j+1,k-1,c) - Val(info,x,i,j-1,k+1,c) + Val(info,x,i,j-1,k-1,c));
+          r = user->kappa*lap + u*u*Val(info,x,i,j,k,(c+1)%dof) + PetscSinScalar(Val(info,x,i,j,k,(c+dof-1)%dof));
+          if (info->dim == 1)      ((PetscScalar*)f)[i*dof+c] = r;
+          else if (info->dim == 2) ((PetscScalar**)f)[j][i*dof+c] = r;
+          else                     ((PetscScalar***)f)[k][j][i*dof+c] = r;
+        }
+      }
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode ComputeJacobian(DM da,PetscBool fdlocal,Vec X,PetscInt bench,AppCtx *user,Mat *J)
+{
+  SNES           snes;
+  PetscInt       i;
+  PetscLogDouble t0,t1;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = DMDASNESSetFunctionLocal(da,INSERT_VALUES,FormFunctionLocal,user);CHKERRQ(ierr);
+  ierr = DMDASNESSetFDColoringLocal(da,fdlocal);CHKERRQ(ierr);
+  ierr = SNESCreate(PETSC_COMM_WORLD,&snes);CHKERRQ(ierr);
+  ierr = SNESSetDM(snes,da);CHKERRQ(ierr);
+  ierr = DMCreateMatrix(da,J);CHKERRQ(ierr);
+  /* evaluate at another state first, so that the comparison also checks that every entry gets replaced */
+  ierr = VecScale(X,2.0);CHKERRQ(ierr);
+  ierr = SNESComputeJacobian(snes,X,*J,*J);CHKERRQ(ierr);
+  ierr = VecScale(X,0.5);CHKERRQ(ierr);
+  ierr = SNESComputeJacobian(snes,X,*J,*J);CHKERRQ(ierr);
+  if (bench) {
+    ierr = PetscTime(&t0);CHKERRQ(ierr);
+    for (i = 0; i < bench; ++i) {ierr = SNESComputeJacobian(snes,X,*J,*J);CHKERRQ(ierr);}
+    ierr = PetscTime(&t1);CHKERRQ(ierr);
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"%s: %g s per Jacobian\n",fdlocal ? "DMDA finite differences" : "MatFDColoring",(t1-t0)/bench);CHKERRQ(ierr);
+  }
+  ierr = SNESDestroy(&snes);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode CreateDA(PetscInt dim,DMBoundaryType bt,DMDAStencilType st,PetscInt n,PetscInt dof,PetscInt s,DM *da)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  if (dim == 1)      {ierr = DMDACreate1d(PETSC_COMM_WORLD,bt,n,dof,s,NULL,da);CHKERRQ(ierr);}
+  else if (dim == 2) {ierr = DMDACreate2d(PETSC_COMM_WORLD,bt,bt,st,n,n,PETSC_DECIDE,PETSC_DECIDE,dof,s,NULL,NULL,da);CHKERRQ(ierr);}
+  else               {ierr = DMDACreate3d(PETSC_COMM_WORLD,bt,bt,bt,st,n,n,n,PETSC_DECIDE,PETSC_DECIDE,PETSC_DECIDE,dof,s,NULL,NULL,NULL,da);CHKERRQ(ierr);}
+  ierr = DMSetFromOptions(*da);CHKERRQ(ierr);
+  ierr = DMSetUp(*da);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  DM              da1,da2;
+  DMBoundaryType  bt = DM_BOUNDARY_NONE;
+  Mat             J1,J2;
+  Vec             X;
+  PetscRandom     rnd;
+  AppCtx          user;
+  PetscInt        dim = 2,n = 15,dof = 2,bench = 0;
+  PetscBool       star = PETSC_FALSE;
+  PetscReal       nrm,err;
+  PetscErrorCode  ierr;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  user.kappa = 0.01;
+  user.s     = 1;
+  user.st    = DMDA_STENCIL_BOX;
+  ierr = PetscOptionsBegin(PETSC_COMM_WORLD,NULL,"DMDA finite difference Jacobian test","SNES");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-dim","The dimension","ex70.c",dim,&dim,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-n","The number of nodes in each direction","ex70.c",n,&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-dof","The number of components","ex70.c",dof,&dof,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsRangeInt("-s","The stencil width","ex70.c",user.s,&user.s,NULL,1,2);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-star","Use a star stencil","ex70.c",star,&star,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnum("-boundary","The boundary type","ex70.c",DMBoundaryTypes,(PetscEnum)bt,(PetscEnum*)&bt,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-bench","The number of timed Jacobian evaluations","ex70.c",bench,&bench,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();CHKERRQ(ierr);
+  if (star) user.st = DMDA_STENCIL_STAR;
+
+  ierr = CreateDA(dim,bt,user.st,n,dof,user.s,&da1);CHKERRQ(ierr);
+  ierr = CreateDA(dim,bt,user.st,n,dof,user.s,&da2);CHKERRQ(ierr);
+  ierr = DMCreateGlobalVector(da1,&X);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rnd);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rnd);CHKERRQ(ierr);
+  ierr = VecSetRandom(X,rnd);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rnd);CHKERRQ(ierr);
+
+  ierr = ComputeJacobian(da1,PETSC_FALSE,X,bench,&user,&J1);CHKERRQ(ierr);
+  ierr = ComputeJacobian(da2,PETSC_TRUE,X,bench,&user,&J2);CHKERRQ(ierr);
+  ierr = MatNorm(J1,NORM_FROBENIUS,&nrm);CHKERRQ(ierr);
+  ierr = MatAXPY(J2,-1.0,J1,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+  ierr = MatNorm(J2,NORM_FROBENIUS,&err);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"DMDA finite difference Jacobian %s MatFDColoring\n",err <= 1e-10*nrm ? "matches" : "DIFFERS from");CHKERRQ(ierr);
+
+  ierr = MatDestroy(&J1);CHKERRQ(ierr);
+  ierr = MatDestroy(&J2);CHKERRQ(ierr);
+  ierr = VecDestroy(&X);CHKERRQ(ierr);
+  ierr = DMDestroy(&da1);CHKERRQ(ierr);
+  ierr = DMDestroy(&da2);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+  test:
+    suffix: 1d
+    nsize: {{1 3}}
+    args: -dim 1 -n 30 -s {{1 2}} -boundary {{none ghosted periodic}}
+
+  test:
+    suffix: 2d
+    nsize: {{1 4}}
+    args: -star {{0 1}} -s {{1 2}} -boundary {{none periodic}} -da_snes_fd_color_local_planes {{1 4}}
+
+  test:
+    suffix: 3d
+    nsize: {{1 8}}
+    args: -dim 3 -n 6 -dof 3 -star {{0 1}} -boundary {{none periodic}}
+
+  test:
+    suffix: 3d_star
+    nsize: 2
+    args: -dim 3 -n 21 -dof 1 -star -boundary periodic -dm_mat_type baij
+
+  test:
+    suffix: ds
+    nsize: 2
+    args: -dof 3 -mat_fd_type ds
+
+TEST*/
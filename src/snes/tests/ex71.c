@@ -0,0 +1,127 @@
+static char help[] = "Tests SNESNASM with several subdomains per process given with SNESNASMSetSubdomains().\n\
+  -nsub <n> : number of subdomains on each process\n\n";
+
+/*
+   The Bratu problem -Laplacian u - lambda exp(u) = 0 on the unit square with zero Dirichlet conditions,
+   solved with NASM and compared with the Newton solution.
+*/
+
+#include <petscdmda.h>
+#include <petscsnes.h>
+
+static PetscErrorCode FormFunctionLocal(DMDALocalInfo *info,PetscScalar **x,PetscScalar **f,void *ctx)
+{
+  PetscReal   lambda = *(PetscReal*)ctx,hx = 1.0/(info->mx-1),hy = 1.0/(info->my-1);
+  PetscScalar u,uxx,uyy;
+  PetscInt    i,j;
+
+  PetscFunctionBeginUser;
+  for (j=info->ys; j<info->ys+info->ym; j++) {
+    for (i=info->xs; i<info->xs+info->xm; i++) {
+      if (i == 0 || j == 0 || i == info->mx-1 || j == info->my-1) {f[j][i] = x[j][i]; continue;}
+      u       = x[j][i];
+      uxx     = (2.0*u - x[j][i-1] - x[j][i+1])*hy/hx;
+      uyy     = (2.0*u - x[j-1][i] - x[j+1][i])*hx/hy;
+      f[j][i] = uxx + uyy - hx*hy*lambda*PetscExpScalar(u);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  DM             da,*subdm;
+  SNES           snes,newton,*subsnes;
+  KSP            ksp;
+  PC             pc;
+  Vec            x,xref;
+  VecScatter     *iscat,*oscat,*gscat;
+  PetscReal      lambda = 6.0,norm,nref;
+  PetscInt       nsub = 2,n,i;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-nsub",&nsub,NULL);CHKERRQ(ierr);
+  ierr = DMDACreate2d(PETSC_COMM_WORLD,DM_BOUNDARY_NONE,DM_BOUNDARY_NONE,DMDA_STENCIL_STAR,17,17,PETSC_DECIDE,PETSC_DECIDE,1,1,NULL,NULL,&da);CHKERRQ(ierr);
+  ierr = DMSetFromOptions(da);CHKERRQ(ierr);
+  ierr = DMDASetOverlap(da,2,2,0);CHKERRQ(ierr);
+  ierr = DMSetUp(da);CHKERRQ(ierr);
+  ierr = DMDASetNumLocalSubDomains(da,nsub);CHKERRQ(ierr);
+  ierr = DMDASNESSetFunctionLocal(da,INSERT_VALUES,(DMDASNESFunction)FormFunctionLocal,&lambda);CHKERRQ(ierr);
+
+  /* the reference solution */
+  ierr = DMCreateGlobalVector(da,&xref);CHKERRQ(ierr);
+  ierr = VecDuplicate(xref,&x);CHKERRQ(ierr);
+  ierr = SNESCreate(PETSC_COMM_WORLD,&newton);CHKERRQ(ierr);
+  ierr = SNESSetOptionsPrefix(newton,"ref_");CHKERRQ(ierr);
+  ierr = SNESSetDM(newton,da);CHKERRQ(ierr);
+  ierr = SNESSetTolerances(newton,1.e-12,1.e-12,PETSC_DEFAULT,PETSC_DEFAULT,PETSC_DEFAULT);CHKERRQ(ierr);
+  ierr = SNESSetFromOptions(newton);CHKERRQ(ierr);
+  ierr = SNESSolve(newton,NULL,xref);CHKERRQ(ierr);
+
+  /* the subdomains and their solvers are built here instead of in SNESSetUp_NASM() */
+  ierr = DMCreateDomainDecomposition(da,&n,NULL,NULL,NULL,&subdm);CHKERRQ(ierr);
+  if (n != nsub) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Wrong number of subdomains %D != %D",n,nsub);
+  ierr = DMCreateDomainDecompositionScatters(da,n,subdm,&iscat,&oscat,&gscat);CHKERRQ(ierr);
+  ierr = PetscMalloc1(n,&subsnes);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    ierr = SNESCreate(PETSC_COMM_SELF,&subsnes[i]);CHKERRQ(ierr);
+    ierr = SNESSetOptionsPrefix(subsnes[i],"sub_");CHKERRQ(ierr);
+    ierr = SNESSetDM(subsnes[i],subdm[i]);CHKERRQ(ierr);
+    ierr = SNESGetKSP(subsnes[i],&ksp);CHKERRQ(ierr);
+    ierr = KSPSetType(ksp,KSPPREONLY);CHKERRQ(ierr);
+    ierr = KSPGetPC(ksp,&pc);CHKERRQ(ierr);
+    ierr = PCSetType(pc,PCLU);CHKERRQ(ierr);
+    ierr = SNESSetFromOptions(subsnes[i]);CHKERRQ(ierr);
+  }
+
+  ierr = SNESCreate(PETSC_COMM_WORLD,&snes);CHKERRQ(ierr);
+  ierr = SNESSetDM(snes,da);CHKERRQ(ierr);
+  ierr = SNESSetType(snes,SNESNASM);CHKERRQ(ierr);
+  /* NASM takes over the subdomain solvers and references the scatters */
+  ierr = SNESNASMSetSubdomains(snes,n,subsnes,iscat,oscat,gscat);CHKERRQ(ierr);
+  ierr = SNESSetTolerances(snes,1.e-10,1.e-10,PETSC_DEFAULT,100,PETSC_DEFAULT);CHKERRQ(ierr);
+  ierr = SNESSetFromOptions(snes);CHKERRQ(ierr);
+  ierr = SNESSolve(snes,NULL,x);CHKERRQ(ierr);
+
+  ierr = VecAXPY(x,-1.0,xref);CHKERRQ(ierr);
+  ierr = VecNorm(x,NORM_INFINITY,&norm);CHKERRQ(ierr);
+  ierr = VecNorm(xref,NORM_INFINITY,&nref);CHKERRQ(ierr);
+  if (norm > 1.e-6*nref) {ierr = PetscPrintf(PETSC_COMM_WORLD,"NASM solution differs from the Newton solution, relative error %g\n",(double)(norm/nref));CHKERRQ(ierr);}
+
+  for (i=0; i<n; i++) {
+    ierr = VecScatterDestroy(&iscat[i]);CHKERRQ(ierr);
+    ierr = VecScatterDestroy(&oscat[i]);CHKERRQ(ierr);
+    ierr = VecScatterDestroy(&gscat[i]);CHKERRQ(ierr);
+    ierr = DMDestroy(&subdm[i]);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(iscat);CHKERRQ(ierr);
+  ierr = PetscFree(oscat);CHKERRQ(ierr);
+  ierr = PetscFree(gscat);CHKERRQ(ierr);
+  ierr = PetscFree(subdm);CHKERRQ(ierr);
+  ierr = PetscFree(subsnes);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&xref);CHKERRQ(ierr);
+  ierr = SNESDestroy(&snes);CHKERRQ(ierr);
+  ierr = SNESDestroy(&newton);CHKERRQ(ierr);
+  ierr = DMDestroy(&da);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      nsize: {{1 2}}
+      args: -nsub {{2 3}} -snes_nasm_type restrict -snes_converged_reason
+      filter: sed -E "s/iterations [0-9]+/iterations/"
+      output_file: output/ex71_1.out
+
+   test:
+      suffix: async
+      nsize: {{1 2 3}}
+      args: -nsub {{1 2}} -snes_nasm_type restrict -snes_nasm_async -snes_converged_reason
+      filter: sed -E "s/iterations [0-9]+/iterations/"
+      output_file: output/ex71_1.out
+
+TEST*/
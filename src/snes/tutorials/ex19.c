@@ -837,6 +837,14 @@ PetscErrorCode NonlinearGS(SNES snes, Vec X, Vec B, void *ctx)
       output_file: output/ex19_2.out
       requires: !single
 
+   test:
+      suffix: lag_adaptive
+      nsize: {{1 2}}
+      args: -da_refine 2 -snes_lag_adaptive -snes_lag_adaptive_costs 10,1,1,0.1 -snes_rtol 1e-10 -snes_fd -pc_type redundant -snes_converged_reason -snes_view ::ascii_info -info :snes
+      filter: grep -E "converged|rebuilt adaptively|^\[0\] .*(Reusing|Recomputing|Rebuilding)"
+      output_file: output/ex19_lag_adaptive.out
+      requires: !single
+
    test:
       suffix: fdcoloring_ds_baij
       args: -da_refine 3 -snes_converged_reason -pc_type mg -mat_fd_type ds -dm_mat_type baij
@@ -851,6 +851,12 @@ PetscErrorCode NonlinearGS(SNES snes,Vec X, Vec B, void *ctx)
      suffix: 5_anderson
      args: -da_grid_x 81 -da_grid_y 81 -snes_monitor_short -snes_max_it 50 -par 6.0 -snes_type anderson
 
+   test:
+     suffix: 5_anderson_single_reduction
+     nsize: {{1 2}}
+     args: -da_grid_x 81 -da_grid_y 81 -snes_monitor_short -snes_max_it 50 -par 6.0 -snes_type anderson -snes_anderson_restart_type difference -snes_anderson_single_reduction
+     output_file: output/ex5_5_anderson.out
+
    test:
      suffix: 5_aspin
      nsize: 4
@@ -908,6 +914,12 @@ PetscErrorCode NonlinearGS(SNES snes,Vec X, Vec B, void *ctx)
      suffix: 5_ngmres
      args: -da_grid_x 81 -da_grid_y 81 -snes_monitor_short -snes_max_it 50 -par 6.0 -snes_type ngmres -snes_ngmres_m 10
 
+   test:
+     suffix: 5_ngmres_single_reduction
+     nsize: {{1 2}}
+     args: -da_grid_x 81 -da_grid_y 81 -snes_monitor_short -snes_max_it 50 -par 6.0 -snes_type ngmres -snes_ngmres_m 10 -snes_ngmres_single_reduction
+     output_file: output/ex5_5_ngmres.out
+
    test:
      suffix: 5_ngmres_fas
      args: -snes_rtol 1.e-4 -snes_type ngmres -npc_fas_coarse_snes_max_it 1 -npc_fas_coarse_snes_type newtonls -npc_fas_coarse_pc_type lu -npc_fas_coarse_ksp_type preonly -snes_ngmres_m 10 -snes_monitor_short -npc_snes_max_it 1 -npc_snes_type fas -npc_fas_coarse_ksp_type richardson -da_refine 6
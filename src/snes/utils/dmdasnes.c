@@ -1,5 +1,5 @@
 #include <petscdmda.h>          /*I "petscdmda.h" I*/
-#include <petsc/private/dmimpl.h>
+#include <petsc/private/dmdaimpl.h>
 #include <petsc/private/snesimpl.h>   /*I "petscsnes.h" I*/
 
 /* This structure holds the user-provided DMDA callbacks */
@@ -16,6 +16,8 @@ typedef struct {
   PetscErrorCode (*rhsplocal)(DMDALocalInfo*,void*,void*,void*);
   PetscErrorCode (*jacobianplocal)(DMDALocalInfo*,void*,Mat,Mat,void*);
   void *picardlocalctx;
+
+  PetscBool fdcolorlocal;     /* Jacobian by the DMDA-aware finite differences, see DMDASNESSetFDColoringLocal() */
 } DMSNES_DA;
 
 static PetscErrorCode DMSNESDestroy_DMDA(DMSNES sdm)
@@ -138,6 +140,495 @@ static PetscErrorCode SNESComputeObjective_DMDA(SNES snes,Vec X,PetscReal *ob,vo
   PetscFunctionReturn(0);
 }
 
+/*
+   The DMDA-aware finite difference Jacobian, see DMDASNESSetFDColoringLocal().
+
+   The points are colored periodically so that the stencil of each point contains at most one
+   point of each color: color (i + 2 j + 3 k) mod (2 dim + 1) for a star stencil of width one,
+   and the box coloring of DMCreateColoring() with period 2 s + 1 in each direction otherwise.
+   Perturbing all the points of one color thus changes the residual at a point only through the
+   neighbor of that color, whose stencil offset follows from the residues of the point.
+
+   Unlike MatFDColoringApply() the perturbations are made in place in the ghosted local state, so
+   that there is a single ghost update per Jacobian instead of one per color, the local function
+   is evaluated for all colors on a block of a few planes of the outermost direction before moving
+   on to the next block, so that the state and residual of the block stay in cache, and the entries
+   are located by stencil offset, and written directly into the values of AIJ matrices.
+*/
+typedef struct {
+  PetscInt    dim,dof,s,M[3];
+  PetscBool   periodic[3];
+  PetscBool   linear;         /* star coloring of width one, otherwise box coloring */
+  PetscInt    period;         /* period of the box coloring in each direction */
+  PetscInt    ncolors,nq;
+  PetscInt    *offsets;       /* the nq stencil offsets, 3 entries each */
+  PetscInt    *table;         /* color relative to a point -> index of the stencil offset of that color, or -1 */
+  PetscInt    planes;         /* number of planes of the outermost direction evaluated together */
+  PetscReal   epsilon,umin;
+  PetscBool   ds;             /* differencing parameter from each entry of the state, as -mat_fd_type ds */
+  PetscScalar *buf,*vals;
+  PetscInt    *rows;          /* for each row of a block with a neighbor of the current color: entry, residual and neighbor state offsets */
+  PetscInt    *work;
+  PetscBool   direct;         /* write the entries directly into the values of an AIJ matrix */
+  PetscInt    *slots;         /* location of each entry in the values of the diagonal block, or -2 - location in the off-diagonal block */
+  PetscObjectId    slotsid;   /* the matrix and nonzero state the slots were computed for */
+  PetscObjectState slotsstate;
+} DMDASNESFDLocal;
+
+PETSC_STATIC_INLINE PetscInt DMDASNESFDLocalMod(PetscInt a,PetscInt n)
+{
+  const PetscInt r = a % n;
+  return r < 0 ? r + n : r;
+}
+
+/* Color col relative to the point p, equal to the color of the stencil offset leading to the point of color col */
+PETSC_STATIC_INLINE PetscInt DMDASNESFDLocalKey(const DMDASNESFDLocal *fd,PetscInt col,const PetscInt p[])
+{
+  PetscInt d,key = 0,w = 1;
+
+  if (fd->linear) return DMDASNESFDLocalMod(col - p[0] - 2*p[1] - 3*p[2],fd->ncolors);
+  for (d=0; d<fd->dim; ++d) {
+    key += w*DMDASNESFDLocalMod(col/w - p[d],fd->period);
+    w   *= fd->period;
+  }
+  return key;
+}
+
+/* The differencing parameter for an entry of the state, as in MatFDColoringApply() */
+PETSC_STATIC_INLINE PetscScalar DMDASNESFDLocalH(const DMDASNESFDLocal *fd,PetscScalar h,PetscScalar x0)
+{
+  if (!fd->ds) return h;
+  if (PetscAbsScalar(x0) < fd->umin) x0 = PetscRealPart(x0) >= 0.0 ? fd->umin : -fd->umin;
+  return fd->epsilon*x0;
+}
+
+/* The start of the storage behind an array from DMDAVecGetArray() whose first point is st */
+PETSC_STATIC_INLINE PetscScalar *DMDASNESFDLocalBase(PetscInt dim,void *a,const PetscInt st[],PetscInt dof)
+{
+  if (dim == 1) return &((PetscScalar*)a)[st[0]*dof];
+  if (dim == 2) return &((PetscScalar**)a)[st[1]][st[0]*dof];
+  return &((PetscScalar***)a)[st[2]][st[1]][st[0]*dof];
+}
+
+static PetscErrorCode DMDASNESFDLocalDestroy(void *ctx)
+{
+  DMDASNESFDLocal *fd = (DMDASNESFDLocal*)ctx;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree6(fd->offsets,fd->table,fd->buf,fd->vals,fd->rows,fd->work);CHKERRQ(ierr);
+  ierr = PetscFree(fd->slots);CHKERRQ(ierr);
+  ierr = PetscFree(fd);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Sets up the finite difference Jacobian and composes it with the DM, or returns NULL if the DMDA or the local function are not supported */
+static PetscErrorCode DMDASNESFDLocalCreate(DM dm,DMSNES_DA *dmdasnes,PetscContainer *container)
+{
+  DM_DA           *da = (DM_DA*)dm->data;
+  DMDASNESFDLocal *fd;
+  DMDAStencilType st;
+  DMBoundaryType  bt[3];
+  DMDALocalInfo   info;
+  PetscInt        dim,M[3],dof,s,d,o[3],q,nq,ncolors,inner,outer,planes,period;
+  PetscBool       linear,flg;
+  char            htype[8];
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  *container = NULL;
+  ierr = DMDAGetInfo(dm,&dim,&M[0],&M[1],&M[2],NULL,NULL,NULL,&dof,&s,&bt[0],&bt[1],&bt[2],&st);CHKERRQ(ierr);
+  if (dmdasnes->residuallocalimode != INSERT_VALUES || da->ofill || da->dfill || dm->coloringtype != IS_COLORING_GLOBAL) {
+    ierr = PetscInfo(dm,"Local function, block fills or coloring type not supported by the DMDA finite difference Jacobian, using MatFDColoring\n");CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  for (d=0; d<dim; ++d) {
+    if (bt[d] != DM_BOUNDARY_NONE && bt[d] != DM_BOUNDARY_GHOSTED && bt[d] != DM_BOUNDARY_PERIODIC) {
+      ierr = PetscInfo1(dm,"Boundary type %s not supported by the DMDA finite difference Jacobian, using MatFDColoring\n",DMBoundaryTypes[bt[d]]);CHKERRQ(ierr);
+      PetscFunctionReturn(0);
+    }
+  }
+  /* periodic directions must be multiples of the period of the coloring */
+  period = 2*s+1;
+  linear = (PetscBool)(st == DMDA_STENCIL_STAR && s == 1);
+  for (d=0; d<dim; ++d) if (bt[d] == DM_BOUNDARY_PERIODIC && M[d] % (2*dim+1)) linear = PETSC_FALSE;
+  if (!linear) {
+    for (d=0; d<dim; ++d) {
+      if (bt[d] == DM_BOUNDARY_PERIODIC && M[d] % period) SETERRQ3(PetscObjectComm((PetscObject)dm),PETSC_ERR_SUP,"For coloring efficiency ensure number of grid points %D in direction %D is divisible by 2*stencil_width + 1 = %D",M[d],d,period);
+    }
+  }
+  ncolors = linear ? 2*dim+1 : (dim == 1 ? period : (dim == 2 ? period*period : period*period*period));
+  for (d=dim; d<3; ++d) M[d] = 1;
+  nq = 0;
+  for (o[2]=(dim > 2 ? -s : 0); o[2]<=(dim > 2 ? s : 0); ++o[2]) {
+    for (o[1]=(dim > 1 ? -s : 0); o[1]<=(dim > 1 ? s : 0); ++o[1]) {
+      for (o[0]=-s; o[0]<=s; ++o[0]) {
+        if (st == DMDA_STENCIL_BOX || (!o[0] + !o[1] + !o[2]) >= 2) ++nq;
+      }
+    }
+  }
+
+  /* blocks of planes whose state, base and perturbed residual fit in about half a megabyte */
+  ierr = DMDAGetLocalInfo(dm,&info);CHKERRQ(ierr);
+  inner  = dim == 1 ? 1 : (dim == 2 ? info.xm : info.xm*info.ym);
+  outer  = dim == 1 ? info.xm : (dim == 2 ? info.ym : info.zm);
+  planes = PetscMax(1,(1<<16)/(3*inner*dof) - 2*s);
+  ierr   = PetscOptionsGetInt(((PetscObject)dm)->options,((PetscObject)dm)->prefix,"-da_snes_fd_color_local_planes",&planes,NULL);CHKERRQ(ierr);
+  planes = PetscMax(1,PetscMin(planes,outer));
+
+  ierr = PetscNew(&fd);CHKERRQ(ierr);
+  ierr = PetscMalloc6(3*nq,&fd->offsets,ncolors,&fd->table,planes*inner*dof*nq*dof,&fd->buf,dof*nq*dof,&fd->vals,3*planes*inner,&fd->rows,(2+dof)*nq+dof,&fd->work);CHKERRQ(ierr);
+  fd->dim     = dim;
+  fd->dof     = dof;
+  fd->s       = s;
+  fd->linear  = linear;
+  fd->period  = period;
+  fd->ncolors = ncolors;
+  fd->nq      = nq;
+  fd->planes  = planes;
+  for (d=0; d<3; ++d) {
+    fd->M[d]        = M[d];
+    fd->periodic[d] = (PetscBool)(d < dim && bt[d] == DM_BOUNDARY_PERIODIC);
+  }
+  for (q=0; q<ncolors; ++q) fd->table[q] = -1;
+  q = 0;
+  for (o[2]=(dim > 2 ? -s : 0); o[2]<=(dim > 2 ? s : 0); ++o[2]) {
+    for (o[1]=(dim > 1 ? -s : 0); o[1]<=(dim > 1 ? s : 0); ++o[1]) {
+      for (o[0]=-s; o[0]<=s; ++o[0]) {
+        if (st == DMDA_STENCIL_BOX || (!o[0] + !o[1] + !o[2]) >= 2) {
+          const PetscInt mo[3] = {-o[0],-o[1],-o[2]};
+
+          for (d=0; d<3; ++d) fd->offsets[3*q+d] = o[d];
+          fd->table[DMDASNESFDLocalKey(fd,0,mo)] = q;
+          ++q;
+        }
+      }
+    }
+  }
+
+  /* the same differencing parameters as MatFDColoring */
+  fd->epsilon = PETSC_SQRT_MACHINE_EPSILON;
+  fd->umin    = 100.0*PETSC_SQRT_MACHINE_EPSILON;
+  ierr = PetscOptionsGetReal(((PetscObject)dm)->options,((PetscObject)dm)->prefix,"-mat_fd_coloring_err",&fd->epsilon,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetReal(((PetscObject)dm)->options,((PetscObject)dm)->prefix,"-mat_fd_coloring_umin",&fd->umin,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetString(((PetscObject)dm)->options,((PetscObject)dm)->prefix,"-mat_fd_type",htype,sizeof(htype),&flg);CHKERRQ(ierr);
+  fd->ds = (PetscBool)(flg && htype[0] == 'd' && htype[1] == 's');
+  ierr = PetscInfo4(dm,"DMDA finite difference Jacobian with %D %s colors, %D stencil points and blocks of %D planes\n",ncolors,linear ? "star" : "box",nq,planes);CHKERRQ(ierr);
+
+  ierr = PetscContainerCreate(PETSC_COMM_SELF,container);CHKERRQ(ierr);
+  ierr = PetscContainerSetPointer(*container,fd);CHKERRQ(ierr);
+  ierr = PetscContainerSetUserDestroy(*container,DMDASNESFDLocalDestroy);CHKERRQ(ierr);
+  ierr = PetscObjectCompose((PetscObject)dm,"DMDASNES_FDLOCAL",(PetscObject)*container);CHKERRQ(ierr);
+  ierr = PetscObjectDereference((PetscObject)*container);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Adds the perturbation of component c to the points of color col in the box lo..hi of the ghosted local state x, or restores them from x0 */
+static void DMDASNESFDLocalPerturb(const DMDASNESFDLocal *fd,const DMDALocalInfo *info,PetscInt col,PetscInt c,const PetscInt lo[],const PetscInt hi[],PetscScalar h,PetscScalar *x,const PetscScalar *x0,PetscBool add)
+{
+  const PetscInt g[3] = {info->gxs,info->gys,info->gzs},gm[3] = {info->gxm,info->gym,info->gzm};
+  const PetscInt P = fd->period,dof = fd->dof;
+  PetscInt       first[3],step[3],p[3],d,l;
+
+  for (d=0; d<3; ++d) {
+    if (d < fd->dim && !fd->linear) {
+      const PetscInt cd = (d == 0 ? col : (d == 1 ? col/P : col/(P*P))) % P;
+
+      first[d] = lo[d] + DMDASNESFDLocalMod(cd - lo[d],P);
+      step[d]  = P;
+    } else {
+      first[d] = lo[d];
+      step[d]  = 1;
+    }
+  }
+  for (p[2]=first[2]; p[2]<hi[2]; p[2]+=step[2]) {
+    for (p[1]=first[1]; p[1]<hi[1]; p[1]+=step[1]) {
+      if (fd->linear) {
+        first[0] = lo[0] + DMDASNESFDLocalMod(col - 2*p[1] - 3*p[2] - lo[0],fd->ncolors);
+        step[0]  = fd->ncolors;
+      }
+      for (p[0]=first[0]; p[0]<hi[0]; p[0]+=step[0]) {
+        l    = (((p[2]-g[2])*gm[1] + p[1]-g[1])*gm[0] + p[0]-g[0])*dof + c;
+        x[l] = add ? x0[l] + DMDASNESFDLocalH(fd,h,x0[l]) : x0[l];
+      }
+    }
+  }
+}
+
+/*
+   Finds the location in the values of an AIJ matrix of the entry of each owned row for each stencil offset, so that
+   the entries can be written directly: loc in the diagonal block, -2 - loc in the off-diagonal block, -1 if missing
+*/
+static PetscErrorCode DMDASNESFDLocalSetUpDirect(DMDASNESFDLocal *fd,Mat B,const PetscInt *bidx,const PetscInt g[],const PetscInt gm[],const PetscInt os[],const PetscInt om[])
+{
+  const PetscInt   dim = fd->dim,dof = fd->dof,nq = fd->nq;
+  const PetscInt   *ia,*ja,*ib = NULL,*jb = NULL,*garray = NULL;
+  Mat              Ad = B,Ao = NULL;
+  PetscBool        isseq,ismpi,assembled,done;
+  PetscObjectId    id;
+  PetscObjectState state;
+  PetscInt         rstart,cstart,cend,n,p[3],pp[3],q = 0,oi,c,cc,d;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetId((PetscObject)B,&id);CHKERRQ(ierr);
+  ierr = MatGetNonzeroState(B,&state);CHKERRQ(ierr);
+  if (fd->slots && id == fd->slotsid && state == fd->slotsstate) PetscFunctionReturn(0);
+  fd->direct     = PETSC_FALSE;
+  fd->slotsid    = id;
+  fd->slotsstate = state;
+  ierr = PetscObjectBaseTypeCompare((PetscObject)B,MATSEQAIJ,&isseq);CHKERRQ(ierr);
+  ierr = PetscObjectBaseTypeCompare((PetscObject)B,MATMPIAIJ,&ismpi);CHKERRQ(ierr);
+  ierr = MatAssembled(B,&assembled);CHKERRQ(ierr);
+  if ((!isseq && !ismpi) || !assembled) PetscFunctionReturn(0);
+  if (ismpi) {ierr = MatMPIAIJGetSeqAIJ(B,&Ad,&Ao,&garray);CHKERRQ(ierr);}
+  ierr = MatGetOwnershipRange(B,&rstart,NULL);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRangeColumn(B,&cstart,&cend);CHKERRQ(ierr);
+  ierr = MatGetRowIJ(Ad,0,PETSC_FALSE,PETSC_FALSE,&n,&ia,&ja,&done);CHKERRQ(ierr);
+  if (!done) PetscFunctionReturn(0);
+  if (Ao) {
+    ierr = MatGetRowIJ(Ao,0,PETSC_FALSE,PETSC_FALSE,&n,&ib,&jb,&done);CHKERRQ(ierr);
+    if (!done) {
+      ierr = MatRestoreRowIJ(Ad,0,PETSC_FALSE,PETSC_FALSE,&n,&ia,&ja,&done);CHKERRQ(ierr);
+      PetscFunctionReturn(0);
+    }
+  }
+  if (!fd->slots) {ierr = PetscMalloc1(om[0]*om[1]*om[2]*dof*nq*dof,&fd->slots);CHKERRQ(ierr);}
+  fd->direct = PETSC_TRUE;
+  for (p[2]=os[2]; p[2]<os[2]+om[2]; ++p[2]) {
+    for (p[1]=os[1]; p[1]<os[1]+om[1]; ++p[1]) {
+      for (p[0]=os[0]; p[0]<os[0]+om[0]; ++p[0],++q) {
+        const PetscInt brow = bidx[((p[2]-g[2])*gm[1] + p[1]-g[1])*gm[0] + p[0]-g[0]];
+
+        for (oi=0; oi<nq; ++oi) {
+          PetscInt bcol;
+
+          for (d=0; d<3; ++d) pp[d] = p[d] + fd->offsets[3*oi+d];
+          for (d=0; d<dim; ++d) if (!fd->periodic[d] && (pp[d] < 0 || pp[d] >= fd->M[d])) break;
+          if (d < dim) continue;
+          bcol = bidx[((pp[2]-g[2])*gm[1] + pp[1]-g[1])*gm[0] + pp[0]-g[0]];
+          for (cc=0; cc<dof; ++cc) {
+            const PetscInt row = brow*dof + cc - rstart;
+            PetscInt       loc = -1,lo,hi;
+
+            /* find the first column of the block, the others normally follow it */
+            if (bcol*dof >= cstart && bcol*dof < cend) {
+              ierr = PetscFindInt(bcol*dof-cstart,ia[row+1]-ia[row],ja+ia[row],&loc);CHKERRQ(ierr);
+              if (loc >= 0) loc += ia[row];
+            } else if (Ao) {
+              /* the off-diagonal columns are sorted, and so is garray */
+              for (lo=ib[row],hi=ib[row+1]; lo<hi;) {
+                const PetscInt mid = (lo+hi)/2;
+
+                if (garray[jb[mid]] < bcol*dof) lo = mid+1;
+                else hi = mid;
+              }
+              if (lo < ib[row+1] && garray[jb[lo]] == bcol*dof) loc = lo;
+            }
+            for (c=0; c<dof; ++c) {
+              PetscInt sl = -1;
+
+              if (loc >= 0 && bcol*dof >= cstart && bcol*dof < cend) {
+                if (loc+c < ia[row+1] && ja[loc+c] == bcol*dof+c-cstart) sl = loc+c;
+              } else if (loc >= 0) {
+                if (loc+c < ib[row+1] && garray[jb[loc+c]] == bcol*dof+c) sl = -2-(loc+c);
+              }
+              if (sl == -1) fd->direct = PETSC_FALSE;
+              fd->slots[((q*dof+cc)*nq+oi)*dof+c] = sl;
+            }
+          }
+        }
+      }
+    }
+  }
+  ierr = MatRestoreRowIJ(Ad,0,PETSC_FALSE,PETSC_FALSE,&n,&ia,&ja,&done);CHKERRQ(ierr);
+  if (Ao) {ierr = MatRestoreRowIJ(Ao,0,PETSC_FALSE,PETSC_FALSE,&n,&ib,&jb,&done);CHKERRQ(ierr);}
+  ierr = PetscInfo1(B,"%s the DMDA finite difference Jacobian entries directly\n",fd->direct ? "Writing" : "Not writing");CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode SNESComputeJacobian_DMDA_FDLocal(SNES snes,DM dm,DMSNES_DA *dmdasnes,DMDASNESFDLocal *fd,Vec X,Mat B)
+{
+  const PetscInt         dim = fd->dim,dof = fd->dof,nq = fd->nq,od = fd->dim-1;
+  DMDALocalInfo          info,binfo;
+  ISLocalToGlobalMapping ltog;
+  const PetscInt         *bidx;
+  const PetscScalar      *x0a;
+  PetscScalar            *xa,*f0a,*fpa,*ad = NULL,*ao = NULL,h = 0.0;
+  Mat                    Ad = NULL,Ao = NULL;
+  PetscInt               *valid = fd->work,*cols = fd->work+nq,*rows = fd->work+2*nq,*ecols = fd->work+2*nq+dof;
+  PetscInt               g[3],gm[3],os[3],om[3],lo[3],hi[3],p[3],pp[3],start,end,col,c,cc,q,qb,r,d,n,bs;
+  PetscReal              unorm;
+  Vec                    Xloc,X0,F0,Fp;
+  void                   *x,*f0,*fp;
+  PetscErrorCode         ierr;
+
+  PetscFunctionBegin;
+  ierr = DMDAGetLocalInfo(dm,&info);CHKERRQ(ierr);
+  for (d=0; d<3; ++d) {
+    g[d]  = d < dim ? (d == 0 ? info.gxs : (d == 1 ? info.gys : info.gzs)) : 0;
+    gm[d] = d < dim ? (d == 0 ? info.gxm : (d == 1 ? info.gym : info.gzm)) : 1;
+    os[d] = d < dim ? (d == 0 ? info.xs : (d == 1 ? info.ys : info.zs)) : 0;
+    om[d] = d < dim ? (d == 0 ? info.xm : (d == 1 ? info.ym : info.zm)) : 1;
+  }
+  ierr = MatGetBlockSize(B,&bs);CHKERRQ(ierr);
+  ierr = DMGetLocalToGlobalMapping(dm,&ltog);CHKERRQ(ierr);
+  ierr = ISLocalToGlobalMappingGetBlockIndices(ltog,&bidx);CHKERRQ(ierr);
+  ierr = DMDASNESFDLocalSetUpDirect(fd,B,bidx,g,gm,os,om);CHKERRQ(ierr);
+  if (fd->direct) {
+    PetscBool ismpi;
+
+    ierr = PetscObjectBaseTypeCompare((PetscObject)B,MATMPIAIJ,&ismpi);CHKERRQ(ierr);
+    if (ismpi) {ierr = MatMPIAIJGetSeqAIJ(B,&Ad,&Ao,NULL);CHKERRQ(ierr);}
+    else Ad = B;
+    ierr = MatSeqAIJGetArray(Ad,&ad);CHKERRQ(ierr);
+    if (Ao) {ierr = MatSeqAIJGetArray(Ao,&ao);CHKERRQ(ierr);}
+  }
+
+  ierr = DMGetLocalVector(dm,&Xloc);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(dm,&X0);CHKERRQ(ierr);
+  ierr = DMGetGlobalVector(dm,&F0);CHKERRQ(ierr);
+  ierr = DMGetGlobalVector(dm,&Fp);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalBegin(dm,X,INSERT_VALUES,Xloc);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalEnd(dm,X,INSERT_VALUES,Xloc);CHKERRQ(ierr);
+  ierr = VecCopy(Xloc,X0);CHKERRQ(ierr);
+  if (!fd->ds) {
+    ierr = VecNorm(X,NORM_2,&unorm);CHKERRQ(ierr);
+    h    = fd->epsilon*PetscSqrtReal(1.0 + unorm);
+  }
+  ierr = DMDAVecGetArray(dm,Xloc,&x);CHKERRQ(ierr);
+  ierr = DMDAVecGetArray(dm,F0,&f0);CHKERRQ(ierr);
+  ierr = DMDAVecGetArray(dm,Fp,&fp);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(X0,&x0a);CHKERRQ(ierr);
+  xa  = DMDASNESFDLocalBase(dim,x,g,dof);
+  f0a = DMDASNESFDLocalBase(dim,f0,os,dof);
+  fpa = DMDASNESFDLocalBase(dim,fp,os,dof);
+
+  ierr = PetscLogEventBegin(SNES_FunctionEval,snes,X,F0,0);CHKERRQ(ierr);
+  ierr = (*dmdasnes->residuallocal)(&info,x,f0,dmdasnes->residuallocalctx);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(SNES_FunctionEval,snes,X,F0,0);CHKERRQ(ierr);
+  for (start=os[od]; start<os[od]+om[od]; start=end) {
+    end   = PetscMin(start+fd->planes,os[od]+om[od]);
+    binfo = info;
+    if (od == 0)      {binfo.xs = start; binfo.xm = end-start;}
+    else if (od == 1) {binfo.ys = start; binfo.ym = end-start;}
+    else              {binfo.zs = start; binfo.zm = end-start;}
+    /* the points whose perturbation reaches the block */
+    for (d=0; d<3; ++d) {
+      lo[d] = g[d];
+      hi[d] = g[d]+gm[d];
+      if (!fd->periodic[d]) {
+        lo[d] = PetscMax(lo[d],0);
+        hi[d] = PetscMin(hi[d],fd->M[d]);
+      }
+    }
+    lo[od] = PetscMax(lo[od],start-fd->s);
+    hi[od] = PetscMin(hi[od],end+fd->s);
+
+    for (col=0; col<fd->ncolors; ++col) {
+      PetscInt nr = 0;
+
+      /* the rows of the block with their neighbor of this color, as a stencil offset and a ghosted local point */
+      qb = 0;
+      for (p[2]=(od == 2 ? start : os[2]); p[2]<(od == 2 ? end : os[2]+om[2]); ++p[2]) {
+        for (p[1]=(od == 1 ? start : os[1]); p[1]<(od == 1 ? end : os[1]+om[1]); ++p[1]) {
+          for (p[0]=(od == 0 ? start : os[0]); p[0]<(od == 0 ? end : os[0]+om[0]); ++p[0],++qb) {
+            const PetscInt oi = fd->table[DMDASNESFDLocalKey(fd,col,p)];
+
+            if (oi < 0) continue;
+            for (d=0; d<3; ++d) pp[d] = p[d] + fd->offsets[3*oi+d];
+            for (d=0; d<dim; ++d) if (!fd->periodic[d] && (pp[d] < 0 || pp[d] >= fd->M[d])) break;
+            if (d < dim) continue;
+            fd->rows[3*nr+1] = (((p[2]-os[2])*om[1] + p[1]-os[1])*om[0] + p[0]-os[0])*dof;
+            fd->rows[3*nr+0] = ((fd->direct ? fd->rows[3*nr+1] : qb*dof)*nq+oi)*dof;
+            fd->rows[3*nr+2] = (((pp[2]-g[2])*gm[1] + pp[1]-g[1])*gm[0] + pp[0]-g[0])*dof;
+            ++nr;
+          }
+        }
+      }
+      for (c=0; c<dof; ++c) {
+        DMDASNESFDLocalPerturb(fd,&info,col,c,lo,hi,h,xa,x0a,PETSC_TRUE);
+        ierr = PetscLogEventBegin(SNES_FunctionEval,snes,X,Fp,0);CHKERRQ(ierr);
+        ierr = (*dmdasnes->residuallocal)(&binfo,x,fp,dmdasnes->residuallocalctx);CHKERRQ(ierr);
+        ierr = PetscLogEventEnd(SNES_FunctionEval,snes,X,Fp,0);CHKERRQ(ierr);
+        DMDASNESFDLocalPerturb(fd,&info,col,c,lo,hi,h,xa,x0a,PETSC_FALSE);
+        if (fd->direct) {
+          for (r=0; r<nr; ++r) {
+            const PetscInt    *rr = &fd->rows[3*r],*sq = &fd->slots[rr[0]+c];
+            const PetscScalar hp  = 1.0/DMDASNESFDLocalH(fd,h,x0a[rr[2]+c]);
+
+            for (cc=0; cc<dof; ++cc) {
+              const PetscInt    sl = sq[cc*nq*dof];
+              const PetscScalar v  = (fpa[rr[1]+cc] - f0a[rr[1]+cc])*hp;
+
+              if (sl >= 0) ad[sl] = v;
+              else ao[-2-sl] = v;
+            }
+          }
+        } else {
+          for (r=0; r<nr; ++r) {
+            const PetscInt    *rr = &fd->rows[3*r];
+            const PetscScalar hp  = 1.0/DMDASNESFDLocalH(fd,h,x0a[rr[2]+c]);
+            PetscScalar       *bq = &fd->buf[rr[0]+c];
+
+            for (cc=0; cc<dof; ++cc) bq[cc*nq*dof] = (fpa[rr[1]+cc] - f0a[rr[1]+cc])*hp;
+          }
+        }
+      }
+    }
+
+    if (fd->direct) continue;
+
+    /* insert the rows of the block by stencil offset */
+    q = 0;
+    for (p[2]=(od == 2 ? start : os[2]); p[2]<(od == 2 ? end : os[2]+om[2]); ++p[2]) {
+      for (p[1]=(od == 1 ? start : os[1]); p[1]<(od == 1 ? end : os[1]+om[1]); ++p[1]) {
+        for (p[0]=(od == 0 ? start : os[0]); p[0]<(od == 0 ? end : os[0]+om[0]); ++p[0],++q) {
+          const PetscInt row = bidx[((p[2]-g[2])*gm[1] + p[1]-g[1])*gm[0] + p[0]-g[0]];
+          PetscInt       oi,v;
+
+          n = 0;
+          for (oi=0; oi<nq; ++oi) {
+            for (d=0; d<3; ++d) pp[d] = p[d] + fd->offsets[3*oi+d];
+            for (d=0; d<dim; ++d) if (!fd->periodic[d] && (pp[d] < 0 || pp[d] >= fd->M[d])) break;
+            if (d < dim) continue;
+            valid[n] = oi;
+            cols[n]  = bidx[((pp[2]-g[2])*gm[1] + pp[1]-g[1])*gm[0] + pp[0]-g[0]];
+            ++n;
+          }
+          for (cc=0; cc<dof; ++cc) {
+            for (v=0; v<n; ++v) {
+              for (c=0; c<dof; ++c) fd->vals[(cc*n+v)*dof+c] = fd->buf[((q*dof+cc)*nq+valid[v])*dof+c];
+            }
+          }
+          if (bs == dof) {
+            ierr = MatSetValuesBlocked(B,1,&row,n,cols,fd->vals,INSERT_VALUES);CHKERRQ(ierr);
+          } else {
+            for (cc=0; cc<dof; ++cc) rows[cc] = row*dof+cc;
+            for (v=0; v<n; ++v) for (c=0; c<dof; ++c) ecols[v*dof+c] = cols[v]*dof+c;
+            ierr = MatSetValues(B,dof,rows,n*dof,ecols,fd->vals,INSERT_VALUES);CHKERRQ(ierr);
+          }
+        }
+      }
+    }
+  }
+
+  ierr = VecRestoreArrayRead(X0,&x0a);CHKERRQ(ierr);
+  ierr = DMDAVecRestoreArray(dm,Fp,&fp);CHKERRQ(ierr);
+  ierr = DMDAVecRestoreArray(dm,F0,&f0);CHKERRQ(ierr);
+  ierr = DMDAVecRestoreArray(dm,Xloc,&x);CHKERRQ(ierr);
+  ierr = DMRestoreGlobalVector(dm,&Fp);CHKERRQ(ierr);
+  ierr = DMRestoreGlobalVector(dm,&F0);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(dm,&X0);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(dm,&Xloc);CHKERRQ(ierr);
+  ierr = ISLocalToGlobalMappingRestoreBlockIndices(ltog,&bidx);CHKERRQ(ierr);
+  if (ad) {ierr = MatSeqAIJRestoreArray(Ad,&ad);CHKERRQ(ierr);}
+  if (ao) {ierr = MatSeqAIJRestoreArray(Ao,&ao);CHKERRQ(ierr);}
+  ierr = MatAssemblyBegin(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /* Routine is called by example, hence must be labeled PETSC_EXTERN */
 PETSC_EXTERN PetscErrorCode SNESComputeJacobian_DMDA(SNES snes,Vec X,Mat A,Mat B,void *ctx)
 {
@@ -164,35 +655,51 @@ PETSC_EXTERN PetscErrorCode SNESComputeJacobian_DMDA(SNES snes,Vec X,Mat A,Mat B
     ierr = DMDAVecRestoreArray(dm,Xloc,&x);CHKERRQ(ierr);
     ierr = DMRestoreLocalVector(dm,&Xloc);CHKERRQ(ierr);
   } else {
-    MatFDColoring fdcoloring;
+    MatFDColoring  fdcoloring;
+    PetscContainer container;
+
+    ierr = PetscObjectQuery((PetscObject)dm,"DMDASNES_FDLOCAL",(PetscObject*)&container);CHKERRQ(ierr);
     ierr = PetscObjectQuery((PetscObject)dm,"DMDASNES_FDCOLORING",(PetscObject*)&fdcoloring);CHKERRQ(ierr);
-    if (!fdcoloring) {
-      ISColoring coloring;
-
-      ierr = DMCreateColoring(dm,dm->coloringtype,&coloring);CHKERRQ(ierr);
-      ierr = MatFDColoringCreate(B,coloring,&fdcoloring);CHKERRQ(ierr);
-      switch (dm->coloringtype) {
-      case IS_COLORING_GLOBAL:
-        ierr = MatFDColoringSetFunction(fdcoloring,(PetscErrorCode (*)(void))SNESComputeFunction_DMDA,dmdasnes);CHKERRQ(ierr);
-        break;
-      default: SETERRQ1(PetscObjectComm((PetscObject)snes),PETSC_ERR_SUP,"No support for coloring type '%s'",ISColoringTypes[dm->coloringtype]);
+    if (!container && !fdcoloring) {
+      PetscBool fdlocal = dmdasnes->fdcolorlocal;
+
+      ierr = PetscOptionsGetBool(((PetscObject)dm)->options,((PetscObject)dm)->prefix,"-da_snes_fd_color_local",&fdlocal,NULL);CHKERRQ(ierr);
+      if (fdlocal) {ierr = DMDASNESFDLocalCreate(dm,dmdasnes,&container);CHKERRQ(ierr);}
+    }
+    if (container) {
+      DMDASNESFDLocal *fd;
+
+      ierr = PetscContainerGetPointer(container,(void**)&fd);CHKERRQ(ierr);
+      ierr = SNESComputeJacobian_DMDA_FDLocal(snes,dm,dmdasnes,fd,X,B);CHKERRQ(ierr);
+    } else {
+      if (!fdcoloring) {
+        ISColoring coloring;
+
+        ierr = DMCreateColoring(dm,dm->coloringtype,&coloring);CHKERRQ(ierr);
+        ierr = MatFDColoringCreate(B,coloring,&fdcoloring);CHKERRQ(ierr);
+        switch (dm->coloringtype) {
+        case IS_COLORING_GLOBAL:
+          ierr = MatFDColoringSetFunction(fdcoloring,(PetscErrorCode (*)(void))SNESComputeFunction_DMDA,dmdasnes);CHKERRQ(ierr);
+          break;
+        default: SETERRQ1(PetscObjectComm((PetscObject)snes),PETSC_ERR_SUP,"No support for coloring type '%s'",ISColoringTypes[dm->coloringtype]);
+        }
+        ierr = PetscObjectSetOptionsPrefix((PetscObject)fdcoloring,((PetscObject)dm)->prefix);CHKERRQ(ierr);
+        ierr = MatFDColoringSetFromOptions(fdcoloring);CHKERRQ(ierr);
+        ierr = MatFDColoringSetUp(B,coloring,fdcoloring);CHKERRQ(ierr);
+        ierr = ISColoringDestroy(&coloring);CHKERRQ(ierr);
+        ierr = PetscObjectCompose((PetscObject)dm,"DMDASNES_FDCOLORING",(PetscObject)fdcoloring);CHKERRQ(ierr);
+        ierr = PetscObjectDereference((PetscObject)fdcoloring);CHKERRQ(ierr);
+
+        /* The following breaks an ugly reference counting loop that deserves a paragraph. MatFDColoringApply() will call
+         * VecDuplicate() with the state Vec and store inside the MatFDColoring. This Vec will duplicate the Vec, but the
+         * MatFDColoring is composed with the DM. We dereference the DM here so that the reference count will eventually
+         * drop to 0. Note the code in DMDestroy() that exits early for a negative reference count. That code path will be
+         * taken when the PetscObjectList for the Vec inside MatFDColoring is destroyed.
+         */
+        ierr = PetscObjectDereference((PetscObject)dm);CHKERRQ(ierr);
       }
-      ierr = PetscObjectSetOptionsPrefix((PetscObject)fdcoloring,((PetscObject)dm)->prefix);CHKERRQ(ierr);
-      ierr = MatFDColoringSetFromOptions(fdcoloring);CHKERRQ(ierr);
-      ierr = MatFDColoringSetUp(B,coloring,fdcoloring);CHKERRQ(ierr);
-      ierr = ISColoringDestroy(&coloring);CHKERRQ(ierr);
-      ierr = PetscObjectCompose((PetscObject)dm,"DMDASNES_FDCOLORING",(PetscObject)fdcoloring);CHKERRQ(ierr);
-      ierr = PetscObjectDereference((PetscObject)fdcoloring);CHKERRQ(ierr);
-
-      /* The following breaks an ugly reference counting loop that deserves a paragraph. MatFDColoringApply() will call
-       * VecDuplicate() with the state Vec and store inside the MatFDColoring. This Vec will duplicate the Vec, but the
-       * MatFDColoring is composed with the DM. We dereference the DM here so that the reference count will eventually
-       * drop to 0. Note the code in DMDestroy() that exits early for a negative reference count. That code path will be
-       * taken when the PetscObjectList for the Vec inside MatFDColoring is destroyed.
-       */
-      ierr = PetscObjectDereference((PetscObject)dm);CHKERRQ(ierr);
+      ierr = MatFDColoringApply(B,fdcoloring,X,snes);CHKERRQ(ierr);
     }
-    ierr = MatFDColoringApply(B,fdcoloring,X,snes);CHKERRQ(ierr);
   }
   /* This will be redundant if the user called both, but it's too common to forget. */
   if (A != B) {
@@ -286,6 +793,55 @@ PetscErrorCode DMDASNESSetJacobianLocal(DM dm,PetscErrorCode (*func)(DMDALocalIn
   PetscFunctionReturn(0);
 }
 
+/*@
+   DMDASNESSetFDColoringLocal - compute the Jacobian by finite differences that exploit the DMDA stencil, instead of MatFDColoring
+
+   Logically Collective
+
+   Input Parameters:
++  dm - DM to associate callback with
+-  flg - PETSC_TRUE to use the DMDA-aware finite differences
+
+   Options Database Keys:
++  -da_snes_fd_color_local - use the DMDA-aware finite differences
+-  -da_snes_fd_color_local_planes <n> - number of planes of the outermost direction evaluated together for all colors
+
+   Notes:
+   This is used when the Jacobian is computed by finite differences from the function set with DMDASNESSetFunctionLocal(),
+   that is when no DMDASNESSetJacobianLocal() is provided. The points of the DMDA are colored periodically so that the stencil
+   of a point contains at most one point of each color, the perturbations are made in place in the ghosted local state, so there
+   is one ghost update per Jacobian instead of one per color, and the local function is called on blocks of planes of the
+   outermost direction, for all colors in turn, while their state stays in cache. The entries are inserted by stencil offset.
+   A star stencil of width one needs only 2*dim+1 colors.
+
+   The local function must compute the residual at exactly the points info->xs..info->xs+info->xm-1 (and similarly in the other
+   directions) of the DMDALocalInfo it is passed, reading the state only within the stencil of those points. It is given blocks
+   of the local subdomain. The differencing parameters are those of MatFDColoring, set with -mat_fd_coloring_err,
+   -mat_fd_coloring_umin and -mat_fd_type.
+
+   Local functions with ADD_VALUES, DMDASetBlockFills(), and mirror boundaries fall back to MatFDColoring.
+   This must be called before the first Jacobian evaluation.
+
+   Level: intermediate
+
+.seealso: DMDASNESSetFunctionLocal(), DMDASNESSetJacobianLocal(), MatFDColoringCreate(), DMCreateColoring()
+@*/
+PetscErrorCode DMDASNESSetFDColoringLocal(DM dm,PetscBool flg)
+{
+  PetscErrorCode ierr;
+  DMSNES         sdm;
+  DMSNES_DA      *dmdasnes;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm,DM_CLASSID,1);
+  PetscValidLogicalCollectiveBool(dm,flg,2);
+  ierr = DMGetDMSNESWrite(dm,&sdm);CHKERRQ(ierr);
+  ierr = DMDASNESGetContext(dm,sdm,&dmdasnes);CHKERRQ(ierr);
+
+  dmdasnes->fdcolorlocal = flg;
+  PetscFunctionReturn(0);
+}
+
 /*@C
    DMDASNESSetObjectiveLocal - set a local residual evaluation function
 
@@ -368,4 +368,14 @@ PetscErrorCode FormHessian(Tao tao,Vec X,Mat H, Mat Hpre, void *ptr)
      suffix: 28
      args: -tao_fmin 10 -tao_converged_reason
 
+   test:
+     suffix: 29
+     output_file: output/rosenbrock1_14.out
+     args: -test_lmvm -tao_max_it 10 -tao_bqnk_mat_type lmvmbfgs -tao_bqnk_mat_lmvm_compact -tao_bqnk_mat_lmvm_scale_type {{none scalar diagonal}}
+
+   test:
+     suffix: 30
+     output_file: output/rosenbrock1_2.out
+     args: -tao_smonitor -tao_type lmvm -tao_gatol 1.e-3 -tao_lmvm_mat_lmvm_compact
+
 TEST*/
@@ -775,34 +775,50 @@ static PetscErrorCode TSStep_RK(TS ts)
   TSAdapt         adapt;
   PetscInt        i,j;
   PetscInt        rejections = 0;
-  PetscBool       stageok,accept = PETSC_TRUE;
+  PetscBool       stageok,accept = PETSC_TRUE,stepped = PETSC_FALSE;
   PetscReal       next_time_step = ts->time_step;
+  DMTS            tsdm = NULL;
   PetscErrorCode  ierr;
 
   PetscFunctionBegin;
   if (ts->steprollback || ts->steprestart) FSAL = PETSC_FALSE;
   if (FSAL) { ierr = VecCopy(YdotRHS[s-1],YdotRHS[0]);CHKERRQ(ierr); }
+  /* the DM can advance the whole step locally if nothing needs the stages themselves */
+  if (rk->tblock > 0 && !ts->prestage && !ts->poststage && !ts->trajectory && !ts->forward_solve && !ts->costintegralfwd) {
+    DM dm;
+
+    ierr = TSGetAdapt(ts,&adapt);CHKERRQ(ierr);
+    ierr = TSGetDM(ts,&dm);CHKERRQ(ierr);
+    ierr = DMGetDMTS(dm,&tsdm);CHKERRQ(ierr);
+    if (adapt->checkstage || !tsdm->ops->rkstep) tsdm = NULL;
+  }
 
   rk->status = TS_STEP_INCOMPLETE;
   while (!ts->reason && rk->status != TS_STEP_COMPLETE) {
     PetscReal t = ts->ptime;
     PetscReal h = ts->time_step;
-    for (i=0; i<s; i++) {
-      rk->stage_time = t + h*c[i];
-      ierr = TSPreStage(ts,rk->stage_time);CHKERRQ(ierr);
-      ierr = VecCopy(ts->vec_sol,Y[i]);CHKERRQ(ierr);
-      for (j=0; j<i; j++) w[j] = h*A[i*s+j];
-      ierr = VecMAXPY(Y[i],i,w,YdotRHS);CHKERRQ(ierr);
-      ierr = TSPostStage(ts,rk->stage_time,i,Y);CHKERRQ(ierr);
-      ierr = TSGetAdapt(ts,&adapt);CHKERRQ(ierr);
-      ierr = TSAdaptCheckStage(adapt,ts,rk->stage_time,Y[i],&stageok);CHKERRQ(ierr);
-      if (!stageok) goto reject_step;
-      if (FSAL && !i) continue;
-      ierr = TSComputeRHSFunction(ts,t+h*c[i],Y[i],YdotRHS[i]);CHKERRQ(ierr);
+    if (tsdm) {
+      rk->stage_time = t + h*c[s-1];
+      ierr = (*tsdm->ops->rkstep)(ts,rk->tblock,t,h,s,A,tab->b,c,ts->vec_sol,YdotRHS,&stepped,tsdm->rkstepctx);CHKERRQ(ierr);
     }
+    if (!stepped) {
+      for (i=0; i<s; i++) {
+        rk->stage_time = t + h*c[i];
+        ierr = TSPreStage(ts,rk->stage_time);CHKERRQ(ierr);
+        ierr = VecCopy(ts->vec_sol,Y[i]);CHKERRQ(ierr);
+        for (j=0; j<i; j++) w[j] = h*A[i*s+j];
+        ierr = VecMAXPY(Y[i],i,w,YdotRHS);CHKERRQ(ierr);
+        ierr = TSPostStage(ts,rk->stage_time,i,Y);CHKERRQ(ierr);
+        ierr = TSGetAdapt(ts,&adapt);CHKERRQ(ierr);
+        ierr = TSAdaptCheckStage(adapt,ts,rk->stage_time,Y[i],&stageok);CHKERRQ(ierr);
+        if (!stageok) goto reject_step;
+        if (FSAL && !i) continue;
+        ierr = TSComputeRHSFunction(ts,t+h*c[i],Y[i],YdotRHS[i]);CHKERRQ(ierr);
+      }
 
-    rk->status = TS_STEP_INCOMPLETE;
-    ierr = TSEvaluateStep(ts,tab->order,ts->vec_sol,NULL);CHKERRQ(ierr);
+      rk->status = TS_STEP_INCOMPLETE;
+      ierr = TSEvaluateStep(ts,tab->order,ts->vec_sol,NULL);CHKERRQ(ierr);
+    }
     rk->status = TS_STEP_PENDING;
     ierr = TSGetAdapt(ts,&adapt);CHKERRQ(ierr);
     ierr = TSAdaptCandidatesClear(adapt);CHKERRQ(ierr);
@@ -1208,6 +1224,7 @@ static PetscErrorCode TSSetFromOptions_RK(PetscOptionItems *PetscOptionsObject,T
     if (flg) {ierr = TSRKSetType(ts,namelist[choice]);CHKERRQ(ierr);}
     ierr = PetscFree(namelist);CHKERRQ(ierr);
   }
+  ierr = PetscOptionsInt("-ts_rk_temporal_blocking","Steps per ghost update when the DM can advance the step locally","TSRKSetTemporalBlocking",rk->tblock,&rk->tblock,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsTail();CHKERRQ(ierr);
   ierr = PetscOptionsBegin(PetscObjectComm((PetscObject)ts),NULL,"Multirate methods options","");CHKERRQ(ierr);
   ierr = PetscOptionsInt("-ts_rk_dtratio","time step ratio between slow and fast","",rk->dtratio,&rk->dtratio,NULL);CHKERRQ(ierr);
@@ -1238,6 +1255,7 @@ static PetscErrorCode TSView_RK(TS ts,PetscViewer viewer)
     ierr = PetscViewerASCIIPrintf(viewer,"  FSAL property: %s\n",FSAL ? "yes" : "no");CHKERRQ(ierr);
     ierr = PetscFormatRealArray(buf,sizeof(buf),"% 8.6f",s,c);CHKERRQ(ierr);
     ierr = PetscViewerASCIIPrintf(viewer,"  Abscissa c = %s\n",buf);CHKERRQ(ierr);
+    if (rk->tblock) {ierr = PetscViewerASCIIPrintf(viewer,"  Temporal blocking: %D steps per ghost update\n",rk->tblock);CHKERRQ(ierr);}
   }
   PetscFunctionReturn(0);
 }
@@ -1399,6 +1417,8 @@ static PetscErrorCode TSDestroy_RK(TS ts)
   ierr = PetscObjectComposeFunction((PetscObject)ts,"TSRKGetType_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ts,"TSRKSetType_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ts,"TSRKGetTableau_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ts,"TSRKSetTemporalBlocking_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ts,"TSRKGetTemporalBlocking_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ts,"TSRKSetMultirate_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ts,"TSRKGetMultirate_C",NULL);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -1491,6 +1511,86 @@ PetscErrorCode TSRKGetMultirate(TS ts,PetscBool *use_multirate)
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode TSRKSetTemporalBlocking_RK(TS ts,PetscInt steps)
+{
+  TS_RK *rk = (TS_RK*)ts->data;
+
+  PetscFunctionBegin;
+  if (steps < 0) SETERRQ1(PetscObjectComm((PetscObject)ts),PETSC_ERR_ARG_OUTOFRANGE,"Number of steps %D cannot be negative",steps);
+  rk->tblock = steps;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSRKGetTemporalBlocking_RK(TS ts,PetscInt *steps)
+{
+  TS_RK *rk = (TS_RK*)ts->data;
+
+  PetscFunctionBegin;
+  *steps = rk->tblock;
+  PetscFunctionReturn(0);
+}
+
+/*@
+  TSRKSetTemporalBlocking - Lets the DM advance each RK step on a local copy of the solution whose ghost regions are
+  updated only every few steps
+
+  Logically collective
+
+  Input Parameters:
++  ts - timestepping context
+-  steps - the number of steps per ghost update, 0 to compute the stages with TSComputeRHSFunction() as usual
+
+  Options Database:
+.   -ts_rk_temporal_blocking <steps> - the number of steps per ghost update
+
+  Notes:
+  This requires a DM that can evaluate the right hand side on subsets of its local grid, currently a DMDA whose right
+  hand side was set with DMDATSSetRHSStencilLocal(). The ghost regions then hold steps times the number of stages
+  times the stencil width grid points, and the number of steps is reduced if the subdomains are too narrow for that.
+  The step is taken as usual if no such DM is present, or if pre- or post-stage callbacks, stage checks, a
+  trajectory, or forward sensitivities need the stage values, which the blocked step does not store.
+
+  Level: intermediate
+
+.seealso: TSRKGetTemporalBlocking(), DMDATSSetRHSStencilLocal()
+@*/
+PetscErrorCode TSRKSetTemporalBlocking(TS ts,PetscInt steps)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts,TS_CLASSID,1);
+  PetscValidLogicalCollectiveInt(ts,steps,2);
+  ierr = PetscTryMethod(ts,"TSRKSetTemporalBlocking_C",(TS,PetscInt),(ts,steps));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+  TSRKGetTemporalBlocking - Gets the number of steps per ghost update set with TSRKSetTemporalBlocking()
+
+  Not collective
+
+  Input Parameter:
+.  ts - timestepping context
+
+  Output Parameter:
+.  steps - the number of steps per ghost update, 0 if disabled
+
+  Level: intermediate
+
+.seealso: TSRKSetTemporalBlocking()
+@*/
+PetscErrorCode TSRKGetTemporalBlocking(TS ts,PetscInt *steps)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts,TS_CLASSID,1);
+  PetscValidIntPointer(steps,2);
+  ierr = PetscUseMethod(ts,"TSRKGetTemporalBlocking_C",(TS,PetscInt*),(ts,steps));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*MC
       TSRK - ODE and DAE solver using Runge-Kutta schemes
 
@@ -1503,7 +1603,8 @@ PetscErrorCode TSRKGetMultirate(TS ts,PetscBool *use_multirate)
   Level: beginner
 
 .seealso:  TSCreate(), TS, TSSetType(), TSRKSetType(), TSRKGetType(), TSRK2D, TTSRK2E, TSRK3,
-           TSRK4, TSRK5, TSRKPRSSP2, TSRKBPR3, TSRKType, TSRKRegister(), TSRKSetMultirate(), TSRKGetMultirate()
+           TSRK4, TSRK5, TSRKPRSSP2, TSRKBPR3, TSRKType, TSRKRegister(), TSRKSetMultirate(), TSRKGetMultirate(),
+           TSRKSetTemporalBlocking()
 
 M*/
 PETSC_EXTERN PetscErrorCode TSCreate_RK(TS ts)
@@ -1548,6 +1649,8 @@ PETSC_EXTERN PetscErrorCode TSCreate_RK(TS ts)
   ierr = PetscObjectComposeFunction((PetscObject)ts,"TSRKGetTableau_C",TSRKGetTableau_RK);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ts,"TSRKSetMultirate_C",TSRKSetMultirate_RK);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ts,"TSRKGetMultirate_C",TSRKGetMultirate_RK);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ts,"TSRKSetTemporalBlocking_C",TSRKSetTemporalBlocking_RK);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ts,"TSRKGetTemporalBlocking_C",TSRKGetTemporalBlocking_RK);CHKERRQ(ierr);
 
   ierr = TSRKSetType(ts,TSRKDefault);CHKERRQ(ierr);
   rk->dtratio = 1;
@@ -39,6 +39,7 @@ typedef struct {
   IS           is_fast,is_slow;
   TS           subts_fast,subts_slow,subts_current,ts_root;
   PetscBool    use_multirate;
+  PetscInt     tblock;           /* steps per ghost update when the DM advances the step locally, 0 to disable   */
   Mat          MatFwdSensip0;
   Mat          *MatsFwdStageSensip;
   Mat          *MatsFwdSensipTemp;
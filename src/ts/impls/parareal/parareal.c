@@ -0,0 +1,752 @@
+/*
+  Code for parallel-in-time integration with Parareal and two-level MGRIT
+*/
+#include <petsc/private/tsimpl.h>                /*I   "petscts.h"   I*/
+#include <petscdm.h>
+
+const char *const TSParaRealRelaxationTypes[] = {"F","FCF","TSParaRealRelaxationType","TS_PARAREAL_RELAXATION_",NULL};
+
+typedef struct {
+  TS                       fine,coarse;     /* propagators over one time slice, sharing the problem definition of the outer TS */
+  MPI_Comm                 tcomm;           /* the processes holding the same part of the state on each time group */
+  PetscMPIInt              trank,tsize;     /* this time group and the number of time groups */
+  PetscInt                 nslices,nlocal;  /* number of time slices in total and on this time group */
+  PetscInt                 coarsening;      /* ratio of the coarse to the fine time step */
+  PetscInt                 max_it,its;
+  PetscReal                rtol,atol;
+  TSParaRealRelaxationType relax;
+  PetscBool                monitor;
+  Vec                      *U;              /* state at the start of each local slice */
+  Vec                      *G;              /* coarse propagation of the previous start values */
+  Vec                      *F;              /* fine propagation of the previous start values */
+  Vec                      Uend,X,Xsend;
+  MPI_Request              sendreq;
+} TS_ParaReal;
+
+/* Advance X from t0 to t1 with the given propagator */
+static PetscErrorCode TSParaRealPropagate(TS sub,PetscReal t0,PetscReal t1,PetscReal dt,Vec X)
+{
+  TSConvergedReason reason;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = TSSetTime(sub,t0);CHKERRQ(ierr);
+  ierr = TSSetMaxTime(sub,t1);CHKERRQ(ierr);
+  ierr = TSSetTimeStep(sub,PetscMin(dt,t1-t0));CHKERRQ(ierr);
+  ierr = TSSetStepNumber(sub,0);CHKERRQ(ierr);
+  ierr = TSSolve(sub,X);CHKERRQ(ierr);
+  ierr = TSGetConvergedReason(sub,&reason);CHKERRQ(ierr);
+  if (reason < 0) SETERRQ3(PetscObjectComm((PetscObject)sub),PETSC_ERR_NOT_CONVERGED,"Propagator %s failed on the time slice [%g,%g]",((PetscObject)sub)->prefix,(double)t0,(double)t1);
+  PetscFunctionReturn(0);
+}
+
+/* Pass X on to the next time group; the send completes while this group carries on */
+static PetscErrorCode TSParaRealSend(TS ts,Vec X)
+{
+  TS_ParaReal       *pr = (TS_ParaReal*)ts->data;
+  const PetscScalar *x;
+  PetscInt          n;
+  PetscMPIInt       nn;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (pr->trank == pr->tsize-1) PetscFunctionReturn(0);
+  ierr = MPI_Wait(&pr->sendreq,MPI_STATUS_IGNORE);CHKERRMPI(ierr);
+  ierr = VecCopy(X,pr->Xsend);CHKERRQ(ierr);
+  ierr = VecGetLocalSize(X,&n);CHKERRQ(ierr);
+  ierr = PetscMPIIntCast(n,&nn);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(pr->Xsend,&x);CHKERRQ(ierr);
+  ierr = MPI_Isend((void*)x,nn,MPIU_SCALAR,pr->trank+1,0,pr->tcomm,&pr->sendreq);CHKERRMPI(ierr);
+  ierr = VecRestoreArrayRead(pr->Xsend,&x);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Receive X from the previous time group; the first time group keeps X */
+static PetscErrorCode TSParaRealRecv(TS ts,Vec X)
+{
+  TS_ParaReal    *pr = (TS_ParaReal*)ts->data;
+  PetscScalar    *x;
+  PetscInt       n;
+  PetscMPIInt    nn;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!pr->trank) PetscFunctionReturn(0);
+  ierr = VecGetLocalSize(X,&n);CHKERRQ(ierr);
+  ierr = PetscMPIIntCast(n,&nn);CHKERRQ(ierr);
+  ierr = VecGetArray(X,&x);CHKERRQ(ierr);
+  ierr = MPI_Recv(x,nn,MPIU_SCALAR,pr->trank-1,0,pr->tcomm,MPI_STATUS_IGNORE);CHKERRMPI(ierr);
+  ierr = VecRestoreArray(X,&x);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+  The sequential coarse sweep U_{n+1} = G(U_n) + F_n - G_n, pipelined over the time groups. The first sweep
+  (k = 0) is a plain coarse propagation. Returns the largest change of a slice end value and the largest
+  excess of that change over the tolerance.
+*/
+static PetscErrorCode TSParaRealSweep(TS ts,PetscInt k,PetscReal err[2])
+{
+  TS_ParaReal    *pr = (TS_ParaReal*)ts->data;
+  const PetscInt m = pr->nlocal;
+  PetscReal      T = (ts->max_time-ts->ptime)/pr->nslices,dtc = pr->coarsening*ts->time_step,lerr[2] = {0.0,PETSC_MIN_REAL},diff,nrm;
+  PetscInt       j;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecCopy(pr->U[0],pr->X);CHKERRQ(ierr);
+  ierr = TSParaRealRecv(ts,pr->X);CHKERRQ(ierr);
+  for (j=0; j<m; ++j) {
+    const PetscReal t = ts->ptime + (pr->trank*m+j)*T;
+    Vec             old = j < m-1 ? pr->U[j+1] : pr->Uend;
+
+    ierr = VecCopy(pr->X,pr->U[j]);CHKERRQ(ierr);
+    ierr = TSParaRealPropagate(pr->coarse,t,t+T,dtc,pr->X);CHKERRQ(ierr);
+    if (k) {
+      ierr = VecAXPY(pr->F[j],-1.0,pr->G[j]);CHKERRQ(ierr);
+      ierr = VecCopy(pr->X,pr->G[j]);CHKERRQ(ierr);
+      ierr = VecAXPY(pr->X,1.0,pr->F[j]);CHKERRQ(ierr);
+      /* the old end value is overwritten right after */
+      ierr = VecAXPY(old,-1.0,pr->X);CHKERRQ(ierr);
+      ierr = VecNorm(old,NORM_2,&diff);CHKERRQ(ierr);
+      ierr = VecNorm(pr->X,NORM_2,&nrm);CHKERRQ(ierr);
+      lerr[0] = PetscMax(lerr[0],diff);
+      lerr[1] = PetscMax(lerr[1],diff-(pr->atol+pr->rtol*nrm));
+    } else {
+      ierr = VecCopy(pr->X,pr->G[j]);CHKERRQ(ierr);
+    }
+  }
+  ierr = VecCopy(pr->X,pr->Uend);CHKERRQ(ierr);
+  ierr = TSParaRealSend(ts,pr->Uend);CHKERRQ(ierr);
+  if (pr->tsize > 1) {
+    ierr = MPIU_Allreduce(lerr,err,2,MPIU_REAL,MPIU_MAX,pr->tcomm);CHKERRMPI(ierr);
+  } else {
+    err[0] = lerr[0];
+    err[1] = lerr[1];
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Fine (F-relaxation) or coarse propagation of all local slices from their start values, concurrently on all time groups */
+static PetscErrorCode TSParaRealRelax(TS ts,TS sub,PetscReal dt,Vec *Y)
+{
+  TS_ParaReal    *pr = (TS_ParaReal*)ts->data;
+  PetscReal      T = (ts->max_time-ts->ptime)/pr->nslices;
+  PetscInt       j;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (j=0; j<pr->nlocal; ++j) {
+    const PetscReal t = ts->ptime + (pr->trank*pr->nlocal+j)*T;
+
+    ierr = VecCopy(pr->U[j],Y[j]);CHKERRQ(ierr);
+    ierr = TSParaRealPropagate(sub,t,t+T,dt,Y[j]);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSSolve_ParaReal(TS ts)
+{
+  TS_ParaReal    *pr = (TS_ParaReal*)ts->data;
+  const PetscInt m = pr->nlocal;
+  PetscReal      err[2];
+  PetscInt       j,k;
+  PetscBool      converged = PETSC_FALSE;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (ts->max_time >= PETSC_MAX_REAL) SETERRQ(PetscObjectComm((PetscObject)ts),PETSC_ERR_ARG_WRONGSTATE,"TSPARAREAL needs the final time from TSSetMaxTime() or -ts_max_time");
+  ierr = TSMonitor(ts,ts->steps,ts->ptime,ts->vec_sol);CHKERRQ(ierr);
+  ierr = VecCopy(ts->vec_sol,pr->U[0]);CHKERRQ(ierr);
+  ierr = TSParaRealSweep(ts,0,err);CHKERRQ(ierr);
+  for (k=1, pr->its=0; k<=pr->max_it && !converged; ++k) {
+    if (pr->relax == TS_PARAREAL_RELAXATION_FCF) {
+      /* F- and C-relaxation give new start values U_n = F(U_{n-1}), whose coarse propagation replaces the old one */
+      ierr = TSParaRealRelax(ts,pr->fine,ts->time_step,pr->F);CHKERRQ(ierr);
+      ierr = VecCopy(pr->F[m-1],pr->Uend);CHKERRQ(ierr);
+      for (j=m-1; j>0; --j) {ierr = VecCopy(pr->F[j-1],pr->U[j]);CHKERRQ(ierr);}
+      ierr = TSParaRealSend(ts,pr->Uend);CHKERRQ(ierr);
+      ierr = TSParaRealRecv(ts,pr->U[0]);CHKERRQ(ierr);
+      ierr = TSParaRealRelax(ts,pr->coarse,pr->coarsening*ts->time_step,pr->G);CHKERRQ(ierr);
+    }
+    ierr = TSParaRealRelax(ts,pr->fine,ts->time_step,pr->F);CHKERRQ(ierr);
+    ierr = TSParaRealSweep(ts,k,err);CHKERRQ(ierr);
+    pr->its = k;
+    if (pr->monitor && !pr->trank) {
+      ierr = PetscPrintf(PetscObjectComm((PetscObject)ts),"  %D TS Parareal correction norm %g\n",k,(double)err[0]);CHKERRQ(ierr);
+    }
+    /* each iteration makes one (F) or two (FCF) more slices exact */
+    converged = (PetscBool)(err[1] <= 0.0 || (pr->relax == TS_PARAREAL_RELAXATION_FCF ? 2*k : k) >= pr->nslices);
+  }
+  ierr = MPI_Wait(&pr->sendreq,MPI_STATUS_IGNORE);CHKERRMPI(ierr);
+  ierr = VecCopy(pr->Uend,ts->vec_sol);CHKERRQ(ierr);
+  if (pr->tsize > 1) {
+    PetscScalar *x;
+    PetscInt    n;
+    PetscMPIInt nn;
+
+    ierr = VecGetLocalSize(ts->vec_sol,&n);CHKERRQ(ierr);
+    ierr = PetscMPIIntCast(n,&nn);CHKERRQ(ierr);
+    ierr = VecGetArray(ts->vec_sol,&x);CHKERRQ(ierr);
+    ierr = MPI_Bcast(x,nn,MPIU_SCALAR,pr->tsize-1,pr->tcomm);CHKERRMPI(ierr);
+    ierr = VecRestoreArray(ts->vec_sol,&x);CHKERRQ(ierr);
+  }
+  ts->ptime  = ts->max_time;
+  ts->steps += pr->nslices;
+  ts->reason = converged ? TS_CONVERGED_TIME : TS_CONVERGED_ITS;
+  ierr = TSMonitor(ts,ts->steps,ts->ptime,ts->vec_sol);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* The fine and coarse TS get a copy of the DM sharing its DMTS, hence the problem definition, and their own Jacobian matrices */
+static PetscErrorCode TSParaRealSetUpSubTS(TS ts,TS sub,PetscBool copy)
+{
+  DM             dm,newdm;
+  TSIJacobian    ijacobian;
+  Mat            A = NULL,B = NULL;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = TSGetDM(ts,&dm);CHKERRQ(ierr);
+  ierr = DMClone(dm,&newdm);CHKERRQ(ierr);
+  ierr = DMCopyDMTS(dm,newdm);CHKERRQ(ierr);
+  ierr = TSSetDM(sub,newdm);CHKERRQ(ierr);
+  ierr = DMDestroy(&newdm);CHKERRQ(ierr);
+  ierr = TSSetApplicationContext(sub,ts->user);CHKERRQ(ierr);
+  ierr = TSSetProblemType(sub,ts->problem_type);CHKERRQ(ierr);
+  ierr = TSSetEquationType(sub,ts->equation_type);CHKERRQ(ierr);
+  ierr = TSSetExactFinalTime(sub,TS_EXACTFINALTIME_MATCHSTEP);CHKERRQ(ierr);
+  if (ts->Arhs || ts->Brhs) {
+    if (copy) {
+      if (ts->Arhs) {ierr = MatDuplicate(ts->Arhs,MAT_COPY_VALUES,&A);CHKERRQ(ierr);}
+      if (ts->Brhs == ts->Arhs) {ierr = PetscObjectReference((PetscObject)A);CHKERRQ(ierr); B = A;}
+      else if (ts->Brhs) {ierr = MatDuplicate(ts->Brhs,MAT_COPY_VALUES,&B);CHKERRQ(ierr);}
+      ierr = TSSetRHSJacobian(sub,A,B,NULL,NULL);CHKERRQ(ierr);
+      ierr = MatDestroy(&A);CHKERRQ(ierr);
+      ierr = MatDestroy(&B);CHKERRQ(ierr);
+    } else {
+      ierr = TSSetRHSJacobian(sub,ts->Arhs,ts->Brhs,NULL,NULL);CHKERRQ(ierr);
+    }
+  }
+  ierr = DMTSGetIJacobian(dm,&ijacobian,NULL);CHKERRQ(ierr);
+  if (ijacobian && ts->snes) {
+    Mat Ats,Bts;
+
+    ierr = SNESGetJacobian(ts->snes,&Ats,&Bts,NULL,NULL);CHKERRQ(ierr);
+    if (Ats || Bts) {
+      if (copy) {
+        if (Ats) {ierr = MatDuplicate(Ats,MAT_DO_NOT_COPY_VALUES,&A);CHKERRQ(ierr);}
+        if (Bts == Ats) {ierr = PetscObjectReference((PetscObject)A);CHKERRQ(ierr); B = A;}
+        else if (Bts) {ierr = MatDuplicate(Bts,MAT_DO_NOT_COPY_VALUES,&B);CHKERRQ(ierr);}
+        ierr = TSSetIJacobian(sub,A,B,NULL,NULL);CHKERRQ(ierr);
+        ierr = MatDestroy(&A);CHKERRQ(ierr);
+        ierr = MatDestroy(&B);CHKERRQ(ierr);
+      } else {
+        ierr = TSSetIJacobian(sub,Ats,Bts,NULL,NULL);CHKERRQ(ierr);
+      }
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSParaRealGetSubTS_ParaReal(TS ts,PetscBool coarse,TS *sub)
+{
+  TS_ParaReal    *pr = (TS_ParaReal*)ts->data;
+  TS             *s = coarse ? &pr->coarse : &pr->fine;
+  TSAdapt        adapt;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!*s) {
+    ierr = TSCreate(PetscObjectComm((PetscObject)ts),s);CHKERRQ(ierr);
+    ierr = PetscObjectIncrementTabLevel((PetscObject)*s,(PetscObject)ts,1);CHKERRQ(ierr);
+    ierr = PetscLogObjectParent((PetscObject)ts,(PetscObject)*s);CHKERRQ(ierr);
+    ierr = TSSetOptionsPrefix(*s,((PetscObject)ts)->prefix);CHKERRQ(ierr);
+    ierr = TSAppendOptionsPrefix(*s,coarse ? "parareal_coarse_" : "parareal_fine_");CHKERRQ(ierr);
+    ierr = TSSetType(*s,TSRK);CHKERRQ(ierr);
+    ierr = TSGetAdapt(*s,&adapt);CHKERRQ(ierr);
+    ierr = TSAdaptSetType(adapt,TSADAPTNONE);CHKERRQ(ierr);
+  }
+  *sub = *s;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSParaRealGetFineTS_ParaReal(TS ts,TS *fine)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = TSParaRealGetSubTS_ParaReal(ts,PETSC_FALSE,fine);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSParaRealGetCoarseTS_ParaReal(TS ts,TS *coarse)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = TSParaRealGetSubTS_ParaReal(ts,PETSC_TRUE,coarse);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSSetUp_ParaReal(TS ts)
+{
+  TS_ParaReal    *pr = (TS_ParaReal*)ts->data;
+  TS             sub;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!pr->nslices) pr->nslices = pr->tsize;
+  if (pr->nslices % pr->tsize) SETERRQ2(PetscObjectComm((PetscObject)ts),PETSC_ERR_ARG_INCOMP,"The number of time slices %D must be a multiple of the number of time groups %d",pr->nslices,pr->tsize);
+  pr->nlocal = pr->nslices/pr->tsize;
+  if (pr->tsize > 1) {
+    PetscInt n,nmin,nmax;
+
+    ierr = VecGetLocalSize(ts->vec_sol,&n);CHKERRQ(ierr);
+    ierr = MPIU_Allreduce(&n,&nmin,1,MPIU_INT,MPI_MIN,pr->tcomm);CHKERRMPI(ierr);
+    ierr = MPIU_Allreduce(&n,&nmax,1,MPIU_INT,MPI_MAX,pr->tcomm);CHKERRMPI(ierr);
+    if (nmin != nmax) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_INCOMP,"The solution must have the same parallel layout on every time group");
+  }
+  ierr = TSParaRealGetSubTS_ParaReal(ts,PETSC_FALSE,&sub);CHKERRQ(ierr);
+  ierr = TSParaRealSetUpSubTS(ts,sub,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = TSParaRealGetSubTS_ParaReal(ts,PETSC_TRUE,&sub);CHKERRQ(ierr);
+  ierr = TSParaRealSetUpSubTS(ts,sub,PETSC_TRUE);CHKERRQ(ierr);
+  ierr = VecDuplicateVecs(ts->vec_sol,pr->nlocal,&pr->U);CHKERRQ(ierr);
+  ierr = VecDuplicateVecs(ts->vec_sol,pr->nlocal,&pr->G);CHKERRQ(ierr);
+  ierr = VecDuplicateVecs(ts->vec_sol,pr->nlocal,&pr->F);CHKERRQ(ierr);
+  ierr = VecDuplicate(ts->vec_sol,&pr->Uend);CHKERRQ(ierr);
+  ierr = VecDuplicate(ts->vec_sol,&pr->X);CHKERRQ(ierr);
+  if (pr->tsize > 1) {ierr = VecDuplicate(ts->vec_sol,&pr->Xsend);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSReset_ParaReal(TS ts)
+{
+  TS_ParaReal    *pr = (TS_ParaReal*)ts->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MPI_Wait(&pr->sendreq,MPI_STATUS_IGNORE);CHKERRMPI(ierr);
+  ierr = VecDestroyVecs(pr->nlocal,&pr->U);CHKERRQ(ierr);
+  ierr = VecDestroyVecs(pr->nlocal,&pr->G);CHKERRQ(ierr);
+  ierr = VecDestroyVecs(pr->nlocal,&pr->F);CHKERRQ(ierr);
+  ierr = VecDestroy(&pr->Uend);CHKERRQ(ierr);
+  ierr = VecDestroy(&pr->X);CHKERRQ(ierr);
+  ierr = VecDestroy(&pr->Xsend);CHKERRQ(ierr);
+  pr->nlocal = 0;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSDestroy_ParaReal(TS ts)
+{
+  TS_ParaReal    *pr = (TS_ParaReal*)ts->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = TSReset_ParaReal(ts);CHKERRQ(ierr);
+  ierr = TSDestroy(&pr->fine);CHKERRQ(ierr);
+  ierr = TSDestroy(&pr->coarse);CHKERRQ(ierr);
+  if (pr->tcomm != MPI_COMM_NULL) {ierr = MPI_Comm_free(&pr->tcomm);CHKERRMPI(ierr);}
+  ierr = PetscFree(ts->data);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ts,"TSParaRealSetSubcomm_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ts,"TSParaRealSetNumSlices_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ts,"TSParaRealSetRelaxationType_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ts,"TSParaRealSetTolerances_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ts,"TSParaRealGetIterationNumber_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ts,"TSParaRealGetFineTS_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ts,"TSParaRealGetCoarseTS_C",NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSSetFromOptions_ParaReal(PetscOptionItems *PetscOptionsObject,TS ts)
+{
+  TS_ParaReal    *pr = (TS_ParaReal*)ts->data;
+  TS             sub;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"Parareal options");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-ts_parareal_num_slices","Number of time slices, a multiple of the number of time groups","TSParaRealSetNumSlices",pr->nslices,&pr->nslices,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnum("-ts_parareal_relaxation","Relaxation before each coarse sweep","TSParaRealSetRelaxationType",TSParaRealRelaxationTypes,(PetscEnum)pr->relax,(PetscEnum*)&pr->relax,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsReal("-ts_parareal_rtol","Relative tolerance for the change of the slice end values","TSParaRealSetTolerances",pr->rtol,&pr->rtol,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsReal("-ts_parareal_atol","Absolute tolerance for the change of the slice end values","TSParaRealSetTolerances",pr->atol,&pr->atol,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-ts_parareal_max_it","Maximum number of iterations","TSParaRealSetTolerances",pr->max_it,&pr->max_it,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-ts_parareal_coarsening","Ratio of the coarse to the fine time step","",pr->coarsening,&pr->coarsening,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-ts_parareal_monitor","Monitor the change of the slice end values","",pr->monitor,&pr->monitor,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  if (pr->coarsening < 1) SETERRQ1(PetscObjectComm((PetscObject)ts),PETSC_ERR_ARG_OUTOFRANGE,"The coarsening factor %D must be positive",pr->coarsening);
+  ierr = TSParaRealGetSubTS_ParaReal(ts,PETSC_FALSE,&sub);CHKERRQ(ierr);
+  ierr = TSSetFromOptions(sub);CHKERRQ(ierr);
+  ierr = TSParaRealGetSubTS_ParaReal(ts,PETSC_TRUE,&sub);CHKERRQ(ierr);
+  ierr = TSSetFromOptions(sub);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSView_ParaReal(TS ts,PetscViewer viewer)
+{
+  TS_ParaReal    *pr = (TS_ParaReal*)ts->data;
+  PetscBool      isascii;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&isascii);CHKERRQ(ierr);
+  if (isascii) {
+    ierr = PetscViewerASCIIPrintf(viewer,"  %D time slices on %d time groups, %s-relaxation\n",pr->nslices ? pr->nslices : pr->tsize,pr->tsize,TSParaRealRelaxationTypes[pr->relax]);CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPrintf(viewer,"  tolerances: relative=%g, absolute=%g, maximum iterations=%D\n",(double)pr->rtol,(double)pr->atol,pr->max_it);CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPrintf(viewer,"  coarse time step is %D fine time steps\n",pr->coarsening);CHKERRQ(ierr);
+    if (pr->fine) {
+      ierr = PetscViewerASCIIPrintf(viewer,"  Fine propagator\n");CHKERRQ(ierr);
+      ierr = PetscViewerASCIIPushTab(viewer);CHKERRQ(ierr);
+      ierr = TSView(pr->fine,viewer);CHKERRQ(ierr);
+      ierr = PetscViewerASCIIPopTab(viewer);CHKERRQ(ierr);
+    }
+    if (pr->coarse) {
+      ierr = PetscViewerASCIIPrintf(viewer,"  Coarse propagator\n");CHKERRQ(ierr);
+      ierr = PetscViewerASCIIPushTab(viewer);CHKERRQ(ierr);
+      ierr = TSView(pr->coarse,viewer);CHKERRQ(ierr);
+      ierr = PetscViewerASCIIPopTab(viewer);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSParaRealSetSubcomm_ParaReal(TS ts,PetscSubcomm psubcomm)
+{
+  TS_ParaReal    *pr = (TS_ParaReal*)ts->data;
+  PetscMPIInt    result,rank,size,sizes[2],gsizes[2];
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (ts->setupcalled) SETERRQ(PetscObjectComm((PetscObject)ts),PETSC_ERR_ARG_WRONGSTATE,"Must be called before TSSetUp()");
+  ierr = MPI_Comm_compare(PetscSubcommChild(psubcomm),PetscObjectComm((PetscObject)ts),&result);CHKERRMPI(ierr);
+  if (result != MPI_IDENT && result != MPI_CONGRUENT) SETERRQ(PetscObjectComm((PetscObject)ts),PETSC_ERR_ARG_NOTSAMECOMM,"The TS must live on the child communicator of the PetscSubcomm");
+  ierr = MPI_Comm_rank(PetscSubcommChild(psubcomm),&rank);CHKERRMPI(ierr);
+  ierr = MPI_Comm_size(PetscSubcommChild(psubcomm),&size);CHKERRMPI(ierr);
+  sizes[0] = size; sizes[1] = -size;
+  ierr = MPIU_Allreduce(sizes,gsizes,2,MPI_INT,MPI_MAX,PetscSubcommParent(psubcomm));CHKERRMPI(ierr);
+  if (gsizes[0] != -gsizes[1]) SETERRQ(PetscSubcommParent(psubcomm),PETSC_ERR_ARG_INCOMP,"All time groups of the PetscSubcomm must have the same number of processes");
+  if (pr->tcomm != MPI_COMM_NULL) {ierr = MPI_Comm_free(&pr->tcomm);CHKERRMPI(ierr);}
+  ierr = MPI_Comm_split(PetscSubcommParent(psubcomm),rank,psubcomm->color,&pr->tcomm);CHKERRMPI(ierr);
+  ierr = MPI_Comm_rank(pr->tcomm,&pr->trank);CHKERRMPI(ierr);
+  ierr = MPI_Comm_size(pr->tcomm,&pr->tsize);CHKERRMPI(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSParaRealSetNumSlices_ParaReal(TS ts,PetscInt nslices)
+{
+  TS_ParaReal *pr = (TS_ParaReal*)ts->data;
+
+  PetscFunctionBegin;
+  if (ts->setupcalled) SETERRQ(PetscObjectComm((PetscObject)ts),PETSC_ERR_ARG_WRONGSTATE,"Must be called before TSSetUp()");
+  pr->nslices = nslices == PETSC_DEFAULT ? 0 : nslices;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSParaRealSetRelaxationType_ParaReal(TS ts,TSParaRealRelaxationType relax)
+{
+  TS_ParaReal *pr = (TS_ParaReal*)ts->data;
+
+  PetscFunctionBegin;
+  pr->relax = relax;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSParaRealSetTolerances_ParaReal(TS ts,PetscReal rtol,PetscReal atol,PetscInt max_it)
+{
+  TS_ParaReal *pr = (TS_ParaReal*)ts->data;
+
+  PetscFunctionBegin;
+  if (rtol != PETSC_DEFAULT) pr->rtol = rtol;
+  if (atol != PETSC_DEFAULT) pr->atol = atol;
+  if (max_it != PETSC_DEFAULT) pr->max_it = max_it;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSParaRealGetIterationNumber_ParaReal(TS ts,PetscInt *its)
+{
+  TS_ParaReal *pr = (TS_ParaReal*)ts->data;
+
+  PetscFunctionBegin;
+  *its = pr->its;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   TSParaRealSetSubcomm - Distributes the time slices of TSPARAREAL over the children of a PetscSubcomm
+
+   Collective on the parent communicator of psubcomm
+
+   Input Parameters:
++  ts - the TS context, created on PetscSubcommChild(psubcomm)
+-  psubcomm - the split of a communicator into time groups, each holding the whole problem
+
+   Notes:
+   Every time group runs the same problem setup on its child communicator, so the solution vector has the same
+   parallel layout on every group. The slice end values are passed between the processes of neighbouring groups
+   holding the same part of the state; after TSSolve() every group has the solution at the final time.
+   Without a PetscSubcomm all time slices are integrated on the communicator of the TS.
+
+   Level: intermediate
+
+.seealso: TSPARAREAL, TSParaRealSetNumSlices(), PetscSubcommCreate(), PetscSubcommChild()
+@*/
+PetscErrorCode TSParaRealSetSubcomm(TS ts,PetscSubcomm psubcomm)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts,TS_CLASSID,1);
+  PetscValidPointer(psubcomm,2);
+  ierr = PetscTryMethod(ts,"TSParaRealSetSubcomm_C",(TS,PetscSubcomm),(ts,psubcomm));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   TSParaRealSetNumSlices - Sets the number of time slices of TSPARAREAL
+
+   Logically Collective on TS
+
+   Input Parameters:
++  ts - the TS context
+-  nslices - the number of time slices, a multiple of the number of time groups, or PETSC_DEFAULT for one slice per group
+
+   Options Database Key:
+.  -ts_parareal_num_slices <nslices> - the number of time slices
+
+   Level: intermediate
+
+.seealso: TSPARAREAL, TSParaRealSetSubcomm()
+@*/
+PetscErrorCode TSParaRealSetNumSlices(TS ts,PetscInt nslices)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts,TS_CLASSID,1);
+  PetscValidLogicalCollectiveInt(ts,nslices,2);
+  ierr = PetscTryMethod(ts,"TSParaRealSetNumSlices_C",(TS,PetscInt),(ts,nslices));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   TSParaRealSetRelaxationType - Sets the relaxation of TSPARAREAL before each coarse sweep
+
+   Logically Collective on TS
+
+   Input Parameters:
++  ts - the TS context
+-  relax - TS_PARAREAL_RELAXATION_F (Parareal) or TS_PARAREAL_RELAXATION_FCF (two-level MGRIT with FCF-relaxation)
+
+   Options Database Key:
+.  -ts_parareal_relaxation <F,FCF> - the relaxation type
+
+   Level: intermediate
+
+.seealso: TSPARAREAL, TSParaRealRelaxationType
+@*/
+PetscErrorCode TSParaRealSetRelaxationType(TS ts,TSParaRealRelaxationType relax)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts,TS_CLASSID,1);
+  PetscValidLogicalCollectiveEnum(ts,relax,2);
+  ierr = PetscTryMethod(ts,"TSParaRealSetRelaxationType_C",(TS,TSParaRealRelaxationType),(ts,relax));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   TSParaRealSetTolerances - Sets the convergence tolerances of TSPARAREAL
+
+   Logically Collective on TS
+
+   Input Parameters:
++  ts - the TS context
+.  rtol - the relative tolerance for the change of each slice end value
+.  atol - the absolute tolerance for the change of each slice end value
+-  max_it - the maximum number of iterations
+
+   Options Database Keys:
++  -ts_parareal_rtol <rtol> - the relative tolerance
+.  -ts_parareal_atol <atol> - the absolute tolerance
+-  -ts_parareal_max_it <max_it> - the maximum number of iterations
+
+   Notes:
+   Use PETSC_DEFAULT to keep a value. The iteration stops once no slice end value changes by more than
+   atol + rtol times its 2-norm, and at the latest when the result equals the sequential fine integration.
+
+   Level: intermediate
+
+.seealso: TSPARAREAL, TSParaRealGetIterationNumber()
+@*/
+PetscErrorCode TSParaRealSetTolerances(TS ts,PetscReal rtol,PetscReal atol,PetscInt max_it)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts,TS_CLASSID,1);
+  PetscValidLogicalCollectiveReal(ts,rtol,2);
+  PetscValidLogicalCollectiveReal(ts,atol,3);
+  PetscValidLogicalCollectiveInt(ts,max_it,4);
+  ierr = PetscTryMethod(ts,"TSParaRealSetTolerances_C",(TS,PetscReal,PetscReal,PetscInt),(ts,rtol,atol,max_it));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   TSParaRealGetIterationNumber - Gets the number of iterations of the last TSSolve() with TSPARAREAL
+
+   Not Collective
+
+   Input Parameter:
+.  ts - the TS context
+
+   Output Parameter:
+.  its - the number of iterations after the initial coarse sweep
+
+   Level: intermediate
+
+.seealso: TSPARAREAL, TSParaRealSetTolerances()
+@*/
+PetscErrorCode TSParaRealGetIterationNumber(TS ts,PetscInt *its)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts,TS_CLASSID,1);
+  PetscValidIntPointer(its,2);
+  ierr = PetscUseMethod(ts,"TSParaRealGetIterationNumber_C",(TS,PetscInt*),(ts,its));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   TSParaRealGetFineTS - Gets the TS that propagates over one time slice with the fine time step
+
+   Not Collective
+
+   Input Parameter:
+.  ts - the TS context
+
+   Output Parameter:
+.  fine - the fine propagator, using the options prefix -parareal_fine_
+
+   Notes:
+   It defaults to TSRK with constant time steps. Its problem definition is set from ts in TSSetUp().
+
+   Level: intermediate
+
+.seealso: TSPARAREAL, TSParaRealGetCoarseTS()
+@*/
+PetscErrorCode TSParaRealGetFineTS(TS ts,TS *fine)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts,TS_CLASSID,1);
+  PetscValidPointer(fine,2);
+  ierr = PetscUseMethod(ts,"TSParaRealGetFineTS_C",(TS,TS*),(ts,fine));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   TSParaRealGetCoarseTS - Gets the TS that propagates over one time slice with the coarse time step
+
+   Not Collective
+
+   Input Parameter:
+.  ts - the TS context
+
+   Output Parameter:
+.  coarse - the coarse propagator, using the options prefix -parareal_coarse_
+
+   Notes:
+   It defaults to TSRK with constant time steps. Its problem definition is set from ts in TSSetUp().
+
+   Level: intermediate
+
+.seealso: TSPARAREAL, TSParaRealGetFineTS()
+@*/
+PetscErrorCode TSParaRealGetCoarseTS(TS ts,TS *coarse)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ts,TS_CLASSID,1);
+  PetscValidPointer(coarse,2);
+  ierr = PetscUseMethod(ts,"TSParaRealGetCoarseTS_C",(TS,TS*),(ts,coarse));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*MC
+      TSPARAREAL - Parallel-in-time integration with Parareal or two-level MGRIT
+
+   The interval from the initial time to the final time is split into time slices. A cheap coarse propagator G
+   gives the start values U_n of all slices; then each iteration integrates all slices concurrently with the fine
+   propagator F and corrects the start values in a sequential coarse sweep
+
+$     U_{n+1} = G(U_n) + F(U_n^old) - G(U_n^old).
+
+   This is Parareal, that is two-level MGRIT with F-relaxation. With FCF-relaxation the fine propagation is done twice
+   per iteration, the second time from the start values U_n = F(U_{n-1}^old), which converges in fewer iterations.
+   After k iterations the first k (2k with FCF-relaxation) slices agree with the sequential fine integration.
+
+   The fine and coarse propagators are TS objects sharing the problem definition (the functions, Jacobians and
+   application context) of this TS; the fine one uses the time step of this TS, the coarse one a multiple of it.
+   For time parallel speedup, split the processes into time groups with a PetscSubcomm, set up the same problem on
+   each child communicator and pass the PetscSubcomm with TSParaRealSetSubcomm().
+
+   Options Database Keys:
++  -ts_parareal_num_slices <n> - number of time slices, a multiple of the number of time groups (default one per group)
+.  -ts_parareal_relaxation <F,FCF> - relaxation before each coarse sweep
+.  -ts_parareal_rtol <rtol> - relative tolerance for the change of the slice end values
+.  -ts_parareal_atol <atol> - absolute tolerance for the change of the slice end values
+.  -ts_parareal_max_it <its> - maximum number of iterations
+.  -ts_parareal_coarsening <c> - ratio of the coarse to the fine time step (default 10)
+.  -ts_parareal_monitor - print the largest change of a slice end value in each iteration
+.  -parareal_fine_ts_type <type> - the fine propagator
+-  -parareal_coarse_ts_type <type> - the coarse propagator
+
+   Notes:
+   TSPARAREAL needs the final time and does not support events, trajectories or sensitivity analysis.
+
+   Level: advanced
+
+.seealso:  TSCreate(), TS, TSSetType(), TSParaRealSetSubcomm(), TSParaRealSetRelaxationType(), TSParaRealSetTolerances(),
+           TSParaRealGetFineTS(), TSParaRealGetCoarseTS()
+
+M*/
+PETSC_EXTERN PetscErrorCode TSCreate_ParaReal(TS ts)
+{
+  TS_ParaReal    *pr;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ts->ops->reset          = TSReset_ParaReal;
+  ts->ops->destroy        = TSDestroy_ParaReal;
+  ts->ops->view           = TSView_ParaReal;
+  ts->ops->setup          = TSSetUp_ParaReal;
+  ts->ops->solve          = TSSolve_ParaReal;
+  ts->ops->setfromoptions = TSSetFromOptions_ParaReal;
+  ts->default_adapt_type  = TSADAPTNONE;
+
+  ierr = PetscNewLog(ts,&pr);CHKERRQ(ierr);
+  ts->data = (void*)pr;
+
+  pr->tcomm      = MPI_COMM_NULL;
+  pr->trank      = 0;
+  pr->tsize      = 1;
+  pr->coarsening = 10;
+  pr->max_it     = 100;
+  pr->rtol       = 1e-8;
+  pr->atol       = 1e-50;
+  pr->relax      = TS_PARAREAL_RELAXATION_F;
+  pr->sendreq    = MPI_REQUEST_NULL;
+
+  ierr = PetscObjectComposeFunction((PetscObject)ts,"TSParaRealSetSubcomm_C",TSParaRealSetSubcomm_ParaReal);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ts,"TSParaRealSetNumSlices_C",TSParaRealSetNumSlices_ParaReal);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ts,"TSParaRealSetRelaxationType_C",TSParaRealSetRelaxationType_ParaReal);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ts,"TSParaRealSetTolerances_C",TSParaRealSetTolerances_ParaReal);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ts,"TSParaRealGetIterationNumber_C",TSParaRealGetIterationNumber_ParaReal);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ts,"TSParaRealGetFineTS_C",TSParaRealGetFineTS_ParaReal);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ts,"TSParaRealGetCoarseTS_C",TSParaRealGetCoarseTS_ParaReal);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
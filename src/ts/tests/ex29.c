@@ -0,0 +1,200 @@
+static char help[] = "Tests the temporally blocked RK step of DMDATSSetRHSStencilLocal() against the regular one.\n\n";
+
+/*
+   u_t = kappa (Laplacian u + u_xy) + u (1 - u) + beta v    on [0,1]^dim, each component coupled to the next one,
+
+   with second (-s 1) or fourth (-s 2) order differences, and zero Dirichlet or periodic boundary conditions.
+*/
+
+#include <petscdmda.h>
+#include <petscts.h>
+#include <petsc/private/tsimpl.h>
+
+typedef struct {
+  PetscReal kappa,beta;
+  PetscInt  s;
+} AppCtx;
+
+/* wraps the blocked step of the DMDA to count the steps it actually took */
+typedef struct {
+  PetscErrorCode (*rkstep)(TS,PetscInt,PetscReal,PetscReal,PetscInt,const PetscReal[],const PetscReal[],const PetscReal[],Vec,Vec[],PetscBool*,void*);
+  void           *ctx;
+  PetscInt       nblocked;
+} BlockCtx;
+
+static PetscErrorCode CountedRKStep(TS ts,PetscInt nsteps,PetscReal t,PetscReal h,PetscInt s,const PetscReal A[],const PetscReal b[],const PetscReal c[],Vec X,Vec Ydot[],PetscBool *stepped,void *ctx)
+{
+  BlockCtx       *bctx = (BlockCtx*)ctx;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = (*bctx->rkstep)(ts,nsteps,t,h,s,A,b,c,X,Ydot,stepped,bctx->ctx);CHKERRQ(ierr);
+  if (*stepped) bctx->nblocked++;
+  PetscFunctionReturn(0);
+}
+
+/* value at a grid point, zero outside a non-periodic domain */
+static PetscScalar Val(DMDALocalInfo *info,void *x,PetscInt i,PetscInt j,PetscInt k,PetscInt c)
+{
+  if (info->bx != DM_BOUNDARY_PERIODIC && (i < 0 || i >= info->mx)) return 0.0;
+  if (info->dim > 1 && info->by != DM_BOUNDARY_PERIODIC && (j < 0 || j >= info->my)) return 0.0;
+  if (info->dim > 2 && info->bz != DM_BOUNDARY_PERIODIC && (k < 0 || k >= info->mz)) return 0.0;
+  if (info->dim == 1) return ((PetscScalar*)x)[i*info->dof+c];
+  if (info->dim == 2) return ((PetscScalar**)x)[j][i*info->dof+c];
+  return ((PetscScalar***)x)[k][j][i*info->dof+c];
+}
+
+static PetscErrorCode FormRHSLocal(DMDALocalInfo *info,PetscReal t,void *x,void *f,void *ctx)
+{
+  AppCtx          *user = (AppCtx*)ctx;
+  const PetscReal w1[] = {1.0,-2.0},w2[] = {-1.0/12,4.0/3,-5.0/2};
+  const PetscReal *wt = user->s == 1 ? w1 : w2;
+  const PetscInt  s = user->s,n[3] = {info->mx,info->my,info->mz};
+  PetscInt        i,j,k,c,d,q;
+
+  PetscFunctionBeginUser;
+  for (k = info->zs; k < info->zs+info->zm; ++k) {
+    for (j = info->ys; j < info->ys+info->ym; ++j) {
+      for (i = info->xs; i < info->xs+info->xm; ++i) {
+        for (c = 0; c < info->dof; ++c) {
+          PetscScalar u = Val(info,x,i,j,k,c),lap = 0.0,r;
+
+          for (d = 0; d < info->dim; ++d) {
+            PetscReal   h2 = 1.0/(PetscReal)(n[d]*n[d]);
+            PetscScalar v  = wt[s]*u;
+
+            for (q = 1; q <= s; ++q) {
+              PetscInt o[3] = {0,0,0};
+
+              o[d] = q;
+              v   += wt[s-q]*(Val(info,x,i+o[0],j+o[1],k+o[2],c) + Val(info,x,i-o[0],j-o[1],k-o[2],c));
+            }
+            lap += v/h2;
+          }
+          if (info->dim > 1) lap += 0.25*info->mx*info->my*(Val(info,x,i+1,j+1,k,c) - Val(info,x,i+1,j-1,k,c) - Val(info,x,i-1,j+1,k,c) + Val(info,x,i-1,j-1,k,c));
+          r = user->kappa*lap + u*(1.0 - u) + user->beta*Val(info,x,i,j,k,(c+1)%info->dof);
+          if (info->dim == 1)      ((PetscScalar*)f)[i*info->dof+c] = r;
+          else if (info->dim == 2) ((PetscScalar**)f)[j][i*info->dof+c] = r;
+          else                     ((PetscScalar***)f)[k][j][i*info->dof+c] = r;
+        }
+      }
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode Solve(DM da,PetscInt blocking,Vec u0,Vec u,PetscInt *nsteps,PetscInt *nattempts)
+{
+  TS             ts;
+  PetscInt       nrejects;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = TSCreate(PETSC_COMM_WORLD,&ts);CHKERRQ(ierr);
+  ierr = TSSetDM(ts,da);CHKERRQ(ierr);
+  ierr = TSSetType(ts,TSRK);CHKERRQ(ierr);
+  ierr = TSSetTimeStep(ts,1e-4);CHKERRQ(ierr);
+  ierr = TSSetMaxSteps(ts,20);CHKERRQ(ierr);
+  ierr = TSSetMaxTime(ts,1.0);CHKERRQ(ierr);
+  ierr = TSSetExactFinalTime(ts,TS_EXACTFINALTIME_STEPOVER);CHKERRQ(ierr);
+  ierr = TSSetFromOptions(ts);CHKERRQ(ierr);
+  ierr = TSRKSetTemporalBlocking(ts,blocking);CHKERRQ(ierr);
+  ierr = VecCopy(u0,u);CHKERRQ(ierr);
+  ierr = TSSolve(ts,u);CHKERRQ(ierr);
+  ierr = TSGetStepNumber(ts,nsteps);CHKERRQ(ierr);
+  ierr = TSGetStepRejections(ts,&nrejects);CHKERRQ(ierr);
+  *nattempts = *nsteps+nrejects;
+  ierr = TSDestroy(&ts);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  DM              da;
+  DMBoundaryType  bt = DM_BOUNDARY_NONE;
+  Vec             u0,u1,u2;
+  PetscRandom     rnd;
+  AppCtx          user;
+  BlockCtx        bctx;
+  DMTS            tsdm;
+  PetscInt        dim = 2,n = 16,dof = 1,blocking = 2,nsteps,nattempts;
+  PetscReal       nrm,err;
+  PetscErrorCode  ierr;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  user.kappa = 0.1;
+  user.beta  = 0.5;
+  user.s     = 1;
+  ierr = PetscOptionsBegin(PETSC_COMM_WORLD,NULL,"Temporal blocking test","TS");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-dim","The dimension","ex29.c",dim,&dim,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-n","The number of nodes in each direction","ex29.c",n,&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-dof","The number of components","ex29.c",dof,&dof,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsRangeInt("-s","The stencil width","ex29.c",user.s,&user.s,NULL,1,2);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-blocking","The number of steps per ghost update","ex29.c",blocking,&blocking,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnum("-boundary","The boundary type","ex29.c",DMBoundaryTypes,(PetscEnum)bt,(PetscEnum*)&bt,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();CHKERRQ(ierr);
+
+  if (dim == 1)      {ierr = DMDACreate1d(PETSC_COMM_WORLD,bt,n,dof,user.s,NULL,&da);CHKERRQ(ierr);}
+  else if (dim == 2) {ierr = DMDACreate2d(PETSC_COMM_WORLD,bt,bt,DMDA_STENCIL_BOX,n,n,PETSC_DECIDE,PETSC_DECIDE,dof,user.s,NULL,NULL,&da);CHKERRQ(ierr);}
+  else               {ierr = DMDACreate3d(PETSC_COMM_WORLD,bt,bt,bt,DMDA_STENCIL_BOX,n,n,n,PETSC_DECIDE,PETSC_DECIDE,PETSC_DECIDE,dof,user.s,NULL,NULL,NULL,&da);CHKERRQ(ierr);}
+  ierr = DMSetFromOptions(da);CHKERRQ(ierr);
+  ierr = DMSetUp(da);CHKERRQ(ierr);
+  ierr = DMDATSSetRHSStencilLocal(da,user.s,FormRHSLocal,&user);CHKERRQ(ierr);
+  ierr = DMGetDMTSWrite(da,&tsdm);CHKERRQ(ierr);
+  bctx.rkstep      = tsdm->ops->rkstep;
+  bctx.ctx         = tsdm->rkstepctx;
+  bctx.nblocked    = 0;
+  tsdm->ops->rkstep = CountedRKStep;
+  tsdm->rkstepctx   = &bctx;
+
+  ierr = DMCreateGlobalVector(da,&u0);CHKERRQ(ierr);
+  ierr = VecDuplicate(u0,&u1);CHKERRQ(ierr);
+  ierr = VecDuplicate(u0,&u2);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rnd);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rnd);CHKERRQ(ierr);
+  ierr = VecSetRandom(u0,rnd);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rnd);CHKERRQ(ierr);
+
+  ierr = Solve(da,0,u0,u1,&nsteps,&nattempts);CHKERRQ(ierr);
+  if (bctx.nblocked) SETERRQ1(PETSC_COMM_WORLD,PETSC_ERR_PLIB,"The regular solve took %D blocked steps",bctx.nblocked);
+  ierr = Solve(da,blocking,u0,u2,&nsteps,&nattempts);CHKERRQ(ierr);
+  /* the number of rejected steps depends on the scheme, so only report it when the blocked path missed some */
+  if (bctx.nblocked == nattempts) {ierr = PetscPrintf(PETSC_COMM_WORLD,"All %D steps were blocked\n",nsteps);CHKERRQ(ierr);}
+  else {ierr = PetscPrintf(PETSC_COMM_WORLD,"Only %D of %D step attempts were blocked\n",bctx.nblocked,nattempts);CHKERRQ(ierr);}
+  ierr = VecNorm(u1,NORM_INFINITY,&nrm);CHKERRQ(ierr);
+  ierr = VecAXPY(u2,-1.0,u1);CHKERRQ(ierr);
+  ierr = VecNorm(u2,NORM_INFINITY,&err);CHKERRQ(ierr);
+  /* the adaptive controllers amplify rounding differences, so this is looser than what fixed steps achieve */
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Blocked step %s the regular one\n",err <= 1e-10*nrm ? "matches" : "DIFFERS from");CHKERRQ(ierr);
+
+  ierr = VecDestroy(&u0);CHKERRQ(ierr);
+  ierr = VecDestroy(&u1);CHKERRQ(ierr);
+  ierr = VecDestroy(&u2);CHKERRQ(ierr);
+  ierr = DMDestroy(&da);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+  test:
+    suffix: 1d
+    nsize: {{1 3}}
+    args: -dim 1 -n 40 -dof 2 -s {{1 2}} -boundary {{none periodic}} -ts_rk_type {{1fe 3bs 4}}
+
+  test:
+    suffix: 2d
+    nsize: {{1 2 4}}
+    args: -n 32 -s {{1 2}} -boundary {{none periodic}} -ts_rk_type {{2a 3bs 5dp}} -da_ts_wavefront_rows 3
+
+  test:
+    suffix: 3d
+    nsize: {{1 8}}
+    args: -dim 3 -n 12 -dof 2 -boundary {{none periodic}} -ts_rk_type {{3 4}} -blocking {{1 3}}
+
+  test:
+    suffix: adapt
+    nsize: 2
+    args: -ts_rk_type 5dp -ts_adapt_type basic -ts_max_steps 40 -blocking 3 -da_ghost_exchange_datatypes
+
+TEST*/
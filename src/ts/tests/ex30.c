@@ -0,0 +1,172 @@
+static char help[] = "Tests TSPARAREAL against the sequential integration with its fine propagator.\n\n";
+
+/*
+   u_t = kappa u_xx + u (1 - u)    on [0,1] with u = 0 on the boundary,
+
+   integrated with the time slices distributed over -ntime groups of processes, each holding the whole grid.
+*/
+
+#include <petscdmda.h>
+#include <petscts.h>
+
+typedef struct {
+  PetscReal kappa;
+} AppCtx;
+
+static PetscErrorCode FormRHSLocal(DMDALocalInfo *info,PetscReal t,PetscScalar *u,PetscScalar *f,AppCtx *user)
+{
+  const PetscReal h2 = 1.0/((info->mx+1)*(info->mx+1));
+  PetscInt        i;
+
+  PetscFunctionBeginUser;
+  for (i = info->xs; i < info->xs+info->xm; ++i) {
+    const PetscScalar ul = i > 0 ? u[i-1] : 0.0,ur = i < info->mx-1 ? u[i+1] : 0.0;
+
+    f[i] = user->kappa*(ul - 2.0*u[i] + ur)/h2 + u[i]*(1.0 - u[i]);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode FormRHSJacobianLocal(DMDALocalInfo *info,PetscReal t,PetscScalar *u,Mat A,Mat B,AppCtx *user)
+{
+  const PetscReal h2 = 1.0/((info->mx+1)*(info->mx+1));
+  PetscInt        i,n,cols[3];
+  PetscScalar     vals[3];
+  PetscErrorCode  ierr;
+
+  PetscFunctionBeginUser;
+  for (i = info->xs; i < info->xs+info->xm; ++i) {
+    n = 0;
+    if (i > 0) {cols[n] = i-1; vals[n++] = user->kappa/h2;}
+    cols[n] = i; vals[n++] = -2.0*user->kappa/h2 + 1.0 - 2.0*u[i];
+    if (i < info->mx-1) {cols[n] = i+1; vals[n++] = user->kappa/h2;}
+    ierr = MatSetValues(B,1,&i,n,cols,vals,INSERT_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  if (A != B) {
+    ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode FormInitialSolution(DM da,Vec U)
+{
+  DMDALocalInfo  info;
+  PetscScalar    *u;
+  PetscInt       i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = DMDAGetLocalInfo(da,&info);CHKERRQ(ierr);
+  ierr = DMDAVecGetArray(da,U,&u);CHKERRQ(ierr);
+  for (i = info.xs; i < info.xs+info.xm; ++i) {
+    const PetscReal x = (i+1.0)/(info.mx+1);
+
+    u[i] = 0.5*PetscSinReal(PETSC_PI*x) + 0.25*PetscSinReal(3*PETSC_PI*x);
+  }
+  ierr = DMDAVecRestoreArray(da,U,&u);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode CreateProblem(MPI_Comm comm,AppCtx *user,DM *da)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBeginUser;
+  ierr = DMDACreate1d(comm,DM_BOUNDARY_NONE,64,1,1,NULL,da);CHKERRQ(ierr);
+  ierr = DMSetFromOptions(*da);CHKERRQ(ierr);
+  ierr = DMSetUp(*da);CHKERRQ(ierr);
+  ierr = DMDATSSetRHSFunctionLocal(*da,INSERT_VALUES,(DMDATSRHSFunctionLocal)FormRHSLocal,user);CHKERRQ(ierr);
+  ierr = DMDATSSetRHSJacobianLocal(*da,(DMDATSRHSJacobianLocal)FormRHSJacobianLocal,user);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  PetscSubcomm   psubcomm;
+  MPI_Comm       comm;
+  DM             da,daref;
+  TS             ts,ref;
+  TSAdapt        adapt;
+  Vec            U,Uref;
+  AppCtx         user;
+  PetscInt       ntime = 1,its;
+  PetscReal      nrm,err;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  user.kappa = 0.001;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-ntime",&ntime,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetReal(NULL,NULL,"-kappa",&user.kappa,NULL);CHKERRQ(ierr);
+  ierr = PetscSubcommCreate(PETSC_COMM_WORLD,&psubcomm);CHKERRQ(ierr);
+  ierr = PetscSubcommSetNumber(psubcomm,ntime);CHKERRQ(ierr);
+  ierr = PetscSubcommSetType(psubcomm,PETSC_SUBCOMM_CONTIGUOUS);CHKERRQ(ierr);
+  comm = PetscSubcommChild(psubcomm);
+
+  /* every time group sets up the same problem */
+  ierr = CreateProblem(comm,&user,&da);CHKERRQ(ierr);
+  ierr = DMCreateGlobalVector(da,&U);CHKERRQ(ierr);
+  ierr = VecDuplicate(U,&Uref);CHKERRQ(ierr);
+
+  ierr = TSCreate(comm,&ts);CHKERRQ(ierr);
+  ierr = TSSetDM(ts,da);CHKERRQ(ierr);
+  ierr = TSSetType(ts,TSPARAREAL);CHKERRQ(ierr);
+  ierr = TSParaRealSetSubcomm(ts,psubcomm);CHKERRQ(ierr);
+  ierr = TSSetMaxTime(ts,1.0);CHKERRQ(ierr);
+  ierr = TSSetTimeStep(ts,1.0/64);CHKERRQ(ierr);
+  ierr = TSSetExactFinalTime(ts,TS_EXACTFINALTIME_MATCHSTEP);CHKERRQ(ierr);
+  ierr = TSSetFromOptions(ts);CHKERRQ(ierr);
+  ierr = FormInitialSolution(da,U);CHKERRQ(ierr);
+  ierr = TSSolve(ts,U);CHKERRQ(ierr);
+  ierr = TSParaRealGetIterationNumber(ts,&its);CHKERRQ(ierr);
+
+  /* the same integration in one piece, set up from the options of the fine propagator */
+  ierr = CreateProblem(comm,&user,&daref);CHKERRQ(ierr);
+  ierr = TSCreate(comm,&ref);CHKERRQ(ierr);
+  ierr = TSSetDM(ref,daref);CHKERRQ(ierr);
+  ierr = TSSetOptionsPrefix(ref,"parareal_fine_");CHKERRQ(ierr);
+  ierr = TSSetType(ref,TSRK);CHKERRQ(ierr);
+  ierr = TSGetAdapt(ref,&adapt);CHKERRQ(ierr);
+  ierr = TSAdaptSetType(adapt,TSADAPTNONE);CHKERRQ(ierr);
+  ierr = TSSetMaxTime(ref,1.0);CHKERRQ(ierr);
+  ierr = TSSetTimeStep(ref,1.0/64);CHKERRQ(ierr);
+  ierr = TSSetExactFinalTime(ref,TS_EXACTFINALTIME_MATCHSTEP);CHKERRQ(ierr);
+  ierr = TSSetFromOptions(ref);CHKERRQ(ierr);
+  ierr = FormInitialSolution(daref,Uref);CHKERRQ(ierr);
+  ierr = TSSolve(ref,Uref);CHKERRQ(ierr);
+
+  ierr = VecNorm(Uref,NORM_2,&nrm);CHKERRQ(ierr);
+  ierr = VecAXPY(U,-1.0,Uref);CHKERRQ(ierr);
+  ierr = VecNorm(U,NORM_2,&err);CHKERRQ(ierr);
+  ierr = PetscPrintf(PetscSubcommParent(psubcomm),"Parareal solution after %D iterations %s the fine solution\n",its,err <= 1e-5*nrm ? "matches" : "DIFFERS from");CHKERRQ(ierr);
+
+  ierr = VecDestroy(&U);CHKERRQ(ierr);
+  ierr = VecDestroy(&Uref);CHKERRQ(ierr);
+  ierr = TSDestroy(&ts);CHKERRQ(ierr);
+  ierr = TSDestroy(&ref);CHKERRQ(ierr);
+  ierr = DMDestroy(&da);CHKERRQ(ierr);
+  ierr = DMDestroy(&daref);CHKERRQ(ierr);
+  ierr = PetscSubcommDestroy(&psubcomm);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+  test:
+    suffix: 1
+    args: -ts_parareal_num_slices 8 -ts_parareal_rtol 1e-7 -ts_parareal_monitor -ts_parareal_relaxation {{F FCF}separate output}
+
+  test:
+    suffix: 2
+    nsize: 4
+    args: -ntime 4 -ts_parareal_rtol 1e-7 -ts_parareal_relaxation {{F FCF}separate output}
+
+  test:
+    suffix: 3
+    nsize: 4
+    args: -ntime 2 -ts_parareal_num_slices 8 -ts_parareal_rtol 1e-7 -ts_parareal_coarsening 16 -parareal_coarse_ts_type beuler -parareal_fine_ts_type {{rk cn}separate output}
+
+TEST*/
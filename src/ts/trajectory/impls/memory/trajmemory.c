@@ -22,16 +22,20 @@ PETSC_STATIC_INLINE PetscErrorCode PetscRevolveIntCast(PetscInt a,PetscRevolveIn
 #if defined(PETSC_HAVE_CAMS)
 #include <offline_schedule.h>
 #endif
+#if defined(PETSC_HAVE_PTHREAD)
+#include <pthread.h>
+#endif
 
 PetscLogEvent TSTrajectory_DiskWrite, TSTrajectory_DiskRead;
 static PetscErrorCode TSTrajectorySet_Memory(TSTrajectory,TS,PetscInt,PetscReal,Vec);
 
-typedef enum {NONE,TWO_LEVEL_NOREVOLVE,TWO_LEVEL_REVOLVE,TWO_LEVEL_TWO_REVOLVE,REVOLVE_OFFLINE,REVOLVE_ONLINE,REVOLVE_MULTISTAGE,CAMS_OFFLINE} SchedulerType;
+typedef enum {NONE,MULTI_LEVEL,TWO_LEVEL_NOREVOLVE,TWO_LEVEL_REVOLVE,TWO_LEVEL_TWO_REVOLVE,REVOLVE_OFFLINE,REVOLVE_ONLINE,REVOLVE_MULTISTAGE,CAMS_OFFLINE} SchedulerType;
 
 typedef enum {UNSET=-1,SOLUTIONONLY=0,STAGESONLY=1,SOLUTION_STAGES=2} CheckpointType;
 
 typedef enum {TJ_REVOLVE, TJ_CAMS, TJ_PETSC} TSTrajectoryMemoryType;
 static const char *const TSTrajectoryMemoryTypes[] = {"REVOLVE","CAMS","PETSC","TSTrajectoryMemoryType","TJ_",NULL};
+const char *const TSTrajectoryCompressionTypes[] = {"NONE","LOSSLESS","LOSSY","TSTrajectoryCompressionType","TS_TRAJECTORY_COMPRESSION_",NULL};
 
 #define HaveSolution(m) ((m) == SOLUTIONONLY || (m) == SOLUTION_STAGES)
 #define HaveStages(m)   ((m) == STAGESONLY || (m) == SOLUTION_STAGES)
@@ -89,6 +93,98 @@ typedef struct _DiskStack {
   PetscInt  *container;
 } DiskStack;
 
+/*
+  Checkpoints on disk can also be kept in files of their own for each process, which are
+  written and read by a background thread and possibly compressed. A checkpoint file holds
+  the header, the records and the (encoded) local parts of their vectors, one after another.
+*/
+typedef struct _TJIORecord {
+  PetscInt  stepnum;
+  PetscInt  cptype;
+  PetscInt  offset;     /* position of the vectors of the record in the data */
+  PetscReal time;
+  PetscReal timeprev;
+} TJIORecord;
+
+typedef struct _TJIOHeader {
+  PetscInt  nrec;
+  PetscInt  ndata;      /* number of scalars in the data */
+  PetscInt  compression;
+  PetscReal tol;
+  size_t    nbytes;     /* size of the encoded data */
+} TJIOHeader;
+
+typedef enum {TJIO_IDLE,TJIO_WRITE,TJIO_READ} TJIOState;
+
+typedef struct _TJIOBuffer {
+  TJIOState     state;    /* the operation started last */
+  PetscBool     pending;  /* the operation has not been waited for */
+  PetscBool     threaded; /* the operation runs on the thread */
+  PetscBool     valid;    /* the buffer holds checkpoint file (kind,id) */
+  PetscInt      kind,id;  /* see TJIOFileName() */
+  PetscInt      lastuse;
+  TJIOHeader    hdr;
+  TJIORecord    *rec;
+  PetscScalar   *data;
+  unsigned char *bytes;
+  PetscInt      reccap,datacap;
+  size_t        bytecap;
+  char          filename[PETSC_MAX_PATH_LEN];
+  int           err;
+#if defined(PETSC_HAVE_PTHREAD)
+  pthread_t     thread;
+#endif
+} TJIOBuffer;
+
+typedef struct _TJIOFile {
+  PetscInt kind,id,nrec,ndata;
+} TJIOFile;
+
+typedef struct _TJIO {
+  PetscBool                   async;
+  TSTrajectoryCompressionType compression;
+  PetscReal                   tol;
+  PetscMPIInt                 rank;
+  TJIOBuffer                  buf[2]; /* one is filled or read while the other one is in use */
+  PetscInt                    clock;
+  TJIOFile                    *files; /* the checkpoint files on disk in the order they were written */
+  PetscInt                    nfiles,maxfiles;
+} TJIO;
+
+#define TJIOActive(io) ((io)->async || (io)->compression != TS_TRAJECTORY_COMPRESSION_NONE)
+
+/*
+  The multilevel schedule keeps solution checkpoints in RAM (level 0) and in files in up to
+  TJ_MAX_LEVELS-1 directories, say on a node-local SSD and on the parallel file system.
+  It reverses segments of steps: the checkpoint at step begin is stored at level src, and
+  the segment may store its checkpoints at the levels up to level, which has free slots left.
+*/
+#define TJ_MAX_LEVELS 4
+/* bound on the number of split points the multilevel schedule may try, about a few seconds of work */
+#define TJ_ML_MAX_WORK 1e9
+
+typedef struct _TJLevel {
+  char      dir[PETSC_MAX_PATH_LEN]; /* the trajectory directory if empty */
+  PetscInt  max_cps;
+  PetscReal wbw,rbw;                 /* write and read bandwidth in bytes per second, 0 if it costs nothing */
+} TJLevel;
+
+typedef struct _TJSegment {
+  PetscInt begin,len,src,level,free;
+} TJSegment;
+
+typedef struct _MLCTX {
+  PetscInt       nlevels;
+  TJLevel        level[TJ_MAX_LEVELS];
+  PetscInt       cap[TJ_MAX_LEVELS];      /* checkpoints at each level available to the schedule */
+  PetscInt       offset[TJ_MAX_LEVELS+1];
+  PetscReal      steptime;                /* time of a step, measured in the first one if not set */
+  PetscLogDouble tstart;
+  PetscInt       *choice;                 /* the optimal decision for each (len,src,level,free) */
+  TJSegment      *seg;                    /* the segments being reversed, innermost last */
+  PetscInt       nseg;
+} MLCTX;
+
 typedef struct _TJScheduler {
   SchedulerType stype;
   TSTrajectoryMemoryType tj_memory_type;
@@ -112,6 +208,8 @@ typedef struct _TJScheduler {
   Stack         stack;
   DiskStack     diskstack;
   PetscViewer   viewer;
+  TJIO          io;
+  MLCTX         ml;
 } TJScheduler;
 
 static PetscErrorCode TurnForwardWithStepsize(TS ts,PetscReal nextstepsize)
@@ -327,6 +425,571 @@ static PetscErrorCode StackFind(Stack *stack,StackElement *e,PetscInt index)
   PetscFunctionReturn(0);
 }
 
+#if defined(PETSC_USE_REAL_SINGLE)
+typedef uint32_t TJIOWord;
+#else
+typedef uint64_t TJIOWord;
+#endif
+
+/*
+  Each real number is turned into a 64-bit word: the XOR of its bits with those of the previous
+  number (lossless), or the difference of its rounding to a multiple of 2*tol and that of the previous
+  number, folded to be nonnegative (lossy). Words are stored as their nonzero low-order bytes, whose
+  count is kept in a 4-bit code; smooth data have many leading zero bytes.
+*/
+static size_t TJIOEncode(const TJIOHeader *hdr,const PetscScalar *data,unsigned char *bytes)
+{
+  const PetscReal *x = (const PetscReal*)data;
+  const size_t    n = (size_t)hdr->ndata*(sizeof(PetscScalar)/sizeof(PetscReal));
+  const PetscReal h = 2*hdr->tol;
+  size_t          i,pos = (n+1)/2;
+  TJIOWord        prev = 0;
+  int64_t         qprev = 0;
+  int             k,nb;
+
+  memset(bytes,0,(n+1)/2);
+  for (i=0; i<n; i++) {
+    uint64_t w;
+
+    if (hdr->compression == TS_TRAJECTORY_COMPRESSION_LOSSY) {
+      const int64_t q = (int64_t)PetscFloorReal(x[i]/h+0.5),d = q-qprev;
+
+      w     = d < 0 ? 2*(uint64_t)(-(d+1))+1 : 2*(uint64_t)d;
+      qprev = q;
+    } else {
+      TJIOWord v;
+
+      memcpy(&v,&x[i],sizeof(v));
+      w    = v^prev;
+      prev = v;
+    }
+    for (nb=0; nb<8 && (w>>(8*nb)); nb++) ;
+    bytes[i/2] |= (unsigned char)(nb<<(4*(i%2)));
+    for (k=0; k<nb; k++) bytes[pos++] = (unsigned char)(w>>(8*k));
+  }
+  return pos;
+}
+
+static void TJIODecode(const TJIOHeader *hdr,const unsigned char *bytes,PetscScalar *data)
+{
+  PetscReal       *x = (PetscReal*)data;
+  const size_t    n = (size_t)hdr->ndata*(sizeof(PetscScalar)/sizeof(PetscReal));
+  const PetscReal h = 2*hdr->tol;
+  size_t          i,pos = (n+1)/2;
+  TJIOWord        prev = 0;
+  int64_t         q = 0;
+  int             k,nb;
+
+  for (i=0; i<n; i++) {
+    uint64_t w = 0;
+
+    nb = (bytes[i/2]>>(4*(i%2))) & 15;
+    for (k=0; k<nb; k++) w |= (uint64_t)bytes[pos++]<<(8*k);
+    if (hdr->compression == TS_TRAJECTORY_COMPRESSION_LOSSY) {
+      q   += (w & 1) ? -(int64_t)(w>>1)-1 : (int64_t)(w>>1);
+      x[i] = h*(PetscReal)q;
+    } else {
+      prev ^= (TJIOWord)w;
+      memcpy(&x[i],&prev,sizeof(prev));
+    }
+  }
+}
+
+/* 2^-52: the rounded values are encoded in at most 52 bits, whatever the precision of PetscReal */
+#define TJIO_LOSSY_EPS ((PetscReal)(1.0/4503599627370496.0))
+
+/*
+  The rounded values have to fit into the mantissa, and into 52 bits; NaN and Inf do not. The folded differences
+  then have at most 2 more bits, so they fit into a TJIOWord and TJIOGetBuffer() allocates enough bytes for them.
+*/
+static PetscBool TJIOLossyFits(const TJIOHeader *hdr,const PetscScalar *data)
+{
+  const PetscReal *x = (const PetscReal*)data;
+  const size_t    n = (size_t)hdr->ndata*(sizeof(PetscScalar)/sizeof(PetscReal));
+  const PetscReal xmax = 2*hdr->tol/PetscMax(PETSC_MACHINE_EPSILON,TJIO_LOSSY_EPS);
+  size_t          i;
+
+  for (i=0; i<n; i++) if (!(PetscAbsReal(x[i]) < xmax)) return PETSC_FALSE;
+  return PETSC_TRUE;
+}
+
+/* These run on the I/O thread, so they only use the C library */
+static int TJIOWriteFile(TJIOBuffer *b)
+{
+  const void *payload = b->data;
+  FILE       *fp;
+  int        err = 0;
+
+  if (b->hdr.compression == TS_TRAJECTORY_COMPRESSION_LOSSY && !TJIOLossyFits(&b->hdr,b->data)) b->hdr.compression = TS_TRAJECTORY_COMPRESSION_LOSSLESS;
+  if (b->hdr.compression == TS_TRAJECTORY_COMPRESSION_NONE) b->hdr.nbytes = (size_t)b->hdr.ndata*sizeof(PetscScalar);
+  else {
+    b->hdr.nbytes = TJIOEncode(&b->hdr,b->data,b->bytes);
+    payload       = b->bytes;
+  }
+  fp = fopen(b->filename,"wb");
+  if (!fp) return 1;
+  if (fwrite(&b->hdr,sizeof(b->hdr),1,fp) != 1) err = 1;
+  else if (fwrite(b->rec,sizeof(TJIORecord),(size_t)b->hdr.nrec,fp) != (size_t)b->hdr.nrec) err = 1;
+  else if (b->hdr.nbytes && fwrite(payload,1,b->hdr.nbytes,fp) != b->hdr.nbytes) err = 1;
+  if (fclose(fp)) err = 1;
+  return err;
+}
+
+static int TJIOReadFile(TJIOBuffer *b)
+{
+  TJIOHeader hdr;
+  void       *payload;
+  size_t     cap;
+  FILE       *fp;
+  int        err = 0;
+
+  fp = fopen(b->filename,"rb");
+  if (!fp) return 1;
+  if (fread(&hdr,sizeof(hdr),1,fp) != 1 || hdr.nrec > b->reccap || hdr.ndata > b->datacap) err = 1;
+  else {
+    payload = hdr.compression == TS_TRAJECTORY_COMPRESSION_NONE ? (void*)b->data : (void*)b->bytes;
+    cap     = hdr.compression == TS_TRAJECTORY_COMPRESSION_NONE ? (size_t)b->datacap*sizeof(PetscScalar) : b->bytecap;
+    if (hdr.nbytes > cap || fread(b->rec,sizeof(TJIORecord),(size_t)hdr.nrec,fp) != (size_t)hdr.nrec) err = 1;
+    else if (hdr.nbytes && fread(payload,1,hdr.nbytes,fp) != hdr.nbytes) err = 1;
+    else {
+      if (hdr.compression != TS_TRAJECTORY_COMPRESSION_NONE) TJIODecode(&hdr,b->bytes,b->data);
+      b->hdr = hdr;
+    }
+  }
+  if (fclose(fp)) err = 1;
+  return err;
+}
+
+static void *TJIOWork(void *ctx)
+{
+  TJIOBuffer *b = (TJIOBuffer*)ctx;
+
+  b->err = b->state == TJIO_WRITE ? TJIOWriteFile(b) : TJIOReadFile(b);
+  return NULL;
+}
+
+static PetscErrorCode TJIOWait(TJIOBuffer *b)
+{
+  PetscFunctionBegin;
+  if (!b->pending) PetscFunctionReturn(0);
+#if defined(PETSC_HAVE_PTHREAD)
+  if (b->threaded) {
+    int err = pthread_join(b->thread,NULL);
+    if (err) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_SYS,"pthread_join() failed with error code %d",err);
+  }
+#endif
+  b->pending  = PETSC_FALSE;
+  b->threaded = PETSC_FALSE;
+  if (b->err) {
+    b->valid = PETSC_FALSE;
+    if (b->state == TJIO_WRITE) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_FILE_WRITE,"Could not write checkpoint file %s",b->filename);
+    SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_FILE_READ,"Could not read checkpoint file %s",b->filename);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TJIOStart(TJIO *io,TJIOBuffer *b,TJIOState state)
+{
+  TJIOFile       *f;
+  PetscInt       i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (state == TJIO_WRITE) { /* the file replaces an older one with the same id */
+    for (i=0; i<io->nfiles; i++) {
+      if (io->files[i].kind == b->kind && io->files[i].id == b->id) {
+        ierr = PetscArraymove(io->files+i,io->files+i+1,io->nfiles-i-1);CHKERRQ(ierr);
+        io->nfiles--;
+        break;
+      }
+    }
+    if (io->nfiles == io->maxfiles) {
+      TJIOFile *files;
+
+      io->maxfiles = PetscMax(2*io->maxfiles,16);
+      ierr = PetscMalloc1(io->maxfiles,&files);CHKERRQ(ierr);
+      ierr = PetscArraycpy(files,io->files,io->nfiles);CHKERRQ(ierr);
+      ierr = PetscFree(io->files);CHKERRQ(ierr);
+      io->files = files;
+    }
+    f        = &io->files[io->nfiles++];
+    f->kind  = b->kind;
+    f->id    = b->id;
+    f->nrec  = b->hdr.nrec;
+    f->ndata = b->hdr.ndata;
+  }
+  b->state    = state;
+  b->pending  = PETSC_TRUE;
+  b->threaded = PETSC_FALSE;
+  b->valid    = PETSC_TRUE;
+  b->err      = 0;
+#if defined(PETSC_HAVE_PTHREAD)
+  if (io->async && !pthread_create(&b->thread,NULL,TJIOWork,b)) {
+    b->threaded = PETSC_TRUE;
+    PetscFunctionReturn(0);
+  }
+#endif
+  TJIOWork(b);
+  ierr = TJIOWait(b);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Kind 0 is a dumped stack, 1 a single checkpoint and 1+k a checkpoint at storage level k of the multilevel schedule */
+static PetscErrorCode TJIOFileName(TSTrajectory tj,PetscInt kind,PetscInt id,char filename[],size_t len)
+{
+  TJScheduler    *tjsch = (TJScheduler*)tj->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (kind > 1) {
+    const char *dir = tjsch->ml.level[kind-1].dir[0] ? tjsch->ml.level[kind-1].dir : tj->dirname;
+
+    ierr = PetscSNPrintf(filename,len,"%s/TS-L%d-%06d-%d.bin",dir,(int)(kind-1),(int)id,(int)tjsch->io.rank);CHKERRQ(ierr);
+  } else {
+    ierr = PetscSNPrintf(filename,len,kind ? "%s/TS-CPS%06d-%d.bin" : "%s/TS-STACK%06d-%d.bin",tj->dirname,(int)id,(int)tjsch->io.rank);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Takes the buffer that already holds checkpoint file (kind,id), or else the least recently used one, once it is done */
+static PetscErrorCode TJIOGetBuffer(TSTrajectory tj,PetscInt kind,PetscInt id,PetscInt nrec,PetscInt ndata,TJIOBuffer **buf)
+{
+  TJScheduler    *tjsch = (TJScheduler*)tj->data;
+  TJIO           *io = &tjsch->io;
+  TJIOBuffer     *b = io->buf[0].lastuse <= io->buf[1].lastuse ? &io->buf[0] : &io->buf[1];
+  PetscInt       i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (i=0; i<2; i++) if (io->buf[i].valid && io->buf[i].kind == kind && io->buf[i].id == id) b = &io->buf[i];
+  ierr = TJIOWait(b);CHKERRQ(ierr);
+  b->valid = PETSC_FALSE;
+  if (nrec > b->reccap) {
+    ierr = PetscFree(b->rec);CHKERRQ(ierr);
+    ierr = PetscMalloc1(nrec,&b->rec);CHKERRQ(ierr);
+    b->reccap = nrec;
+  }
+  if (ndata > b->datacap || (io->compression != TS_TRAJECTORY_COMPRESSION_NONE && !b->bytes)) {
+    const size_t n = (size_t)ndata*(sizeof(PetscScalar)/sizeof(PetscReal));
+
+    ierr = PetscFree(b->data);CHKERRQ(ierr);
+    ierr = PetscMalloc1(ndata,&b->data);CHKERRQ(ierr);
+    b->datacap = ndata;
+    if (io->compression != TS_TRAJECTORY_COMPRESSION_NONE) {
+      ierr = PetscFree(b->bytes);CHKERRQ(ierr);
+      b->bytecap = (n+1)/2 + n*sizeof(TJIOWord);
+      ierr = PetscMalloc1(b->bytecap,&b->bytes);CHKERRQ(ierr);
+    }
+  }
+  ierr = TJIOFileName(tj,kind,id,b->filename,sizeof(b->filename));CHKERRQ(ierr);
+  b->kind            = kind;
+  b->id              = id;
+  b->lastuse         = ++io->clock;
+  b->hdr.nrec        = 0;
+  b->hdr.ndata       = 0;
+  b->hdr.compression = io->compression;
+  b->hdr.tol         = io->tol;
+  b->hdr.nbytes      = 0;
+  *buf               = b;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TJIOStartRead(TSTrajectory tj,PetscInt kind,PetscInt id,TJIOBuffer **buf)
+{
+  TJScheduler    *tjsch = (TJScheduler*)tj->data;
+  TJIO           *io = &tjsch->io;
+  TJIOFile       *f = NULL;
+  PetscInt       i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (i=0; i<io->nfiles; i++) if (io->files[i].kind == kind && io->files[i].id == id) f = &io->files[i];
+  if (!f) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Checkpoint %D has not been written to disk",id);
+  ierr = TJIOGetBuffer(tj,kind,id,f->nrec,f->ndata,buf);CHKERRQ(ierr);
+  ierr = TJIOStart(io,*buf,TJIO_READ);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+  Returns the buffer holding checkpoint file (kind,id), reading it if it is not in memory. The backward
+  sweep restores the checkpoints on disk in the reverse order of their creation, so with the thread
+  the next older one is read ahead into the other buffer. The current one stays in memory in case the
+  schedule restores it again.
+*/
+static PetscErrorCode TJIOLoad(TSTrajectory tj,PetscInt kind,PetscInt id,TJIOBuffer **buf)
+{
+  TJScheduler    *tjsch = (TJScheduler*)tj->data;
+  TJIO           *io = &tjsch->io;
+  TJIOBuffer     *b = NULL,*pb;
+  PetscInt       i,next = -1;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (i=0; i<2; i++) if (io->buf[i].valid && io->buf[i].kind == kind && io->buf[i].id == id) b = &io->buf[i];
+  if (b) {
+    if (b->state == TJIO_READ) {ierr = TJIOWait(b);CHKERRQ(ierr);}
+    b->lastuse = ++io->clock;
+  } else {
+    ierr = TJIOStartRead(tj,kind,id,&b);CHKERRQ(ierr);
+    ierr = TJIOWait(b);CHKERRQ(ierr);
+  }
+  if (io->async) {
+    for (i=0; i<io->nfiles; i++) if (io->files[i].kind == kind && io->files[i].id < id && io->files[i].id > next) next = io->files[i].id;
+    for (i=0; i<2; i++) if (io->buf[i].valid && io->buf[i].kind == kind && io->buf[i].id == next) next = -1;
+    if (next >= 0) {
+      if (tj->monitor) {
+        ierr = PetscViewerASCIIAddTab(tj->monitor,((PetscObject)tj)->tablevel);CHKERRQ(ierr);
+        ierr = PetscViewerASCIIPrintf(tj->monitor,"Prefetch checkpoint file %D\n",next);CHKERRQ(ierr);
+        ierr = PetscViewerASCIISubtractTab(tj->monitor,((PetscObject)tj)->tablevel);CHKERRQ(ierr);
+      }
+      ierr = TJIOStartRead(tj,kind,next,&pb);CHKERRQ(ierr);
+    }
+  }
+  *buf = b;
+  PetscFunctionReturn(0);
+}
+
+/* Deletes checkpoint file (kind,id) once the schedule no longer needs it */
+static PetscErrorCode TJIORemove(TSTrajectory tj,PetscInt kind,PetscInt id)
+{
+  TJScheduler    *tjsch = (TJScheduler*)tj->data;
+  TJIO           *io = &tjsch->io;
+  char           filename[PETSC_MAX_PATH_LEN];
+  PetscInt       i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (i=0; i<2; i++) {
+    if (io->buf[i].valid && io->buf[i].kind == kind && io->buf[i].id == id) {
+      ierr = TJIOWait(&io->buf[i]);CHKERRQ(ierr);
+      io->buf[i].valid = PETSC_FALSE;
+    }
+  }
+  for (i=0; i<io->nfiles; i++) {
+    if (io->files[i].kind == kind && io->files[i].id == id) {
+      ierr = PetscArraymove(io->files+i,io->files+i+1,io->nfiles-i-1);CHKERRQ(ierr);
+      io->nfiles--;
+      ierr = TJIOFileName(tj,kind,id,filename,sizeof(filename));CHKERRQ(ierr);
+      if (remove(filename)) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"Could not delete checkpoint file %s",filename);
+      break;
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TJIOReset(TJIO *io)
+{
+  PetscInt       i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (i=0; i<2; i++) {
+    ierr = TJIOWait(&io->buf[i]);CHKERRQ(ierr);
+    io->buf[i].valid = PETSC_FALSE;
+  }
+  io->nfiles = 0;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TJIODestroy(TJIO *io)
+{
+  PetscInt       i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = TJIOReset(io);CHKERRQ(ierr);
+  for (i=0; i<2; i++) {
+    ierr = PetscFree(io->buf[i].rec);CHKERRQ(ierr);
+    ierr = PetscFree(io->buf[i].data);CHKERRQ(ierr);
+    ierr = PetscFree(io->buf[i].bytes);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(io->files);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Number of vectors WriteToDisk() stores for a checkpoint */
+static PetscInt TJIORecordVecs(PetscBool stifflyaccurate,PetscInt numY,CheckpointType cptype)
+{
+  PetscInt n = HaveSolution(cptype) ? 1 : 0;
+
+  if (HaveStages(cptype)) n += (stifflyaccurate && HaveSolution(cptype) && numY) ? numY-1 : numY;
+  return n;
+}
+
+static PetscErrorCode TJIOPackVec(TJIOBuffer *b,Vec X)
+{
+  const PetscScalar *x;
+  PetscInt          n;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = VecGetLocalSize(X,&n);CHKERRQ(ierr);
+  if (b->hdr.ndata+n > b->datacap) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Checkpoint buffer is too small");
+  ierr = VecGetArrayRead(X,&x);CHKERRQ(ierr);
+  ierr = PetscArraycpy(b->data+b->hdr.ndata,x,n);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(X,&x);CHKERRQ(ierr);
+  b->hdr.ndata += n;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TJIOUnpackVec(TJIOBuffer *b,PetscInt *offset,Vec X)
+{
+  PetscScalar    *x;
+  PetscInt       n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecGetLocalSize(X,&n);CHKERRQ(ierr);
+  if (*offset+n > b->hdr.ndata) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"Checkpoint file %s is too short",b->filename);
+  ierr = VecGetArrayWrite(X,&x);CHKERRQ(ierr);
+  ierr = PetscArraycpy(x,b->data+*offset,n);CHKERRQ(ierr);
+  ierr = VecRestoreArrayWrite(X,&x);CHKERRQ(ierr);
+  *offset += n;
+  PetscFunctionReturn(0);
+}
+
+/* The counterparts of WriteToDisk() and ReadFromDisk() */
+static PetscErrorCode TJIOPackRecord(TJIOBuffer *b,PetscBool stifflyaccurate,PetscInt stepnum,PetscReal time,PetscReal timeprev,Vec X,Vec *Y,PetscInt numY,CheckpointType cptype)
+{
+  TJIORecord     *r = &b->rec[b->hdr.nrec++];
+  PetscInt       i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  r->stepnum  = stepnum;
+  r->cptype   = (PetscInt)cptype;
+  r->offset   = b->hdr.ndata;
+  r->time     = time;
+  r->timeprev = timeprev;
+  if (HaveSolution(cptype)) {
+    ierr = TJIOPackVec(b,X);CHKERRQ(ierr);
+  }
+  if (HaveStages(cptype)) {
+    for (i=0; i<numY; i++) {
+      if (stifflyaccurate && i == numY-1 && HaveSolution(cptype)) continue;
+      ierr = TJIOPackVec(b,Y[i]);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TJIOUnpackRecord(TJIOBuffer *b,PetscInt irec,PetscBool stifflyaccurate,PetscInt *stepnum,PetscReal *time,PetscReal *timeprev,Vec X,Vec *Y,PetscInt numY)
+{
+  const TJIORecord     *r = &b->rec[irec];
+  const CheckpointType cptype = (CheckpointType)r->cptype;
+  PetscInt             i,offset = r->offset;
+  PetscErrorCode       ierr;
+
+  PetscFunctionBegin;
+  *stepnum  = r->stepnum;
+  *time     = r->time;
+  *timeprev = r->timeprev;
+  if (HaveSolution(cptype)) {
+    ierr = TJIOUnpackVec(b,&offset,X);CHKERRQ(ierr);
+  }
+  if (HaveStages(cptype)) {
+    for (i=0; i<numY; i++) {
+      if (stifflyaccurate && i == numY-1 && HaveSolution(cptype)) continue;
+      ierr = TJIOUnpackVec(b,&offset,Y[i]);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TJIODumpStack(TSTrajectory tj,TS ts,Stack *stack,PetscInt id)
+{
+  TJScheduler    *tjsch = (TJScheduler*)tj->data;
+  TJIOBuffer     *b;
+  StackElement   e;
+  Vec            *Y;
+  PetscInt       i,n,nvecs,ndumped = stack->top+1;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = TSGetStages(ts,&stack->numY,&Y);CHKERRQ(ierr);
+  ierr = VecGetLocalSize(ts->vec_sol,&n);CHKERRQ(ierr);
+  nvecs = TJIORecordVecs(ts->stifflyaccurate,stack->numY,SOLUTION_STAGES);
+  for (i=0; i<ndumped; i++) nvecs += TJIORecordVecs(ts->stifflyaccurate,stack->numY,stack->container[i]->cptype);
+  ierr = PetscLogEventBegin(TSTrajectory_DiskWrite,tj,ts,0,0);CHKERRQ(ierr);
+  ierr = TJIOGetBuffer(tj,0,id,ndumped+1,nvecs*n,&b);CHKERRQ(ierr);
+  for (i=0; i<ndumped; i++) {
+    e    = stack->container[i];
+    ierr = TJIOPackRecord(b,ts->stifflyaccurate,e->stepnum,e->time,e->timeprev,e->X,e->Y,stack->numY,e->cptype);CHKERRQ(ierr);
+  }
+  /* save the last step for restart */
+  ierr = TJIOPackRecord(b,ts->stifflyaccurate,ts->steps,ts->ptime,ts->ptime_prev,ts->vec_sol,Y,stack->numY,SOLUTION_STAGES);CHKERRQ(ierr);
+  ierr = TJIOStart(&tjsch->io,b,TJIO_WRITE);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(TSTrajectory_DiskWrite,tj,ts,0,0);CHKERRQ(ierr);
+  for (i=0; i<ndumped; i++) {
+    ierr = StackPop(stack,&e);CHKERRQ(ierr);
+  }
+  tj->diskwrites += ndumped+1;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TJIOLoadStack(TSTrajectory tj,TS ts,Stack *stack,PetscInt id,PetscBool lastonly)
+{
+  TJIOBuffer     *b;
+  StackElement   e;
+  Vec            *Y;
+  PetscInt       i,last;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscLogEventBegin(TSTrajectory_DiskRead,tj,ts,0,0);CHKERRQ(ierr);
+  ierr = TJIOLoad(tj,0,id,&b);CHKERRQ(ierr);
+  last = b->hdr.nrec-1;
+  for (i=0; i<last && !lastonly; i++) {
+    ierr = ElementCreate(ts,(CheckpointType)b->rec[i].cptype,stack,&e);CHKERRQ(ierr);
+    ierr = StackPush(stack,e);CHKERRQ(ierr);
+    ierr = TJIOUnpackRecord(b,i,ts->stifflyaccurate,&e->stepnum,&e->time,&e->timeprev,e->X,e->Y,stack->numY);CHKERRQ(ierr);
+  }
+  /* load the last step into TS */
+  ierr = TSGetStages(ts,&stack->numY,&Y);CHKERRQ(ierr);
+  ierr = TJIOUnpackRecord(b,last,ts->stifflyaccurate,&ts->steps,&ts->ptime,&ts->ptime_prev,ts->vec_sol,Y,stack->numY);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(TSTrajectory_DiskRead,tj,ts,0,0);CHKERRQ(ierr);
+  tj->diskreads += lastonly ? 1 : last+1;
+  ierr = TurnBackward(ts);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TJIODumpSingle(TSTrajectory tj,TS ts,Stack *stack,PetscInt id)
+{
+  TJScheduler    *tjsch = (TJScheduler*)tj->data;
+  TJIOBuffer     *b;
+  Vec            *Y;
+  PetscInt       n,stepnum;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = TSGetStepNumber(ts,&stepnum);CHKERRQ(ierr);
+  ierr = TSGetStages(ts,&stack->numY,&Y);CHKERRQ(ierr);
+  ierr = VecGetLocalSize(ts->vec_sol,&n);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(TSTrajectory_DiskWrite,tj,ts,0,0);CHKERRQ(ierr);
+  ierr = TJIOGetBuffer(tj,1,id,1,n*TJIORecordVecs(ts->stifflyaccurate,stack->numY,SOLUTION_STAGES),&b);CHKERRQ(ierr);
+  ierr = TJIOPackRecord(b,ts->stifflyaccurate,stepnum,ts->ptime,ts->ptime_prev,ts->vec_sol,Y,stack->numY,SOLUTION_STAGES);CHKERRQ(ierr);
+  ierr = TJIOStart(&tjsch->io,b,TJIO_WRITE);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(TSTrajectory_DiskWrite,tj,ts,0,0);CHKERRQ(ierr);
+  tj->diskwrites++;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TJIOLoadSingle(TSTrajectory tj,TS ts,Stack *stack,PetscInt id)
+{
+  TJIOBuffer     *b;
+  Vec            *Y;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = TSGetStages(ts,&stack->numY,&Y);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(TSTrajectory_DiskRead,tj,ts,0,0);CHKERRQ(ierr);
+  ierr = TJIOLoad(tj,1,id,&b);CHKERRQ(ierr);
+  ierr = TJIOUnpackRecord(b,0,ts->stifflyaccurate,&ts->steps,&ts->ptime,&ts->ptime_prev,ts->vec_sol,Y,stack->numY);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(TSTrajectory_DiskRead,tj,ts,0,0);CHKERRQ(ierr);
+  tj->diskreads++;
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode WriteToDisk(PetscBool stifflyaccurate,PetscInt stepnum,PetscReal time,PetscReal timeprev,Vec X,Vec *Y,PetscInt numY,CheckpointType cptype,PetscViewer viewer)
 {
   PetscInt       i;
@@ -388,6 +1051,10 @@ static PetscErrorCode StackDumpAll(TSTrajectory tj,TS ts,Stack *stack,PetscInt i
     ierr = PetscViewerASCIIPrintf(tj->monitor,"Dump stack id %D to file\n",id);CHKERRQ(ierr);
     ierr = PetscViewerASCIIPopTab(tj->monitor);CHKERRQ(ierr);
   }
+  if (TJIOActive(&tjsch->io)) {
+    ierr = TJIODumpStack(tj,ts,stack,id);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = PetscSNPrintf(filename,sizeof(filename),"%s/TS-STACK%06d.bin",tj->dirname,id);CHKERRQ(ierr);
   ierr = PetscViewerFileSetName(tjsch->viewer,filename);CHKERRQ(ierr);
   ierr = PetscViewerSetUp(tjsch->viewer);CHKERRQ(ierr);
@@ -414,6 +1081,7 @@ static PetscErrorCode StackDumpAll(TSTrajectory tj,TS ts,Stack *stack,PetscInt i
 
 static PetscErrorCode StackLoadAll(TSTrajectory tj,TS ts,Stack *stack,PetscInt id)
 {
+  TJScheduler    *tjsch = (TJScheduler*)tj->data;
   Vec            *Y;
   PetscInt       i,nloaded,cptype_int;
   StackElement   e;
@@ -427,6 +1095,10 @@ static PetscErrorCode StackLoadAll(TSTrajectory tj,TS ts,Stack *stack,PetscInt i
     ierr = PetscViewerASCIIPrintf(tj->monitor,"Load stack from file\n");CHKERRQ(ierr);
     ierr = PetscViewerASCIISubtractTab(tj->monitor,((PetscObject)tj)->tablevel);CHKERRQ(ierr);
   }
+  if (TJIOActive(&tjsch->io)) {
+    ierr = TJIOLoadStack(tj,ts,stack,id,PETSC_FALSE);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = PetscSNPrintf(filename,sizeof filename,"%s/TS-STACK%06d.bin",tj->dirname,id);CHKERRQ(ierr);
   ierr = PetscViewerBinaryOpen(PetscObjectComm((PetscObject)tj),filename,FILE_MODE_READ,&viewer);CHKERRQ(ierr);
   ierr = PetscViewerBinarySetSkipInfo(viewer,PETSC_TRUE);CHKERRQ(ierr);
@@ -455,6 +1127,7 @@ static PetscErrorCode StackLoadAll(TSTrajectory tj,TS ts,Stack *stack,PetscInt i
 #if defined(PETSC_HAVE_REVOLVE)
 static PetscErrorCode StackLoadLast(TSTrajectory tj,TS ts,Stack *stack,PetscInt id)
 {
+  TJScheduler    *tjsch = (TJScheduler*)tj->data;
   Vec            *Y;
   PetscInt       size;
   PetscViewer    viewer;
@@ -472,6 +1145,10 @@ static PetscErrorCode StackLoadLast(TSTrajectory tj,TS ts,Stack *stack,PetscInt
     ierr = PetscViewerASCIIPrintf(tj->monitor,"Load last stack element from file\n");CHKERRQ(ierr);
     ierr = PetscViewerASCIISubtractTab(tj->monitor,((PetscObject)tj)->tablevel);CHKERRQ(ierr);
   }
+  if (TJIOActive(&tjsch->io)) {
+    ierr = TJIOLoadStack(tj,ts,stack,id,PETSC_TRUE);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = TSGetStages(ts,&stack->numY,&Y);CHKERRQ(ierr);
   ierr = VecGetSize(Y[0],&size);CHKERRQ(ierr);
   /* VecView writes to file two extra int's for class id and number of rows */
@@ -520,6 +1197,10 @@ static PetscErrorCode DumpSingle(TSTrajectory tj,TS ts,Stack *stack,PetscInt id)
     ierr = PetscViewerASCIIPrintf(tj->monitor,"Dump a single point from file\n");CHKERRQ(ierr);
     ierr = PetscViewerASCIISubtractTab(tj->monitor,((PetscObject)tj)->tablevel);CHKERRQ(ierr);
   }
+  if (TJIOActive(&tjsch->io)) {
+    ierr = TJIODumpSingle(tj,ts,stack,id);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = TSGetStepNumber(ts,&stepnum);CHKERRQ(ierr);
   ierr = PetscSNPrintf(filename,sizeof(filename),"%s/TS-CPS%06d.bin",tj->dirname,id);CHKERRQ(ierr);
   ierr = PetscViewerFileSetName(tjsch->viewer,filename);CHKERRQ(ierr);
@@ -535,6 +1216,7 @@ static PetscErrorCode DumpSingle(TSTrajectory tj,TS ts,Stack *stack,PetscInt id)
 
 static PetscErrorCode LoadSingle(TSTrajectory tj,TS ts,Stack *stack,PetscInt id)
 {
+  TJScheduler    *tjsch = (TJScheduler*)tj->data;
   Vec            *Y;
   PetscViewer    viewer;
   char           filename[PETSC_MAX_PATH_LEN];
@@ -546,6 +1228,10 @@ static PetscErrorCode LoadSingle(TSTrajectory tj,TS ts,Stack *stack,PetscInt id)
     ierr = PetscViewerASCIIPrintf(tj->monitor,"Load a single point from file\n");CHKERRQ(ierr);
     ierr = PetscViewerASCIISubtractTab(tj->monitor,((PetscObject)tj)->tablevel);CHKERRQ(ierr);
   }
+  if (TJIOActive(&tjsch->io)) {
+    ierr = TJIOLoadSingle(tj,ts,stack,id);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = PetscSNPrintf(filename,sizeof filename,"%s/TS-CPS%06d.bin",tj->dirname,id);CHKERRQ(ierr);
   ierr = PetscViewerBinaryOpen(PetscObjectComm((PetscObject)tj),filename,FILE_MODE_READ,&viewer);CHKERRQ(ierr);
   ierr = PetscViewerBinarySetSkipInfo(viewer,PETSC_TRUE);CHKERRQ(ierr);
@@ -1795,6 +2481,260 @@ static PetscErrorCode TSTrajectoryMemoryGet_AOF(TSTrajectory tj,TS ts,TJSchedule
 }
 #endif
 
+#define MLIndex(ml,l,s,k,c) ((((l)-1)*(ml)->nlevels+(s))*(ml)->offset[(ml)->nlevels]+(ml)->offset[k]+(c))
+
+/*
+  Computes the schedule with the least predicted time, in the spirit of H-Revolve. The cost of reversing a segment
+  of len steps whose first state is in memory is
+    a single step:                   one forward step
+    no free slots at level 0:        len(len+1)/2 forward steps and len-1 reads from src
+    descend to level-1:              the cost with all the slots of level-1
+    store a checkpoint j steps on:   j forward steps, a write at level, the cost of the remaining len-j steps
+                                     from there with one slot less, and a read from src followed by the cost
+                                     of the first j steps
+  Each process computes the same schedule.
+*/
+static PetscErrorCode MLSchedule(TSTrajectory tj,TS ts,TJScheduler *tjsch)
+{
+  MLCTX          *ml = &tjsch->ml;
+  const PetscInt N = tjsch->total_steps,K = ml->nlevels;
+  PetscReal      w[TJ_MAX_LEVELS],r[TJ_MAX_LEVELS],loc[2],glb[2],*cost,best,v;
+  PetscLogDouble tnow;
+  PetscInt       n,l,s,k,c,j,choice,nslots = 1;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscTime(&tnow);CHKERRQ(ierr);
+  ierr = VecGetLocalSize(ts->vec_sol,&n);CHKERRQ(ierr);
+  loc[0] = ml->steptime > 0 ? ml->steptime : (PetscReal)(tnow-ml->tstart);
+  loc[1] = (PetscReal)n*sizeof(PetscScalar);
+  ierr = MPIU_Allreduce(loc,glb,2,MPIU_REAL,MPIU_MAX,PetscObjectComm((PetscObject)tj));CHKERRMPI(ierr);
+  w[0] = r[0] = 0.0;
+  for (k=1; k<K; k++) {
+    w[k] = ml->level[k].wbw > 0 ? glb[1]/ml->level[k].wbw : 0.0;
+    r[k] = ml->level[k].rbw > 0 ? glb[1]/ml->level[k].rbw : 0.0;
+  }
+  ml->offset[0] = 0;
+  for (k=0; k<K; k++) {
+    ml->offset[k+1] = ml->offset[k]+ml->cap[k]+1;
+    nslots         += ml->cap[k];
+  }
+  if ((PetscReal)N*K*ml->offset[K] >= PETSC_MAX_INT) SETERRQ1(PetscObjectComm((PetscObject)tj),PETSC_ERR_ARG_OUTOFRANGE,"The multilevel schedule of %D steps is too large to compute",N);
+  ierr = PetscMalloc1(N*K*ml->offset[K],&cost);CHKERRQ(ierr);
+  ierr = PetscMalloc1(N*K*ml->offset[K],&ml->choice);CHKERRQ(ierr);
+  for (l=1; l<=N; l++) {
+    for (s=0; s<K; s++) {
+      for (k=0; k<K; k++) {
+        for (c=0; c<=ml->cap[k]; c++) {
+          best   = PETSC_MAX_REAL;
+          choice = -1; /* no checkpoint */
+          if (l == 1) best = glb[0];
+          else {
+            if (!k && !c) best = (l-1)*r[s]+glb[0]*l*(l+1)/2;
+            if (k && cost[MLIndex(ml,l,s,k-1,ml->cap[k-1])] < best) {
+              best   = cost[MLIndex(ml,l,s,k-1,ml->cap[k-1])];
+              choice = 0;
+            }
+            for (j=1; c && j<l; j++) {
+              v = j*glb[0]+w[k]+cost[MLIndex(ml,l-j,k,k,c-1)]+r[s]+cost[MLIndex(ml,j,s,k,c)];
+              if (v < best) {
+                best   = v;
+                choice = j;
+              }
+            }
+          }
+          cost[MLIndex(ml,l,s,k,c)]      = best;
+          ml->choice[MLIndex(ml,l,s,k,c)] = choice;
+        }
+      }
+    }
+  }
+  if (tj->monitor) {
+    ierr = PetscViewerASCIIAddTab(tj->monitor,((PetscObject)tj)->tablevel);CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPrintf(tj->monitor,"Multilevel schedule for %D steps with predicted cost %g s\n",N,(double)cost[MLIndex(ml,N,0,K-1,ml->cap[K-1])]);CHKERRQ(ierr);
+    ierr = PetscViewerASCIISubtractTab(tj->monitor,((PetscObject)tj)->tablevel);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(cost);CHKERRQ(ierr);
+  ierr = PetscMalloc1(nslots,&ml->seg);CHKERRQ(ierr);
+  ml->seg[0].begin = 0;
+  ml->seg[0].len   = N;
+  ml->seg[0].src   = 0;
+  ml->seg[0].level = K-1;
+  ml->seg[0].free  = ml->cap[K-1];
+  ml->nseg         = 1;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MLStore(TSTrajectory tj,TS ts,TJScheduler *tjsch,PetscInt level,PetscInt stepnum,PetscReal time,Vec X)
+{
+  Stack          *stack = &tjsch->stack;
+  StackElement   e;
+  TJIOBuffer     *b;
+  PetscInt       n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (tj->monitor) {
+    ierr = PetscViewerASCIIAddTab(tj->monitor,((PetscObject)tj)->tablevel);CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPrintf(tj->monitor,"Store checkpoint %D at level %D\n",stepnum,level);CHKERRQ(ierr);
+    ierr = PetscViewerASCIISubtractTab(tj->monitor,((PetscObject)tj)->tablevel);CHKERRQ(ierr);
+  }
+  if (!level) {
+    ierr = ElementCreate(ts,SOLUTIONONLY,stack,&e);CHKERRQ(ierr);
+    ierr = ElementSet(ts,stack,&e,stepnum,time,X);CHKERRQ(ierr);
+    ierr = StackPush(stack,e);CHKERRQ(ierr);
+  } else {
+    ierr = VecGetLocalSize(X,&n);CHKERRQ(ierr);
+    ierr = PetscLogEventBegin(TSTrajectory_DiskWrite,tj,ts,0,0);CHKERRQ(ierr);
+    ierr = TJIOGetBuffer(tj,1+level,stepnum,1,n,&b);CHKERRQ(ierr);
+    ierr = TJIOPackRecord(b,ts->stifflyaccurate,stepnum,time,ts->ptime_prev,X,NULL,0,SOLUTIONONLY);CHKERRQ(ierr);
+    ierr = TJIOStart(&tjsch->io,b,TJIO_WRITE);CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(TSTrajectory_DiskWrite,tj,ts,0,0);CHKERRQ(ierr);
+    tj->diskwrites++;
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Restores the first state of the innermost segment and turns forward to recompute from there */
+static PetscErrorCode MLRestore(TSTrajectory tj,TS ts,TJScheduler *tjsch,PetscInt stepnum)
+{
+  Stack          *stack = &tjsch->stack;
+  TJSegment      *seg = &tjsch->ml.seg[tjsch->ml.nseg-1];
+  StackElement   e;
+  TJIOBuffer     *b;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (tj->monitor) {
+    ierr = PetscViewerASCIIAddTab(tj->monitor,((PetscObject)tj)->tablevel);CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPrintf(tj->monitor,"Restore checkpoint %D from level %D\n",seg->begin,seg->src);CHKERRQ(ierr);
+    ierr = PetscViewerASCIISubtractTab(tj->monitor,((PetscObject)tj)->tablevel);CHKERRQ(ierr);
+  }
+  if (!seg->src) {
+    ierr = StackTop(stack,&e);CHKERRQ(ierr);
+    if (e->stepnum != seg->begin) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Inconsistent steps! %D != %D",seg->begin,e->stepnum);
+    ierr = UpdateTS(ts,stack,e,stepnum,PETSC_TRUE);CHKERRQ(ierr);
+    ierr = TurnForward(ts);CHKERRQ(ierr);
+  } else {
+    ierr = PetscLogEventBegin(TSTrajectory_DiskRead,tj,ts,0,0);CHKERRQ(ierr);
+    ierr = TJIOLoad(tj,1+seg->src,seg->begin,&b);CHKERRQ(ierr);
+    ierr = TJIOUnpackRecord(b,0,ts->stifflyaccurate,&ts->steps,&ts->ptime,&ts->ptime_prev,ts->vec_sol,NULL,0);CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(TSTrajectory_DiskRead,tj,ts,0,0);CHKERRQ(ierr);
+    tj->diskreads++;
+    ierr = TSSetTimeStep(ts,ts->ptime-ts->ptime_prev);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Stores the state at stepnum if the schedule splits a segment there */
+static PetscErrorCode MLSplit(TSTrajectory tj,TS ts,TJScheduler *tjsch,PetscInt stepnum,PetscReal time,Vec X)
+{
+  MLCTX          *ml = &tjsch->ml;
+  TJSegment      *seg;
+  PetscInt       j;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  while (ml->nseg) {
+    seg = &ml->seg[ml->nseg-1];
+    if (seg->len == 1) break;
+    j = ml->choice[MLIndex(ml,seg->len,seg->src,seg->level,seg->free)];
+    if (!j) { /* continue with the lower levels only */
+      seg->level--;
+      seg->free = ml->cap[seg->level];
+      continue;
+    }
+    if (j < 0 || seg->begin+j != stepnum) break;
+    ierr = MLStore(tj,ts,tjsch,seg->level,stepnum,time,X);CHKERRQ(ierr);
+    ml->seg[ml->nseg].begin = stepnum;
+    ml->seg[ml->nseg].len   = seg->len-j;
+    ml->seg[ml->nseg].src   = seg->level;
+    ml->seg[ml->nseg].level = seg->level;
+    ml->seg[ml->nseg].free  = seg->free-1;
+    ml->nseg++;
+    seg->len = j;
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Marks the last step of the innermost segment as reversed and discards its checkpoint when no segment needs it anymore */
+static PetscErrorCode MLAdvance(TSTrajectory tj,TJScheduler *tjsch)
+{
+  MLCTX          *ml = &tjsch->ml;
+  TJSegment      *seg = &ml->seg[ml->nseg-1];
+  StackElement   e;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (--seg->len) PetscFunctionReturn(0);
+  ml->nseg--;
+  if (ml->nseg && ml->seg[ml->nseg-1].begin == seg->begin) PetscFunctionReturn(0);
+  if (!seg->src) {
+    ierr = StackPop(&tjsch->stack,&e);CHKERRQ(ierr);
+  } else {
+    ierr = TJIORemove(tj,1+seg->src,seg->begin);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSTrajectoryMemorySet_ML(TSTrajectory tj,TS ts,TJScheduler *tjsch,PetscInt stepnum,PetscReal time,Vec X)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (ts->reason) {
+    if (stepnum != tjsch->total_steps) SETERRQ2(PetscObjectComm((PetscObject)tj),PETSC_ERR_SUP,"The multilevel schedule is for %D steps but the integration took %D",tjsch->total_steps,stepnum);
+    PetscFunctionReturn(0);
+  }
+  if (!tjsch->recompute) {
+    if (!stepnum) { /* the initial state stays in RAM until the end */
+      ierr = MLStore(tj,ts,tjsch,0,stepnum,time,X);CHKERRQ(ierr);
+      ierr = PetscTime(&tjsch->ml.tstart);CHKERRQ(ierr);
+      PetscFunctionReturn(0);
+    }
+    if (stepnum == 1) {ierr = MLSchedule(tj,ts,tjsch);CHKERRQ(ierr);}
+  }
+  ierr = MLSplit(tj,ts,tjsch,stepnum,time,X);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSTrajectoryMemoryGet_ML(TSTrajectory tj,TS ts,TJScheduler *tjsch,PetscInt stepnum)
+{
+  MLCTX          *ml = &tjsch->ml;
+  TJSegment      *seg = &ml->seg[ml->nseg-1];
+  PetscInt       j;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (ts->reason) PetscFunctionReturn(0);
+  if (!ml->nseg || seg->begin+seg->len != stepnum) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Step %D is not the next one of the multilevel schedule",stepnum);
+  if (stepnum == tjsch->total_steps) {
+    ierr = TurnBackward(ts);CHKERRQ(ierr);
+    ierr = MLAdvance(tj,tjsch);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  while (seg->len > 1 && !ml->choice[MLIndex(ml,seg->len,seg->src,seg->level,seg->free)]) {
+    seg->level--;
+    seg->free = ml->cap[seg->level];
+  }
+  j = seg->len > 1 ? ml->choice[MLIndex(ml,seg->len,seg->src,seg->level,seg->free)] : -1;
+  ierr = MLRestore(tj,ts,tjsch,stepnum);CHKERRQ(ierr);
+  if (j > 0) { /* advance to the step before, storing the checkpoints of the schedule on the way */
+    tjsch->skip_trajectory = PETSC_FALSE;
+    ierr = ReCompute(ts,tjsch,seg->begin,stepnum-1);CHKERRQ(ierr);
+    ierr = MLSplit(tj,ts,tjsch,stepnum-1,ts->ptime,ts->vec_sol);CHKERRQ(ierr);
+    ierr = TurnForward(ts);CHKERRQ(ierr);
+    tjsch->skip_trajectory = PETSC_TRUE;
+    ierr = ReCompute(ts,tjsch,stepnum-1,stepnum);CHKERRQ(ierr);
+  } else {
+    tjsch->skip_trajectory = PETSC_TRUE;
+    ierr = ReCompute(ts,tjsch,seg->begin,stepnum);CHKERRQ(ierr);
+  }
+  tjsch->skip_trajectory = PETSC_FALSE;
+  ierr = MLAdvance(tj,tjsch);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode TSTrajectorySet_Memory(TSTrajectory tj,TS ts,PetscInt stepnum,PetscReal time,Vec X)
 {
   TJScheduler *tjsch = (TJScheduler*)tj->data;
@@ -1818,6 +2758,10 @@ static PetscErrorCode TSTrajectorySet_Memory(TSTrajectory tj,TS ts,PetscInt step
       if (!tj->adjoint_solve_mode) SETERRQ(PetscObjectComm((PetscObject)tj),PETSC_ERR_SUP,"Not implemented");
       ierr = TSTrajectoryMemorySet_TLNR(tj,ts,tjsch,stepnum,time,X);CHKERRQ(ierr);
       break;
+    case MULTI_LEVEL:
+      if (!tj->adjoint_solve_mode) SETERRQ(PetscObjectComm((PetscObject)tj),PETSC_ERR_SUP,"Not implemented");
+      ierr = TSTrajectoryMemorySet_ML(tj,ts,tjsch,stepnum,time,X);CHKERRQ(ierr);
+      break;
 #if defined(PETSC_HAVE_REVOLVE)
     case TWO_LEVEL_REVOLVE:
       if (!tj->adjoint_solve_mode) SETERRQ(PetscObjectComm((PetscObject)tj),PETSC_ERR_SUP,"Not implemented");
@@ -1874,6 +2818,10 @@ static PetscErrorCode TSTrajectoryGet_Memory(TSTrajectory tj,TS ts,PetscInt step
       if (!tj->adjoint_solve_mode) SETERRQ(PetscObjectComm((PetscObject)tj),PETSC_ERR_SUP,"Not implemented");
       ierr = TSTrajectoryMemoryGet_TLNR(tj,ts,tjsch,stepnum);CHKERRQ(ierr);
       break;
+    case MULTI_LEVEL:
+      if (!tj->adjoint_solve_mode) SETERRQ(PetscObjectComm((PetscObject)tj),PETSC_ERR_SUP,"Not implemented");
+      ierr = TSTrajectoryMemoryGet_ML(tj,ts,tjsch,stepnum);CHKERRQ(ierr);
+      break;
 #if defined(PETSC_HAVE_REVOLVE)
     case TWO_LEVEL_REVOLVE:
       if (!tj->adjoint_solve_mode) SETERRQ(PetscObjectComm((PetscObject)tj),PETSC_ERR_SUP,"Not implemented");
@@ -1955,6 +2903,58 @@ static PetscErrorCode TSTrajectorySetMaxUnitsDisk_Memory(TSTrajectory tj,PetscIn
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode TSTrajectoryMemorySetAsyncIO_Memory(TSTrajectory tj,PetscBool flg)
+{
+  TJScheduler *tjsch = (TJScheduler*)tj->data;
+
+  PetscFunctionBegin;
+  tjsch->io.async = flg;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSTrajectoryMemorySetCompression_Memory(TSTrajectory tj,TSTrajectoryCompressionType type,PetscReal tol)
+{
+  TJScheduler *tjsch = (TJScheduler*)tj->data;
+
+  PetscFunctionBegin;
+  if (type != TS_TRAJECTORY_COMPRESSION_NONE && sizeof(PetscReal) != sizeof(TJIOWord)) SETERRQ(PetscObjectComm((PetscObject)tj),PETSC_ERR_SUP,"Checkpoint compression requires single or double precision");
+  if (tol != PETSC_DEFAULT) {
+    if (tol <= 0.0) SETERRQ1(PetscObjectComm((PetscObject)tj),PETSC_ERR_ARG_OUTOFRANGE,"Compression tolerance %g must be positive",(double)tol);
+    tjsch->io.tol = tol;
+  }
+  tjsch->io.compression = type;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSTrajectoryMemorySetStorageLevel_Memory(TSTrajectory tj,PetscInt level,const char dir[],PetscInt max_cps,PetscReal write_bw,PetscReal read_bw)
+{
+  TJScheduler    *tjsch = (TJScheduler*)tj->data;
+  TJLevel        *lev;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (tj->setupcalled) SETERRQ(PetscObjectComm((PetscObject)tj),PETSC_ERR_ARG_WRONGSTATE,"Cannot change the storage levels after TSTrajectory has been setup or used");
+  if (level < 1 || level >= TJ_MAX_LEVELS) SETERRQ2(PetscObjectComm((PetscObject)tj),PETSC_ERR_ARG_OUTOFRANGE,"Storage level %D must be in [1,%d)",level,TJ_MAX_LEVELS);
+  if (level > tjsch->ml.nlevels) SETERRQ1(PetscObjectComm((PetscObject)tj),PETSC_ERR_ARG_WRONGSTATE,"Storage level %D must be set first",tjsch->ml.nlevels);
+  if (max_cps < 0) SETERRQ1(PetscObjectComm((PetscObject)tj),PETSC_ERR_ARG_OUTOFRANGE,"Number of checkpoints %D cannot be negative",max_cps);
+  lev = &tjsch->ml.level[level];
+  ierr = PetscStrncpy(lev->dir,dir ? dir : "",sizeof(lev->dir));CHKERRQ(ierr);
+  lev->max_cps = max_cps;
+  lev->wbw     = write_bw;
+  lev->rbw     = read_bw;
+  tjsch->ml.nlevels = PetscMax(tjsch->ml.nlevels,level+1);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode TSTrajectoryMemorySetStepTime_Memory(TSTrajectory tj,PetscReal steptime)
+{
+  TJScheduler *tjsch = (TJScheduler*)tj->data;
+
+  PetscFunctionBegin;
+  tjsch->ml.steptime = steptime;
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode TSTrajectoryMemorySetType_Memory(TSTrajectory tj,TSTrajectoryMemoryType tj_memory_type)
 {
   TJScheduler *tjsch = (TJScheduler*)tj->data;
@@ -2020,6 +3020,154 @@ PetscErrorCode TSTrajectoryMemorySetType(TSTrajectory tj,TSTrajectoryMemoryType
   PetscFunctionReturn(0);
 }
 
+/*@
+   TSTrajectoryMemorySetAsyncIO - Sets whether the checkpoints that TSTRAJECTORYMEMORY stores on disk are written and read on a background thread
+
+   Logically Collective on TSTrajectory
+
+   Input Parameters:
++  tj - the TSTrajectory context
+-  flg - PETSC_TRUE to overlap the disk I/O with the time integration
+
+   Options Database Key:
+.  -ts_trajectory_memory_async_io - write and read ahead the checkpoints on a thread
+
+   Notes:
+   Each process then keeps its part of a checkpoint in a file of its own. The forward sweep copies a
+   checkpoint into one of two buffers and continues while a thread writes it, so it only waits if the
+   write from the buffer before is still in progress. When the adjoint sweep restores a checkpoint from
+   disk, the thread reads the next older one, which the schedule restores next, into the other buffer.
+
+   Without pthreads the files are written and read when the checkpoints are stored and restored.
+
+   Level: intermediate
+
+.seealso: TSTrajectoryMemorySetCompression(), TSTrajectorySetMaxCpsDisk()
+@*/
+PetscErrorCode TSTrajectoryMemorySetAsyncIO(TSTrajectory tj,PetscBool flg)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(tj,TSTRAJECTORY_CLASSID,1);
+  PetscValidLogicalCollectiveBool(tj,flg,2);
+  ierr = PetscTryMethod(tj,"TSTrajectoryMemorySetAsyncIO_C",(TSTrajectory,PetscBool),(tj,flg));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   TSTrajectoryMemorySetCompression - Sets how TSTRAJECTORYMEMORY compresses the checkpoints it stores on disk
+
+   Logically Collective on TSTrajectory
+
+   Input Parameters:
++  tj - the TSTrajectory context
+.  type - the TSTrajectoryCompressionType
+-  tol - the absolute accuracy of the values stored with TS_TRAJECTORY_COMPRESSION_LOSSY, or PETSC_DEFAULT
+
+   Options Database Keys:
++  -ts_trajectory_memory_compression <none,lossless,lossy> - the type of compression
+-  -ts_trajectory_memory_compression_tol <tol> - the accuracy of lossy compression
+
+   Notes:
+   Compressed checkpoints are kept in a file for each process as with TSTrajectoryMemorySetAsyncIO(). A lossy checkpoint
+   differs from the solution by at most tol in each entry; if an entry is too large in magnitude for this accuracy,
+   the checkpoint is stored without loss. The default tolerance is 1e-10.
+
+   Level: intermediate
+
+.seealso: TSTrajectoryMemorySetAsyncIO(), TSTrajectoryCompressionType
+@*/
+PetscErrorCode TSTrajectoryMemorySetCompression(TSTrajectory tj,TSTrajectoryCompressionType type,PetscReal tol)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(tj,TSTRAJECTORY_CLASSID,1);
+  PetscValidLogicalCollectiveEnum(tj,type,2);
+  PetscValidLogicalCollectiveReal(tj,tol,3);
+  ierr = PetscTryMethod(tj,"TSTrajectoryMemorySetCompression_C",(TSTrajectory,TSTrajectoryCompressionType,PetscReal),(tj,type,tol));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   TSTrajectoryMemorySetStorageLevel - Adds a directory, such as one on a node-local SSD or on the parallel file system, in which
+   TSTRAJECTORYMEMORY may keep checkpoints in addition to RAM
+
+   Logically Collective on TSTrajectory
+
+   Input Parameters:
++  tj - the TSTrajectory context
+.  level - the storage level, starting with 1 for the fastest one after RAM
+.  dir - the directory, which must exist on every process, or NULL for the trajectory directory
+.  max_cps - the maximum number of checkpoints at this level
+.  write_bw - the bandwidth in bytes per second at which each process writes a checkpoint, 0 if writing costs nothing
+-  read_bw - the bandwidth in bytes per second at which each process reads a checkpoint, 0 if reading costs nothing
+
+   Options Database Keys:
++  -ts_trajectory_memory_level_dirs <dir1,dir2,...> - the directories of the levels
+.  -ts_trajectory_memory_level_max_cps <n1,n2,...> - the maximum numbers of checkpoints, one for each level
+.  -ts_trajectory_memory_level_write_bandwidth <b1,b2,...> - the write bandwidths
+.  -ts_trajectory_memory_level_read_bandwidth <b1,b2,...> - the read bandwidths
+-  -ts_trajectory_memory_step_time <t> - see TSTrajectoryMemorySetStepTime()
+
+   Notes:
+   RAM is level 0, whose capacity is set with TSTrajectorySetMaxCpsRAM(); it must hold at least the initial condition.
+   When the steps do not all fit into RAM and the time step is fixed, the checkpoints are placed with a multilevel schedule
+   that minimizes the predicted time of the adjoint run, which consists of the recomputed steps and the time to write and
+   read the checkpoints. As in H-Revolve, a checkpoint at a slower level splits the steps into segments that are reversed
+   with the checkpoints of the faster levels. The schedule stores solutions only, recomputing the stages of a step before
+   its adjoint step. The files are written and read as those of TSTrajectoryMemorySetAsyncIO() and TSTrajectoryMemorySetCompression().
+
+   The schedule is computed after the first step. It tries every split point for every segment length, level and number
+   of free slots, that is N(N-1)/2 K (c_0+...+c_{K-1}) candidates for N steps, K levels and c_k checkpoints at level k.
+   TSSetUp() errors when this exceeds 1e9; reduce the number of steps or of checkpoints, or use the single level schedule.
+
+   Level: advanced
+
+.seealso: TSTrajectoryMemorySetStepTime(), TSTrajectorySetMaxCpsRAM(), TSTrajectoryMemorySetAsyncIO()
+@*/
+PetscErrorCode TSTrajectoryMemorySetStorageLevel(TSTrajectory tj,PetscInt level,const char dir[],PetscInt max_cps,PetscReal write_bw,PetscReal read_bw)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(tj,TSTRAJECTORY_CLASSID,1);
+  PetscValidLogicalCollectiveInt(tj,level,2);
+  PetscValidLogicalCollectiveInt(tj,max_cps,4);
+  PetscValidLogicalCollectiveReal(tj,write_bw,5);
+  PetscValidLogicalCollectiveReal(tj,read_bw,6);
+  ierr = PetscTryMethod(tj,"TSTrajectoryMemorySetStorageLevel_C",(TSTrajectory,PetscInt,const char[],PetscInt,PetscReal,PetscReal),(tj,level,dir,max_cps,write_bw,read_bw));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   TSTrajectoryMemorySetStepTime - Sets the time of a forward step that the multilevel schedule of TSTRAJECTORYMEMORY assumes
+
+   Logically Collective on TSTrajectory
+
+   Input Parameters:
++  tj - the TSTrajectory context
+-  steptime - the time in seconds, or 0 to measure the first step
+
+   Options Database Key:
+.  -ts_trajectory_memory_step_time <t> - the time of a step
+
+   Level: advanced
+
+.seealso: TSTrajectoryMemorySetStorageLevel()
+@*/
+PetscErrorCode TSTrajectoryMemorySetStepTime(TSTrajectory tj,PetscReal steptime)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(tj,TSTRAJECTORY_CLASSID,1);
+  PetscValidLogicalCollectiveReal(tj,steptime,2);
+  ierr = PetscTryMethod(tj,"TSTrajectoryMemorySetStepTime_C",(TSTrajectory,PetscReal),(tj,steptime));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@C
   TSTrajectorySetMaxCpsRAM - Set maximum number of checkpoints in RAM
 
@@ -2121,7 +3269,10 @@ static PetscErrorCode TSTrajectorySetFromOptions_Memory(PetscOptionItems *PetscO
   TJScheduler    *tjsch = (TJScheduler*)tj->data;
   PetscEnum      etmp;
   PetscInt       max_cps_ram,max_cps_disk,max_units_ram,max_units_disk;
-  PetscBool      flg;
+  PetscInt       i,nlevels,ndirs,nbw,max_cps[TJ_MAX_LEVELS-1];
+  PetscReal      tol,wbw[TJ_MAX_LEVELS-1],rbw[TJ_MAX_LEVELS-1];
+  char           *dirs[TJ_MAX_LEVELS-1];
+  PetscBool      flg,flg2,async;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
@@ -2153,6 +3304,34 @@ static PetscErrorCode TSTrajectorySetFromOptions_Memory(PetscOptionItems *PetscO
     if (flg) {
       ierr = TSTrajectoryMemorySetType(tj,(TSTrajectoryMemoryType)etmp);CHKERRQ(ierr);
     }
+    ierr = PetscOptionsBool("-ts_trajectory_memory_async_io","Write and read ahead the checkpoints on disk on a background thread","TSTrajectoryMemorySetAsyncIO",tjsch->io.async,&async,&flg);CHKERRQ(ierr);
+    if (flg) {
+      ierr = TSTrajectoryMemorySetAsyncIO(tj,async);CHKERRQ(ierr);
+    }
+    nlevels = TJ_MAX_LEVELS-1;
+    ierr = PetscOptionsIntArray("-ts_trajectory_memory_level_max_cps","Maximum number of checkpoints at each storage level after RAM","TSTrajectoryMemorySetStorageLevel",max_cps,&nlevels,&flg);CHKERRQ(ierr);
+    if (flg) {
+      ndirs = nbw = nlevels;
+      for (i=0; i<nlevels; i++) {
+        dirs[i] = NULL;
+        wbw[i]  = tjsch->ml.level[i+1].wbw;
+        rbw[i]  = tjsch->ml.level[i+1].rbw;
+      }
+      ierr = PetscOptionsStringArray("-ts_trajectory_memory_level_dirs","Directory of each storage level","TSTrajectoryMemorySetStorageLevel",dirs,&ndirs,NULL);CHKERRQ(ierr);
+      ierr = PetscOptionsRealArray("-ts_trajectory_memory_level_write_bandwidth","Write bandwidth in bytes per second of each storage level","TSTrajectoryMemorySetStorageLevel",wbw,&nbw,NULL);CHKERRQ(ierr);
+      nbw  = nlevels;
+      ierr = PetscOptionsRealArray("-ts_trajectory_memory_level_read_bandwidth","Read bandwidth in bytes per second of each storage level","TSTrajectoryMemorySetStorageLevel",rbw,&nbw,NULL);CHKERRQ(ierr);
+      for (i=0; i<nlevels; i++) {
+        ierr = TSTrajectoryMemorySetStorageLevel(tj,i+1,i < ndirs ? dirs[i] : NULL,max_cps[i],wbw[i],rbw[i]);CHKERRQ(ierr);
+        ierr = PetscFree(dirs[i]);CHKERRQ(ierr);
+      }
+    }
+    ierr = PetscOptionsReal("-ts_trajectory_memory_step_time","Time of a step assumed by the multilevel schedule","TSTrajectoryMemorySetStepTime",tjsch->ml.steptime,&tjsch->ml.steptime,NULL);CHKERRQ(ierr);
+    ierr = PetscOptionsEnum("-ts_trajectory_memory_compression","Compression of the checkpoints on disk","TSTrajectoryMemorySetCompression",TSTrajectoryCompressionTypes,(PetscEnum)tjsch->io.compression,&etmp,&flg);CHKERRQ(ierr);
+    ierr = PetscOptionsReal("-ts_trajectory_memory_compression_tol","Absolute accuracy of lossy compression","TSTrajectoryMemorySetCompression",tjsch->io.tol,&tol,&flg2);CHKERRQ(ierr);
+    if (flg || flg2) {
+      ierr = TSTrajectoryMemorySetCompression(tj,flg ? (TSTrajectoryCompressionType)etmp : tjsch->io.compression,flg2 ? tol : PETSC_DEFAULT);CHKERRQ(ierr);
+    }
   }
   ierr = PetscOptionsTail();CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -2205,6 +3384,8 @@ static PetscErrorCode TSTrajectorySetUp_Memory(TSTrajectory tj,TS ts)
     if (fixedtimestep) {
       if (tjsch->max_cps_ram >= tjsch->total_steps-1 || tjsch->max_cps_ram == -1)
         tjsch->stype = NONE; /* checkpoint all */
+      else if (tjsch->ml.nlevels > 1)
+        tjsch->stype = MULTI_LEVEL;
       else { /* choose the schedule software for offline checkpointing */
         switch (tjsch->tj_memory_type) {
           case TJ_PETSC:
@@ -2226,7 +3407,20 @@ static PetscErrorCode TSTrajectorySetUp_Memory(TSTrajectory tj,TS ts)
 #endif
     if (tjsch->stype != NONE && tjsch->max_cps_ram < 1 && tjsch->max_cps_disk < 1) SETERRQ(PetscObjectComm((PetscObject)ts),PETSC_ERR_ARG_INCOMP,"The specified storage capacity is insufficient for one checkpoint, which is the minimum");
   }
-  if (tjsch->stype >= CAMS_OFFLINE) {
+  if (tjsch->stype == MULTI_LEVEL) {
+    PetscInt  k;
+    PetscReal work = 0.0;
+
+    if (tjsch->max_cps_ram < 1) SETERRQ(PetscObjectComm((PetscObject)ts),PETSC_ERR_ARG_INCOMP,"The multilevel schedule needs RAM for at least the initial condition");
+    tjsch->ml.cap[0] = tjsch->max_cps_ram-1;
+    for (k=1; k<tjsch->ml.nlevels; k++) tjsch->ml.cap[k] = tjsch->ml.level[k].max_cps;
+    tjsch->ml.nseg = 0;
+    /* MLSchedule() tries every split point; refuse up front rather than stall at the first step */
+    for (k=0; k<tjsch->ml.nlevels; k++) work += tjsch->ml.cap[k];
+    work *= 0.5*tjsch->total_steps*(tjsch->total_steps-1)*tjsch->ml.nlevels;
+    ierr = PetscInfo2(tj,"Multilevel schedule of %D steps tries %g split points\n",tjsch->total_steps,(double)work);CHKERRQ(ierr);
+    if (work > TJ_ML_MAX_WORK) SETERRQ3(PetscObjectComm((PetscObject)ts),PETSC_ERR_ARG_OUTOFRANGE,"The multilevel schedule of %D steps would try %g > %g split points; reduce the number of steps or of checkpoints, or use a single storage level",tjsch->total_steps,(double)work,(double)TJ_ML_MAX_WORK);
+  } else if (tjsch->stype >= CAMS_OFFLINE) {
 #ifndef PETSC_HAVE_CAMS
     SETERRQ(PetscObjectComm((PetscObject)ts),PETSC_ERR_SUP,"CAMS is needed when there is not enough memory to checkpoint all time steps according to the user's settings, please reconfigure with the additional option --download-cams.");
 #else
@@ -2327,8 +3521,16 @@ static PetscErrorCode TSTrajectorySetUp_Memory(TSTrajectory tj,TS ts)
     }
   }
 
-  if ((tjsch->stype >= TWO_LEVEL_NOREVOLVE && tjsch->stype < REVOLVE_OFFLINE) || tjsch->stype == REVOLVE_MULTISTAGE) { /* these types need to use disk */
+  if ((tjsch->stype >= TWO_LEVEL_NOREVOLVE && tjsch->stype < REVOLVE_OFFLINE) || tjsch->stype == REVOLVE_MULTISTAGE || tjsch->stype == MULTI_LEVEL) { /* these types need to use disk */
     ierr = TSTrajectorySetUp_Basic(tj,ts);CHKERRQ(ierr);
+    if (TJIOActive(&tjsch->io) || tjsch->stype == MULTI_LEVEL) { /* every process writes files of its own into the directory */
+      char dirname[PETSC_MAX_PATH_LEN] = "";
+
+      ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)tj),&tjsch->io.rank);CHKERRMPI(ierr);
+      if (!tjsch->io.rank) {ierr = PetscStrncpy(dirname,tj->dirname,sizeof(dirname));CHKERRQ(ierr);}
+      ierr = MPI_Bcast(dirname,sizeof(dirname),MPI_CHAR,0,PetscObjectComm((PetscObject)tj));CHKERRMPI(ierr);
+      if (!tj->dirname) {ierr = PetscStrallocpy(dirname,&tj->dirname);CHKERRQ(ierr);}
+    }
   }
 
   stack->stacksize = PetscMax(stack->stacksize,1);
@@ -2339,12 +3541,14 @@ static PetscErrorCode TSTrajectorySetUp_Memory(TSTrajectory tj,TS ts)
 
 static PetscErrorCode TSTrajectoryReset_Memory(TSTrajectory tj)
 {
-#if defined (PETSC_HAVE_REVOLVE) || defined (PETSC_HAVE_CAMS)
   TJScheduler    *tjsch = (TJScheduler*)tj->data;
   PetscErrorCode ierr;
-#endif
 
   PetscFunctionBegin;
+  ierr = TJIOReset(&tjsch->io);CHKERRQ(ierr);
+  ierr = PetscFree(tjsch->ml.choice);CHKERRQ(ierr);
+  ierr = PetscFree(tjsch->ml.seg);CHKERRQ(ierr);
+  tjsch->ml.nseg = 0;
 #if defined(PETSC_HAVE_REVOLVE)
   if (tjsch->stype > TWO_LEVEL_NOREVOLVE) {
     revolve_reset();
@@ -2375,12 +3579,17 @@ static PetscErrorCode TSTrajectoryDestroy_Memory(TSTrajectory tj)
 
   PetscFunctionBegin;
   ierr = StackDestroy(&tjsch->stack);CHKERRQ(ierr);
+  ierr = TJIODestroy(&tjsch->io);CHKERRQ(ierr);
   ierr = PetscViewerDestroy(&tjsch->viewer);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)tj,"TSTrajectorySetMaxCpsRAM_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)tj,"TSTrajectorySetMaxCpsDisk_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)tj,"TSTrajectorySetMaxUnitsRAM_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)tj,"TSTrajectorySetMaxUnitsDisk_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)tj,"TSTrajectoryMemorySetType_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)tj,"TSTrajectoryMemorySetAsyncIO_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)tj,"TSTrajectoryMemorySetCompression_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)tj,"TSTrajectoryMemorySetStorageLevel_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)tj,"TSTrajectoryMemorySetStepTime_C",NULL);CHKERRQ(ierr);
   ierr = PetscFree(tjsch);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -2390,7 +3599,7 @@ static PetscErrorCode TSTrajectoryDestroy_Memory(TSTrajectory tj)
 
   Level: intermediate
 
-.seealso:  TSTrajectoryCreate(), TS, TSTrajectorySetType()
+.seealso:  TSTrajectoryCreate(), TS, TSTrajectorySetType(), TSTrajectoryMemorySetAsyncIO(), TSTrajectoryMemorySetCompression(), TSTrajectoryMemorySetStorageLevel()
 
 M*/
 PETSC_EXTERN PetscErrorCode TSTrajectoryCreate_Memory(TSTrajectory tj,TS ts)
@@ -2415,6 +3624,8 @@ PETSC_EXTERN PetscErrorCode TSTrajectoryCreate_Memory(TSTrajectory tj,TS ts)
   tjsch->use_online   = PETSC_FALSE;
 #endif
   tjsch->save_stack   = PETSC_TRUE;
+  tjsch->io.tol       = 1e-10;
+  tjsch->ml.nlevels   = 1; /* RAM */
 
   tjsch->stack.solution_only = tj->solution_only;
   ierr = PetscViewerCreate(PetscObjectComm((PetscObject)tj),&tjsch->viewer);CHKERRQ(ierr);
@@ -2427,6 +3638,10 @@ PETSC_EXTERN PetscErrorCode TSTrajectoryCreate_Memory(TSTrajectory tj,TS ts)
   ierr = PetscObjectComposeFunction((PetscObject)tj,"TSTrajectorySetMaxUnitsRAM_C",TSTrajectorySetMaxUnitsRAM_Memory);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)tj,"TSTrajectorySetMaxUnitsDisk_C",TSTrajectorySetMaxUnitsDisk_Memory);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)tj,"TSTrajectoryMemorySetType_C",TSTrajectoryMemorySetType_Memory);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)tj,"TSTrajectoryMemorySetAsyncIO_C",TSTrajectoryMemorySetAsyncIO_Memory);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)tj,"TSTrajectoryMemorySetCompression_C",TSTrajectoryMemorySetCompression_Memory);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)tj,"TSTrajectoryMemorySetStorageLevel_C",TSTrajectoryMemorySetStorageLevel_Memory);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)tj,"TSTrajectoryMemorySetStepTime_C",TSTrajectoryMemorySetStepTime_Memory);CHKERRQ(ierr);
   tj->data = tjsch;
   PetscFunctionReturn(0);
 }
@@ -2408,6 +2408,16 @@ int initLinearWave(EulerNode *ux, const PetscReal gamma, const PetscReal coord[]
       args: -ufv_vtk_interval 0 -dm_refine 3 -dm_plex_separate_marker -grid_bounds -0.5,0.5,-0.5,0.5 -bc_inflow 1,2,4 -bc_outflow 3 -advect_sol_type bump -advect_bump_center 0.25,0 -advect_bump_radius 0.1
       timeoutfactor: 3
 
+    test:
+      suffix: adv_2d_quad_chunk
+      output_file: output/ex11_adv_2d_quad_0.out
+      args: -ufv_vtk_interval 0 -dm_refine 3 -dm_plex_separate_marker -bc_inflow 1,2,4 -bc_outflow 3 -dm_plex_fvm_chunk_size {{7 100000}}
+
+    test:
+      suffix: sw_hll_sort
+      output_file: output/ex11_sw_hll.out
+      args: -ufv_vtk_interval 0 -bc_wall 1,2,3,4 -physics sw -ufv_cfl 3 -petscfv_type leastsquares -petsclimiter_type sin -ts_max_steps 5 -ts_ssp_type rks2 -ts_ssp_nstages 10 -monitor height,energy -grid_bounds 0,5,0,5 -dm_plex_box_faces 25,25 -sw_riemann hll -dm_plex_fvm_sort_faces -dm_plex_fvm_chunk_size 33
+
     test:
       suffix: adv_2d_quad_p4est_0
       requires: p4est
@@ -475,4 +475,30 @@ int main(int argc,char **argv)
       args: -ts_type cn -ts_dt 0.001 -mu 100000 -ts_max_steps 15 -ts_trajectory_type memory -ts_trajectory_max_units_ram 5 -ts_trajectory_solution_only 0 -ts_trajectory_monitor -ts_trajectory_memory_type cams
       output_file: output/ex20adj_6.out
 
+    test:
+      suffix: 25
+      args: -ts_type cn -ts_dt 0.001 -mu 100000 -ts_max_steps 15 -ts_trajectory_type memory -ts_trajectory_stride 3 -ts_trajectory_solution_only {{0 1}} -ts_trajectory_save_stack {{0 1}} -ts_trajectory_memory_async_io -ts_trajectory_memory_compression {{none lossless}}
+      output_file: output/ex20adj_2.out
+
+    test:
+      suffix: 26
+      args: -ts_type cn -ts_dt 0.001 -mu 100000 -ts_max_steps 15 -ts_trajectory_type memory -ts_trajectory_stride 3 -ts_trajectory_solution_only {{0 1}} -ts_trajectory_memory_async_io {{0 1}} -ts_trajectory_memory_compression lossy -ts_trajectory_memory_compression_tol 1e-12
+      output_file: output/ex20adj_2.out
+
+    test:
+      suffix: 26_single
+      requires: single
+      args: -ts_type cn -ts_dt 0.001 -mu 100000 -ts_max_steps 15 -ts_trajectory_type memory -ts_trajectory_stride 3 -ts_trajectory_solution_only {{0 1}} -ts_trajectory_memory_compression lossy -ts_trajectory_memory_compression_tol {{1e-6 1e-12}}
+      output_file: output/ex20adj_2.out
+
+    test:
+      suffix: 27
+      args: -ts_type cn -ts_dt 0.001 -mu 100000 -ts_max_steps 15 -ts_trajectory_type memory -ts_trajectory_max_cps_ram 2 -ts_trajectory_memory_level_max_cps 2,3 -ts_trajectory_memory_level_write_bandwidth 32,16 -ts_trajectory_memory_level_read_bandwidth 32,16 -ts_trajectory_memory_step_time 1 -ts_trajectory_solution_only -ts_trajectory_monitor
+      output_file: output/ex20adj_7.out
+
+    test:
+      suffix: 28
+      args: -ts_type cn -ts_dt 0.001 -mu 100000 -ts_max_steps 15 -ts_trajectory_type memory -ts_trajectory_max_cps_ram 2 -ts_trajectory_memory_level_max_cps 2,3 -ts_trajectory_memory_level_write_bandwidth 32,16 -ts_trajectory_memory_level_read_bandwidth 32,16 -ts_trajectory_memory_step_time 1 -ts_trajectory_solution_only {{0 1}} -ts_trajectory_memory_async_io {{0 1}} -ts_trajectory_memory_compression lossless
+      output_file: output/ex20adj_2.out
+
 TEST*/
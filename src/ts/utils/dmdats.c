@@ -3,6 +3,19 @@
 #include <petsc/private/tsimpl.h>   /*I "petscts.h" I*/
 #include <petscdraw.h>
 
+/* Deep ghost copy of the solution used by the temporally blocked RK step, see DMDATSSetRHSStencilLocal() */
+typedef struct {
+  DM               da;          /* the DMDA with a box stencil of width depth */
+  PetscInt         depth;
+  Vec              X,Y[2],*F;   /* solution, two rotating stage states and the stage derivatives, all local to da */
+  PetscInt         nf;
+  PetscInt         lo[3],hi[3]; /* part of X that holds the current solution */
+  PetscInt         left;        /* ghost layers of X not yet used up by the steps since the last update */
+  PetscInt         rows;        /* rows by which the wavefront advances */
+  PetscObjectId    id;          /* the global solution X was last synchronized with, and its state at that time */
+  PetscObjectState state;
+} DMTSDABlock;
+
 /* This structure holds the user-provided DMDA callbacks */
 typedef struct {
   PetscErrorCode (*ifunctionlocal)(DMDALocalInfo*,PetscReal,void*,void*,void*,void*);
@@ -15,13 +28,31 @@ typedef struct {
   void       *rhsjacobianlocalctx;
   InsertMode ifunctionlocalimode;
   InsertMode rhsfunctionlocalimode;
+  PetscInt   rhsstencilwidth;  /* set by DMDATSSetRHSStencilLocal(), 0 if the RHS cannot be evaluated on arbitrary boxes */
+  DMTSDABlock *block;
 } DMTS_DA;
 
+static PetscErrorCode DMTSDABlockDestroy(DMTSDABlock **block)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!*block) PetscFunctionReturn(0);
+  ierr = VecDestroy(&(*block)->X);CHKERRQ(ierr);
+  ierr = VecDestroy(&(*block)->Y[0]);CHKERRQ(ierr);
+  ierr = VecDestroy(&(*block)->Y[1]);CHKERRQ(ierr);
+  if ((*block)->F) {ierr = VecDestroyVecs((*block)->nf,&(*block)->F);CHKERRQ(ierr);}
+  ierr = DMDestroy(&(*block)->da);CHKERRQ(ierr);
+  ierr = PetscFree(*block);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode DMTSDestroy_DMDA(DMTS sdm)
 {
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
+  if (sdm->data) {ierr = DMTSDABlockDestroy(&((DMTS_DA*)sdm->data)->block);CHKERRQ(ierr);}
   ierr = PetscFree(sdm->data);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -33,6 +64,7 @@ static PetscErrorCode DMTSDuplicate_DMDA(DMTS oldsdm,DMTS sdm)
   PetscFunctionBegin;
   ierr = PetscNewLog(sdm,(DMTS_DA**)&sdm->data);CHKERRQ(ierr);
   if (oldsdm->data) {ierr = PetscMemcpy(sdm->data,oldsdm->data,sizeof(DMTS_DA));CHKERRQ(ierr);}
+  ((DMTS_DA*)sdm->data)->block = NULL;
   PetscFunctionReturn(0);
 }
 
@@ -223,6 +255,251 @@ static PetscErrorCode TSComputeRHSJacobian_DMDA(TS ts,PetscReal ptime,Vec X,Mat
   PetscFunctionReturn(0);
 }
 
+/* the box [lo,hi) on which an RHS evaluation can be completed from values on [lo,hi): it loses the stencil width on
+   every side that is not a physical boundary */
+static void DMTSDABlockShrink(const DMDALocalInfo *info,PetscInt w,const PetscInt lo[],const PetscInt hi[],PetscInt nlo[],PetscInt nhi[])
+{
+  const PetscInt       n[3]  = {info->mx,info->my,info->mz};
+  const DMBoundaryType bt[3] = {info->bx,info->by,info->bz};
+  PetscInt             d;
+
+  for (d = 0; d < 3; ++d) {
+    nlo[d] = lo[d];
+    nhi[d] = hi[d];
+    if (d >= info->dim) continue;
+    if (bt[d] == DM_BOUNDARY_PERIODIC || lo[d] > 0)    nlo[d] += w;
+    if (bt[d] == DM_BOUNDARY_PERIODIC || hi[d] < n[d]) nhi[d] -= w;
+  }
+}
+
+/* y = x + sum_q a[q] f[q] on the rows [r0,r1) along the last axis of the box [lo,hi) of arrays laid out like a local vector */
+static PetscErrorCode DMTSDABlockMAXPY(const DMDALocalInfo *info,const PetscInt lo[],const PetscInt hi[],PetscInt r0,PetscInt r1,PetscScalar *y,const PetscScalar *x,PetscInt nf,const PetscScalar a[],PetscScalar *const f[])
+{
+  const PetscInt dof = info->dof;
+  PetscInt       b[3],e[3],i,j,k,l,q,n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (i = 0; i < 3; ++i) {b[i] = lo[i]; e[i] = hi[i];}
+  b[info->dim-1] = r0;
+  e[info->dim-1] = r1;
+  n = (e[0]-b[0])*dof;
+  for (k = b[2]; k < e[2]; ++k) {
+    for (j = b[1]; j < e[1]; ++j) {
+      const PetscInt o  = (((k-info->gzs)*info->gym + (j-info->gys))*info->gxm + b[0]-info->gxs)*dof;
+      PetscScalar    *yo = y+o;
+
+      if (y != x) {ierr = PetscArraycpy(yo,x+o,n);CHKERRQ(ierr);}
+      for (q = 0; q < nf; ++q) {
+        const PetscScalar *fo = f[q]+o;
+
+        if (a[q] == (PetscScalar)0.0) continue;
+        PetscPragmaSIMD
+        for (l = 0; l < n; ++l) yo[l] += a[q]*fo[l];
+      }
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/* copy the owned part of an array laid out like a local vector into an array laid out like a global vector */
+static PetscErrorCode DMTSDABlockCopyOwned(const DMDALocalInfo *info,const PetscScalar *l,PetscScalar *g)
+{
+  const PetscInt dof = info->dof,n = info->xm*dof;
+  PetscInt       j,k;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (k = info->zs; k < info->zs+info->zm; ++k) {
+    for (j = info->ys; j < info->ys+info->ym; ++j) {
+      ierr = PetscArraycpy(g+((k-info->zs)*info->ym + j-info->ys)*n,l+(((k-info->gzs)*info->gym + j-info->gys)*info->gxm + info->xs-info->gxs)*dof,n);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/* make sure the deep ghost copy fits s stages for as many of the requested steps as the subdomain widths allow */
+static PetscErrorCode DMTSDABlockSetUp(DM dm,DMTS_DA *dmdats,PetscInt s,PetscInt *nsteps)
+{
+  MPI_Comm       comm;
+  DMTSDABlock    *blk;
+  DMBoundaryType bx,by,bz;
+  const PetscInt *lx,*ly,*lz;
+  PetscInt       dim,M,N,P,m,n,p,dof,i,minw = PETSC_MAX_INT,w = dmdats->rhsstencilwidth,depth;
+  PetscBool      flg;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMDAGetInfo(dm,&dim,&M,&N,&P,&m,&n,&p,&dof,NULL,&bx,&by,&bz,NULL);CHKERRQ(ierr);
+  if ((bx != DM_BOUNDARY_NONE && bx != DM_BOUNDARY_PERIODIC) || (by != DM_BOUNDARY_NONE && by != DM_BOUNDARY_PERIODIC) || (bz != DM_BOUNDARY_NONE && bz != DM_BOUNDARY_PERIODIC)) {
+    ierr = PetscInfo(dm,"Only DM_BOUNDARY_NONE and DM_BOUNDARY_PERIODIC support the blocked step\n");CHKERRQ(ierr);
+    *nsteps = 0;
+    PetscFunctionReturn(0);
+  }
+  /* a DMDA cannot have ghost regions wider than the narrowest subdomain */
+  ierr = DMDAGetOwnershipRanges(dm,&lx,&ly,&lz);CHKERRQ(ierr);
+  for (i = 0; i < m; ++i) minw = PetscMin(minw,lx[i]);
+  if (dim > 1) for (i = 0; i < n; ++i) minw = PetscMin(minw,ly[i]);
+  if (dim > 2) for (i = 0; i < p; ++i) minw = PetscMin(minw,lz[i]);
+  if (w) *nsteps = PetscMin(*nsteps,minw/(s*w));
+  if (!*nsteps) {
+    ierr = PetscInfo3(dm,"A step with %D stages of width %D does not fit in subdomains of width %D\n",s,w,minw);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  depth = *nsteps*s*w;
+  if (dmdats->block && dmdats->block->depth == depth && dmdats->block->nf >= s) PetscFunctionReturn(0);
+
+  ierr = DMTSDABlockDestroy(&dmdats->block);CHKERRQ(ierr);
+  ierr = PetscNew(&blk);CHKERRQ(ierr);
+  ierr = PetscObjectGetComm((PetscObject)dm,&comm);CHKERRQ(ierr);
+  if (dim == 1)      {ierr = DMDACreate1d(comm,bx,M,dof,depth,lx,&blk->da);CHKERRQ(ierr);}
+  else if (dim == 2) {ierr = DMDACreate2d(comm,bx,by,DMDA_STENCIL_BOX,M,N,m,n,dof,depth,lx,ly,&blk->da);CHKERRQ(ierr);}
+  else               {ierr = DMDACreate3d(comm,bx,by,bz,DMDA_STENCIL_BOX,M,N,P,m,n,p,dof,depth,lx,ly,lz,&blk->da);CHKERRQ(ierr);}
+  ierr = DMDAGetGhostExchangeDatatypes(dm,&flg);CHKERRQ(ierr);
+  ierr = DMDASetGhostExchangeDatatypes(blk->da,flg);CHKERRQ(ierr);
+  ierr = DMSetUp(blk->da);CHKERRQ(ierr);
+  ierr = DMCreateLocalVector(blk->da,&blk->X);CHKERRQ(ierr);
+  ierr = VecDuplicate(blk->X,&blk->Y[0]);CHKERRQ(ierr);
+  ierr = VecDuplicate(blk->X,&blk->Y[1]);CHKERRQ(ierr);
+  ierr = VecDuplicateVecs(blk->X,s,&blk->F);CHKERRQ(ierr);
+  blk->nf    = s;
+  blk->depth = depth;
+  blk->rows  = dim == 1 ? 1024 : (dim == 2 ? 16 : 2);
+  ierr = PetscOptionsGetInt(((PetscObject)dm)->options,((PetscObject)dm)->prefix,"-da_ts_wavefront_rows",&blk->rows,NULL);CHKERRQ(ierr);
+  blk->rows  = PetscMax(blk->rows,PetscMax(w,1));
+  dmdats->block = blk;
+  PetscFunctionReturn(0);
+}
+
+/*
+  One explicit RK step on the deep ghost copy of the solution. The ghost regions are updated only when the previous
+  steps have used them up or when X was changed by anything but this routine. Otherwise the solution is advanced from
+  the part of the copy that is still current, which shrinks by the stencil width on every interior side per stage.
+
+  The operations Y_0 (= X), F_0, Y_1, F_1, ..., F_{s-1}, X are pipelined along the last axis: in each sweep the first
+  one advances by blk->rows rows and every other one follows as far as its inputs are complete. Y_i is a pointwise
+  combination of X and F_j, j < i, while F_i and the update of X in place must stay the stencil width behind. Two
+  buffers suffice for the states Y_i because Y_{i+2} stays behind the rows F_i still needs.
+*/
+static PetscErrorCode TSRKStepLocal_DMDA(TS ts,PetscInt nsteps,PetscReal t,PetscReal h,PetscInt s,const PetscReal A[],const PetscReal b[],const PetscReal c[],Vec X,Vec Ydot[],PetscBool *stepped,void *ctx)
+{
+  DMTS_DA          *dmdats = (DMTS_DA*)ctx;
+  const PetscInt   w = dmdats->rhsstencilwidth;
+  DM               dm;
+  DMTSDABlock      *blk;
+  DMDALocalInfo    info,binfo;
+  PetscObjectState state;
+  PetscBool        sync;
+  PetscInt         *lo,*hi,*r,a,d,i,j,o,q,R;
+  PetscScalar      *x,*y[2],**f,*wc,*g;
+  void             *xa,*ya[2],**fa;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  *stepped = PETSC_FALSE;
+  ierr = TSGetDM(ts,&dm);CHKERRQ(ierr);
+  ierr = DMTSDABlockSetUp(dm,dmdats,s,&nsteps);CHKERRQ(ierr);
+  if (!nsteps) PetscFunctionReturn(0);
+  blk  = dmdats->block;
+  ierr = DMDAGetLocalInfo(blk->da,&info);CHKERRQ(ierr);
+  a    = info.dim-1;
+
+  /* the decision only involves quantities that change identically on all processes */
+  ierr = PetscObjectStateGet((PetscObject)X,&state);CHKERRQ(ierr);
+  sync = (PetscBool)(blk->id != ((PetscObject)X)->id || blk->state != state || blk->left < s*w);
+#if defined(PETSC_USE_DEBUG)
+  {
+    PetscInt flg[2] = {-(PetscInt)sync,(PetscInt)sync};
+
+    ierr = MPIU_Allreduce(MPI_IN_PLACE,flg,2,MPIU_INT,MPI_MAX,PetscObjectComm((PetscObject)ts));CHKERRMPI(ierr);
+    if (-flg[0] != flg[1]) SETERRQ(PetscObjectComm((PetscObject)ts),PETSC_ERR_ARG_WRONGSTATE,"The solution was changed on some processes only since the previous step");
+  }
+#endif
+  if (sync) {
+    ierr = PetscInfo1(ts,"Updating %D ghost layers of the solution\n",blk->depth);CHKERRQ(ierr);
+    ierr = DMGlobalToLocalBegin(blk->da,X,INSERT_VALUES,blk->X);CHKERRQ(ierr);
+    ierr = DMGlobalToLocalEnd(blk->da,X,INSERT_VALUES,blk->X);CHKERRQ(ierr);
+    blk->lo[0] = info.gxs; blk->hi[0] = info.gxs+info.gxm;
+    blk->lo[1] = info.gys; blk->hi[1] = info.gys+info.gym;
+    blk->lo[2] = info.gzs; blk->hi[2] = info.gzs+info.gzm;
+    blk->left  = blk->depth;
+  }
+
+  /* box i is where Y_i is computed and box i+1 where F_i is, the last one is where X is advanced */
+  ierr = PetscMalloc5(3*(s+1),&lo,3*(s+1),&hi,2*s+1,&r,s,&wc,s,&f);CHKERRQ(ierr);
+  ierr = PetscMalloc1(s,&fa);CHKERRQ(ierr);
+  for (d = 0; d < 3; ++d) {lo[d] = blk->lo[d]; hi[d] = blk->hi[d];}
+  for (i = 0; i < s; ++i) DMTSDABlockShrink(&info,w,lo+3*i,hi+3*i,lo+3*(i+1),hi+3*(i+1));
+  for (o = 0; o <= 2*s; ++o) r[o] = lo[3*((o+1)/2)+a];
+
+  ierr = VecGetArray(blk->X,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(blk->Y[0],&y[0]);CHKERRQ(ierr);
+  ierr = VecGetArray(blk->Y[1],&y[1]);CHKERRQ(ierr);
+  ierr = DMDAVecGetArray(blk->da,blk->X,&xa);CHKERRQ(ierr);
+  ierr = DMDAVecGetArray(blk->da,blk->Y[0],&ya[0]);CHKERRQ(ierr);
+  ierr = DMDAVecGetArray(blk->da,blk->Y[1],&ya[1]);CHKERRQ(ierr);
+  for (i = 0; i < s; ++i) {
+    ierr = VecGetArray(blk->F[i],&f[i]);CHKERRQ(ierr);
+    ierr = DMDAVecGetArray(blk->da,blk->F[i],&fa[i]);CHKERRQ(ierr);
+  }
+  for (q = 0; r[2*s] < hi[3*s+a]; ++q) {
+    for (o = 0, R = 0; o <= 2*s; ++o) {
+      const PetscInt bi = (o+1)/2,ohi = hi[3*bi+a];
+
+      if (!o)         R = PetscMin(ohi,lo[a]+(q+1)*blk->rows);
+      else if (o % 2) R = R >= hi[3*(bi-1)+a] ? ohi : PetscMin(ohi,R-w);   /* F_i from Y_i */
+      else if (o < 2*s) R = PetscMin(ohi,R);                              /* Y_i from X and F_j */
+      else            R = R >= hi[3*bi+a] ? ohi : PetscMin(ohi,R-w);     /* X from X and F_j, behind F_0 which reads X */
+      if (R <= r[o]) continue;
+      if (o % 2) {
+        i     = o/2;
+        binfo = info;
+        binfo.xs = lo[3*bi];   binfo.xm = hi[3*bi]-lo[3*bi];
+        binfo.ys = lo[3*bi+1]; binfo.ym = hi[3*bi+1]-lo[3*bi+1];
+        binfo.zs = lo[3*bi+2]; binfo.zm = hi[3*bi+2]-lo[3*bi+2];
+        if (a == 0)      {binfo.xs = r[o]; binfo.xm = R-r[o];}
+        else if (a == 1) {binfo.ys = r[o]; binfo.ym = R-r[o];}
+        else             {binfo.zs = r[o]; binfo.zm = R-r[o];}
+        ierr = (*dmdats->rhsfunctionlocal)(&binfo,t+c[i]*h,i ? ya[(i-1)%2] : xa,fa[i],dmdats->rhsfunctionlocalctx);CHKERRQ(ierr);
+      } else if (o < 2*s) {
+        i = o/2;
+        for (j = 0; j < i; ++j) wc[j] = h*A[i*s+j];
+        if (i) {ierr = DMTSDABlockMAXPY(&info,lo+3*bi,hi+3*bi,r[o],R,y[(i-1)%2],x,i,wc,f);CHKERRQ(ierr);}
+      } else {
+        for (j = 0; j < s; ++j) wc[j] = h*b[j];
+        ierr = DMTSDABlockMAXPY(&info,lo+3*bi,hi+3*bi,r[o],R,x,x,s,wc,f);CHKERRQ(ierr);
+      }
+      r[o] = R;
+    }
+  }
+
+  for (i = 0; i < s; ++i) {
+    ierr = VecGetArray(Ydot[i],&g);CHKERRQ(ierr);
+    ierr = DMTSDABlockCopyOwned(&info,f[i],g);CHKERRQ(ierr);
+    ierr = VecRestoreArray(Ydot[i],&g);CHKERRQ(ierr);
+    ierr = DMDAVecRestoreArray(blk->da,blk->F[i],&fa[i]);CHKERRQ(ierr);
+    ierr = VecRestoreArray(blk->F[i],&f[i]);CHKERRQ(ierr);
+  }
+  ierr = VecGetArray(X,&g);CHKERRQ(ierr);
+  ierr = DMTSDABlockCopyOwned(&info,x,g);CHKERRQ(ierr);
+  ierr = VecRestoreArray(X,&g);CHKERRQ(ierr);
+  ierr = DMDAVecRestoreArray(blk->da,blk->Y[1],&ya[1]);CHKERRQ(ierr);
+  ierr = DMDAVecRestoreArray(blk->da,blk->Y[0],&ya[0]);CHKERRQ(ierr);
+  ierr = DMDAVecRestoreArray(blk->da,blk->X,&xa);CHKERRQ(ierr);
+  ierr = VecRestoreArray(blk->Y[1],&y[1]);CHKERRQ(ierr);
+  ierr = VecRestoreArray(blk->Y[0],&y[0]);CHKERRQ(ierr);
+  ierr = VecRestoreArray(blk->X,&x);CHKERRQ(ierr);
+
+  for (d = 0; d < 3; ++d) {blk->lo[d] = lo[3*s+d]; blk->hi[d] = hi[3*s+d];}
+  blk->left -= s*w;
+  blk->id    = ((PetscObject)X)->id;
+  ierr = PetscObjectStateGet((PetscObject)X,&blk->state);CHKERRQ(ierr);
+  ierr = PetscFree5(lo,hi,r,wc,f);CHKERRQ(ierr);
+  ierr = PetscFree(fa);CHKERRQ(ierr);
+  *stepped = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
 /*@C
    DMDATSSetRHSFunctionLocal - set a local residual evaluation function
 
@@ -261,7 +538,75 @@ PetscErrorCode DMDATSSetRHSFunctionLocal(DM dm,InsertMode imode,DMDATSRHSFunctio
   dmdats->rhsfunctionlocalimode = imode;
   dmdats->rhsfunctionlocal      = func;
   dmdats->rhsfunctionlocalctx   = ctx;
+  dmdats->rhsstencilwidth       = 0;
+  ierr = DMTSDABlockDestroy(&dmdats->block);CHKERRQ(ierr);
+  ierr = DMTSSetRHSFunction(dm,TSComputeRHSFunction_DMDA,dmdats);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   DMDATSSetRHSStencilLocal - set a local RHS evaluation function that can be evaluated on any box of grid points,
+   which lets explicit Runge-Kutta methods advance several stages and steps per ghost update
+
+   Logically Collective
+
+   Input Parameters:
++  dm - DM to associate callback with
+.  width - the stencil width of the right hand side, in grid points
+.  func - local RHS evaluation
+-  ctx - optional context for local RHS evaluation
+
+   Calling sequence for func:
+
+$ func(DMDALocalInfo *info,PetscReal t,void *x,void *f,void *ctx)
+
++  info - DMDALocalInfo defining the box to evaluate the RHS on
+.  t - time at which to evaluate the RHS
+.  x - array of local state information
+.  f - output array of local RHS information
+-  ctx - optional user context
+
+   Options Database:
+.  -da_ts_wavefront_rows <rows> - rows (planes in 3d) by which the blocked step advances each stage at a time
+
+   Notes:
+   The function must compute f only at the points info->xs <= i < info->xs+info->xm (likewise in y and z) and read
+   x only within width points of them. The box is not necessarily the owned part of the grid and the arrays may have
+   wider ghost regions than the DMDA, so the function must get its loop bounds from info, not from info->da. In
+   periodic directions the indices can lie outside [0,info->mx). Non-periodic boundary conditions are applied at
+   i == 0 and i == info->mx-1 as usual.
+
+   The function is also installed as the ordinary RHS function, with INSERT_VALUES, so it works with any TS. With
+   TSRKSetTemporalBlocking() TSRK advances the whole step on a local copy of the solution with ghost regions of width
+   k s width, where s is the number of stages, and updates the ghost regions only every k steps. The stages are
+   computed in a wavefront along the last axis, so each stage uses the rows just computed by the previous one while
+   they are still in cache. Only DM_BOUNDARY_NONE and DM_BOUNDARY_PERIODIC are supported by the blocked step, with
+   other boundary types TSRK takes the regular step.
+
+   Level: intermediate
+
+.seealso: DMDATSSetRHSFunctionLocal(), TSRKSetTemporalBlocking(), DMDASetGhostExchangeDatatypes()
+@*/
+PetscErrorCode DMDATSSetRHSStencilLocal(DM dm,PetscInt width,DMDATSRHSFunctionLocal func,void *ctx)
+{
+  PetscErrorCode ierr;
+  DMTS           sdm;
+  DMTS_DA        *dmdats;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm,DM_CLASSID,1);
+  PetscValidLogicalCollectiveInt(dm,width,2);
+  if (width < 0) SETERRQ1(PetscObjectComm((PetscObject)dm),PETSC_ERR_ARG_OUTOFRANGE,"Stencil width %D cannot be negative",width);
+  ierr = DMGetDMTSWrite(dm,&sdm);CHKERRQ(ierr);
+  ierr = DMDATSGetContext(dm,sdm,&dmdats);CHKERRQ(ierr);
+  dmdats->rhsfunctionlocalimode = INSERT_VALUES;
+  dmdats->rhsfunctionlocal      = func;
+  dmdats->rhsfunctionlocalctx   = ctx;
+  dmdats->rhsstencilwidth       = width;
+  ierr = DMTSDABlockDestroy(&dmdats->block);CHKERRQ(ierr);
   ierr = DMTSSetRHSFunction(dm,TSComputeRHSFunction_DMDA,dmdats);CHKERRQ(ierr);
+  sdm->ops->rkstep = TSRKStepLocal_DMDA;
+  sdm->rkstepctx   = dmdats;
   PetscFunctionReturn(0);
 }
 
@@ -172,6 +172,7 @@ PetscErrorCode DMTSCopy(DMTS kdm,DMTS nkdm)
   nkdm->ops->i2function  = kdm->ops->i2function;
   nkdm->ops->i2jacobian  = kdm->ops->i2jacobian;
   nkdm->ops->solution    = kdm->ops->solution;
+  nkdm->ops->rkstep      = kdm->ops->rkstep;
   nkdm->ops->destroy     = kdm->ops->destroy;
   nkdm->ops->duplicate   = kdm->ops->duplicate;
 
@@ -182,6 +183,7 @@ PetscErrorCode DMTSCopy(DMTS kdm,DMTS nkdm)
   nkdm->i2functionctx  = kdm->i2functionctx;
   nkdm->i2jacobianctx  = kdm->i2jacobianctx;
   nkdm->solutionctx    = kdm->solutionctx;
+  nkdm->rkstepctx      = kdm->rkstepctx;
 
   nkdm->data = kdm->data;
 
@@ -561,7 +563,10 @@ PetscErrorCode DMTSSetRHSFunction(DM dm,TSRHSFunction func,void *ctx)
   PetscFunctionBegin;
   PetscValidHeaderSpecific(dm,DM_CLASSID,1);
   ierr = DMGetDMTSWrite(dm,&tsdm);CHKERRQ(ierr);
-  if (func) tsdm->ops->rhsfunction = func;
+  if (func) {
+    tsdm->ops->rhsfunction = func;
+    tsdm->ops->rkstep      = NULL; /* only valid together with the function that set it */
+  }
   if (ctx)  tsdm->rhsfunctionctx = ctx;
   PetscFunctionReturn(0);
 }